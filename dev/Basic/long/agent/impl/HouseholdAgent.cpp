@@ -29,7 +29,7 @@
 #include "model/JobAssignmentModel.hpp"
 #include "util/PrintLog.hpp"
 #include "util/Statistics.hpp"
-#include <random>
+#include "util/MarketDraws.hpp"
 
 using namespace sim_mob::long_term;
 using namespace sim_mob::event;
@@ -42,7 +42,8 @@ using std::endl;
 
 HouseholdAgent::HouseholdAgent(BigSerial _id, HM_Model* _model, Household* _household, HousingMarket* _market, bool _marketSeller, int _day, int _householdBiddingWindow, int awakeningDay, bool acceptedBid, int buySellInterval)
                              : Agent_LT(ConfigManager::GetInstance().FullConfig().mutexStategy(), _id), model(_model), market(_market), household(_household), marketSeller(_marketSeller), bidder (nullptr), seller(nullptr), day(_day),
-                               vehicleOwnershipOption(NO_VEHICLE), householdBiddingWindow(_householdBiddingWindow),awakeningDay(awakeningDay),acceptedBid(acceptedBid), buySellInterval(-1)
+                               vehicleOwnershipOption(NO_VEHICLE), householdBiddingWindow(_householdBiddingWindow),awakeningDay(awakeningDay),acceptedBid(acceptedBid), buySellInterval(-1),
+                               btoEventsDay(-1), btoEventsOnDay(0)
                             {
 
     //Freelance agents are active by default.
@@ -314,7 +315,8 @@ void HouseholdAgent::TransferUnitToFreelanceAgent()
 
     int numFreelanceAgents = config.ltParams.workers;
 
-    int agentChosen = (float)rand() / RAND_MAX * numFreelanceAgents;
+    MarketDraws draws(MarketDraws::FREELANCE_AGENT, getId(), day);
+    int agentChosen = draws.nextIndex(numFreelanceAgents);
 
     HouseholdAgent *freelanceAgent = model->getFreelanceAgents()[agentChosen];
 
@@ -340,6 +342,16 @@ void HouseholdAgent::TransferUnitToFreelanceAgent()
     seller->sellingUnitsMap.clear();
 }
 
+unsigned int HouseholdAgent::nextBTOEventSequence()
+{
+    if (btoEventsDay != day)
+    {
+        btoEventsDay = day;
+        btoEventsOnDay = 0;
+    }
+    return btoEventsOnDay++;
+}
+
 void HouseholdAgent::onEvent(EventId eventId, Context ctxId, EventPublisher*, const EventArgs& args)
 {
     processEvent(eventId, ctxId, args);
@@ -367,10 +379,8 @@ void HouseholdAgent::processEvent(EventId eventId, Context ctxId, const EventArg
             ConfigParams& config = ConfigManager::GetInstanceRW().FullConfig();
 
             //generate a unifromly distributed random number
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_real_distribution<> dis(0.0, 1.0);
-            const double montecarlo = dis(gen);
+            MarketDraws draws(MarketDraws::BTO_AWAKENING, getId(), day, nextBTOEventSequence());
+            const double montecarlo = draws.next();
 
             if( montecarlo < config.ltParams.housingModel.householdAwakeningPercentageByBTO )
             {
@@ -398,10 +408,8 @@ void HouseholdAgent::processEvent(EventId eventId, Context ctxId, const EventArg
             ConfigParams& config = ConfigManager::GetInstanceRW().FullConfig();
 
             //generate a unifromly distributed random number
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_real_distribution<> dis(0.0, 1.0);
-            const double montecarlo = dis(gen);
+            MarketDraws draws(MarketDraws::BTO_AWAKENING, getId(), day, nextBTOEventSequence());
+            const double montecarlo = draws.next();
 
             if( montecarlo < config.ltParams.housingModel.householdAwakeningPercentageByBTO )
             {
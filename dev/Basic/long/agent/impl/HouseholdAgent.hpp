@@ -112,6 +112,11 @@ namespace sim_mob
 
             void TakeUnitOwnership();
 
+            /**
+             * @return the sequence of the next BTO or presale unit event of the current day.
+             */
+            unsigned int nextBTOEventSequence();
+
 
         private:
             HM_Model* model;
@@ -134,6 +139,10 @@ namespace sim_mob
 
             int awakeningDay;
             bool acceptedBid;
+
+            ///Day and number of the BTO and presale unit events received that day; tells apart their awakening draws.
+            int btoEventsDay;
+            unsigned int btoEventsOnDay;
         };
     }
 }
@@ -186,6 +186,48 @@ void HousingMarket::Entry::setOwner(Agent_LT* owner)
     this->owner = owner;
 }
 
+void HousingMarket::EntryArray::add(Entry* entry)
+{
+    if (positions.insert(std::make_pair(entry->getUnitId(), entries.size())).second)
+    {
+        entries.push_back(entry);
+    }
+}
+
+void HousingMarket::EntryArray::remove(const Entry* entry)
+{
+    boost::unordered_map<BigSerial, size_t>::iterator it = positions.find(entry->getUnitId());
+    if (it != positions.end())
+    {
+        //move the last entry to the place of the removed one.
+        size_t position = it->second;
+        positions.erase(it);
+        Entry* last = entries.back();
+        entries.pop_back();
+
+        if (position < entries.size())
+        {
+            entries[position] = last;
+            positions[last->getUnitId()] = position;
+        }
+    }
+}
+
+size_t HousingMarket::EntryArray::size() const
+{
+    return entries.size();
+}
+
+bool HousingMarket::EntryArray::empty() const
+{
+    return entries.empty();
+}
+
+const HousingMarket::Entry* HousingMarket::EntryArray::operator[](size_t index) const
+{
+    return entries[index];
+}
+
 HousingMarket::HousingMarket() : Entity(-1)
 {
 }
@@ -237,16 +279,31 @@ void HousingMarket::getAvailableEntries(const IdVector& tazIds, HousingMarket::C
 
 void HousingMarket::getAvailableEntries(ConstEntryList& outList)
 {
-    //copy(entriesById, outList);
-    for( auto itr = entriesById.begin(); itr != entriesById.end(); itr++)
+    for (size_t n = 0; n < entries.size(); n++)
     {
-        if( (*itr).second->isBuySellIntervalCompleted() == true)
+        if (entries[n]->isBuySellIntervalCompleted())
         {
-            outList.push_back((*itr).second);
+            outList.push_back(entries[n]);
         }
     }
 }
 
+const HousingMarket::EntryArray& HousingMarket::getEntries() const
+{
+    return entries;
+}
+
+const HousingMarket::EntryArray* HousingMarket::getEntriesByZoneHousingType(int zoneHousingType) const
+{
+    boost::unordered_map<int, EntryArray>::const_iterator it = entriesByZoneHousingType.find(zoneHousingType);
+    return (it != entriesByZoneHousingType.end()) ? &it->second : nullptr;
+}
+
+const HousingMarket::EntryArray& HousingMarket::getBTOEntries() const
+{
+    return btoEntries;
+}
+
 size_t HousingMarket::getEntrySize(unsigned int currTick)
 {
     size_t size = 0;
@@ -267,15 +324,6 @@ size_t HousingMarket::getBTOEntrySize()
     return btoEntries.size();
 }
 
-std::set<BigSerial> HousingMarket::getBTOEntries()
-{
-    return btoEntries;
-}
-
-std::unordered_multimap<int, BigSerial>& HousingMarket::getunitsByZoneHousingType()
-{
-    return unitsByZoneHousingType;
-}
             
 const HousingMarket::Entry* HousingMarket::getEntryById(const BigSerial& unitId)
 {
@@ -324,12 +372,13 @@ void HousingMarket::HandleMessage(Message::MessageType type, const Message& mess
                 //MessageBus::PublishEvent(LTEID_HM_UNIT_ADDED, this,
                 //MessageBus::EventArgsPtr(new HM_ActionEventArgs(unitId)));
 
+               entries.add(newEntry);
                if( newEntry->isBTO() )
                {
-                   btoEntries.insert(unitId);
+                   btoEntries.add(newEntry);
                }
 
-               unitsByZoneHousingType.insert(std::make_pair<int,BigSerial>( msg.entry.getZoneHousingType(), msg.entry.getUnitId()));
+               entriesByZoneHousingType[newEntry->getZoneHousingType()].add(newEntry);
             }
             break;
         }
@@ -339,18 +388,11 @@ void HousingMarket::HandleMessage(Message::MessageType type, const Message& mess
             Entry* entry = getEntry(entriesById, msg.unitId);
             if (entry)
             {
+                entries.remove(entry);
                 if( entry->isBTO() )
-                    btoEntries.erase(entry->getUnitId());
+                    btoEntries.remove(entry);
 
-                auto itr = unitsByZoneHousingType.equal_range(entry->getZoneHousingType());
-                for (auto it = itr.first; it != itr.second; it++)
-                {
-                    if (it->second == entry->getUnitId())
-                    {
-                        unitsByZoneHousingType.erase(it);
-                        break;
-                    }
-                }
+                entriesByZoneHousingType[entry->getZoneHousingType()].remove(entry);
 
                 BigSerial tazId = entry->getTazId();
                 //remove from the map by Taz.
@@ -106,6 +106,28 @@ namespace sim_mob
             typedef boost::unordered_map<BigSerial, Entry*> EntryMap;
             typedef boost::unordered_map<BigSerial, EntryMap> EntryMapById;
 
+            /**
+             * Set of entries which can be indexed like an array, to draw
+             * random entries in constant time.
+             * 
+             * An entry is removed by moving the last entry to its place, 
+             * so the order of the entries changes as entries are removed.
+             */
+            class EntryArray
+            {
+            public:
+                void add(Entry* entry);
+                void remove(const Entry* entry);
+
+                size_t size() const;
+                bool empty() const;
+                const Entry* operator[](size_t index) const;
+
+            private:
+                EntryList entries;
+                boost::unordered_map<BigSerial, size_t> positions; // index of each unit in entries.
+            };
+
         public:
             HousingMarket();
             virtual ~HousingMarket();
@@ -150,6 +172,25 @@ namespace sim_mob
              */
             void getAvailableEntries(ConstEntryList& outList);
 
+            /**
+             * Get all the entries, including those which are not available 
+             * yet (see Entry::isBuySellIntervalCompleted).
+             * Like the other views, it is updated when the messages of 
+             * addEntry, updateEntry and removeEntry are processed.
+             */
+            const EntryArray& getEntries() const;
+
+            /**
+             * Get the entries of the given zone housing type.
+             * @return the entries or nullptr if there are none.
+             */
+            const EntryArray* getEntriesByZoneHousingType(int zoneHousingType) const;
+
+            /**
+             * Get the BTO entries.
+             */
+            const EntryArray& getBTOEntries() const;
+
             /**
              * Get a pointer of the entry by given unit identifier.
              * You should not change the returned values.
@@ -166,10 +207,6 @@ namespace sim_mob
             size_t getEntrySize(unsigned int currTick);
             size_t getBTOEntrySize();
 
-            std::set<BigSerial> getBTOEntries();
-
-            std::unordered_multimap<int, BigSerial>& getunitsByZoneHousingType();
-
 
         protected:
             /**
@@ -190,8 +227,9 @@ namespace sim_mob
             EntryMap entriesById; // original copies
             EntryMapById entriesByTazId; // only lookup.
 
-            std::set<BigSerial> btoEntries;
-            std::unordered_multimap<int, BigSerial>unitsByZoneHousingType;
+            EntryArray entries; // only lookup.
+            EntryArray btoEntries; // only lookup.
+            boost::unordered_map<int, EntryArray> entriesByZoneHousingType; // only lookup.
 
         };
     }
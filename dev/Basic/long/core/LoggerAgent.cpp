@@ -8,7 +8,6 @@
  */
 
 #include "LoggerAgent.hpp"
-#include "message/MessageBus.hpp"
 #include "Common.hpp"
 #include "util/HelperFunctions.hpp"
 #include "conf/ConfigParams.hpp"
@@ -22,21 +21,19 @@ using namespace sim_mob::messaging;
 
 namespace
 {
-    class LogMsg : public Message
-    {
-    public:
-
-        LogMsg(const std::string& logMsg, LoggerAgent::LogFile fileType) : logMsg(logMsg), fileType(fileType)
-        {
-            priority = INTERNAL_MESSAGE_PRIORITY;
-        }
-
-        std::string logMsg;
-        LoggerAgent::LogFile fileType;
-    };
+    /**
+     * Size from which a chunk is handed over to the writer thread.
+     */
+    const size_t CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * Longest time the writer thread sleeps when it has nothing to write.
+     */
+    const long WRITER_IDLE_WAIT_MS = 100;
 }
 
-LoggerAgent::LoggerAgent() : Entity(-1)
+LoggerAgent::LoggerAgent() : Entity(-1), threadBuffer(keepThreadBuffer), epoch(0),
+                             pendingChunks(128), stopWriting(false)
 {
 
     ConfigParams& config = ConfigManager::GetInstanceRW().FullConfig();
@@ -413,10 +410,20 @@ LoggerAgent::LoggerAgent() : Entity(-1)
      std::ofstream* eLinkStopsWithNearestPolyFile = new std::ofstream("ezLinkStopsWithNearestPoly.csv");
      streams.insert(std::make_pair(LOG_NEARSET_POLYTECH_EZ_LINK, eLinkStopsWithNearestPolyFile));
      *eLinkStopsWithNearestPolyFile << "ezLinkStopId, polyId" << std::endl;
+
+     startWriter();
 }
 
 LoggerAgent::~LoggerAgent()
 {
+    for (std::vector<ThreadBuffer*>::iterator it = threadBuffers.begin(); it != threadBuffers.end(); it++)
+    {
+        handOver(**it);
+        delete *it;
+    }
+    threadBuffers.clear();
+    stopWriter();
+
     typename Files::iterator it;
     for (it = streams.begin(); it != streams.end(); it++)
     {
@@ -443,37 +450,139 @@ void LoggerAgent::onWorkerEnter() {}
 
 void LoggerAgent::onWorkerExit() {}
 
+void LoggerAgent::keepThreadBuffer(ThreadBuffer* buffer) {}
+
 Entity::UpdateStatus LoggerAgent::update(timeslice now)
 {
+    epoch++;
     return Entity::UpdateStatus(Entity::UpdateStatus::RS_CONTINUE);
 }
 
 void LoggerAgent::log(LogFile outputType, const std::string& logMsg)
 {
-    boost::mutex::scoped_lock lock( mtx );
+    if (outputType == STDOUT)
+    {
+        PrintOut(logMsg << std::endl);
+        return;
+    }
 
-    // entry will be available only on the next tick
-    MessageBus::PostMessage(this, LTMID_LOG, MessageBus::MessagePtr(new LogMsg(logMsg, outputType)));
+    ThreadBuffer& buffer = getThreadBuffer();
+    const unsigned int currentEpoch = epoch;
+    if (buffer.epoch != currentEpoch)
+    {
+        handOver(buffer);
+        buffer.epoch = currentEpoch;
+    }
+
+    std::string& chunk = buffer.chunks[outputType];
+    chunk.append(logMsg);
+    chunk.push_back('\n');
+    if (chunk.size() >= CHUNK_SIZE)
+    {
+        handOver(outputType, chunk);
+    }
 }
 
-void LoggerAgent::HandleMessage(messaging::Message::MessageType type, const messaging::Message& message)
+void LoggerAgent::flush()
 {
-    switch (type)
     {
-        case LTMID_LOG:
+        boost::mutex::scoped_lock lock(threadBuffersMtx);
+        for (std::vector<ThreadBuffer*>::iterator it = threadBuffers.begin(); it != threadBuffers.end(); it++)
+        {
+            handOver(**it);
+        }
+    }
+
+    //the writer thread writes all the chunks handed over before it stops.
+    stopWriter();
+    for (Files::iterator it = streams.begin(); it != streams.end(); it++)
+    {
+        if (it->second)
         {
-            const LogMsg& msg = MSG_CAST(LogMsg, message);
-
-            if (msg.fileType == STDOUT)
-            {
-                PrintOut(msg.logMsg << std::endl);
-            }
-            else
-            {
-                (*streams[msg.fileType]) << msg.logMsg << std::endl;
-            }
-            break;
+            it->second->flush();
         }
-        default:break;
-    };
+    }
+    startWriter();
+}
+
+LoggerAgent::ThreadBuffer& LoggerAgent::getThreadBuffer()
+{
+    ThreadBuffer* buffer = threadBuffer.get();
+    if (!buffer)
+    {
+        buffer = new ThreadBuffer();
+        buffer->epoch = epoch;
+        threadBuffer.reset(buffer);
+
+        boost::mutex::scoped_lock lock(threadBuffersMtx);
+        threadBuffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void LoggerAgent::handOver(ThreadBuffer& buffer)
+{
+    for (size_t file = 0; file < buffer.chunks.size(); file++)
+    {
+        if (!buffer.chunks[file].empty())
+        {
+            handOver(static_cast<LogFile>(file), buffer.chunks[file]);
+        }
+    }
+}
+
+void LoggerAgent::handOver(LogFile file, std::string& data)
+{
+    Chunk* chunk = new Chunk(file);
+    chunk->data.swap(data);
+    data.reserve(CHUNK_SIZE);
+    pendingChunks.push(chunk);
+    writerCondition.notify_one();
+}
+
+void LoggerAgent::startWriter()
+{
+    stopWriting = false;
+    writer = boost::thread(&LoggerAgent::writeChunks, this);
+}
+
+void LoggerAgent::stopWriter()
+{
+    {
+        boost::mutex::scoped_lock lock(writerMtx);
+        stopWriting = true;
+    }
+    writerCondition.notify_one();
+    writer.join();
+}
+
+void LoggerAgent::writeChunks()
+{
+    while (true)
+    {
+        writePendingChunks();
+
+        boost::unique_lock<boost::mutex> lock(writerMtx);
+        if (stopWriting)
+        {
+            lock.unlock();
+            writePendingChunks();
+            return;
+        }
+        writerCondition.timed_wait(lock, boost::posix_time::milliseconds(WRITER_IDLE_WAIT_MS));
+    }
+}
+
+void LoggerAgent::writePendingChunks()
+{
+    Chunk* chunk = nullptr;
+    while (pendingChunks.pop(chunk))
+    {
+        Files::iterator it = streams.find(chunk->file);
+        if (it != streams.end() && it->second)
+        {
+            it->second->write(chunk->data.data(), chunk->data.size());
+        }
+        delete chunk;
+    }
 }
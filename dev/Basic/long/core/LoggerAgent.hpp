@@ -11,8 +11,15 @@
 #include "entities/Entity.hpp"
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/lockfree/queue.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
 
 namespace sim_mob
 {
@@ -21,12 +28,20 @@ namespace sim_mob
         /**
          * Entity responsible log messages in a thread-safe way without logs.
          * 
-         * This special agent uses the MessageBus to receive messages to log. 
+         * Each thread appends the lines it logs to its own buffer, one chunk 
+         * per file, without any lock. A chunk is handed over to a writer 
+         * thread when it is full, or when its thread logs again in a later 
+         * tick. The writer thread writes the chunks to their files as they 
+         * come, without flushing after each line.
+         * 
+         * The lines of a thread keep their order in each file, but the lines 
+         * of different threads may be interleaved differently from one run 
+         * to the next (as they were when they went through the MessageBus).
          * 
          * The output is depending on the given configuration.
          * 
-         * Attention: This agent is designed to work with SimMobility Workers and 
-         * MessageBus system. Do not use it within external threads.
+         * Attention: lines still buffered are only written by flush() or by 
+         * the destructor, which must not be called while other threads log.
          * 
          */
         class LoggerAgent : public Entity
@@ -96,6 +111,12 @@ namespace sim_mob
              * @param logMsg to print.
              */
             void log(LogFile outputType, const std::string& logMsg);
+
+            /**
+             * Writes all the buffered lines to their files and flushes them.
+             * No other thread may log during the call.
+             */
+            void flush();
             
         protected:
             /**
@@ -103,7 +124,6 @@ namespace sim_mob
              */
             virtual bool isNonspatial();
             virtual std::vector<sim_mob::BufferedBase*> buildSubscriptionList();
-            virtual void HandleMessage(messaging::Message::MessageType type, const messaging::Message& message);
 
         private:
             /**
@@ -112,11 +132,79 @@ namespace sim_mob
             void onWorkerEnter();
             void onWorkerExit();
 
+            /**
+             * Lines of one file logged by one thread, waiting to be written.
+             */
+            struct Chunk
+            {
+                Chunk(LogFile file) : file(file) {}
+
+                LogFile file;
+                std::string data;
+            };
+
+            /**
+             * Chunks being filled by one thread, indexed by file.
+             */
+            struct ThreadBuffer
+            {
+                ThreadBuffer() : chunks(LOG_NEARSET_POLYTECH_EZ_LINK + 1), epoch(0) {}
+
+                std::vector<std::string> chunks;
+                unsigned int epoch; ///< value of LoggerAgent::epoch when the chunks were started.
+            };
+
+            /**
+             * Returns the buffer of the calling thread, creating it if needed.
+             */
+            ThreadBuffer& getThreadBuffer();
+
+            /**
+             * Hands the non-empty chunks of the given buffer over to the writer thread.
+             */
+            void handOver(ThreadBuffer& buffer);
+
+            /**
+             * Hands the given chunk over to the writer thread, leaving it empty.
+             */
+            void handOver(LogFile file, std::string& data);
+
+            void startWriter();
+            void stopWriter();
+
+            /**
+             * Body of the writer thread: writes the chunks handed over until stopWriter() is called.
+             */
+            void writeChunks();
+            void writePendingChunks();
+
+            /**
+             * Cleanup function of threadBuffer: the buffers are deleted by the destructor instead, 
+             * once their lines have been handed over.
+             */
+            static void keepThreadBuffer(ThreadBuffer* buffer);
+
         private:
             typedef boost::unordered_map<LogFile, std::ofstream*> Files;
             boost::unordered_map<LogFile, std::ofstream*> streams; 
 
-            boost::mutex mtx;
+            /** buffer of each thread; owned by threadBuffers. */
+            boost::thread_specific_ptr<ThreadBuffer> threadBuffer;
+
+            /** buffers of all the threads which have logged. */
+            std::vector<ThreadBuffer*> threadBuffers;
+            boost::mutex threadBuffersMtx;
+
+            /** incremented at each tick; chunks started in an earlier tick are handed over at the next log. */
+            boost::atomic<unsigned int> epoch;
+
+            /** chunks handed over and not written yet. */
+            boost::lockfree::queue<Chunk*> pendingChunks;
+
+            boost::thread writer;
+            boost::mutex writerMtx;
+            boost::condition_variable writerCondition;
+            bool stopWriting;
 
         };
     }
@@ -14,6 +14,7 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
+#include "util/ColumnarSnapshot.hpp"
 
 namespace sim_mob
 {
@@ -54,6 +55,9 @@ namespace sim_mob
             ar & total_price;
         }
 
+        template void AlternativeHedonicPrice::serialize<snapshot::SnapshotOArchive>(snapshot::SnapshotOArchive& ar, const unsigned int version);
+        template void AlternativeHedonicPrice::serialize<snapshot::SnapshotIArchive>(snapshot::SnapshotIArchive& ar, const unsigned int version);
+
         void AlternativeHedonicPrice::saveData(std::vector<AlternativeHedonicPrice*> &altHedonicprices)
         {
             // make an archive
@@ -11,6 +11,7 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
+#include "util/ColumnarSnapshot.hpp"
 
 using namespace sim_mob;
 using namespace sim_mob::long_term;
@@ -111,6 +112,9 @@ void  Awakening::serialize(Archive & ar,const unsigned int version)
     ar & awakenClass3;
 }
 
+template void Awakening::serialize<snapshot::SnapshotOArchive>(snapshot::SnapshotOArchive& ar, const unsigned int version);
+template void Awakening::serialize<snapshot::SnapshotIArchive>(snapshot::SnapshotIArchive& ar, const unsigned int version);
+
 void  Awakening::saveData(std::vector<Awakening*> &awakenings)
 {
     // make an archive
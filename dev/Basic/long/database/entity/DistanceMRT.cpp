@@ -11,6 +11,7 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
+#include "util/ColumnarSnapshot.hpp"
 
 using namespace sim_mob::long_term;
 
@@ -27,6 +28,9 @@ void DistanceMRT::serialize(Archive & ar,const unsigned int version)
 
 }
 
+template void DistanceMRT::serialize<snapshot::SnapshotOArchive>(snapshot::SnapshotOArchive& ar, const unsigned int version);
+template void DistanceMRT::serialize<snapshot::SnapshotIArchive>(snapshot::SnapshotIArchive& ar, const unsigned int version);
+
 void DistanceMRT::saveData(std::vector<DistanceMRT*> &distMRT)
 {
     // make an archive
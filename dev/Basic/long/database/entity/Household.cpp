@@ -16,6 +16,7 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
+#include "util/ColumnarSnapshot.hpp"
 
 
 using namespace sim_mob::long_term;
@@ -127,6 +128,9 @@ void Household::serialize(Archive & ar,const unsigned int version)
 
 }
 
+template void Household::serialize<snapshot::SnapshotOArchive>(snapshot::SnapshotOArchive& ar, const unsigned int version);
+template void Household::serialize<snapshot::SnapshotIArchive>(snapshot::SnapshotIArchive& ar, const unsigned int version);
+
 Household::Household( const Household &source)
 {
     this->id = source.id;
@@ -13,6 +13,7 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
+#include "util/ColumnarSnapshot.hpp"
 
 
 using namespace sim_mob::long_term;
@@ -98,6 +99,9 @@ void Individual::serialize(Archive & ar,const unsigned int version)
 
 }
 
+template void Individual::serialize<snapshot::SnapshotOArchive>(snapshot::SnapshotOArchive& ar, const unsigned int version);
+template void Individual::serialize<snapshot::SnapshotIArchive>(snapshot::SnapshotIArchive& ar, const unsigned int version);
+
 void Individual::saveData(std::vector<Individual*> &individuals)
 {
     // make an archive
@@ -14,6 +14,7 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
+#include "util/ColumnarSnapshot.hpp"
 
 using namespace sim_mob::long_term;
 
@@ -124,6 +125,9 @@ void Parcel::serialize(Archive & ar,const unsigned int version)
     lastChangedDate.tm_year = lastChangedDate.tm_year+1900;
 
 }
+
+template void Parcel::serialize<snapshot::SnapshotOArchive>(snapshot::SnapshotOArchive& ar, const unsigned int version);
+template void Parcel::serialize<snapshot::SnapshotIArchive>(snapshot::SnapshotIArchive& ar, const unsigned int version);
 Parcel::Parcel( const Parcel& source)
 {
     this->id = source.id;
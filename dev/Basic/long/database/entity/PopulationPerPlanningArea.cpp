@@ -9,6 +9,7 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
+#include "util/ColumnarSnapshot.hpp"
 
 using namespace sim_mob::long_term;
 
@@ -61,6 +62,9 @@ void PopulationPerPlanningArea::serialize(Archive & ar,const unsigned int versio
 
 }
 
+template void PopulationPerPlanningArea::serialize<snapshot::SnapshotOArchive>(snapshot::SnapshotOArchive& ar, const unsigned int version);
+template void PopulationPerPlanningArea::serialize<snapshot::SnapshotIArchive>(snapshot::SnapshotIArchive& ar, const unsigned int version);
+
 void PopulationPerPlanningArea::saveData(std::vector<PopulationPerPlanningArea*> &s)
 {
     // make an archive
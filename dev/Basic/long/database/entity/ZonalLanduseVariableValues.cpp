@@ -13,6 +13,7 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
+#include "util/ColumnarSnapshot.hpp"
 
 using namespace sim_mob::long_term;
 
@@ -63,6 +64,9 @@ void ZonalLanduseVariableValues::serialize(Archive & ar,const unsigned int versi
 
 }
 
+template void ZonalLanduseVariableValues::serialize<snapshot::SnapshotOArchive>(snapshot::SnapshotOArchive& ar, const unsigned int version);
+template void ZonalLanduseVariableValues::serialize<snapshot::SnapshotIArchive>(snapshot::SnapshotIArchive& ar, const unsigned int version);
+
 void ZonalLanduseVariableValues::saveData(std::vector<ZonalLanduseVariableValues*> &zonalLanduseVarValues)
 {
     // make an archive
@@ -454,6 +454,7 @@ void performMain(int simulationNumber, std::list<std::string>& resLogFiles)
         PrintOutV("XML Config HousingModel householdBiddingWindow " << config.ltParams.housingModel.householdBiddingWindow << endl);
         PrintOutV("XML Config HousingModel householdBTOBiddingWindow " << config.ltParams.housingModel.householdBTOBiddingWindow << endl);
         PrintOutV("XML Config HousingModel householdAwakeningPercentageByBTO " << config.ltParams.housingModel.householdAwakeningPercentageByBTO << endl);
+        PrintOutV("XML Config HousingModel deterministicMarket " << config.ltParams.housingModel.deterministicMarket << " seed " << config.ltParams.housingModel.marketSeed << endl);
         PrintOutV("XML Config HousingModel offsetBetweenUnitBuyingAndSelling " << config.ltParams.housingModel.offsetBetweenUnitBuyingAndSelling << endl);
         PrintOutV("XML Config HousingModel offsetBetweenUnitBuyingAndSellingAdvanceSelling " << config.ltParams.housingModel.offsetBetweenUnitBuyingAndSellingAdvancedPurchase << endl);
         PrintOutV("XML Config HousingModel bid value a" << config.ltParams.housingModel.hedonicPriceModel.a << endl);
@@ -610,6 +611,9 @@ void performMain(int simulationNumber, std::list<std::string>& resLogFiles)
     }
     models.clear();
 
+    //write the lines still buffered by the logger.
+    agentsLookup.getLogger().flush();
+
     //reset singletons and stop watch.
     dataManager.reset();
     agentsLookup.reset();    
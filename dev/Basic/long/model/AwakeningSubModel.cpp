@@ -20,6 +20,7 @@
 #include "util/PrintLog.hpp"
 #include "util/SharedFunctions.hpp"
 #include "agent/impl/HouseholdAgent.hpp"
+#include "util/MarketDraws.hpp"
 
 using namespace std;
 
@@ -36,7 +37,7 @@ namespace sim_mob
             return futureTransitionOwn;
         }
 
-        bool  AwakeningSubModel::ComputeFutureTransition(Household *household, HM_Model *model, double &futureTransitionRate, double &futureTransitionRandomDraw )
+        bool  AwakeningSubModel::ComputeFutureTransition(Household *household, HM_Model *model, MarketDraws& draws, double &futureTransitionRate, double &futureTransitionRandomDraw )
         {
             std::string tenureTransitionId="";
             //The age category were set by the Jingsi shaw (xujs@mit.edu)
@@ -70,7 +71,7 @@ namespace sim_mob
                 }
             }
 
-            futureTransitionRandomDraw = (double)rand()/RAND_MAX;
+            futureTransitionRandomDraw = draws.next();
 
             if( futureTransitionRandomDraw < futureTransitionRate )
                 futureTransitionOwn = true; //Future transition is to OWN a unit
@@ -134,9 +135,12 @@ namespace sim_mob
             if( model->getAwakeningCounter() > config.ltParams.housingModel.awakeningModel.initialHouseholdsOnMarket)
                 return;
 
+            //random draws of this household for the day.
+            MarketDraws draws(MarketDraws::INITIAL_AWAKENING, household->getId(), day);
+
             if( config.ltParams.housingModel.awakeningModel.awakenModelRandom == true )
             {
-                float random = (float)rand() / RAND_MAX;
+                float random = draws.next();
 
                 if( random < 0.5 )
                     return;
@@ -179,7 +183,7 @@ namespace sim_mob
                 }
 
 
-                float r1 = (float)rand() / RAND_MAX;
+                float r1 = draws.next();
                 int lifestyle = 1;
 
                 if( r1 > class1 && r1 <= class1 + class2 )
@@ -191,7 +195,7 @@ namespace sim_mob
                     lifestyle = 3;
                 }
 
-                float r2 = (float)rand() / RAND_MAX;
+                float r2 = draws.next();
 
                 int ageCategory = 0;
 
@@ -241,7 +245,7 @@ namespace sim_mob
             {
                 double movingRate = movingProbability(household, model, true ) / 100.0;
 
-                double randomDrawMovingRate = (double)rand()/RAND_MAX;
+                double randomDrawMovingRate = draws.next();
 
                 if( randomDrawMovingRate > movingRate )
                     return;
@@ -249,7 +253,7 @@ namespace sim_mob
                 double futureTransitionRate = 0.0;
                 double futureTransitionRandomDraw = 0.0;
 
-                bool success = ComputeFutureTransition(household, model, futureTransitionRate, futureTransitionRandomDraw );
+                bool success = ComputeFutureTransition(household, model, draws, futureTransitionRate, futureTransitionRandomDraw );
 
                 if( success == false )
                     return;
@@ -277,7 +281,7 @@ namespace sim_mob
             household->setAwakenedDay(0);
             household->setLastBidStatus(0);
             household->setLastAwakenedDay(0);
-            int householdBiddingWindow = ( config.ltParams.housingModel.householdBiddingWindow ) * (double)rand() / RAND_MAX + 1;
+            int householdBiddingWindow = ( config.ltParams.housingModel.householdBiddingWindow ) * draws.next() + 1;
             household->setTimeOnMarket(householdBiddingWindow);
             agent->setHouseholdBiddingWindow(householdBiddingWindow);
             //note :: what happens if a household never bids during the bidding window?? where do we set the time off market for those households?
@@ -327,11 +331,14 @@ namespace sim_mob
 
             int n = 0;
 
+            //draws of the households to awaken; each household then draws whether it awakens.
+            MarketDraws householdDraws(MarketDraws::AWAKENED_HOUSEHOLDS, 0, day);
+
             for( ; n < dailyAwakenings; )
             {
                 ExternalEvent extEv;
 
-                BigSerial householdId = (double)rand()/RAND_MAX * model->getHouseholdList()->size();
+                BigSerial householdId = householdDraws.next() * model->getHouseholdList()->size();
 
                 Household *household = model->getHouseholdById(householdId);
 
@@ -361,14 +368,15 @@ namespace sim_mob
                 double futureTransitionRate = 0;
                 double futureTransitionRandomDraw = 0;
 
-                bool success = ComputeFutureTransition(household, model, futureTransitionRate, futureTransitionRandomDraw );
+                MarketDraws draws(MarketDraws::DAILY_AWAKENING, household->getId(), day);
+                bool success = ComputeFutureTransition(household, model, draws, futureTransitionRate, futureTransitionRandomDraw );
 
                 if (success == false)
                     continue;
 
                 double movingRate = movingProbability(household, model, false ) / 100.0;
 
-                double movingRateRandomDraw = (double)rand()/RAND_MAX;
+                double movingRateRandomDraw = draws.next();
 
                 if (movingRateRandomDraw > movingRate)
                     continue;
@@ -18,6 +18,8 @@ namespace sim_mob
 {
     namespace long_term
     {
+        class MarketDraws;
+
         class AwakeningSubModel
         {
         public:
@@ -31,7 +33,7 @@ namespace sim_mob
 
             double movingProbability(Household* household, HM_Model *model, bool day0);
 
-            bool ComputeFutureTransition(Household *household, HM_Model *model, double &futureTransitionRate, double &futureTransitionRandomDraw);
+            bool ComputeFutureTransition(Household *household, HM_Model *model, MarketDraws& draws, double &futureTransitionRate, double &futureTransitionRandomDraw);
 
         private:
 
@@ -53,6 +53,7 @@
 #include "util/PrintLog.hpp"
 #include "SOCI_ConvertersLong.hpp"
 #include "DatabaseHelper.hpp"
+#include "util/ColumnarSnapshot.hpp"
 #include <random>
 
 using namespace sim_mob;
@@ -63,6 +64,9 @@ using std::runtime_error;
 using std::string;
 namespace {
     const string MODEL_NAME = "Developer Model";
+
+    //snapshot of the day 0 parcels, written by the initial loading.
+    const string DAY0_SNAPSHOT = "devSnapshot";
 }
 
 DeveloperModel::DeveloperModel(WorkGroup& workGroup): Model(MODEL_NAME, workGroup), timeInterval( 30 ),dailyParcelCount(0),isParcelRemain(true),numSimulationDays(0),dailyAgentCount(0),isDevAgentsRemain(true),realEstateAgentIdIndex(0),housingMarketModel(nullptr),postcodeForDevAgent(0),initPostcode(false),unitIdForDevAgent(0),buildingIdForDevAgent(0),projectIdForDevAgent(0),devAgentCount(0),simYear(0),minLotSize(0),isRestart(false),OpSchemaLoadingInterval(0),startDay(0){ //In days (7 - weekly, 30 - Monthly)
@@ -241,12 +245,23 @@ void DeveloperModel::startImpl() {
     {
         processParcels();
         PrintOutV("Parcels processed"<<std::endl);
-        parcel->saveData(developmentCandidateParcelList,"developmentCandidateParcelList");
-        parcel->saveData(parcelsWithProjectsList,"parcelsWithProjectsList");
-        parcel->saveData(parcelsWithDay0Projects,"parcelsWithDay0Projects");
+        SnapshotWriter snapshot;
+        snapshot.addSection("developmentCandidateParcelList", developmentCandidateParcelList, &Parcel::getId);
+        snapshot.addSection("parcelsWithProjectsList", parcelsWithProjectsList, &Parcel::getId);
+        snapshot.addSection("parcelsWithDay0Projects", parcelsWithDay0Projects, &Parcel::getId);
+        snapshot.write(DAY0_SNAPSHOT);
+    }
+    else if (SnapshotReader::exists(DAY0_SNAPSHOT))
+    {
+        const SnapshotReader snapshot(DAY0_SNAPSHOT);
+        developmentCandidateParcelList = restoreParcels(snapshot, "developmentCandidateParcelList");
+        parcelsWithProjectsList = restoreParcels(snapshot, "parcelsWithProjectsList");
+        parcelsWithDay0Projects = restoreParcels(snapshot, "parcelsWithDay0Projects");
+        PrintOutV("Parcels restored from the day 0 snapshot, built from it " << snapshotParcels.size() << std::endl);
     }
     else
     {
+        //day 0 saved in the older format.
         developmentCandidateParcelList = parcel->loadSerializedData("developmentCandidateParcelList");
         parcelsWithProjectsList = parcel->loadSerializedData("parcelsWithProjectsList");
         parcelsWithDay0Projects  = parcel->loadSerializedData("parcelsWithDay0Projects");
@@ -303,6 +318,7 @@ void DeveloperModel::stopImpl() {
     clear_delete_vector(developmentTypeTemplates);
     clear_delete_vector(templateUnitTypes);
     clear_delete_vector(initParcelList);
+    clear_delete_vector(snapshotParcels);
     clear_delete_vector(existingProjectIds);
     clear_delete_vector(amenities);
     clear_delete_vector(macroEconomics);
@@ -556,6 +572,25 @@ void DeveloperModel::wakeUpDeveloperAgents(DeveloperList devAgentList)
     }
 }
 
+DeveloperModel::ParcelList DeveloperModel::restoreParcels(const SnapshotReader& snapshot, const std::string& section)
+{
+    //the index of the section gives the ids without building the parcels.
+    const std::vector<BigSerial> ids = snapshot.getIds(section);
+    ParcelList parcels;
+    parcels.reserve(ids.size());
+    for (size_t row = 0; row < ids.size(); row++)
+    {
+        Parcel* parcel = getParcelById(ids[row]);
+        if (parcel == nullptr)
+        {
+            parcel = snapshot.load<Parcel>(section, row);
+            snapshotParcels.push_back(parcel);
+        }
+        parcels.push_back(parcel);
+    }
+    return parcels;
+}
+
 void DeveloperModel::processParcels()
 {
     /**
@@ -49,6 +49,8 @@
 namespace sim_mob {
     namespace long_term {
 
+        class SnapshotReader;
+
         class DeveloperModel : public Model {
         public:
 
@@ -339,6 +341,13 @@ namespace sim_mob {
             void stopImpl();
 
         private:
+            /*
+             * parcels of the given section of the day 0 snapshot. The parcels
+             * already loaded from the database are used as they are; only the
+             * others are built from the snapshot, and kept in snapshotParcels.
+             */
+            ParcelList restoreParcels(const SnapshotReader& snapshot, const std::string& section);
+
             DeveloperList developers;
             TemplateList templates;
             ParcelList initParcelList;
@@ -349,6 +358,7 @@ namespace sim_mob {
             ParcelList freeholdParcels;
             ParcelList parcelsWithOngoingProjects; //this is loaded when the simulation is resumed from a previous run
             ParcelList parcelsWithDay0Projects;
+            ParcelList snapshotParcels; //parcels of the day 0 snapshot which were not loaded from the database
             BuildingList buildings;
             DevelopmentTypeTemplateList developmentTypeTemplates;
             TemplateUnitTypeList templateUnitTypes;
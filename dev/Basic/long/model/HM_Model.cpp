@@ -84,6 +84,10 @@
 
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
+#include "util/ColumnarSnapshot.hpp"
+#include "util/ParallelLoader.hpp"
+#include "util/MarketDraws.hpp"
+#include "database/DB_ConnectionPool.hpp"
 
 using namespace sim_mob;
 using namespace sim_mob::long_term;
@@ -100,6 +104,12 @@ namespace
 {
     const string MODEL_NAME = "Housing Market Model";
 
+    //snapshot of the day 0 state, written by the initial loading.
+    const string DAY0_SNAPSHOT = "hmSnapshot";
+
+    //number of tables loaded at the same time when the model starts.
+    const unsigned int STARTUP_LOADING_THREADS = 4;
+
     enum RESIDENTIAL_STATUS
     {
         RESIDENT = 1,
@@ -384,6 +394,11 @@ Establishment* HM_Model::getEstablishmentById(BigSerial id) const
 
 Individual* HM_Model::getIndividualById(BigSerial id) const
 {
+    if (individualsSnapshot)
+    {
+        return individualsSnapshot->get(id);
+    }
+
     IndividualMap::const_iterator itr = individualsById.find(id);
 
     if (itr != individualsById.end())
@@ -468,6 +483,11 @@ Household* HM_Model::getHouseholdWithBidsById( BigSerial id) const
 
 Awakening* HM_Model::getAwakeningById( BigSerial id) const
 {
+    if (awakeningSnapshot)
+    {
+        return awakeningSnapshot->get(id);
+    }
+
     AwakeningMap::const_iterator itr = awakeningById.find(id);
 
     if( itr != awakeningById.end())
@@ -837,6 +857,11 @@ HM_Model::DistMRTList HM_Model::getDistanceMRT()const
 
 DistanceMRT* HM_Model::getDistanceMRTById( BigSerial id) const
 {
+    if (mrtDistancesSnapshot)
+    {
+        return mrtDistancesSnapshot->get(id);
+    }
+
     DistMRTMap::const_iterator itr = mrtDistancesById.find(id);
 
     if (itr != mrtDistancesById.end())
@@ -965,6 +990,11 @@ std::vector<BigSerial> HM_Model::getTazByMtzVec( std::vector<Mtz*> vecMtz )
 
 ZonalLanduseVariableValues* HM_Model::getZonalLandUseByAlternativeId(int id)const
 {
+    if (zonalLanduseVariableValuesSnapshot)
+    {
+        return zonalLanduseVariableValuesSnapshot->get(id);
+    }
+
     ZonalLanduseVariableValuesMap::const_iterator itr = zonalLanduseVariableValuesById.find(id);
 
     if (itr != zonalLanduseVariableValuesById.end())
@@ -1503,46 +1533,90 @@ void HM_Model::startImpl()
 
     if (conn.isConnected() && conn_calibration.isConnected())
     {
-        loadLTVersion(conn);
-        loadStudyAreas(conn);
-        loadResidentialWTP_Coeffs(conn_calibration);
+        //the tables are loaded by independent steps, each over its own connection.
+        DB_ConnectionPool mainPool(sim_mob::db::POSTGRES, dbConfig, config.schemas.main_schema, STARTUP_LOADING_THREADS);
+        DB_ConnectionPool calibrationPool(sim_mob::db::POSTGRES, dbConfig, config.schemas.calibration_schema, STARTUP_LOADING_THREADS);
+        ParallelLoader loader(STARTUP_LOADING_THREADS);
 
-        loadData<ScreeningModelFactorsDao>( conn_calibration, screeningModelFactorsList, screeningModelFactorsMap, &ScreeningModelFactors::getId );
-        PrintOutV("Number of screening Model Factors: " << screeningModelFactorsList.size() << std::endl );
+        loader.add("lt_version", mainPool, [this](DB_Connection& conn) { loadLTVersion(conn); });
+        loader.add("study_area", mainPool, [this](DB_Connection& conn) { loadStudyAreas(conn); });
+        loader.add("residential_willingness_to_pay_coefficients", calibrationPool, [this](DB_Connection& conn) { loadResidentialWTP_Coeffs(conn); });
 
+        loader.add("screening_model_factors", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<ScreeningModelFactorsDao>( conn, screeningModelFactorsList, screeningModelFactorsMap, &ScreeningModelFactors::getId );
+            PrintOutV("Number of screening Model Factors: " << screeningModelFactorsList.size() << std::endl );
+        });
 
         if(config.ltParams.schoolAssignmentModel.enabled)
         {
-            loadSchools(conn);
-            loadTravelTime(conn_calibration);
-            loadEzLinkStops(conn_calibration);
-            loadStudentStops(conn_calibration);
-            loadSchoolDesks(conn);
+            loader.add("school", mainPool, [this](DB_Connection& conn) { loadSchools(conn); });
+            loader.add("travel_time", calibrationPool, [this](DB_Connection& conn) { loadTravelTime(conn); });
+            loader.add("ez_link_stop", calibrationPool, [this](DB_Connection& conn) { loadEzLinkStops(conn); });
+            loader.add("student_stop", calibrationPool, [this](DB_Connection& conn) { loadStudentStops(conn); });
+            loader.add("school_desk", mainPool, [this](DB_Connection& conn) { loadSchoolDesks(conn); });
 
-            loadData<HouseholdPlanningAreaDao>( conn, hhPlanningAreaList, hhPlanningAreaMap, &HouseholdPlanningArea::getHouseHoldId);
-            PrintOutV("Number of household planning area rows: " << hhPlanningAreaList.size() << std::endl );
+            loader.add("household_planning_area", mainPool, [this](DB_Connection& conn)
+            {
+                loadData<HouseholdPlanningAreaDao>( conn, hhPlanningAreaList, hhPlanningAreaMap, &HouseholdPlanningArea::getHouseHoldId);
+                PrintOutV("Number of household planning area rows: " << hhPlanningAreaList.size() << std::endl );
+            });
 
-            loadData<HHCoordinatesDao>( conn, hhCoordinates, hhCoordinatesById, &HHCoordinates::getHouseHoldId);
-            PrintOutV("Number of household coordinate rows: " << hhCoordinates.size() << std::endl );
+            loader.add("household_coordinates", mainPool, [this](DB_Connection& conn)
+            {
+                loadData<HHCoordinatesDao>( conn, hhCoordinates, hhCoordinatesById, &HHCoordinates::getHouseHoldId);
+                PrintOutV("Number of household coordinate rows: " << hhCoordinates.size() << std::endl );
+            });
 
-            loadData<SchoolAssignmentCoefficientsDao>( conn_calibration, schoolAssignmentCoefficients, SchoolAssignmentCoefficientsById, &SchoolAssignmentCoefficients::getParameterId);
-            PrintOutV("Number of School Assignment Coefficients rows: " << schoolAssignmentCoefficients.size() << std::endl );
+            loader.add("school_assignment_coefficients", calibrationPool, [this](DB_Connection& conn)
+            {
+                loadData<SchoolAssignmentCoefficientsDao>( conn, schoolAssignmentCoefficients, SchoolAssignmentCoefficientsById, &SchoolAssignmentCoefficients::getParameterId);
+                PrintOutV("Number of School Assignment Coefficients rows: " << schoolAssignmentCoefficients.size() << std::endl );
+            });
 
-            assignNearestUniToEzLinkStops();
-            assignNearestPolytechToEzLinkStops();
+            //both update the ez-link stops, so they run in the same step.
+            loader.add("nearest_schools_to_ez_link_stops", [this]()
+            {
+                assignNearestUniToEzLinkStops();
+                assignNearestPolytechToEzLinkStops();
+            }, {"school", "ez_link_stop", "student_stop"});
 
+            loader.add("school_individuals", mainPool, [this, simYear](DB_Connection& conn)
+            {
+                std::tm currentSimYear = getDateBySimDay(simYear,0);
+                IndividualDao indDao(conn);
+                primarySchoolIndList = indDao.getPrimarySchoolIndividual(currentSimYear);
+                //Index all primary school inds.
+                for (IndividualList::iterator it = primarySchoolIndList.begin(); it != primarySchoolIndList.end(); it++) {
+                    primarySchoolIndById.insert(std::make_pair((*it)->getId(), *it));
+                }
+
+                preSchoolIndList = indDao.getPreSchoolIndividual(currentSimYear);
+                //Index all pre school inds.
+                for (IndividualList::iterator it = preSchoolIndList.begin(); it != preSchoolIndList.end(); it++) {
+                    preSchoolIndById.insert(std::make_pair((*it)->getId(), *it));
+                }
+
+                PrintOutV("Number of pre school individuals: " << preSchoolIndList.size() << std::endl );
+                PrintOutV("Number of primary school individuals: " << primarySchoolIndList.size() << std::endl );
+            });
         }
 
         if(config.ltParams.jobAssignmentModel.enabled)
         {
-            loadJobsByTazAndIndustryType(conn);
-            loadJobAssignments(conn);
-            loadJobsByTazAndIndustryType(conn);
+            //the jobs are loaded twice, as they always were: every job is in jobsWithTazAndIndustryType twice, and
+            // assignIndividualJob() erases one entry per assignment.
+            loader.add("jobs_with_industry_type_and_taz", mainPool, [this](DB_Connection& conn)
+            {
+                loadJobsByTazAndIndustryType(conn);
+                loadJobsByTazAndIndustryType(conn);
+            });
+            loader.add("job_assignment_coefficients", mainPool, [this](DB_Connection& conn) { loadJobAssignments(conn); });
         }
 
+        loader.add("workers_grp_by_logsum_params", mainPool, [this, &config](DB_Connection& conn)
         {
-            soci::session sql;
-            sql.open(soci::postgresql, conn.getConnectionStr());
+            soci::session& sql = conn.getSession<soci::session>();
 
             std::string storedProc = config.schemas.calibration_schema + "workers_grp_by_logsum_params";
 
@@ -1559,13 +1633,11 @@ void HM_Model::startImpl()
             }
 
             PrintOutV("Number of WorkersGrpByLogsumParams: " << workersGrpByLogsumParams.size() << std::endl );
-        }
-
-
+        });
 
+        loader.add("building_match", mainPool, [this](DB_Connection& conn)
         {
-            soci::session sql;
-            sql.open(soci::postgresql, conn.getConnectionStr());
+            soci::session& sql = conn.getSession<soci::session>();
 
             std::string storedProc = conn.getSchema() + "building_match";
 
@@ -1582,12 +1654,11 @@ void HM_Model::startImpl()
             }
 
             PrintOutV("Number of BuildingMatch: " << buildingMatch.size() << std::endl );
-        }
-
+        });
 
+        loader.add("sla_building", mainPool, [this](DB_Connection& conn)
         {
-            soci::session sql;
-            sql.open(soci::postgresql, conn.getConnectionStr());
+            soci::session& sql = conn.getSession<soci::session>();
 
             std::string storedProc = conn.getSchema() + "sla_building";
 
@@ -1604,169 +1675,242 @@ void HM_Model::startImpl()
             }
 
             PrintOutV("Number of Sla Buildings: " << slaBuilding.size() << std::endl );
-        }
+        });
 
-        loadData<LogsumMtzV2Dao>( conn_calibration, logsumMtzV2, logsumMtzV2ById, &LogsumMtzV2::getTazId );
-        PrintOutV("Number of LogsumMtzV2: " << logsumMtzV2.size() << std::endl );
+        loader.add("logsum_mtz_v2", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<LogsumMtzV2Dao>( conn, logsumMtzV2, logsumMtzV2ById, &LogsumMtzV2::getTazId );
+            PrintOutV("Number of LogsumMtzV2: " << logsumMtzV2.size() << std::endl );
+        });
 
-        loadData<ScreeningModelCoefficientsDao>( conn_calibration, screeningModelCoefficientsList, screeningModelCoefficicientsMap, &ScreeningModelCoefficients::getId );
-        PrintOutV("Number of screening Model Coefficients: " << screeningModelCoefficientsList.size() << std::endl );
+        loader.add("screening_model_coefficients", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<ScreeningModelCoefficientsDao>( conn, screeningModelCoefficientsList, screeningModelCoefficicientsMap, &ScreeningModelCoefficients::getId );
+            PrintOutV("Number of screening Model Coefficients: " << screeningModelCoefficientsList.size() << std::endl );
+        });
 
         //if initial loading load data from database. otherwise load data from binary files saved in the disk from the initial run.
         if(initialLoading)
         {
-
             //Load households
-            loadData<HouseholdDao>(conn, households, householdsById, &Household::getId);
-            PrintOutV("Number of households: " << households.size() << " Households used: " << households.size()  << std::endl);
+            loader.add("household", mainPool, [this](DB_Connection& conn)
+            {
+                loadData<HouseholdDao>(conn, households, householdsById, &Household::getId);
+                PrintOutV("Number of households: " << households.size() << " Households used: " << households.size()  << std::endl);
+            });
 
             //load individuals
-            loadData<IndividualDao>(conn, individuals, individualsById, &Individual::getId);
-            PrintOutV("Initial Individuals: " << individuals.size() << std::endl);
+            loader.add("individual", mainPool, [this](DB_Connection& conn)
+            {
+                loadData<IndividualDao>(conn, individuals, individualsById, &Individual::getId);
+                PrintOutV("Initial Individuals: " << individuals.size() << std::endl);
+            });
 
-            loadData<AlternativeHedonicPriceDao>( conn, alternativeHedonicPrices, alternativeHedonicPriceById, &AlternativeHedonicPrice::getId );
-            PrintOutV("Number of Alternative Hedonic Price rows: " << alternativeHedonicPrices.size() << std::endl );
+            loader.add("alternative_hedonic_price", mainPool, [this](DB_Connection& conn)
+            {
+                loadData<AlternativeHedonicPriceDao>( conn, alternativeHedonicPrices, alternativeHedonicPriceById, &AlternativeHedonicPrice::getId );
+                PrintOutV("Number of Alternative Hedonic Price rows: " << alternativeHedonicPrices.size() << std::endl );
+            });
 
-            loadData<ZonalLanduseVariableValuesDao>( conn_calibration, zonalLanduseVariableValues, zonalLanduseVariableValuesById, &ZonalLanduseVariableValues::getAltId );
-            PrintOutV("Number of zonal landuse variable values: " << zonalLanduseVariableValues.size() << std::endl );
+            loader.add("zonal_landuse_variable_values", calibrationPool, [this](DB_Connection& conn)
+            {
+                loadData<ZonalLanduseVariableValuesDao>( conn, zonalLanduseVariableValues, zonalLanduseVariableValuesById, &ZonalLanduseVariableValues::getAltId );
+                PrintOutV("Number of zonal landuse variable values: " << zonalLanduseVariableValues.size() << std::endl );
+            });
 
-            loadData<PopulationPerPlanningAreaDao>( conn, populationPerPlanningArea, populationPerPlanningAreaById, &PopulationPerPlanningArea::getPlanningAreaId );
-            PrintOutV("Number of PopulationPerPlanningArea rows: " << populationPerPlanningArea.size() << std::endl );
+            loader.add("population_per_planning_area", mainPool, [this](DB_Connection& conn)
+            {
+                loadData<PopulationPerPlanningAreaDao>( conn, populationPerPlanningArea, populationPerPlanningAreaById, &PopulationPerPlanningArea::getPlanningAreaId );
+                PrintOutV("Number of PopulationPerPlanningArea rows: " << populationPerPlanningArea.size() << std::endl );
+            });
 
-            loadData<DistanceMRTDao>( conn, mrtDistances, mrtDistancesById, &DistanceMRT::getHouseholdId);
-            PrintOutV("Number of mrt distances: " << mrtDistances.size() << std::endl );
+            loader.add("distance_mrt", mainPool, [this](DB_Connection& conn)
+            {
+                loadData<DistanceMRTDao>( conn, mrtDistances, mrtDistancesById, &DistanceMRT::getHouseholdId);
+                PrintOutV("Number of mrt distances: " << mrtDistances.size() << std::endl );
+            });
 
-            loadData<AwakeningDao>(conn_calibration, awakening, awakeningById,  &Awakening::getId);
-            PrintOutV("Awakening probability: " << awakening.size() << std::endl );
+            loader.add("awakening", calibrationPool, [this](DB_Connection& conn)
+            {
+                loadData<AwakeningDao>(conn, awakening, awakeningById,  &Awakening::getId);
+                PrintOutV("Awakening probability: " << awakening.size() << std::endl );
+            });
         }
 
         //Load units
-        loadData<UnitDao>(conn, units, unitsById, &Unit::getId);
+        loader.add("unit", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<UnitDao>(conn, units, unitsById, &Unit::getId);
+            PrintOutV("Number of units: " << units.size() << ". Units Used: " << units.size() << std::endl);
+        });
+
         if(config.ltParams.launchPrivatePresale)
         {
-            UnitDao unitDao(conn);
-            privatePresaleUnits =  unitDao.getPrivatePresaleUnits();
-            for (UnitList::const_iterator it = privatePresaleUnits.begin(); it != privatePresaleUnits.end(); it++)
+            loader.add("private_presale_unit", mainPool, [this](DB_Connection& conn)
             {
-                privatePresaleUnitsMap.insert(std::make_pair((*it)->getId(), (*it)->getId()));
-            }
+                UnitDao unitDao(conn);
+                privatePresaleUnits =  unitDao.getPrivatePresaleUnits();
+                for (UnitList::const_iterator it = privatePresaleUnits.begin(); it != privatePresaleUnits.end(); it++)
+                {
+                    privatePresaleUnitsMap.insert(std::make_pair((*it)->getId(), (*it)->getId()));
+                }
+            });
         }
 
-        PrintOutV("Number of units: " << units.size() << ". Units Used: " << units.size() << std::endl);
-
-        HouseholdDao hhDao(conn);
-        std::tm currentSimYear = getDateBySimDay(simYear,0);
-        std::tm lastDayOfCurrentSimYear = getDateBySimDay(simYear,364);
-        pendingHouseholds = hhDao.getPendingHouseholds(currentSimYear,lastDayOfCurrentSimYear);
-
+        loader.add("pending_household", mainPool, [this, simYear](DB_Connection& conn)
+        {
+            HouseholdDao hhDao(conn);
+            std::tm currentSimYear = getDateBySimDay(simYear,0);
+            std::tm lastDayOfCurrentSimYear = getDateBySimDay(simYear,364);
+            pendingHouseholds = hhDao.getPendingHouseholds(currentSimYear,lastDayOfCurrentSimYear);
+        });
 
         //Load unit types
-        loadData<UnitTypeDao>(conn, unitTypes, unitTypesById, &UnitType::getId);
-        PrintOutV("Number of unit types: " << unitTypes.size() << std::endl);
-
-        if(config.ltParams.schoolAssignmentModel.enabled)
+        loader.add("unit_type", mainPool, [this](DB_Connection& conn)
         {
-            IndividualDao indDao(conn);
-            primarySchoolIndList = indDao.getPrimarySchoolIndividual(currentSimYear);
-            //Index all primary school inds.
-            for (IndividualList::iterator it = primarySchoolIndList.begin(); it != primarySchoolIndList.end(); it++) {
-                primarySchoolIndById.insert(std::make_pair((*it)->getId(), *it));
-            }
+            loadData<UnitTypeDao>(conn, unitTypes, unitTypesById, &UnitType::getId);
+            PrintOutV("Number of unit types: " << unitTypes.size() << std::endl);
+        });
 
-            preSchoolIndList = indDao.getPreSchoolIndividual(currentSimYear);
-            //Index all pre school inds.
-            for (IndividualList::iterator it = preSchoolIndList.begin(); it != preSchoolIndList.end(); it++) {
-                preSchoolIndById.insert(std::make_pair((*it)->getId(), *it));
-
-            }
-
-            loadData<HouseholdPlanningAreaDao>( conn, hhPlanningAreaList, hhPlanningAreaMap, &HouseholdPlanningArea::getHouseHoldId);
-            PrintOutV("Number of household planning area rows: " << hhPlanningAreaList.size() << std::endl );
-
-            loadData<HHCoordinatesDao>( conn, hhCoordinates, hhCoordinatesById, &HHCoordinates::getHouseHoldId);
-            PrintOutV("Number of household coordinate rows: " << hhCoordinates.size() << std::endl );
-
-            loadData<SchoolAssignmentCoefficientsDao>( conn_calibration, schoolAssignmentCoefficients, SchoolAssignmentCoefficientsById, &SchoolAssignmentCoefficients::getParameterId);
-            PrintOutV("Number of School Assignment Coefficients rows: " << schoolAssignmentCoefficients.size() << std::endl );
-
-            loadData<IndvidualEmpSecDao>( conn, indEmpSecList, indEmpSecbyIndId, &IndvidualEmpSec::getIndvidualId );
-            PrintOutV("Number of Indvidual Emp Sec rows: " << indEmpSecList.size() << std::endl );
-        }
-
-        PrintOutV("Number of pre school individuals: " << preSchoolIndList.size() << std::endl );
-        PrintOutV("Number of primary school individuals: " << primarySchoolIndList.size() << std::endl );
-
-        loadData<PostcodeDao>(conn, postcodes, postcodesById,   &Postcode::getAddressId);
-        PrintOutV("Number of postcodes: " << postcodes.size() << std::endl );
-        PrintOutV("Number of postcodes by id: " << postcodesById.size() << std::endl );
+        loader.add("postcode", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<PostcodeDao>(conn, postcodes, postcodesById,   &Postcode::getAddressId);
+            PrintOutV("Number of postcodes: " << postcodes.size() << std::endl );
+            PrintOutV("Number of postcodes by id: " << postcodesById.size() << std::endl );
+        });
 
-        loadData<VehicleOwnershipCoefficientsDao>(conn,vehicleOwnershipCoeffs,vehicleOwnershipCoeffsById, &VehicleOwnershipCoefficients::getVehicleOwnershipOptionId);
-        PrintOutV("Vehicle Ownership coefficients: " << vehicleOwnershipCoeffs.size() << std::endl );
+        loader.add("vehicle_ownership_coefficients", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<VehicleOwnershipCoefficientsDao>(conn,vehicleOwnershipCoeffs,vehicleOwnershipCoeffsById, &VehicleOwnershipCoefficients::getVehicleOwnershipOptionId);
+            PrintOutV("Vehicle Ownership coefficients: " << vehicleOwnershipCoeffs.size() << std::endl );
+        });
 
-        loadData<TaxiAccessCoefficientsDao>(conn_calibration,taxiAccessCoeffs,taxiAccessCoeffsById, &TaxiAccessCoefficients::getParameterId);
-        PrintOutV("Taxi access coefficients: " << taxiAccessCoeffs.size() << std::endl );
+        loader.add("taxi_access_coefficients", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<TaxiAccessCoefficientsDao>(conn,taxiAccessCoeffs,taxiAccessCoeffsById, &TaxiAccessCoefficients::getParameterId);
+            PrintOutV("Taxi access coefficients: " << taxiAccessCoeffs.size() << std::endl );
+        });
 
-        loadData<EstablishmentDao>(conn, establishments, establishmentsById, &Establishment::getId);
-        PrintOutV("Number of establishments: " << establishments.size() << std::endl );
+        loader.add("establishment", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<EstablishmentDao>(conn, establishments, establishmentsById, &Establishment::getId);
+            PrintOutV("Number of establishments: " << establishments.size() << std::endl );
+        });
 
-        loadData<JobDao>( conn, jobs, jobsById, &Job::getId);
-        PrintOutV("Number of jobs: " << jobs.size() << std::endl );
+        loader.add("job", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<JobDao>( conn, jobs, jobsById, &Job::getId);
+            PrintOutV("Number of jobs: " << jobs.size() << std::endl );
+        });
 
-        loadData<HousingInterestRateDao>( conn, housingInterestRates, housingInterestRatesById, &HousingInterestRate::getId);
-        PrintOutV("Number of interest rate quarters: " << housingInterestRates.size() << std::endl );
+        loader.add("housing_interest_rate", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<HousingInterestRateDao>( conn, housingInterestRates, housingInterestRatesById, &HousingInterestRate::getId);
+            PrintOutV("Number of interest rate quarters: " << housingInterestRates.size() << std::endl );
+        });
 
-        loadData<LogSumVehicleOwnershipDao>( conn, vehicleOwnershipLogsums, vehicleOwnershipLogsumById, &LogSumVehicleOwnership::getHouseholdId);
-        PrintOutV("Number of vehicle ownership logsums: " << vehicleOwnershipLogsums.size() << std::endl );
+        loader.add("vehicle_ownership_logsum", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<LogSumVehicleOwnershipDao>( conn, vehicleOwnershipLogsums, vehicleOwnershipLogsumById, &LogSumVehicleOwnership::getHouseholdId);
+            PrintOutV("Number of vehicle ownership logsums: " << vehicleOwnershipLogsums.size() << std::endl );
+        });
 
-        loadData<TazDao>( conn, tazs, tazById, &Taz::getId);
-        PrintOutV("Number of taz: " << tazs.size() << std::endl );
+        loader.add("taz", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<TazDao>( conn, tazs, tazById, &Taz::getId);
+            PrintOutV("Number of taz: " << tazs.size() << std::endl );
+        });
 
-        loadData<HouseHoldHitsSampleDao>( conn, houseHoldHits, houseHoldHitsById, &HouseHoldHitsSample::getHouseholdId);
-        PrintOutV("Number of houseHoldHits: " << houseHoldHits.size() << std::endl );
+        loader.add("household_hits_sample", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<HouseHoldHitsSampleDao>( conn, houseHoldHits, houseHoldHitsById, &HouseHoldHitsSample::getHouseholdId);
+            PrintOutV("Number of houseHoldHits: " << houseHoldHits.size() << std::endl );
+        });
 
-        loadData<TazLogsumWeightDao>( conn_calibration, tazLogsumWeights, tazLogsumWeightById, &TazLogsumWeight::getGroupLogsum );
-        PrintOutV("Number of tazLogsumWeights: " << tazLogsumWeights.size() << std::endl );
+        loader.add("taz_logsum_weight", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<TazLogsumWeightDao>( conn, tazLogsumWeights, tazLogsumWeightById, &TazLogsumWeight::getGroupLogsum );
+            PrintOutV("Number of tazLogsumWeights: " << tazLogsumWeights.size() << std::endl );
+        });
 
-        loadData<PlanningAreaDao>( conn, planningArea, planningAreaById, &PlanningArea::getId );
-        PrintOutV("Number of planning areas: " << planningArea.size() << std::endl );
+        loader.add("planning_area", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<PlanningAreaDao>( conn, planningArea, planningAreaById, &PlanningArea::getId );
+            PrintOutV("Number of planning areas: " << planningArea.size() << std::endl );
+        });
 
-        loadData<PlanningSubzoneDao>( conn, planningSubzone, planningSubzoneById, &PlanningSubzone::getId );
-        PrintOutV("Number of planing subzones: " << planningSubzone.size() << std::endl );
+        loader.add("planning_subzone", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<PlanningSubzoneDao>( conn, planningSubzone, planningSubzoneById, &PlanningSubzone::getId );
+            PrintOutV("Number of planing subzones: " << planningSubzone.size() << std::endl );
+        });
 
-        loadData<MtzDao>( conn, mtz, mtzById, &Mtz::getId );
-        PrintOutV("Number of Mtz: " << mtz.size() << std::endl );
+        loader.add("mtz", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<MtzDao>( conn, mtz, mtzById, &Mtz::getId );
+            PrintOutV("Number of Mtz: " << mtz.size() << std::endl );
+        });
 
-        loadData<MtzTazDao>( conn, mtzTaz, mtzTazById, &MtzTaz::getMtzId );
-        PrintOutV("Number of mtz taz lookups: " << mtzTaz.size() << std::endl );
+        loader.add("mtz_taz", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<MtzTazDao>( conn, mtzTaz, mtzTazById, &MtzTaz::getMtzId );
+            PrintOutV("Number of mtz taz lookups: " << mtzTaz.size() << std::endl );
+        });
 
-        loadData<AlternativeDao>( conn_calibration, alternative, alternativeById, &Alternative::getId );
-        PrintOutV("Number of alternative region names: " << alternative.size() << std::endl );
+        loader.add("alternative", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<AlternativeDao>( conn, alternative, alternativeById, &Alternative::getId );
+            PrintOutV("Number of alternative region names: " << alternative.size() << std::endl );
+        });
 
         //only used with Hits2008 data
         //loadData<Hits2008ScreeningProbDao>( conn, hits2008ScreeningProb, hits2008ScreeningProbById, &Hits2008ScreeningProb::getId );
         //PrintOutV("Number of hits2008 screening probabilities: " << hits2008ScreeningProb.size() << std::endl );
 
-        loadData<HitsIndividualLogsumDao>( conn, hitsIndividualLogsum, hitsIndividualLogsumById, &HitsIndividualLogsum::getId );
-        PrintOutV("Number of Hits Individual Logsum rows: " << hitsIndividualLogsum.size() << std::endl );
+        loader.add("hits_individual_logsum", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<HitsIndividualLogsumDao>( conn, hitsIndividualLogsum, hitsIndividualLogsumById, &HitsIndividualLogsum::getId );
+            PrintOutV("Number of Hits Individual Logsum rows: " << hitsIndividualLogsum.size() << std::endl );
+        });
 
-        loadData<IndvidualVehicleOwnershipLogsumDao>( conn_calibration, IndvidualVehicleOwnershipLogsums, IndvidualVehicleOwnershipLogsumById, &IndvidualVehicleOwnershipLogsum::getHouseholdId );
-        PrintOutV("Number of Hits Individual VehicleOwnership Logsum rows: " << IndvidualVehicleOwnershipLogsums.size() << std::endl );
+        loader.add("individual_vehicle_ownership_logsum", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<IndvidualVehicleOwnershipLogsumDao>( conn, IndvidualVehicleOwnershipLogsums, IndvidualVehicleOwnershipLogsumById, &IndvidualVehicleOwnershipLogsum::getHouseholdId );
+            PrintOutV("Number of Hits Individual VehicleOwnership Logsum rows: " << IndvidualVehicleOwnershipLogsums.size() << std::endl );
+        });
 
-        loadData<ScreeningCostTimeDao>( conn_calibration, screeningCostTime, screeningCostTimeById, &ScreeningCostTime::getId );
-        PrintOutV("Number of Screening Cost Time rows: " << screeningCostTime.size() << std::endl );
+        loader.add("screening_cost_time", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<ScreeningCostTimeDao>( conn, screeningCostTime, screeningCostTimeById, &ScreeningCostTime::getId );
+            PrintOutV("Number of Screening Cost Time rows: " << screeningCostTime.size() << std::endl );
+        });
 
-        loadData<AccessibilityFixedPzidDao>( conn_calibration, accessibilityFixedPzid, accessibilityFixedPzidById, &AccessibilityFixedPzid::getId );
-        PrintOutV("Number of Accessibility fixed pz id rows: " << accessibilityFixedPzid.size() << std::endl );
+        loader.add("accessibility_fixed_pzid", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<AccessibilityFixedPzidDao>( conn, accessibilityFixedPzid, accessibilityFixedPzidById, &AccessibilityFixedPzid::getId );
+            PrintOutV("Number of Accessibility fixed pz id rows: " << accessibilityFixedPzid.size() << std::endl );
+        });
 
-        loadData<TenureTransitionRateDao>( conn_calibration, tenureTransitionRate, tenureTransitionRateById, &TenureTransitionRate::getId );
-        PrintOutV("Number of Tenure Transition rate rows: " << tenureTransitionRate.size() << std::endl );
+        loader.add("tenure_transition_rate", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<TenureTransitionRateDao>( conn, tenureTransitionRate, tenureTransitionRateById, &TenureTransitionRate::getId );
+            PrintOutV("Number of Tenure Transition rate rows: " << tenureTransitionRate.size() << std::endl );
+        });
 
-        loadData<OwnerTenantMovingRateDao>( conn_calibration, ownerTenantMovingRate, ownerTenantMovingRateById, &OwnerTenantMovingRate::getId );
-        PrintOutV("Number of Owner Tenant Moving Rate rows: " << ownerTenantMovingRate.size() << std::endl );
+        loader.add("owner_tenant_moving_rate", calibrationPool, [this](DB_Connection& conn)
+        {
+            loadData<OwnerTenantMovingRateDao>( conn, ownerTenantMovingRate, ownerTenantMovingRateById, &OwnerTenantMovingRate::getId );
+            PrintOutV("Number of Owner Tenant Moving Rate rows: " << ownerTenantMovingRate.size() << std::endl );
+        });
 
-        loadData<IndvidualEmpSecDao>( conn, indEmpSecList, indEmpSecbyIndId, &IndvidualEmpSec::getIndvidualId );
-        PrintOutV("Number of Indvidual Emp Sec rows: " << indEmpSecList.size() << std::endl );
+        loader.add("individual_emp_sec", mainPool, [this](DB_Connection& conn)
+        {
+            loadData<IndvidualEmpSecDao>( conn, indEmpSecList, indEmpSecbyIndId, &IndvidualEmpSec::getIndvidualId );
+            PrintOutV("Number of Indvidual Emp Sec rows: " << indEmpSecList.size() << std::endl );
+        });
 
+        loader.run();
+        loader.printTimings();
     }
 
 
@@ -2032,17 +2176,13 @@ void HM_Model::startImpl()
             int timeOffMarket = 0;
 
 
+            //random draws of this unit for its entry in the market.
+            MarketDraws draws(MarketDraws::UNIT_MARKET_ENTRY, (*it)->getId(), 0);
+
             if(!resume)
             {
-                std::random_device genTimeOn;
-                std::mt19937 genRdTimeOn(genTimeOn());
-                std::uniform_int_distribution<int> disRdTimeOn(1,  config.ltParams.housingModel.timeOnMarket);
-                timeOnMarket = disRdTimeOn(genTimeOn);
-
-                std::random_device genTimeOff;
-                std::mt19937 genRdTimeOff(genTimeOff());
-                std::uniform_int_distribution<int> disRdTimeOff(1,  config.ltParams.housingModel.timeOffMarket);
-                timeOffMarket = disRdTimeOff(genTimeOff);
+                timeOnMarket = 1 + draws.nextIndex(config.ltParams.housingModel.timeOnMarket);
+                timeOffMarket = 1 + draws.nextIndex(config.ltParams.housingModel.timeOffMarket);
 
                 (*it)->setTimeOnMarket(timeOnMarket );
                 (*it)->setTimeOffMarket(timeOffMarket );
@@ -2054,7 +2194,7 @@ void HM_Model::startImpl()
                 {
                     if(!resume)
                     {
-                    float awakeningProbability = (float)rand() / RAND_MAX;
+                    float awakeningProbability = draws.next();
 
                     if( awakeningProbability < config.ltParams.housingModel.vacantUnitActivationProbability )
                     {
@@ -2286,47 +2426,73 @@ void HM_Model::startImpl()
     //save day0 after all the preprocessing
     if(initialLoading)
     {
-        hh->saveData(households);
-        popPerPA->saveData(populationPerPlanningArea);
-        ind->saveData(individuals);
-        altHedonicPrice->saveData(alternativeHedonicPrices);
-        zonalLU_VarVals->saveData(zonalLanduseVariableValues);
-        mrtDistPerHH->saveData(mrtDistances);
-        awakeningPtr->saveData(awakening);
+        SnapshotWriter snapshot;
+        snapshot.addSection("households", households, &Household::getId);
+        snapshot.addSection("populationPerPlanningArea", populationPerPlanningArea, &PopulationPerPlanningArea::getPlanningAreaId);
+        snapshot.addSection("individuals", individuals, &Individual::getId);
+        snapshot.addSection("alternativeHedonicPrices", alternativeHedonicPrices, &AlternativeHedonicPrice::getId);
+        snapshot.addSection("zonalLanduseVariableValues", zonalLanduseVariableValues, &ZonalLanduseVariableValues::getAltId);
+        snapshot.addSection("mrtDistances", mrtDistances, &DistanceMRT::getHouseholdId);
+        snapshot.addSection("awakening", awakening, &Awakening::getId);
+        snapshot.write(DAY0_SNAPSHOT);
         //unit->saveData(units);
 
     }
 
     if(!initialLoading)
     {
-        households = hh->loadSerializedData();
+        if (SnapshotReader::exists(DAY0_SNAPSHOT))
+        {
+            //households are iterated to create the agents, and the small sections are iterated too, so they are built now.
+            //The other sections are only looked up by id: their entities are built from the snapshot when they are first requested.
+            const boost::shared_ptr<const SnapshotReader> snapshot(new SnapshotReader(DAY0_SNAPSHOT));
+            households = snapshot->loadAll<Household>("households");
+            populationPerPlanningArea = snapshot->loadAll<PopulationPerPlanningArea>("populationPerPlanningArea");
+            alternativeHedonicPrices = snapshot->loadAll<AlternativeHedonicPrice>("alternativeHedonicPrices");
+
+            individualsSnapshot.reset(new SnapshotSection<Individual>(snapshot, "individuals"));
+            awakeningSnapshot.reset(new SnapshotSection<Awakening>(snapshot, "awakening"));
+            mrtDistancesSnapshot.reset(new SnapshotSection<DistanceMRT>(snapshot, "mrtDistances"));
+            zonalLanduseVariableValuesSnapshot.reset(new SnapshotSection<ZonalLanduseVariableValues>(snapshot, "zonalLanduseVariableValues"));
+
+            PrintOutV("individuals mapped from disk"<<individualsSnapshot->size() << std::endl );
+            PrintOutV("zonalLanduseVariableValues mapped from disk"<<zonalLanduseVariableValuesSnapshot->size() << std::endl );
+            PrintOutV("mrtDistances mapped from disk"<<mrtDistancesSnapshot->size() << std::endl );
+            PrintOutV("awakening mapped from disk"<<awakeningSnapshot->size() << std::endl );
+        }
+        else
+        {
+            //day 0 saved in the older format.
+            households = hh->loadSerializedData();
+            populationPerPlanningArea = popPerPA->loadSerializedData();
+            individuals = ind->loadSerializedData();
+            alternativeHedonicPrices = altHedonicPrice->loadSerializedData();
+            zonalLanduseVariableValues = zonalLU_VarVals->loadSerializedData();
+            mrtDistances = mrtDistPerHH->loadSerializedData();
+            awakening = awakeningPtr->loadSerializedData();
+
+            indexData(individuals,individualsById,&Individual::getId);
+            PrintOutV("individuals loaded from disk"<<individuals.size() << std::endl );
+
+            indexData(zonalLanduseVariableValues,zonalLanduseVariableValuesById,&ZonalLanduseVariableValues::getAltId);
+            PrintOutV("zonalLanduseVariableValues loaded from disk"<<zonalLanduseVariableValues.size() << std::endl );
+
+            indexData(mrtDistances,mrtDistancesById,&DistanceMRT::getHouseholdId);
+            PrintOutV("mrtDistances loaded from disk"<<mrtDistances.size() << std::endl );
+
+            indexData(awakening,awakeningById,&Awakening::getId);
+            PrintOutV("awakening loaded from disk"<<awakening.size() << std::endl );
+        }
+
         indexData(households, householdsById, &Household::getId);
         PrintOutV("hh agents loaded from disk"<<households.size() << std::endl );
 
-        populationPerPlanningArea = popPerPA->loadSerializedData();
         indexData(populationPerPlanningArea,populationPerPlanningAreaById,&PopulationPerPlanningArea::getPlanningAreaId);
         PrintOutV("populationPerPlanningArea loaded from disk"<<populationPerPlanningArea.size() << std::endl );
 
-        individuals = ind->loadSerializedData();
-        indexData(individuals,individualsById,&Individual::getId);
-        PrintOutV("individuals loaded from disk"<<individuals.size() << std::endl );
-
-        alternativeHedonicPrices = altHedonicPrice->loadSerializedData();
         indexData(alternativeHedonicPrices,alternativeHedonicPriceById,&AlternativeHedonicPrice::getId);
         PrintOutV("alternativeHedonicPrice loaded from disk"<<alternativeHedonicPrices.size() << std::endl );
 
-        zonalLanduseVariableValues = zonalLU_VarVals->loadSerializedData();
-        indexData(zonalLanduseVariableValues,zonalLanduseVariableValuesById,&ZonalLanduseVariableValues::getAltId);
-        PrintOutV("zonalLanduseVariableValues loaded from disk"<<zonalLanduseVariableValues.size() << std::endl );
-
-        mrtDistances = mrtDistPerHH->loadSerializedData();
-        indexData(mrtDistances,mrtDistancesById,&DistanceMRT::getHouseholdId);
-        PrintOutV("mrtDistances loaded from disk"<<mrtDistances.size() << std::endl );
-
-        awakening = awakeningPtr->loadSerializedData();
-        indexData(awakening,awakeningById,&Awakening::getId);
-        PrintOutV("awakening loaded from disk"<<awakening.size() << std::endl );
-
         for (HouseholdList::iterator it = households.begin();   it != households.end(); it++)
         {
             if ((*it)->getId()!=0)
@@ -3697,10 +3863,16 @@ void HM_Model::unitsFiltering()
     PrintOutV( "[Prefilter] Total number of Condos: " << numOfCondo << std::endl );
     PrintOutV( "Total units " << units.size() << std::endl );
 
-    srand(time(0));
+    //the deterministic market draws the units from its seed instead.
+    if (!MarketDraws::isDeterministic())
+    {
+        srand(time(0));
+    }
+    MarketDraws draws(MarketDraws::UNITS_FILTERING, 0, 0);
+
     for( int n = 0;  n < targetNumOfHDB; )
     {
-        int random =  (double)rand() / RAND_MAX * units.size();
+        int random =  draws.nextIndex(units.size());
 
         if( units[random]->getUnitType() < LS70_APT )
         {
@@ -3711,7 +3883,7 @@ void HM_Model::unitsFiltering()
 
     for( int n = 0;  n < targetNumOfCondo; )
     {
-        int random =  (double)rand() / RAND_MAX * units.size();
+        int random =  draws.nextIndex(units.size());
 
         if( units[random]->getUnitType() >= LS70_APT && units[random]->getUnitType() < LG379_RC )
         {
@@ -4856,6 +5028,8 @@ School* HM_Model::getSchoolById(BigSerial schoolId) const
 
 void HM_Model::stopImpl()
 {
+    PredayLT_LogsumManager::saveLogsumCache();
+
     deleteAll(stats);
     clear_delete_vector(households);
     clear_delete_vector(units);
@@ -4863,4 +5037,8 @@ void HM_Model::stopImpl()
     householdsById.clear();
     unitsById.clear();
     resumptionHHById.clear();
+    individualsSnapshot.reset();
+    awakeningSnapshot.reset();
+    mrtDistancesSnapshot.reset();
+    zonalLanduseVariableValuesSnapshot.reset();
 }
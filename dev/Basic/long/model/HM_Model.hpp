@@ -65,6 +65,8 @@
 #include "database/entity/SchoolDesk.hpp"
 #include "core/HousingMarket.hpp"
 #include "boost/unordered_map.hpp"
+#include "boost/shared_ptr.hpp"
+#include "util/ColumnarSnapshot.hpp"
 #include "DeveloperModel.hpp"
 #include "agent/impl/HouseholdAgent.hpp"
 #include "database/entity/ResidentialWTP_Coefs.hpp"
@@ -413,6 +415,7 @@ namespace sim_mob
             LogSumVehicleOwnership* getVehicleOwnershipLogsumsById( BigSerial id) const;
             void setTaxiAccess2008(const Household *household);
             void setTaxiAccess2012(const Household *household);
+            ///Empty when the model was restored from the day 0 snapshot, which serves getDistanceMRTById() instead.
             DistMRTList getDistanceMRT()const;
             DistanceMRT* getDistanceMRTById( BigSerial id) const;
             HouseHoldHitsSampleList getHouseHoldHits()const;
@@ -608,6 +611,11 @@ namespace sim_mob
 
             IndividualList individuals;
             IndividualMap individualsById;
+            ///Sections of the day 0 snapshot which are only looked up by id; set in place of the maps when the model is restored from it.
+            boost::shared_ptr<SnapshotSection<Individual> > individualsSnapshot;
+            boost::shared_ptr<SnapshotSection<Awakening> > awakeningSnapshot;
+            boost::shared_ptr<SnapshotSection<DistanceMRT> > mrtDistancesSnapshot;
+            boost::shared_ptr<SnapshotSection<ZonalLanduseVariableValues> > zonalLanduseVariableValuesSnapshot;
             IndividualList primarySchoolIndList;
             IndividualList preSchoolIndList;
             IndividualMap primarySchoolIndById;
@@ -153,7 +153,7 @@ ExternalEventsModel::~ExternalEventsModel() {}
 
 void ExternalEventsModel::getExternalEvents(int day, vector<ExternalEvent>& outValues) const
 {
-    LuaRef funcRef = getGlobal(state.get(), "getExternalEvents");
+    const LuaRef& funcRef = getFunction("getExternalEvents");
     LuaRef retVal = funcRef(day);
 
     if (retVal.isTable())
@@ -234,7 +234,7 @@ void HM_LuaModel::calulateUnitExpectations(const Unit& unit, int timeOnMarket, d
     assert(0);
     PrintOutV("We no longer use this function.");
     const BigSerial pcId = 0;//unit.getSlaAddressId();
-    LuaRef funcRef = getGlobal(state.get(), "calulateUnitExpectations");
+    const LuaRef& funcRef = getFunction("calulateUnitExpectations");
 
     LuaRef retVal = funcRef(&unit, timeOnMarket, logsum, lagCoefficient, getBuilding(unit.getBuildingId()), getPostcode(pcId), getAmenities(pcId));
 
@@ -264,7 +264,7 @@ double HM_LuaModel::calculateHedonicPrice(const Unit& unit) const
     assert(0);
     PrintOutV("We no longer use this function.");
     const BigSerial pcId = 0;//unit.getSlaAddressId();
-    LuaRef funcRef = getGlobal(state.get(), "calculateHedonicPrice");
+    const LuaRef& funcRef = getFunction("calculateHedonicPrice");
     LuaRef retVal = funcRef(&unit, getBuilding(unit.getBuildingId()), getPostcode(pcId), getAmenities(pcId));
     if (retVal.isNumber()) {
         return retVal.cast<double>();
@@ -274,7 +274,7 @@ double HM_LuaModel::calculateHedonicPrice(const Unit& unit) const
 
 double HM_LuaModel::calculateSpeculation(const HousingMarket::Entry& entry, int unitBids) const
 {
-    LuaRef funcRef = getGlobal(state.get(), "calculateSpeculation");
+    const LuaRef& funcRef = getFunction("calculateSpeculation");
     LuaRef retVal = funcRef(&entry, unitBids);
 
     if (retVal.isNumber())
@@ -290,7 +290,7 @@ double HM_LuaModel::calulateWP(const Household& hh, const Unit& unit, const HM_M
     assert(0);
     PrintOutV("We no longer use this function.");
     const BigSerial pcId = 0;//unit.getSlaAddressId();
-    LuaRef funcRef = getGlobal(state.get(), "calculateWP");
+    const LuaRef& funcRef = getFunction("calculateWP");
     LuaRef retVal = funcRef(&hh, &unit, &stats, getAmenities(pcId));
     if (retVal.isNumber())
     {
@@ -326,7 +326,7 @@ void DeveloperLuaModel::mapClasses()
 
 double DeveloperLuaModel::calculateUnitRevenue(const PotentialUnit& unit,const ParcelAmenities& amenities, double logsum, int quarter, int futureYear, double HPIfromData,int age) const {
 
-    LuaRef funcRef = getGlobal(state.get(), "calculateUnitRevenue");
+    const LuaRef& funcRef = getFunction("calculateUnitRevenue");
     LuaRef retVal = funcRef(&unit, &amenities, logsum, quarter,futureYear,HPIfromData,age);
 
     if (retVal.isNumber())
@@ -34,6 +34,7 @@
 #include "model/WillingnessToPaySubModel.hpp"
 #include "util/PrintLog.hpp"
 #include "model/VehicleOwnershipModel.hpp"
+#include "util/MarketDraws.hpp"
 
 
 using std::list;
@@ -141,7 +142,7 @@ void HouseholdBidderRole::CurrentBiddingEntry::setWtp_e(double value)
 
 
 HouseholdBidderRole::HouseholdBidderRole(HouseholdAgent* parent): parent(parent), waitingForResponse(false), lastTime(0, 0), bidOnCurrentDay(false), active(false), unitIdToBeOwned(0),
-                                                                  moveInWaitingTimeInDays(-1),vehicleBuyingWaitingTimeInDays(0), day(0), initBidderRole(true),year(0),bidComplete(true){}
+                                                                  moveInWaitingTimeInDays(-1),vehicleBuyingWaitingTimeInDays(0), day(0), bidsOnDay(0), initBidderRole(true),year(0),bidComplete(true){}
 
 HouseholdBidderRole::~HouseholdBidderRole(){}
 
@@ -324,6 +325,7 @@ void HouseholdBidderRole::init()
 void HouseholdBidderRole::update(timeslice now)
 {
     day = now.ms();
+    bidsOnDay = 0;
 
     if(initBidderRole)
     {
@@ -478,11 +480,14 @@ bool HouseholdBidderRole::bidUnit(timeslice now)
                 PrintOutV("[day " << day << "] Household " << std::dec << household->getId() << " submitted a bid of $" << biddingEntry.getBestBid() << "[wp:$" << biddingEntry.getWP() << ",bids:"  <<   biddingEntry.getTries() << ",ap:$" << entry->getAskingPrice() << "] on unit " << biddingEntry.getUnitId() << " to seller " <<  entry->getOwner()->getId() << "." << std::endl );
                 #endif
 
-                Bid newBid(model->getBidId(),household->getUnitId(),entry->getUnitId(), household->getId(), getParent(), biddingEntry.getBestBid(), now.ms()-1, biddingEntry.getWP(), biddingEntry.getWtp_e(), biddingEntry.getAffordability());
+                //with the deterministic market, the id does not depend on the order in which the households bid.
+                BigSerial bidId = MarketDraws::isDeterministic() ? MarketDraws::bidId(day, household->getId(), bidsOnDay) : model->getBidId();
+                bidsOnDay++;
+                Bid newBid(bidId,household->getUnitId(),entry->getUnitId(), household->getId(), getParent(), biddingEntry.getBestBid(), now.ms()-1, biddingEntry.getWP(), biddingEntry.getWtp_e(), biddingEntry.getAffordability());
                 bid(entry->getOwner(), newBid);
                 Statistics::increment(Statistics::N_BIDS);
                 model->incrementBids();
-                writeNewBidsToFile(model->getBidId(),household->getUnitId(),entry->getUnitId(), household->getId(), biddingEntry.getBestBid(), now.ms());
+                writeNewBidsToFile(bidId,household->getUnitId(),entry->getUnitId(), household->getId(), biddingEntry.getBestBid(), now.ms());
                 ConfigParams& config = ConfigManager::GetInstanceRW().FullConfig();
                 //add the bids active on last day to op schema
                 if(now.ms() == (config.ltParams.days-1))
@@ -630,10 +635,11 @@ bool HouseholdBidderRole::pickEntryToBid()
 
     const double minUnitsInZoneHousingType = 2;
 
-    //get available entries (for preferable zones if exists)
-    HousingMarket::ConstEntryList entries;
+    //random draws of this household for the day.
+    MarketDraws draws(MarketDraws::BIDDER_CHOICE_SET, household->getId(), day);
 
-    market->getAvailableEntries(entries);
+    //all the entries; only those available (buy/sell interval completed) are screened.
+    const HousingMarket::EntryArray& entries = market->getEntries();
 
     BigSerial maxEntryUnitId = INVALID_ID;
     double maxSurplus = INT_MIN; // holds the wp of the entry with maximum surplus.
@@ -666,10 +672,13 @@ bool HouseholdBidderRole::pickEntryToBid()
 
     if(config.ltParams.housingModel.bidderUnitChoiceset.randomChoiceset == true)
     {
-        while (screenedEntries.size() < config.ltParams.housingModel.bidderUnitChoiceset.bidderChoicesetSize)
+        //give up once every entry had ten chances to be drawn, in case too few entries are available.
+        for (size_t attempts = 0; attempts < 10 * entries.size() && screenedEntries.size() < config.ltParams.housingModel.bidderUnitChoiceset.bidderChoicesetSize; attempts++)
         {
-            double randomDraw = (double) rand() / RAND_MAX * entries.size();
-            screenedEntries.insert(entries[randomDraw]);
+            const HousingMarket::Entry* entry = entries[draws.nextIndex(entries.size())];
+
+            if (entry->isBuySellIntervalCompleted())
+                screenedEntries.insert(entry);
         }
     }
     else
@@ -677,7 +686,7 @@ bool HouseholdBidderRole::pickEntryToBid()
     {
         for (int n = 0; n < entries.size() && screenedEntries.size() < config.ltParams.housingModel.bidderUnitChoiceset.bidderChoicesetSize; n++)
         {
-            double randomDraw = (double) rand() / RAND_MAX;
+            double randomDraw = draws.next();
             int zoneHousingType = -1;
             double cummulativeProbability = 0.0;
             for (int m = 0; m < householdScreeningProbabilities.size(); m++)
@@ -691,8 +700,8 @@ bool HouseholdBidderRole::pickEntryToBid()
             }
 
 
-            auto range = market->getunitsByZoneHousingType().equal_range(zoneHousingType);
-            int numUnits = distance(range.first, range.second); //find the number of units in the above zoneHousingType
+            const HousingMarket::EntryArray* zoneHousingTypeEntries = market->getEntriesByZoneHousingType(zoneHousingType);
+            int numUnits = zoneHousingTypeEntries ? zoneHousingTypeEntries->size() : 0; //find the number of units in the above zoneHousingType
 
             if (numUnits < minUnitsInZoneHousingType)
                 continue;
@@ -701,13 +710,8 @@ bool HouseholdBidderRole::pickEntryToBid()
             if (numUnits == 0)
                 continue;
 
-            int offset = (float) rand() / RAND_MAX * (numUnits - 1);
-            advance(range.first, offset); // change a random unit in that zoneHousingType
-
-            const BigSerial unitId = (range.first)->second;
-
-
-            const HousingMarket::Entry *entry = market->getEntryById(unitId);
+            int offset = draws.next() * (numUnits - 1);
+            const HousingMarket::Entry *entry = (*zoneHousingTypeEntries)[offset]; // change a random unit in that zoneHousingType
 
             if (entry == nullptr || entry->isBuySellIntervalCompleted() == false)
                 continue;
@@ -745,23 +749,29 @@ bool HouseholdBidderRole::pickEntryToBid()
             screenedEntriesVec.push_back(*itr);
 
 
-        //btoEntries will contain pointers all the units in our 'units' vector that are marked as BTOs.
-        set<BigSerial> btoEntries = market->getBTOEntries();
+        //btoEntries contains all the entries of the market that are marked as BTOs.
+        const HousingMarket::EntryArray& btoEntries = market->getBTOEntries();
 
-        //Add x number of BTO units to the screenedUnit vector if the household is eligible for it
-        for(int n = 0; n < config.ltParams.housingModel.bidderUnitChoiceset.bidderBTOChoicesetSize && btoEntries.size() != 0; n++)
+        //Add x number of BTO units to the screenedUnit vector if the household is eligible for it.
+        //The units are drawn without replacement by a partial Fisher-Yates shuffle of the indexes of btoEntries;
+        //drawnIndexes only holds the indexes which were swapped.
+        boost::unordered_map<size_t, size_t> drawnIndexes;
+        size_t remainingBTOEntries = btoEntries.size();
+        for(int n = 0; n < config.ltParams.housingModel.bidderUnitChoiceset.bidderBTOChoicesetSize && remainingBTOEntries != 0; n++)
         {
-            int offset = (float)rand() / RAND_MAX * ( btoEntries.size() - 1 );
+            size_t offset = draws.next() * ( remainingBTOEntries - 1 );
+            remainingBTOEntries--;
+
+            boost::unordered_map<size_t, size_t>::const_iterator drawnItr = drawnIndexes.find(offset);
+            size_t index = (drawnItr != drawnIndexes.end()) ? drawnItr->second : offset;
 
-            auto itr =  btoEntries.begin();
-            std::advance( itr, offset);
+            drawnItr = drawnIndexes.find(remainingBTOEntries);
+            drawnIndexes[offset] = (drawnItr != drawnIndexes.end()) ? drawnItr->second : remainingBTOEntries;
 
-            const HousingMarket::Entry* entry = market->getEntryById(*itr);
+            const HousingMarket::Entry* entry = btoEntries[index];
 
             screenedEntries.insert(entry);
             screenedEntriesVec.push_back(entry);
-
-            btoEntries.erase(*itr);
         }
 
         std::string choiceset(" ");
@@ -160,6 +160,8 @@ namespace sim_mob
             bool bidComplete;
             int vehicleBuyingWaitingTimeInDays;
             uint32_t day;
+            ///number of bids made on the current day.
+            unsigned int bidsOnDay;
             int year;
 
             enum EthnicityId
@@ -32,6 +32,7 @@
 #include "database/entity/UnitSale.hpp"
 #include "database/entity/HouseholdUnit.hpp"
 #include "util/PrintLog.hpp"
+#include "util/MarketDraws.hpp"
 
 using namespace sim_mob;
 using namespace sim_mob::long_term;
@@ -423,7 +424,6 @@ void HouseholdSellerRole::handleReceivedBid(const Bid &bid, BigSerial unitId)
 {
     bool decision = false;
     ExpectationEntry entry;
-    const double dHalf = 0.5;
 
     if(getCurrentExpectation(unitId, entry))
     {
@@ -452,29 +452,9 @@ void HouseholdSellerRole::handleReceivedBid(const Bid &bid, BigSerial unitId)
             {
                 maxBidsOfDay.insert(std::make_pair(unitId, bid));
             }
-            else if( fabs(maxBidOfDay->getBidValue() - bid.getBidValue()) < EPSILON )
+            else if(MarketDraws::prefers(bid, *maxBidOfDay))
             {
-                // bids are exactly equal. Randomly choose one.
-
-                double randomDraw = (double)rand()/RAND_MAX;
-
-                //drop the current bid
-                if(randomDraw < dHalf)
-                {
-                    replyBid(*getParent(), *maxBidOfDay, entry, BETTER_OFFER, dailyBidCounter);
-                    maxBidsOfDay.erase(unitId);
-
-                    //update the new bid and bidder.
-                    maxBidsOfDay.insert(std::make_pair(unitId, bid));
-                }
-                else //keep the current bid
-                {
-                    replyBid(*getParent(), bid, entry, BETTER_OFFER, dailyBidCounter);
-                }
-            }
-            else if(maxBidOfDay->getBidValue() < bid.getBidValue())
-            {
-                // bid is higher than the current one of the day.
+                // bid is higher than the current one of the day (or equal, and won the tie break).
                 // it is necessary to notify the old max bidder
                 // that his bid was not accepted.
                 //reply to sender.
@@ -484,7 +464,7 @@ void HouseholdSellerRole::handleReceivedBid(const Bid &bid, BigSerial unitId)
                 //update the new bid and bidder.
                 maxBidsOfDay.insert(std::make_pair(unitId, bid));
             }
-            else
+            else //keep the current bid
             {
                 replyBid(*getParent(), bid, entry, BETTER_OFFER, dailyBidCounter);
             }
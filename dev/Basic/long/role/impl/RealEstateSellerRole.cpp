@@ -27,6 +27,7 @@
 #include "conf/ConfigParams.hpp"
 #include "util/SharedFunctions.hpp"
 #include "model/HedonicPriceSubModel.hpp"
+#include "util/MarketDraws.hpp"
 
 using namespace sim_mob;
 using namespace sim_mob::long_term;
@@ -346,7 +347,6 @@ void RealEstateSellerRole::HandleMessage(Message::MessageType type, const Messag
             bool decision = false;
             ExpectationEntry entry;
 
-            const double dHalf = 0.5;
 
             if(getCurrentExpectation(unitId, entry))
             {
@@ -371,29 +371,9 @@ void RealEstateSellerRole::HandleMessage(Message::MessageType type, const Messag
                     {
                         maxBidsOfDay.insert(std::make_pair(unitId, msg.getBid()));
                     }
-                    else if( fabs(maxBidOfDay->getBidValue() - msg.getBid().getBidValue()) < EPSILON)
+                    else if(MarketDraws::prefers(msg.getBid(), *maxBidOfDay))
                     {
-                        // bids are equal (i.e so close the difference is less that EPSILON). Randomly choose one.
-
-                        double randomDraw = (double)rand()/RAND_MAX;
-
-                        //drop the current bid
-                        if(randomDraw < dHalf)
-                        {
-                            replyBid(*dynamic_cast<RealEstateAgent*>(getParent()), *maxBidOfDay, entry, BETTER_OFFER, dailyBidCounter);
-                            maxBidsOfDay.erase(unitId);
-
-                            //update the new bid and bidder.
-                            maxBidsOfDay.insert(std::make_pair(unitId, msg.getBid()));
-                        }
-                        else //keep the current bid
-                        {
-                            replyBid(*dynamic_cast<RealEstateAgent*>(getParent()), msg.getBid(), entry, BETTER_OFFER, dailyBidCounter);
-                        }
-                    }
-                    else if(maxBidOfDay->getBidValue() < msg.getBid().getBidValue())
-                    {
-                        // bid is higher than the current one of the day.
+                        // bid is higher than the current one of the day (or equal, and won the tie break).
                         // it is necessary to notify the old max bidder
                         // that his bid was not accepted.
                         //reply to sender.
@@ -403,7 +383,7 @@ void RealEstateSellerRole::HandleMessage(Message::MessageType type, const Messag
                         //update the new bid and bidder.
                         maxBidsOfDay.insert(std::make_pair(unitId, msg.getBid()));
                     }
-                    else
+                    else //keep the current bid
                     {
                         replyBid(*dynamic_cast<RealEstateAgent*>(getParent()), msg.getBid(), entry, BETTER_OFFER, dailyBidCounter);
                     }
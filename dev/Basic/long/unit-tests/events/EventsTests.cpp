@@ -106,6 +106,31 @@ namespace {
         int receivedCallbackNonEvents;
     };
 
+    /**
+     * Listener which unsubscribes itself and subscribes another listener
+     * when it is notified.
+     */
+    class TestReentrantListener : public EventListener {
+    public:
+
+        TestReentrantListener(TestPublisher& publisher, TestListener& other)
+        : publisher(publisher), other(other), receivedEvents(0) {
+        }
+
+        virtual void onEvent(sim_mob::event::EventId id,
+                sim_mob::event::Context ctxId,
+                sim_mob::event::EventPublisher* sender,
+                const EventArgs& args) {
+            receivedEvents++;
+            publisher.unSubscribe(id, this);
+            publisher.subscribe(id, &other);
+        }
+
+        TestPublisher& publisher;
+        TestListener& other;
+        int receivedEvents;
+    };
+
 }
 
 /**
@@ -324,6 +349,27 @@ void testDifferentEventArgs() {
     assert(listener.receivedEvents == 3);
 }
 
+/**
+ * Tests subscriptions changed by a listener while publishing
+ */
+void testSubscribeWhilePublishing() {
+    TestObj obj;
+    TestObjContainer obj1(obj);
+    TestListener listener;
+    TestPublisher publisher;
+    TestReentrantListener reentrant(publisher, listener);
+    publisher.registerEvent(1);
+    publisher.subscribe(1, &reentrant);
+    publisher.publish(1, TestEventArgs(obj1));
+    publisher.publish(1, TestEventArgs(obj1));
+    publisher.publish(1, TestEventArgs(obj1));
+
+    assert(reentrant.receivedEvents == 1);
+    assert(listener.receivedCallbackNonEvents == 2);
+    assert(listener.receivedEvents == 2);
+    assert(publisher.getPublishCount(1) == 3);
+}
+
 void EventsTests::testAll() {
     testUnregister();
     testEvent();
@@ -334,4 +380,5 @@ void EventsTests::testAll() {
     testUnsubscribeAll();
     testUnsubscribeAllWithContext();
     testDifferentEventArgs();
+    testSubscribeWhilePublishing();
 }
\ No newline at end of file
@@ -0,0 +1,217 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/*
+ * ColumnarSnapshotTests.cpp
+ */
+
+#include "ColumnarSnapshotTests.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include "util/ColumnarSnapshot.hpp"
+
+using namespace sim_mob::long_term;
+using namespace unit_tests;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::ColumnarSnapshotTests);
+
+namespace
+{
+    const char* SNAPSHOT_FILE = "ColumnarSnapshotTests.snapshot";
+
+    ///Serialized like the entities of the long-term model, including the vector given again element by element.
+    class TestEntity
+    {
+    public:
+        TestEntity(BigSerial id = 0) : id(id), count(0), value(0), flag(false)
+        {
+        }
+
+        template<class Archive>
+        void serialize(Archive& ar, const unsigned int version)
+        {
+            ar & id;
+            ar & count;
+            ar & BOOST_SERIALIZATION_NVP(value);
+            ar & name;
+            ar & members;
+            for (size_t i = 0; i < members.size(); i++)
+            {
+                ar & members[i];
+            }
+            ar & flag;
+        }
+
+        BigSerial getId() const
+        {
+            return id;
+        }
+
+        BigSerial id;
+        int count;
+        double value;
+        std::string name;
+        std::vector<BigSerial> members;
+        bool flag;
+    };
+
+    std::vector<TestEntity*> createEntities(size_t size)
+    {
+        std::vector<TestEntity*> entities;
+        for (size_t n = 0; n < size; n++)
+        {
+            //ids are written in decreasing order to exercise the index.
+            TestEntity* entity = new TestEntity(1000 - n);
+            entity->count = n;
+            entity->value = n * 0.25;
+            entity->name = std::string(n % 5, 'a' + n % 26);
+            entity->members.assign(n % 4, n);
+            entity->flag = (n % 2 == 0);
+            entities.push_back(entity);
+        }
+        return entities;
+    }
+
+    ///Requests all the entities of the section, in an order which depends on the thread.
+    void getEntities(const SnapshotSection<TestEntity>* section, const std::vector<BigSerial>* ids, size_t first, std::vector<TestEntity*>* res)
+    {
+        res->assign(ids->size(), nullptr);
+        for (size_t n = 0; n < ids->size(); n++)
+        {
+            const size_t row = (first + n) % ids->size();
+            (*res)[row] = section->get((*ids)[row]);
+        }
+    }
+
+    void deleteEntities(std::vector<TestEntity*>& entities)
+    {
+        for (std::vector<TestEntity*>::iterator it = entities.begin(); it != entities.end(); it++)
+        {
+            delete *it;
+        }
+        entities.clear();
+    }
+}
+
+void ColumnarSnapshotTests::testRoundTrip()
+{
+    std::vector<TestEntity*> entities = createEntities(100);
+    SnapshotWriter writer;
+    writer.addSection("entities", entities, &TestEntity::getId);
+    writer.addSection("empty", std::vector<TestEntity*>(), &TestEntity::getId);
+    writer.write(SNAPSHOT_FILE);
+
+    {
+        const SnapshotReader reader(SNAPSHOT_FILE);
+        CPPUNIT_ASSERT(reader.hasSection("entities"));
+        CPPUNIT_ASSERT(!reader.hasSection("missing"));
+        CPPUNIT_ASSERT_EQUAL(size_t(0), reader.getRowCount("empty"));
+
+        std::vector<TestEntity*> loaded = reader.loadAll<TestEntity>("entities");
+        CPPUNIT_ASSERT_EQUAL(entities.size(), loaded.size());
+        for (size_t n = 0; n < entities.size(); n++)
+        {
+            CPPUNIT_ASSERT_EQUAL(entities[n]->id, loaded[n]->id);
+            CPPUNIT_ASSERT_EQUAL(entities[n]->count, loaded[n]->count);
+            CPPUNIT_ASSERT_EQUAL(entities[n]->value, loaded[n]->value);
+            CPPUNIT_ASSERT_EQUAL(entities[n]->name, loaded[n]->name);
+            CPPUNIT_ASSERT(entities[n]->members == loaded[n]->members);
+            CPPUNIT_ASSERT_EQUAL(entities[n]->flag, loaded[n]->flag);
+        }
+        deleteEntities(loaded);
+    }
+    deleteEntities(entities);
+    std::remove(SNAPSHOT_FILE);
+}
+
+void ColumnarSnapshotTests::testLoadById()
+{
+    std::vector<TestEntity*> entities = createEntities(50);
+    SnapshotWriter writer;
+    writer.addSection("entities", entities, &TestEntity::getId);
+    writer.write(SNAPSHOT_FILE);
+
+    {
+        const SnapshotReader reader(SNAPSHOT_FILE);
+        size_t row = 0;
+        CPPUNIT_ASSERT(reader.findRow("entities", 990, row));
+        CPPUNIT_ASSERT_EQUAL(size_t(10), row);
+
+        TestEntity* entity = reader.loadById<TestEntity>("entities", 960);
+        CPPUNIT_ASSERT(entity != nullptr);
+        CPPUNIT_ASSERT_EQUAL(40, entity->count);
+        delete entity;
+
+        CPPUNIT_ASSERT(reader.loadById<TestEntity>("entities", 2000) == nullptr);
+        CPPUNIT_ASSERT_THROW(reader.getRowCount("missing"), std::runtime_error);
+    }
+    deleteEntities(entities);
+    std::remove(SNAPSHOT_FILE);
+}
+
+void ColumnarSnapshotTests::testSnapshotSection()
+{
+    std::vector<TestEntity*> entities = createEntities(50);
+    SnapshotWriter writer;
+    writer.addSection("entities", entities, &TestEntity::getId);
+    writer.write(SNAPSHOT_FILE);
+
+    {
+        const boost::shared_ptr<const SnapshotReader> reader(new SnapshotReader(SNAPSHOT_FILE));
+        const std::vector<BigSerial> ids = reader->getIds("entities");
+        CPPUNIT_ASSERT_EQUAL(entities.size(), ids.size());
+        for (size_t n = 0; n < entities.size(); n++)
+        {
+            CPPUNIT_ASSERT_EQUAL(entities[n]->id, ids[n]);
+        }
+
+        const SnapshotSection<TestEntity> section(reader, "entities");
+        CPPUNIT_ASSERT_EQUAL(entities.size(), section.size());
+        TestEntity* entity = section.get(960);
+        CPPUNIT_ASSERT(entity != nullptr);
+        CPPUNIT_ASSERT_EQUAL(40, entity->count);
+        CPPUNIT_ASSERT(section.get(960) == entity);
+        CPPUNIT_ASSERT(section.get(2000) == nullptr);
+
+        std::vector<std::vector<TestEntity*> > built(4);
+        boost::thread_group threads;
+        for (size_t n = 0; n < built.size(); n++)
+        {
+            threads.create_thread(boost::bind(&getEntities, &section, &ids, n * 13, &built[n]));
+        }
+        threads.join_all();
+        for (size_t n = 0; n < built.size(); n++)
+        {
+            CPPUNIT_ASSERT(built[n] == built[0]);
+        }
+        CPPUNIT_ASSERT(built[0][40] == entity);
+        for (size_t n = 0; n < entities.size(); n++)
+        {
+            CPPUNIT_ASSERT_EQUAL(entities[n]->name, built[0][n]->name);
+        }
+
+        CPPUNIT_ASSERT_THROW(SnapshotSection<TestEntity>(reader, "missing"), std::runtime_error);
+    }
+    deleteEntities(entities);
+    std::remove(SNAPSHOT_FILE);
+}
+
+void ColumnarSnapshotTests::testInvalidFile()
+{
+    {
+        std::ofstream file(SNAPSHOT_FILE);
+        file << "this is not a snapshot, but it is long enough to hold a header";
+    }
+    CPPUNIT_ASSERT_THROW(SnapshotReader reader(SNAPSHOT_FILE), std::runtime_error);
+    std::remove(SNAPSHOT_FILE);
+
+    CPPUNIT_ASSERT(!SnapshotReader::exists(SNAPSHOT_FILE));
+    CPPUNIT_ASSERT_THROW(SnapshotReader reader(SNAPSHOT_FILE), std::runtime_error);
+}
@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/*
+ * ColumnarSnapshotTests.hpp
+ */
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests {
+
+class ColumnarSnapshotTests : public CppUnit::TestFixture
+{
+public:
+    ///Entities written to a snapshot are read back with the same fields, including strings and vectors.
+    void testRoundTrip();
+
+    ///Entities can be read one by one through the id index.
+    void testLoadById();
+
+    ///Entities of a section are built once, the first time they are requested by id, from several threads at once.
+    void testSnapshotSection();
+
+    ///Files which are not snapshots are rejected.
+    void testInvalidFile();
+
+private:
+    CPPUNIT_TEST_SUITE(ColumnarSnapshotTests);
+        CPPUNIT_TEST(testRoundTrip);
+        CPPUNIT_TEST(testLoadById);
+        CPPUNIT_TEST(testSnapshotSection);
+        CPPUNIT_TEST(testInvalidFile);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,224 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/*
+ * MarketDrawsTests.cpp
+ */
+
+#include "MarketDrawsTests.hpp"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/thread.hpp>
+#include "database/entity/Bid.hpp"
+#include "util/MarketDraws.hpp"
+
+using namespace sim_mob::long_term;
+using namespace unit_tests;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::MarketDrawsTests);
+
+namespace
+{
+    const unsigned int SEED = 12345;
+    const BigSerial NUM_HOUSEHOLDS = 400;
+    const BigSerial NUM_UNITS = 60;
+    const int DAY = 3;
+
+    typedef std::map<BigSerial, Bid> BestBids;
+
+    /**
+     * Bids of the households on a day, one each, on a unit drawn from their choice set stream. There are few bid
+     * values, so that sellers get equal bids, and values closer than EPSILON which are not equal to each other.
+     */
+    std::vector<Bid> makeBids()
+    {
+        const double values[] = { 1000.0, 1000.0 + 0.6 * EPSILON, 1000.0 + 1.2 * EPSILON, 1000.0 + 1.2 * EPSILON, 900.0 };
+        std::vector<Bid> bids;
+        for (BigSerial householdId = 1; householdId <= NUM_HOUSEHOLDS; householdId++)
+        {
+            MarketDraws draws(SEED, MarketDraws::BIDDER_CHOICE_SET, householdId, DAY);
+            BigSerial unitId = 1 + draws.nextIndex(NUM_UNITS);
+            bids.push_back(Bid(MarketDraws::bidId(DAY, householdId, 0), INVALID_ID, unitId, householdId, nullptr,
+                               values[householdId % 5], DAY, 0.0, 0.0, 0.0));
+        }
+        return bids;
+    }
+
+    /**
+     * Keeps the best bid of each unit, in the order of arrival, like HouseholdSellerRole::handleReceivedBid() and
+     * RealEstateSellerRole::HandleMessage() with the deterministic market.
+     */
+    void receiveBid(const Bid& bid, BestBids* bestBids, boost::mutex* mutex)
+    {
+        boost::mutex::scoped_lock lock(*mutex);
+        BestBids::iterator best = bestBids->find(bid.getNewUnitId());
+        if (best == bestBids->end())
+        {
+            bestBids->insert(std::make_pair(bid.getNewUnitId(), bid));
+        }
+        else if (MarketDraws::prefers(SEED, bid, best->second))
+        {
+            best->second = bid;
+        }
+    }
+
+    BestBids receiveBids(const std::vector<Bid>& bids)
+    {
+        BestBids bestBids;
+        boost::mutex mutex;
+        for (std::vector<Bid>::const_iterator it = bids.begin(); it != bids.end(); it++)
+        {
+            receiveBid(*it, &bestBids, &mutex);
+        }
+        return bestBids;
+    }
+
+    /**
+     * Bids sent by the households handled by one worker, interleaved with the other workers.
+     */
+    void sendBids(size_t worker, size_t numWorkers, const std::vector<Bid>* bids, BestBids* bestBids, boost::mutex* mutex)
+    {
+        for (size_t i = worker; i < bids->size(); i += numWorkers)
+        {
+            receiveBid((*bids)[i], bestBids, mutex);
+        }
+    }
+
+    /**
+     * @return the bidder of the best bid of each unit.
+     */
+    std::map<BigSerial, BigSerial> winners(const BestBids& bestBids)
+    {
+        std::map<BigSerial, BigSerial> res;
+        for (BestBids::const_iterator it = bestBids.begin(); it != bestBids.end(); it++)
+        {
+            res[it->first] = it->second.getBidderId();
+        }
+        return res;
+    }
+}
+
+void MarketDrawsTests::testBestBidIgnoresArrivalOrder()
+{
+    std::vector<Bid> bids = makeBids();
+    const BestBids bestBids = receiveBids(bids);
+    const std::map<BigSerial, BigSerial> expected = winners(bestBids);
+
+    //the best bid of each unit has its highest value; some units had to break ties
+    std::map<BigSerial, std::vector<const Bid*> > bidsByUnit;
+    for (std::vector<Bid>::const_iterator it = bids.begin(); it != bids.end(); it++)
+    {
+        bidsByUnit[it->getNewUnitId()].push_back(&*it);
+    }
+    CPPUNIT_ASSERT(expected.size() == bidsByUnit.size());
+    size_t numTies = 0;
+    for (std::map<BigSerial, std::vector<const Bid*> >::const_iterator unit = bidsByUnit.begin(); unit != bidsByUnit.end(); unit++)
+    {
+        double maxValue = 0.0;
+        size_t numMax = 0;
+        for (size_t i = 0; i < unit->second.size(); i++)
+        {
+            const Bid& bid = *unit->second[i];
+            if (bid.getBidValue() > maxValue)
+            {
+                maxValue = bid.getBidValue();
+                numMax = 0;
+            }
+            if (bid.getBidValue() == maxValue)
+            {
+                numMax++;
+            }
+
+            //a strict order: exactly one of two bids is preferred
+            for (size_t j = 0; j < unit->second.size(); j++)
+            {
+                CPPUNIT_ASSERT(MarketDraws::prefers(SEED, bid, *unit->second[j]) != (i == j || MarketDraws::prefers(SEED, *unit->second[j], bid)));
+            }
+        }
+        CPPUNIT_ASSERT(maxValue == bestBids.find(unit->first)->second.getBidValue());
+        numTies += (numMax > 1);
+    }
+    CPPUNIT_ASSERT(numTies > 0);
+
+    //the same winners whatever the order of arrival: reversed, shuffled, and from several threads
+    std::reverse(bids.begin(), bids.end());
+    CPPUNIT_ASSERT(expected == winners(receiveBids(bids)));
+
+    boost::mt19937 generator(SEED);
+    for (int n = 0; n < 50; n++)
+    {
+        for (size_t i = bids.size() - 1; i > 0; i--)
+        {
+            std::swap(bids[i], bids[boost::uniform_int<size_t>(0, i)(generator)]);
+        }
+        CPPUNIT_ASSERT(expected == winners(receiveBids(bids)));
+    }
+
+    const size_t threadCounts[] = { 3, 4, 7 };
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++)
+    {
+        BestBids threadBestBids;
+        boost::mutex mutex;
+        boost::thread_group workers;
+        for (size_t worker = 0; worker < threadCounts[i]; worker++)
+        {
+            workers.create_thread(boost::bind(&sendBids, worker, threadCounts[i], &bids, &threadBestBids, &mutex));
+        }
+        workers.join_all();
+        CPPUNIT_ASSERT(expected == winners(threadBestBids));
+    }
+}
+
+void MarketDrawsTests::testDrawStreams()
+{
+    MarketDraws draws(SEED, MarketDraws::BIDDER_CHOICE_SET, 42, 3);
+    MarketDraws same(SEED, MarketDraws::BIDDER_CHOICE_SET, 42, 3);
+    MarketDraws otherSeed(SEED + 1, MarketDraws::BIDDER_CHOICE_SET, 42, 3);
+    MarketDraws otherPurpose(SEED, MarketDraws::DAILY_AWAKENING, 42, 3);
+    MarketDraws otherHousehold(SEED, MarketDraws::BIDDER_CHOICE_SET, 43, 3);
+    MarketDraws otherDay(SEED, MarketDraws::BIDDER_CHOICE_SET, 42, 4);
+    MarketDraws otherSequence(SEED, MarketDraws::BIDDER_CHOICE_SET, 42, 3, 1);
+
+    double first = draws.next();
+    CPPUNIT_ASSERT(first >= 0.0 && first < 1.0);
+    CPPUNIT_ASSERT(first == same.next());
+    CPPUNIT_ASSERT(first != otherSeed.next());
+    CPPUNIT_ASSERT(first != otherPurpose.next());
+    CPPUNIT_ASSERT(first != otherHousehold.next());
+    CPPUNIT_ASSERT(first != otherDay.next());
+    CPPUNIT_ASSERT(first != otherSequence.next());
+
+    for (int n = 0; n < 1000; n++)
+    {
+        CPPUNIT_ASSERT(draws.nextIndex(5) < 5);
+    }
+}
+
+void MarketDrawsTests::testBidIdsAndTieBreak()
+{
+    std::set<BigSerial> ids;
+    for (int day = 0; day < 3; day++)
+    {
+        for (BigSerial householdId = 1; householdId < 300; householdId++)
+        {
+            ids.insert(MarketDraws::bidId(day, householdId, 0));
+            ids.insert(MarketDraws::bidId(day, householdId, 1));
+        }
+    }
+    CPPUNIT_ASSERT(ids.size() == 3 * 299 * 2);
+    CPPUNIT_ASSERT(MarketDraws::bidId(2, 1, 0) > MarketDraws::bidId(1, 299, 1));
+    CPPUNIT_ASSERT(MarketDraws::bidId(365 * 40, 5000000, 3) > 0);
+
+    for (BigSerial bidder = 1; bidder < 100; bidder++)
+    {
+        CPPUNIT_ASSERT(MarketDraws::prefers(SEED, 7, 1, bidder, bidder + 1) != MarketDraws::prefers(SEED, 7, 1, bidder + 1, bidder));
+    }
+}
@@ -0,0 +1,36 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/*
+ * MarketDrawsTests.hpp
+ */
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests {
+
+class MarketDrawsTests : public CppUnit::TestFixture
+{
+public:
+    ///Sellers keep the same bid on each unit whatever the order in which the bids arrive, including ties.
+    void testBestBidIgnoresArrivalOrder();
+
+    ///The draws depend on the seed, the purpose, the household, the day and the sequence only.
+    void testDrawStreams();
+
+    ///Bid ids are unique per day, household and sequence, and the tie break does not depend on the argument order.
+    void testBidIdsAndTieBreak();
+
+private:
+    CPPUNIT_TEST_SUITE(MarketDrawsTests);
+        CPPUNIT_TEST(testBestBidIgnoresArrivalOrder);
+        CPPUNIT_TEST(testDrawStreams);
+        CPPUNIT_TEST(testBidIdsAndTieBreak);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
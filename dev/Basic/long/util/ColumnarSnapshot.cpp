@@ -0,0 +1,367 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//license.txt   (http://opensource.org/licenses/MIT)
+
+/*
+ * ColumnarSnapshot.cpp
+ */
+
+#include "util/ColumnarSnapshot.hpp"
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace sim_mob::long_term;
+using namespace sim_mob::long_term::snapshot;
+
+namespace
+{
+    const uint64_t ALIGNMENT = 8;
+
+    size_t getElementSize(uint32_t type)
+    {
+        return type & 0xff;
+    }
+
+    bool compareIds(const IndexEntry& first, const IndexEntry& second)
+    {
+        return first.id < second.id;
+    }
+
+    /**
+     * Pads the file to the next aligned position and returns it.
+     */
+    uint64_t align(std::ofstream& file)
+    {
+        static const char padding[ALIGNMENT] = {0};
+        uint64_t position = file.tellp();
+        if (position % ALIGNMENT != 0)
+        {
+            file.write(padding, ALIGNMENT - position % ALIGNMENT);
+            position = file.tellp();
+        }
+        return position;
+    }
+
+    template <class T>
+    uint64_t writeBlock(std::ofstream& file, const T* values, size_t count)
+    {
+        uint64_t position = align(file);
+        file.write(reinterpret_cast<const char*>(values), count * sizeof(T));
+        return position;
+    }
+}
+
+SnapshotOArchive::SnapshotOArchive(std::vector<ColumnData>& columns, bool firstRow)
+    : columns(columns), firstRow(firstRow), field(0), lastListBegin(nullptr), lastListEnd(nullptr)
+{
+}
+
+ColumnData& SnapshotOArchive::nextColumn(uint32_t type, bool list)
+{
+    if (firstRow)
+    {
+        columns.push_back(ColumnData(type, list));
+        if (list)
+        {
+            columns.back().rowOffsets.push_back(0);
+        }
+    }
+    else if (field >= columns.size() || columns[field].type != type || columns[field].list != list)
+    {
+        throw std::runtime_error("snapshot: the entities of a section do not have the same fields");
+    }
+    return columns[field++];
+}
+
+void SnapshotOArchive::appendList(ColumnData& column, const void* values, size_t count)
+{
+    const char* first = static_cast<const char*>(values);
+    column.values.insert(column.values.end(), first, first + count * getElementSize(column.type));
+    column.valueCount += count;
+    column.rowOffsets.push_back(column.valueCount);
+}
+
+bool SnapshotOArchive::isInLastList(const void* value) const
+{
+    const char* address = static_cast<const char*>(value);
+    return address >= lastListBegin && address < lastListEnd;
+}
+
+SnapshotIArchive::SnapshotIArchive(const char* data, const std::vector<const ColumnHeader*>& columns, size_t row)
+    : data(data), columns(columns), row(row), field(0), lastListBegin(nullptr), lastListEnd(nullptr)
+{
+}
+
+const ColumnHeader& SnapshotIArchive::nextColumn(uint32_t type, bool list)
+{
+    if (field >= columns.size() || columns[field]->type != type || (columns[field]->list != 0) != list)
+    {
+        throw std::runtime_error("snapshot: the fields of the entity do not match the columns of the section");
+    }
+    return *columns[field++];
+}
+
+const char* SnapshotIArchive::nextValue(uint32_t type)
+{
+    const ColumnHeader& column = nextColumn(type, false);
+    return data + column.valuesOffset + row * getElementSize(type);
+}
+
+const char* SnapshotIArchive::nextList(uint32_t type, size_t& count)
+{
+    const ColumnHeader& column = nextColumn(type, true);
+    const uint64_t* rowOffsets = reinterpret_cast<const uint64_t*>(data + column.rowOffsetsOffset);
+    const uint64_t first = rowOffsets[row];
+    const uint64_t last = rowOffsets[row + 1];
+    if (first > last || last > column.valueCount)
+    {
+        throw std::runtime_error("snapshot: corrupted list column");
+    }
+    count = last - first;
+    return data + column.valuesOffset + first * getElementSize(type);
+}
+
+bool SnapshotIArchive::isInLastList(const void* value) const
+{
+    const char* address = static_cast<const char*>(value);
+    return address >= lastListBegin && address < lastListEnd;
+}
+
+SnapshotWriter::SnapshotWriter()
+{
+}
+
+SnapshotWriter::Section& SnapshotWriter::newSection(const std::string& name, size_t rows)
+{
+    if (name.size() >= sizeof(SectionHeader().name))
+    {
+        throw std::runtime_error("snapshot: section name too long: " + name);
+    }
+    sections.push_back(Section());
+    Section& section = sections.back();
+    section.name = name;
+    section.rows = rows;
+    section.index.reserve(rows);
+    return section;
+}
+
+void SnapshotWriter::endRow(Section& section, size_t fieldCount)
+{
+    if (fieldCount != section.columns.size())
+    {
+        throw std::runtime_error("snapshot: the entities of section " + section.name + " do not have the same fields");
+    }
+}
+
+void SnapshotWriter::write(const std::string& path)
+{
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("snapshot: cannot create " + path);
+    }
+
+    FileHeader header = FileHeader();
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.sectionCount = sections.size();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<SectionHeader> sectionHeaders(sections.size());
+    std::vector<std::vector<ColumnHeader> > columnHeaders(sections.size());
+    for (size_t n = 0; n < sections.size(); n++)
+    {
+        Section& section = sections[n];
+        for (std::vector<ColumnData>::const_iterator it = section.columns.begin(); it != section.columns.end(); it++)
+        {
+            ColumnHeader column = ColumnHeader();
+            column.type = it->type;
+            column.list = it->list ? 1 : 0;
+            column.valueCount = it->valueCount;
+            column.valuesOffset = writeBlock(file, it->values.data(), it->values.size());
+            if (it->list)
+            {
+                column.rowOffsetsOffset = writeBlock(file, it->rowOffsets.data(), it->rowOffsets.size());
+            }
+            columnHeaders[n].push_back(column);
+        }
+
+        std::stable_sort(section.index.begin(), section.index.end(), compareIds);
+
+        SectionHeader& sectionHeader = sectionHeaders[n];
+        sectionHeader = SectionHeader();
+        std::strncpy(sectionHeader.name, section.name.c_str(), sizeof(sectionHeader.name) - 1);
+        sectionHeader.rows = section.rows;
+        sectionHeader.columnCount = section.columns.size();
+        sectionHeader.indexOffset = writeBlock(file, section.index.data(), section.index.size());
+    }
+
+    header.directoryOffset = align(file);
+    for (size_t n = 0; n < sections.size(); n++)
+    {
+        file.write(reinterpret_cast<const char*>(&sectionHeaders[n]), sizeof(SectionHeader));
+        file.write(reinterpret_cast<const char*>(columnHeaders[n].data()), columnHeaders[n].size() * sizeof(ColumnHeader));
+    }
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (!file)
+    {
+        throw std::runtime_error("snapshot: cannot write " + path);
+    }
+}
+
+SnapshotReader::SnapshotReader(const std::string& path) : path(path), data(nullptr), size(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("snapshot: cannot open " + path);
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(FileHeader)))
+    {
+        close(fd);
+        throw std::runtime_error("snapshot: " + path + " is not a snapshot");
+    }
+
+    size = status.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("snapshot: cannot map " + path);
+    }
+    data = static_cast<const char*>(mapping);
+
+    try
+    {
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+        if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            throw std::runtime_error("snapshot: " + path + " is not a snapshot");
+        }
+        if (header->version != FORMAT_VERSION)
+        {
+            throw std::runtime_error("snapshot: " + path + " has an unsupported version");
+        }
+
+        //check every offset once, so that the archives can read without checks.
+        uint64_t offset = header->directoryOffset;
+        for (uint32_t n = 0; n < header->sectionCount; n++)
+        {
+            const SectionHeader* sectionHeader = reinterpret_cast<const SectionHeader*>(at(offset, sizeof(SectionHeader)));
+            offset += sizeof(SectionHeader);
+
+            Section section;
+            section.name.assign(sectionHeader->name, strnlen(sectionHeader->name, sizeof(sectionHeader->name)));
+            section.rows = sectionHeader->rows;
+            section.index = reinterpret_cast<const IndexEntry*>(at(sectionHeader->indexOffset, section.rows * sizeof(IndexEntry)));
+
+            for (uint32_t c = 0; c < sectionHeader->columnCount; c++)
+            {
+                const ColumnHeader* column = reinterpret_cast<const ColumnHeader*>(at(offset, sizeof(ColumnHeader)));
+                offset += sizeof(ColumnHeader);
+
+                at(column->valuesOffset, column->valueCount * getElementSize(column->type));
+                if (column->list)
+                {
+                    at(column->rowOffsetsOffset, (section.rows + 1) * sizeof(uint64_t));
+                }
+                else if (column->valueCount != section.rows)
+                {
+                    throw std::runtime_error("snapshot: corrupted column in section " + section.name);
+                }
+                section.columns.push_back(column);
+            }
+            sections.push_back(section);
+        }
+    }
+    catch (...)
+    {
+        munmap(const_cast<char*>(data), size);
+        throw;
+    }
+}
+
+SnapshotReader::~SnapshotReader()
+{
+    munmap(const_cast<char*>(data), size);
+}
+
+bool SnapshotReader::exists(const std::string& path)
+{
+    return access(path.c_str(), R_OK) == 0;
+}
+
+bool SnapshotReader::hasSection(const std::string& name) const
+{
+    for (std::vector<Section>::const_iterator it = sections.begin(); it != sections.end(); it++)
+    {
+        if (it->name == name)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t SnapshotReader::getRowCount(const std::string& name) const
+{
+    return getSection(name).rows;
+}
+
+bool SnapshotReader::findRow(const std::string& name, BigSerial id, size_t& row) const
+{
+    const Section& section = getSection(name);
+    const IndexEntry key = { id, 0 };
+    const IndexEntry* entry = std::lower_bound(section.index, section.index + section.rows, key, compareIds);
+    if (entry == section.index + section.rows || entry->id != id)
+    {
+        return false;
+    }
+    row = entry->row;
+    return true;
+}
+
+std::vector<BigSerial> SnapshotReader::getIds(const std::string& name) const
+{
+    const Section& section = getSection(name);
+    std::vector<BigSerial> ids(section.rows);
+    for (size_t n = 0; n < section.rows; n++)
+    {
+        const IndexEntry& entry = section.index[n];
+        if (entry.row >= section.rows)
+        {
+            throw std::runtime_error("snapshot: corrupted index in section " + name);
+        }
+        ids[entry.row] = entry.id;
+    }
+    return ids;
+}
+
+const SnapshotReader::Section& SnapshotReader::getSection(const std::string& name) const
+{
+    for (std::vector<Section>::const_iterator it = sections.begin(); it != sections.end(); it++)
+    {
+        if (it->name == name)
+        {
+            return *it;
+        }
+    }
+    throw std::runtime_error("snapshot: " + path + " has no section " + name);
+}
+
+const char* SnapshotReader::at(uint64_t offset, uint64_t length) const
+{
+    if (offset > size || length > size - offset || offset % ALIGNMENT != 0)
+    {
+        throw std::runtime_error("snapshot: " + path + " is truncated or corrupted");
+    }
+    return data + offset;
+}
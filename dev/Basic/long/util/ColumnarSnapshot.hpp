@@ -0,0 +1,459 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//license.txt   (http://opensource.org/licenses/MIT)
+
+/*
+ * ColumnarSnapshot.hpp
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include "Types.hpp"
+
+namespace sim_mob
+{
+    namespace long_term
+    {
+        /**
+         * Snapshot of the state of the long-term models, stored by columns.
+         *
+         * A snapshot holds named sections, one per list of entities. Each field
+         * given to the archive by the serialize() function of the entities is
+         * stored in its own column: scalar fields hold one value per entity,
+         * strings and vectors hold a list of values per entity. Each section
+         * also holds the ids of its entities, sorted, so that an entity can be
+         * found without building a map.
+         *
+         * The file is memory-mapped when read, so the columns are not read
+         * until entities are built from them: sections can be built on
+         * demand, one entity at a time (load, loadById, SnapshotSection) or
+         * all together (loadAll), from several threads at once.
+         *
+         * Layout (native byte order, all blocks aligned on 8 bytes):
+         *  - FileHeader
+         *  - the values, row offsets and indexes of all the columns and sections
+         *  - the directory: for each section a SectionHeader followed by its ColumnHeaders
+         */
+        namespace snapshot
+        {
+            const char MAGIC[8] = {'S', 'M', 'L', 'T', 'S', 'N', 'A', 'P'};
+            const uint32_t FORMAT_VERSION = 1;
+
+            struct FileHeader
+            {
+                char magic[8];
+                uint32_t version;
+                uint32_t sectionCount;
+                uint64_t directoryOffset;
+            };
+
+            struct SectionHeader
+            {
+                char name[56];
+                uint64_t rows;
+                uint64_t indexOffset;  ///< rows IndexEntries, sorted by id.
+                uint32_t columnCount;
+                uint32_t reserved;
+            };
+
+            struct ColumnHeader
+            {
+                uint32_t type;              ///< see getColumnType().
+                uint32_t list;              ///< 1 if each row holds a list of values.
+                uint64_t valuesOffset;
+                uint64_t valueCount;
+                uint64_t rowOffsetsOffset;  ///< lists only: rows + 1 offsets of the first value of each row.
+            };
+
+            struct IndexEntry
+            {
+                int64_t id;
+                uint64_t row;
+            };
+
+            /**
+             * Identifies the type of the values of a column by their kind and size.
+             */
+            template <class T>
+            uint32_t getColumnType()
+            {
+                static_assert(std::is_arithmetic<T>::value, "snapshot columns only hold arithmetic values, strings and vectors of them");
+                return (std::is_floating_point<T>::value ? 0x200 : 0) | (std::is_signed<T>::value ? 0x100 : 0) | sizeof(T);
+            }
+
+            /**
+             * Values of a column, as they are built by the SnapshotWriter.
+             */
+            struct ColumnData
+            {
+                ColumnData(uint32_t type, bool list) : type(type), list(list), valueCount(0) {}
+
+                uint32_t type;
+                bool list;
+                std::vector<char> values;
+                uint64_t valueCount;
+                std::vector<uint64_t> rowOffsets;
+            };
+
+            /**
+             * Archive given to the serialize() function of the entities to write one row of a section.
+             * Fields are matched to columns by their order.
+             */
+            class SnapshotOArchive
+            {
+            public:
+                SnapshotOArchive(std::vector<ColumnData>& columns, bool firstRow);
+
+                template <class T>
+                SnapshotOArchive& operator&(const boost::serialization::nvp<T>& field)
+                {
+                    return *this & field.value();
+                }
+
+                SnapshotOArchive& operator&(std::string& value)
+                {
+                    ColumnData& column = nextColumn(getColumnType<char>(), true);
+                    appendList(column, value.data(), value.size());
+                    return *this;
+                }
+
+                template <class T>
+                SnapshotOArchive& operator&(std::vector<T>& values)
+                {
+                    ColumnData& column = nextColumn(getColumnType<T>(), true);
+                    appendList(column, values.data(), values.size());
+                    lastListBegin = reinterpret_cast<const char*>(values.data());
+                    lastListEnd = reinterpret_cast<const char*>(values.data() + values.size());
+                    return *this;
+                }
+
+                template <class T>
+                SnapshotOArchive& operator&(T& value)
+                {
+                    //the elements of a vector given again one by one are already in its column.
+                    if (isInLastList(&value))
+                    {
+                        return *this;
+                    }
+                    ColumnData& column = nextColumn(getColumnType<T>(), false);
+                    column.values.insert(column.values.end(), reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value + 1));
+                    column.valueCount++;
+                    return *this;
+                }
+
+                size_t getFieldCount() const
+                {
+                    return field;
+                }
+
+            private:
+                ColumnData& nextColumn(uint32_t type, bool list);
+                void appendList(ColumnData& column, const void* values, size_t count);
+                bool isInLastList(const void* value) const;
+
+                std::vector<ColumnData>& columns;
+                bool firstRow;
+                size_t field;
+                const char* lastListBegin;
+                const char* lastListEnd;
+            };
+
+            /**
+             * Archive given to the serialize() function of the entities to read one row of a section.
+             */
+            class SnapshotIArchive
+            {
+            public:
+                SnapshotIArchive(const char* data, const std::vector<const ColumnHeader*>& columns, size_t row);
+
+                template <class T>
+                SnapshotIArchive& operator&(const boost::serialization::nvp<T>& field)
+                {
+                    return *this & field.value();
+                }
+
+                SnapshotIArchive& operator&(std::string& value)
+                {
+                    size_t count = 0;
+                    const char* values = nextList(getColumnType<char>(), count);
+                    value.assign(values, count);
+                    return *this;
+                }
+
+                template <class T>
+                SnapshotIArchive& operator&(std::vector<T>& values)
+                {
+                    size_t count = 0;
+                    const T* first = reinterpret_cast<const T*>(nextList(getColumnType<T>(), count));
+                    values.assign(first, first + count);
+                    lastListBegin = reinterpret_cast<const char*>(values.data());
+                    lastListEnd = reinterpret_cast<const char*>(values.data() + values.size());
+                    return *this;
+                }
+
+                template <class T>
+                SnapshotIArchive& operator&(T& value)
+                {
+                    if (isInLastList(&value))
+                    {
+                        return *this;
+                    }
+                    std::memcpy(&value, nextValue(getColumnType<T>()), sizeof(T));
+                    return *this;
+                }
+
+            private:
+                const ColumnHeader& nextColumn(uint32_t type, bool list);
+                const char* nextValue(uint32_t type);
+                const char* nextList(uint32_t type, size_t& count);
+                bool isInLastList(const void* value) const;
+
+                const char* data;
+                const std::vector<const ColumnHeader*>& columns;
+                size_t row;
+                size_t field;
+                const char* lastListBegin;
+                const char* lastListEnd;
+            };
+        }
+
+        /**
+         * Writes a snapshot file.
+         *
+         * Entities are stored with their serialize() function, which must be
+         * instantiated for snapshot::SnapshotOArchive.
+         */
+        class SnapshotWriter : private boost::noncopyable
+        {
+        public:
+            SnapshotWriter();
+
+            /**
+             * Adds a section holding the given entities.
+             * @param name of the section (at most 55 characters).
+             * @param entities to store.
+             * @param getId member function giving the id of an entity.
+             */
+            template <class T, class IdGetter>
+            void addSection(const std::string& name, const std::vector<T*>& entities, IdGetter getId)
+            {
+                Section& section = newSection(name, entities.size());
+                for (size_t row = 0; row < entities.size(); row++)
+                {
+                    snapshot::SnapshotOArchive archive(section.columns, row == 0);
+                    entities[row]->serialize(archive, 0);
+                    endRow(section, archive.getFieldCount());
+
+                    snapshot::IndexEntry entry = { static_cast<int64_t>((entities[row]->*getId)()), row };
+                    section.index.push_back(entry);
+                }
+            }
+
+            /**
+             * Writes all the sections to the given file.
+             */
+            void write(const std::string& path);
+
+        private:
+            struct Section
+            {
+                std::string name;
+                uint64_t rows;
+                std::vector<snapshot::ColumnData> columns;
+                std::vector<snapshot::IndexEntry> index;
+            };
+
+            Section& newSection(const std::string& name, size_t rows);
+            void endRow(Section& section, size_t fieldCount);
+
+            std::vector<Section> sections;
+        };
+
+        /**
+         * Reads a snapshot file written by SnapshotWriter.
+         *
+         * The file is memory-mapped; entities are built only when they are
+         * requested. Entities are built with their serialize() function,
+         * which must be instantiated for snapshot::SnapshotIArchive.
+         * All the methods may be called from several threads at once.
+         */
+        class SnapshotReader : private boost::noncopyable
+        {
+        public:
+            /**
+             * Maps the given file.
+             * @throw std::runtime_error if the file cannot be mapped or is not a snapshot of this version.
+             */
+            explicit SnapshotReader(const std::string& path);
+            ~SnapshotReader();
+
+            /**
+             * @return true if the given file exists and can be read.
+             */
+            static bool exists(const std::string& path);
+
+            bool hasSection(const std::string& name) const;
+            size_t getRowCount(const std::string& name) const;
+
+            /**
+             * Finds the row of the entity with the given id.
+             * @return false if the section has no such entity.
+             */
+            bool findRow(const std::string& name, BigSerial id, size_t& row) const;
+
+            /**
+             * @return the ids of the entities of the given section, in the order they were written.
+             */
+            std::vector<BigSerial> getIds(const std::string& name) const;
+
+            /**
+             * Builds the entity of the given row. The caller owns it.
+             */
+            template <class T>
+            T* load(const std::string& name, size_t row) const
+            {
+                const Section& section = getSection(name);
+                if (row >= section.rows)
+                {
+                    throw std::runtime_error("snapshot: row out of range in section " + name);
+                }
+                T* entity = new T();
+                snapshot::SnapshotIArchive archive(data, section.columns, row);
+                entity->serialize(archive, 0);
+                return entity;
+            }
+
+            /**
+             * Builds the entity with the given id. The caller owns it.
+             * @return the entity or nullptr if the section has no such entity.
+             */
+            template <class T>
+            T* loadById(const std::string& name, BigSerial id) const
+            {
+                size_t row = 0;
+                return findRow(name, id, row) ? load<T>(name, row) : nullptr;
+            }
+
+            /**
+             * Builds all the entities of the given section, in the order they were written. The caller owns them.
+             */
+            template <class T>
+            std::vector<T*> loadAll(const std::string& name) const
+            {
+                std::vector<T*> entities;
+                const size_t rows = getRowCount(name);
+                entities.reserve(rows);
+                for (size_t row = 0; row < rows; row++)
+                {
+                    entities.push_back(load<T>(name, row));
+                }
+                return entities;
+            }
+
+        private:
+            struct Section
+            {
+                std::string name;
+                size_t rows;
+                const snapshot::IndexEntry* index;
+                std::vector<const snapshot::ColumnHeader*> columns;
+            };
+
+            const Section& getSection(const std::string& name) const;
+            const char* at(uint64_t offset, uint64_t length) const;
+
+            std::string path;
+            const char* data;
+            size_t size;
+            std::vector<Section> sections;
+        };
+
+        /**
+         * Entities of one section of a snapshot, built the first time they are requested by id.
+         *
+         * Stands in for the map by id of a section which is only looked up by
+         * id, so that its entities are not built when the snapshot is loaded.
+         * The entities built belong to the section and stay valid until it is
+         * destroyed. get() may be called from several threads at once.
+         */
+        template <class T>
+        class SnapshotSection : private boost::noncopyable
+        {
+        public:
+            /**
+             * @throw std::runtime_error if the snapshot has no such section.
+             */
+            SnapshotSection(const boost::shared_ptr<const SnapshotReader>& reader, const std::string& name)
+                : reader(reader), name(name), rows(reader->getRowCount(name))
+            {
+            }
+
+            ~SnapshotSection()
+            {
+                for (typename EntityMap::iterator it = entities.begin(); it != entities.end(); it++)
+                {
+                    delete it->second;
+                }
+            }
+
+            /**
+             * @return the entity with the given id or nullptr if the section has no such entity.
+             */
+            T* get(BigSerial id) const
+            {
+                {
+                    boost::lock_guard<boost::mutex> lock(mutex);
+                    typename EntityMap::const_iterator it = entities.find(id);
+                    if (it != entities.end())
+                    {
+                        return it->second;
+                    }
+                }
+
+                //built without the lock; if another thread built it meanwhile, its entity is kept.
+                T* entity = reader->loadById<T>(name, id);
+                if (entity == nullptr)
+                {
+                    return nullptr;
+                }
+                boost::lock_guard<boost::mutex> lock(mutex);
+                std::pair<typename EntityMap::iterator, bool> res = entities.insert(std::make_pair(id, entity));
+                if (!res.second)
+                {
+                    delete entity;
+                }
+                return res.first->second;
+            }
+
+            /**
+             * @return the number of entities of the section, built or not.
+             */
+            size_t size() const
+            {
+                return rows;
+            }
+
+        private:
+            typedef boost::unordered_map<BigSerial, T*> EntityMap;
+
+            const boost::shared_ptr<const SnapshotReader> reader;
+            const std::string name;
+            const size_t rows;
+            mutable boost::mutex mutex;
+            mutable EntityMap entities;
+        };
+    }
+}
@@ -0,0 +1,127 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//license.txt   (http://opensource.org/licenses/MIT)
+
+/*
+ * MarketDraws.cpp
+ */
+
+#include "util/MarketDraws.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <boost/functional/hash.hpp>
+#include <boost/random/uniform_01.hpp>
+#include "conf/ConfigManager.hpp"
+#include "conf/ConfigParams.hpp"
+#include "Common.hpp"
+#include "database/entity/Bid.hpp"
+
+using namespace sim_mob;
+using namespace sim_mob::long_term;
+
+namespace
+{
+    //bits of a deterministic bid id: day, household, sequence.
+    const int BID_SEQUENCE_BITS = 8;
+    const int BID_HOUSEHOLD_BITS = 39;
+
+    unsigned int getMarketSeed()
+    {
+        return ConfigManager::GetInstance().FullConfig().ltParams.housingModel.marketSeed;
+    }
+}
+
+MarketDraws::MarketDraws(Purpose purpose, BigSerial id, int day, unsigned int sequence) : deterministic(isDeterministic())
+{
+    if (deterministic)
+    {
+        seed(getMarketSeed(), purpose, id, day, sequence);
+    }
+}
+
+MarketDraws::MarketDraws(unsigned int marketSeed, Purpose purpose, BigSerial id, int day, unsigned int sequence) : deterministic(true)
+{
+    seed(marketSeed, purpose, id, day, sequence);
+}
+
+void MarketDraws::seed(unsigned int marketSeed, Purpose purpose, BigSerial id, int day, unsigned int sequence)
+{
+    std::size_t key = marketSeed;
+    boost::hash_combine(key, static_cast<int>(purpose));
+    boost::hash_combine(key, id);
+    boost::hash_combine(key, day);
+    boost::hash_combine(key, sequence);
+    generator.seed(static_cast<boost::mt19937::result_type>(key));
+}
+
+double MarketDraws::next()
+{
+    if (deterministic)
+    {
+        boost::random::uniform_01<double> distribution;
+        return distribution(generator);
+    }
+    return (double) rand() / RAND_MAX;
+}
+
+std::size_t MarketDraws::nextIndex(std::size_t size)
+{
+    //rand() may draw 1.0.
+    return std::min<std::size_t>(next() * size, size - 1);
+}
+
+bool MarketDraws::isDeterministic()
+{
+    return ConfigManager::GetInstance().FullConfig().ltParams.housingModel.deterministicMarket;
+}
+
+bool MarketDraws::prefers(const Bid& challenger, const Bid& current)
+{
+    if (isDeterministic())
+    {
+        return prefers(getMarketSeed(), challenger, current);
+    }
+
+    if (std::fabs(current.getBidValue() - challenger.getBidValue()) < EPSILON)
+    {
+        // bids are equal (i.e so close the difference is less that EPSILON). Randomly choose one.
+        return (double) rand() / RAND_MAX < 0.5;
+    }
+    return current.getBidValue() < challenger.getBidValue();
+}
+
+bool MarketDraws::prefers(unsigned int seed, const Bid& challenger, const Bid& current)
+{
+    //no EPSILON here: equality within EPSILON is not transitive, so the winner would depend on the order of arrival.
+    if (challenger.getBidValue() != current.getBidValue())
+    {
+        return challenger.getBidValue() > current.getBidValue();
+    }
+    return prefers(seed, challenger.getNewUnitId(), challenger.getSimulationDay(), challenger.getBidderId(), current.getBidderId());
+}
+
+bool MarketDraws::prefers(unsigned int seed, BigSerial unitId, int day, BigSerial challengerId, BigSerial currentId)
+{
+    std::size_t challengerKey = tieBreakKey(seed, unitId, day, challengerId);
+    std::size_t currentKey = tieBreakKey(seed, unitId, day, currentId);
+    if (challengerKey != currentKey)
+    {
+        return challengerKey < currentKey;
+    }
+    return challengerId < currentId;
+}
+
+BigSerial MarketDraws::bidId(int day, BigSerial householdId, unsigned int sequence)
+{
+    return ((static_cast<BigSerial>(day) << BID_HOUSEHOLD_BITS | householdId) << BID_SEQUENCE_BITS) | sequence;
+}
+
+std::size_t MarketDraws::tieBreakKey(unsigned int seed, BigSerial unitId, int day, BigSerial bidderId)
+{
+    std::size_t key = seed;
+    boost::hash_combine(key, unitId);
+    boost::hash_combine(key, bidderId);
+    boost::hash_combine(key, day);
+    return key;
+}
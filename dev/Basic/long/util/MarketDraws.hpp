@@ -0,0 +1,125 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//license.txt   (http://opensource.org/licenses/MIT)
+
+/*
+ * MarketDraws.hpp
+ */
+
+#pragma once
+#include <cstddef>
+#include <boost/random/mersenne_twister.hpp>
+#include "Types.hpp"
+
+namespace sim_mob
+{
+    namespace long_term
+    {
+        class Bid;
+
+        /**
+         * Random draws of the housing market.
+         *
+         * With the deterministic market (housingModel deterministicMarket),
+         * the draws made for a purpose, about a household (or unit) on a
+         * given day, come from a generator seeded with the market seed, the
+         * purpose, the household and the day. Equal bids are resolved by a
+         * key computed the same way, and bid ids are derived from the day,
+         * the household and the number of bids it made that day. The results
+         * of the market then depend only on the seed, not on how the
+         * households are spread over the workers nor on the order in which
+         * the bids reach the sellers.
+         *
+         * Otherwise the draws come from rand() as before, and bid ids from
+         * the counter of the model.
+         */
+        class MarketDraws
+        {
+        public:
+            /**
+             * What the draws are for; the streams of the different
+             * purposes of a household on a day are independent.
+             */
+            enum Purpose
+            {
+                BIDDER_CHOICE_SET,
+                INITIAL_AWAKENING,
+                DAILY_AWAKENING,
+                AWAKENED_HOUSEHOLDS,
+                BTO_AWAKENING,
+                FREELANCE_AGENT,
+                UNIT_MARKET_ENTRY,
+                UNITS_FILTERING
+            };
+
+            /**
+             * @param purpose of the draws.
+             * @param id household (or unit) drawing; 0 for draws about the whole market.
+             * @param day of the draws.
+             * @param sequence tells apart the draws made for the same purpose several times on a day.
+             */
+            MarketDraws(Purpose purpose, BigSerial id, int day, unsigned int sequence = 0);
+
+            /**
+             * Deterministic draws from the given seed, whatever the configuration.
+             */
+            MarketDraws(unsigned int seed, Purpose purpose, BigSerial id, int day, unsigned int sequence = 0);
+
+            /**
+             * @return a uniform draw in [0, 1] ([0, 1) with the deterministic market).
+             */
+            double next();
+
+            /**
+             * @return a uniform draw in [0, size).
+             */
+            std::size_t nextIndex(std::size_t size);
+
+            /**
+             * @return true if the deterministic market is enabled.
+             */
+            static bool isDeterministic();
+
+            /**
+             * Tells if a seller keeps a new bid on a unit rather than the
+             * best bid it received on that unit so far on the day.
+             *
+             * With the deterministic market, bids are ordered by value and
+             * equal values by a seeded key of the bidder. This is a strict
+             * total order, so the bid kept at the end of the day does not
+             * depend on the order in which the bids were received.
+             * Otherwise, bids whose values differ by less than EPSILON are
+             * equal and one of them is kept at random, with rand(), as before.
+             * @return true if the seller should keep the challenger.
+             */
+            static bool prefers(const Bid& challenger, const Bid& current);
+
+            /**
+             * prefers() with the deterministic market and the given seed.
+             */
+            static bool prefers(unsigned int seed, const Bid& challenger, const Bid& current);
+
+            /**
+             * Tie break of the deterministic market between the bids of
+             * two bidders on a unit on a day, with the given seed.
+             */
+            static bool prefers(unsigned int seed, BigSerial unitId, int day, BigSerial challengerId, BigSerial currentId);
+
+            /**
+             * Id of a bid with the deterministic market.
+             * @param day of the bid.
+             * @param householdId bidder; must be below 2^39.
+             * @param sequence number of bids the household made before on that day; must be below 2^8.
+             */
+            static BigSerial bidId(int day, BigSerial householdId, unsigned int sequence);
+
+        private:
+            void seed(unsigned int marketSeed, Purpose purpose, BigSerial id, int day, unsigned int sequence);
+
+            static std::size_t tieBreakKey(unsigned int seed, BigSerial unitId, int day, BigSerial bidderId);
+
+            bool deterministic;
+            boost::mt19937 generator;
+        };
+    }
+}
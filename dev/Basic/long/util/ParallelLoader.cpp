@@ -0,0 +1,244 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/*
+ * ParallelLoader.cpp
+ */
+
+#include "ParallelLoader.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <boost/chrono.hpp>
+#include <boost/thread.hpp>
+#include <boost/unordered_map.hpp>
+#include "logging/Log.hpp"
+
+using namespace sim_mob;
+using namespace sim_mob::long_term;
+
+namespace
+{
+    typedef boost::chrono::steady_clock Clock;
+
+    double getSeconds(const Clock::time_point& start)
+    {
+        return boost::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    /**
+     * Orders the steps by decreasing duration.
+     */
+    class LongerStep
+    {
+    public:
+        LongerStep(const std::vector<double>& durations) : durations(durations)
+        {
+        }
+
+        bool operator()(size_t first, size_t second) const
+        {
+            return durations[first] > durations[second];
+        }
+
+    private:
+        const std::vector<double>& durations;
+    };
+}
+
+ParallelLoader::ParallelLoader(unsigned int threads) : threads(std::max(threads, 1u)), duration(0), doneSteps(0)
+{
+}
+
+void ParallelLoader::add(const std::string& name, const Step& step, const std::vector<std::string>& dependencies)
+{
+    for (std::vector<StepInfo>::const_iterator it = steps.begin(); it != steps.end(); it++)
+    {
+        if (it->name == name)
+        {
+            throw std::runtime_error("ParallelLoader: step " + name + " added twice");
+        }
+    }
+
+    StepInfo info;
+    info.name = name;
+    info.step = step;
+    info.dependencies = dependencies;
+    info.waitingFor = 0;
+    info.duration = 0;
+    steps.push_back(info);
+}
+
+void ParallelLoader::add(const std::string& name, db::DB_ConnectionPool& pool, const DbStep& step, const std::vector<std::string>& dependencies)
+{
+    db::DB_ConnectionPool* stepPool = &pool;
+    add(name, [stepPool, step]()
+    {
+        db::DB_ConnectionPool::ScopedConnection connection(*stepPool);
+        step(*connection);
+    }, dependencies);
+}
+
+void ParallelLoader::run()
+{
+    const Clock::time_point start = Clock::now();
+    resolveDependencies();
+
+    if (threads == 1)
+    {
+        runSteps();
+    }
+    else
+    {
+        boost::thread_group group;
+        for (unsigned int n = 0; n < threads; n++)
+        {
+            group.create_thread(boost::bind(&ParallelLoader::runSteps, this));
+        }
+        group.join_all();
+    }
+    duration = getSeconds(start);
+
+    if (!error.empty())
+    {
+        throw std::runtime_error("ParallelLoader: step " + error);
+    }
+}
+
+void ParallelLoader::printTimings() const
+{
+    std::vector<double> durations;
+    std::vector<size_t> order;
+    double total = 0;
+    for (size_t n = 0; n < steps.size(); n++)
+    {
+        durations.push_back(steps[n].duration);
+        order.push_back(n);
+        total += steps[n].duration;
+    }
+    std::stable_sort(order.begin(), order.end(), LongerStep(durations));
+
+    PrintOutV("Loaded " << steps.size() << " steps in " << duration << " s on " << threads << " threads (" << total << " s in total)" << std::endl);
+    for (std::vector<size_t>::const_iterator it = order.begin(); it != order.end(); it++)
+    {
+        PrintOutV("    " << steps[*it].name << ": " << steps[*it].duration << " s" << std::endl);
+    }
+}
+
+void ParallelLoader::resolveDependencies()
+{
+    boost::unordered_map<std::string, size_t> stepsByName;
+    for (size_t n = 0; n < steps.size(); n++)
+    {
+        stepsByName.insert(std::make_pair(steps[n].name, n));
+        steps[n].dependents.clear();
+        steps[n].waitingFor = 0;
+    }
+
+    for (size_t n = 0; n < steps.size(); n++)
+    {
+        for (std::vector<std::string>::const_iterator it = steps[n].dependencies.begin(); it != steps[n].dependencies.end(); it++)
+        {
+            boost::unordered_map<std::string, size_t>::const_iterator dependency = stepsByName.find(*it);
+            if (dependency == stepsByName.end())
+            {
+                throw std::runtime_error("ParallelLoader: step " + steps[n].name + " depends on unknown step " + *it);
+            }
+            steps[dependency->second].dependents.push_back(n);
+            steps[n].waitingFor++;
+        }
+    }
+
+    //checks that every step can be reached, as a circular dependency would make run() wait forever.
+    std::vector<size_t> waitingFor;
+    std::deque<size_t> reachable;
+    for (size_t n = 0; n < steps.size(); n++)
+    {
+        waitingFor.push_back(steps[n].waitingFor);
+        if (waitingFor[n] == 0)
+        {
+            reachable.push_back(n);
+        }
+    }
+    readySteps = reachable;
+
+    size_t reached = 0;
+    while (!reachable.empty())
+    {
+        const size_t step = reachable.front();
+        reachable.pop_front();
+        reached++;
+        for (std::vector<size_t>::const_iterator it = steps[step].dependents.begin(); it != steps[step].dependents.end(); it++)
+        {
+            if (--waitingFor[*it] == 0)
+            {
+                reachable.push_back(*it);
+            }
+        }
+    }
+    if (reached != steps.size())
+    {
+        throw std::runtime_error("ParallelLoader: circular dependency between the steps");
+    }
+    doneSteps = 0;
+    error.clear();
+}
+
+void ParallelLoader::runSteps()
+{
+    boost::unique_lock<boost::mutex> lock(mutex);
+    while (true)
+    {
+        //as there is no circular dependency, some step is running while none is ready.
+        while (readySteps.empty() && error.empty() && doneSteps < steps.size())
+        {
+            stateChanged.wait(lock);
+        }
+        if (!error.empty() || doneSteps == steps.size())
+        {
+            return;
+        }
+
+        const size_t step = readySteps.front();
+        readySteps.pop_front();
+        lock.unlock();
+
+        std::string failure;
+        const Clock::time_point start = Clock::now();
+        try
+        {
+            steps[step].step();
+        }
+        catch (const std::exception& ex)
+        {
+            failure = ex.what();
+        }
+        catch (...)
+        {
+            failure = "unknown error";
+        }
+        const double stepDuration = getSeconds(start);
+
+        lock.lock();
+        steps[step].duration = stepDuration;
+        if (!failure.empty())
+        {
+            if (error.empty())
+            {
+                error = steps[step].name + " failed: " + failure;
+            }
+        }
+        else
+        {
+            doneSteps++;
+            for (std::vector<size_t>::const_iterator it = steps[step].dependents.begin(); it != steps[step].dependents.end(); it++)
+            {
+                if (--steps[*it].waitingFor == 0)
+                {
+                    readySteps.push_back(*it);
+                }
+            }
+        }
+        stateChanged.notify_all();
+    }
+}
@@ -0,0 +1,101 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/*
+ * ParallelLoader.hpp
+ */
+
+#pragma once
+#include <deque>
+#include <string>
+#include <vector>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include "database/DB_ConnectionPool.hpp"
+
+namespace sim_mob
+{
+    namespace long_term
+    {
+        /**
+         * Runs the loading steps of a model on several threads.
+         *
+         * Each step has a name and the names of the steps it depends on; a
+         * step starts once all its dependencies are done, and independent
+         * steps run at the same time. Steps reading from the database are
+         * given a connection of their pool for their whole duration.
+         *
+         * Steps must not write to the same containers unless one depends on
+         * the other. The duration of each step is recorded and can be
+         * printed once the loader has run.
+         */
+        class ParallelLoader : private boost::noncopyable
+        {
+        public:
+            typedef boost::function<void()> Step;
+            typedef boost::function<void(db::DB_Connection&)> DbStep;
+
+            /**
+             * @param threads number of steps run at the same time.
+             */
+            explicit ParallelLoader(unsigned int threads);
+
+            /**
+             * Adds a step.
+             * @param name of the step, unique.
+             * @param step to run.
+             * @param dependencies names of the steps which must be done first.
+             */
+            void add(const std::string& name, const Step& step, const std::vector<std::string>& dependencies = std::vector<std::string>());
+
+            /**
+             * Adds a step reading from the database.
+             * @param name of the step, unique.
+             * @param pool giving the connection to the step.
+             * @param step to run.
+             * @param dependencies names of the steps which must be done first.
+             */
+            void add(const std::string& name, db::DB_ConnectionPool& pool, const DbStep& step, const std::vector<std::string>& dependencies = std::vector<std::string>());
+
+            /**
+             * Runs all the steps and waits for them.
+             * Once a step fails, no other step is started.
+             * @throw std::runtime_error if a dependency is unknown or circular, or if a step failed.
+             */
+            void run();
+
+            /**
+             * Prints the duration of each step, longest first.
+             */
+            void printTimings() const;
+
+        private:
+            struct StepInfo
+            {
+                std::string name;
+                Step step;
+                std::vector<std::string> dependencies;
+                std::vector<size_t> dependents;
+                size_t waitingFor;
+                double duration;
+            };
+
+            void resolveDependencies();
+            void runSteps();
+
+            unsigned int threads;
+            std::vector<StepInfo> steps;
+            double duration;
+
+            //state shared by the threads during run().
+            boost::mutex mutex;
+            boost::condition_variable stateChanged;
+            std::deque<size_t> readySteps;
+            size_t doneSteps;
+            std::string error;
+        };
+    }
+}
@@ -0,0 +1,151 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "ActivityScheduleWriter.hpp"
+
+#include <stdexcept>
+#include <boost/bind.hpp>
+
+using namespace sim_mob;
+using namespace sim_mob::medium;
+
+ActivityScheduleWriter::ActivityScheduleWriter(std::size_t maxQueuedChunks) :
+		maxQueuedChunks(maxQueuedChunks), bulkInserter(0), copying(false), noMoreChunks(false), failed(false)
+{
+}
+
+ActivityScheduleWriter::~ActivityScheduleWriter()
+{
+	if (writerThread.joinable())
+	{
+		{
+			boost::unique_lock<boost::mutex> lock(chunksMutex);
+			noMoreChunks = true;
+		}
+		chunkQueued.notify_one();
+		writerThread.join();
+	}
+	if (copying)
+	{
+		//finish() was not reached, e.g. a preday thread threw; the rows copied so far are incomplete
+		bulkInserter.abortCopy("activity schedule writer destroyed before finish()");
+	}
+}
+
+void ActivityScheduleWriter::copyToTable(const std::string& connectionStr, const std::string& tableName, const std::vector<std::string>& columnNames)
+{
+	if (!bulkInserter.connect(connectionStr) || !bulkInserter.buildQuery(tableName, columnNames) || !bulkInserter.beginCopy())
+	{
+		throw std::runtime_error("could not start copying activity schedules to " + tableName);
+	}
+	copying = true;
+}
+
+void ActivityScheduleWriter::writeToFile(const std::string& fileName)
+{
+	file.open(fileName.c_str(), std::ios::trunc | std::ios::out | std::ios::binary);
+	if (!file.is_open())
+	{
+		throw std::runtime_error("could not open activity schedule file " + fileName);
+	}
+}
+
+void ActivityScheduleWriter::start()
+{
+	writerThread = boost::thread(boost::bind(&ActivityScheduleWriter::run, this));
+}
+
+void ActivityScheduleWriter::write(std::string& rows)
+{
+	if (rows.empty())
+	{
+		return;
+	}
+
+	{
+		boost::unique_lock<boost::mutex> lock(chunksMutex);
+		while (chunks.size() >= maxQueuedChunks)
+		{
+			chunkWritten.wait(lock);
+		}
+		chunks.push_back(std::string());
+		chunks.back().swap(rows);
+	}
+	chunkQueued.notify_one();
+}
+
+void ActivityScheduleWriter::finish()
+{
+	{
+		boost::unique_lock<boost::mutex> lock(chunksMutex);
+		noMoreChunks = true;
+	}
+	chunkQueued.notify_one();
+	writerThread.join();
+
+	if (file.is_open())
+	{
+		file.close();
+		failed = file.fail() || failed;
+	}
+	if (copying)
+	{
+		copying = false;
+		if (failed)
+		{
+			bulkInserter.abortCopy("some activity schedules could not be written");
+		}
+		else
+		{
+			failed = !bulkInserter.endCopy();
+		}
+	}
+	if (failed)
+	{
+		throw std::runtime_error("activity schedules could not be written");
+	}
+}
+
+void ActivityScheduleWriter::run()
+{
+	std::string rows;
+	while (true)
+	{
+		{
+			boost::unique_lock<boost::mutex> lock(chunksMutex);
+			while (chunks.empty() && !noMoreChunks)
+			{
+				chunkQueued.wait(lock);
+			}
+			if (chunks.empty())
+			{
+				return;
+			}
+			rows.swap(chunks.front());
+			chunks.pop_front();
+		}
+		chunkWritten.notify_all();
+
+		writeChunk(rows);
+		rows.clear();
+	}
+}
+
+void ActivityScheduleWriter::writeChunk(const std::string& rows)
+{
+	//only the writer thread reads and sets failed until finish() joins it
+	if (failed)
+	{
+		return;
+	}
+	if (copying && !bulkInserter.putRows(rows))
+	{
+		failed = true;
+	}
+	if (file.is_open())
+	{
+		file << rows;
+		failed = file.fail() || failed;
+	}
+}
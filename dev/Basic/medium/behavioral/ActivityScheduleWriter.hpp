@@ -0,0 +1,118 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include "database/PG_BulkInserter.hpp"
+
+namespace sim_mob
+{
+namespace medium
+{
+
+/**
+ * Writes the activity schedules of the preday threads while they are being computed.
+ *
+ * The preday threads hand over the schedule rows of a chunk of persons at a time. A single writer
+ * thread sends them to the day activity schedule table through one COPY kept open for the whole
+ * run, and/or appends them to the activity schedule file.
+ * At most maxQueuedChunks chunks wait in memory; write() blocks while the queue is full, so that
+ * the preday threads cannot run ahead of the database.
+ */
+class ActivityScheduleWriter : private boost::noncopyable
+{
+public:
+    /**
+     * @param maxQueuedChunks maximum number of chunks waiting to be written
+     */
+    explicit ActivityScheduleWriter(std::size_t maxQueuedChunks);
+
+    /**
+     * Waits for the writer thread if finish() was not called.
+     * The COPY is then aborted, so that no partial schedules are committed.
+     */
+    ~ActivityScheduleWriter();
+
+    /**
+     * Sends the rows to a table; must be called before start()
+     *
+     * @param connectionStr connection string of the database
+     * @param tableName table to copy the rows to; it must exist
+     * @param columnNames columns of the table, in the order of the fields of the rows
+     *
+     * @throws std::runtime_error if the COPY cannot be started
+     */
+    void copyToTable(const std::string& connectionStr, const std::string& tableName, const std::vector<std::string>& columnNames);
+
+    /**
+     * Appends the rows to a file, which is truncated first; must be called before start()
+     *
+     * @param fileName name of the file
+     *
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    void writeToFile(const std::string& fileName);
+
+    /**
+     * Starts the writer thread
+     */
+    void start();
+
+    /**
+     * Queues the rows of a chunk of persons.
+     * The rows are moved out of the given string, which is left empty.
+     *
+     * @param rows comma separated lines, one per stop
+     */
+    void write(std::string& rows);
+
+    /**
+     * Waits until all queued rows are written and ends the COPY.
+     * If some rows could not be written, the COPY is aborted and none of the rows are committed.
+     *
+     * @throws std::runtime_error if some rows could not be written
+     */
+    void finish();
+
+private:
+    /**
+     * loop of the writer thread
+     */
+    void run();
+
+    /**
+     * writes one chunk of rows to the table and the file
+     */
+    void writeChunk(const std::string& rows);
+
+    std::size_t maxQueuedChunks;
+
+    PG_BulkInserter bulkInserter;
+    bool copying;
+
+    std::ofstream file;
+
+    std::deque<std::string> chunks;
+    boost::mutex chunksMutex;
+    boost::condition_variable chunkQueued;
+    boost::condition_variable chunkWritten;
+
+    /** set once no more chunks will be queued */
+    bool noMoreChunks;
+
+    /** set if a chunk could not be written; later chunks are discarded */
+    bool failed;
+
+    boost::thread writerThread;
+};
+
+} //end namespace medium
+} //end namespace sim_mob
@@ -5,6 +5,8 @@
 #include "PredayManager.hpp"
 
 #include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
 #include <boost/thread.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
@@ -51,6 +53,15 @@ const std::string UPPER_LIMIT_CSV_HEADER = "upper_limit";
 
 const std::size_t NUM_INSERTS_PER_QUERY = 100000;
 
+/** number of consecutive persons claimed at a time by a preday thread */
+const std::size_t PERSON_CHUNK_SIZE = 64;
+
+/** number of chunks of activity schedules which may wait to be written, per preday thread */
+const std::size_t MAX_QUEUED_SCHEDULE_CHUNKS_PER_THREAD = 4;
+
+/** file to which activity schedules are written if file output is enabled */
+const std::string ACTIVITY_SCHEDULE_FILE = "activity_schedule";
+
 /** vector of variables to be calibrated. used only in calibration mode of Preday*/
 std::vector<CalibrationVariable> calibrationVariablesList;
 size_t numVariablesCalibrated;
@@ -473,17 +484,6 @@ void printParameters(const std::vector<CalibrationVariable>& calVarList, const s
 	Print() << ss.str();
 }
 
-/**
- * flush stream contents to file
- * @param logHandle handle to output file
- * @param strm stringstream to flush
- */
-void outputToFile(std::ofstream& logHandle, std::stringstream& strm)
-{
-	NullableOutputStream(&logHandle) << strm.str() << std::flush;
-	strm.str(std::string());
-}
-
 /**
  * constructs unique file name strings by appending serial numbers to prefix
  * @param numFiles number of file names to generate
@@ -501,36 +501,21 @@ void constructFileNames(size_t numFiles, const std::string& prefix, std::list<st
 	}
 }
 
-void mergeCSV_Files(const std::list<std::string>& fileNameList, const std::string& fileName)
+/**
+ * @return columns of the day activity schedule table, in the order of the fields in the schedule output
+ */
+std::vector<std::string> getDayActivityScheduleColumns()
 {
-	//This can take some time.
-	StopWatch sw;
-	sw.start();
-	std::cout << "Merging files, this can take several minutes...\n";
-
-	//One-by-one.
-	std::ofstream out(fileName.c_str(), std::ios::trunc | std::ios::binary);
-	if (!out.good())
-	{
-		throw std::runtime_error("Error: Can't write to file.");
-	}
-	for (std::list<std::string>::const_iterator it = fileNameList.begin(); it != fileNameList.end(); it++)
+	std::vector<std::string> columnNames = {"person_id", "tour_no", "tour_type", "stop_no", "stop_type", "stop_location",
+											"stop_zone", "stop_mode", "primary_stop", "arrival_time", "departure_time",
+											"prev_stop_location", "prev_stop_zone", "prev_stop_departure_time"};
+	if (MT_Config::getInstance().isEnergyModelEnabled())
 	{
-		Print() << "  Merging: " << *it << std::endl;
-		std::ifstream src(it->c_str(), std::ios::binary);
-		if (src.fail())
-		{
-			throw std::runtime_error("Error: Can't read from file.");
-		}
-
-		//If src is good, this part's easy.
-		out << src.rdbuf();
-		src.close();
+		columnNames.push_back("drivetrain");
+		columnNames.push_back("make");
+		columnNames.push_back("model");
 	}
-	out.close();
-
-	sw.stop();
-	std::cout << "Files merged; took " << sw.getTime() << "s\n";
+	return columnNames;
 }
 
 /**
@@ -554,7 +539,7 @@ DB_Connection getDB_Connection(const DatabaseDetails& dbInfo)
 } //end anonymous namespace
 
 sim_mob::medium::PredayManager::PredayManager() :
-		mtConfig(MT_Config::getInstance()), logFile(nullptr)
+		activityScheduleTableFilled(false), mtConfig(MT_Config::getInstance()), logFile(nullptr)
 {
 }
 
@@ -761,17 +746,56 @@ void sim_mob::medium::PredayManager::loadUnavailableODs()
 	}
 }
 
+void sim_mob::medium::PredayManager::loadTimeDependentTravelTimes()
+{
+	if (!mtConfig.isTravelTimeStoreEnabled())
+	{
+		return;
+	}
+
+	const std::string& ttStoreFile = mtConfig.getTravelTimeStoreFile();
+	if (!ttStoreFile.empty() && ttStore.loadFromFile(ttStoreFile))
+	{
+		Print() << "Time dependent travel times mapped from " << ttStoreFile << "\n";
+		return;
+	}
+
+	DB_Connection simmobConn = getDB_Connection(ConfigManager::GetInstance().FullConfig().networkDatabase);
+	simmobConn.connect();
+	if (!simmobConn.isConnected())
+	{
+		throw std::runtime_error("simmob db connection failure!");
+	}
+
+	std::vector<int> zoneCodes;
+	zoneCodes.reserve(zoneIdLookup.size());
+	for (boost::unordered_map<int, int>::const_iterator it = zoneIdLookup.begin(); it != zoneIdLookup.end(); ++it)
+	{
+		zoneCodes.push_back(it->first);
+	}
+	std::sort(zoneCodes.begin(), zoneCodes.end());
+
+	TimeDependentTT_SqlDao tcostDao(simmobConn);
+	ttStore.loadFromDatabase(tcostDao, zoneCodes);
+	Print() << "Time dependent travel times loaded\n";
+
+	if (!ttStoreFile.empty())
+	{
+		ttStore.writeToFile(ttStoreFile);
+		Print() << "Time dependent travel times written to " << ttStoreFile << "\n";
+	}
+}
+
 void sim_mob::medium::PredayManager::dispatchLT_Persons()
 {
-	boost::thread_group threadGroup;
-	unsigned numWorkers = mtConfig.getNumPredayThreads();
-	std::list<std::string> logFileNames;
-	std::string logFileNamePrefix;
 	if (mtConfig.runningPredaySimulation())
 	{
-		logFileNamePrefix = "activity_schedule";
+		simulateLT_Population(false);
+		return;
 	}
-	constructFileNames(numWorkers, logFileNamePrefix, logFileNames);
+
+	boost::thread_group threadGroup;
+	unsigned numWorkers = mtConfig.getNumPredayThreads();
 
 	if(mtConfig.runningPredayLogsumComputation())
 	{
@@ -805,11 +829,7 @@ void sim_mob::medium::PredayManager::dispatchLT_Persons()
 
 	if (numWorkers == 1)
 	{ // if single threaded execution was requested
-		if (mtConfig.runningPredaySimulation())
-		{
-			processPersonsForLT_Population(ltPersonIdList.begin(), ltPersonIdList.end(), logFileNames.front());
-		}
-		else if (mtConfig.runningPredayLogsumComputation())
+		if (mtConfig.runningPredayLogsumComputation())
 		{
 			computeLogsumsForLT_Population(ltPersonIdList.begin(), ltPersonIdList.end());
 		}
@@ -831,15 +851,9 @@ void sim_mob::medium::PredayManager::dispatchLT_Persons()
 		 */
 		LT_PersonIdList::iterator first = ltPersonIdList.begin();
 		LT_PersonIdList::iterator last = ltPersonIdList.begin() + numPersonsPerThread;
-		std::list<std::string>::const_iterator fileNameIt = logFileNames.begin();
 		for (int i = 1; i <= numWorkers; i++)
 		{
-			if (mtConfig.runningPredaySimulation())
-			{
-				threadGroup.create_thread(boost::bind(&PredayManager::processPersonsForLT_Population, this, first, last, (*fileNameIt)));
-				fileNameIt++;
-			}
-			else if (mtConfig.runningPredayLogsumComputation())
+			if (mtConfig.runningPredayLogsumComputation())
 			{
 				threadGroup.create_thread(boost::bind(&PredayManager::computeLogsumsForLT_Population, this, first, last));
 			}
@@ -857,12 +871,6 @@ void sim_mob::medium::PredayManager::dispatchLT_Persons()
 		}
 		threadGroup.join_all();
 	}
-
-	// merge log files from each thread into 1 file.
-	if (mtConfig.isFileOutputEnabled())
-	{
-		mergeCSV_Files(logFileNames, logFileNamePrefix);
-	}
 }
 
 
@@ -946,62 +954,58 @@ void PredayManager::runLogSumComputation()
 
 void PredayManager::runPredaySimulation()
 {
-    boost::thread_group threadGroup;
+    simulateLT_Population(mtConfig.dasConfig.streaming);
+}
+
+void PredayManager::simulateLT_Population(bool copyToTable)
+{
     unsigned numWorkers = mtConfig.getNumPredayThreads();
-    std::list<std::string> logFileNames;
-    std::string logFileNamePrefix;
-    logFileNamePrefix = "activity_schedule";
-    constructFileNames(numWorkers, logFileNamePrefix, logFileNames);
+    bool outputSchedules = copyToTable || mtConfig.isFileOutputEnabled();
+
+    ActivityScheduleWriter scheduleWriter(MAX_QUEUED_SCHEDULE_CHUNKS_PER_THREAD * numWorkers);
+    if (copyToTable)
+    {
+        createDayActivityScheduleTable();
+        const std::string tableName = mtConfig.dasConfig.schema + "." + mtConfig.dasConfig.table;
+        scheduleWriter.copyToTable(ConfigManager::GetInstance().FullConfig().getDatabaseConnectionString(false), tableName,
+                getDayActivityScheduleColumns());
+    }
+    if (mtConfig.isFileOutputEnabled())
+    {
+        scheduleWriter.writeToFile(ACTIVITY_SCHEDULE_FILE);
+    }
+    if (outputSchedules)
+    {
+        scheduleWriter.start();
+    }
+    ActivityScheduleWriter* writer = outputSchedules ? &scheduleWriter : nullptr;
+
+    boost::atomic<std::size_t> nextChunk(0);
     if (numWorkers == 1)
     { // if single threaded execution was requested
-        processPersonsForLT_Population(ltPersonIdList.begin(), ltPersonIdList.end(), logFileNames.front());
+        processPersonsForLT_Population(nextChunk, writer);
     }
     else
     {
-        LT_PersonIdList::size_type numPersons = ltPersonIdList.size();
-        LT_PersonIdList::size_type numPersonsPerThread = numPersons / numWorkers;
-        Print() << "numPersons:" << numPersons << "|numWorkers:" << numWorkers << "|numPersonsPerThread:" << numPersonsPerThread << std::endl;
+        Print() << "numPersons:" << ltPersonIdList.size() << "|numWorkers:" << numWorkers << "|personsPerChunk:" << PERSON_CHUNK_SIZE << std::endl;
 
-        /*
-         * We are passing different iterators on the same list into the threaded
-         * function. Each thread will iterate through a mutually exclusive and
-         * exhaustive set of persons from the population.
-         *
-         * Note that each thread will iterate the same personList with different
-         * start and end iterators. It is therefore important that none of the
-         * threads change the personList.
-         */
-        LT_PersonIdList::iterator first = ltPersonIdList.begin();
-        LT_PersonIdList::iterator last = ltPersonIdList.begin() + numPersonsPerThread;
-        std::list<std::string>::const_iterator fileNameIt = logFileNames.begin();
-        for (int i = 1; i <= numWorkers; i++)
+        boost::thread_group threadGroup;
+        for (unsigned i = 0; i < numWorkers; i++)
         {
-            threadGroup.create_thread(boost::bind(&PredayManager::processPersonsForLT_Population, this, first, last, (*fileNameIt)));
-            fileNameIt++;
-
-            first = last;
-            if (i + 1 == numWorkers)
-            {
-                // if the next iteration is the last take all remaining persons
-                last = ltPersonIdList.end();
-            }
-            else
-            {
-                last = last + numPersonsPerThread;
-            }
+            threadGroup.create_thread(boost::bind(&PredayManager::processPersonsForLT_Population, this, boost::ref(nextChunk), writer));
         }
         threadGroup.join_all();
     }
 
-    // merge log files from each thread into 1 file.
-    if (mtConfig.isFileOutputEnabled())
+    if (outputSchedules)
     {
-        mergeCSV_Files(logFileNames, logFileNamePrefix);
+        scheduleWriter.finish();
     }
+    activityScheduleTableFilled = copyToTable;
 }
 
 
-void PredayManager::updateDayActivityScheduleTable()
+void PredayManager::createDayActivityScheduleTable()
 {
 	MT_Config& mtCfg = MT_Config::getInstance();
 
@@ -1064,27 +1068,30 @@ void PredayManager::updateDayActivityScheduleTable()
 	query = (sql_.prepare << "ALTER TABLE " << tableName << " OWNER TO postgres");
 	query.execute();
 
-	PG_BulkInserter bulkInserter(NUM_INSERTS_PER_QUERY);
-	bulkInserter.setInputFile(mtCfg.dasConfig.fileName);
-    std::vector<std::string> columnNames;
-    if(!(MT_Config::getInstance().isEnergyModelEnabled()))
-    {
-        columnNames = {"person_id", "tour_no", "tour_type", "stop_no", "stop_type", "stop_location",
-                                                "stop_zone", "stop_mode", "primary_stop", "arrival_time", "departure_time",
-                                                "prev_stop_location", "prev_stop_zone", "prev_stop_departure_time"};
-    }
-    else
-    {
-        columnNames = {"person_id", "tour_no", "tour_type", "stop_no", "stop_type", "stop_location",
-                       "stop_zone", "stop_mode", "primary_stop", "arrival_time", "departure_time",
-                       "prev_stop_location", "prev_stop_zone", "prev_stop_departure_time","drivetrain","make","model"};
-    }
-	bulkInserter.buildQuery(tableName, columnNames);
-	bulkInserter.connect(ConfigManager::GetInstance().FullConfig().getDatabaseConnectionString(false));
-	bulkInserter.bulkInsert();
+	sql_.close();
+}
+
+void PredayManager::updateDayActivityScheduleTable()
+{
+	MT_Config& mtCfg = MT_Config::getInstance();
+
+	std::string tableName = mtCfg.dasConfig.schema + "." + mtCfg.dasConfig.table;
+
+	if (!activityScheduleTableFilled)
+	{
+		createDayActivityScheduleTable();
+
+		PG_BulkInserter bulkInserter(NUM_INSERTS_PER_QUERY);
+		bulkInserter.setInputFile(mtCfg.dasConfig.fileName);
+		bulkInserter.buildQuery(tableName, getDayActivityScheduleColumns());
+		bulkInserter.connect(ConfigManager::GetInstance().FullConfig().getDatabaseConnectionString(false));
+		bulkInserter.bulkInsert();
+	}
+
+	soci::session sql_(soci::postgresql, ConfigManager::GetInstanceRW().FullConfig().getDatabaseConnectionString(false));
 
 	/// Create Indexes and update sharing modes
-	query = (sql_.prepare << "SELECT " << mtCfg.dasConfig.updateProc << "('" << mtCfg.dasConfig.schema << "','" << mtCfg.dasConfig.table << "');");
+	soci::statement query = (sql_.prepare << "SELECT " << mtCfg.dasConfig.updateProc << "('" << mtCfg.dasConfig.schema << "','" << mtCfg.dasConfig.table << "');");
 	query.execute();
 
 	sql_.close();
@@ -1429,7 +1436,7 @@ void sim_mob::medium::PredayManager::processPersonsForCalibration(const PersonLi
 
 	for (PersonList::iterator i = firstPersonIt; i != oneAfterLastPersonIt; i++)
 	{
-        PredaySystem predaySystem(**i, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
+        PredaySystem predaySystem(**i, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, ttStore, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
 		predaySystem.planDay();
 		predaySystem.updateStatistics(simStats);
 		if (consoleOutput)
@@ -1517,10 +1524,8 @@ void sim_mob::medium::PredayManager::computeWeightedGradient(const std::vector<s
 	}
 }
 
-void sim_mob::medium::PredayManager::processPersonsForLT_Population(const LT_PersonIdList::iterator& firstPersonIdIt,
-		const LT_PersonIdList::iterator& oneAfterLastPersonIdIt, const std::string& activityScheduleLog)
+void sim_mob::medium::PredayManager::processPersonsForLT_Population(boost::atomic<std::size_t>& nextChunk, ActivityScheduleWriter* scheduleWriter)
 {
-	bool outputTripchains = mtConfig.isFileOutputEnabled();
 	bool consoleOutput = mtConfig.isConsoleOutput();
 
     const ConfigParams& cfg = ConfigManager::GetInstance().FullConfig();
@@ -1553,31 +1558,42 @@ void sim_mob::medium::PredayManager::processPersonsForLT_Population(const LT_Per
 	SimmobSqlDao logsumSqlDao(simmobConn, logsumTableName, activityLogsumColumns);
 	TimeDependentTT_SqlDao tcostDao(simmobConn);
 
-	// open log file for this thread
-	std::ofstream activityScheduleLogFile(activityScheduleLog.c_str(), std::ios::trunc | std::ios::out);
 	std::stringstream activityScheduleStream;
+	std::string activityScheduleRows;
 
-	// loop through all persons within the range and plan their day
-	for (LT_PersonIdList::iterator i = firstPersonIdIt; i != oneAfterLastPersonIdIt; i++)
+	// claim chunks of persons until all are claimed and plan the day of each person in the chunk
+	const LT_PersonIdList::size_type numPersons = ltPersonIdList.size();
+	for (std::size_t chunk = nextChunk++; chunk * PERSON_CHUNK_SIZE < numPersons; chunk = nextChunk++)
 	{
-		PersonParams personParams;
-		populationDao.getOneById(*i, personParams);
-		if (personParams.getPersonId().empty())
+		LT_PersonIdList::const_iterator i = ltPersonIdList.begin() + chunk * PERSON_CHUNK_SIZE;
+		LT_PersonIdList::const_iterator oneAfterLastPersonIdIt = ltPersonIdList.begin() + std::min(numPersons, (chunk + 1) * PERSON_CHUNK_SIZE);
+		for (; i != oneAfterLastPersonIdIt; i++)
 		{
-			continue;
-		} // some persons are not complete in the database
-		logsumSqlDao.getLogsumById(*i, personParams);
-		PredaySystem predaySystem(personParams, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
-		predaySystem.planDay();
+			PersonParams personParams;
+			populationDao.getOneById(*i, personParams);
+			if (personParams.getPersonId().empty())
+			{
+				continue;
+			} // some persons are not complete in the database
+			logsumSqlDao.getLogsumById(*i, personParams);
+			PredaySystem predaySystem(personParams, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, ttStore, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
+			predaySystem.planDay();
 
-		if (outputTripchains)
-		{
-			predaySystem.outputActivityScheduleToStream(zoneNodeMap, activityScheduleStream);
-			outputToFile(activityScheduleLogFile, activityScheduleStream);
+			if (scheduleWriter)
+			{
+				predaySystem.outputActivityScheduleToStream(zoneNodeMap, activityScheduleStream);
+			}
+			if (consoleOutput)
+			{
+				predaySystem.printLogs();
+			}
 		}
-		if (consoleOutput)
+
+		if (scheduleWriter)
 		{
-			predaySystem.printLogs();
+			activityScheduleRows = activityScheduleStream.str();
+			activityScheduleStream.str(std::string());
+			scheduleWriter->write(activityScheduleRows);
 		}
 	}
 }
@@ -1601,7 +1617,7 @@ void sim_mob::medium::PredayManager::computeLogsumsForCalibration(const PersonLi
 	// loop through all persons within the range and plan their day
 	for (PersonList::iterator i = firstPersonIt; i != oneAfterLastPersonIt; i++)
 	{
-		PredaySystem predaySystem(**i, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
+		PredaySystem predaySystem(**i, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, ttStore, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
 		predaySystem.computeLogsums();
 		if (consoleOutput)
 		{
@@ -1653,7 +1669,7 @@ void sim_mob::medium::PredayManager::computeLogsumsForLT_Population(const LT_Per
 		{
 			continue;
 		} // some persons are not complete in the database
-        PredaySystem predaySystem(personParams, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
+        PredaySystem predaySystem(personParams, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, ttStore, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
 		predaySystem.computeLogsums();
 		logsumSqlDao.insert(personParams);
 		if (consoleOutput)
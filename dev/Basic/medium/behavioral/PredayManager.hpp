@@ -3,6 +3,7 @@
 //   license.txt   (http://opensource.org/licenses/MIT)
 
 #pragma once
+#include <boost/atomic.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/function.hpp>
 #include <ostream>
@@ -11,6 +12,7 @@
 #include <vector>
 #include "behavioral/params/PersonParams.hpp"
 #include "behavioral/params/ZoneCostParams.hpp"
+#include "ActivityScheduleWriter.hpp"
 #include "CalibrationStatistics.hpp"
 #include "config/MT_Config.hpp"
 #include "PredaySystem.hpp"
@@ -145,6 +147,13 @@ public:
      */
     void loadUnavailableODs();
 
+    /**
+     * loads the time dependent travel times into memory if the travel time store is enabled in config.
+     * The travel times are memory-mapped from the configured file if it exists. Otherwise they are
+     * bulk loaded from the database and written to the configured file (if any) for subsequent runs.
+     */
+    void loadTimeDependentTravelTimes();
+
     /**
      * Distributes long-term persons to different threads and starts the threads which process the persons
      */
@@ -152,8 +161,17 @@ public:
 
     void runLogSumComputation();
 
+    /**
+     * Runs preday for the LT population.
+     * If streaming is enabled in the activity schedule table config, the table is created first and
+     * the schedules are copied to it while they are computed.
+     */
     void runPredaySimulation();
 
+    /**
+     * Loads the activity schedule file into the day activity schedule table, unless the schedules
+     * were already copied to it by runPredaySimulation, and runs the update procedure of the table
+     */
     void updateDayActivityScheduleTable();
 
     void updateGetPersonBetweenStoredProc();
@@ -179,17 +197,30 @@ private:
 
     typedef void (PredayManager::*threadedFnPtr)(const PersonList::iterator&, const PersonList::iterator&, size_t);
 
+    /**
+     * Runs the Preday system of models for the LT population on the preday threads
+     * and outputs the activity schedules as they are computed.
+     *
+     * @param copyToTable whether to create the day activity schedule table and copy the schedules to it
+     */
+    void simulateLT_Population(bool copyToTable);
+
     /**
      * Threaded function loop for simulation of LT population
-     * Loops through all elements in personList within the specified range and
-     * invokes the Preday system of models for each of them.
+     * Claims chunks of consecutive persons of ltPersonIdList until all of them are claimed and
+     * invokes the Preday system of models for each person of the chunk. Threads which get
+     * cheaper persons claim more chunks, so that all threads finish at about the same time.
      *
-     * @param first personIdList iterator corresponding to the first person to be
-     *              processed
-     * @param last personIdList iterator corresponding to the person after the
-     *              last person to be processed
+     * @param nextChunk index of the next chunk to claim, shared by all threads
+     * @param scheduleWriter writer receiving the activity schedules of each chunk;
+     *              nullptr if schedules are not output
      */
-    void processPersonsForLT_Population(const LT_PersonIdList::iterator& first, const LT_PersonIdList::iterator& last, const std::string& scheduleLog);
+    void processPersonsForLT_Population(boost::atomic<std::size_t>& nextChunk, ActivityScheduleWriter* scheduleWriter);
+
+    /**
+     * drops and re-creates the day activity schedule table
+     */
+    void createDayActivityScheduleTable();
 
     /**
      * Distributes persons to different threads and starts the threads which process the persons for calibration
@@ -323,6 +354,12 @@ private:
     /** for each origin, has a list of unavailable destinations */
     std::vector<OD_Pair> unavailableODs;
 
+    /** time dependent travel times shared by all preday threads */
+    TimeDependentTT_Store ttStore;
+
+    /** whether runPredaySimulation copied the activity schedules to the day activity schedule table */
+    bool activityScheduleTableFilled;
+
     /**
      * list of values computed for objective function
      * objectiveFunctionValue[i] is the objective function value for iteration i
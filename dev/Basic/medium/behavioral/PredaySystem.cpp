@@ -151,12 +151,12 @@ namespace {
 PredaySystem::PredaySystem(PersonParams& personParams,
         const ZoneMap& zoneMap, const boost::unordered_map<int,int>& zoneIdLookup,
         const CostMap& amCostMap, const CostMap& pmCostMap, const CostMap& opCostMap,
-        TimeDependentTT_SqlDao& tcostDao,
+        TimeDependentTT_SqlDao& tcostDao, const TimeDependentTT_Store& ttStore,
         const std::vector<OD_Pair>& unavailableODs, const std::unordered_map<StopType, ActivityTypeConfig> &activityTypeConfig,
         const int numModes)
 : personParams(personParams), zoneMap(zoneMap), zoneIdLookup(zoneIdLookup),
   amCostMap(amCostMap), pmCostMap(pmCostMap), opCostMap(opCostMap),
-  tcostDao(tcostDao), unavailableODs(unavailableODs),
+  tcostDao(tcostDao), ttStore(ttStore), unavailableODs(unavailableODs),
   firstAvailableTimeIndex(FIRST_INDEX), logStream(std::stringstream::out),
   activityTypeConfigMap(activityTypeConfig), numModes(numModes)
 {}
@@ -523,7 +523,7 @@ TimeWindowAvailability PredaySystem::predictTourTimeOfDay(Tour& tour)
         case PT_TRAVEL_MODE:
         case PRIVATE_BUS_MODE:
 		{
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
+			fetchTimeDependentTT(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
 			break;
 		}
         case PVT_CAR_MODE: // Fall through
@@ -531,7 +531,7 @@ TimeWindowAvailability PredaySystem::predictTourTimeOfDay(Tour& tour)
         case PVT_BIKE_MODE:
         case TAXI_MODE:
 		{
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
+			fetchTimeDependentTT(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
 			break;
 		}
         case WALK_MODE:
@@ -1056,7 +1056,7 @@ bool PredaySystem::predictStopTimeOfDay(Stop* stop, int destination, bool isBefo
         case PT_TRAVEL_MODE:
         case PRIVATE_BUS_MODE:
 		{
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
+			fetchTimeDependentTT(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
 			break;
 		}
         case PVT_CAR_MODE:
@@ -1064,7 +1064,7 @@ bool PredaySystem::predictStopTimeOfDay(Stop* stop, int destination, bool isBefo
         case PVT_BIKE_MODE:
         case TAXI_MODE:
 		{
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
+			fetchTimeDependentTT(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
 			break;
 		}
         case WALK_MODE:
@@ -1304,6 +1304,35 @@ bool PredaySystem::predictStopTimeOfDay(Stop* stop, int destination, bool isBefo
 	return true;
 }
 
+bool PredaySystem::fetchTimeDependentTT(TravelTimeMode ttMode, int origin, int destination, TimeDependentTT_Params& todBasedTT)
+{
+	if(ttStore.isLoaded())
+	{
+		return ttStore.getTT_ByOD(ttMode, origin, destination, todBasedTT);
+	}
+	return tcostDao.getTT_ByOD(ttMode, origin, destination, todBasedTT);
+}
+
+double PredaySystem::fetchTimeDependentTT(TravelTimeMode ttMode, int origin, int destination, bool arrivalBased, double timeIdx)
+{
+	if(ttStore.isLoaded())
+	{
+		if(arrivalBased)
+		{
+			return ttStore.getArrivalBasedTT_at(ttMode, origin, destination, timeIdx-1);
+		}
+		return ttStore.getDepartureBasedTT_at(ttMode, origin, destination, timeIdx-1);
+	}
+
+	TimeDependentTT_Params todBasedTT;
+	tcostDao.getTT_ByOD(ttMode, origin, destination, todBasedTT);
+	if(arrivalBased)
+	{
+		return todBasedTT.getArrivalBasedTT_at(timeIdx-1);
+	}
+	return todBasedTT.getDepartureBasedTT_at(timeIdx-1);
+}
+
 double PredaySystem::fetchTravelTime(int origin, int destination, int mode,  bool arrivalBased, double timeIdx)
 {
 	double travelTime = 0.0;
@@ -1315,16 +1344,7 @@ double PredaySystem::fetchTravelTime(int origin, int destination, int mode,  boo
         case PT_TRAVEL_MODE:
         case PRIVATE_BUS_MODE:
 		{
-			TimeDependentTT_Params todBasedTT;
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
-			if(arrivalBased)
-			{
-				travelTime = todBasedTT.getArrivalBasedTT_at(timeIdx-1);
-			}
-			else
-			{
-				travelTime = todBasedTT.getDepartureBasedTT_at(timeIdx-1);
-			}
+			travelTime = fetchTimeDependentTT(TravelTimeMode::TT_PUBLIC, origin, destination, arrivalBased, timeIdx);
 			break;
 		}
         case PVT_CAR_MODE:
@@ -1332,16 +1352,7 @@ double PredaySystem::fetchTravelTime(int origin, int destination, int mode,  boo
         case PVT_BIKE_MODE:
         case TAXI_MODE:
 		{
-			TimeDependentTT_Params todBasedTT;
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
-			if(arrivalBased)
-			{
-				travelTime = todBasedTT.getArrivalBasedTT_at(timeIdx-1);
-			}
-			else
-			{
-				travelTime = todBasedTT.getDepartureBasedTT_at(timeIdx-1);
-			}
+			travelTime = fetchTimeDependentTT(TravelTimeMode::TT_PRIVATE, origin, destination, arrivalBased, timeIdx);
 			break;
 		}
         case WALK_MODE:
@@ -11,6 +11,7 @@
 #include <sstream>
 #include "behavioral/lua/PredayLuaProvider.hpp"
 #include "behavioral/params/PersonParams.hpp"
+#include "behavioral/TimeDependentTT_Store.hpp"
 #include "CalibrationStatistics.hpp"
 #include "PredayClasses.hpp"
 #include "database/predaydao/PopulationSqlDao.hpp"
@@ -152,6 +153,29 @@ private:
 	 */
 	double fetchTravelTime(int origin, int destination, int mode, bool isArrivalBased, double timeIdx);
 
+	/**
+	 * fetches all time dependent travel times for an OD.
+	 * The in-memory travel time store is used if it was loaded; the travel time tables are queried otherwise.
+	 * @param ttMode mode type - (public transit / private) for fetching travel time
+	 * @param origin the origin zone code
+	 * @param destination the destination zone code
+	 * @param todBasedTT output object to fill
+	 * @return true if travel times were found for the OD; false otherwise
+	 */
+	bool fetchTimeDependentTT(TravelTimeMode ttMode, int origin, int destination, TimeDependentTT_Params& todBasedTT);
+
+	/**
+	 * fetches the time dependent travel time for an OD in one time window, without copying the travel times of the other windows
+	 * when the in-memory travel time store is loaded.
+	 * @param ttMode mode type - (public transit / private) for fetching travel time
+	 * @param origin the origin zone code
+	 * @param destination the destination zone code
+	 * @param isArrivalBased travel time is arrival based. true implies arrival based, false implies departure based
+	 * @param timeIdx the time index to fetch
+	 * @return travel time
+	 */
+	double fetchTimeDependentTT(TravelTimeMode ttMode, int origin, int destination, bool isArrivalBased, double timeIdx);
+
 	/**
 	 * Calculates the arrival time for stops in the second half tour.
 	 * this function sets the departure time for the currentStop
@@ -280,6 +304,12 @@ private:
 	 */
 	TimeDependentTT_SqlDao& tcostDao;
 
+	/**
+	 * In-memory store of time dependent travel times shared by all preday threads.
+	 * Used instead of tcostDao if loaded.
+	 */
+	const TimeDependentTT_Store& ttStore;
+
 	/**
 	 * used for logging messages
 	 */
@@ -296,7 +326,8 @@ private:
 
 public:
 	PredaySystem(PersonParams& personParams, const ZoneMap& zoneMap, const boost::unordered_map<int, int>& zoneIdLookup, const CostMap& amCostMap,
-            const CostMap& pmCostMap, const CostMap& opCostMap, TimeDependentTT_SqlDao& tcosDao, const std::vector<OD_Pair>& unavailableODs,
+            const CostMap& pmCostMap, const CostMap& opCostMap, TimeDependentTT_SqlDao& tcosDao, const TimeDependentTT_Store& ttStore,
+            const std::vector<OD_Pair>& unavailableODs,
             const std::unordered_map<StopType, ActivityTypeConfig>& activityTypeConfig, const int numModes);
 
 	virtual ~PredaySystem();
@@ -34,7 +34,7 @@ ServiceController::ServiceController()
 
 void ServiceController::useServiceController(std::string time)
 {
-    LuaRef useServiceControllerRef = getGlobal(state.get(), "use_servicecontroller");
+    const LuaRef& useServiceControllerRef = getFunction("use_servicecontroller");
     lineTrainDriversLock.lock();
     LuaRef retVal = useServiceControllerRef(this,time);
     DailyTime now(time);
@@ -4,7 +4,9 @@
 
 #include "PredayLuaModel.hpp"
 
+#include "behavioral/lua/LogitLuaFunctions.hpp"
 #include "behavioral/StopType.hpp"
+#include "config/MT_Config.hpp"
 #include "lua/LuaLibrary.hpp"
 #include "lua/third-party/luabridge/LuaBridge.h"
 #include "lua/third-party/luabridge/RefCountedObject.h"
@@ -220,10 +222,17 @@ void sim_mob::medium::PredayLuaModel::mapClasses()
 
 }
 
+void sim_mob::medium::PredayLuaModel::mapNativeFunctions()
+{
+    if (MT_Config::getInstance().isNativeLogitEnabled())
+    {
+        lua::registerNativeLogitFunctions(state.get());
+    }
+}
+
 void sim_mob::medium::PredayLuaModel::computeDayPatternLogsums(PersonParams& personParams) const
 {
-    LuaRef computeLogsumDPT = getGlobal(state.get(), "compute_logsum_dpt");
-    LuaRef dptRetVal = computeLogsumDPT(personParams);
+    LuaRef dptRetVal = getFunction("compute_logsum_dpt")(&personParams);
     if(dptRetVal.isTable())
     {
         personParams.setDptLogsum(dptRetVal[1].cast<double>());
@@ -233,15 +242,12 @@ void sim_mob::medium::PredayLuaModel::computeDayPatternLogsums(PersonParams& per
         throw std::runtime_error("compute_logsum_dpt function does not return a table as expected");
     }
 
-    LuaRef computeLogsumDPS = getGlobal(state.get(), "compute_logsum_dps");
-    LuaRef dpsLogsum = computeLogsumDPS(personParams);
-    personParams.setDpsLogsum(dpsLogsum.cast<double>());
+    personParams.setDpsLogsum(call<double>(getFunction("compute_logsum_dps"), &personParams));
 }
 
 void sim_mob::medium::PredayLuaModel::computeDayPatternBinaryLogsums(PersonParams& personParams) const
 {
-    LuaRef computeLogsumDPB = getGlobal(state.get(), "compute_logsum_dpb");
-    LuaRef dpbRetVal = computeLogsumDPB(personParams);
+    LuaRef dpbRetVal = getFunction("compute_logsum_dpb")(&personParams);
     if(dpbRetVal.isTable())
     {
         personParams.setDpbLogsum(dpbRetVal[1].cast<double>());
@@ -255,9 +261,7 @@ void sim_mob::medium::PredayLuaModel::computeDayPatternBinaryLogsums(PersonParam
 void sim_mob::medium::PredayLuaModel::predictDayPattern(PersonParams& personParams, const std::unordered_map<int, ActivityTypeConfig> &activityTypes,
                                                         std::unordered_map<int, bool> &dayPatternTours, std::unordered_map<int, bool> &dayPatternStops) const
 {
-    LuaRef chooseDPB = getGlobal(state.get(), "choose_dpb");
-    LuaRef retValB = chooseDPB(&personParams);
-    if(retValB.cast<int>() == 1) // no travel
+    if(call<int>(getFunction("choose_dpb"), &personParams) == 1) // no travel
     {
         for (const auto& activityType : activityTypes)
         {
@@ -268,8 +272,7 @@ void sim_mob::medium::PredayLuaModel::predictDayPattern(PersonParams& personPara
     else
     {
         //Day pattern tours
-        LuaRef chooseDPT = getGlobal(state.get(), "choose_dpt");
-        LuaRef retValT = chooseDPT(&personParams);
+        LuaRef retValT = getFunction("choose_dpt")(&personParams);
         if (retValT.isTable())
         {
             for (const auto& activityType : activityTypes)
@@ -283,8 +286,7 @@ void sim_mob::medium::PredayLuaModel::predictDayPattern(PersonParams& personPara
         }
 
         //Day pattern stops
-        LuaRef chooseDPS = getGlobal(state.get(), "choose_dps");
-        LuaRef retValS = chooseDPS(&personParams);
+        LuaRef retValS = getFunction("choose_dps")(&personParams);
         if (retValS.isTable())
         {
             for (const auto& activityType : activityTypes)
@@ -308,9 +310,7 @@ void sim_mob::medium::PredayLuaModel::predictNumTours(PersonParams& personParams
 
         if (dayPatternTour.second)
         {
-            std::string luaFunc = "choose_" + activityTypes.at(dayPatternTour.first).numToursModel;
-            LuaRef chooseNT = getGlobal(state.get(), luaFunc.c_str());
-            LuaRef retVal = chooseNT(&personParams);
+            LuaRef retVal = getFunction("choose_", activityTypes.at(dayPatternTour.first).numToursModel)(&personParams);
             if (retVal.isNumber())
             {
                 numTours[dayPatternTour.first] = retVal.cast<int>();
@@ -321,8 +321,7 @@ void sim_mob::medium::PredayLuaModel::predictNumTours(PersonParams& personParams
 
 bool sim_mob::medium::PredayLuaModel::predictUsualWorkLocation(PersonParams& personParams, UsualWorkParams& usualWorkParams) const
 {
-    LuaRef chooseUW = getGlobal(state.get(), "choose_uw"); // choose usual work location
-    LuaRef retVal = chooseUW(&personParams, &usualWorkParams);
+    LuaRef retVal = getFunction("choose_uw")(&personParams, &usualWorkParams);
     if (!retVal.isNumber())
     {
         throw std::runtime_error("Error in usual work location model. Unexpected return value");
@@ -337,10 +336,7 @@ int sim_mob::medium::PredayLuaModel::predictTourMode(PersonParams& personParams,
 
     if (!tmModel.empty())
     {
-        std::string luaFunc = "choose_" + tmModel;
-        LuaRef chooseTM = getGlobal(state.get(), luaFunc.c_str());
-        LuaRef retVal = chooseTM(&personParams, &tourModeParams);
-        return retVal.cast<int>();
+        return call<int>(getFunction("choose_", tmModel), &personParams, &tourModeParams);
     }
     else
         {
@@ -359,10 +355,8 @@ void sim_mob::medium::PredayLuaModel::computeTourModeLogsumWork(PersonParams& pe
         {
             if (!actConfig.tourModeModel.empty())
             {
-                std::string luaFunc = "compute_logsum_" + actConfig.tourModeModel;
-                LuaRef computeLogsumTMW = getGlobal(state.get(), luaFunc.c_str());
-                LuaRef workLogSum = computeLogsumTMW(&personParams, &tourModeParams);
-                personParams.setActivityLogsum(activity.first, workLogSum.cast<double>());
+                double workLogSum = call<double>(getFunction("compute_logsum_", actConfig.tourModeModel), &personParams, &tourModeParams);
+                personParams.setActivityLogsum(activity.first, workLogSum);
             }
         }
     }
@@ -379,10 +373,8 @@ void sim_mob::medium::PredayLuaModel::computeTourModeLogsumEducation(PersonParam
         {
             if (!actConfig.tourModeModel.empty())
             {
-                std::string luaFunc = "compute_logsum_" + actConfig.tourModeModel;
-                LuaRef computeLogsumTME = getGlobal(state.get(), luaFunc.c_str());
-                LuaRef eduLogSum = computeLogsumTME(&personParams, &tourModeParams);
-                personParams.setActivityLogsum(activity.first, eduLogSum.cast<double>());
+                double eduLogSum = call<double>(getFunction("compute_logsum_", actConfig.tourModeModel), &personParams, &tourModeParams);
+                personParams.setActivityLogsum(activity.first, eduLogSum);
             }
         }
     }
@@ -403,20 +395,18 @@ void sim_mob::medium::PredayLuaModel::computeTourModeDestinationLogsum(PersonPar
         {
             if (!actConfig.tourModeDestModel.empty())
             {
-                std::string luaFunc = "compute_logsum_" + actConfig.tourModeDestModel;
-                LuaRef computeLogsumTMDW = getGlobal(state.get(), luaFunc.c_str());
-                LuaRef workLogSum = computeLogsumTMDW(&personParams, &tourModeDestinationParams, zoneSize);
-                personParams.setActivityLogsum(activity.first, workLogSum.cast<double>());
+                double workLogSum = call<double>(getFunction("compute_logsum_", actConfig.tourModeDestModel), &personParams,
+                        &tourModeDestinationParams, zoneSize);
+                personParams.setActivityLogsum(activity.first, workLogSum);
             }
         }
         else
         {
             if (!actConfig.tourModeDestModel.empty())
             {
-                 std::string luaFunc = "compute_logsum_" + actConfig.tourModeDestModel;
-                LuaRef computeLogsumTMD = getGlobal(state.get(), luaFunc.c_str());
-                LuaRef logsum = computeLogsumTMD(&personParams, &tourModeDestinationParams, zoneSize);
-                personParams.setActivityLogsum(activity.first, logsum.cast<double>());
+                double logsum = call<double>(getFunction("compute_logsum_", actConfig.tourModeDestModel), &personParams,
+                        &tourModeDestinationParams, zoneSize);
+                personParams.setActivityLogsum(activity.first, logsum);
             }
         }
     }
@@ -429,10 +419,7 @@ int sim_mob::medium::PredayLuaModel::predictTourModeDestination(PersonParams& pe
 
     if(!tmdModel.empty())
     {
-        std::string luaFunc = "choose_" + tmdModel;
-        LuaRef chooseTMD = getGlobal(state.get(), luaFunc.c_str());
-        LuaRef retVal = chooseTMD(&personParams, &tourModeDestinationParams);
-        return retVal.cast<int>();
+        return call<int>(getFunction("choose_", tmdModel), &personParams, &tourModeDestinationParams);
     }
     else
         {
@@ -455,58 +442,41 @@ int sim_mob::medium::PredayLuaModel::predictTourTimeOfDay(PersonParams& personPa
     const std::string& modelName = activityTypes.at(tourType).tourTimeOfDayModel;
     if (!modelName.empty())
     {
-        std::string luaFunc = "choose_" + modelName;
-        LuaRef chooseTTD = getGlobal(state.get(), luaFunc.c_str());
-        LuaRef retVal = chooseTTD(&personParams, &tourTimeOfDayParams);
-        return retVal.cast<int>();
+        return call<int>(getFunction("choose_", modelName), &personParams, &tourTimeOfDayParams);
     }
 }
 
 int sim_mob::medium::PredayLuaModel::generateIntermediateStop(PersonParams& personParams, StopGenerationParams& isgParams) const
 {
-    LuaRef chooseISG = getGlobal(state.get(), "choose_isg");
-    LuaRef retVal = chooseISG(&personParams, &isgParams);
-    return retVal.cast<int>();
+    return call<int>(getFunction("choose_isg"), &personParams, &isgParams);
 }
 
 int sim_mob::medium::PredayLuaModel::predictStopModeDestination(PersonParams& personParams, StopModeDestinationParams& imdParams) const
 {
-    LuaRef chooseIMD = getGlobal(state.get(), "choose_imd");
-    LuaRef retVal = chooseIMD(&personParams, &imdParams);
-    return retVal.cast<int>();
+    return call<int>(getFunction("choose_imd"), &personParams, &imdParams);
 }
 
 int sim_mob::medium::PredayLuaModel::predictStopTimeOfDay(PersonParams& personParams, StopTimeOfDayParams& stopTimeOfDayParams) const
 {
-    LuaRef chooseITD = getGlobal(state.get(), "choose_itd");
-    LuaRef retVal = chooseITD(&personParams, &stopTimeOfDayParams);
-    return retVal.cast<int>();
+    return call<int>(getFunction("choose_itd"), &personParams, &stopTimeOfDayParams);
 }
 
 int sim_mob::medium::PredayLuaModel::predictWorkBasedSubTour(PersonParams& personParams, SubTourParams& subTourParams) const
 {
-    LuaRef chooseTWS = getGlobal(state.get(), "choose_tws");
-    LuaRef retVal = chooseTWS(&personParams, &subTourParams);
-    return retVal.cast<int>();
+    return call<int>(getFunction("choose_tws"), &personParams, &subTourParams);
 }
 
 int sim_mob::medium::PredayLuaModel::predictSubTourModeDestination(PersonParams& personParams, TourModeDestinationParams& tourModeDestinationParams) const
 {
-    LuaRef chooseSTMD = getGlobal(state.get(), "choose_stmd");
-    LuaRef retVal = chooseSTMD(&personParams, &tourModeDestinationParams);
-    return retVal.cast<int>();
+    return call<int>(getFunction("choose_stmd"), &personParams, &tourModeDestinationParams);
 }
 
 int sim_mob::medium::PredayLuaModel::predictSubTourTimeOfDay(PersonParams& personParams, SubTourParams& subTourParams) const
 {
-    LuaRef chooseSTTD = getGlobal(state.get(), "choose_sttd");
-    LuaRef retVal = chooseSTTD(&personParams, &subTourParams);
-    return retVal.cast<int>();
+    return call<int>(getFunction("choose_sttd"), &personParams, &subTourParams);
 }
 
 int sim_mob::medium::PredayLuaModel::predictAddress(ZoneAddressParams& znAddressParams) const
 {
-    LuaRef chooseAddress = getGlobal(state.get(), "choose_address");
-    LuaRef retVal = chooseAddress(&znAddressParams);
-    return znAddressParams.getAddressId(retVal.cast<int>());
+    return znAddressParams.getAddressId(call<int>(getFunction("choose_address"), &znAddressParams));
 }
@@ -193,6 +193,12 @@ private:
      * Inherited from LuaModel
      */
     void mapClasses();
+
+    /**
+     * Inherited from LuaModel.
+     * Replaces the probability and logsum functions of logit.lua unless the lua functions are configured to be used.
+     */
+    void mapNativeFunctions();
 };
 } // end namespace medium
 } //end namespace sim_mob
@@ -165,94 +165,145 @@ TourModeDestinationParams::~TourModeDestinationParams()
 {
 }
 
-double TourModeDestinationParams::getCostPublicFirst(int zoneId) const
+double TourModeDestinationParams::ZoneCostColumns::get(const std::vector<double>& column, int zoneId, unsigned char required) const
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
+	if (zoneId < 0 || zoneId >= static_cast<int>(costData.size()) || (costData[zoneId] & required) != required)
 	{
-		return 0;
+		throw std::out_of_range("no cost data for zone " + std::to_string(zoneId) + " from origin " + std::to_string(origin));
 	}
-	return amCostsMap.at(origin).at(destination)->getPubCost();
+	return column[zoneId];
 }
 
-double TourModeDestinationParams::getCostPublicSecond(int zoneId) const
+const TourModeDestinationParams::ZoneCostColumns& TourModeDestinationParams::getZoneCostColumns() const
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
+	if (zoneCostColumns.origin == origin && !zoneCostColumns.costData.empty())
 	{
-		return 0;
+		return zoneCostColumns;
 	}
-	return pmCostsMap.at(destination).at(origin)->getPubCost();
-}
 
-double TourModeDestinationParams::getCostCarERPFirst(int zoneId) const
-{
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
+	const ConfigParams& cfg = ConfigManager::GetInstance().FullConfig();
+	double operationalCost = cfg.operationalCostICE(); // resorting to ICE
+	if (powertrain == VehicleParams::BEV or powertrain == VehicleParams::FCV)
 	{
-		return 0;
+		operationalCost = cfg.operationalCostBEV();
 	}
-	return amCostsMap.at(origin).at(destination)->getCarCostErp();
-}
-
-double TourModeDestinationParams::getCostCarERPSecond(int zoneId) const
-{
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
+	else if (powertrain == VehicleParams::HEV or powertrain == VehicleParams::PHEV)
 	{
-		return 0;
+		operationalCost = cfg.operationalCostHEV();
 	}
-	return pmCostsMap.at(destination).at(origin)->getCarCostErp();
-}
 
-double TourModeDestinationParams::getCostCarOPFirst(int zoneId) const
-{
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
+	ZoneCostColumns& columns = zoneCostColumns;
+	const size_t size = zoneMap.size() + 1; // zone ids start from 1
+	columns.origin = origin;
+	columns.costData.assign(size, 0);
+	std::vector<double>* allColumns[] = { &columns.costPublicFirst, &columns.costPublicSecond, &columns.costCarErpFirst,
+			&columns.costCarErpSecond, &columns.costCarOp, &columns.walkDistanceFirst, &columns.walkDistanceSecond,
+			&columns.ttPublicIvtFirst, &columns.ttPublicIvtSecond, &columns.ttCarIvtFirst, &columns.ttCarIvtSecond,
+			&columns.ttPublicOutFirst, &columns.ttPublicOutSecond, &columns.avgTransferNumber };
+	for (std::vector<double>* column : allColumns)
 	{
-		return 0;
+		column->assign(size, 0);
 	}
-	else
+
+	CostMap::const_iterator amOriginIt = amCostsMap.find(origin);
+	for (int zoneId = 1; zoneId < static_cast<int>(size); ++zoneId)
 	{
-		const ConfigParams& cfg = ConfigManager::GetInstance().FullConfig();
-		if (powertrain == VehicleParams::BEV or powertrain == VehicleParams::FCV)
+		ZoneMap::const_iterator zoneIt = zoneMap.find(zoneId);
+		if (zoneIt == zoneMap.end())
 		{
-			return (amCostsMap.at(origin).at(destination)->getDistance() * cfg.operationalCostBEV());
+			continue;
 		}
-		else if (powertrain == VehicleParams::HEV or powertrain == VehicleParams::PHEV)
+		int destination = zoneIt->second->getZoneCode();
+		if (origin == destination)
 		{
-			return (amCostsMap.at(origin).at(destination)->getDistance() * cfg.operationalCostHEV());
+			// all costs are 0 within the origin zone
+			columns.costData[zoneId] = ZoneCostColumns::AM_COSTS | ZoneCostColumns::PM_COSTS;
+			continue;
 		}
-		else // resorting to ICE
+
+		const CostParams* amCosts = nullptr;
+		if (amOriginIt != amCostsMap.end())
 		{
-			return (amCostsMap.at(origin).at(destination)->getDistance() * cfg.operationalCostICE());
+			boost::unordered_map<int, CostParams*>::const_iterator amIt = amOriginIt->second.find(destination);
+			if (amIt != amOriginIt->second.end())
+			{
+				amCosts = amIt->second;
+			}
+		}
+		const CostParams* pmCosts = nullptr;
+		CostMap::const_iterator pmDestinationIt = pmCostsMap.find(destination);
+		if (pmDestinationIt != pmCostsMap.end())
+		{
+			boost::unordered_map<int, CostParams*>::const_iterator pmIt = pmDestinationIt->second.find(origin);
+			if (pmIt != pmDestinationIt->second.end())
+			{
+				pmCosts = pmIt->second;
+			}
 		}
-	}
-}
 
-double TourModeDestinationParams::getCostCarOPSecond(int zoneId) const
-{
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
-	{
-		return 0;
-	}
-	else
-	{
-		const ConfigParams& cfg = ConfigManager::GetInstance().FullConfig();
-		if (powertrain == VehicleParams::BEV or powertrain == VehicleParams::FCV)
+		if (amCosts)
 		{
-			return (amCostsMap.at(origin).at(destination)->getDistance() * cfg.operationalCostBEV());
+			columns.costData[zoneId] |= ZoneCostColumns::AM_COSTS;
+			columns.costPublicFirst[zoneId] = amCosts->getPubCost();
+			columns.costCarErpFirst[zoneId] = amCosts->getCarCostErp();
+			columns.costCarOp[zoneId] = amCosts->getDistance() * operationalCost;
+			columns.walkDistanceFirst[zoneId] = amCosts->getPubWalkt();
+			columns.ttPublicIvtFirst[zoneId] = amCosts->getPubIvt();
+			columns.ttCarIvtFirst[zoneId] = amCosts->getCarIvt();
+			columns.ttPublicOutFirst[zoneId] = amCosts->getPubOut();
 		}
-		else if (powertrain == VehicleParams::HEV or powertrain == VehicleParams::PHEV)
+		if (pmCosts)
 		{
-			return (amCostsMap.at(origin).at(destination)->getDistance() * cfg.operationalCostHEV());
+			columns.costData[zoneId] |= ZoneCostColumns::PM_COSTS;
+			columns.costPublicSecond[zoneId] = pmCosts->getPubCost();
+			columns.costCarErpSecond[zoneId] = pmCosts->getCarCostErp();
+			columns.walkDistanceSecond[zoneId] = pmCosts->getPubWalkt();
+			columns.ttPublicIvtSecond[zoneId] = pmCosts->getPubIvt();
+			columns.ttCarIvtSecond[zoneId] = pmCosts->getCarIvt();
+			columns.ttPublicOutSecond[zoneId] = pmCosts->getPubOut();
 		}
-		else // resorting to ICE
+		if (amCosts && pmCosts)
 		{
-			return (amCostsMap.at(origin).at(destination)->getDistance() * cfg.operationalCostICE());
+			columns.avgTransferNumber[zoneId] = (amCosts->getAvgTransfer() + pmCosts->getAvgTransfer()) / 2;
 		}
 	}
+	return columns;
+}
+
+double TourModeDestinationParams::getCostPublicFirst(int zoneId) const
+{
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.costPublicFirst, zoneId, ZoneCostColumns::AM_COSTS);
+}
+
+double TourModeDestinationParams::getCostPublicSecond(int zoneId) const
+{
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.costPublicSecond, zoneId, ZoneCostColumns::PM_COSTS);
+}
+
+double TourModeDestinationParams::getCostCarERPFirst(int zoneId) const
+{
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.costCarErpFirst, zoneId, ZoneCostColumns::AM_COSTS);
+}
+
+double TourModeDestinationParams::getCostCarERPSecond(int zoneId) const
+{
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.costCarErpSecond, zoneId, ZoneCostColumns::PM_COSTS);
+}
+
+double TourModeDestinationParams::getCostCarOPFirst(int zoneId) const
+{
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.costCarOp, zoneId, ZoneCostColumns::AM_COSTS);
+}
+
+double TourModeDestinationParams::getCostCarOPSecond(int zoneId) const
+{
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.costCarOp, zoneId, ZoneCostColumns::AM_COSTS);
 }
 
 double TourModeDestinationParams::getCostCarParking(int zoneId) const
@@ -262,92 +313,56 @@ double TourModeDestinationParams::getCostCarParking(int zoneId) const
 
 double TourModeDestinationParams::getWalkDistance1(int zoneId) const
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
-	{
-		return 0;
-	}
-	return amCostsMap.at(origin).at(destination)->getPubWalkt();
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.walkDistanceFirst, zoneId, ZoneCostColumns::AM_COSTS);
 }
 
 double TourModeDestinationParams::getWalkDistance2(int zoneId) const
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
-	{
-		return 0;
-	}
-	return pmCostsMap.at(destination).at(origin)->getPubWalkt();
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.walkDistanceSecond, zoneId, ZoneCostColumns::PM_COSTS);
 }
 
 double TourModeDestinationParams::getTT_PublicIvtFirst(int zoneId)
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
-	{
-		return 0;
-	}
-	return amCostsMap.at(origin).at(destination)->getPubIvt();
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.ttPublicIvtFirst, zoneId, ZoneCostColumns::AM_COSTS);
 }
 
 double TourModeDestinationParams::getTT_PublicIvtSecond(int zoneId) const
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
-	{
-		return 0;
-	}
-	return pmCostsMap.at(destination).at(origin)->getPubIvt();
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.ttPublicIvtSecond, zoneId, ZoneCostColumns::PM_COSTS);
 }
 
 double TourModeDestinationParams::getTT_CarIvtFirst(int zoneId) const
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
-	{
-		return 0;
-	}
-	return amCostsMap.at(origin).at(destination)->getCarIvt();
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.ttCarIvtFirst, zoneId, ZoneCostColumns::AM_COSTS);
 }
 
 double TourModeDestinationParams::getTT_CarIvtSecond(int zoneId) const
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
-	{
-		return 0;
-	}
-	return pmCostsMap.at(destination).at(origin)->getCarIvt();
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.ttCarIvtSecond, zoneId, ZoneCostColumns::PM_COSTS);
 }
 
 double TourModeDestinationParams::getTT_PublicOutFirst(int zoneId) const
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
-	{
-		return 0;
-	}
-	return amCostsMap.at(origin).at(destination)->getPubOut();
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.ttPublicOutFirst, zoneId, ZoneCostColumns::AM_COSTS);
 }
 
 double TourModeDestinationParams::getTT_PublicOutSecond(int zoneId) const
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
-	{
-		return 0;
-	}
-	return pmCostsMap.at(destination).at(origin)->getPubOut();
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.ttPublicOutSecond, zoneId, ZoneCostColumns::PM_COSTS);
 }
 
 double TourModeDestinationParams::getAvgTransferNumber(int zoneId) const
 {
-	int destination = zoneMap.at(zoneId)->getZoneCode();
-	if (origin == destination)
-	{
-		return 0;
-	}
-	return (amCostsMap.at(origin).at(destination)->getAvgTransfer() + pmCostsMap.at(destination).at(origin)->getAvgTransfer()) / 2;
+	const ZoneCostColumns& columns = getZoneCostColumns();
+	return columns.get(columns.avgTransferNumber, zoneId, ZoneCostColumns::AM_COSTS | ZoneCostColumns::PM_COSTS);
 }
 
 int TourModeDestinationParams::getCentralDummy(int zone) const
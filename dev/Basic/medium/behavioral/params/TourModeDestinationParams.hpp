@@ -63,6 +63,56 @@ public:
 	double getCostIncrease() const;
 
 private:
+	/**
+	 * Costs and travel times between the origin and every zone, one array per attribute, indexed by zone id.
+	 * The tmd scripts read several of these attributes for every zone, some of them several times;
+	 * the arrays replace the lookups in the zone and cost maps for each read.
+	 * The arrays are built on first use and rebuilt when the origin changes.
+	 */
+	struct ZoneCostColumns
+	{
+		/** flags telling which cost data is available for a zone */
+		enum CostData
+		{
+			AM_COSTS = 1, ///< costs from the origin to the zone in the AM peak
+			PM_COSTS = 2, ///< costs from the zone to the origin in the PM peak
+		};
+
+		ZoneCostColumns() : origin(-1) {}
+
+		/**
+		 * gets the value of an attribute for a zone
+		 * @param column array of the attribute
+		 * @param zoneId id of the zone
+		 * @param required cost data from which the attribute is computed
+		 * @return value of the attribute
+		 * @throws std::out_of_range if the zone or its cost data does not exist, as the lookups in the maps do
+		 */
+		double get(const std::vector<double>& column, int zoneId, unsigned char required) const;
+
+		int origin;
+		std::vector<unsigned char> costData;
+		std::vector<double> costPublicFirst;
+		std::vector<double> costPublicSecond;
+		std::vector<double> costCarErpFirst;
+		std::vector<double> costCarErpSecond;
+		std::vector<double> costCarOp;
+		std::vector<double> walkDistanceFirst;
+		std::vector<double> walkDistanceSecond;
+		std::vector<double> ttPublicIvtFirst;
+		std::vector<double> ttPublicIvtSecond;
+		std::vector<double> ttCarIvtFirst;
+		std::vector<double> ttCarIvtSecond;
+		std::vector<double> ttPublicOutFirst;
+		std::vector<double> ttPublicOutSecond;
+		std::vector<double> avgTransferNumber;
+	};
+
+	/**
+	 * gets the zone cost arrays for the current origin, building them if required
+	 */
+	const ZoneCostColumns& getZoneCostColumns() const;
+
     /*bool drive1Available;
     bool motorAvailable;*/
 
@@ -70,6 +120,8 @@ private:
 
 	int modeForParentWorkTour;
 	double costIncrease;
+
+	mutable ZoneCostColumns zoneCostColumns;
 };
 
 class StopModeDestinationParams: public ModeDestinationParams
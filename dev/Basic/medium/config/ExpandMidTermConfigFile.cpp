@@ -340,6 +340,9 @@ void ExpandMidTermConfigFile::printSettings()
     case WorkGroup::ASSIGN_SMALLEST:
 	std::cout << "smallest" << std::endl;
 	break;
+    case WorkGroup::ASSIGN_TIMEBASED:
+	std::cout << "timebased (rebalanced every " << cfg.simulation.workGroupRebalanceInterval << " ticks)" << std::endl;
+	break;
     default:
 	std::cout << "<unknown>" << std::endl;
 	break;
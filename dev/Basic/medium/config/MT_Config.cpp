@@ -26,7 +26,7 @@ MT_Config::MT_Config() :
 			configSealed(false), fileOutputEnabled(false), consoleOutput(false), predayRunMode(MT_Config::PREDAY_NONE),
 			calibrationMethodology(MT_Config::WSPSA), logsumComputationFrequency(0), supplyUpdateInterval(0),
 			activityScheduleLoadInterval(0), busCapacity(0), populationSource(db::POSTGRES), granPersonTicks(0),threadsNumInPersonLoader(0),
-			energyModelEnabled(false)
+			energyModelEnabled(false), travelTimeStoreEnabled(false), nativeLogitEnabled(true)
 {
 }
 
@@ -300,6 +300,45 @@ void MT_Config::setLogsumTableName(const std::string& logsumTableName)
 		this->logsumTableName = logsumTableName;
     }
 }
+
+bool MT_Config::isTravelTimeStoreEnabled() const
+{
+	return travelTimeStoreEnabled;
+}
+
+void MT_Config::setTravelTimeStoreEnabled(bool enabled)
+{
+	if(!configSealed)
+	{
+		travelTimeStoreEnabled = enabled;
+	}
+}
+
+const std::string& MT_Config::getTravelTimeStoreFile() const
+{
+	return travelTimeStoreFile;
+}
+
+void MT_Config::setTravelTimeStoreFile(const std::string& travelTimeStoreFile)
+{
+	if(!configSealed)
+	{
+		this->travelTimeStoreFile = travelTimeStoreFile;
+	}
+}
+
+bool MT_Config::isNativeLogitEnabled() const
+{
+	return nativeLogitEnabled;
+}
+
+void MT_Config::setNativeLogitEnabled(bool enabled)
+{
+	if(!configSealed)
+	{
+		nativeLogitEnabled = enabled;
+	}
+}
 const unsigned int MT_Config::getThreadsNumInPersonLoader() const
 {
 	return threadsNumInPersonLoader;
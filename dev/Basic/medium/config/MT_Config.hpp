@@ -304,7 +304,7 @@ struct TripChainOutputConfig
  */
 struct DAS_Config
 {
-	DAS_Config() : schema(""), table(""), updateProc(""), fileName(""), vehicleTable("")
+	DAS_Config() : schema(""), table(""), updateProc(""), fileName(""), vehicleTable(""), streaming(true)
 	{}
 
 	std::string schema;
@@ -312,6 +312,9 @@ struct DAS_Config
 	std::string updateProc;
 	std::string fileName;
 	std::string vehicleTable; // Eytan Gross
+
+	/** whether schedules are copied to the table while preday runs, instead of being loaded from fileName afterwards */
+	bool streaming;
 };
 
 
@@ -788,6 +791,42 @@ public:
 	 */
 	void setLogsumTableName(const std::string& logsumTableName);
 
+	/**
+	 * Checks whether time dependent travel times are to be held in memory for preday
+	 * @return true if the in-memory travel time store is enabled, else false
+	 */
+	bool isTravelTimeStoreEnabled() const;
+
+	/**
+	 * Sets whether time dependent travel times are to be held in memory for preday
+	 * @param enabled status to be set
+	 */
+	void setTravelTimeStoreEnabled(bool enabled);
+
+	/**
+	 * get the binary file backing the in-memory travel time store
+	 * @return file name; empty if travel times are to be loaded from the database every run
+	 */
+	const std::string& getTravelTimeStoreFile() const;
+
+	/**
+	 * sets the binary file backing the in-memory travel time store
+	 * @param travelTimeStoreFile file name
+	 */
+	void setTravelTimeStoreFile(const std::string& travelTimeStoreFile);
+
+	/**
+	 * Checks whether the probabilities and logsums of the preday logit models are computed natively
+	 * @return true if the native logit functions replace those of logit.lua, false if the lua functions are used
+	 */
+	bool isNativeLogitEnabled() const;
+
+	/**
+	 * Sets whether the probabilities and logsums of the preday logit models are computed natively
+	 * @param enabled status to be set
+	 */
+	void setNativeLogitEnabled(bool enabled);
+
 	/**
 	 * get threads number for person loader
 	 * @return the threads number in use of person loader
@@ -883,6 +922,15 @@ private:
 	/// name of table containing pre-computed values
 	std::string logsumTableName;
 
+	/// flag to indicate whether preday holds the time dependent travel times in memory
+	bool travelTimeStoreEnabled;
+
+	/// binary file to map the time dependent travel times from (written from the database if absent)
+	std::string travelTimeStoreFile;
+
+	/// flag to indicate whether the preday logit probabilities and logsums are computed natively instead of in lua
+	bool nativeLogitEnabled;
+
 	/// worker allocation details
 	WorkerParams workers;
 
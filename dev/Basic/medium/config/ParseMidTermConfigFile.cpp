@@ -181,6 +181,19 @@ void ParseMidTermConfigFile::processPredayNode(xercesc::DOMElement* node)
 	childNode = GetSingleElementByName(node, "logsum_table", true);
 	mtCfg.setLogsumTableName(ParseString(GetNamedAttributeValue(childNode, "name", true)));
 
+	childNode = GetSingleElementByName(node, "travel_time_store");
+	if (childNode)
+	{
+		mtCfg.setTravelTimeStoreEnabled(ParseBoolean(GetNamedAttributeValue(childNode, "enabled", true)));
+		mtCfg.setTravelTimeStoreFile(ParseString(GetNamedAttributeValue(childNode, "file", false), ""));
+	}
+
+	childNode = GetSingleElementByName(node, "logit_computation");
+	if (childNode)
+	{
+		mtCfg.setNativeLogitEnabled(ParseBoolean(GetNamedAttributeValue(childNode, "native", true)));
+	}
+
 	childNode = GetSingleElementByName(node, "activity_schedule_table", true);
 	mtCfg.dasConfig.schema = ParseString(GetNamedAttributeValue(childNode, "schema", true));
 	mtCfg.dasConfig.table = ParseString(GetNamedAttributeValue(childNode, "table", true));
@@ -189,6 +202,7 @@ void ParseMidTermConfigFile::processPredayNode(xercesc::DOMElement* node)
 	//jo {Apr12 for vehicle table
 	mtCfg.dasConfig.vehicleTable = ParseString(GetNamedAttributeValue(childNode, "vehicleTable", true));
 	//}jo
+	mtCfg.dasConfig.streaming = ParseBoolean(GetNamedAttributeValue(childNode, "streaming", false), true);
 
 	ModelScriptsMap luaModelsMap = processModelScriptsNode(GetSingleElementByName(node, "model_scripts", true));
 	cfg.predayLuaScriptsMap = luaModelsMap;
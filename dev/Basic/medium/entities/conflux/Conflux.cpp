@@ -94,8 +94,8 @@ boost::mutex Conflux::activeAgentsLock;
 std::unordered_map<const Node *,Conflux *> Conflux::nodeConfluxMap;
 Conflux::Conflux(Node* confluxNode, const MutexStrategy& mtxStrat, int id, bool isLoader) :
         Agent(mtxStrat, id), confluxNode(confluxNode), parentWorkerAssigned(false), currFrame(0, 0), isLoader(isLoader), numUpdatesThisTick(0),
-        tickTimeInS(ConfigManager::GetInstance().FullConfig().baseGranSecond()), evadeVQ_Bounds(false), segStatsOutput(std::string()),
-        lnkStatsOutput(std::string())
+        tickTimeInS(ConfigManager::GetInstance().FullConfig().baseGranSecond()), evadeVQ_Bounds(false), laneMerger(confluxNode->getNodeId()),
+        linkMerger(confluxNode->getNodeId()), segStatsOutput(std::string()), lnkStatsOutput(std::string())
 {
     nodeConfluxMap[confluxNode] = this;
 
@@ -462,13 +462,13 @@ void Conflux::loadPersons()
 
 void Conflux::processAgents(timeslice frameNumber)
 {
-    PersonList orderedPersons;
+    orderedPersons.clear();
     getAllPersonsUsingTopCMerge(orderedPersons); //merge on-road agents of this conflux into a single list
     orderedPersons.insert(orderedPersons.end(), activityPerformers.begin(), activityPerformers.end()); // append activity performers
     orderedPersons.insert(orderedPersons.end(), travelingPersons.begin(), travelingPersons.end());
     orderedPersons.insert(orderedPersons.end(), brokenPersons.begin(), brokenPersons.end());
 
-    for (PersonList::iterator personIt = orderedPersons.begin(); personIt != orderedPersons.end(); personIt++) //iterate and update all persons
+    for (std::vector<Person_MT*>::iterator personIt = orderedPersons.begin(); personIt != orderedPersons.end(); personIt++) //iterate and update all persons
     {
         (*personIt)->currTick = currFrame;
         updateAgent(*personIt);
@@ -1304,6 +1304,7 @@ void Conflux::setLinkTravelTimes(double travelTime, const Link* link)
 bool Conflux::callMovementFrameInit(timeslice now, Person_MT* person)
 {
     //register the person as a message handler if required
+    //  (into the context of this conflux, even when its update was stolen by another Worker's thread)
     if (!person->GetContext())
     {
         messaging::MessageBus::RegisterHandler(person);
@@ -2122,11 +2123,11 @@ PersonCount Conflux::countPersons() const
     return count;
 }
 
-void Conflux::getAllPersonsUsingTopCMerge(std::deque<Person_MT*>& mergedPersonDeque)
+void Conflux::getAllPersonsUsingTopCMerge(std::vector<Person_MT*>& mergedPersons)
 {
     SegmentStats* segStats = nullptr;
-    std::vector<PersonList> allPersonLists;
     int sumCapacity = 0;
+    linkMerger.reset();
 
     //need to calculate the time to intersection for each vehicle.
     //basic test-case shows that this calculation is kind of costly.
@@ -2135,7 +2136,6 @@ void Conflux::getAllPersonsUsingTopCMerge(std::deque<Person_MT*>& mergedPersonDe
         const SegmentStatsList& upstreamSegments = upStrmSegMapIt->second;
         sumCapacity += (int) (ceil((*upstreamSegments.rbegin())->getCapacity()));
         double totalTimeToSegEnd = 0;
-        std::deque<Person_MT*> oneDeque;
         for (SegmentStatsList::const_reverse_iterator rdSegIt = upstreamSegments.rbegin(); rdSegIt != upstreamSegments.rend(); rdSegIt++)
         {
             segStats = (*rdSegIt);
@@ -2146,83 +2146,15 @@ void Conflux::getAllPersonsUsingTopCMerge(std::deque<Person_MT*>& mergedPersonDe
                 speed = INFINITESIMAL_DOUBLE;
             }
             segStats->updateLinkDrivingTimes(totalTimeToSegEnd);
-            PersonList tmpAgents;
-            segStats->topCMergeLanesInSegment(tmpAgents);
+            segmentPersons.clear();
+            segStats->topCMergeLanesInSegment(laneMerger, segmentPersons);
             totalTimeToSegEnd += segStats->getLength() / speed;
-            oneDeque.insert(oneDeque.end(), tmpAgents.begin(), tmpAgents.end());
+            linkMerger.append(segmentPersons.begin(), segmentPersons.end());
         }
-        allPersonLists.push_back(oneDeque);
+        linkMerger.endList();
     }
 
-    topCMergeDifferentLinksInConflux(mergedPersonDeque, allPersonLists, sumCapacity);
-}
-
-void Conflux::topCMergeDifferentLinksInConflux(std::deque<Person_MT*>& mergedPersonDeque, std::vector<std::deque<Person_MT*> >& allPersonLists, int capacity)
-{
-    std::vector<std::deque<Person_MT*>::iterator> iteratorLists;
-
-    //init location
-    size_t dequeSize = allPersonLists.size();
-    for (std::vector<std::deque<Person_MT*> >::iterator it = allPersonLists.begin(); it != allPersonLists.end(); ++it)
-    {
-        iteratorLists.push_back(((*it)).begin());
-    }
-
-    //pick the Top C
-    for (size_t c = 0; c < capacity; c++)
-    {
-        double minVal = MAX_DOUBLE;
-        Person_MT* currPerson = nullptr;
-        std::vector<std::pair<int, Person_MT*> > equiTimeList;
-        for (size_t i = 0; i < dequeSize; i++)
-        {
-            if (iteratorLists[i] != (allPersonLists[i]).end())
-            {
-                currPerson = (*(iteratorLists[i]));
-                if (currPerson->drivingTimeToEndOfLink == minVal)
-                {
-                    equiTimeList.push_back(std::make_pair(i, currPerson));
-                }
-                else if (currPerson->drivingTimeToEndOfLink < minVal)
-                {
-                    minVal = (*iteratorLists[i])->drivingTimeToEndOfLink;
-                    equiTimeList.clear();
-                    equiTimeList.push_back(std::make_pair(i, currPerson));
-                }
-            }
-        }
-
-        if (equiTimeList.empty())
-        {
-            return; //no more vehicles
-        }
-        else
-        {
-            //we have to randomly choose from persons in equiDistantList
-            size_t numElements = equiTimeList.size();
-            std::pair<int, Person_MT*> chosenPair;
-            if (numElements == 1)
-            {
-                chosenPair = equiTimeList.front();
-            }
-            else
-            {
-                int chosenIdx = rand() % numElements;
-                chosenPair = equiTimeList[chosenIdx];
-            }
-            iteratorLists.at(chosenPair.first)++;
-            mergedPersonDeque.push_back(chosenPair.second);
-        }
-    }
-
-    //After pick the Top C, there are still some vehicles left in the deque
-    for (size_t i = 0; i < dequeSize; i++)
-    {
-        if (iteratorLists[i] != (allPersonLists[i]).end())
-        {
-            mergedPersonDeque.insert(mergedPersonDeque.end(), iteratorLists[i], (allPersonLists[i]).end());
-        }
-    }
+    linkMerger.merge(&Person_MT::drivingTimeToEndOfLink, sumCapacity, mergedPersons);
 }
 //
 //void Conflux::addSegTT(Agent::RdSegTravelStat & stats, Person_MT* person) {
@@ -2318,6 +2250,7 @@ Conflux* Conflux::findStartingConflux(Person_MT* person, unsigned int now)
     }
 
     //register the person as a message handler if required
+    //  (into the context of this conflux, even when its update was stolen by another Worker's thread)
     if (!person->GetContext())
     {
         messaging::MessageBus::RegisterHandler(person);
@@ -2643,6 +2576,43 @@ void Conflux::addConnectedConflux(Conflux* conflux)
     connectedConfluxes.insert(conflux);
 }
 
+bool Conflux::isMigratable() const
+{
+    return !isLoader;
+}
+
+void Conflux::getAdjacentEntities(std::vector<Entity*>& adjacent) const
+{
+    adjacent.insert(adjacent.end(), connectedConfluxes.begin(), connectedConfluxes.end());
+}
+
+void Conflux::resetWorkerProvider(WorkerProvider* provider)
+{
+    currWorkerProvider = provider;
+
+    const PersonList persons = getAllPersons();
+    for (Person_MT* person : persons)
+    {
+        person->currWorkerProvider = provider;
+    }
+    for (Person_MT* person : mrt)
+    {
+        person->currWorkerProvider = provider;
+    }
+    for (Person_MT* person : stashedPersons)
+    {
+        person->currWorkerProvider = provider;
+    }
+    for (Agent* stationAgent : stationAgents)
+    {
+        stationAgent->currWorkerProvider = provider;
+    }
+    for (Agent* parkingAgent : parkingAgents)
+    {
+        parkingAgent->currWorkerProvider = provider;
+    }
+}
+
 void Conflux::CreateSegmentStats(const RoadSegment* rdSeg, Conflux* conflux, std::list<SegmentStats*>& splitSegmentStats)
 {
     if (!rdSeg)
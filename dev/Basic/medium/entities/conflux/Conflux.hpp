@@ -204,6 +204,18 @@ static std::unordered_map<const Node *,Conflux *> nodeConfluxMap;
      */
     bool evadeVQ_Bounds;
 
+    /** merger of the lanes of each segment stats, reused across ticks */
+    TopCMerger laneMerger;
+
+    /** merger of the links of this conflux, reused across ticks */
+    TopCMerger linkMerger;
+
+    /** merged persons of one segment stats; reused across ticks */
+    std::vector<Person_MT*> segmentPersons;
+
+    /** persons in the order in which they are updated in this tick; reused across ticks */
+    std::vector<Person_MT*> orderedPersons;
+
     /**
      * temporary holder for outputs reported by segmentstats of this conflux at the end of each update interval
      */
@@ -442,6 +454,25 @@ public:
         return connectedConfluxes;
     }
 
+    /**
+     * Confluxes other than the loader confluxes can be moved between workers
+     * @return true if this conflux is not a loader
+     */
+    virtual bool isMigratable() const;
+
+    /**
+     * adjacent entities of a conflux are its connected confluxes
+     * @param adjacent output list to which the connected confluxes are appended
+     */
+    virtual void getAdjacentEntities(std::vector<Entity*>& adjacent) const;
+
+    /**
+     * sets the worker provider of this conflux and of the persons and agents it holds, which take the worker provider
+     * of the conflux when they are updated
+     * @param provider the worker provider managing this conflux
+     */
+    virtual void resetWorkerProvider(WorkerProvider* provider);
+
     /**
      * initializes the conflux
      * @param now timeslice when initialize is called
@@ -610,19 +641,10 @@ public:
     PersonCount countPersons() const;
 
     /**
-     * get an ordered list of all persons in this conflux
-     * @param mergedPersonDeque output list that must contain the merged list of persons
-     */
-    void getAllPersonsUsingTopCMerge(std::deque<Person_MT*>& mergedPersonDeque);
-
-    /**
-     * merges the ordered list of persons on each link of the conflux into 1
-     * @param mergedPersonDeque output list that must contain the merged list of persons
-     * @param allPersonLists list of list of persons to merge
-     * @param capacity capacity till which the relative ordering of persons is important
+     * get an ordered list of all persons on the links of this conflux
+     * @param mergedPersons output list to which the merged list of persons is appended
      */
-    void topCMergeDifferentLinksInConflux(std::deque<Person_MT*>& mergedPersonDeque,
-            std::vector< std::deque<Person_MT*> >& allPersonLists, int capacity);
+    void getAllPersonsUsingTopCMerge(std::vector<Person_MT*>& mergedPersons);
 
     /**
      * get number of persons in lane infinities of this conflux
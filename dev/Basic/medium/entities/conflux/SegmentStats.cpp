@@ -282,110 +282,40 @@ void SegmentStats::getInfinityPersons(std::deque<Person_MT*>& segAgents)
 	segAgents.insert(segAgents.end(), lnAgents.begin(), lnAgents.end());
 }
 
-void SegmentStats::topCMergeLanesInSegment(PersonList& mergedPersonList)
+void SegmentStats::topCMergeLanesInSegment(TopCMerger& laneMerger, std::vector<Person_MT*>& mergedPersonList)
 {
-	mergedPersonList.clear();
 	//Bus drivers go in the front of the list, because bus stops are (virtually) located at the end of the segment
 	for (BusStopList::const_reverse_iterator stopIt = busStops.rbegin(); stopIt != busStops.rend(); stopIt++)
 	{
 		const BusStop* stop = *stopIt;
 		PersonList& driversAtStop = busDrivers.at(stop);
-		for (PersonList::iterator pIt = driversAtStop.begin(); pIt != driversAtStop.end(); pIt++)
-		{
-			mergedPersonList.push_back(*pIt);
-		}
+		mergedPersonList.insert(mergedPersonList.end(), driversAtStop.begin(), driversAtStop.end());
 	}
 
-	int capacity = (int) (ceil(supplyParams.getCapacity()));
-	//init iterator list to the front of each lane
-	std::vector<PersonList::iterator> iteratorLists;
+	//one list per lane, in the order of the lanes
+	laneMerger.reset();
 	for (LaneStatsMap::iterator lnIt = laneStatsMap.begin(); lnIt != laneStatsMap.end(); lnIt++)
 	{
 		if(!lnIt->second->isLaneInfinity())
 		{
-			iteratorLists.push_back(lnIt->second->laneAgents.begin());
+			PersonList& personsInLane = lnIt->second->laneAgents;
+			laneMerger.append(personsInLane.begin(), personsInLane.end());
+			laneMerger.endList();
 		}
 	}
 
-	//pick the Top C
-	for (int c = 0; c < capacity; c++)
+	//pick the Top C, then append the remaining vehicles in the output list
+	int capacity = (int) (ceil(supplyParams.getCapacity()));
+	double Person_MT::*orderingKey = &Person_MT::drivingTimeToEndOfLink;
+	if (orderBySetting == SEGMENT_ORDERING_BY_DISTANCE_TO_INTERSECTION)
 	{
-		double minVal = std::numeric_limits<double>::max();
-		Person_MT* currPerson = nullptr;
-		std::vector<std::pair<int, Person_MT*> > equiDistantList;
-		int i = 0;
-		for (LaneStatsMap::iterator lnIt = laneStatsMap.begin(); lnIt != laneStatsMap.end(); lnIt++)
-		{
-			if(!lnIt->second->isLaneInfinity())
-			{
-				PersonList& personsInLane = lnIt->second->laneAgents;
-				if (iteratorLists[i] != personsInLane.end())
-				{
-					currPerson = (*(iteratorLists[i]));
-					if (orderBySetting == SEGMENT_ORDERING_BY_DISTANCE_TO_INTERSECTION)
-					{
-						if (currPerson->distanceToEndOfSegment == minVal)
-						{
-							equiDistantList.push_back(std::make_pair(i, currPerson));
-						}
-						else if (currPerson->distanceToEndOfSegment < minVal)
-						{
-							minVal = currPerson->distanceToEndOfSegment;
-							equiDistantList.clear();
-							equiDistantList.push_back(std::make_pair(i, currPerson));
-						}
-					}
-					else if (orderBySetting == SEGMENT_ORDERING_BY_DRIVING_TIME_TO_INTERSECTION)
-					{
-						if (currPerson->drivingTimeToEndOfLink == minVal)
-						{
-							equiDistantList.push_back(std::make_pair(i, currPerson));
-						}
-						else if (currPerson->drivingTimeToEndOfLink < minVal)
-						{
-							minVal = currPerson->drivingTimeToEndOfLink;
-							equiDistantList.clear();
-							equiDistantList.push_back(std::make_pair(i, currPerson));
-						}
-					}
-				}
-				i++;
-			}
-		}
-
-		if (!equiDistantList.empty())
-		{
-			//we have to randomly choose from persons in equiDistantList
-			size_t numElements = equiDistantList.size();
-			std::pair<int, Person_MT*> chosenPair;
-			if (numElements == 1)
-			{
-				chosenPair = equiDistantList.front();
-			}
-			else
-			{
-				int chosenIdx = rand() % numElements;
-				chosenPair = equiDistantList[chosenIdx];
-			}
-			iteratorLists.at(chosenPair.first)++;
-			mergedPersonList.push_back(chosenPair.second);
-		}
+		orderingKey = &Person_MT::distanceToEndOfSegment;
 	}
-
-	//After picking the Top C, just append the remaining vehicles in the output list
-	int i = 0;
-	for (LaneStatsMap::iterator lnIt = laneStatsMap.begin(); lnIt != laneStatsMap.end(); lnIt++)
+	else if (orderBySetting != SEGMENT_ORDERING_BY_DRIVING_TIME_TO_INTERSECTION)
 	{
-		if(!lnIt->second->isLaneInfinity())
-		{
-			PersonList& personsInLane = lnIt->second->laneAgents;
-			if (iteratorLists[i] != personsInLane.end())
-			{
-				mergedPersonList.insert(mergedPersonList.end(), iteratorLists[i], personsInLane.end());
-			}
-			i++;
-		}
+		capacity = 0;
 	}
+	laneMerger.merge(orderingKey, capacity, mergedPersonList);
 
 	//insert lane infinity persons at the tail of mergedPersonList
 	LaneStats* lnInfStats =  laneStatsMap[laneInfinity];
@@ -13,6 +13,7 @@
 #include "geospatial/network/Link.hpp"
 #include "geospatial/network/PT_Stop.hpp"
 #include "geospatial/network/TaxiStand.hpp"
+#include "TopCMerger.hpp"
 
 namespace sim_mob
 {
@@ -712,9 +713,10 @@ public:
 	/**
 	 * merges the persons in segment in one list, thus forming the order in which
 	 * those persons need to be updated in this tick
-	 * @param mergedPersonList output list of persons to be populated
+	 * @param laneMerger merger used to merge the lanes (its previous lists are dropped)
+	 * @param mergedPersonList output list to which the persons are appended
 	 */
-	void topCMergeLanesInSegment(PersonList& mergedPersonList);
+	void topCMergeLanesInSegment(TopCMerger& laneMerger, std::vector<Person_MT*>& mergedPersonList);
 
 	/**
 	 * returns the queuing and moiving persons count in lane
@@ -0,0 +1,176 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+namespace sim_mob
+{
+namespace medium
+{
+class Person_MT;
+
+/**
+ * Merges ordered lists of items (the persons in the lanes of a segment, or in the links of a conflux) into the order
+ * in which they must be updated.
+ *
+ * The first "capacity" items are picked one at a time among the heads of the lists, by increasing key (distance or
+ * driving time to the end of the segment or link). The items left in each list are then appended list after list.
+ *
+ * The lists are copied into one flat buffer and the heads are kept in a binary heap, so a merge takes O(n log k)
+ * for n items in k lists. The buffers are kept from one merge to the next; once they have grown to the size of the
+ * largest merge, merging allocates no memory.
+ *
+ * When several heads have the smallest key, each pick draws one of them uniformly, as it did with rand(), but with
+ * the merger's own random number generator: the order is reproducible for a given seed, and independent of the other
+ * threads.
+ */
+template <typename T>
+class BasicTopCMerger
+{
+public:
+    /**
+     * @param seed seed of the random number generator breaking the ties
+     */
+    explicit BasicTopCMerger(uint32_t seed) : tieBreakerGenerator(seed)
+    {
+    }
+
+    /**
+     * starts a new merge, dropping the lists of the previous one
+     */
+    void reset()
+    {
+        items.clear();
+        listEnds.clear();
+    }
+
+    /**
+     * appends items to the list being built
+     * @param first iterator to the first item to append
+     * @param last iterator past the last item to append
+     */
+    template <typename InputIterator>
+    void append(InputIterator first, InputIterator last)
+    {
+        items.insert(items.end(), first, last);
+    }
+
+    /**
+     * closes the list being built; the items appended next go to a new list
+     */
+    void endList()
+    {
+        listEnds.push_back(items.size());
+    }
+
+    /**
+     * merges the lists closed since the last reset()
+     * @param key member of T by which the items of each list are ordered
+     * @param capacity number of items to pick by increasing key
+     * @param merged output list to which the merged items are appended
+     */
+    void merge(double T::*key, int capacity, std::vector<T*>& merged)
+    {
+        //init the heads of the non-empty lists
+        cursors.clear();
+        heads.clear();
+        size_t begin = 0;
+        for (size_t list = 0; list < listEnds.size(); list++)
+        {
+            cursors.push_back(begin);
+            if (begin < listEnds[list])
+            {
+                Head head = { items[begin]->*key, list };
+                heads.push_back(head);
+            }
+            begin = listEnds[list];
+        }
+        std::make_heap(heads.begin(), heads.end(), comesAfter);
+
+        //pick the Top C
+        for (int c = 0; c < capacity && !heads.empty(); c++)
+        {
+            //move the heads tied on the smallest key to the back
+            std::pop_heap(heads.begin(), heads.end(), comesAfter);
+            size_t numTied = 1;
+            while (numTied < heads.size() && heads.front().key == heads.back().key)
+            {
+                std::pop_heap(heads.begin(), heads.end() - numTied, comesAfter);
+                numTied++;
+            }
+
+            //pick one of them uniformly, and put the others back in the heap
+            if (numTied > 1)
+            {
+                boost::random::uniform_int_distribution<size_t> tiedHead(heads.size() - numTied, heads.size() - 1);
+                std::swap(heads[tiedHead(tieBreakerGenerator)], heads.back());
+                for (size_t tied = heads.size() - numTied + 1; tied < heads.size(); tied++)
+                {
+                    std::push_heap(heads.begin(), heads.begin() + tied, comesAfter);
+                }
+            }
+
+            Head& head = heads.back();
+            size_t& cursor = cursors[head.list];
+            merged.push_back(items[cursor]);
+            cursor++;
+
+            if (cursor < listEnds[head.list])
+            {
+                head.key = items[cursor]->*key;
+                std::push_heap(heads.begin(), heads.end(), comesAfter);
+            }
+            else
+            {
+                heads.pop_back();
+            }
+        }
+
+        //after picking the Top C, append the items left in each list
+        for (size_t list = 0; list < listEnds.size(); list++)
+        {
+            merged.insert(merged.end(), items.begin() + cursors[list], items.begin() + listEnds[list]);
+        }
+    }
+
+private:
+    /** next item of a list competing for the next pick */
+    struct Head
+    {
+        double key;
+        size_t list;
+    };
+
+    /** orders the heap so that its front holds the smallest key; tied heads are told apart by list */
+    static bool comesAfter(const Head& first, const Head& second)
+    {
+        return first.key > second.key || (first.key == second.key && first.list > second.list);
+    }
+
+    /** items of all lists, list after list */
+    std::vector<T*> items;
+
+    /** position in items past the end of each list */
+    std::vector<size_t> listEnds;
+
+    /** position in items of the next item of each list, during a merge */
+    std::vector<size_t> cursors;
+
+    /** heads of the lists which are not exhausted, during a merge */
+    std::vector<Head> heads;
+
+    boost::mt19937 tieBreakerGenerator;
+};
+
+/** merger of the persons of a conflux */
+typedef BasicTopCMerger<Person_MT> TopCMerger;
+
+} // namespace medium
+} // namespace sim_mob
@@ -729,6 +729,7 @@ bool performMainDemand()
 	predayManager.loadCosts();
 	predayManager.loadPersonIds();
 	predayManager.loadUnavailableODs();
+	predayManager.loadTimeDependentTravelTimes();
 
 	/// The seed for RNG's in lua is set before any choice is made for any of the preday models
 	ConfigManager& cfg = ConfigManager::GetInstanceRW();
@@ -773,6 +774,7 @@ bool performPredayFullLoop(const std::string& configFileName, std::list<std::str
 	predayManager.loadCosts();
 	predayManager.loadPersonIds();
 	predayManager.loadUnavailableODs();
+	predayManager.loadTimeDependentTravelTimes();
 
 
 	Print() << "LogSum computation: Started\n";
@@ -807,6 +809,7 @@ bool performMidFullLoop(const std::string& configFileName, std::list<std::string
 	predayManager.loadCosts();
 	predayManager.loadPersonIds();
 	predayManager.loadUnavailableODs();
+	predayManager.loadTimeDependentTravelTimes();
 
 
 	Print() << "LogSum computation: Started\n";
@@ -0,0 +1,232 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cmath>
+#include <set>
+#include <vector>
+
+#include "entities/conflux/TopCMerger.hpp"
+
+#include "TopCMergerUnitTests.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::TopCMergerUnitTests);
+
+namespace
+{
+struct Vehicle
+{
+    double timeToEnd;
+};
+
+typedef sim_mob::medium::BasicTopCMerger<Vehicle> Merger;
+
+/**adds the vehicles at the given positions of vehicles as a new list of merger*/
+void addList(Merger& merger, std::vector<Vehicle>& vehicles, size_t first, size_t last)
+{
+    std::vector<Vehicle*> list;
+    for (size_t i = first; i < last; i++)
+    {
+        list.push_back(&vehicles[i]);
+    }
+    merger.append(list.begin(), list.end());
+    merger.endList();
+}
+
+/**@return the positions in vehicles of the merged vehicles*/
+std::vector<size_t> positions(const std::vector<Vehicle>& vehicles, const std::vector<Vehicle*>& merged)
+{
+    std::vector<size_t> res;
+    for (std::vector<Vehicle*>::const_iterator it = merged.begin(); it != merged.end(); it++)
+    {
+        res.push_back(*it - &vehicles.front());
+    }
+    return res;
+}
+
+std::vector<size_t> sequence(const size_t* values, size_t count)
+{
+    return std::vector<size_t>(values, values + count);
+}
+}
+
+void unit_tests::TopCMergerUnitTests::test_TopCSelection()
+{
+    //three lists, each ordered by time to the end
+    const double times[] = { 1.0, 4.0, 9.0,   2.0, 3.0, 10.0, 11.0,   0.5, 8.0 };
+    std::vector<Vehicle> vehicles;
+    for (size_t i = 0; i < sizeof(times) / sizeof(times[0]); i++)
+    {
+        Vehicle vehicle = { times[i] };
+        vehicles.push_back(vehicle);
+    }
+
+    Merger merger(1);
+    addList(merger, vehicles, 0, 3);
+    addList(merger, vehicles, 3, 7);
+    addList(merger, vehicles, 7, 9);
+
+    //the first 5 by time (0.5, 1, 2, 3, 4), then the rest of each list in list order
+    std::vector<Vehicle*> merged;
+    merger.merge(&Vehicle::timeToEnd, 5, merged);
+    const size_t expected[] = { 7, 0, 3, 4, 1,   2,   5, 6,   8 };
+    CPPUNIT_ASSERT(sequence(expected, 9) == positions(vehicles, merged));
+}
+
+void unit_tests::TopCMergerUnitTests::test_CapacityAndEmptyLists()
+{
+    const double times[] = { 3.0, 5.0,   1.0, 4.0 };
+    std::vector<Vehicle> vehicles;
+    for (size_t i = 0; i < 4; i++)
+    {
+        Vehicle vehicle = { times[i] };
+        vehicles.push_back(vehicle);
+    }
+
+    Merger merger(1);
+    addList(merger, vehicles, 0, 0);
+    addList(merger, vehicles, 0, 2);
+    addList(merger, vehicles, 2, 2);
+    addList(merger, vehicles, 2, 4);
+
+    //no pick: the lists are appended as they are
+    std::vector<Vehicle*> merged;
+    merger.merge(&Vehicle::timeToEnd, 0, merged);
+    const size_t unmerged[] = { 0, 1, 2, 3 };
+    CPPUNIT_ASSERT(sequence(unmerged, 4) == positions(vehicles, merged));
+
+    //more capacity than vehicles: all of them by time; the output is appended to
+    merger.merge(&Vehicle::timeToEnd, 10, merged);
+    const size_t sorted[] = { 0, 1, 2, 3,   2, 0, 3, 1 };
+    CPPUNIT_ASSERT(sequence(sorted, 8) == positions(vehicles, merged));
+
+    //no list at all
+    merger.reset();
+    merged.clear();
+    merger.merge(&Vehicle::timeToEnd, 3, merged);
+    CPPUNIT_ASSERT(merged.empty());
+}
+
+void unit_tests::TopCMergerUnitTests::test_TiesAreSeeded()
+{
+    //four lists whose heads all have the same time; the second vehicles too
+    const size_t numLists = 4;
+    std::vector<Vehicle> vehicles;
+    for (size_t i = 0; i < numLists; i++)
+    {
+        Vehicle head = { 2.0 };
+        Vehicle second = { 6.0 };
+        vehicles.push_back(head);
+        vehicles.push_back(second);
+    }
+
+    std::set<size_t> firstPicks;
+    for (uint32_t seed = 0; seed < 64; seed++)
+    {
+        std::vector<Vehicle*> merged;
+        std::vector<Vehicle*> mergedAgain;
+        Merger merger(seed);
+        Merger sameSeed(seed);
+        for (size_t i = 0; i < numLists; i++)
+        {
+            addList(merger, vehicles, 2 * i, 2 * i + 2);
+            addList(sameSeed, vehicles, 2 * i, 2 * i + 2);
+        }
+        merger.merge(&Vehicle::timeToEnd, 2 * numLists, merged);
+        sameSeed.merge(&Vehicle::timeToEnd, 2 * numLists, mergedAgain);
+        CPPUNIT_ASSERT(merged == mergedAgain);
+
+        //the tied heads come first, in some order, then the tied second vehicles
+        std::vector<size_t> picks = positions(vehicles, merged);
+        CPPUNIT_ASSERT(2 * numLists == picks.size());
+        std::set<size_t> heads;
+        std::set<size_t> seconds;
+        for (size_t i = 0; i < numLists; i++)
+        {
+            heads.insert(picks[i]);
+            seconds.insert(picks[numLists + i]);
+        }
+        for (size_t i = 0; i < numLists; i++)
+        {
+            CPPUNIT_ASSERT(heads.count(2 * i) == 1);
+            CPPUNIT_ASSERT(seconds.count(2 * i + 1) == 1);
+        }
+        firstPicks.insert(picks.front());
+    }
+
+    //every tied head wins for some seed
+    CPPUNIT_ASSERT(numLists == firstPicks.size());
+}
+
+void unit_tests::TopCMergerUnitTests::test_RepeatedTiesAreUniform()
+{
+    //three lists of vehicles which all have the same time, so that every pick is a tie between all the heads
+    const size_t numLists = 3;
+    const size_t listSize = 4;
+    std::vector<Vehicle> vehicles(numLists * listSize);
+    for (size_t i = 0; i < vehicles.size(); i++)
+    {
+        vehicles[i].timeToEnd = 5.0;
+    }
+
+    //the generator carries on from one merge to the next
+    const size_t numMerges = 6000;
+    Merger merger(3);
+    std::vector<size_t> firstPicks(numLists, 0);
+    std::vector<size_t> secondPicks(numLists, 0);
+    size_t samePicks = 0;
+    for (size_t m = 0; m < numMerges; m++)
+    {
+        merger.reset();
+        for (size_t i = 0; i < numLists; i++)
+        {
+            addList(merger, vehicles, i * listSize, (i + 1) * listSize);
+        }
+        std::vector<Vehicle*> merged;
+        merger.merge(&Vehicle::timeToEnd, 2, merged);
+        const std::vector<size_t> picks = positions(vehicles, merged);
+        const size_t firstList = picks[0] / listSize;
+        const size_t secondList = picks[1] / listSize;
+        firstPicks[firstList]++;
+        secondPicks[secondList]++;
+        if (firstList == secondList)
+        {
+            samePicks++;
+        }
+    }
+
+    //each list wins each pick a third of the times; in particular, the lists which lost the first pick are not more
+    //likely to lose the second one (the new head of the first winner would then win half of the times)
+    const double expected = numMerges / double(numLists);
+    const double tolerance = 4.0 * std::sqrt(numMerges * (1.0 / numLists) * (1.0 - 1.0 / numLists));
+    for (size_t i = 0; i < numLists; i++)
+    {
+        CPPUNIT_ASSERT(std::abs(firstPicks[i] - expected) < tolerance);
+        CPPUNIT_ASSERT(std::abs(secondPicks[i] - expected) < tolerance);
+    }
+    CPPUNIT_ASSERT(std::abs(samePicks - expected) < tolerance);
+}
+
+void unit_tests::TopCMergerUnitTests::test_ReuseAcrossMerges()
+{
+    std::vector<Vehicle> vehicles;
+    for (size_t i = 0; i < 6; i++)
+    {
+        Vehicle vehicle = { double(6 - i) };
+        vehicles.push_back(vehicle);
+    }
+
+    Merger merger(7);
+    addList(merger, vehicles, 0, 6);
+    std::vector<Vehicle*> merged;
+    merger.merge(&Vehicle::timeToEnd, 6, merged);
+
+    //the second merge only sees the lists added since the reset
+    merger.reset();
+    addList(merger, vehicles, 4, 5);
+    addList(merger, vehicles, 1, 2);
+    merged.clear();
+    merger.merge(&Vehicle::timeToEnd, 2, merged);
+    const size_t expected[] = { 4, 1 };
+    CPPUNIT_ASSERT(sequence(expected, 2) == positions(vehicles, merged));
+}
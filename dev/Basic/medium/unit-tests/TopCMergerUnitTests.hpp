@@ -0,0 +1,44 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the TopCMerger in entities/conflux/TopCMerger.hpp
+ */
+class TopCMergerUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that the first C items are picked by increasing key and the others appended list after list
+    void test_TopCSelection();
+
+    ///Test that a capacity of zero, a capacity above the item count and empty lists are handled
+    void test_CapacityAndEmptyLists();
+
+    ///Test that tied heads are picked in an order which depends on the seed only
+    void test_TiesAreSeeded();
+
+    ///Test that each pick among tied heads is uniform, including for the heads which lost the previous picks
+    void test_RepeatedTiesAreUniform();
+
+    ///Test that the buffers of a merger are reset between merges
+    void test_ReuseAcrossMerges();
+
+private:
+    CPPUNIT_TEST_SUITE(TopCMergerUnitTests);
+        CPPUNIT_TEST(test_TopCSelection);
+        CPPUNIT_TEST(test_CapacityAndEmptyLists);
+        CPPUNIT_TEST(test_TiesAreSeeded);
+        CPPUNIT_TEST(test_RepeatedTiesAreUniform);
+        CPPUNIT_TEST(test_ReuseAcrossMerges);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,132 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "LogitKernels.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace sim_mob;
+
+namespace
+{
+/**
+ * computes the exponentiated utilities of each nest and the sum of (nest sum)^(1/scale) over all nests
+ *
+ * @param nestSums output param for the sum of the exponentiated utilities of each nest
+ *
+ * @return sum over all nests of (nest sum)^(1/scale)
+ */
+double computeNestSums(double* utility, double* availability, const std::size_t* nestSizes, const double* scales,
+        std::size_t numNests, double* expUtility, std::vector<double>& nestSums)
+{
+    nestSums.resize(numNests);
+    std::size_t first = 0;
+    for (std::size_t nest = 0; nest < numNests; ++nest)
+    {
+        logit::maskInvalidUtilities(utility + first, availability + first, nestSizes[nest]);
+        nestSums[nest] = logit::computeExpUtilities(utility + first, availability + first, scales[nest], nestSizes[nest],
+                expUtility + first);
+        first += nestSizes[nest];
+    }
+
+    double sumNestSumPowScaleInv = 0;
+    for (std::size_t nest = 0; nest < numNests; ++nest)
+    {
+        sumNestSumPowScaleInv += std::pow(nestSums[nest], 1 / scales[nest]);
+    }
+    return sumNestSumPowScaleInv;
+}
+}
+
+void logit::maskInvalidUtilities(double* utility, double* availability, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const bool invalid = (utility[i] != utility[i]);
+        utility[i] = invalid ? 0 : utility[i];
+        availability[i] = invalid ? 0 : availability[i];
+    }
+}
+
+double logit::computeExpUtilities(const double* utility, const double* availability, double scale, std::size_t count,
+        double* expUtility)
+{
+    //the exponentials are computed first and summed in a separate pass, in the order of the alternatives,
+    //to keep the sum identical to the one of logit.lua
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        expUtility[i] = availability[i] * std::exp(scale * utility[i]);
+    }
+    double sum = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sum += expUtility[i];
+    }
+    return sum;
+}
+
+void logit::computeMnlProbabilities(double* utility, double* availability, std::size_t count, double* probability)
+{
+    maskInvalidUtilities(utility, availability, count);
+    const double sum = computeExpUtilities(utility, availability, 1, count, probability);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        probability[i] = (probability[i] != 0) ? probability[i] / sum : probability[i];
+    }
+}
+
+double logit::computeMnlLogsum(const double* utility, const double* availability, std::size_t count)
+{
+    double sum = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const bool invalid = (utility[i] != utility[i]);
+        sum += (invalid ? 0 : availability[i]) * std::exp(invalid ? 0 : utility[i]);
+    }
+    return std::log(sum);
+}
+
+void logit::computeNlProbabilities(double* utility, double* availability, const std::size_t* nestSizes, const double* scales,
+        std::size_t numNests, double* probability)
+{
+    std::vector<double> nestSums;
+    const double sumNestSumPowScaleInv = computeNestSums(utility, availability, nestSizes, scales, numNests, probability, nestSums);
+
+    std::size_t first = 0;
+    for (std::size_t nest = 0; nest < numNests; ++nest)
+    {
+        double* nestProbability = probability + first;
+        const std::size_t count = nestSizes[nest];
+        if (nestSums[nest] != 0)
+        {
+            const double nestFactor = std::pow(nestSums[nest], 1 / scales[nest] - 1);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                nestProbability[i] = nestProbability[i] * nestFactor / sumNestSumPowScaleInv;
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                nestProbability[i] = 0;
+            }
+        }
+        first += count;
+    }
+}
+
+double logit::computeNlLogsum(double* utility, double* availability, const std::size_t* nestSizes, const double* scales,
+        std::size_t numNests)
+{
+    std::size_t count = 0;
+    for (std::size_t nest = 0; nest < numNests; ++nest)
+    {
+        count += nestSizes[nest];
+    }
+    std::vector<double> expUtility(count);
+    std::vector<double> nestSums;
+    return std::log(computeNestSums(utility, availability, nestSizes, scales, numNests, expUtility.data(), nestSums));
+}
@@ -0,0 +1,101 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+
+namespace sim_mob
+{
+
+/**
+ * Batched probability and logsum computations for multinomial (MNL) and nested (NL) logit models.
+ *
+ * These are the computations of logit.lua, done over contiguous arrays of utilities and availabilities
+ * instead of lua tables. Only the probabilities and logsums are computed here: the utilities are given
+ * by the callers, which take them from the model scripts.
+ * The masking and scaling loops are branch-free and can be vectorised by the compiler. The exponentials
+ * are scalar libm calls and the sums are added in the order of the alternatives, as in logit.lua, so
+ * that the results do not depend on the build.
+ * For nested logit models, the alternatives are laid out nest by nest: the first nestSizes[0] entries
+ * are the alternatives of the first nest, the next nestSizes[1] those of the second nest, and so on.
+ *
+ * As in logit.lua, an alternative whose utility is not a number is made unavailable: its utility and
+ * its availability are both set to 0 in the given arrays.
+ */
+namespace logit
+{
+
+/**
+ * Sets the utility and the availability of alternatives whose utility is NaN to 0
+ *
+ * @param utility utilities of the alternatives
+ * @param availability availabilities (0 or 1) of the alternatives
+ * @param count number of alternatives
+ */
+void maskInvalidUtilities(double* utility, double* availability, std::size_t count);
+
+/**
+ * computes availability * exp(scale * utility) for each alternative
+ *
+ * @param utility utilities of the alternatives
+ * @param availability availabilities of the alternatives
+ * @param scale scale applied to all the utilities
+ * @param count number of alternatives
+ * @param expUtility output array of count values
+ *
+ * @return sum of the values written to expUtility
+ */
+double computeExpUtilities(const double* utility, const double* availability, double scale, std::size_t count, double* expUtility);
+
+/**
+ * computes the choice probabilities of a multinomial logit model
+ *
+ * @param utility utilities of the alternatives (NaN utilities are masked)
+ * @param availability availabilities of the alternatives (masked with utility)
+ * @param count number of alternatives
+ * @param probability output array of count probabilities
+ */
+void computeMnlProbabilities(double* utility, double* availability, std::size_t count, double* probability);
+
+/**
+ * computes the logsum of a multinomial logit model.
+ * Unlike the probability computation, utility and availability are not modified.
+ *
+ * @param utility utilities of the alternatives
+ * @param availability availabilities of the alternatives
+ * @param count number of alternatives
+ *
+ * @return log of the sum of the exponentiated utilities of the available alternatives
+ */
+double computeMnlLogsum(const double* utility, const double* availability, std::size_t count);
+
+/**
+ * computes the choice probabilities of a nested logit model
+ *
+ * @param utility utilities of the alternatives, nest by nest (NaN utilities are masked)
+ * @param availability availabilities of the alternatives (masked with utility)
+ * @param nestSizes number of alternatives in each nest
+ * @param scales scale of each nest
+ * @param numNests number of nests
+ * @param probability output array with one probability per alternative
+ */
+void computeNlProbabilities(double* utility, double* availability, const std::size_t* nestSizes, const double* scales,
+        std::size_t numNests, double* probability);
+
+/**
+ * computes the logsum of a nested logit model
+ *
+ * @param utility utilities of the alternatives, nest by nest (NaN utilities are masked)
+ * @param availability availabilities of the alternatives (masked with utility)
+ * @param nestSizes number of alternatives in each nest
+ * @param scales scale of each nest
+ * @param numNests number of nests
+ *
+ * @return logsum of the model
+ */
+double computeNlLogsum(double* utility, double* availability, const std::size_t* nestSizes, const double* scales, std::size_t numNests);
+
+} // namespace logit
+} // namespace sim_mob
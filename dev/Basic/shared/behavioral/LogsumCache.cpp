@@ -0,0 +1,320 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "LogsumCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <boost/functional/hash.hpp>
+#include "logging/Log.hpp"
+
+using namespace sim_mob;
+
+namespace
+{
+const char LOGSUM_CACHE_MAGIC[8] = { 'S', 'M', 'L', 'G', 'S', 'M', '\0', '\0' };
+const uint32_t LOGSUM_CACHE_VERSION = 2;
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/** size of an entry without attributes, scripts name and activity logsums */
+const uint64_t MIN_ENTRY_SIZE = 3 * sizeof(uint32_t) + 5 * sizeof(double);
+
+int64_t doubleBits(double value)
+{
+    int64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+template<typename T>
+void writeValue(std::ostream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readValue(std::istream& in, T& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/**
+ * @return true if count items of the given size fit in the rest of the file
+ */
+bool fitsInFile(std::istream& in, std::streamoff fileSize, uint64_t count, uint64_t size)
+{
+    const std::streamoff position = in.tellg();
+    if (position < 0 || position > fileSize)
+    {
+        return false;
+    }
+    return count <= static_cast<uint64_t>(fileSize - position) / size;
+}
+
+/**
+ * Collects the entries of the cache
+ */
+struct EntryCollector
+{
+    typedef std::vector<std::pair<LogsumSignature, boost::shared_ptr<const LogsumResult> > > Entries;
+
+    explicit EntryCollector(Entries& entries) : entries(entries)
+    {
+    }
+
+    void operator()(const LogsumSignature& signature, const boost::shared_ptr<const LogsumResult>& result)
+    {
+        entries.push_back(std::make_pair(signature, result));
+    }
+
+    Entries& entries;
+};
+}
+
+LogsumSignature::LogsumSignature()
+{
+}
+
+LogsumSignature::LogsumSignature(const PersonParams& personParams, const std::string& scripts) : scripts(scripts)
+{
+    const int64_t personAttributes[] = {
+        personParams.getPersonTypeId(), personParams.getAgeId(), personParams.getIsUniversityStudent(), personParams.getStudentTypeId(),
+        personParams.getIsFemale(), personParams.getIncomeId(), personParams.getMissingIncome(), personParams.getWorksAtHome(),
+        personParams.getVehicleOwnershipCategory(), static_cast<int64_t>(personParams.getConstVehicleParams().getDrivetrain()),
+        personParams.hasDrivingLicence(), personParams.getCarLicense(), personParams.getMotorLicense(),
+        personParams.getHasFixedWorkTiming(), personParams.hasWorkplace(), personParams.isStudent(),
+        personParams.getHomeLocation(), personParams.getFixedWorkLocation(), personParams.getFixedSchoolLocation(),
+        personParams.getHH_OnlyAdults(), personParams.getHH_OnlyWorkers(), personParams.getHH_NumUnder4(), personParams.getHH_HasUnder15()
+    };
+    attributes.assign(personAttributes, personAttributes + sizeof(personAttributes) / sizeof(personAttributes[0]));
+
+    //activity logsums which are not recomputed are read by the day pattern models
+    const std::unordered_map<StopType, double> activityLogsums = personParams.getActivityLogsums();
+    std::vector<std::pair<StopType, double> > sortedLogsums(activityLogsums.begin(), activityLogsums.end());
+    std::sort(sortedLogsums.begin(), sortedLogsums.end());
+    for (std::vector<std::pair<StopType, double> >::const_iterator it = sortedLogsums.begin(); it != sortedLogsums.end(); ++it)
+    {
+        attributes.push_back(it->first);
+        attributes.push_back(doubleBits(it->second));
+    }
+}
+
+bool LogsumSignature::operator==(const LogsumSignature& other) const
+{
+    return attributes == other.attributes && scripts == other.scripts;
+}
+
+std::size_t sim_mob::hash_value(const LogsumSignature& signature)
+{
+    std::size_t seed = boost::hash_range(signature.attributes.begin(), signature.attributes.end());
+    boost::hash_combine(seed, signature.scripts);
+    return seed;
+}
+
+LogsumInputsFingerprint::LogsumInputsFingerprint() : ordered(FNV_OFFSET_BASIS), unordered(0)
+{
+}
+
+void LogsumInputsFingerprint::addBytes(const void* data, std::size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        ordered = (ordered ^ bytes[i]) * FNV_PRIME;
+    }
+}
+
+void LogsumInputsFingerprint::addString(const std::string& value)
+{
+    addValue(static_cast<uint64_t>(value.size()));
+    addBytes(value.data(), value.size());
+}
+
+void LogsumInputsFingerprint::addFile(const std::string& fileName)
+{
+    addString(fileName);
+    std::ifstream inFile(fileName.c_str(), std::ios::binary);
+    char buffer[4096];
+    while (inFile.read(buffer, sizeof(buffer)) || inFile.gcount() > 0)
+    {
+        addBytes(buffer, inFile.gcount());
+    }
+}
+
+void LogsumInputsFingerprint::addUnordered(const LogsumInputsFingerprint& entry)
+{
+    //a sum does not depend on the order in which the entries are added
+    unordered += entry.getValue();
+}
+
+uint64_t LogsumInputsFingerprint::getValue() const
+{
+    return (ordered ^ unordered) * FNV_PRIME;
+}
+
+LogsumResult::LogsumResult() : dptLogsum(0), dpsLogsum(0), dpbLogsum(0), travelProbability(0), tripsExpected(0)
+{
+}
+
+LogsumResult::LogsumResult(const PersonParams& personParams) :
+        dptLogsum(personParams.getDptLogsum()), dpsLogsum(personParams.getDpsLogsum()), dpbLogsum(personParams.getDpbLogsum()),
+        travelProbability(personParams.getTravelProbability()), tripsExpected(personParams.getTripsExpected())
+{
+    const std::unordered_map<StopType, double> logsums = personParams.getActivityLogsums();
+    activityLogsums.assign(logsums.begin(), logsums.end());
+}
+
+void LogsumResult::applyTo(PersonParams& personParams) const
+{
+    for (std::vector<std::pair<StopType, double> >::const_iterator it = activityLogsums.begin(); it != activityLogsums.end(); ++it)
+    {
+        personParams.setActivityLogsum(it->first, it->second);
+    }
+    personParams.setDptLogsum(dptLogsum);
+    personParams.setDpsLogsum(dpsLogsum);
+    personParams.setDpbLogsum(dpbLogsum);
+    personParams.setTravelProbability(travelProbability);
+    personParams.setTripsExpected(tripsExpected);
+}
+
+LogsumCache::LogsumCache(std::size_t capacity, uint64_t inputsFingerprint) : cache(capacity), inputsFingerprint(inputsFingerprint)
+{
+}
+
+bool LogsumCache::find(const LogsumSignature& signature, PersonParams& personParams)
+{
+    boost::shared_ptr<const LogsumResult> result;
+    if (!cache.find(signature, result))
+    {
+        return false;
+    }
+    result->applyTo(personParams);
+    return true;
+}
+
+void LogsumCache::insert(const LogsumSignature& signature, const PersonParams& personParams)
+{
+    cache.insert(signature, boost::shared_ptr<const LogsumResult>(new LogsumResult(personParams)));
+}
+
+CacheStatistics LogsumCache::getStatistics()
+{
+    return cache.getStatistics();
+}
+
+std::size_t LogsumCache::loadFromFile(const std::string& fileName)
+{
+    std::ifstream inFile(fileName.c_str(), std::ios::binary);
+    if (!inFile.good())
+    {
+        return 0;
+    }
+
+    inFile.seekg(0, std::ios::end);
+    const std::streamoff fileSize = inFile.tellg();
+    inFile.seekg(0, std::ios::beg);
+
+    char magic[sizeof(LOGSUM_CACHE_MAGIC)];
+    uint32_t version = 0;
+    uint64_t fileFingerprint = 0;
+    uint64_t numEntries = 0;
+    if (!inFile.read(magic, sizeof(magic)) || std::memcmp(magic, LOGSUM_CACHE_MAGIC, sizeof(magic)) != 0)
+    {
+        throw std::runtime_error(fileName + " is not a logsum cache file");
+    }
+    if (!readValue(inFile, version) || version != LOGSUM_CACHE_VERSION || !readValue(inFile, fileFingerprint)
+            || !readValue(inFile, numEntries))
+    {
+        throw std::runtime_error(fileName + " is not a logsum cache file of the current version");
+    }
+    if (fileFingerprint != inputsFingerprint)
+    {
+        Print() << "LogsumCache: " << fileName << " was saved for other model scripts, zones or costs; it is ignored" << std::endl;
+        return 0;
+    }
+    if (!fitsInFile(inFile, fileSize, numEntries, MIN_ENTRY_SIZE))
+    {
+        throw std::runtime_error(fileName + " is truncated or corrupt");
+    }
+
+    for (uint64_t entry = 0; entry < numEntries; ++entry)
+    {
+        LogsumSignature signature;
+        boost::shared_ptr<LogsumResult> result(new LogsumResult());
+
+        uint32_t numAttributes = 0, scriptsLength = 0, numActivityLogsums = 0;
+        //counts are checked against the rest of the file before anything is allocated for them
+        bool valid = readValue(inFile, numAttributes) && fitsInFile(inFile, fileSize, numAttributes, sizeof(int64_t));
+        signature.attributes.resize(valid ? numAttributes : 0);
+        for (uint32_t i = 0; valid && i < numAttributes; ++i)
+        {
+            valid = readValue(inFile, signature.attributes[i]);
+        }
+        valid = valid && readValue(inFile, scriptsLength) && fitsInFile(inFile, fileSize, scriptsLength, 1);
+        signature.scripts.resize(valid ? scriptsLength : 0);
+        valid = valid && (scriptsLength == 0 || inFile.read(&signature.scripts[0], scriptsLength));
+
+        valid = valid && readValue(inFile, numActivityLogsums)
+                && fitsInFile(inFile, fileSize, numActivityLogsums, sizeof(StopType) + sizeof(double));
+        result->activityLogsums.resize(valid ? numActivityLogsums : 0);
+        for (uint32_t i = 0; valid && i < numActivityLogsums; ++i)
+        {
+            valid = readValue(inFile, result->activityLogsums[i].first) && readValue(inFile, result->activityLogsums[i].second);
+        }
+        valid = valid && readValue(inFile, result->dptLogsum) && readValue(inFile, result->dpsLogsum) && readValue(inFile, result->dpbLogsum)
+                && readValue(inFile, result->travelProbability) && readValue(inFile, result->tripsExpected);
+        if (!valid)
+        {
+            throw std::runtime_error(fileName + " is truncated or corrupt");
+        }
+        cache.insert(signature, result);
+    }
+    return numEntries;
+}
+
+std::size_t LogsumCache::saveToFile(const std::string& fileName)
+{
+    EntryCollector::Entries entries;
+    cache.forEach(EntryCollector(entries));
+
+    std::ofstream outFile(fileName.c_str(), std::ios::binary | std::ios::trunc | std::ios::out);
+    outFile.write(LOGSUM_CACHE_MAGIC, sizeof(LOGSUM_CACHE_MAGIC));
+    writeValue(outFile, LOGSUM_CACHE_VERSION);
+    writeValue(outFile, inputsFingerprint);
+    writeValue(outFile, static_cast<uint64_t>(entries.size()));
+    for (EntryCollector::Entries::const_iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        const LogsumSignature& signature = it->first;
+        const LogsumResult& result = *it->second;
+
+        writeValue(outFile, static_cast<uint32_t>(signature.attributes.size()));
+        outFile.write(reinterpret_cast<const char*>(signature.attributes.data()), signature.attributes.size() * sizeof(int64_t));
+        writeValue(outFile, static_cast<uint32_t>(signature.scripts.size()));
+        outFile.write(signature.scripts.data(), signature.scripts.size());
+
+        writeValue(outFile, static_cast<uint32_t>(result.activityLogsums.size()));
+        for (std::vector<std::pair<StopType, double> >::const_iterator logsumIt = result.activityLogsums.begin();
+                logsumIt != result.activityLogsums.end(); ++logsumIt)
+        {
+            writeValue(outFile, logsumIt->first);
+            writeValue(outFile, logsumIt->second);
+        }
+        writeValue(outFile, result.dptLogsum);
+        writeValue(outFile, result.dpsLogsum);
+        writeValue(outFile, result.dpbLogsum);
+        writeValue(outFile, result.travelProbability);
+        writeValue(outFile, result.tripsExpected);
+    }
+
+    outFile.close();
+    if (!outFile)
+    {
+        throw std::runtime_error("LogsumCache: could not write " + fileName);
+    }
+    return entries.size();
+}
@@ -0,0 +1,173 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "params/PersonParams.hpp"
+#include "util/Cache.hpp"
+
+namespace sim_mob
+{
+
+/**
+ * Canonical form of the inputs of the preday logsum models for a person.
+ *
+ * Holds, in a fixed order, the person attributes read by the logsum models (from the lua scripts and from the
+ * construction of their zone and cost parameters), the activity logsums the person already has, and the name of
+ * the model scripts. Person ids, household ids and addresses are left out, so that all persons with the same
+ * attributes and home, work and school zones get the same signature.
+ */
+class LogsumSignature
+{
+public:
+    LogsumSignature();
+
+    /**
+     * @param personParams person whose logsums are computed
+     * @param scripts name of the set of model scripts computing the logsums
+     */
+    LogsumSignature(const PersonParams& personParams, const std::string& scripts);
+
+    bool operator==(const LogsumSignature& other) const;
+
+    friend std::size_t hash_value(const LogsumSignature& signature);
+
+private:
+    friend class LogsumCache;
+
+    std::vector<int64_t> attributes;
+    std::string scripts;
+};
+
+std::size_t hash_value(const LogsumSignature& signature);
+
+/**
+ * 64 bit FNV-1a hash of the inputs shared by all the logsums of a run: the contents of the model scripts, which
+ * hold the coefficients, and the zone and cost data.
+ *
+ * Values can be added in order, or as the hash of an entry of an unordered container, whose iteration order
+ * may differ from one run to the next.
+ */
+class LogsumInputsFingerprint
+{
+public:
+    LogsumInputsFingerprint();
+
+    void addBytes(const void* data, std::size_t size);
+
+    template<typename T>
+    void addValue(const T& value)
+    {
+        addBytes(&value, sizeof(T));
+    }
+
+    void addString(const std::string& value);
+
+    /**
+     * adds the name and the contents of a file; only the name if the file cannot be read
+     */
+    void addFile(const std::string& fileName);
+
+    /**
+     * adds the fingerprint of one entry of an unordered container
+     */
+    void addUnordered(const LogsumInputsFingerprint& entry);
+
+    uint64_t getValue() const;
+
+private:
+    uint64_t ordered;
+    uint64_t unordered;
+};
+
+/**
+ * Logsums computed for a person by the preday logsum models
+ */
+struct LogsumResult
+{
+    LogsumResult();
+
+    /**
+     * copies the logsums of personParams
+     */
+    explicit LogsumResult(const PersonParams& personParams);
+
+    /**
+     * sets the logsums of personParams
+     */
+    void applyTo(PersonParams& personParams) const;
+
+    std::vector<std::pair<StopType, double> > activityLogsums;
+    double dptLogsum;
+    double dpsLogsum;
+    double dpbLogsum;
+    double travelProbability;
+    double tripsExpected;
+};
+
+/**
+ * Thread safe cache of the logsums computed for persons, keyed on their LogsumSignature.
+ *
+ * Persons with the same signature get the same logsums, so the logsums of a person need only be computed
+ * once per signature. Entries can be saved to a binary file and loaded back in later runs; the file records the
+ * inputs fingerprint, so that it is only loaded back if the model scripts and the zone and cost data are the same.
+ */
+class LogsumCache : private boost::noncopyable
+{
+public:
+    /**
+     * @param capacity maximum number of entries kept
+     * @param inputsFingerprint fingerprint of the scripts and data the logsums are computed from
+     */
+    LogsumCache(std::size_t capacity, uint64_t inputsFingerprint);
+
+    /**
+     * sets the logsums of personParams if logsums were cached for signature
+     *
+     * @return true if the logsums were found
+     */
+    bool find(const LogsumSignature& signature, PersonParams& personParams);
+
+    /**
+     * caches the logsums of personParams for signature
+     */
+    void insert(const LogsumSignature& signature, const PersonParams& personParams);
+
+    /**
+     * @return hit, miss and size counters of the cache
+     */
+    CacheStatistics getStatistics();
+
+    /**
+     * adds the entries saved by saveToFile() to the cache.
+     * The file is ignored if it was saved by a cache with another inputs fingerprint.
+     *
+     * @param fileName path of the binary file
+     * @return number of entries read; 0 if the file does not exist or was saved for other inputs
+     * @throws std::runtime_error if the file exists but is not a valid logsum cache file
+     */
+    std::size_t loadFromFile(const std::string& fileName);
+
+    /**
+     * saves all the entries of the cache
+     *
+     * @param fileName path of the binary file, which is overwritten
+     * @return number of entries saved
+     * @throws std::runtime_error if the file cannot be written
+     */
+    std::size_t saveToFile(const std::string& fileName);
+
+private:
+    LRU_Cache<LogsumSignature, boost::shared_ptr<const LogsumResult> > cache;
+
+    uint64_t inputsFingerprint;
+};
+
+}
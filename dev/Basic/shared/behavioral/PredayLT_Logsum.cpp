@@ -6,6 +6,7 @@
 
 #include <boost/thread/thread.hpp>
 #include <boost/thread/tss.hpp>
+#include <algorithm>
 #include <vector>
 
 #include "behavioral/lua/PredayLogsumLuaProvider.hpp"
@@ -200,6 +201,39 @@ void sim_mob::PredayLT_LogsumManager::loadCosts()
 	}
 }
 
+uint64_t sim_mob::PredayLT_LogsumManager::computeInputsFingerprint() const
+{
+	const ConfigParams& config = ConfigManager::GetInstance().FullConfig();
+	LogsumInputsFingerprint fingerprint;
+
+	//the coefficients of the models are in the scripts
+	addScripts(fingerprint, config.luaScriptsMapTC);
+	addScripts(fingerprint, config.luaScriptsMapTimeCostPlusOne);
+	addScripts(fingerprint, config.luaScriptsMapCostTimePlusOne);
+	addScripts(fingerprint, config.luaScriptsMapTCZeroCostConstants);
+	fingerprint.addValue(config.getNumTravelModes());
+
+	LogsumInputsFingerprint zones;
+	for (ZoneMap::const_iterator it = zoneMap.begin(); it != zoneMap.end(); ++it)
+	{
+		const ZoneParams* zone = it->second;
+		LogsumInputsFingerprint entry;
+		entry.addValue(it->first);
+		const int ids[] = { zone->getZoneCode(), zone->getCentralDummy(), zone->getCbdDummy() };
+		const double values[] = { zone->getShop(), zone->getParkingRate(), zone->getResidentWorkers(), zone->getEmployment(),
+				zone->getPopulation(), zone->getArea(), zone->getTotalEnrollment(), zone->getResidentStudents() };
+		entry.addBytes(ids, sizeof(ids));
+		entry.addBytes(values, sizeof(values));
+		zones.addUnordered(entry);
+	}
+	fingerprint.addValue(zones.getValue());
+
+	addCosts(fingerprint, amCostMap);
+	addCosts(fingerprint, pmCostMap);
+	addCosts(fingerprint, opCostMap);
+	return fingerprint.getValue();
+}
+
 const PredayLT_LogsumManager& sim_mob::PredayLT_LogsumManager::getInstance()
 {
 	if(logsumManager.dataLoadReqd)
@@ -217,11 +251,43 @@ const PredayLT_LogsumManager& sim_mob::PredayLT_LogsumManager::getInstance()
 
 		ltPopulationDao.getIncomeCategories(PersonParams::getIncomeCategoryLowerLimits());
 		ltPopulationDao.getAddresses();
+
+		const LongTermParams::LogsumCache& cacheParams = config.ltParams.logsumCache;
+		if(cacheParams.enabled)
+		{
+			logsumManager.logsumCache.reset(new LogsumCache(std::max(cacheParams.capacity, 1u), logsumManager.computeInputsFingerprint()));
+			if(!cacheParams.file.empty())
+			{
+				std::size_t numEntries = logsumManager.logsumCache->loadFromFile(cacheParams.file);
+				Print() << "Logsums of " << numEntries << " individual signatures loaded from " << cacheParams.file << std::endl;
+			}
+		}
 		logsumManager.dataLoadReqd = false;
 	}
 	return logsumManager;
 }
 
+void sim_mob::PredayLT_LogsumManager::saveLogsumCache()
+{
+	if(logsumManager.dataLoadReqd || !logsumManager.logsumCache)
+	{
+		return;
+	}
+
+	CacheStatistics stats = logsumManager.logsumCache->getStatistics();
+	uint64_t lookups = stats.hits + stats.misses;
+	Print() << "Logsum cache: " << stats.hits << " hits, " << stats.misses << " misses (hit rate "
+			<< (lookups ? (100.0 * stats.hits / lookups) : 0.0) << "%), " << stats.entries << " entries, "
+			<< stats.evictions << " evictions" << std::endl;
+
+	const std::string& fileName = ConfigManager::GetInstance().FullConfig().ltParams.logsumCache.file;
+	if(!fileName.empty())
+	{
+		std::size_t numEntries = logsumManager.logsumCache->saveToFile(fileName);
+		Print() << "Logsums of " << numEntries << " individual signatures saved to " << fileName << std::endl;
+	}
+}
+
 PersonParams sim_mob::PredayLT_LogsumManager::computeLogsum(long individualId, int homeLocation, int workLocation, int vehicleOwnership, PersonParams *personParamsFromLT,const std::string& luaDir) const
 {
 	ensureContext();
@@ -267,6 +333,17 @@ PersonParams sim_mob::PredayLT_LogsumManager::computeLogsum(long individualId, i
 	personParams.setActivityLogsum(1,0);
 	personParams.setActivityLogsum(2,0);
 
+	//individuals with the same signature get the same logsums
+	LogsumSignature signature;
+	if(logsumCache)
+	{
+		signature = LogsumSignature(personParams, luaDir);
+		if(logsumCache->find(signature, personParams))
+		{
+			return personParams;
+		}
+	}
+
 	LogsumTourModeDestinationParams tmdParams(zoneMap, amCostMap, pmCostMap, personParams, NULL_STOP, cfg.getNumTravelModes());
 	PredayLogsumLuaProvider::getPredayModel(luaDir).computeTourModeDestinationLogsum(personParams, cfg.getActivityTypeConfigMap(), tmdParams, zoneMap.size());
 
@@ -365,5 +442,10 @@ PersonParams sim_mob::PredayLT_LogsumManager::computeLogsum(long individualId, i
 	PredayLogsumLuaProvider::getPredayModel(luaDir).computeDayPatternLogsums(personParams);
 	PredayLogsumLuaProvider::getPredayModel(luaDir).computeDayPatternBinaryLogsums(personParams);
 
+	if(logsumCache)
+	{
+		logsumCache->insert(signature, personParams);
+	}
+
 	return personParams;
 }
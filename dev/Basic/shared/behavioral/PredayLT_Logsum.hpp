@@ -5,8 +5,10 @@
 #pragma once
 
 #include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/unordered_map.hpp>
 #include <vector>
+#include "LogsumCache.hpp"
 #include "params/PersonParams.hpp"
 #include "params/ZoneCostParams.hpp"
 
@@ -45,6 +47,11 @@ private:
 
     bool dataLoadReqd;
 
+    /**
+     * logsums already computed, keyed on the attributes of the individuals; null if the cache is disabled
+     */
+    boost::scoped_ptr<LogsumCache> logsumCache;
+
     PredayLT_LogsumManager();
 
     /**
@@ -57,6 +64,11 @@ private:
      */
     void loadCosts();
 
+    /**
+     * @return fingerprint of the logsum model scripts and of the loaded zones and costs
+     */
+    uint64_t computeInputsFingerprint() const;
+
 public:
     virtual ~PredayLT_LogsumManager();
 
@@ -74,5 +86,11 @@ public:
      * @return logsum value computed from day pattern binary (dpb.lua) model
      */
     PersonParams computeLogsum(long individualId, int homeLocation=-1, int workLocation=-1, int vehicleOwnership =-1, PersonParams *personParams = nullptr, const std::string& luaDir = std::string()) const;
+
+    /**
+     * prints the hit rate of the logsum cache and saves it to the configured file, if any.
+     * Does nothing if the cache is disabled or no logsum was computed.
+     */
+    static void saveLogsumCache();
 };
 }
@@ -0,0 +1,242 @@
+//Copyright (c) 2016 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "TimeDependentTT_Store.hpp"
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "database/predaydao/ZoneCostSqlDao.hpp"
+
+using namespace sim_mob;
+
+namespace
+{
+const char TT_STORE_MAGIC[8] = { 'S', 'M', 'T', 'D', 'T', 'T', '\0', '\0' };
+const uint32_t TT_STORE_VERSION = 1;
+
+inline size_t alignTo8(size_t size)
+{
+    return (size + 7) & ~static_cast<size_t>(7);
+}
+
+/**
+ * offsets of each section of the data block
+ */
+struct Layout
+{
+    size_t zoneIndexOffset;
+    size_t flagsOffset;
+    size_t travelTimesOffset;
+    size_t totalSize;
+
+    Layout(size_t headerSize, size_t numZones, size_t zoneIndexSize, size_t numModes, size_t valuesPerOD)
+    {
+        size_t numRecords = numModes * numZones * numZones;
+        zoneIndexOffset = alignTo8(headerSize);
+        flagsOffset = zoneIndexOffset + alignTo8(zoneIndexSize * sizeof(int32_t));
+        travelTimesOffset = flagsOffset + alignTo8(numRecords * sizeof(uint8_t));
+        totalSize = travelTimesOffset + (numRecords * valuesPerOD * sizeof(double));
+    }
+};
+
+/**
+ * copies one database record into its slot in the data block
+ */
+void fillRecord(TravelTimeMode ttMode, const TimeDependentTT_Params& todBasedTT, const int32_t* zoneIndex, uint32_t zoneIndexSize,
+        uint32_t numZones, uint8_t* flags, double* travelTimes, size_t& numRecordsFilled)
+{
+    int origin = todBasedTT.getOriginZone();
+    int destination = todBasedTT.getDestinationZone();
+    if (origin < 0 || destination < 0 || (uint32_t) origin >= zoneIndexSize || (uint32_t) destination >= zoneIndexSize
+            || zoneIndex[origin] < 0 || zoneIndex[destination] < 0)
+    {
+        return; //OD not in the zone list
+    }
+
+    size_t recordIdx = ((static_cast<size_t>(ttMode) * numZones + zoneIndex[origin]) * numZones) + zoneIndex[destination];
+    flags[recordIdx] = 1; //TimeDependentTT_Store::RECORD_AVAILABLE
+    if (todBasedTT.isInfoUnavailable())
+    {
+        flags[recordIdx] |= 2; //TimeDependentTT_Store::RECORD_INFO_UNAVAILABLE
+    }
+
+    double* record = travelTimes + (recordIdx * 2 * NUM_30MIN_TIME_WINDOWS_IN_DAY);
+    for (unsigned i = 0; i < NUM_30MIN_TIME_WINDOWS_IN_DAY; ++i)
+    {
+        record[i] = todBasedTT.getArrivalBasedTT_at(i);
+        record[NUM_30MIN_TIME_WINDOWS_IN_DAY + i] = todBasedTT.getDepartureBasedTT_at(i);
+    }
+    ++numRecordsFilled;
+}
+}
+
+TimeDependentTT_Store::TimeDependentTT_Store() :
+        data(nullptr), header(nullptr), zoneIndex(nullptr), flags(nullptr), travelTimes(nullptr)
+{
+}
+
+TimeDependentTT_Store::~TimeDependentTT_Store()
+{
+    release();
+}
+
+void TimeDependentTT_Store::release()
+{
+    data = nullptr;
+    header = nullptr;
+    zoneIndex = nullptr;
+    flags = nullptr;
+    travelTimes = nullptr;
+    std::vector<char>().swap(ownedData);
+    mappedRegion.reset();
+    mappedFile.reset();
+}
+
+void TimeDependentTT_Store::setSections()
+{
+    header = reinterpret_cast<const Header*>(data);
+    Layout layout(sizeof(Header), header->numZones, header->zoneIndexSize, NUM_TT_MODES, NUM_VALUES_PER_OD);
+    zoneIndex = reinterpret_cast<const int32_t*>(data + layout.zoneIndexOffset);
+    flags = reinterpret_cast<const uint8_t*>(data + layout.flagsOffset);
+    travelTimes = reinterpret_cast<const double*>(data + layout.travelTimesOffset);
+}
+
+void TimeDependentTT_Store::loadFromDatabase(TimeDependentTT_SqlDao& tcostDao, const std::vector<int>& zoneCodes)
+{
+    release();
+
+    int maxZoneCode = -1;
+    for (std::vector<int>::const_iterator it = zoneCodes.begin(); it != zoneCodes.end(); ++it)
+    {
+        if (*it < 0)
+        {
+            throw std::runtime_error("TimeDependentTT_Store: negative zone codes are not supported");
+        }
+        maxZoneCode = std::max(maxZoneCode, *it);
+    }
+
+    uint32_t numZones = zoneCodes.size();
+    uint32_t zoneIndexSize = maxZoneCode + 1;
+    Layout layout(sizeof(Header), numZones, zoneIndexSize, NUM_TT_MODES, NUM_VALUES_PER_OD);
+    ownedData.assign(layout.totalSize, 0);
+
+    char* block = &ownedData[0];
+    Header* writableHeader = reinterpret_cast<Header*>(block);
+    std::memcpy(writableHeader->magic, TT_STORE_MAGIC, sizeof(TT_STORE_MAGIC));
+    writableHeader->version = TT_STORE_VERSION;
+    writableHeader->numZones = numZones;
+    writableHeader->numTimeWindows = NUM_30MIN_TIME_WINDOWS_IN_DAY;
+    writableHeader->zoneIndexSize = zoneIndexSize;
+    writableHeader->totalSize = layout.totalSize;
+
+    int32_t* writableZoneIndex = reinterpret_cast<int32_t*>(block + layout.zoneIndexOffset);
+    std::fill(writableZoneIndex, writableZoneIndex + zoneIndexSize, -1);
+    for (uint32_t idx = 0; idx < numZones; ++idx)
+    {
+        writableZoneIndex[zoneCodes[idx]] = idx;
+    }
+
+    uint8_t* writableFlags = reinterpret_cast<uint8_t*>(block + layout.flagsOffset);
+    double* writableTravelTimes = reinterpret_cast<double*>(block + layout.travelTimesOffset);
+    size_t numRecordsFilled = 0;
+    const TravelTimeMode modes[NUM_TT_MODES] = { TravelTimeMode::TT_PRIVATE, TravelTimeMode::TT_PUBLIC };
+    for (unsigned m = 0; m < NUM_TT_MODES; ++m)
+    {
+        tcostDao.getAllTT(modes[m], boost::bind(fillRecord, modes[m], _1, writableZoneIndex, zoneIndexSize, numZones,
+                writableFlags, writableTravelTimes, boost::ref(numRecordsFilled)));
+    }
+
+    if (numRecordsFilled == 0)
+    {
+        release();
+        throw std::runtime_error("TimeDependentTT_Store: no time dependent travel times were loaded from the database");
+    }
+
+    data = block;
+    setSections();
+}
+
+bool TimeDependentTT_Store::loadFromFile(const std::string& fileName)
+{
+    {
+        std::ifstream probe(fileName.c_str(), std::ios::binary);
+        if (!probe.good())
+        {
+            return false;
+        }
+    }
+
+    release();
+    mappedFile.reset(new boost::interprocess::file_mapping(fileName.c_str(), boost::interprocess::read_only));
+    mappedRegion.reset(new boost::interprocess::mapped_region(*mappedFile, boost::interprocess::read_only));
+
+    const char* block = static_cast<const char*>(mappedRegion->get_address());
+    size_t blockSize = mappedRegion->get_size();
+    const Header* fileHeader = reinterpret_cast<const Header*>(block);
+
+    std::stringstream err;
+    if (blockSize < sizeof(Header) || std::memcmp(fileHeader->magic, TT_STORE_MAGIC, sizeof(TT_STORE_MAGIC)) != 0)
+    {
+        err << fileName << " is not a time dependent travel time file";
+    }
+    else if (fileHeader->version != TT_STORE_VERSION || fileHeader->numTimeWindows != NUM_30MIN_TIME_WINDOWS_IN_DAY)
+    {
+        err << fileName << " has version " << fileHeader->version << " with " << fileHeader->numTimeWindows
+            << " time windows; expected version " << TT_STORE_VERSION << " with " << NUM_30MIN_TIME_WINDOWS_IN_DAY;
+    }
+    else if (fileHeader->totalSize != blockSize
+            || Layout(sizeof(Header), fileHeader->numZones, fileHeader->zoneIndexSize, NUM_TT_MODES, NUM_VALUES_PER_OD).totalSize != blockSize)
+    {
+        err << fileName << " is truncated or corrupt";
+    }
+
+    if (!err.str().empty())
+    {
+        release();
+        throw std::runtime_error(err.str());
+    }
+
+    data = block;
+    setSections();
+    return true;
+}
+
+void TimeDependentTT_Store::writeToFile(const std::string& fileName) const
+{
+    if (!isLoaded())
+    {
+        throw std::runtime_error("TimeDependentTT_Store: nothing to write");
+    }
+
+    std::ofstream outFile(fileName.c_str(), std::ios::binary | std::ios::trunc | std::ios::out);
+    outFile.write(data, header->totalSize);
+    outFile.close();
+    if (!outFile)
+    {
+        throw std::runtime_error("TimeDependentTT_Store: could not write " + fileName);
+    }
+}
+
+bool TimeDependentTT_Store::getTT_ByOD(TravelTimeMode ttMode, int originZn, int destZn, TimeDependentTT_Params& outObj) const
+{
+    long recordIdx = getRecordIdx(ttMode, originZn, destZn);
+    if (recordIdx < 0 || !(flags[recordIdx] & RECORD_AVAILABLE))
+    {
+        return false;
+    }
+
+    outObj.setOriginZone(originZn);
+    outObj.setDestinationZone(destZn);
+    outObj.setInfoUnavailable(flags[recordIdx] & RECORD_INFO_UNAVAILABLE);
+    const double* record = travelTimes + (recordIdx * NUM_VALUES_PER_OD);
+    std::copy(record, record + NUM_30MIN_TIME_WINDOWS_IN_DAY, outObj.getArrivalBasedTT());
+    std::copy(record + NUM_30MIN_TIME_WINDOWS_IN_DAY, record + NUM_VALUES_PER_OD, outObj.getDepartureBasedTT());
+    return true;
+}
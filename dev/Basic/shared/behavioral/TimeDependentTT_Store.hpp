@@ -0,0 +1,207 @@
+//Copyright (c) 2016 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "params/ZoneCostParams.hpp"
+#include "PredayUtils.hpp"
+
+namespace boost
+{
+namespace interprocess
+{
+class file_mapping;
+class mapped_region;
+}
+}
+
+namespace sim_mob
+{
+
+class TimeDependentTT_SqlDao;
+
+/**
+ * Dense, read-only store of the time dependent zone to zone travel times (the learned travel time tables)
+ * for both private and public travel time modes.
+ *
+ * The data is held as one contiguous block laid out as
+ *  [header][zone code -> zone index][per OD record flags][per OD travel times (48 arrival based, 48 departure based)]
+ * so that a lookup is a couple of array indexing operations. The block is either bulk loaded from the database
+ * or memory-mapped (read-only) from a binary file previously written by writeToFile(). In both cases, the store
+ * is immutable after loading and can be shared by all preday threads without locking.
+ */
+class TimeDependentTT_Store : private boost::noncopyable
+{
+public:
+    TimeDependentTT_Store();
+    virtual ~TimeDependentTT_Store();
+
+    /**
+     * bulk loads the travel time tables of both modes from the database
+     *
+     * @param tcostDao dao for the time dependent travel time tables
+     * @param zoneCodes list of all zone codes for which travel times are to be stored
+     */
+    void loadFromDatabase(TimeDependentTT_SqlDao& tcostDao, const std::vector<int>& zoneCodes);
+
+    /**
+     * memory-maps a binary travel time file written by writeToFile()
+     *
+     * @param fileName path of the binary file
+     * @return true if the file was mapped; false if the file does not exist
+     * @throws std::runtime_error if the file exists but is not a valid travel time file
+     */
+    bool loadFromFile(const std::string& fileName);
+
+    /**
+     * writes the loaded travel times into a binary file which can later be mapped with loadFromFile()
+     *
+     * @param fileName path of the binary file to write
+     */
+    void writeToFile(const std::string& fileName) const;
+
+    /**
+     * @return true if travel times were loaded (from database or file); false otherwise
+     */
+    bool isLoaded() const
+    {
+        return (data != nullptr);
+    }
+
+    /**
+     * fills the travel times for an OD into a TimeDependentTT_Params.
+     * Behaves like TimeDependentTT_SqlDao::getTT_ByOD()
+     *
+     * @param ttMode mode type - (public transit / private) for fetching travel time
+     * @param originZn origin zone code
+     * @param destZn destination zone code
+     * @param outObj output object to fill
+     * @return true if travel times are available for the OD; false otherwise
+     */
+    bool getTT_ByOD(TravelTimeMode ttMode, int originZn, int destZn, TimeDependentTT_Params& outObj) const;
+
+    /**
+     * fetches the arrival based travel time for an OD in the i-th half hour window
+     *
+     * @param ttMode mode type - (public transit / private) for fetching travel time
+     * @param originZn origin zone code
+     * @param destZn destination zone code
+     * @param i index of half hour window (0 based)
+     * @return travel time if available; 0 if the OD is not available; -1 if i is an invalid index
+     */
+    double getArrivalBasedTT_at(TravelTimeMode ttMode, int originZn, int destZn, int i) const
+    {
+        return getTT_at(ttMode, originZn, destZn, i, 0);
+    }
+
+    /**
+     * fetches the departure based travel time for an OD in the i-th half hour window
+     *
+     * @param ttMode mode type - (public transit / private) for fetching travel time
+     * @param originZn origin zone code
+     * @param destZn destination zone code
+     * @param i index of half hour window (0 based)
+     * @return travel time if available; 0 if the OD is not available; -1 if i is an invalid index
+     */
+    double getDepartureBasedTT_at(TravelTimeMode ttMode, int originZn, int destZn, int i) const
+    {
+        return getTT_at(ttMode, originZn, destZn, i, NUM_30MIN_TIME_WINDOWS_IN_DAY);
+    }
+
+private:
+    /** header of the contiguous data block */
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t numZones;
+        uint32_t numTimeWindows;
+        uint32_t zoneIndexSize;
+        uint64_t totalSize;
+    };
+
+    /** per OD record flags */
+    enum RecordFlag
+    {
+        RECORD_AVAILABLE = 1,
+        RECORD_INFO_UNAVAILABLE = 2
+    };
+
+    /** number of travel time modes stored (private and public) */
+    static const unsigned NUM_TT_MODES = 2;
+
+    /** number of travel time values per OD (arrival based followed by departure based) */
+    static const unsigned NUM_VALUES_PER_OD = 2 * NUM_30MIN_TIME_WINDOWS_IN_DAY;
+
+    /**
+     * computes the offsets of the sections within the data block and sets the section pointers
+     */
+    void setSections();
+
+    /**
+     * releases the data block (owned or mapped)
+     */
+    void release();
+
+    /**
+     * @return position of the OD record for ttMode; -1 if either zone is unknown
+     */
+    long getRecordIdx(TravelTimeMode ttMode, int originZn, int destZn) const
+    {
+        if (originZn < 0 || destZn < 0 || (uint32_t) originZn >= header->zoneIndexSize || (uint32_t) destZn >= header->zoneIndexSize)
+        {
+            return -1;
+        }
+        int32_t orgIdx = zoneIndex[originZn];
+        int32_t destIdx = zoneIndex[destZn];
+        if (orgIdx < 0 || destIdx < 0)
+        {
+            return -1;
+        }
+        long numZones = header->numZones;
+        return ((static_cast<long>(ttMode) * numZones + orgIdx) * numZones + destIdx);
+    }
+
+    /**
+     * @param i index of half hour window (0 based)
+     * @param offset offset of the arrival based (0) or departure based (NUM_30MIN_TIME_WINDOWS_IN_DAY) values in the OD record
+     * @return travel time if available; 0 if the OD is not available; -1 if i is an invalid index
+     */
+    double getTT_at(TravelTimeMode ttMode, int originZn, int destZn, int i, unsigned offset) const
+    {
+        if (i < 0 || i >= (int) NUM_30MIN_TIME_WINDOWS_IN_DAY)
+        {
+            return -1;
+        }
+        long recordIdx = getRecordIdx(ttMode, originZn, destZn);
+        if (recordIdx < 0 || !(flags[recordIdx] & RECORD_AVAILABLE))
+        {
+            return 0;
+        }
+        return travelTimes[recordIdx * NUM_VALUES_PER_OD + offset + i];
+    }
+
+    /** data block; points into ownedData or into the mapped region */
+    const char* data;
+
+    /** sections of the data block */
+    const Header* header;
+    const int32_t* zoneIndex;
+    const uint8_t* flags;
+    const double* travelTimes;
+
+    /** storage for travel times loaded from the database */
+    std::vector<char> ownedData;
+
+    /** file mapping for travel times loaded from file */
+    boost::scoped_ptr<boost::interprocess::file_mapping> mappedFile;
+    boost::scoped_ptr<boost::interprocess::mapped_region> mappedRegion;
+};
+
+} // end namespace sim_mob
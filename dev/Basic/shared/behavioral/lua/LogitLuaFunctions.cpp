@@ -0,0 +1,319 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "LogitLuaFunctions.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "behavioral/LogitKernels.hpp"
+
+using namespace sim_mob;
+
+namespace
+{
+/**
+ * Stack positions of the lua tables given to a logit function
+ */
+struct Arguments
+{
+    int choiceset;
+    int utility;
+    int availability;
+    int scales;
+};
+
+/// calculate_probability(mtype, choiceset, utility, availables, scales)
+const Arguments PROBABILITY_ARGS = { 2, 3, 4, 5 };
+
+/// compute_mnl_logsum(utility, availability)
+const Arguments MNL_LOGSUM_ARGS = { 0, 1, 2, 0 };
+
+/// compute_nl_logsum(choiceset, utility, availables, scales)
+const Arguments NL_LOGSUM_ARGS = { 1, 2, 3, 4 };
+
+/**
+ * Error raised while reading the lua tables.
+ * luaL_error does not return, so errors are only raised once the C++ containers are destroyed.
+ */
+struct ReadError
+{
+    char message[128];
+
+    ReadError()
+    {
+        message[0] = '\0';
+    }
+
+    bool isSet() const
+    {
+        return message[0] != '\0';
+    }
+};
+
+/**
+ * reads the number stored in the table at tableIdx for the key on top of the stack; pops the key
+ *
+ * @return false if the value is not a number
+ */
+bool readNumber(lua_State* state, int tableIdx, double& value)
+{
+    lua_rawget(state, tableIdx);
+    const bool isNumber = lua_isnumber(state, -1);
+    value = lua_tonumber(state, -1);
+    lua_pop(state, 1);
+    return isNumber;
+}
+
+/**
+ * stores value in the table at tableIdx for the key on top of the stack; pops the key
+ */
+void writeNumber(lua_State* state, int tableIdx, double value)
+{
+    lua_pushnumber(state, value);
+    lua_rawset(state, tableIdx);
+}
+
+/**
+ * reads utility[key] and availability[key] for a key pushed by pushKey; as logit.lua does, an alternative whose
+ * utility is NaN gets a utility and an availability of 0 in the lua tables as well.
+ */
+template<typename PushKey>
+bool readAlternative(lua_State* state, const Arguments& args, PushKey pushKey, bool maskTables, double& utility, double& availability,
+        ReadError& error)
+{
+    pushKey();
+    if (!readNumber(state, args.utility, utility))
+    {
+        std::snprintf(error.message, sizeof(error.message), "logit: utility of an alternative is not a number");
+        return false;
+    }
+    if (utility != utility)
+    {
+        utility = 0;
+        availability = 0;
+        if (maskTables)
+        {
+            pushKey();
+            writeNumber(state, args.utility, 0);
+            pushKey();
+            writeNumber(state, args.availability, 0);
+        }
+        return true;
+    }
+    pushKey();
+    if (!readNumber(state, args.availability, availability))
+    {
+        std::snprintf(error.message, sizeof(error.message), "logit: availability of an alternative is not a number");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * reads the alternatives 1, 2, ... up to the first nil entry of the table at lengthIdx, as ipairs does
+ */
+bool readSequence(lua_State* state, const Arguments& args, int lengthIdx, bool maskTables, std::vector<double>& utility,
+        std::vector<double>& availability, ReadError& error)
+{
+    for (int k = 1;; ++k)
+    {
+        lua_rawgeti(state, lengthIdx, k);
+        const bool end = lua_isnil(state, -1);
+        lua_pop(state, 1);
+        if (end)
+        {
+            return true;
+        }
+
+        double u = 0, avl = 0;
+        if (!readAlternative(state, args, [state, k]() { lua_pushinteger(state, k); }, maskTables, u, avl, error))
+        {
+            return false;
+        }
+        utility.push_back(u);
+        availability.push_back(avl);
+    }
+}
+
+/**
+ * reads the alternatives of the choiceset of a nested logit model, nest by nest, in the order of pairs(choiceset)
+ *
+ * @param choices output param for the ids of the alternatives, in the order they are read
+ */
+bool readNests(lua_State* state, const Arguments& args, std::vector<double>& choices, std::vector<double>& utility,
+        std::vector<double>& availability, std::vector<std::size_t>& nestSizes, std::vector<double>& scales, ReadError& error)
+{
+    lua_pushnil(state);
+    while (lua_next(state, args.choiceset) != 0)
+    {
+        const int nestChoicesIdx = lua_gettop(state);
+        lua_pushvalue(state, nestChoicesIdx - 1);
+        double scale = 0;
+        if (!readNumber(state, args.scales, scale))
+        {
+            std::snprintf(error.message, sizeof(error.message), "logit: scale of a nest is not a number");
+            return false;
+        }
+        if (!lua_istable(state, nestChoicesIdx))
+        {
+            std::snprintf(error.message, sizeof(error.message), "logit: choices of a nest must be a table");
+            return false;
+        }
+
+        std::size_t nestSize = 0;
+        for (int i = 1;; ++i)
+        {
+            lua_rawgeti(state, nestChoicesIdx, i);
+            if (lua_isnil(state, -1))
+            {
+                lua_pop(state, 1);
+                break;
+            }
+            const int choiceIdx = lua_gettop(state);
+            double u = 0, avl = 0;
+            if (!readAlternative(state, args, [state, choiceIdx]() { lua_pushvalue(state, choiceIdx); }, true, u, avl, error))
+            {
+                return false;
+            }
+            choices.push_back(lua_tonumber(state, choiceIdx));
+            utility.push_back(u);
+            availability.push_back(avl);
+            lua_pop(state, 1);
+            ++nestSize;
+        }
+        nestSizes.push_back(nestSize);
+        scales.push_back(scale);
+        lua_pop(state, 1);
+    }
+    return true;
+}
+
+bool checkTable(lua_State* state, int arg, ReadError& error)
+{
+    if (!lua_istable(state, arg))
+    {
+        std::snprintf(error.message, sizeof(error.message), "logit: argument %d must be a table", arg);
+        return false;
+    }
+    return true;
+}
+
+bool checkTables(lua_State* state, const Arguments& args, bool nested, ReadError& error)
+{
+    return (args.choiceset == 0 || checkTable(state, args.choiceset, error)) && checkTable(state, args.utility, error)
+            && checkTable(state, args.availability, error) && (!nested || checkTable(state, args.scales, error));
+}
+
+/**
+ * lua: calculate_probability(mtype, choiceset, utility, availables, scales)
+ */
+int calculateProbability(lua_State* state)
+{
+    ReadError error;
+    {
+        const char* modelType = lua_tostring(state, 1);
+        if (modelType && std::strcmp(modelType, "mnl") == 0)
+        {
+            std::vector<double> utility, availability;
+            if (checkTables(state, PROBABILITY_ARGS, false, error)
+                    && readSequence(state, PROBABILITY_ARGS, PROBABILITY_ARGS.choiceset, true, utility, availability, error))
+            {
+                std::vector<double> probability(utility.size());
+                logit::computeMnlProbabilities(utility.data(), availability.data(), utility.size(), probability.data());
+                lua_newtable(state);
+                for (std::size_t k = 0; k < probability.size(); ++k)
+                {
+                    lua_pushnumber(state, probability[k]);
+                    lua_rawseti(state, -2, k + 1);
+                }
+            }
+        }
+        else if (modelType && std::strcmp(modelType, "nl") == 0)
+        {
+            std::vector<double> choices, utility, availability, scales;
+            std::vector<std::size_t> nestSizes;
+            if (checkTables(state, PROBABILITY_ARGS, true, error)
+                    && readNests(state, PROBABILITY_ARGS, choices, utility, availability, nestSizes, scales, error))
+            {
+                std::vector<double> probability(utility.size());
+                logit::computeNlProbabilities(utility.data(), availability.data(), nestSizes.data(), scales.data(), nestSizes.size(),
+                        probability.data());
+                //keys are inserted in the order logit.lua inserts them, so that make_final_choice visits them in the same order
+                lua_newtable(state);
+                for (std::size_t i = 0; i < probability.size(); ++i)
+                {
+                    lua_pushnumber(state, choices[i]);
+                    lua_pushnumber(state, probability[i]);
+                    lua_rawset(state, -3);
+                }
+            }
+        }
+        else
+        {
+            std::snprintf(error.message, sizeof(error.message), "unknown model type:%s. Only 'mnl' and 'nl' are currently supported",
+                    modelType ? modelType : "nil");
+        }
+    }
+    if (error.isSet())
+    {
+        return luaL_error(state, "%s", error.message);
+    }
+    return 1;
+}
+
+/**
+ * lua: compute_mnl_logsum(utility, availability)
+ * the tables are not modified, as in logit.lua
+ */
+int computeMnlLogsum(lua_State* state)
+{
+    ReadError error;
+    double logsum = 0;
+    {
+        std::vector<double> utility, availability;
+        if (checkTables(state, MNL_LOGSUM_ARGS, false, error)
+                && readSequence(state, MNL_LOGSUM_ARGS, MNL_LOGSUM_ARGS.utility, false, utility, availability, error))
+        {
+            logsum = logit::computeMnlLogsum(utility.data(), availability.data(), utility.size());
+        }
+    }
+    if (error.isSet())
+    {
+        return luaL_error(state, "%s", error.message);
+    }
+    lua_pushnumber(state, logsum);
+    return 1;
+}
+
+/**
+ * lua: compute_nl_logsum(choiceset, utility, availables, scales)
+ */
+int computeNlLogsum(lua_State* state)
+{
+    ReadError error;
+    double logsum = 0;
+    {
+        std::vector<double> choices, utility, availability, scales;
+        std::vector<std::size_t> nestSizes;
+        if (checkTables(state, NL_LOGSUM_ARGS, true, error) && readNests(state, NL_LOGSUM_ARGS, choices, utility, availability, nestSizes, scales, error))
+        {
+            logsum = logit::computeNlLogsum(utility.data(), availability.data(), nestSizes.data(), scales.data(), nestSizes.size());
+        }
+    }
+    if (error.isSet())
+    {
+        return luaL_error(state, "%s", error.message);
+    }
+    lua_pushnumber(state, logsum);
+    return 1;
+}
+}
+
+void sim_mob::lua::registerNativeLogitFunctions(lua_State* state)
+{
+    lua_register(state, "calculate_probability", calculateProbability);
+    lua_register(state, "compute_mnl_logsum", computeMnlLogsum);
+    lua_register(state, "compute_nl_logsum", computeNlLogsum);
+}
@@ -0,0 +1,26 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+#include "lua/LuaLibrary.hpp"
+
+namespace sim_mob
+{
+namespace lua
+{
+/**
+ * Replaces the lua functions calculate_probability, compute_mnl_logsum and compute_nl_logsum of logit.lua
+ * in the given state by native functions with the same arguments and results, computed with the batched
+ * kernels of behavioral/LogitKernels.hpp.
+ * make_final_choice is left in lua, so that the random numbers drawn for the choices do not change.
+ * The utilities are still computed by the model scripts, whose formulas and coefficients differ for each model;
+ * they take most of the time of a call (see benchmarks/PredayLogitBenchmark.cpp).
+ *
+ * Must be called after logit.lua is loaded, since loading it redefines the lua versions.
+ *
+ * @param state lua state in which logit.lua is loaded
+ */
+void registerNativeLogitFunctions(lua_State* state);
+}
+}
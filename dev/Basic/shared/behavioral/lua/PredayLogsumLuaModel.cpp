@@ -111,8 +111,7 @@ void sim_mob::PredayLogsumLuaModel::mapClasses()
 
 void sim_mob::PredayLogsumLuaModel::computeDayPatternLogsums(PersonParams& personParams) const
 {
-    LuaRef computeLogsumDPT = getGlobal(state.get(), "compute_logsum_dpt");
-    LuaRef dptRetVal = computeLogsumDPT(personParams);
+    LuaRef dptRetVal = getFunction("compute_logsum_dpt")(&personParams);
     if(dptRetVal.isTable())
     {
         personParams.setDptLogsum(dptRetVal[1].cast<double>());
@@ -123,15 +122,12 @@ void sim_mob::PredayLogsumLuaModel::computeDayPatternLogsums(PersonParams& perso
         throw std::runtime_error("compute_logsum_dpt function does not return a table as expected");
     }
 
-    LuaRef computeLogsumDPS = getGlobal(state.get(), "compute_logsum_dps");
-    LuaRef dpsLogsum = computeLogsumDPS(personParams);
-    personParams.setDpsLogsum(dpsLogsum.cast<double>());
+    personParams.setDpsLogsum(call<double>(getFunction("compute_logsum_dps"), &personParams));
 }
 
 void sim_mob::PredayLogsumLuaModel::computeDayPatternBinaryLogsums(PersonParams& personParams) const
 {
-    LuaRef computeLogsumDPB = getGlobal(state.get(), "compute_logsum_dpb");
-    LuaRef dpbRetVal = computeLogsumDPB(personParams);
+    LuaRef dpbRetVal = getFunction("compute_logsum_dpb")(&personParams);
     if(dpbRetVal.isTable())
     {
         personParams.setDpbLogsum(dpbRetVal[1].cast<double>());
@@ -153,10 +149,8 @@ void sim_mob::PredayLogsumLuaModel::computeTourModeLogsum(PersonParams& personPa
         {
             if (!actConfig.tourModeDestModel.empty())
             {
-                std::string luaFunc = "compute_logsum_" + actConfig.tourModeModel;
-                LuaRef computeLogsumTMW = getGlobal(state.get(), luaFunc.c_str());
-                LuaRef workLogSum = computeLogsumTMW(&personParams, &tourModeParams);
-                personParams.setActivityLogsum(activity.first, workLogSum.cast<double>());
+                personParams.setActivityLogsum(activity.first,
+                        call<double>(getFunction("compute_logsum_", actConfig.tourModeModel), &personParams, &tourModeParams));
             }
         }
 
@@ -164,10 +158,8 @@ void sim_mob::PredayLogsumLuaModel::computeTourModeLogsum(PersonParams& personPa
         {
             if (!actConfig.tourModeModel.empty())
             {
-                std::string luaFunc = "compute_logsum_" + actConfig.tourModeModel;
-                LuaRef computeLogsumTMW = getGlobal(state.get(), luaFunc.c_str());
-                LuaRef workLogSum = computeLogsumTMW(&personParams, &tourModeParams);
-                personParams.setActivityLogsum(activity.first, workLogSum.cast<double>());
+                personParams.setActivityLogsum(activity.first,
+                        call<double>(getFunction("compute_logsum_", actConfig.tourModeModel), &personParams, &tourModeParams));
             }
         }
     }
@@ -188,20 +180,16 @@ void sim_mob::PredayLogsumLuaModel::computeTourModeDestinationLogsum(PersonParam
         {
             if (!actConfig.tourModeDestModel.empty())
             {
-                std::string luaFunc = "compute_logsum_" + actConfig.tourModeDestModel;
-                LuaRef computeLogsumTMDW = getGlobal(state.get(), luaFunc.c_str());
-                LuaRef workLogSum = computeLogsumTMDW(&personParams, &tourModeDestinationParams, size);
-                personParams.setActivityLogsum(activity.first, workLogSum.cast<double>());
+                personParams.setActivityLogsum(activity.first,
+                        call<double>(getFunction("compute_logsum_", actConfig.tourModeDestModel), &personParams, &tourModeDestinationParams, size));
             }
         }
         else
         {
             if (!actConfig.tourModeDestModel.empty())
             {
-                std::string luaFunc = "compute_logsum_" + actConfig.tourModeDestModel;
-                LuaRef computeLogsumTMD = getGlobal(state.get(), luaFunc.c_str());
-                LuaRef logsum = computeLogsumTMD(&personParams, &tourModeDestinationParams, size);
-                personParams.setActivityLogsum(activity.first, logsum.cast<double>());
+                personParams.setActivityLogsum(activity.first,
+                        call<double>(getFunction("compute_logsum_", actConfig.tourModeDestModel), &personParams, &tourModeDestinationParams, size));
             }
         }
     }
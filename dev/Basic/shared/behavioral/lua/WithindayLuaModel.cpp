@@ -119,10 +119,7 @@ int sim_mob::WithindayLuaModel::chooseMode(const PersonParams& personParams, con
     const std::string& modelName = activityTypes.at(wdModeParams.getTripType()).withinDayModeChoiceModel;
     if (modelName.empty())
     {
-        std::string luaFunc = "choose_" + modelName;
-        LuaRef chooseWDM = getGlobal(state.get(), luaFunc.c_str());
-        LuaRef retVal = chooseWDM(&personParams, &wdModeParams);
-        return retVal.cast<int>();
+        return call<int>(getFunction("choose_", modelName), &personParams, &wdModeParams);
     }
 }
 
@@ -0,0 +1,299 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/**
+ * \file AuraManagerBenchmark.cpp
+ * Compares the GridAuraManager with the PackingTreeAuraManager.
+ *
+ * Agents drive around a square area, split among worker threads which move their own agents at every tick, while
+ * a few agents leave the simulation and are replaced by new ones. At every tick, as in the aura manager barrier
+ * phase of WorkGroup, the packing tree is rebuilt from Agent::all_agents on the main thread, whereas the grid is
+ * updated by the worker threads (updateAgents) and then by the main thread (update). Random rectangles are then
+ * queried from both and the results must be the same agents.
+ * Prints the time spent updating each index (on the worker threads and on the main thread) and answering the queries.
+ *
+ * Usage: SM_AuraManagerBenchmark [-threads <n>] [-agents <n>] [-ticks <n>] [-queries <n>]
+ *   -threads : number of worker threads.
+ *   -agents  : number of agents.
+ *   -ticks   : number of ticks.
+ *   -queries : number of rectangles queried at every tick.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "entities/Agent.hpp"
+#include "geospatial/network/Point.hpp"
+#include "spatial_trees/grid/GridAuraManager.hpp"
+#include "spatial_trees/packing_tree/PackingTreeAuraManager.hpp"
+
+using namespace sim_mob;
+
+namespace
+{
+typedef boost::chrono::high_resolution_clock Clock;
+
+/**side of the simulated area (meters)*/
+const int AREA_SIZE = 20000;
+
+/**maximum distance covered by an agent in a tick along each axis (meters)*/
+const int MAX_STEP = 2;
+
+/**side of the queried rectangles (meters)*/
+const double QUERY_SIZE = 200.0;
+
+/**fraction of the agents replaced at every tick*/
+const double CHURN = 0.001;
+
+double elapsedMs(const Clock::time_point& start)
+{
+    return boost::chrono::duration_cast<boost::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+/**agent which only has a position*/
+class BenchmarkAgent : public Agent
+{
+public:
+    BenchmarkAgent(int x, int y) : Agent(MtxStrat_Buffered)
+    {
+        xPos.force(x);
+        yPos.force(y);
+    }
+
+    virtual bool isNonspatial()
+    {
+        return false;
+    }
+
+protected:
+    virtual UpdateStatus frame_init(timeslice now)
+    {
+        return UpdateStatus::Continue;
+    }
+
+    virtual UpdateStatus frame_tick(timeslice now)
+    {
+        return UpdateStatus::Continue;
+    }
+
+    virtual void frame_output(timeslice now)
+    {
+    }
+};
+
+class Benchmark
+{
+public:
+    Benchmark(unsigned numThreads, unsigned numAgents, unsigned numTicks, unsigned numQueries) :
+            numThreads(numThreads), numAgents(numAgents), numTicks(numTicks), numQueries(numQueries), workerAgents(numThreads),
+            generators(numThreads), tickStart(numThreads + 1), tickEnd(numThreads + 1), rng(1)
+    {
+        for (unsigned t = 0; t < numThreads; ++t)
+        {
+            generators[t].seed(t + 2);
+        }
+        for (unsigned i = 0; i < numAgents; ++i)
+        {
+            addAgent(i % numThreads);
+        }
+    }
+
+    ~Benchmark()
+    {
+        for (std::set<Entity *>::iterator it = Agent::all_agents.begin(); it != Agent::all_agents.end(); ++it)
+        {
+            delete *it;
+        }
+        Agent::all_agents.clear();
+    }
+
+    void run()
+    {
+        boost::thread_group workers;
+        for (unsigned t = 0; t < numThreads; ++t)
+        {
+            workers.create_thread(boost::bind(&Benchmark::workerLoop, this, t));
+        }
+
+        double packingMs = 0, gridWorkersMs = 0, gridMainMs = 0, packingQueryMs = 0, gridQueryMs = 0;
+        unsigned long found = 0;
+        for (unsigned tick = 0; tick < numTicks; ++tick)
+        {
+            std::set<Entity *> removed;
+            replaceAgents(removed);
+
+            //the workers move their agents
+            tickStart.wait();
+            tickEnd.wait();
+
+            Clock::time_point start = Clock::now();
+            packing.update(tick, removed);
+            packingMs += elapsedMs(start);
+
+            //the workers report the new positions of their agents
+            start = Clock::now();
+            tickStart.wait();
+            tickEnd.wait();
+            gridWorkersMs += elapsedMs(start);
+
+            start = Clock::now();
+            grid.update(tick, removed);
+            gridMainMs += elapsedMs(start);
+
+            for (unsigned q = 0; q < numQueries; ++q)
+            {
+                boost::random::uniform_int_distribution<int> corner(-100, AREA_SIZE);
+                const Point lowerLeft(corner(rng) + 0.5, corner(rng) + 0.5);
+                const Point upperRight(lowerLeft.getX() + QUERY_SIZE, lowerLeft.getY() + QUERY_SIZE);
+
+                start = Clock::now();
+                std::vector<const Agent *> expected = packing.agentsInRect(lowerLeft, upperRight, nullptr);
+                packingQueryMs += elapsedMs(start);
+
+                start = Clock::now();
+                std::vector<const Agent *> result = grid.agentsInRect(lowerLeft, upperRight, nullptr);
+                gridQueryMs += elapsedMs(start);
+
+                std::sort(expected.begin(), expected.end());
+                std::sort(result.begin(), result.end());
+                if (expected != result)
+                {
+                    throw std::runtime_error("the grid and the packing tree found different agents");
+                }
+                found += result.size();
+            }
+
+            for (std::set<Entity *>::iterator it = removed.begin(); it != removed.end(); ++it)
+            {
+                delete *it;
+            }
+        }
+        workers.join_all();
+
+        std::cout << numAgents << " agents, " << numThreads << " threads, " << numTicks << " ticks, " << found << " agents found by "
+                << static_cast<unsigned long>(numTicks) * numQueries << " queries" << std::endl;
+        std::cout << "packing tree: update " << packingMs / numTicks << " ms/tick (main thread), queries "
+                << packingQueryMs / numTicks << " ms/tick" << std::endl;
+        std::cout << "grid        : update " << gridWorkersMs / numTicks << " ms/tick (workers) + " << gridMainMs / numTicks
+                << " ms/tick (main thread), queries " << gridQueryMs / numTicks << " ms/tick" << std::endl;
+    }
+
+private:
+    void addAgent(unsigned t)
+    {
+        boost::random::uniform_int_distribution<int> coordinate(0, AREA_SIZE);
+        BenchmarkAgent *agent = new BenchmarkAgent(coordinate(rng), coordinate(rng));
+        Agent::all_agents.insert(agent);
+        workerAgents[t].insert(agent);
+    }
+
+    /**removes some agents, as WorkGroup does with the agents which are done, and adds as many new ones*/
+    void replaceAgents(std::set<Entity *> &removed)
+    {
+        const unsigned numReplaced = static_cast<unsigned>(numAgents * CHURN);
+        for (unsigned i = 0; i < numReplaced; ++i)
+        {
+            const unsigned t = i % numThreads;
+            if (workerAgents[t].empty())
+            {
+                continue;
+            }
+            Entity *agent = *workerAgents[t].begin();
+            workerAgents[t].erase(workerAgents[t].begin());
+            Agent::all_agents.erase(agent);
+            removed.insert(agent);
+            addAgent(t);
+        }
+    }
+
+    void workerLoop(unsigned t)
+    {
+        boost::random::uniform_int_distribution<int> step(-MAX_STEP, MAX_STEP);
+        for (unsigned tick = 0; tick < numTicks; ++tick)
+        {
+            //frame tick: move the agents
+            tickStart.wait();
+            for (std::set<Entity *>::iterator it = workerAgents[t].begin(); it != workerAgents[t].end(); ++it)
+            {
+                Agent *agent = static_cast<Agent *>(*it);
+                agent->xPos.force(agent->xPos.get() + step(generators[t]));
+                agent->yPos.force(agent->yPos.get() + step(generators[t]));
+            }
+            tickEnd.wait();
+
+            //buffer flip: report the new positions
+            tickStart.wait();
+            grid.updateAgents(workerAgents[t]);
+            tickEnd.wait();
+        }
+    }
+
+    const unsigned numThreads;
+    const unsigned numAgents;
+    const unsigned numTicks;
+    const unsigned numQueries;
+
+    /**agents moved by each worker*/
+    std::vector<std::set<Entity *> > workerAgents;
+    std::vector<boost::random::mt19937> generators;
+
+    boost::barrier tickStart;
+    boost::barrier tickEnd;
+
+    /**generator of the main thread*/
+    boost::random::mt19937 rng;
+
+    PackingTreeAuraManager packing;
+    GridAuraManager grid;
+};
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned numThreads = 4;
+    unsigned numAgents = 100000;
+    unsigned numTicks = 100;
+    unsigned numQueries = 1000;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        if (arg == "-threads") { numThreads = std::atoi(argv[i + 1]); }
+        else if (arg == "-agents") { numAgents = std::atoi(argv[i + 1]); }
+        else if (arg == "-ticks") { numTicks = std::atoi(argv[i + 1]); }
+        else if (arg == "-queries") { numQueries = std::atoi(argv[i + 1]); }
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (numThreads == 0 || numAgents == 0)
+    {
+        std::cerr << "Error: -threads and -agents must be positive" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        Benchmark benchmark(numThreads, numAgents, numTicks, numQueries);
+        benchmark.run();
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
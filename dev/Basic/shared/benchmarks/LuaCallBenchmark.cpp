@@ -0,0 +1,186 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/**
+ * \file LuaCallBenchmark.cpp
+ * Micro-benchmark of calls from C++ to the functions of lua model scripts.
+ *
+ * Calls a lua function taking a parameter object, as the behavioral models do:
+ *  - looking the function up with luabridge::getGlobal on every call, with a name built from a prefix and a model name,
+ *    and reading the result through the returned LuaRef, as the models did before, and
+ *  - through LuaModel::getFunction and LuaModel::call,
+ * checks that both give the same results and prints the number of calls per second of each.
+ *
+ * Usage: SM_LuaCallBenchmark [-script <file>] [-calls <n>]
+ *   -script : lua script defining choose_benchmark(params); params has the property "value" and the function
+ *             "zone_value(zone)". If omitted, a small script is generated.
+ *   -calls  : number of calls of each variant.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/chrono.hpp>
+#include <boost/filesystem.hpp>
+
+#include "lua/LuaModel.hpp"
+
+using namespace sim_mob;
+using namespace luabridge;
+
+namespace
+{
+typedef boost::chrono::high_resolution_clock Clock;
+
+const std::string MODEL_NAME = "benchmark";
+
+const char* DEFAULT_SCRIPT =
+        "function choose_benchmark(params)\n"
+        "    local utility = params.value\n"
+        "    for zone = 1, 4 do\n"
+        "        utility = utility + params:zone_value(zone)\n"
+        "    end\n"
+        "    return utility % 7\n"
+        "end\n";
+
+/**parameter object given to the lua function*/
+class BenchmarkParams
+{
+public:
+    BenchmarkParams() : value(0)
+    {
+    }
+
+    int getValue() const
+    {
+        return value;
+    }
+
+    void setValue(int value)
+    {
+        this->value = value;
+    }
+
+    int getZoneValue(int zone) const
+    {
+        return value * zone;
+    }
+
+private:
+    int value;
+};
+
+class BenchmarkLuaModel : public lua::LuaModel
+{
+public:
+    /**looks the function up by name on each call, as the behavioral models did before*/
+    int callByName(BenchmarkParams& params) const
+    {
+        std::string luaFunc = "choose_" + MODEL_NAME;
+        LuaRef chooseFunc = getGlobal(state.get(), luaFunc.c_str());
+        LuaRef retVal = chooseFunc(&params);
+        return retVal.cast<int>();
+    }
+
+    int callCached(BenchmarkParams& params) const
+    {
+        return call<int>(getFunction("choose_", MODEL_NAME), &params);
+    }
+
+private:
+    void mapClasses()
+    {
+        getGlobalNamespace(state.get())
+                .beginClass<BenchmarkParams>("BenchmarkParams")
+                    .addProperty("value", &BenchmarkParams::getValue)
+                    .addFunction("zone_value", &BenchmarkParams::getZoneValue)
+                .endClass();
+    }
+};
+
+double elapsedMs(const Clock::time_point& start)
+{
+    return boost::chrono::duration_cast<boost::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+void printRate(const std::string& variant, unsigned numCalls, double ms)
+{
+    std::cout << variant << ": " << ms << " ms, " << static_cast<long>(numCalls / (ms / 1000.0)) << " calls/s" << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    std::string scriptFile;
+    unsigned numCalls = 1000000;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        if (arg == "-script") { scriptFile = argv[i + 1]; }
+        else if (arg == "-calls") { numCalls = std::atoi(argv[i + 1]); }
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    boost::filesystem::path generatedScript;
+    try
+    {
+        if (scriptFile.empty())
+        {
+            generatedScript = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("lua-benchmark-%%%%%%%%.lua");
+            std::ofstream out(generatedScript.string().c_str());
+            out << DEFAULT_SCRIPT;
+            scriptFile = generatedScript.string();
+        }
+
+        BenchmarkLuaModel model;
+        model.loadFile(scriptFile);
+        model.initialize();
+
+        BenchmarkParams params;
+        long byNameSum = 0;
+        Clock::time_point start = Clock::now();
+        for (unsigned i = 0; i < numCalls; ++i)
+        {
+            params.setValue(i);
+            byNameSum += model.callByName(params);
+        }
+        printRate("getGlobal per call", numCalls, elapsedMs(start));
+
+        long cachedSum = 0;
+        start = Clock::now();
+        for (unsigned i = 0; i < numCalls; ++i)
+        {
+            params.setValue(i);
+            cachedSum += model.callCached(params);
+        }
+        printRate("cached function  ", numCalls, elapsedMs(start));
+
+        if (byNameSum != cachedSum)
+        {
+            throw std::runtime_error("the variants returned different results");
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        if (!generatedScript.empty())
+        {
+            boost::filesystem::remove(generatedScript);
+        }
+        return 1;
+    }
+
+    if (!generatedScript.empty())
+    {
+        boost::filesystem::remove(generatedScript);
+    }
+    return 0;
+}
@@ -0,0 +1,325 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/**
+ * \file MessageBusBenchmark.cpp
+ * Micro-benchmark of the distribution of messages between thread contexts by the MessageBus.
+ *
+ * Worker threads and the main thread go through the same tick as in WorkGroupManager: the workers dispatch
+ * their messages, post new ones while the main thread waits, and the main thread then distributes them.
+ * Two workloads are run:
+ *  - transit : each vehicle sends a request to a random stop (of any thread) every tick and each stop replies
+ *              to the vehicle, as bus and train drivers exchange messages with stop agents across confluxes, and
+ *  - mobility: each driver sends its status to a single controller every tick, and the controller replies to
+ *              a quarter of them, as the mobility service controller does with its drivers.
+ * Checks that every message is handled once and prints the number of messages per second of each workload.
+ *
+ * Usage: SM_MessageBusBenchmark [-threads <n>] [-handlers <n>] [-ticks <n>]
+ *   -threads  : number of worker threads.
+ *   -handlers : number of vehicles (drivers) and of stops per worker thread.
+ *   -ticks    : number of ticks of each workload.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "message/MessageBus.hpp"
+
+using namespace sim_mob;
+using namespace sim_mob::messaging;
+
+namespace
+{
+typedef boost::chrono::high_resolution_clock Clock;
+
+enum BenchmarkMessages
+{
+    MSG_REQUEST = 9900000,
+    MSG_REPLY
+};
+
+class BenchmarkMessage : public Message
+{
+public:
+    explicit BenchmarkMessage(MessageHandler* from) : from(from)
+    {
+    }
+
+    MessageHandler* from;
+};
+
+/**agent exchanging messages; replies to the requests it receives if replyEvery is not 0*/
+class BenchmarkHandler : public MessageHandler
+{
+public:
+    BenchmarkHandler(unsigned int id, unsigned int replyEvery) : MessageHandler(id), replyEvery(replyEvery), received(0)
+    {
+    }
+
+    virtual void HandleMessage(Message::MessageType type, const Message& message)
+    {
+        ++received;
+        if (type == MSG_REQUEST && replyEvery != 0 && received % replyEvery == 0)
+        {
+            MessageBus::PostMessage(MSG_CAST(BenchmarkMessage, message).from, MSG_REPLY,
+                    MessageBus::MessagePtr(new BenchmarkMessage(this)));
+        }
+    }
+
+    unsigned int replyEvery;
+    unsigned long received;
+};
+
+/**one run of a workload*/
+class Workload
+{
+public:
+    Workload(const std::string& name, unsigned numThreads, unsigned numHandlers, unsigned numTicks) :
+            name(name), numThreads(numThreads), numHandlers(numHandlers), numTicks(numTicks),
+            senders(numThreads), receivers(numThreads), tickStart(numThreads + 1), tickEnd(numThreads + 1), dispatched(numThreads)
+    {
+    }
+
+    virtual ~Workload()
+    {
+        for (unsigned t = 0; t < numThreads; ++t)
+        {
+            for (size_t i = 0; i < senders[t].size(); ++i)
+            {
+                delete senders[t][i];
+            }
+            for (size_t i = 0; i < receivers[t].size(); ++i)
+            {
+                delete receivers[t][i];
+            }
+        }
+    }
+
+    /**runs the workload on the calling (main) thread and the worker threads; returns the number of messages handled*/
+    unsigned long run()
+    {
+        boost::thread_group workers;
+        for (unsigned t = 0; t < numThreads; ++t)
+        {
+            workers.create_thread(boost::bind(&Workload::workerLoop, this, t));
+        }
+
+        //the handlers of all threads are created before the first tick
+        tickEnd.wait();
+        Clock::time_point start = Clock::now();
+        for (unsigned tick = 0; tick <= numTicks; ++tick)
+        {
+            tickStart.wait();
+            tickEnd.wait();
+            MessageBus::DistributeMessages();
+        }
+        //last dispatch; no more messages are posted
+        tickStart.wait();
+        tickEnd.wait();
+        workers.join_all();
+        MessageBus::DistributeMessages();
+        double ms = boost::chrono::duration_cast<boost::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+
+        unsigned long handled = 0, expected = 0;
+        for (unsigned t = 0; t < numThreads; ++t)
+        {
+            for (size_t i = 0; i < senders[t].size(); ++i)
+            {
+                handled += senders[t][i]->received;
+            }
+            for (size_t i = 0; i < receivers[t].size(); ++i)
+            {
+                handled += receivers[t][i]->received;
+                expected += receivers[t][i]->received / receivers[t][i]->replyEvery;
+            }
+        }
+        expected += getNumRequests();
+        if (handled != expected)
+        {
+            throw std::runtime_error(name + ": messages were lost or handled twice");
+        }
+        std::cout << name << ": " << handled << " messages, " << ms << " ms, " << static_cast<long>(handled / (ms / 1000.0))
+                << " messages/s" << std::endl;
+        return handled;
+    }
+
+protected:
+    /**creates the handlers of thread t; called on thread t*/
+    virtual void createHandlers(unsigned t) = 0;
+
+    /**posts the messages of thread t for the given tick*/
+    virtual void post(unsigned t, unsigned tick) = 0;
+
+    /**number of requests posted over all ticks*/
+    virtual unsigned long getNumRequests() const = 0;
+
+    void workerLoop(unsigned t)
+    {
+        MessageBus::RegisterThread();
+        createHandlers(t);
+        for (size_t i = 0; i < senders[t].size(); ++i)
+        {
+            MessageBus::RegisterHandler(senders[t][i]);
+        }
+        for (size_t i = 0; i < receivers[t].size(); ++i)
+        {
+            MessageBus::RegisterHandler(receivers[t][i]);
+        }
+        tickEnd.wait();
+
+        for (unsigned tick = 0; tick <= numTicks + 1; ++tick)
+        {
+            tickStart.wait();
+            MessageBus::ThreadDispatchMessages();
+            dispatched.wait();
+            if (tick < numTicks)
+            {
+                post(t, tick);
+            }
+            tickEnd.wait();
+        }
+    }
+
+    const std::string name;
+    const unsigned numThreads;
+    const unsigned numHandlers;
+    const unsigned numTicks;
+
+    /**handlers posting requests, by thread*/
+    std::vector<std::vector<BenchmarkHandler*> > senders;
+
+    /**handlers receiving requests, by thread*/
+    std::vector<std::vector<BenchmarkHandler*> > receivers;
+
+    boost::barrier tickStart;
+    boost::barrier tickEnd;
+    boost::barrier dispatched;
+};
+
+class TransitWorkload : public Workload
+{
+public:
+    TransitWorkload(unsigned numThreads, unsigned numHandlers, unsigned numTicks) :
+            Workload("transit ", numThreads, numHandlers, numTicks), generators(numThreads)
+    {
+    }
+
+protected:
+    virtual void createHandlers(unsigned t)
+    {
+        generators[t].seed(t + 1);
+        for (unsigned i = 0; i < numHandlers; ++i)
+        {
+            senders[t].push_back(new BenchmarkHandler(t * numHandlers + i, 0));
+            receivers[t].push_back(new BenchmarkHandler(t * numHandlers + i, 1));
+        }
+    }
+
+    virtual void post(unsigned t, unsigned tick)
+    {
+        boost::random::uniform_int_distribution<unsigned> thread(0, numThreads - 1), stop(0, numHandlers - 1);
+        for (size_t i = 0; i < senders[t].size(); ++i)
+        {
+            MessageBus::PostMessage(receivers[thread(generators[t])][stop(generators[t])], MSG_REQUEST,
+                    MessageBus::MessagePtr(new BenchmarkMessage(senders[t][i])));
+        }
+    }
+
+    virtual unsigned long getNumRequests() const
+    {
+        return static_cast<unsigned long>(numThreads) * numHandlers * numTicks;
+    }
+
+private:
+    std::vector<boost::random::mt19937> generators;
+};
+
+class MobilityServiceWorkload : public Workload
+{
+public:
+    MobilityServiceWorkload(unsigned numThreads, unsigned numHandlers, unsigned numTicks) :
+            Workload("mobility", numThreads, numHandlers, numTicks)
+    {
+    }
+
+protected:
+    virtual void createHandlers(unsigned t)
+    {
+        for (unsigned i = 0; i < numHandlers; ++i)
+        {
+            senders[t].push_back(new BenchmarkHandler(t * numHandlers + i, 0));
+        }
+        if (t == 0)
+        {
+            receivers[t].push_back(new BenchmarkHandler(0, 4));
+        }
+    }
+
+    virtual void post(unsigned t, unsigned tick)
+    {
+        for (size_t i = 0; i < senders[t].size(); ++i)
+        {
+            MessageBus::PostMessage(receivers[0][0], MSG_REQUEST, MessageBus::MessagePtr(new BenchmarkMessage(senders[t][i])));
+        }
+    }
+
+    virtual unsigned long getNumRequests() const
+    {
+        return static_cast<unsigned long>(numThreads) * numHandlers * numTicks;
+    }
+};
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned numThreads = 4;
+    unsigned numHandlers = 5000;
+    unsigned numTicks = 200;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        if (arg == "-threads") { numThreads = std::atoi(argv[i + 1]); }
+        else if (arg == "-handlers") { numHandlers = std::atoi(argv[i + 1]); }
+        else if (arg == "-ticks") { numTicks = std::atoi(argv[i + 1]); }
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (numThreads == 0 || numHandlers == 0)
+    {
+        std::cerr << "Error: -threads and -handlers must be positive" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        MessageBus::RegisterMainThread();
+        {
+            TransitWorkload transit(numThreads, numHandlers, numTicks);
+            transit.run();
+        }
+        {
+            MobilityServiceWorkload mobility(numThreads, numHandlers, numTicks);
+            mobility.run();
+        }
+        MessageBus::UnRegisterMainThread();
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,319 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/**
+ * \file PredayLogitBenchmark.cpp
+ * Micro-benchmark of a preday tour mode/destination model script, with the lua and the native logit functions.
+ *
+ * Loads logit.lua and the script of the model in two lua states, one of which gets the native calculate_probability,
+ * compute_mnl_logsum and compute_nl_logsum of behavioral/lua/LogitLuaFunctions.hpp, and times:
+ *  - compute_logsum_<model> and choose_<model> with each,
+ *  - calculate_probability and compute_mnl_logsum alone, on tables with as many alternatives as the model,
+ * so that the time spent in the logit functions can be told apart from the time spent computing the utilities
+ * (including the calls to the zone getters) in the script.
+ *
+ * The zone getters return values read from arrays, as those of TourModeDestinationParams do.
+ *
+ * Usage: SM_PredayLogitBenchmark [-scripts <dir>] [-model <name>] [-calls <n>]
+ *   -scripts : directory holding logit.lua and <model>.lua (default: scripts/lua/mid/behavior_vc)
+ *   -model   : tour mode/destination model to run: tmdw, tmds or tmdo (default: tmdw)
+ *   -calls   : number of calls of each function (default: 2000)
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/filesystem.hpp>
+
+#include "behavioral/lua/LogitLuaFunctions.hpp"
+#include "lua/LuaModel.hpp"
+
+using namespace sim_mob;
+using namespace luabridge;
+
+namespace
+{
+typedef boost::chrono::high_resolution_clock Clock;
+
+/**defines the logit calls timed alone; the tables are built by logit_benchmark_setup(numAlternatives)*/
+const char* LOGIT_SCRIPT =
+        "local choice, utility, availability = {}, {}, {}\n"
+        "function logit_benchmark_setup(n)\n"
+        "    for i = 1, n do\n"
+        "        choice[i] = i\n"
+        "        utility[i] = ((i * 37) % 101) / 25 - 2\n"
+        "        availability[i] = (i % 7 ~= 0) and 1 or 0\n"
+        "    end\n"
+        "    return n\n"
+        "end\n"
+        "function logit_benchmark_probability()\n"
+        "    calculate_probability(\"mnl\", choice, utility, availability, 1)\n"
+        "    return 0\n"
+        "end\n"
+        "function logit_benchmark_logsum()\n"
+        "    return compute_mnl_logsum(utility, availability)\n"
+        "end\n";
+
+/**the attributes of the person read by the tour mode/destination scripts*/
+class BenchmarkPersonParams
+{
+public:
+    int getFemaleDummy() const
+    {
+        return 1;
+    }
+
+    int getIncomeId() const
+    {
+        return 5;
+    }
+
+    int getVehicleOwnershipCategory() const
+    {
+        return 3;
+    }
+};
+
+/**the zone values of a tour mode/destination model, read from arrays as in TourModeDestinationParams*/
+class BenchmarkZoneParams
+{
+public:
+    BenchmarkZoneParams() : values(97), numGetterCalls(0), numAlternatives(0)
+    {
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] = 0.5 + (i * 37 % 97) / 10.0;
+        }
+    }
+
+    double getCostIncrease() const
+    {
+        return 0;
+    }
+
+    double getValue(int zone) const
+    {
+        ++numGetterCalls;
+        return values[(zone - 1) % values.size()];
+    }
+
+    int isAvailable(int choice) const
+    {
+        if (choice > numAlternatives)
+        {
+            numAlternatives = choice;
+        }
+        return (choice % 7) != 0;
+    }
+
+    std::vector<double> values;
+
+    /**number of calls to the zone getters, availability excluded*/
+    mutable unsigned long numGetterCalls;
+
+    /**the largest choice whose availability was asked for*/
+    mutable int numAlternatives;
+};
+
+class BenchmarkLuaModel : public lua::LuaModel
+{
+public:
+    explicit BenchmarkLuaModel(bool nativeLogit) : nativeLogit(nativeLogit)
+    {
+    }
+
+    double callLogsum(const std::string& model, BenchmarkPersonParams& person, BenchmarkZoneParams& zones) const
+    {
+        return call<double>(getFunction("compute_logsum_", model), &person, &zones);
+    }
+
+    int callChoose(const std::string& model, BenchmarkPersonParams& person, BenchmarkZoneParams& zones) const
+    {
+        return call<int>(getFunction("choose_", model), &person, &zones);
+    }
+
+    double callLogit(const std::string& name, int arg = 0) const
+    {
+        return getFunction(name)(arg).cast<double>();
+    }
+
+private:
+    void mapClasses()
+    {
+        getGlobalNamespace(state.get())
+                .beginClass<BenchmarkPersonParams>("BenchmarkPersonParams")
+                    .addProperty("female_dummy", &BenchmarkPersonParams::getFemaleDummy)
+                    .addProperty("income_id", &BenchmarkPersonParams::getIncomeId)
+                    .addProperty("vehicle_ownership_category", &BenchmarkPersonParams::getVehicleOwnershipCategory)
+                .endClass()
+
+                .beginClass<BenchmarkZoneParams>("BenchmarkZoneParams")
+                    .addProperty("cost_increase", &BenchmarkZoneParams::getCostIncrease)
+                    .addFunction("availability", &BenchmarkZoneParams::isAvailable)
+                    .addFunction("area", &BenchmarkZoneParams::getValue)
+                    .addFunction("average_transfer_number", &BenchmarkZoneParams::getValue)
+                    .addFunction("central_dummy", &BenchmarkZoneParams::getValue)
+                    .addFunction("cost_car_ERP_first", &BenchmarkZoneParams::getValue)
+                    .addFunction("cost_car_ERP_second", &BenchmarkZoneParams::getValue)
+                    .addFunction("cost_car_OP_first", &BenchmarkZoneParams::getValue)
+                    .addFunction("cost_car_OP_second", &BenchmarkZoneParams::getValue)
+                    .addFunction("cost_car_parking", &BenchmarkZoneParams::getValue)
+                    .addFunction("cost_public_first", &BenchmarkZoneParams::getValue)
+                    .addFunction("cost_public_second", &BenchmarkZoneParams::getValue)
+                    .addFunction("employment", &BenchmarkZoneParams::getValue)
+                    .addFunction("population", &BenchmarkZoneParams::getValue)
+                    .addFunction("shop", &BenchmarkZoneParams::getValue)
+                    .addFunction("tt_car_ivt_first", &BenchmarkZoneParams::getValue)
+                    .addFunction("tt_car_ivt_second", &BenchmarkZoneParams::getValue)
+                    .addFunction("tt_public_ivt_first", &BenchmarkZoneParams::getValue)
+                    .addFunction("tt_public_ivt_second", &BenchmarkZoneParams::getValue)
+                    .addFunction("tt_public_out_first", &BenchmarkZoneParams::getValue)
+                    .addFunction("tt_public_out_second", &BenchmarkZoneParams::getValue)
+                    .addFunction("walk_distance1", &BenchmarkZoneParams::getValue)
+                    .addFunction("walk_distance2", &BenchmarkZoneParams::getValue)
+                .endClass();
+    }
+
+    void mapNativeFunctions()
+    {
+        if (nativeLogit)
+        {
+            lua::registerNativeLogitFunctions(state.get());
+        }
+    }
+
+    bool nativeLogit;
+};
+
+double elapsedUs(const Clock::time_point& start, unsigned numCalls)
+{
+    return boost::chrono::duration_cast<boost::chrono::nanoseconds>(Clock::now() - start).count() / 1000.0 / numCalls;
+}
+
+struct Timings
+{
+    double logsum;
+    double choose;
+    double logitProbability;
+    double logitLogsum;
+};
+
+Timings run(BenchmarkLuaModel& model, const std::string& modelName, unsigned numCalls, int numAlternatives, double& logsum)
+{
+    BenchmarkPersonParams person;
+    BenchmarkZoneParams zones;
+    Timings timings;
+
+    Clock::time_point start = Clock::now();
+    for (unsigned i = 0; i < numCalls; ++i)
+    {
+        logsum = model.callLogsum(modelName, person, zones);
+    }
+    timings.logsum = elapsedUs(start, numCalls);
+
+    start = Clock::now();
+    for (unsigned i = 0; i < numCalls; ++i)
+    {
+        model.callChoose(modelName, person, zones);
+    }
+    timings.choose = elapsedUs(start, numCalls);
+
+    model.callLogit("logit_benchmark_setup", numAlternatives);
+    start = Clock::now();
+    for (unsigned i = 0; i < numCalls; ++i)
+    {
+        model.callLogit("logit_benchmark_probability");
+    }
+    timings.logitProbability = elapsedUs(start, numCalls);
+
+    start = Clock::now();
+    for (unsigned i = 0; i < numCalls; ++i)
+    {
+        model.callLogit("logit_benchmark_logsum");
+    }
+    timings.logitLogsum = elapsedUs(start, numCalls);
+    return timings;
+}
+
+void print(const std::string& variant, const Timings& timings)
+{
+    std::cout << variant << ": compute_logsum " << timings.logsum << " us (compute_mnl_logsum alone " << timings.logitLogsum
+              << " us), choose " << timings.choose << " us (calculate_probability alone " << timings.logitProbability << " us)"
+              << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    std::string scriptsDir = "scripts/lua/mid/behavior_vc";
+    std::string modelName = "tmdw";
+    unsigned numCalls = 2000;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        if (arg == "-scripts") { scriptsDir = argv[i + 1]; }
+        else if (arg == "-model") { modelName = argv[i + 1]; }
+        else if (arg == "-calls") { numCalls = std::atoi(argv[i + 1]); }
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    boost::filesystem::path logitScript = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("logit-benchmark-%%%%%%%%.lua");
+    try
+    {
+        {
+            std::ofstream out(logitScript.string().c_str());
+            out << LOGIT_SCRIPT;
+        }
+
+        BenchmarkLuaModel luaModel(false), nativeModel(true);
+        BenchmarkLuaModel* models[] = { &luaModel, &nativeModel };
+        for (size_t i = 0; i < 2; ++i)
+        {
+            models[i]->loadFile(scriptsDir + "/logit.lua");
+            models[i]->loadFile(scriptsDir + "/" + modelName + ".lua");
+            models[i]->loadFile(logitScript.string());
+            models[i]->initialize();
+        }
+
+        //one call to find the number of alternatives and of zone getter calls of the model
+        BenchmarkPersonParams person;
+        BenchmarkZoneParams zones;
+        luaModel.callLogsum(modelName, person, zones);
+        std::cout << modelName << ": " << zones.numAlternatives << " alternatives, " << zones.numGetterCalls
+                  << " zone getter calls per call" << std::endl;
+
+        double luaLogsum = 0, nativeLogsum = 0;
+        Timings luaTimings = run(luaModel, modelName, numCalls, zones.numAlternatives, luaLogsum);
+        Timings nativeTimings = run(nativeModel, modelName, numCalls, zones.numAlternatives, nativeLogsum);
+        print("lua logit   ", luaTimings);
+        print("native logit", nativeTimings);
+        std::cout << "utilities and availabilities (compute_logsum - compute_mnl_logsum, lua logit): "
+                  << luaTimings.logsum - luaTimings.logitLogsum << " us" << std::endl;
+
+        if (std::abs(luaLogsum - nativeLogsum) > 1e-9 * std::max(1.0, std::abs(luaLogsum)))
+        {
+            throw std::runtime_error("the lua and native logsums differ");
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        boost::filesystem::remove(logitScript);
+        return 1;
+    }
+
+    boost::filesystem::remove(logitScript);
+    return 0;
+}
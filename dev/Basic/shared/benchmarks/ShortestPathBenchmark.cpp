@@ -0,0 +1,407 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+/**
+ * \file ShortestPathBenchmark.cpp
+ * Micro-benchmark of the distance-based shortest path searches on a driving graph.
+ *
+ * Replays a list of ODs with:
+ *  - the allocating, exception-terminated boost::astar_search the driving path searches used before,
+ *  - A_StarSearchWorkspace::search (unidirectional), and
+ *  - A_StarSearchWorkspace::searchBidirectional, and
+ *  - ContractionHierarchy::query (after timing ContractionHierarchy::build),
+ * checks that all of them agree on the path costs and prints the time taken by each.
+ * It then times A_StarSearchWorkspace::searchOneToMany against one A* search per pair on a travel time matrix between
+ * the origins and the destinations of the first ODs.
+ *
+ * Usage: SM_ShortestPathBenchmark [-graph <file>] [-od <file>] [-record <file>] [-grid <n>] [-queries <n>] [-seed <n>]
+ *   -graph  : graph to search; lines "v <x> <y>" define vertices 0, 1, 2... and lines "e <from> <to> <length>" define edges.
+ *             If omitted, a <n> x <n> grid of two-way streets with jittered lengths is generated.
+ *   -od     : ODs to replay; one "<from> <to>" vertex pair per line. If omitted, random ODs are generated.
+ *   -record : writes the replayed ODs to a file, so that the same queries can be replayed later.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/graph/astar_search.hpp>
+#include <boost/random.hpp>
+
+#include "geospatial/streetdir/A_StarSearchWorkspace.hpp"
+#include "geospatial/streetdir/ContractionHierarchy.hpp"
+#include "geospatial/streetdir/StreetDirectory.hpp"
+
+using namespace sim_mob;
+
+namespace
+{
+typedef std::pair<StreetDirectory::Vertex, StreetDirectory::Vertex> VertexOD;
+typedef boost::chrono::high_resolution_clock Clock;
+
+struct BenchmarkGoal
+{
+};
+
+/**terminates boost::astar_search by throwing, like the original driving path searches*/
+class BenchmarkGoalVisitor : public boost::default_astar_visitor
+{
+public:
+    BenchmarkGoalVisitor(StreetDirectory::Vertex goal) : goal(goal)
+    {
+    }
+
+    template<class Graph>
+    void examine_vertex(StreetDirectory::Vertex u, const Graph& g)
+    {
+        if (u == goal)
+        {
+            throw BenchmarkGoal();
+        }
+    }
+
+private:
+    StreetDirectory::Vertex goal;
+};
+
+double euclideanDist(const Point& pt1, const Point& pt2)
+{
+    double dx = pt2.getX() - pt1.getX();
+    double dy = pt2.getY() - pt1.getY();
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+class EuclideanHeuristic : public boost::astar_heuristic<StreetDirectory::Graph, double>
+{
+public:
+    EuclideanHeuristic(const StreetDirectory::Graph* graph, StreetDirectory::Vertex goal) : graph(graph), goal(goal)
+    {
+    }
+
+    double operator()(StreetDirectory::Vertex v)
+    {
+        return euclideanDist(boost::get(boost::vertex_name, *graph, v), boost::get(boost::vertex_name, *graph, goal));
+    }
+
+private:
+    const StreetDirectory::Graph* graph;
+    StreetDirectory::Vertex goal;
+};
+
+void addEdge(StreetDirectory::Graph& graph, StreetDirectory::Vertex from, StreetDirectory::Vertex to, double length)
+{
+    StreetDirectory::Edge edge = boost::add_edge(from, to, graph).first;
+    boost::put(boost::edge_weight, graph, edge, length);
+}
+
+void loadGraph(const std::string& fileName, StreetDirectory::Graph& graph)
+{
+    std::ifstream in(fileName.c_str());
+    if (!in.good())
+    {
+        throw std::runtime_error("cannot open graph file " + fileName);
+    }
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        std::string type;
+        fields >> type;
+        if (type == "v")
+        {
+            double x, y;
+            fields >> x >> y;
+            StreetDirectory::Vertex v = boost::add_vertex(graph);
+            boost::put(boost::vertex_name, graph, v, Point(x, y));
+        }
+        else if (type == "e")
+        {
+            StreetDirectory::Vertex from, to;
+            double length;
+            fields >> from >> to >> length;
+            addEdge(graph, from, to, length);
+        }
+    }
+}
+
+void generateGrid(unsigned size, boost::mt19937& rng, StreetDirectory::Graph& graph)
+{
+    const double spacing = 100.0;
+    boost::uniform_real<> jitter(1.0, 1.5);
+    for (unsigned row = 0; row < size; ++row)
+    {
+        for (unsigned col = 0; col < size; ++col)
+        {
+            StreetDirectory::Vertex v = boost::add_vertex(graph);
+            boost::put(boost::vertex_name, graph, v, Point(col * spacing, row * spacing));
+        }
+    }
+
+    //edges are never shorter than the straight line, so that the euclidean heuristic stays admissible
+    for (unsigned row = 0; row < size; ++row)
+    {
+        for (unsigned col = 0; col < size; ++col)
+        {
+            StreetDirectory::Vertex v = row * size + col;
+            if (col + 1 < size)
+            {
+                addEdge(graph, v, v + 1, spacing * jitter(rng));
+                addEdge(graph, v + 1, v, spacing * jitter(rng));
+            }
+            if (row + 1 < size)
+            {
+                addEdge(graph, v, v + size, spacing * jitter(rng));
+                addEdge(graph, v + size, v, spacing * jitter(rng));
+            }
+        }
+    }
+}
+
+void loadODs(const std::string& fileName, std::vector<VertexOD>& ods)
+{
+    std::ifstream in(fileName.c_str());
+    if (!in.good())
+    {
+        throw std::runtime_error("cannot open OD file " + fileName);
+    }
+
+    VertexOD od;
+    while (in >> od.first >> od.second)
+    {
+        ods.push_back(od);
+    }
+}
+
+void generateODs(size_t numVertices, unsigned numQueries, boost::mt19937& rng, std::vector<VertexOD>& ods)
+{
+    boost::uniform_int<size_t> vertex(0, numVertices - 1);
+    while (ods.size() < numQueries)
+    {
+        VertexOD od(vertex(rng), vertex(rng));
+        if (od.first != od.second)
+        {
+            ods.push_back(od);
+        }
+    }
+}
+
+double pathCost(const StreetDirectory::Graph& graph, const std::vector<StreetDirectory::Edge>& path)
+{
+    double cost = 0.0;
+    for (std::vector<StreetDirectory::Edge>::const_iterator it = path.begin(); it != path.end(); ++it)
+    {
+        cost += boost::get(boost::edge_weight, graph, *it);
+    }
+    return cost;
+}
+
+/**@return the path cost found by boost::astar_search; -1 if unreachable*/
+double legacySearch(const StreetDirectory::Graph& graph, const VertexOD& od)
+{
+    std::vector<StreetDirectory::Vertex> p(boost::num_vertices(graph));
+    std::vector<double> d(boost::num_vertices(graph));
+    try
+    {
+        boost::astar_search(graph, od.first, EuclideanHeuristic(&graph, od.second),
+                            boost::predecessor_map(&p[0]).distance_map(&d[0]).visitor(BenchmarkGoalVisitor(od.second)));
+    }
+    catch (BenchmarkGoal&)
+    {
+        return d[od.second];
+    }
+    return -1.0;
+}
+
+double elapsedMs(const Clock::time_point& start)
+{
+    return boost::chrono::duration_cast<boost::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    std::string graphFile, odFile, recordFile;
+    unsigned gridSize = 200;
+    unsigned numQueries = 1000;
+    unsigned seed = 42;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        if (arg == "-graph") { graphFile = argv[i + 1]; }
+        else if (arg == "-od") { odFile = argv[i + 1]; }
+        else if (arg == "-record") { recordFile = argv[i + 1]; }
+        else if (arg == "-grid") { gridSize = std::atoi(argv[i + 1]); }
+        else if (arg == "-queries") { numQueries = std::atoi(argv[i + 1]); }
+        else if (arg == "-seed") { seed = std::atoi(argv[i + 1]); }
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    try
+    {
+        boost::mt19937 rng(seed);
+        StreetDirectory::Graph graph;
+        if (graphFile.empty())
+        {
+            generateGrid(gridSize, rng, graph);
+        }
+        else
+        {
+            loadGraph(graphFile, graph);
+        }
+
+        std::vector<VertexOD> ods;
+        if (odFile.empty())
+        {
+            generateODs(boost::num_vertices(graph), numQueries, rng, ods);
+        }
+        else
+        {
+            loadODs(odFile, ods);
+        }
+
+        if (!recordFile.empty())
+        {
+            std::ofstream out(recordFile.c_str());
+            for (std::vector<VertexOD>::const_iterator it = ods.begin(); it != ods.end(); ++it)
+            {
+                out << it->first << " " << it->second << "\n";
+            }
+        }
+
+        std::cout << "graph: " << boost::num_vertices(graph) << " vertices, " << boost::num_edges(graph) << " edges; "
+                  << ods.size() << " ODs" << std::endl;
+
+        ReverseAdjacency reverse;
+        reverse.build(graph);
+        A_StarSearchWorkspace& workspace = A_StarSearchWorkspace::getThreadWorkspace();
+        std::vector<StreetDirectory::Edge> path;
+        std::vector<double> legacyCosts, workspaceCosts, bidirectionalCosts, hierarchyCosts;
+        legacyCosts.reserve(ods.size());
+        workspaceCosts.reserve(ods.size());
+        bidirectionalCosts.reserve(ods.size());
+        hierarchyCosts.reserve(ods.size());
+
+        Clock::time_point start = Clock::now();
+        for (std::vector<VertexOD>::const_iterator it = ods.begin(); it != ods.end(); ++it)
+        {
+            legacyCosts.push_back(legacySearch(graph, *it));
+        }
+        double legacyMs = elapsedMs(start);
+
+        start = Clock::now();
+        for (std::vector<VertexOD>::const_iterator it = ods.begin(); it != ods.end(); ++it)
+        {
+            bool found = workspace.search(graph, it->first, it->second, EuclideanHeuristic(&graph, it->second), path);
+            workspaceCosts.push_back(found ? pathCost(graph, path) : -1.0);
+        }
+        double workspaceMs = elapsedMs(start);
+
+        start = Clock::now();
+        for (std::vector<VertexOD>::const_iterator it = ods.begin(); it != ods.end(); ++it)
+        {
+            bool found = workspace.searchBidirectional(graph, reverse, AllEdgesConstraint(), it->first, it->second, path);
+            bidirectionalCosts.push_back(found ? pathCost(graph, path) : -1.0);
+        }
+        double bidirectionalMs = elapsedMs(start);
+
+        ContractionHierarchy hierarchy;
+        start = Clock::now();
+        hierarchy.build(graph);
+        double hierarchyBuildMs = elapsedMs(start);
+
+        start = Clock::now();
+        for (std::vector<VertexOD>::const_iterator it = ods.begin(); it != ods.end(); ++it)
+        {
+            double cost;
+            bool found = hierarchy.query(it->first, it->second, path, cost);
+            hierarchyCosts.push_back(found ? pathCost(graph, path) : -1.0);
+        }
+        double hierarchyMs = elapsedMs(start);
+
+        unsigned mismatches = 0;
+        for (size_t i = 0; i < ods.size(); ++i)
+        {
+            double tolerance = 1e-6 * std::max(1.0, legacyCosts[i]);
+            if (std::fabs(legacyCosts[i] - workspaceCosts[i]) > tolerance || std::fabs(legacyCosts[i] - bidirectionalCosts[i]) > tolerance
+                    || std::fabs(legacyCosts[i] - hierarchyCosts[i]) > tolerance)
+            {
+                ++mismatches;
+                std::cerr << "cost mismatch for OD " << ods[i].first << "-" << ods[i].second << ": " << legacyCosts[i] << " (boost), "
+                          << workspaceCosts[i] << " (workspace), " << bidirectionalCosts[i] << " (bidirectional), "
+                          << hierarchyCosts[i] << " (contraction hierarchy)" << std::endl;
+            }
+        }
+
+        //travel time matrix: one search per origin vs one search per pair
+        const size_t matrixSize = std::min<size_t>(ods.size(), 50);
+        std::vector<StreetDirectory::Vertex> matrixTargets;
+        for (size_t i = 0; i < matrixSize; ++i)
+        {
+            matrixTargets.push_back(ods[i].second);
+        }
+        std::vector<std::vector<StreetDirectory::Edge> > paths;
+        std::vector<double> oneToManyCosts, pairCosts;
+
+        start = Clock::now();
+        for (size_t i = 0; i < matrixSize; ++i)
+        {
+            workspace.searchOneToMany(graph, ods[i].first, matrixTargets, paths);
+            for (size_t j = 0; j < matrixSize; ++j)
+            {
+                oneToManyCosts.push_back(paths[j].empty() && ods[i].first != matrixTargets[j] ? -1.0 : pathCost(graph, paths[j]));
+            }
+        }
+        double oneToManyMs = elapsedMs(start);
+
+        start = Clock::now();
+        for (size_t i = 0; i < matrixSize; ++i)
+        {
+            for (size_t j = 0; j < matrixSize; ++j)
+            {
+                bool found = workspace.search(graph, ods[i].first, matrixTargets[j], EuclideanHeuristic(&graph, matrixTargets[j]), path);
+                pairCosts.push_back(found ? pathCost(graph, path) : -1.0);
+            }
+        }
+        double pairMs = elapsedMs(start);
+
+        for (size_t i = 0; i < pairCosts.size(); ++i)
+        {
+            if (std::fabs(pairCosts[i] - oneToManyCosts[i]) > 1e-6 * std::max(1.0, pairCosts[i]))
+            {
+                ++mismatches;
+                std::cerr << "cost mismatch in the travel time matrix at " << i / matrixSize << "," << i % matrixSize << ": "
+                          << pairCosts[i] << " (A* per pair), " << oneToManyCosts[i] << " (one-to-many)" << std::endl;
+            }
+        }
+
+        const double usPerQuery = 1000.0 / std::max<size_t>(ods.size(), 1);
+        std::cout << "boost::astar_search     : " << legacyMs << " ms (" << legacyMs * usPerQuery << " us/query)\n"
+                  << "workspace A*            : " << workspaceMs << " ms (" << workspaceMs * usPerQuery << " us/query)\n"
+                  << "workspace bidirectional : " << bidirectionalMs << " ms (" << bidirectionalMs * usPerQuery << " us/query)\n"
+                  << "contraction hierarchy   : " << hierarchyMs << " ms (" << hierarchyMs * usPerQuery << " us/query; build: "
+                  << hierarchyBuildMs << " ms, "
+                  << hierarchy.getNumShortcuts() << " shortcuts)\n"
+                  << matrixSize << "x" << matrixSize << " matrix, A* per pair : " << pairMs << " ms\n"
+                  << matrixSize << "x" << matrixSize << " matrix, one-to-many : " << oneToManyMs << " ms\n"
+                  << mismatches << " cost mismatches" << std::endl;
+        return (mismatches == 0 ? 0 : 2);
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}
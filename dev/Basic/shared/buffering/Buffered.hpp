@@ -5,6 +5,8 @@
 #pragma once
 
 
+#include <boost/atomic.hpp>
+
 #include "BufferedDataManager.hpp"
 
 
@@ -55,7 +57,8 @@ public:
      *
      * \param value The initial value. You can also set an initial value using "force".
      */
-    explicit Buffered (const T& value = T()) : BufferedBase(), current_ (value), next_ (value) {}
+    explicit Buffered (const T& value = T()) : BufferedBase(), current_ (value), next_ (value),
+        currentPtr_(&current_), nextPtr_(&next_), pool_(nullptr), slot_(0) {}
     virtual ~Buffered() {}
 
 
@@ -64,7 +67,7 @@ public:
      * also be thought of as being one flip "behind" the actual value.
      */
     const T& get() const {
-        return current_;
+        return currentRef();
     }
 
     /**
@@ -72,7 +75,7 @@ public:
      * only take effect when "flip" is called.
      */
     void set (const T& value) {
-        next_ = value;
+        nextRef() = value;
     }
 
 
@@ -117,7 +120,7 @@ public:
      */
     operator T() const
     {
-        return current_;
+        return currentRef();
     }
 
     /**
@@ -125,18 +128,61 @@ public:
      * This is usually only needed when loading values from a config file.
      */
     void force(const T& value) {
-        next_ = current_ = value;
+        nextRef() = currentRef() = value;
     }
 
 
 protected:
     void flip() {
-        current_ = next_;
+        currentRef() = nextRef();
+    }
+
+    bool moveToArena() {
+        BufferedPool<T>& pool = getArena()->template getPool<T>();
+        slot_ = pool.allocate(this, current_, next_);
+        pool_ = &pool;
+        nextPtr_ = &pool.next(slot_);
+        currentPtr_.store(&pool.current(slot_), boost::memory_order_release);
+        return true;
+    }
+
+    ///Readers switch back to current_ before the slot is released; the pool keeps its values until the next flip.
+    void moveFromArena() {
+        current_ = pool_->current(slot_);
+        next_ = pool_->next(slot_);
+        nextPtr_ = &next_;
+        currentPtr_.store(&current_, boost::memory_order_release);
+        BufferedPool<T>* pool = pool_;
+        pool_ = nullptr;
+        pool->release(slot_);
+    }
+
+    ///The current value; held by the pool of the BufferedDataManager's arena while managed.
+    const T& currentRef() const {
+        return *currentPtr_.load(boost::memory_order_acquire);
+    }
+
+    T& currentRef() {
+        return *currentPtr_.load(boost::memory_order_acquire);
+    }
+
+    ///The next value; held by the pool of the BufferedDataManager's arena while managed. Only used by the writer.
+    T& nextRef() {
+        return *nextPtr_;
     }
 
     T current_;
     T next_;
 
+    ///Where the values are: current_ and next_, or a slot of the pool. Readers on other threads only follow
+    ///currentPtr_, which keeps pointing to a live value while the datum moves in and out of the pool.
+    boost::atomic<T*> currentPtr_;
+    T* nextPtr_;
+
+    ///Pool and slot holding the values; nullptr if current_ and next_ hold them.
+    BufferedPool<T>* pool_;
+    size_t slot_;
+
 };
 
 }
@@ -0,0 +1,75 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "BufferedArena.hpp"
+
+#include "BufferedDataManager.hpp"
+
+using namespace sim_mob;
+using std::vector;
+
+
+sim_mob::BufferedArena::~BufferedArena()
+{
+    //Give the values back to the data which are still here.
+    vector<BufferedBase*> data = getData();
+    for (vector<BufferedBase*>::iterator it=data.begin(); it!=data.end(); it++) {
+        remove(*it);
+    }
+
+    for (vector<BufferedPoolBase*>::iterator it=pools.begin(); it!=pools.end(); it++) {
+        delete *it;
+    }
+}
+
+bool sim_mob::BufferedArena::add(BufferedBase* datum)
+{
+    if (datum->arena == this || unpooled.find(datum) != unpooled.end()) {
+        return false;
+    }
+
+    //A datum pooled by another arena keeps its values there; we flip it through its own flip().
+    if (!datum->arena) {
+        datum->arena = this;
+        if (datum->moveToArena()) {
+            numPooled++;
+            return true;
+        }
+        datum->arena = nullptr;
+    }
+    unpooled.insert(datum);
+    return true;
+}
+
+bool sim_mob::BufferedArena::remove(BufferedBase* datum)
+{
+    if (datum->arena == this) {
+        datum->moveFromArena();
+        datum->arena = nullptr;
+        numPooled--;
+        return true;
+    }
+    return unpooled.erase(datum) > 0;
+}
+
+void sim_mob::BufferedArena::flip()
+{
+    for (vector<BufferedPoolBase*>::iterator it=pools.begin(); it!=pools.end(); it++) {
+        (*it)->flip();
+    }
+    for (std::set<BufferedBase*>::iterator it=unpooled.begin(); it!=unpooled.end(); it++) {
+        (*it)->flip();
+    }
+}
+
+vector<BufferedBase*> sim_mob::BufferedArena::getData() const
+{
+    vector<BufferedBase*> data;
+    data.reserve(size());
+    for (vector<BufferedPoolBase*>::const_iterator it=pools.begin(); it!=pools.end(); it++) {
+        (*it)->getOwners(data);
+    }
+    data.insert(data.end(), unpooled.begin(), unpooled.end());
+    return data;
+}
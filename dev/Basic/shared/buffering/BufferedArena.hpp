@@ -0,0 +1,220 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <algorithm>
+#include <set>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace sim_mob
+{
+
+class BufferedBase;
+
+/**
+ * Base class of the pools of a BufferedArena; one per value type.
+ */
+class BufferedPoolBase : private boost::noncopyable
+{
+public:
+    virtual ~BufferedPoolBase() {}
+
+    ///Copy the next values over the current values of all the slots, and free the slots released since the last flip.
+    virtual void flip() = 0;
+
+    ///Append the data whose values are stored in this pool to data.
+    virtual void getOwners(std::vector<BufferedBase*>& data) const = 0;
+};
+
+/**
+ * Current and next values of the buffered data of type T managed by a BufferedArena.
+ *
+ * Values are stored in blocks of BLOCK_SIZE slots, the current values of a block followed by its next values, so
+ * flipping a block is a single copy of a contiguous range (a memmove for trivially copyable types). Blocks are never
+ * moved nor freed while the pool lives, so a slot has stable addresses: data keep pointers to their values and readers
+ * never look up the pool, which may grow while they read. Data start and stop being managed during the update phase,
+ * while other threads read them, so a released slot is only retired: its values stay untouched until the next flip,
+ * which resets the slot and makes it available to later allocations. Slots are reused rather than compacted.
+ */
+template <typename T>
+class BufferedPool : public BufferedPoolBase
+{
+public:
+    BufferedPool() : used(0) {}
+
+    virtual ~BufferedPool()
+    {
+        for (typename std::vector<Block*>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+            delete *it;
+        }
+    }
+
+    ///Take a slot for owner, with the given values. Returns the slot; its addresses never change.
+    size_t allocate(BufferedBase* owner, const T& currentValue, const T& nextValue)
+    {
+        size_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (used == blocks.size() * BLOCK_SIZE) {
+                blocks.push_back(new Block());
+            }
+            slot = used++;
+        }
+
+        current(slot) = currentValue;
+        next(slot) = nextValue;
+        blocks[slot / BLOCK_SIZE]->owners[slot % BLOCK_SIZE] = owner;
+        return slot;
+    }
+
+    /**
+     * Give a slot back. Readers which fetched its current value before the release may still be reading it, so the
+     * slot keeps its values until the next flip, which resets them (releasing the resources held by them) and frees
+     * the slot.
+     */
+    void release(size_t slot)
+    {
+        blocks[slot / BLOCK_SIZE]->owners[slot % BLOCK_SIZE] = nullptr;
+        retiredSlots.push_back(slot);
+    }
+
+    T& current(size_t slot)
+    {
+        return blocks[slot / BLOCK_SIZE]->current[slot % BLOCK_SIZE];
+    }
+
+    T& next(size_t slot)
+    {
+        return blocks[slot / BLOCK_SIZE]->next[slot % BLOCK_SIZE];
+    }
+
+    virtual void flip()
+    {
+        for (std::vector<size_t>::const_iterator it = retiredSlots.begin(); it != retiredSlots.end(); ++it) {
+            current(*it) = T();
+            next(*it) = T();
+            freeSlots.push_back(*it);
+        }
+        retiredSlots.clear();
+
+        //Free slots are copied too; it is cheaper than skipping them.
+        size_t remaining = used;
+        for (typename std::vector<Block*>::iterator it = blocks.begin(); it != blocks.end() && remaining > 0; ++it) {
+            const size_t count = (remaining < BLOCK_SIZE ? remaining : BLOCK_SIZE);
+            std::copy((*it)->next, (*it)->next + count, (*it)->current);
+            remaining -= count;
+        }
+    }
+
+    virtual void getOwners(std::vector<BufferedBase*>& data) const
+    {
+        for (size_t slot = 0; slot < used; ++slot) {
+            BufferedBase* owner = blocks[slot / BLOCK_SIZE]->owners[slot % BLOCK_SIZE];
+            if (owner) {
+                data.push_back(owner);
+            }
+        }
+    }
+
+private:
+    static const size_t BLOCK_SIZE = 256;
+
+    struct Block
+    {
+        Block() : owners() {}
+
+        T current[BLOCK_SIZE];
+        T next[BLOCK_SIZE];
+        BufferedBase* owners[BLOCK_SIZE];
+    };
+
+    std::vector<Block*> blocks;
+
+    ///Number of slots ever taken; slots beyond it have never been used.
+    size_t used;
+
+    ///Slots which may be allocated again.
+    std::vector<size_t> freeSlots;
+
+    ///Slots released since the last flip.
+    std::vector<size_t> retiredSlots;
+};
+
+/**
+ * Storage of the buffered data managed by a BufferedDataManager.
+ *
+ * \author Seth N. Hetu (original BufferedDataManager)
+ *
+ * The values of the data are moved into one BufferedPool per value type when they are added, so flip() runs one copy
+ * per block of values instead of one virtual call per datum, and adding or removing a datum takes constant time. Data
+ * which cannot be pooled (Locked<>, Shared<> with locking, or data already pooled by another arena) are kept in a set
+ * and flipped one by one, as they were before.
+ */
+class BufferedArena : private boost::noncopyable
+{
+public:
+    BufferedArena() : numPooled(0) {}
+
+    ~BufferedArena();
+
+    ///Add a datum. Returns false if it was already there.
+    bool add(BufferedBase* datum);
+
+    ///Remove a datum. Returns false if it was not there.
+    bool remove(BufferedBase* datum);
+
+    ///Update the current value of all the data.
+    void flip();
+
+    ///Number of data in the arena.
+    size_t size() const
+    {
+        return numPooled + unpooled.size();
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    ///Retrieve all the data in the arena.
+    std::vector<BufferedBase*> getData() const;
+
+    ///Return the pool for values of type T, creating it if needed.
+    template <typename T>
+    BufferedPool<T>& getPool()
+    {
+        const std::type_index type(typeid(T));
+        std::unordered_map<std::type_index, size_t>::const_iterator it = poolIndices.find(type);
+        if (it != poolIndices.end()) {
+            return *static_cast<BufferedPool<T>*>(pools[it->second]);
+        }
+
+        BufferedPool<T>* pool = new BufferedPool<T>();
+        poolIndices.insert(std::make_pair(type, pools.size()));
+        pools.push_back(pool);
+        return *pool;
+    }
+
+private:
+    ///One pool per value type, in order of creation.
+    std::vector<BufferedPoolBase*> pools;
+    std::unordered_map<std::type_index, size_t> poolIndices;
+
+    ///Number of data whose values are in the pools.
+    size_t numPooled;
+
+    ///Data flipped through BufferedBase::flip().
+    std::set<BufferedBase*> unpooled;
+};
+
+}
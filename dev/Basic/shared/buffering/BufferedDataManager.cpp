@@ -19,8 +19,9 @@ sim_mob::BufferedBase::~BufferedBase() {
 sim_mob::BufferedDataManager::~BufferedDataManager()
 {
     //Stop managing all items
-    while (managedData.begin() != managedData.end()) {
-        stopManaging(*managedData.begin());
+    vector<BufferedBase*> data = managedData.getData();
+    for (vector<BufferedBase*>::iterator it=data.begin(); it!=data.end(); it++) {
+        stopManaging(*it);
     }
 }
 
@@ -29,10 +30,7 @@ sim_mob::BufferedDataManager::~BufferedDataManager()
 void sim_mob::BufferedDataManager::beginManaging(BufferedBase* datum)
 {
     //Only add if we're not managing it already.
-    std::set<BufferedBase*>::iterator it = managedData.find(datum);
-    if (it==managedData.end()) {
-        managedData.insert(datum);
-
+    if (managedData.add(datum)) {
         //Helps with debugging.
         datum->refCount++;
     }
@@ -41,10 +39,7 @@ void sim_mob::BufferedDataManager::beginManaging(BufferedBase* datum)
 void sim_mob::BufferedDataManager::stopManaging(BufferedBase* datum)
 {
     //Only remove if we are actually managing it.
-    std::set<BufferedBase*>::iterator it = managedData.find(datum);
-    if (it!=managedData.end()) {
-        managedData.erase(it);
-
+    if (managedData.remove(datum)) {
         //Helps with debugging.
         datum->refCount--;
     }
@@ -67,9 +62,7 @@ void sim_mob::BufferedDataManager::stopManaging(vector<BufferedBase*> data)
 
 void sim_mob::BufferedDataManager::flip()
 {
-    for (std::set<BufferedBase*>::iterator it=managedData.begin(); it!=managedData.end(); it++) {
-        (*it)->flip();
-    }
+    managedData.flip();
 }
 
 
@@ -8,6 +8,8 @@
 #include <vector>
 #include <boost/noncopyable.hpp>
 
+#include "BufferedArena.hpp"
+
 namespace sim_mob
 {
 
@@ -41,7 +43,7 @@ class BufferedDataManager;
 class BufferedBase : private boost::noncopyable
 {
 protected:
-    BufferedBase() : refCount(0) {}
+    BufferedBase() : refCount(0), arena(nullptr) {}
     virtual ~BufferedBase();
 
     /**
@@ -51,13 +53,31 @@ protected:
      */
     virtual void flip() = 0;
 
-    //Allow access to protected methods by BufferedDataManager.
+    /**
+     * Move the current and next values into a pool of getArena(), which flips them from then on. Returns false if
+     * the values cannot be pooled; the datum is then flipped through flip().
+     */
+    virtual bool moveToArena() { return false; }
+
+    /**
+     * Move the current and next values back from the arena into this object.
+     */
+    virtual void moveFromArena() {}
+
+    ///The arena pooling the values of this datum; nullptr if it holds them itself.
+    BufferedArena* getArena() const { return arena; }
+
+    //Allow access to protected methods by BufferedDataManager and BufferedArena.
     friend class BufferedDataManager;
+    friend class BufferedArena;
 
 private:
     ///Count of BufferedDataManagers accessing this Buffered type.
     ///Helps catch harder-to-debug errors further down the line.
     unsigned int refCount;
+
+    ///Arena holding the values of this datum; nullptr if it holds them itself.
+    BufferedArena* arena;
 };
 
 
@@ -66,16 +86,9 @@ private:
  * updates their current values each time flip() is called. Calling flip() multiple times
  * in a row (without calling each datum's "set()" method in between) has undefined behavior.
  *
- * \todo
- * It seems sensible to have beginManaging() add the datum to a static array of raw "data", using
- * the "size" of the buffered type. The next_ and current_ values can then be represented by two
- * large static arrays, which can be flipped with a single pointer swap. Care should be taken to
- * update the arrays when they grow too big. In addition, internal segmentation will develop
- * when an item is removed through a call to stopManaging(). So, it's not a trivial feature, but
- * then again there's plenty of existing research (for dealing with general memory allocation).
- *
- * \par
- * ~Seth
+ * The values of the managed data are stored in a BufferedArena, contiguously by type, so flip() copies
+ * blocks of values rather than calling each datum's flip(). A pointer swap is not possible, since
+ * some data (e.g., Buffered_uint32) build the next value on top of the previous one.
  */
 class BufferedDataManager
 {
@@ -97,7 +110,7 @@ public:
 
 
 protected:
-    std::set<BufferedBase*> managedData;
+    BufferedArena managedData;
 };
 
 
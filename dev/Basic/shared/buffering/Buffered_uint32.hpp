@@ -40,7 +40,7 @@ public:
      */
     void operator++()
     {
-        ++next_;
+        ++nextRef();
     }
 
     /**
@@ -51,7 +51,7 @@ public:
      */
     void operator++(int)
     {
-        ++next_;
+        ++nextRef();
     }
 
     /**
@@ -62,7 +62,7 @@ public:
      */
     void operator--()
     {
-        --next_;
+        --nextRef();
     }
 
     /**
@@ -73,7 +73,7 @@ public:
      */
     void operator--(int)
     {
-        --next_;
+        --nextRef();
     }
 
     /**
@@ -84,7 +84,7 @@ public:
      */
     void operator+=(int delta)
     {
-        next_ += delta;
+        nextRef() += delta;
     }
 
     /**
@@ -95,7 +95,7 @@ public:
      */
     void operator-=(int delta)
     {
-        next_ -= delta;
+        nextRef() -= delta;
     }
 };
 
@@ -6,6 +6,7 @@
 
 #include "BufferedDataManager.hpp"
 
+#include <boost/atomic.hpp>
 #include <boost/thread.hpp>
 
 
@@ -69,7 +70,8 @@ public:
      * \param value The initial value. You can also set an initial value using "force".
      */
     Shared (const sim_mob::MutexStrategy& mtxStrategy, const T& value = T()) : BufferedBase(),
-        current_ (value), strategy_(mtxStrategy), next_ (value) {}
+        current_ (value), strategy_(mtxStrategy), next_ (value), currentPtr_(&current_), nextPtr_(&next_),
+        pool_(nullptr), slot_(0) {}
     virtual ~Shared() {}
 
 
@@ -85,7 +87,7 @@ public:
             boost::shared_lock<boost::shared_mutex> lock_(mutex_);
             return current_;
         }*/
-        return current_;
+        return currentRef();
     }
 
     T& getRW() {
@@ -96,7 +98,7 @@ public:
             boost::shared_lock<boost::shared_mutex> lock_(mutex_);
             return current_;
         }*/
-        return current_;
+        return currentRef();
     }
 
 
@@ -112,7 +114,7 @@ public:
         } else if (strategy_==MtxStrat_Buffered) {
             next_ = value;
         }*/
-        next_ = value;
+        nextRef() = value;
     }
 
 
@@ -168,17 +170,55 @@ public:
      * Note that calling this function is inherently unsafe in a parallel environment.
      */
     void force(const T& value) {
-        current_ = value;
+        currentRef() = value;
         if (strategy_==MtxStrat_Buffered) {
-            next_ = value;
+            nextRef() = value;
         }
     }
 
 protected:
     void flip() {
         if (strategy_==MtxStrat_Buffered) {
-            current_ = next_;
+            currentRef() = nextRef();
+        }
+    }
+
+    ///Only buffered values are pooled; locked values are never flipped.
+    bool moveToArena() {
+        if (strategy_!=MtxStrat_Buffered) {
+            return false;
         }
+        BufferedPool<T>& pool = getArena()->template getPool<T>();
+        slot_ = pool.allocate(this, current_, next_);
+        pool_ = &pool;
+        nextPtr_ = &pool.next(slot_);
+        currentPtr_.store(&pool.current(slot_), boost::memory_order_release);
+        return true;
+    }
+
+    ///Readers switch back to current_ before the slot is released; the pool keeps its values until the next flip.
+    void moveFromArena() {
+        current_ = pool_->current(slot_);
+        next_ = pool_->next(slot_);
+        nextPtr_ = &next_;
+        currentPtr_.store(&current_, boost::memory_order_release);
+        BufferedPool<T>* pool = pool_;
+        pool_ = nullptr;
+        pool->release(slot_);
+    }
+
+    ///The current value; held by the pool of the BufferedDataManager's arena while managed.
+    const T& currentRef() const {
+        return *currentPtr_.load(boost::memory_order_acquire);
+    }
+
+    T& currentRef() {
+        return *currentPtr_.load(boost::memory_order_acquire);
+    }
+
+    ///The next value; held by the pool of the BufferedDataManager's arena while managed. Only used by the writer.
+    T& nextRef() {
+        return *nextPtr_;
     }
 
     //Used by both
@@ -194,6 +234,16 @@ protected:
     // Used by Locked
     mutable boost::shared_mutex mutex_;
 
+    //Where the values are: current_ and next_, or a slot of the pool while managed. Readers on other
+    // threads only follow currentPtr_, which keeps pointing to a live value while the datum moves.
+    boost::atomic<T*> currentPtr_;
+    T* nextPtr_;
+
+    //Pool and slot holding the values while managed; nullptr if current_ and next_ hold them.
+    // Used by Buffered
+    BufferedPool<T>* pool_;
+    size_t slot_;
+
 
 };
 
@@ -33,10 +33,14 @@ WorkGroup::ASSIGNMENT_STRATEGY ParseWrkGrpAssignEnum(const XMLCh *srcX, WorkGrou
 		{
 			return WorkGroup::ASSIGN_SMALLEST;
 		}
+		else if (src == "timebased")
+		{
+			return WorkGroup::ASSIGN_TIMEBASED;
+		}
 
 		stringstream msg;
 		msg << "Invalid value for \'workgroup_assignment\': \"" << src
-		    << "\". Expected: \"roundrobin\" or \"smallest\"";
+		    << "\". Expected: \"roundrobin\", \"smallest\" or \"timebased\"";
 		throw runtime_error(msg.str());
 	}
 
@@ -332,6 +336,21 @@ void ParseConfigFile::processLongTermParamsNode(xercesc::DOMElement *node)
 	processDeveloperModelNode(GetSingleElementByName(node, "developerModel"));
 	processHousingModelNode(GetSingleElementByName(node, "housingModel"));
 	processHouseHoldLogsumsNode(GetSingleElementByName(node, "outputHouseholdLogsums"));
+
+	LongTermParams::LogsumCache logsumCache;
+	DOMElement* logsumCacheNode = GetSingleElementByName(node, "logsumCache");
+
+	logsumCache.enabled =
+			ParseBoolean(GetNamedAttributeValue(logsumCacheNode, "enabled"), false);
+
+	logsumCache.capacity =
+			ParseUnsignedInt(GetNamedAttributeValue(logsumCacheNode, "capacity"), logsumCache.capacity);
+
+	logsumCache.file =
+			ParseString(GetNamedAttributeValue(logsumCacheNode, "file"), logsumCache.file);
+
+	cfg.ltParams.logsumCache = logsumCache;
+
 	processVehicleOwnershipModelNode(GetSingleElementByName(node, "vehicleOwnershipModel"));
 
 	LongTermParams::TaxiAccessModel taxiAccessModel;
@@ -656,6 +675,14 @@ void ParseConfigFile::processHousingModelNode(xercesc::DOMElement *houseModel)
 			ParseInteger(GetNamedAttributeValue(GetSingleElementByName(
 					houseModel, "offsetBetweenUnitBuyingAndSellingAdvancedPurchase"), "value"), (int) 0);
 
+	housingModel.deterministicMarket =
+			ParseBoolean(GetNamedAttributeValue(GetSingleElementByName(
+					houseModel, "deterministicMarket"), "value"), false);
+
+	housingModel.marketSeed =
+			ParseUnsignedInt(GetNamedAttributeValue(GetSingleElementByName(
+					houseModel, "deterministicMarket"), "seed"), (unsigned int) 0);
+
 	housingModel.awakeningModel.awakeningOffMarketSuccessfulBid =
 			ParseInteger(GetNamedAttributeValue(GetSingleElementByName(GetSingleElementByName(
 					houseModel, "awakeningModel"), "awakeningOffMarketSuccessfulBid"), "value"), (int) 0);
@@ -765,6 +792,7 @@ void ParseConfigFile::processSimulationNode(xercesc::DOMElement *node)
 			processInSimulationTTUsage(GetSingleElementByName(node, "in_simulation_travel_time_usage", true));
 
 	processWorkgroupAssignmentNode(GetSingleElementByName(node, "workgroup_assignment"));
+	processWorkStealingNode(GetSingleElementByName(node, "work_stealing"));
 	processOperationalCostNode(GetSingleElementByName(node, "operational_cost")) ;
 	processMutexEnforcementNode(GetSingleElementByName(node, "mutex_enforcement"));
 	processClosedLoopPropertiesNode(GetSingleElementByName(node, "closed_loop"));
@@ -824,6 +852,12 @@ void ParseConfigFile::processWorkgroupAssignmentNode(xercesc::DOMElement *node)
 {
 	cfg.simulation.workGroupAssigmentStrategy = ParseWrkGrpAssignEnum(GetNamedAttributeValue(node, "value"),
 	                                                                  WorkGroup::ASSIGN_SMALLEST);
+	cfg.simulation.workGroupRebalanceInterval = ParseUnsignedInt(GetNamedAttributeValue(node, "rebalance_interval", false), 100);
+}
+
+void ParseConfigFile::processWorkStealingNode(xercesc::DOMElement *node)
+{
+	cfg.simulation.workStealing = ParseBoolean(GetNamedAttributeValue(node, "value"), false);
 }
 
 void ParseConfigFile::processOperationalCostNode(xercesc::DOMElement *node)
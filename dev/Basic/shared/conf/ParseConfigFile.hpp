@@ -147,6 +147,13 @@ private:
 	 */
 	void processWorkgroupAssignmentNode(xercesc::DOMElement *node);
 
+	/**
+	 * Processes the work_stealing element in the config file
+	 *
+	 * @param node node corresponding to the work_stealing element in the xml file
+	 */
+	void processWorkStealingNode(xercesc::DOMElement *node);
+
 	/**
 	 * Processes the operational cost in the config file
 	 *
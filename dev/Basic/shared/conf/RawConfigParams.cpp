@@ -12,7 +12,7 @@ sim_mob::RawConfigParams::RawConfigParams() : mergeLogFiles(false), generateBusR
 
 sim_mob::SimulationParams::SimulationParams() :
     baseGranMS(0), baseGranSecond(0), totalRuntimeMS(0), totalWarmupMS(0), inSimulationTTUsage(0),
-    workGroupAssigmentStrategy(WorkGroup::ASSIGN_ROUNDROBIN), startingAutoAgentID(0), operationalCostICE(0), operationalCostHEV(0), operationalCostBEV(0),
+    workGroupAssigmentStrategy(WorkGroup::ASSIGN_ROUNDROBIN), workGroupRebalanceInterval(100), workStealing(false), startingAutoAgentID(0), operationalCostICE(0), operationalCostHEV(0), operationalCostBEV(0),
     mutexStategy(MtxStrat_Buffered)
 {}
 
@@ -24,7 +24,8 @@ sim_mob::LongTermParams::DeveloperModel::DeveloperModel(): enabled(false), timeI
 sim_mob::LongTermParams::HousingModel::HousingModel(): enabled(false), timeInterval(0), timeOnMarket(0), timeOffMarket(0), wtpOffsetEnabled(false),unitsFiltering(false),vacantUnitActivationProbability(0),
                                                        housingMarketSearchPercentage(0), housingMoveInDaysInterval(0), offsetBetweenUnitBuyingAndSelling(0),
                                                        bidderUnitsChoiceSet(0),bidderBTOUnitsChoiceSet(0),householdBiddingWindow(0), householdBTOBiddingWindow(0),
-                                                       householdAwakeningPercentageByBTO(0), offsetBetweenUnitBuyingAndSellingAdvancedPurchase(0){}
+                                                       householdAwakeningPercentageByBTO(0), offsetBetweenUnitBuyingAndSellingAdvancedPurchase(0),
+                                                       deterministicMarket(false), marketSeed(0){}
 
 
 sim_mob::LongTermParams::HousingModel::BidderUnitChoiceset::BidderUnitChoiceset(): enabled(false),
@@ -39,6 +40,8 @@ sim_mob::LongTermParams::HousingModel::HedonicPriceModel::HedonicPriceModel(): a
 
 sim_mob::LongTermParams::OutputHouseholdLogsums::OutputHouseholdLogsums():enabled(false), fixedHomeVariableWork(false), fixedWorkVariableHome(false), vehicleOwnership(false), hitsRun(false), maxcCost(false), maxTime(false){}
 
+sim_mob::LongTermParams::LogsumCache::LogsumCache(): enabled(false), capacity(100000), file(""){}
+
 sim_mob::LongTermParams::VehicleOwnershipModel::VehicleOwnershipModel():enabled(false), vehicleBuyingWaitingTimeInDays(0){}
 sim_mob::LongTermParams::TaxiAccessModel::TaxiAccessModel():enabled(false){}
 sim_mob::LongTermParams::SchoolAssignmentModel::SchoolAssignmentModel():enabled(false), schoolChangeWaitingTimeInDays(0){}
@@ -89,6 +89,8 @@ struct LongTermParams
 		int householdBTOBiddingWindow;
 		float householdAwakeningPercentageByBTO;
 		int offsetBetweenUnitBuyingAndSellingAdvancedPurchase;
+		bool deterministicMarket; //draw choice sets and resolve equal bids from marketSeed, independently of the workers.
+		unsigned int marketSeed;
 
 		struct BidderUnitChoiceset
 		{
@@ -134,6 +136,17 @@ struct LongTermParams
 		bool maxTime;
 	} outputHouseholdLogsums;
 
+	/// cache of the preday logsums of individuals, keyed on the attributes read by the logsum models
+	struct LogsumCache
+	{
+		LogsumCache();
+		bool enabled;
+		unsigned int capacity;
+
+		/// file the cache is loaded from at startup and saved to at the end of the run; not persisted if empty
+		std::string file;
+	} logsumCache;
+
 	struct VehicleOwnershipModel{
 		VehicleOwnershipModel();
 		bool enabled;
@@ -352,6 +365,12 @@ public:
     /// Defautl assignment strategy for Workgroups.
     WorkGroup::ASSIGNMENT_STRATEGY workGroupAssigmentStrategy;
 
+    /// Number of ticks between two rebalancings of the Workers, with the time-based assignment strategy.
+    unsigned int workGroupRebalanceInterval;
+
+    /// Whether idle Workers steal entity updates from busier Workers of the same WorkGroup.
+    bool workStealing;
+
     /// Default starting ID for agents with auto-generated IDs.
     int startingAutoAgentID;
 
@@ -470,7 +489,7 @@ struct PathSetConf
     /**
      * Constructor
      */
-	PathSetConf() : enabled(false), supplyLinkFile(""), RTTT_Conf(""), DTT_Conf(""), psRetrievalWithoutBannedRegion(""), interval(0), recPS(false), reroute(false),
+	PathSetConf() : enabled(false), supplyLinkFile(""), RTTT_Conf(""), DTT_Conf(""), psRetrievalWithoutBannedRegion(""), interval(0), recPS(false), reroute(false), bidirectionalSearch(false), contractionHierarchy(false),
 			perturbationRange(std::pair<unsigned short,unsigned short>(0,0)), kspLevel(0),
 			perturbationIteration(0), threadPoolSize(0), maxSegSpeed(0), publickShortestPathLevel(10), simulationApproachIterations(10),
 			publicPathSetEnabled(true), privatePathSetEnabled(true)
@@ -537,6 +556,12 @@ struct PathSetConf
     ///	 enable rerouting?
 	bool reroute;
 
+    /// search the distance-based shortest driving paths with bidirectional A*?
+	bool bidirectionalSearch;
+
+    /// answer the distance-based shortest driving path queries without blacklist from a contraction hierarchy?
+	bool contractionHierarchy;
+
     ///	number of iterations in random perturbation
 	int perturbationIteration;
 
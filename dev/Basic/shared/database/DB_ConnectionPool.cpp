@@ -0,0 +1,96 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "DB_ConnectionPool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace sim_mob::db;
+
+DB_ConnectionPool::ScopedConnection::ScopedConnection(DB_ConnectionPool& pool) :
+        pool(pool), connection(pool.acquire())
+{
+}
+
+DB_ConnectionPool::ScopedConnection::~ScopedConnection()
+{
+    pool.release(connection);
+}
+
+DB_Connection& DB_ConnectionPool::ScopedConnection::operator*() const
+{
+    return connection;
+}
+
+DB_ConnectionPool::DB_ConnectionPool(BackendType type, const DB_Config& config, const std::string& schema, size_t size) :
+        type(type), config(config), schema(schema), maxSize(std::max<size_t>(size, 1))
+{
+}
+
+DB_ConnectionPool::~DB_ConnectionPool()
+{
+    for (std::vector<DB_Connection*>::iterator it = connections.begin(); it != connections.end(); it++)
+    {
+        delete *it;
+    }
+}
+
+DB_Connection& DB_ConnectionPool::acquire()
+{
+    boost::unique_lock<boost::mutex> lock(mutex);
+    while (freeConnections.empty() && connections.size() >= maxSize)
+    {
+        released.wait(lock);
+    }
+
+    DB_Connection* connection = nullptr;
+    if (!freeConnections.empty())
+    {
+        connection = freeConnections.back();
+        freeConnections.pop_back();
+    }
+    else
+    {
+        connection = new DB_Connection(type, config);
+        connections.push_back(connection);
+    }
+    //connects outside the lock, so that other threads do not wait for the connection to open.
+    lock.unlock();
+
+    if (!connection->isConnected())
+    {
+        bool connected = false;
+        try
+        {
+            connected = connection->connect();
+        }
+        catch (...)
+        {
+            release(*connection);
+            throw;
+        }
+        if (!connected)
+        {
+            release(*connection);
+            throw std::runtime_error("Cannot connect to the database " + config.getDatabaseName());
+        }
+        connection->setSchema(schema);
+    }
+    return *connection;
+}
+
+void DB_ConnectionPool::release(DB_Connection& connection)
+{
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        freeConnections.push_back(&connection);
+    }
+    released.notify_one();
+}
+
+size_t DB_ConnectionPool::size() const
+{
+    return maxSize;
+}
@@ -0,0 +1,88 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include "DB_Config.hpp"
+#include "DB_Connection.hpp"
+
+namespace sim_mob
+{
+
+namespace db
+{
+
+/**
+ * Fixed-size pool of connections to the same database and schema, shared by several threads.
+ *
+ * Connections are opened the first time they are needed and kept open until the pool is destroyed,
+ * so that the tables loaded later reuse open sessions instead of connecting again. acquire() hands out
+ * any free connection (the last one released first), not necessarily the one the calling thread used before.
+ * A connection is used by one thread at a time: acquire() blocks until one is free.
+ */
+class DB_ConnectionPool : private boost::noncopyable
+{
+public:
+    /**
+     * Connection of the pool held by the current scope.
+     */
+    class ScopedConnection : private boost::noncopyable
+    {
+    public:
+        explicit ScopedConnection(DB_ConnectionPool& pool);
+        ~ScopedConnection();
+
+        DB_Connection& operator*() const;
+
+    private:
+        DB_ConnectionPool& pool;
+        DB_Connection& connection;
+    };
+
+    /**
+     * @param type of database.
+     * @param config of the database.
+     * @param schema set on every connection of the pool.
+     * @param size maximum number of connections.
+     */
+    DB_ConnectionPool(BackendType type, const DB_Config& config, const std::string& schema, size_t size);
+    virtual ~DB_ConnectionPool();
+
+    /**
+     * Takes a connection from the pool, waiting until one is free. The connection is opened if needed.
+     * @return connection, which must be given back with release().
+     * @throw std::runtime_error if the connection cannot be opened.
+     */
+    DB_Connection& acquire();
+
+    /**
+     * Gives a connection back to the pool.
+     * @param connection taken with acquire().
+     */
+    void release(DB_Connection& connection);
+
+    size_t size() const;
+
+private:
+    BackendType type;
+    DB_Config config;
+    std::string schema;
+
+    /** all the connections created, at most maxSize */
+    std::vector<DB_Connection*> connections;
+
+    /** connections not taken at the moment */
+    std::vector<DB_Connection*> freeConnections;
+
+    size_t maxSize;
+    boost::mutex mutex;
+    boost::condition_variable released;
+};
+}
+}
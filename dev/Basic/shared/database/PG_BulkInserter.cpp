@@ -4,7 +4,7 @@
 
 using namespace sim_mob;
 
-PG_BulkInserter::PG_BulkInserter(const int numInsertsPerQuery) : numInsertsPerQuery(numInsertsPerQuery), query("")
+PG_BulkInserter::PG_BulkInserter(const int numInsertsPerQuery) : inputFile(nullptr), query(""), connection(nullptr), numInsertsPerQuery(numInsertsPerQuery)
 {
 
 }
@@ -12,6 +12,10 @@ PG_BulkInserter::PG_BulkInserter(const int numInsertsPerQuery) : numInsertsPerQu
 PG_BulkInserter::~PG_BulkInserter()
 {
     delete inputFile;
+    if (connection)
+    {
+        PQfinish(connection);
+    }
 }
 
 bool PG_BulkInserter::connect(const std::string &connectionStr)
@@ -73,7 +77,67 @@ bool PG_BulkInserter::bulkInsert()
         }
     }
 
-    copyToDB(streamBuf);
+    return copyToDB(streamBuf);
+}
+
+bool PG_BulkInserter::beginCopy()
+{
+    PGresult* res = PQexec(connection, query.c_str());
+    bool retVal = (PQresultStatus(res) == PGRES_COPY_IN);
+    if (!retVal)
+    {
+        Print() << "PG_BulkInserter: Copy Failed\n" << PQerrorMessage(connection);
+    }
+    PQclear(res);
+    return retVal;
+}
+
+bool PG_BulkInserter::putRows(const std::string& rows)
+{
+    if (PQputCopyData(connection, rows.data(), rows.size()) != 1)
+    {
+        Print() << PQerrorMessage(connection);
+        return false;
+    }
+    return true;
+}
+
+bool PG_BulkInserter::endCopy()
+{
+    if (PQputCopyEnd(connection, NULL) != 1)
+    {
+        Print() << PQerrorMessage(connection);
+        return false;
+    }
+
+    bool retVal = true;
+    PGresult* res = PQgetResult(connection);
+    if (PQresultStatus(res) != PGRES_COMMAND_OK)
+    {
+        Print() << PQerrorMessage(connection);
+        retVal = false;
+    }
+    PQclear(res);
+    return retVal;
+}
+
+bool PG_BulkInserter::abortCopy(const std::string& reason)
+{
+    if (PQputCopyEnd(connection, reason.c_str()) != 1)
+    {
+        Print() << PQerrorMessage(connection);
+        return false;
+    }
+
+    //the COPY is expected to fail now; drain its result so the connection can be reused
+    bool retVal = true;
+    PGresult* res = PQgetResult(connection);
+    if (PQresultStatus(res) != PGRES_FATAL_ERROR)
+    {
+        retVal = false;
+    }
+    PQclear(res);
+    return retVal;
 }
 
 bool PG_BulkInserter::copyToDB(const std::string& buffer)
@@ -22,6 +22,33 @@ public:
     bool setInputFile(const std::string& inputFile);
 
     bool bulkInsert();
+
+    /**
+     * Starts a COPY with the query built by buildQuery.
+     * Rows are then sent with putRows, without ending the COPY, until endCopy is called.
+     * @return true if the COPY was started
+     */
+    bool beginCopy();
+
+    /**
+     * Sends rows to the COPY started by beginCopy
+     * @param rows complete lines in the format of the COPY query
+     * @return true if the rows were sent
+     */
+    bool putRows(const std::string& rows);
+
+    /**
+     * Ends the COPY started by beginCopy; the rows are committed only if this succeeds
+     * @return true if all the rows were copied
+     */
+    bool endCopy();
+
+    /**
+     * Ends the COPY started by beginCopy with an error, so that none of its rows are committed
+     * @param reason error message reported by the server
+     * @return true if the server acknowledged the abort
+     */
+    bool abortCopy(const std::string& reason);
 private:
     std::ifstream* inputFile;
 
@@ -27,6 +27,24 @@ std::vector<std::string> initTimeDependentTT_ColNames(const std::string& prefix)
 
 std::vector<std::string> ttArrivalBasedColumn = initTimeDependentTT_ColNames(DB_FIELD_TCOST_TT_ARRIVAL_PREFIX);
 std::vector<std::string> ttDepartureBasedColumn = initTimeDependentTT_ColNames(DB_FIELD_TCOST_TT_DEPARTURE_PREFIX);
+
+std::string getTimeDependentTT_TableName(TravelTimeMode ttMode)
+{
+	ConfigParams& fullConfig = ConfigManager::GetInstanceRW().FullConfig();
+	const std::string DEMAND_SCHEMA = fullConfig.schemas.demand_schema;
+	switch(ttMode)
+	{
+	case TravelTimeMode::TT_PRIVATE:
+	{
+		return APPLY_SCHEMA(DEMAND_SCHEMA, fullConfig.dbTableNamesMap["learned_travel_time_table_car"]);
+	}
+	case TravelTimeMode::TT_PUBLIC:
+	default:
+	{
+		return APPLY_SCHEMA(DEMAND_SCHEMA, fullConfig.dbTableNamesMap["learned_travel_time_table_bus"]);
+	}
+	}
+}
 }
 
 CostSqlDao::CostSqlDao(DB_Connection& connection, const std::string& getAllQuery) :
@@ -250,6 +268,24 @@ bool sim_mob::TimeDependentTT_SqlDao::getTT_ByOD(TravelTimeMode ttMode, int orig
 	return returnVal;
 }
 
+void sim_mob::TimeDependentTT_SqlDao::getAllTT(TravelTimeMode ttMode, const boost::function<void (const TimeDependentTT_Params&)>& callback)
+{
+	if (isConnected())
+	{
+		Statement query(connection.getSession<soci::session>());
+		const std::string DB_GET_ALL_TCOST = "SELECT * FROM " + getTimeDependentTT_TableName(ttMode);
+		prepareStatement(DB_GET_ALL_TCOST, db::EMPTY_PARAMS, query);
+		ResultSet rs(query);
+		TimeDependentTT_Params todBasedTT;
+		for (ResultSet::const_iterator it = rs.begin(); it != rs.end(); ++it)
+		{
+			db::Row& row = *it;
+			fromRow(row, todBasedTT);
+			callback(todBasedTT);
+		}
+	}
+}
+
 void sim_mob::TimeDependentTT_SqlDao::getUnavailableODs(TravelTimeMode ttMode, std::vector<sim_mob::OD_Pair>& outVect)
 {
 	if (isConnected())
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <boost/function.hpp>
 #include <boost/unordered_map.hpp>
 #include <string>
 #include "database/dao/SqlAbstractDao.hpp"
@@ -153,6 +154,14 @@ public:
      */
     bool getTT_ByOD(TravelTimeMode ttMode, int originZn, int destZn, TimeDependentTT_Params& outObj);
 
+    /**
+     * streams all records of the travel time table for a mode.
+     * The same params object is reused for every record; callers must copy what they need to keep.
+     * @param ttMode mode type - (public transit / private) for fetching travel time
+     * @param callback function to be invoked for each record fetched
+     */
+    void getAllTT(TravelTimeMode ttMode, const boost::function<void (const TimeDependentTT_Params&)>& callback);
+
     /**
      * get ODs for which data is unavailable in the database
      * @param ttMode mode type - (public transit / private) for fetching travel time
@@ -17,6 +17,7 @@
 #include "spatial_trees/simtree/SimAuraManager.hpp"
 #include "spatial_trees/rdu_tree/RDUAuraManager.hpp"
 #include "spatial_trees/packing_tree/PackingTreeAuraManager.hpp"
+#include "spatial_trees/grid/GridAuraManager.hpp"
 
 namespace sim_mob
 {
@@ -52,6 +53,11 @@ void AuraManager::init(AuraManagerImplementation implType)
         impl_ = new PackingTreeAuraManager();
         impl_->init();
     }
+    else if (implType == IMPL_GRID)
+    {
+        impl_ = new GridAuraManager();
+        impl_->init();
+    }
     else
     {
         throw std::runtime_error("Unknown AuraManager Implementation type selected.");
@@ -72,6 +78,14 @@ void AuraManager::update(const std::set<sim_mob::Entity *>& removedAgentPointers
     time_step++;
 }
 
+void AuraManager::updateAgents(const std::set<sim_mob::Entity *>& entities)
+{
+    if (impl_)
+    {
+        impl_->updateAgents(entities);
+    }
+}
+
 std::vector<Agent const *> AuraManager::agentsInRect(Point const &lowerLeft, Point const &upperRight, const sim_mob::Agent *refAgent) const
 {
     std::vector<Agent const *> results;
@@ -56,7 +56,10 @@ public:
         IMPL_RDU,
         
         /**R-Star with packing algorithm*/
-        IMPL_PACKING
+        IMPL_PACKING,
+
+        /**Uniform grid, updated incrementally by the workers*/
+        IMPL_GRID
     };
 
     static AuraManager& instance()
@@ -75,6 +78,14 @@ public:
      */
     void update(const std::set<sim_mob::Entity *>& removedAgentPointers);
 
+    /**
+     * Called every frame by each worker, in parallel, after it has flipped its buffers, with the entities it manages.
+     *
+     * Implementations which index the agents incrementally (namely the grid) record the new positions here, so that
+     * update() need only process the agents which changed cell. Others ignore this call.
+     */
+    void updateAgents(const std::set<sim_mob::Entity *>& entities);
+
     /**
      * Return a collection of agents that are located in the axially-aligned rectangle.
      * 
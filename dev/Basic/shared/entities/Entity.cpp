@@ -81,6 +81,20 @@ void sim_mob::Entity::onWorkerExit()
 {
 }
 
+bool sim_mob::Entity::isMigratable() const
+{
+    return false;
+}
+
+void sim_mob::Entity::getAdjacentEntities(std::vector<Entity*>& adjacent) const
+{
+}
+
+void sim_mob::Entity::resetWorkerProvider(WorkerProvider* provider)
+{
+    currWorkerProvider = provider;
+}
+
 void sim_mob::Entity::registerChild(Entity* child)
 {
 }
@@ -185,6 +185,31 @@ public:
      */
     virtual void unregisterChild(Entity* child = nullptr);
 
+    /**
+     * Used to determine if the WorkGroup may move this entity to another Worker between two ticks to balance the
+     * load of its Workers (see WorkGroup::ASSIGN_TIMEBASED). The messages of a moved entity are still handled by the
+     * thread which first registered it.
+     *
+     * @return true if the entity can be moved; false (the default) otherwise
+     */
+    virtual bool isMigratable() const;
+
+    /**
+     * Collects the entities which interact closely with this one, and which are best managed by the same Worker.
+     *
+     * @param adjacent output list to which the adjacent entities are appended
+     */
+    virtual void getAdjacentEntities(std::vector<Entity*>& adjacent) const;
+
+    /**
+     * Sets the worker provider of this entity, and of the entities to which this entity passes its worker provider
+     * while it is updated. Used by a Worker which updated this entity on behalf of the Worker managing it (work
+     * stealing), so that none of them keeps using the stealing Worker's random number generator and log file.
+     *
+     * @param provider the worker provider managing this entity
+     */
+    virtual void resetWorkerProvider(WorkerProvider* provider);
+
     /**
      * Returns a list of pointers to each Buffered<> type that this entity managed.
      * Entity sub-classes should override buildSubscriptionList() to help with
@@ -16,6 +16,36 @@ using namespace sim_mob;
 using namespace messaging;
 using namespace std;
 
+namespace
+{
+/** Speed assumed by the euclidean travel time estimation: 30Kmph converted in mps */
+const double EUCLIDEAN_ESTIMATION_SPEED = 30.0 * 1000 / 3600;
+}
+
+TravelTimeMatrix::TravelTimeMatrix(const std::vector<const Node *> &sources, const std::vector<const Node *> &targets)
+        : sources(sources), targets(targets), travelTimes(sources.size() * targets.size(), 0)
+{
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        sourceIndices.emplace(sources[i], i);
+    }
+    for (size_t j = 0; j < targets.size(); ++j)
+    {
+        targetIndices.emplace(targets[j], j);
+    }
+}
+
+double TravelTimeMatrix::get(const Node *source, const Node *target) const
+{
+    const std::unordered_map<const Node *, size_t>::const_iterator sourceIt = sourceIndices.find(source);
+    const std::unordered_map<const Node *, size_t>::const_iterator targetIt = targetIndices.find(target);
+    if (sourceIt == sourceIndices.end() || targetIt == targetIndices.end())
+    {
+        throw std::runtime_error("TravelTimeMatrix::get: node not in the matrix");
+    }
+    return travelTimes[sourceIt->second * targets.size() + targetIt->second];
+}
+
 OnCallController::OnCallController(const MutexStrategy &mtxStrat, unsigned int computationPeriod,
                                    MobilityServiceControllerType type_, unsigned id, std::string tripSupportMode_, TT_EstimateType ttEstimateType_,
                                    unsigned maxAggregatedRequests_,bool studyAreaEnabledController, unsigned int toleratedExtraTime_,
@@ -44,6 +74,7 @@ void OnCallController::subscribeDriver(Person *driver)
 
     MobilityServiceController::subscribeDriver(driver);
     availableDrivers.insert(driver);
+    indexAvailableDriver(driver);
 
 #ifndef NDEBUG
     if (driverSchedules.find(driver) != driverSchedules.end() )
@@ -90,6 +121,7 @@ void OnCallController::unsubscribeDriver(Person *driver)
     }
 
     availableDrivers.erase(driver);
+    availableDriversIndex.erase(driver);
     partiallyAvailableDrivers.erase(driver);
     driversServingSharedReq.erase(driver);
     currentReq.erase(driver);
@@ -119,6 +151,7 @@ void OnCallController::driverAvailable(const Person *driver)
 #endif
 
     availableDrivers.insert(driver);
+    indexAvailableDriver(driver);
 
     // The driver has an empty schedule now
     driverSchedules[driver] = Schedule();
@@ -140,6 +173,7 @@ void OnCallController::driverUnavailable(Person *person)
 #endif
 
     availableDrivers.erase(person);
+    availableDriversIndex.erase(person);
 
 #ifndef NDEBUG
     consistencyChecks("driverUnavailable: end");
@@ -232,6 +266,7 @@ Entity::UpdateStatus OnCallController::frame_tick(timeslice now)
                             << ", driversServingSharedReq.size() = "<<driversServingSharedReq.size() <<" , "<< currTick
                             << std::endl;
 
+            updateAvailableDriversIndex();
             computeSchedules();
             ControllerLog() << "Computation schedule done: now " << requestQueue.size() << " requests are in the queue, available drivers "
                             << availableDrivers.size() <<", partiallyAvailableDrivers.size()="<< partiallyAvailableDrivers.size()
@@ -465,6 +500,7 @@ void OnCallController::assignSchedule(const Person *driver, const Schedule &sche
         driverSchedules[driver] = controllersCopy;
         // The driver is not available anymore
         availableDrivers.erase(driver);
+        availableDriversIndex.erase(driver);
     }
     else
     {
@@ -623,49 +659,56 @@ const Node *OnCallController::getCurrentNode(const Person *driver) const
 }
 
 
-const Person *OnCallController::findClosestDriver(const Node *node) const
+void OnCallController::indexAvailableDriver(const Person *driver)
 {
-    double bestDistance = std::numeric_limits<double>::max();
-    double bestX, bestY;
+    const Node *driverNode = getCurrentNode(driver);
+    if (driverNode)
+    {
+        availableDriversIndex.update(driver, driverNode->getPosX(), driverNode->getPosY());
+    }
+    else
+    {
+        //Not on the network yet. She will be indexed at the next update
+        availableDriversIndex.erase(driver);
+    }
+}
 
-    const Person *bestDriver = NULL;
-    auto driver = availableDrivers.begin();
+void OnCallController::updateAvailableDriversIndex()
+{
+    for (const Person *driver : availableDrivers)
+    {
+        indexAvailableDriver(driver);
+    }
+}
 
+const Person *OnCallController::findClosestDriver(const Node *node) const
+{
 #ifndef NDEBUG
     unsigned nonCruisingDrivers = 0;
 #endif
 
-    while (driver != availableDrivers.end())
-    {
-#ifndef NDEBUG
-        if ( driverSchedules.find(*driver) == driverSchedules.end()  )
+    const Person *bestDriver = availableDriversIndex.findNearest(node->getPosX(), node->getPosY(),
+        [&](const Person *driver) -> bool
         {
-            std::stringstream msg;
-            msg << "Driver " << (*driver)->getDatabaseId() << " and pointer " << *driver
-                << " exists in availableDrivers but not in driverSchedules";
-            throw std::runtime_error(msg.str());
-        }
+#ifndef NDEBUG
+            if ( driverSchedules.find(driver) == driverSchedules.end()  )
+            {
+                std::stringstream msg;
+                msg << "Driver " << driver->getDatabaseId() << " and pointer " << driver
+                    << " exists in availableDrivers but not in driverSchedules";
+                throw std::runtime_error(msg.str());
+            }
 #endif
-        if (isCruising(*driver) || isParked(*driver) || isJustStated(*driver) || isDrivingToPark(*driver))
-        {
-            const Node *driverNode = getCurrentNode(*driver);
-            double currDistance = dist(node->getLocation(), driverNode->getLocation());
-
-            if (currDistance < bestDistance)
+            if (isCruising(driver) || isParked(driver) || isJustStated(driver) || isDrivingToPark(driver))
             {
-                bestDriver = *driver;
-                bestDistance = currDistance;
-                bestX = driverNode->getPosX();
-                bestY = driverNode->getPosY();
+                return true;
             }
-        }
 #ifndef NDEBUG
-        else{
             nonCruisingDrivers++;
 
-            const MobilityServiceDriver* mobilityServiceDriver = (*driver)->exportServiceDriver();
+            const MobilityServiceDriver* mobilityServiceDriver = driver->exportServiceDriver();
             const std::string driverStatusStr = mobilityServiceDriver->getDriverStatusStr();
-            std::stringstream msg; msg<<"Error: "<<__FILE__<<":" <<__LINE__<< ":Driver " << (*driver)->getDatabaseId() <<
+            std::stringstream msg; msg<<"Error: "<<__FILE__<<":" <<__LINE__<< ":Driver " << driver->getDatabaseId() <<
                 " is among the available drivers of a controller of type "<<
                 sim_mob::toString(controllerServiceType) <<", but her state is "<<
                 driverStatusStr<<
@@ -674,15 +717,15 @@ const Person *OnCallController::findClosestDriver(const Node *node) const
                     "ALL the available drivers MUST be cruising. If it is not the case, there is a bug. If you are running a more complex scenario, where a driver can be "
                     <<"subscribed to different services at the same time, please remove this exception, compile and run again";
             throw std::runtime_error(msg.str() );
-        }
 #endif
-        driver++;
-    }
+            return false;
+        });
 
     std::stringstream msg;
     if (bestDriver != NULL)
     {
-        msg << "Closest vehicle is at (" << bestX << ", " << bestY << ")" << std::endl;
+        const Node *driverNode = getCurrentNode(bestDriver);
+        msg << "Closest vehicle is at (" << driverNode->getPosX() << ", " << driverNode->getPosY() << ")" << std::endl;
     }
     else
     {
@@ -692,7 +735,7 @@ const Person *OnCallController::findClosestDriver(const Node *node) const
 #endif
         ControllerLog() << msg.str() << std::endl;
 #ifndef NDEBUG
-        if (! availableDrivers.empty() )
+        if (! availableDriversIndex.empty() )
         {
             msg<<". In the scenarios where a driver subscribed to an OnCall service is only subscribed to that service, "<<
             "ALL the available drivers MUST be cruising. If it is not the case, there is a bug. If you are running a more complex scenario, where a driver can be "
@@ -1027,6 +1070,15 @@ void OnCallController::consistencyChecks(const std::string& label) const
         }
     }
 
+    if (availableDriversIndex.size() > availableDrivers.size())
+    {
+        std::stringstream msg;
+        msg << label << " availableDriversIndex.size()=" << availableDriversIndex.size()
+            << " and availableDrivers.size()=" << availableDrivers.size()
+            << ". The index cannot hold drivers who are not available";
+        throw std::runtime_error(msg.str());
+    }
+
     // Check if the same request is present more than once
     std::vector<TripRequestMessage> requestQueueCopy{std::begin(requestQueue), std::end(requestQueue)};
     std::sort(requestQueueCopy.begin(), requestQueueCopy.end());
@@ -1153,6 +1205,43 @@ double OnCallController::getTT(const Node *node1, const Node *node2, TT_Estimate
     return retValue;
 }
 
+TravelTimeMatrix OnCallController::getTTMatrix(const std::vector<const Node *> &sources, const std::vector<const Node *> &targets,
+                                               TT_EstimateType type) const
+{
+    TravelTimeMatrix matrix(sources, targets);
+    if (type == SHORTEST_PATH_ESTIMATION)
+    {
+        const std::vector<std::vector<double>> travelTimes = PrivateTrafficRouteChoice::getInstance()->getShortestPathTravelTimes(
+                sources, targets, DailyTime(currTick.ms()));
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            for (size_t j = 0; j < targets.size(); ++j)
+            {
+                // Same conventions as getTT(..)
+                if (sources[i] == targets[j])
+                {
+                    matrix.at(i, j) = 0;
+                }
+                else
+                {
+                    matrix.at(i, j) = (travelTimes[i][j] <= 0 ? std::numeric_limits<double>::max() : travelTimes[i][j]);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            for (size_t j = 0; j < targets.size(); ++j)
+            {
+                matrix.at(i, j) = getTT(sources[i], targets[j], type);
+            }
+        }
+    }
+    return matrix;
+}
+
 double OnCallController::getTT(const Point &point1, const Point &point2) const
 {
     double squareDistance = pow(point1.getX() - point2.getX(), 2) + pow(
@@ -1161,8 +1250,18 @@ double OnCallController::getTT(const Point &point1, const Point &point2) const
     // that we go from a node to the other by crossing the two catheti
     double cathetus = sqrt(squareDistance) / sqrt(2.0);
     double distanceToCover = 2.0 * cathetus; // meters
-    double speedAssumed = 30.0 * 1000 / 3600; //30Kmph converted in mps
-    return distanceToCover / speedAssumed;
+    return distanceToCover / EUCLIDEAN_ESTIMATION_SPEED;
+}
+
+double OnCallController::getTTLowerBoundSpeed(TT_EstimateType typeOD) const
+{
+    if (typeOD == EUCLIDEAN_ESTIMATION)
+    {
+        // The distance covered along the two catheti is sqrt(2) times the euclidean distance
+        return EUCLIDEAN_ESTIMATION_SPEED / sqrt(2.0);
+    }
+    // The network travel times can be arbitrarily short w.r.t. the distance, e.g. on expressways
+    return 0;
 }
 
 double OnCallController::toMs(int c) const
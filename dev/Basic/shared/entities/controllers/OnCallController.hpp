@@ -15,6 +15,7 @@
 #include "entities/controllers/Rebalancer.hpp"
 #include "message/Message.hpp"
 #include "message/MobilityServiceControllerMessage.hpp"
+#include "spatial_trees/SpatialGridIndex.hpp"
 #include "MobilityServiceController.hpp"
 
 
@@ -119,6 +120,50 @@ enum TT_EstimateType
     EUCLIDEAN_ESTIMATION // The least computationally expensive one
 };
 
+/**
+ * Travel times from each node of a set of sources to each node of a set of targets, as returned by
+ * OnCallController::getTTMatrix(..). In seconds
+ */
+class TravelTimeMatrix
+{
+public:
+    TravelTimeMatrix(const std::vector<const Node*>& sources, const std::vector<const Node*>& targets);
+
+    /**
+     * Returns the travel time from source to target. Throws if source is not a source or target is not a target of the matrix
+     */
+    double get(const Node* source, const Node* target) const;
+
+    /**
+     * Returns the travel time from the sourceIdx-th source to the targetIdx-th target
+     */
+    double& at(size_t sourceIdx, size_t targetIdx)
+    {
+        return travelTimes[sourceIdx * targets.size() + targetIdx];
+    }
+
+    const std::vector<const Node*>& getSources() const
+    {
+        return sources;
+    }
+
+    const std::vector<const Node*>& getTargets() const
+    {
+        return targets;
+    }
+
+private:
+    std::vector<const Node*> sources;
+    std::vector<const Node*> targets;
+
+    /** Position of each node in sources and targets */
+    std::unordered_map<const Node*, size_t> sourceIndices;
+    std::unordered_map<const Node*, size_t> targetIndices;
+
+    /** Travel times, row by row (one row per source) */
+    std::vector<double> travelTimes;
+};
+
 class OnCallController : public MobilityServiceController
 {
 protected:
@@ -151,6 +196,20 @@ public:
      */
     double getTT(const Point& point1, const Point& point2) const;
 
+    /**
+     * Returns a speed s such that getTT(node1, node2, typeOD) >= distance(node1, node2) / s for any two nodes, in meters
+     * per second. Returns 0 if no such speed is known for the estimate type
+     */
+    double getTTLowerBoundSpeed(TT_EstimateType typeOD) const;
+
+    /**
+     * Estimates the travel times to go from each of the sources to each of the targets, as getTT(..) would for each
+     * pair. With SHORTEST_PATH_ESTIMATION, the paths from a source to all targets are found by a single search and
+     * the searches of the sources run in parallel. Use this instead of calling getTT(..) in nested loops
+     */
+    TravelTimeMatrix getTTMatrix(const std::vector<const Node*>& sources, const std::vector<const Node*>& targets,
+                                 TT_EstimateType typeOD) const;
+
     /**
      * Converts from number of clocks to milliseconds
      */
@@ -187,6 +246,12 @@ protected:
     /** Store list of available drivers */
     std::set<const Person *> availableDrivers;
 
+    /**
+     * Locations of the available drivers, for findClosestDriver(..). Drivers are added and removed together with
+     * availableDrivers; the locations of the cruising ones are refreshed before each computation of the schedules
+     */
+    SpatialGridIndex<Person> availableDriversIndex;
+
     /** Store queue of requests */
     std::list<TripRequestMessage> requestQueue;
 
@@ -273,6 +338,16 @@ protected:
      */
     virtual void computeSchedules() = 0;
 
+    /**
+     * Inserts the driver in availableDriversIndex at her current node, or moves her there if she is already indexed
+     */
+    void indexAvailableDriver(const Person* driver);
+
+    /**
+     * Moves all the drivers in availableDriversIndex to their current nodes
+     */
+    void updateAvailableDriversIndex();
+
     /**
      * Computes a hypothetical schedule such that a driver located at a certain position can serve her current schedule
      * as well as additional requests. The hypothetical schedule is written in newSchedule.
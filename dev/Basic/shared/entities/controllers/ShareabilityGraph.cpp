@@ -0,0 +1,355 @@
+/*
+ * ShareabilityGraph.cpp
+ *
+ * Pairs of pending requests which can be served by the same vehicle
+ */
+
+#include "ShareabilityGraph.hpp"
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "geospatial/network/Node.hpp"
+#include "spatial_trees/SpatialGridIndex.hpp"
+#include "util/threadpool/Threadpool.hpp"
+
+using namespace sim_mob;
+
+namespace
+{
+/**below this number of pairs, the graph is built by the calling thread*/
+const size_t MIN_PAIRS_FOR_THREAD_POOL = 20000;
+
+/**number of tasks per thread of the pool; the tasks are interleaved, so that their costs are similar*/
+const size_t TASKS_PER_THREAD = 4;
+
+boost::shared_ptr<sim_mob::batched::ThreadPool> threadPool;
+boost::mutex threadPoolMutex;
+
+/**
+ * What the tasks building the graph share
+ */
+struct BuildContext
+{
+    const std::vector<TripRequestMessage>* requests;
+    const ShareabilityGraph::TravelTimeFunction* travelTime;
+
+    /**desired travel time plus tolerated extra time of each request*/
+    std::vector<double> maxTravelTimes;
+
+    /**if non empty, the candidates of each request with a higher index; otherwise all of them are candidates*/
+    std::vector<std::vector<unsigned> > candidates;
+
+    /**requests within reach of the origin of each request, before the candidates are known*/
+    std::vector<std::vector<const TripRequestMessage*> > neighbours;
+
+    const SpatialGridIndex<TripRequestMessage>* origins;
+    double lowerBoundSpeed;
+
+    /**the edges found for each request towards the requests with a higher index*/
+    std::vector<std::vector<ShareabilityGraph::SharedTrip> > trips;
+};
+
+/**
+ * Sets the best trip of request1 and request2 to the given one if there is none yet or if the given one is shorter
+ */
+void setIfBetter(bool& found, ShareabilityGraph::SharedTrip& best, double totalTime, SharedTripSequence sequence)
+{
+    if (!found || totalTime < best.totalTime)
+    {
+        best.totalTime = totalTime;
+        best.sequence = sequence;
+    }
+    found = true;
+}
+
+/**
+ * Checks if two requests can be combined, in any of the possible sequences. When they are combined, user 1 experiences
+ * some additional delay w.r.t. the case when each user travels alone. A combination is feasible if this extra-delay is
+ * below the tolerated one. The best combination is the one minimizing the total travel time.
+ *
+ * @return true if the requests can be shared, in which case best holds the best sequence
+ */
+bool evaluatePair(const BuildContext& context, unsigned request1Index, unsigned request2Index,
+                  ShareabilityGraph::SharedTrip& best)
+{
+    const ShareabilityGraph::TravelTimeFunction& tt = *context.travelTime;
+    const TripRequestMessage& request1 = (*context.requests)[request1Index];
+    const TripRequestMessage& request2 = (*context.requests)[request2Index];
+    const double maxTravelTime1 = context.maxTravelTimes[request1Index];
+    const double maxTravelTime2 = context.maxTravelTimes[request2Index];
+
+    const Node* startNode1 = request1.startNode;
+    const Node* destinationNode1 = request1.destinationNode;
+    const Node* startNode2 = request2.startNode;
+    const Node* destinationNode2 = request2.destinationNode;
+
+    bool found = false;
+    best.request = request2Index;
+
+    //{ o1 o2 d1 d2
+    double tripTime1 = tt(startNode1, startNode2) + tt(startNode2, destinationNode1);
+    double tripTime2 = tt(startNode2, destinationNode1) + tt(destinationNode1, destinationNode2);
+    if (tripTime1 <= maxTravelTime1 && tripTime2 <= maxTravelTime2)
+    {
+        setIfBetter(found, best, tripTime1 + tripTime2, O1_O2_D1_D2);
+    }
+    //} o1 o2 d1 d2
+
+    //{ o2 o1 d2 d1
+    tripTime1 = tt(startNode1, destinationNode2) + tt(destinationNode2, destinationNode1);
+    tripTime2 = tt(startNode2, startNode1) + tt(startNode1, destinationNode2);
+    if (tripTime1 <= maxTravelTime1 && tripTime2 <= maxTravelTime2)
+    {
+        setIfBetter(found, best, tripTime1 + tripTime2, O2_O1_D2_D1);
+    }
+    //} o2 o1 d2 d1
+
+    //{ o1 o2 d2 d1
+    tripTime1 = tt(startNode1, startNode2) + tt(startNode2, destinationNode2) + tt(destinationNode2, destinationNode1);
+    // tripTime2 is kept from the previous sequence, as the controller always did
+    if (tripTime1 <= maxTravelTime1)
+    {
+        setIfBetter(found, best, tripTime1 + tripTime2, O1_O2_D2_D1);
+    }
+    //} o1 o2 d2 d1
+
+    //{ o2 o1 d1 d2
+    tripTime2 = tt(startNode2, startNode1) + tt(startNode1, destinationNode1) + tt(destinationNode1, destinationNode2);
+    // tripTime1 is kept from the previous sequence, as the controller always did
+    if (tripTime2 <= maxTravelTime2)
+    {
+        setIfBetter(found, best, tripTime1 + tripTime2, O2_O1_D1_D2);
+    }
+    //} o2 o1 d1 d2
+
+    return found;
+}
+
+double distance(const Node* node1, const Node* node2)
+{
+    const double dx = node1->getPosX() - node2->getPosX();
+    const double dy = node1->getPosY() - node2->getPosY();
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * Longest distance the user of a request can travel within her maximum travel time. Slightly enlarged, so that rounding
+ * errors do not prune feasible pairs
+ */
+double reach(const BuildContext& context, unsigned request)
+{
+    return context.maxTravelTimes[request] * context.lowerBoundSpeed * (1.0 + 1e-9) + 1e-6;
+}
+
+/**
+ * True if the user of the request can travel from her origin to the origin of the other request and then to her
+ * destination within her maximum travel time
+ */
+bool isWithinDetour(const BuildContext* context, unsigned request, const TripRequestMessage* other)
+{
+    const TripRequestMessage& trip = (*context->requests)[request];
+    return distance(trip.startNode, other->startNode) + distance(other->startNode, trip.destinationNode)
+           <= reach(*context, request);
+}
+
+/**
+ * Finds the requests whose origins are within the detour allowed to the requests first, first + step, first + 2 * step,
+ * ... These are inside an ellipse with foci at the origin and at the destination, which is itself inside the circle
+ * centred at their midpoint, with radius equal to half the reach
+ */
+void findNeighbours(BuildContext* context, size_t first, size_t step)
+{
+    for (size_t i = first; i < context->requests->size(); i += step)
+    {
+        const TripRequestMessage& request = (*context->requests)[i];
+        context->origins->findWithinRadius(
+                (request.startNode->getPosX() + request.destinationNode->getPosX()) / 2.0,
+                (request.startNode->getPosY() + request.destinationNode->getPosY()) / 2.0,
+                reach(*context, i) / 2.0 + 1e-6, context->neighbours[i],
+                boost::bind(isWithinDetour, context, static_cast<unsigned>(i), _1));
+    }
+}
+
+/**
+ * Evaluates the candidate pairs of the requests first, first + step, first + 2 * step, ...
+ */
+void evaluateRequests(BuildContext* context, size_t first, size_t step)
+{
+    const unsigned numRequests = context->requests->size();
+    ShareabilityGraph::SharedTrip trip;
+    for (size_t i = first; i < numRequests; i += step)
+    {
+        std::vector<ShareabilityGraph::SharedTrip>& trips = context->trips[i];
+        if (context->candidates.empty())
+        {
+            for (unsigned j = i + 1; j < numRequests; ++j)
+            {
+                if (evaluatePair(*context, i, j, trip))
+                {
+                    trips.push_back(trip);
+                }
+            }
+        }
+        else
+        {
+            std::vector<unsigned>& candidates = context->candidates[i];
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            for (unsigned j : candidates)
+            {
+                if (evaluatePair(*context, i, j, trip))
+                {
+                    trips.push_back(trip);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Runs task(context, first, step) for all the interleaved slices of the requests, in parallel if useThreadPool is set
+ */
+void runTasks(void (*task)(BuildContext*, size_t, size_t), BuildContext& context, bool useThreadPool)
+{
+    const size_t poolSize = boost::thread::hardware_concurrency();
+    if (!useThreadPool || poolSize <= 1)
+    {
+        task(&context, 0, 1);
+        return;
+    }
+
+    {
+        boost::unique_lock<boost::mutex> lock(threadPoolMutex);
+        if (!threadPool)
+        {
+            threadPool.reset(new sim_mob::batched::ThreadPool(poolSize));
+        }
+    }
+    const size_t numTasks = poolSize * TASKS_PER_THREAD;
+    for (size_t first = 0; first < numTasks; ++first)
+    {
+        threadPool->enqueue(boost::bind(task, &context, first, numTasks));
+    }
+    threadPool->wait();
+}
+}
+
+ShareabilityGraph::ShareabilityGraph(const std::vector<TripRequestMessage>& requests,
+                                     const std::vector<double>& desiredTravelTimes,
+                                     const TravelTimeFunction& travelTime, double lowerBoundSpeed)
+        : offsets(requests.size() + 1, 0), numEvaluatedPairs(0)
+{
+    if (requests.size() != desiredTravelTimes.size())
+    {
+        throw std::runtime_error("ShareabilityGraph: requests and desiredTravelTimes must have the same length");
+    }
+
+    const size_t numRequests = requests.size();
+    BuildContext context;
+    context.requests = &requests;
+    context.travelTime = &travelTime;
+    context.origins = nullptr;
+    context.lowerBoundSpeed = lowerBoundSpeed;
+    context.trips.resize(numRequests);
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        context.maxTravelTimes.push_back(desiredTravelTimes[i] + requests[i].extraTripTimeThreshold);
+    }
+
+    if (lowerBoundSpeed > 0.0 && numRequests > 1)
+    {
+        // In all the sequences, the user picked up first travels to the origin of the other one and then to her own
+        // destination. Hence, the two requests can be shared only if the origin of one of them is within the detour
+        // allowed to the other
+        double meanRadius = 0.0;
+        for (size_t i = 0; i < numRequests; ++i)
+        {
+            meanRadius += std::min(reach(context, i) / 2.0, 1e6) / numRequests;
+        }
+        SpatialGridIndex<TripRequestMessage> origins(std::max(meanRadius / 4.0, 100.0));
+        for (const TripRequestMessage& request : requests)
+        {
+            origins.update(&request, request.startNode->getPosX(), request.startNode->getPosY());
+        }
+        context.origins = &origins;
+        context.neighbours.resize(numRequests);
+        runTasks(findNeighbours, context, numRequests * numRequests / 2 >= MIN_PAIRS_FOR_THREAD_POOL);
+
+        context.candidates.resize(numRequests);
+        for (unsigned i = 0; i < numRequests; ++i)
+        {
+            for (const TripRequestMessage* neighbour : context.neighbours[i])
+            {
+                const unsigned j = neighbour - requests.data();
+                if (j != i)
+                {
+                    context.candidates[std::min(i, j)].push_back(std::max(i, j));
+                }
+            }
+            std::vector<const TripRequestMessage*>().swap(context.neighbours[i]);
+        }
+        for (const std::vector<unsigned>& candidates : context.candidates)
+        {
+            numEvaluatedPairs += candidates.size();
+        }
+    }
+    else
+    {
+        numEvaluatedPairs = numRequests * (numRequests - 1) / 2;
+    }
+
+    // Duplicated candidates are removed by the tasks, so numEvaluatedPairs is an upper bound until then
+    runTasks(evaluateRequests, context, numEvaluatedPairs >= MIN_PAIRS_FOR_THREAD_POOL);
+    if (!context.candidates.empty())
+    {
+        numEvaluatedPairs = 0;
+        for (const std::vector<unsigned>& candidates : context.candidates)
+        {
+            numEvaluatedPairs += candidates.size();
+        }
+    }
+
+    // Compressed sparse rows, with each edge stored at both its ends. Rows are filled by increasing index of the
+    // request with the lower index, so each row is sorted
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        offsets[i + 1] += context.trips[i].size();
+        for (const SharedTrip& trip : context.trips[i])
+        {
+            offsets[trip.request + 1]++;
+        }
+    }
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+
+    trips.resize(offsets[numRequests]);
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (unsigned i = 0; i < numRequests; ++i)
+    {
+        for (const SharedTrip& trip : context.trips[i])
+        {
+            trips[next[i]++] = trip;
+
+            SharedTrip reverse = trip;
+            reverse.request = i;
+            trips[next[trip.request]++] = reverse;
+        }
+    }
+}
+
+const ShareabilityGraph::SharedTrip* ShareabilityGraph::findSharedTrip(unsigned request1, unsigned request2) const
+{
+    const std::pair<const SharedTrip*, const SharedTrip*> range = getSharedTrips(request1);
+    const SharedTrip* trip = std::lower_bound(range.first, range.second, request2,
+                                              [](const SharedTrip& edge, unsigned request)
+                                              {
+                                                  return edge.request < request;
+                                              });
+    return (trip != range.second && trip->request == request2 ? trip : nullptr);
+}
@@ -0,0 +1,114 @@
+/*
+ * ShareabilityGraph.hpp
+ *
+ * Pairs of pending requests which can be served by the same vehicle
+ */
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <boost/function.hpp>
+
+#include "message/MobilityServiceControllerMessage.hpp"
+
+namespace sim_mob
+{
+
+class Node;
+
+/**
+ * Order in which two shared requests are picked up (o) and dropped off (d). Request 1 is the one with the lower index
+ */
+enum SharedTripSequence
+{
+    O1_O2_D1_D2,
+    O2_O1_D2_D1,
+    O1_O2_D2_D1,
+    O2_O1_D1_D2
+};
+
+/**
+ * Undirected graph with a vertex per request and an edge between every two requests which can be shared, i.e. for
+ * which some sequence of pickups and dropoffs keeps the travel time of both users within their desired travel time plus
+ * their tolerated extra time. Each edge holds the best such sequence.
+ *
+ * Evaluating all the pairs is quadratic in the number of requests. When the travel times are bounded from below by the
+ * euclidean distance at some speed, the pairs whose origins are too far apart to be shared by either user are pruned with
+ * a spatial grid over the origins, before being evaluated. The remaining pairs are evaluated in parallel, and the edges
+ * are stored in compressed sparse row form.
+ */
+class ShareabilityGraph
+{
+public:
+    /**Travel time from a node to another; must be safe to call from several threads at the same time*/
+    typedef boost::function<double (const Node*, const Node*)> TravelTimeFunction;
+
+    /**An edge of the graph, as seen from one of its ends*/
+    struct SharedTrip
+    {
+        /**index of the request at the other end*/
+        unsigned request;
+
+        /**sum of the travel times of the two users*/
+        double totalTime;
+
+        SharedTripSequence sequence;
+    };
+
+    /**
+     * Builds the graph
+     *
+     * @param requests the pending requests
+     * @param desiredTravelTimes the travel time of each request if served alone
+     * @param travelTime estimates the travel time between two nodes
+     * @param lowerBoundSpeed a speed s such that travelTime(a, b) >= distance(a, b) / s for any pair of nodes;
+     *        0 if it is not known, in which case all pairs are evaluated
+     */
+    ShareabilityGraph(const std::vector<TripRequestMessage>& requests, const std::vector<double>& desiredTravelTimes,
+                      const TravelTimeFunction& travelTime, double lowerBoundSpeed);
+
+    size_t getNumRequests() const
+    {
+        return offsets.size() - 1;
+    }
+
+    /**
+     * @return the number of edges (pairs of requests which can be shared)
+     */
+    size_t getNumEdges() const
+    {
+        return trips.size() / 2;
+    }
+
+    /**
+     * @return the number of pairs which were evaluated, i.e. which survived the pruning
+     */
+    size_t getNumEvaluatedPairs() const
+    {
+        return numEvaluatedPairs;
+    }
+
+    /**
+     * @return the range of edges of a request, sorted by the index of the other request
+     */
+    std::pair<const SharedTrip*, const SharedTrip*> getSharedTrips(unsigned request) const
+    {
+        return std::make_pair(trips.data() + offsets[request], trips.data() + offsets[request + 1]);
+    }
+
+    /**
+     * @return the edge between two requests; nullptr if they cannot be shared
+     */
+    const SharedTrip* findSharedTrip(unsigned request1, unsigned request2) const;
+
+private:
+    /**edges of request i are trips[offsets[i]] to trips[offsets[i + 1] - 1]*/
+    std::vector<size_t> offsets;
+    std::vector<SharedTrip> trips;
+
+    size_t numEvaluatedPairs;
+};
+
+}
@@ -7,6 +7,9 @@
 
 #include "SharedController.hpp"
 
+#include <memory>
+#include <unordered_set>
+#include <boost/bind.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/max_cardinality_matching.hpp>
 
@@ -15,6 +18,7 @@
 #include "message/MessageBus.hpp"
 #include "message/MobilityServiceControllerMessage.hpp"
 #include "path/PathSetManager.hpp"
+#include "ShareabilityGraph.hpp"
 #include <sys/time.h>
 
 
@@ -58,20 +62,40 @@ void SharedController::computeSchedules()
     profilingTime_previous = profilingTime_current;
 
     // 1. Calculate times for direct trips
-    unsigned int requestIndex = 0;
-    auto request = requestQueue.begin();
-    while (request != requestQueue.end())
-    {
-        const Node *startNode = (*request).startNode;
-        const Node *destinationNode = (*request).destinationNode;
+    validRequests.assign(requestQueue.begin(), requestQueue.end());
 
-        validRequests.push_back(*request);
+    ShareabilityGraph::TravelTimeFunction travelTime;
+    std::unique_ptr<TravelTimeMatrix> ttMatrix;
+    if (ttEstimateType == EUCLIDEAN_ESTIMATION)
+    {
+        // Cheap enough to be computed for the pairs which survive the pruning only
+        double (OnCallController::*nodeTT)(const Node *, const Node *, TT_EstimateType) const = &OnCallController::getTT;
+        travelTime = boost::bind(nodeTT, this, _1, _2, ttEstimateType);
+    }
+    else
+    {
+        // The travel times between all the pickup and dropoff nodes are estimated at once, rather than pair by pair
+        std::vector<const Node *> requestNodes;
+        std::unordered_set<const Node *> requestNodeSet;
+        for (const TripRequestMessage &request : validRequests)
+        {
+            if (requestNodeSet.insert(request.startNode).second)
+            {
+                requestNodes.push_back(request.startNode);
+            }
+            if (requestNodeSet.insert(request.destinationNode).second)
+            {
+                requestNodes.push_back(request.destinationNode);
+            }
+        }
+        ttMatrix.reset(new TravelTimeMatrix(getTTMatrix(requestNodes, requestNodes, ttEstimateType)));
+        travelTime = boost::bind(&TravelTimeMatrix::get, ttMatrix.get(), _1, _2);
+    }
 
-        double tripTime = getTT(startNode, destinationNode, ttEstimateType);
+    for (const TripRequestMessage &request : validRequests)
+    {
+        double tripTime = travelTime(request.startNode, request.destinationNode);
         desiredTravelTimes.push_back(tripTime);
-
-        request++;
-        requestIndex++;
     }
 
 #ifndef NDEBUG
@@ -100,179 +124,33 @@ void SharedController::computeSchedules()
         // 2. Add valid shared trips to graph
         // We construct a graph in which each node represents a trip. We will later draw and edge between two
         // two trips if they can be shared. Nodes are numbered starting from 0 in the graph
+        const ShareabilityGraph shareabilityGraph(validRequests, desiredTravelTimes, travelTime,
+                                                  getTTLowerBoundSpeed(ttEstimateType));
+
         boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> graph(validRequests.size());
         std::vector<boost::graph_traits<boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>>::vertex_descriptor> mate(
                 validRequests.size());
 
-        std::map<std::pair<unsigned int, unsigned int>, std::pair<double, std::string>> bestTrips;
-
-        auto request1 = validRequests.begin();
-        unsigned int request1Index = 0;
-        while (request1 != validRequests.end())
+        for (unsigned int requestIndex = 0; requestIndex < validRequests.size(); requestIndex++)
         {
-            // We check if request1 can be shared with some of the following requests in the queue
-            auto request2 = request1 + 1;
-            unsigned int request2Index = request1Index + 1;
-            while (request2 != validRequests.end())
+            const std::pair<const ShareabilityGraph::SharedTrip *, const ShareabilityGraph::SharedTrip *> sharedTrips =
+                    shareabilityGraph.getSharedTrips(requestIndex);
+            for (const ShareabilityGraph::SharedTrip *sharedTrip = sharedTrips.first; sharedTrip != sharedTrips.second; ++sharedTrip)
             {
-#ifndef NDEBUG
-                //ControllerLog() << "DebugPrint, Checking if we can combine request " << request1Index << " and request " << request2Index << std::endl;
-
-#endif
-                const Node *startNode1 = (*request1).startNode;
-                const Node *destinationNode1 = (*request1).destinationNode;
-
-                const Node *startNode2 = (*request2).startNode;
-                const Node *destinationNode2 = (*request2).destinationNode;
-
-                // We now check if we can combine trip 1 and trip 2. They can be combined in different ways.
-                // For example, we can
-                //      i) pick up user 1, ii) pick up user 2, iii) drop off user 1, iv) drop off user 2
-                // (which we indicate with o1 o2 d1 d2), or we can
-                //      i) pick up user 2, ii) pick up user 1, iii) drop off user 2, iv) drop off user 1
-                // and so on. When trip 1 is combined with trip 2, user 1 experiences some additional delays
-                // w.r.t. the case when each user travels alone. A combination is feasible if this extra-delay
-                // induced by sharing is below a certain threshold.
-                // In the following line, we check what are the feasible combination and we select the
-                // "best", i.e., the one with the minimum induce extra-delay.
-
-                //{ o1 o2 d1 d2
-                // We compute the travel time that user 1 would experience in this case
-                double tripTime1 = getTT(startNode1, startNode2, ttEstimateType) + getTT(startNode2, destinationNode1,
-                                                                                         ttEstimateType);
-
-                // We also compute the travel time that user 2 would experience
-                double tripTime2 = getTT(startNode2, destinationNode1, ttEstimateType) + getTT(destinationNode1,
-                                                                                               destinationNode2,
-                                                                                               ttEstimateType);
-
-                if ((tripTime1 <= desiredTravelTimes.at(request1Index) + (*request1).extraTripTimeThreshold)
-                    && (tripTime2 <= desiredTravelTimes.at(request2Index) + (*request2).extraTripTimeThreshold))
-                {
-                    bestTrips[std::make_pair(request1Index, request2Index)] = std::make_pair(tripTime1 + tripTime2,
-                                                                                             "o1o2d1d2");
-                    add_edge(request1Index, request2Index, graph);
-                }
-                //} o1 o2 d1 d2
-
-                //{ o2 o1 d2 d1
-                tripTime1 = getTT(startNode1, destinationNode2, ttEstimateType) + getTT(destinationNode2,
-                                                                                        destinationNode1,
-                                                                                        ttEstimateType);
-
-                tripTime2 = getTT(startNode2, startNode1, ttEstimateType) + getTT(startNode1, destinationNode2,
-                                                                                  ttEstimateType);
-
-                if ((tripTime1 <= desiredTravelTimes.at(request1Index) + (*request1).extraTripTimeThreshold)
-                    && (tripTime2 <= desiredTravelTimes.at(request2Index) + (*request2).extraTripTimeThreshold))
+                if (requestIndex < sharedTrip->request)
                 {
-                    if (bestTrips.count(std::make_pair(request1Index, request2Index)) > 0)
-                    {
-                        std::pair<double, std::string> currBestTrip = bestTrips[std::make_pair(request1Index,
-                                                                                               request2Index)];
-
-                        if (tripTime1 + tripTime2 < currBestTrip.first)
-                        {
-                            bestTrips[std::make_pair(request1Index, request2Index)] = std::make_pair(
-                                    tripTime1 + tripTime2, "o2o1d2d1");
-                        }
-                    }
-                    else
-                    {
-                        bestTrips[std::make_pair(request1Index, request2Index)] = std::make_pair(tripTime1 + tripTime2,
-                                                                                                 "o2o1d2d1");
-                    }
-
-                    add_edge(request1Index, request2Index, graph);
+                    add_edge(requestIndex, sharedTrip->request, graph);
                 }
-                //} o2 o1 d2 d1
-
-                //{ o1 o2 d2 d1
-                tripTime1 = getTT(startNode1, startNode2, ttEstimateType) + getTT(startNode2, destinationNode2,
-                                                                                  ttEstimateType) +
-                            getTT(destinationNode2, destinationNode1, ttEstimateType);
-
-                // tripTime2 is ok, because user 2 does the same path as she was alone in the car
-
-                if (tripTime1 <= desiredTravelTimes.at(request1Index) + (*request1).extraTripTimeThreshold)
-                {
-                    if (bestTrips.count(std::make_pair(request1Index, request2Index)) > 0)
-                    {
-                        std::pair<double, std::string> currBestTrip = bestTrips[std::make_pair(request1Index,
-                                                                                               request2Index)];
-
-                        if (tripTime1 + tripTime2 < currBestTrip.first)
-                        {
-                            bestTrips[std::make_pair(request1Index, request2Index)] = std::make_pair(
-                                    tripTime1 + tripTime2, "o1o2d2d1");
-                        }
-                    }
-                    else
-                    {
-                        bestTrips[std::make_pair(request1Index, request2Index)] = std::make_pair(tripTime1 + tripTime2,
-                                                                                                 "o1o2d2d1");
-                    }
-
-                    add_edge(request1Index, request2Index, graph);
-                }
-                //} o1 o2 d2 d1
-
-                //{ o2 o1 d1 d2
-                tripTime2 = getTT(startNode2, startNode1, ttEstimateType) + getTT(startNode1, destinationNode1,
-                                                                                  ttEstimateType) +
-                            getTT(destinationNode1, destinationNode2, ttEstimateType);
-
-                // tripTime2 is ok, because user 1 does the same path as she was alone in the car
-
-                if (tripTime2 <= desiredTravelTimes.at(request2Index) + (*request2).extraTripTimeThreshold)
-                {
-                    if (bestTrips.count(std::make_pair(request1Index, request2Index)) > 0)
-                    {
-                        std::pair<double, std::string> currBestTrip = bestTrips[std::make_pair(request1Index,
-                                                                                               request2Index)];
-
-                        if (tripTime1 + tripTime2 < currBestTrip.first)
-                        {
-                            bestTrips[std::make_pair(request1Index, request2Index)] = std::make_pair(
-                                    tripTime1 + tripTime2, "o2o1d1d2");
-                        }
-                    }
-                    else
-                    {
-                        bestTrips[std::make_pair(request1Index, request2Index)] = std::make_pair(tripTime1 + tripTime2,
-                                                                                                 "o2o1d1d2");
-                    }
-
-                    add_edge(request1Index, request2Index, graph);
-#ifndef NDEBUG
-                    if (request1Index >= requestQueue.size()  || request2Index >= requestQueue.size())
-                    {
-                        std::stringstream msg; msg<< __FILE__<<":"<<__LINE__<< ":"<<" request1Index="<< request1Index<<
-                            " and request2Index="<<request2Index<< ", while they should both be requestQueue.size()= < "<<requestQueue.size();
-                        throw std::runtime_error(msg.str() );
-                    }
-
-                    if (requestQueue.size() != howManyRequests)
-                    {
-                        std::stringstream msg; msg<<"requestQueue.size() changed. Before it was "<< howManyRequests
-                        <<", while now it is "<<requestQueue.size();
-                    }
-#endif
-                }
-                //} o2 o1 d1 d2
-
-                request2++;
-                request2Index++;
             }
-            request1++;
-            request1Index++;
         }
 
-
         profilingTime_current = clock();
         profilingTime_graphConstruction = profilingTime_current - profilingTime_previous;
         profilingTime_previous = profilingTime_current;
 
+        ControllerLog() << "Shareability graph: " << shareabilityGraph.getNumEdges() << " shareable pairs out of "
+                        << shareabilityGraph.getNumEvaluatedPairs() << " evaluated" << std::endl;
+
         ControllerLog() << "About to perform matching on " << requestQueue.size() << " requests and "
                         << availableDrivers.size() <<
                         " drivers. Wish me luck" << std::endl;
@@ -308,34 +186,39 @@ void SharedController::computeSchedules()
                 const unsigned request2Idx = mate[*vi];
                 const TripRequestMessage &request1 = validRequests.at(request1Idx);
                 const TripRequestMessage &request2 = validRequests.at(request2Idx);
-                const std::pair<double, std::string> sharedTripInfo = bestTrips.at(
-                        std::make_pair(request1Idx, request2Idx));
-                const unsigned &totalTime = sharedTripInfo.first;
-                const string &sequence = sharedTripInfo.second;
+                const ShareabilityGraph::SharedTrip *sharedTrip = shareabilityGraph.findSharedTrip(request1Idx, request2Idx);
+                if (!sharedTrip)
+                {
+                    std::stringstream msg;
+                    msg << __FILE__ << ":" << __LINE__ << ":Requests " << request1Idx << " and " << request2Idx
+                        << " are matched but they cannot be shared";
+                    throw std::runtime_error(msg.str());
+                }
+                const SharedTripSequence sequence = sharedTrip->sequence;
 
                 TripRequestMessage firstPickUp, secondPickUp, firstDropOff, secondDropOff;
-                if (sequence == "o1o2d1d2")
+                if (sequence == O1_O2_D1_D2)
                 {
                     firstPickUp = validRequests.at(request1Idx);
                     secondPickUp = validRequests.at(request2Idx);
                     firstDropOff = validRequests.at(request1Idx);
                     secondDropOff = validRequests.at(request2Idx);
                 }
-                else if (sequence == "o2o1d2d1")
+                else if (sequence == O2_O1_D2_D1)
                 {
                     firstPickUp = validRequests.at(request2Idx);
                     secondPickUp = validRequests.at(request1Idx);
                     firstDropOff = validRequests.at(request2Idx);
                     secondDropOff = validRequests.at(request1Idx);
                 }
-                else if (sequence == "o1o2d2d1")
+                else if (sequence == O1_O2_D2_D1)
                 {
                     firstPickUp = validRequests.at(request1Idx);
                     secondPickUp = validRequests.at(request2Idx);
                     firstDropOff = validRequests.at(request2Idx);
                     secondDropOff = validRequests.at(request1Idx);
                 }
-                else if (sequence == "o2o1d1d2")
+                else if (sequence == O2_O1_D1_D2)
                 {
                     firstPickUp = validRequests.at(request2Idx);
                     secondPickUp = validRequests.at(request1Idx);
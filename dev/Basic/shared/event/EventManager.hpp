@@ -78,8 +78,7 @@ namespace sim_mob {
             void schedule(const timeslice& target, L* listener,
                    DECLARATION_CALLBACK_PTR(callback, L, T)) {
                 if (callback) {
-                    Callback cb(new CallbackImpl<L, T>(callback));
-                    schedule(target, listener, cb);
+                    schedule(target, listener, Callback::create(callback));
                 } else {
                     schedule(target, listener, Callback());
                 }
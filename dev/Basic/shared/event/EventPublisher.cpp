@@ -9,88 +9,153 @@
  * Created on March 7, 2013, 11:30 AM
  */
 
-#include <boost/property_map/property_map.hpp>
+#include <algorithm>
 
 #include "EventPublisher.hpp"
 #include "util/LangHelpers.hpp"
 
 using namespace sim_mob::event;
-using std::list;
-using std::pair;
 
 namespace {
-    //Helper functions declaration.
-    bool exitsEvent(const ContextListenersMap& map, EventId id);
-    void remove(ListenersList& listenersList, EventListenerPtr listener);
-    void publishEvent(ContextListenersMap& map, bool globalCtx, EventPublisher* sender,
-            EventId id, Context ctx, const EventArgs& args);
-    void subscribeListener(ContextListenersMap& map, EventId id, Context ctx,
-            EventListenerPtr listener, Callback callback);
+    /**
+     * Tells if the listener of an entry was unsubscribed.
+     */
+    bool isRemoved(const Entry& entry) {
+        return !entry.listener;
+    }
 }
 
 /**********************
  * ListenerEntry
  **********************/
-ListenerEntry::ListenerEntry(EventListenerPtr listener, Callback callback) {
-    this->callback = callback;
-    this->listener = listener;
+ListenerEntry::ListenerEntry(EventListenerPtr listener, Callback callback)
+: listener(listener), callback(callback) {
 }
 
 /**********************
  * Event Publisher
  **********************/
-EventPublisher::EventPublisher() {
+EventPublisher::EventSlot::EventSlot(EventId id)
+: id(id), registered(true), published(0), hasRemovedEntries(false) {
+}
+
+EventPublisher::PendingSubscription::PendingSubscription(EventId id, Context context, const Entry& entry)
+: id(id), context(context), entry(entry) {
+}
+
+EventPublisher::EventPublisher() : publishDepth(0), hasUnregisteredSlots(false) {
 }
 
 EventPublisher::~EventPublisher() {
 }
 
 void EventPublisher::registerEvent(EventId id) {
-    if (!exitsEvent(listeners, id)) {
-        listeners.insert(pair<EventId, ContextMap>(id, ContextMap()));
+    if (!findSlot(id)) {
+        slots.push_back(EventSlot(id));
     }
 }
 
 void EventPublisher::unRegisterEvent(EventId id) {
-    if (exitsEvent(listeners, id)) {
-        // remove all context listeners.
-        ContextListenersMap::iterator ctxMapItr = listeners.find(id);
-        if (ctxMapItr != listeners.end()) {
-            ContextMap& cm = ctxMapItr->second;
-            cm.clear();
+    EventSlot* slot = findSlot(id);
+    if (!slot) {
+        return;
+    }
+    if (publishDepth == 0) {
+        for (std::deque<EventSlot>::iterator it = slots.begin(); it != slots.end(); ++it) {
+            if (&(*it) == slot) {
+                slots.erase(it);
+                break;
+            }
+        }
+        return;
+    }
+
+    // the listeners may be being notified; they are removed once publishing is over.
+    slot->registered = false;
+    hasUnregisteredSlots = true;
+    for (ListenerEntries::iterator it = slot->global.begin(); it != slot->global.end(); ++it) {
+        it->listener = nullptr;
+    }
+    for (ContextListeners::iterator ctxIt = slot->contexts.begin(); ctxIt != slot->contexts.end(); ++ctxIt) {
+        for (ListenerEntries::iterator it = ctxIt->second.begin(); it != ctxIt->second.end(); ++it) {
+            it->listener = nullptr;
+        }
+    }
+    for (std::vector<PendingSubscription>::iterator it = pendingSubscriptions.begin(); it != pendingSubscriptions.end(); ++it) {
+        if (it->id == id) {
+            it->entry.listener = nullptr;
         }
-        //erase entries in 
-        listeners.erase(id);
     }
 }
 
 bool EventPublisher::isEventRegistered(EventId id) const {
-    return exitsEvent(listeners, id);
+    return findSlot(id) != nullptr;
 }
 
 void EventPublisher::publish(EventId id, const EventArgs& args) {
-    // publish using the global context.    
-    publishEvent(listeners, true, this, id, this, args);
+    // publish using the global context.
+    EventSlot* slot = findSlot(id);
+    if (!slot) {
+        return;
+    }
+    slot->published++;
+    publishDepth++;
+    try {
+        notify(slot->global, id, this, args);
+    } catch (...) {
+        if (--publishDepth == 0) {
+            applyPendingChanges();
+        }
+        throw;
+    }
+    if (--publishDepth == 0) {
+        applyPendingChanges();
+    }
 }
 
 void EventPublisher::publish(EventId id, Context ctx, const EventArgs& args) {
-    publishEvent(listeners, true, this, id, this, args);
-    //notify context listeners.
-    publishEvent(listeners, false, this, id, ctx, args);
+    EventSlot* slot = findSlot(id);
+    if (!slot) {
+        return;
+    }
+    slot->published++;
+    publishDepth++;
+    try {
+        notify(slot->global, id, this, args);
+        //notify context listeners.
+        ListenerEntries* entries = findEntries(*slot, ctx);
+        if (entries) {
+            notify(*entries, id, ctx, args);
+        }
+    } catch (...) {
+        if (--publishDepth == 0) {
+            applyPendingChanges();
+        }
+        throw;
+    }
+    if (--publishDepth == 0) {
+        applyPendingChanges();
+    }
 }
 
 void EventPublisher::subscribe(EventId id, EventListenerPtr listener,
         Context context) {
-    Callback cb(new CallbackImpl<EventListener, EventArgs>
-        (&EventListener::onEvent));
-    subscribe(id, listener, cb, context);
+    subscribe(id, listener, Callback(), context);
 }
 
 void EventPublisher::subscribe(EventId id, EventListenerPtr listener,
         Callback callback, Context ctx) {
-    if (exitsEvent(listeners, id) && listener && callback) {
-        subscribeListener(listeners, id, (ctx) ? ctx : this,
-                listener, callback);
+    EventSlot* slot = findSlot(id);
+    if (!slot || !listener) {
+        return;
+    }
+    Context context = (ctx) ? ctx : this;
+    if (publishDepth > 0) {
+        pendingSubscriptions.push_back(PendingSubscription(id, context, Entry(listener, callback)));
+    } else if (context == this) {
+        slot->global.push_back(Entry(listener, callback));
+    } else {
+        slot->contexts[context].push_back(Entry(listener, callback));
     }
 }
 
@@ -100,40 +165,51 @@ void EventPublisher::unSubscribe(EventId id, EventListenerPtr listener) {
 
 void EventPublisher::unSubscribe(EventId id, Context ctx,
         EventListenerPtr listener) {
-    if (exitsEvent(listeners, id) && listener) {
-        ContextListenersMap::iterator ctxMapItr = listeners.find(id);
-        if (ctxMapItr != listeners.end()) {
-            ContextMap::iterator mapItr = ctxMapItr->second.find(ctx);
-            if (mapItr != ctxMapItr->second.end()) { //Context exists
-                ListenersList& ll = mapItr->second;
-                remove(ll, listener);
-                //if list is empty then remove the context.
-                if (ll.empty()) {
-                    //remove the list
-                    ctxMapItr->second.erase(ctx);
-                }
-            }
+    EventSlot* slot = findSlot(id);
+    if (!slot || !listener) {
+        return;
+    }
+    ListenerEntries* entries = findEntries(*slot, ctx);
+    if (entries && removeListener(*entries, listener, *slot)) {
+        //if list is empty then remove the context.
+        if (entries->empty() && ctx != this) {
+            slot->contexts.erase(ctx);
+        }
+        return;
+    }
+    for (std::vector<PendingSubscription>::iterator it = pendingSubscriptions.begin(); it != pendingSubscriptions.end(); ++it) {
+        if (it->id == id && it->context == ctx && it->entry.listener == listener) {
+            pendingSubscriptions.erase(it);
+            return;
         }
     }
 }
 
 void EventPublisher::unSubscribeAll(EventListenerPtr listener) {
-    if (listener) {
-        //TODO: this method is very inefficient we need something better. But for now...
-        for (ContextListenersMap::iterator itr = listeners.begin(); itr != listeners.end(); itr++) {
-            ContextMap& cm = itr->second;
-            for (ContextMap::iterator mapItr = cm.begin(); mapItr != cm.end(); mapItr++) {
-                ListenersList& ll = mapItr->second;
-                for (ListenersList::iterator listItr = ll.begin(); listItr != ll.end(); listItr++) {
-                    Entry& entry = *listItr;
-                    if (entry.listener == listener) {
-                        listItr = ll.erase(listItr);
-                        break;
-                    }
-                }
+    if (!listener) {
+        return;
+    }
+    for (std::deque<EventSlot>::iterator slotIt = slots.begin(); slotIt != slots.end(); ++slotIt) {
+        EventSlot& slot = *slotIt;
+        if (!slot.registered) {
+            continue;
+        }
+        removeListener(slot.global, listener, slot);
+        ContextListeners::iterator ctxIt = slot.contexts.begin();
+        while (ctxIt != slot.contexts.end()) {
+            removeListener(ctxIt->second, listener, slot);
+            if (ctxIt->second.empty()) {
+                ctxIt = slot.contexts.erase(ctxIt);
+            } else {
+                ++ctxIt;
             }
         }
     }
+    for (std::vector<PendingSubscription>::iterator it = pendingSubscriptions.begin(); it != pendingSubscriptions.end(); ++it) {
+        if (it->entry.listener == listener) {
+            it->entry.listener = nullptr;
+        }
+    }
 }
 
 void EventPublisher::unSubscribeAll(EventId id) {
@@ -141,81 +217,119 @@ void EventPublisher::unSubscribeAll(EventId id) {
 }
 
 void EventPublisher::unSubscribeAll(EventId id, Context ctx) {
-    if (exitsEvent(listeners, id)) {
-        ContextListenersMap::iterator ctxMapItr = listeners.find(id);
-        if (ctxMapItr != listeners.end()) {
-            ContextMap::iterator mapItr = ctxMapItr->second.find(ctx);
-            if (mapItr != ctxMapItr->second.end()) { //Context Id does exists
-                ListenersList& ll = mapItr->second;
-                ll.clear();
-                ctxMapItr->second.erase(ctx);
+    EventSlot* slot = findSlot(id);
+    if (!slot) {
+        return;
+    }
+    ListenerEntries* entries = findEntries(*slot, ctx);
+    if (entries) {
+        if (publishDepth > 0) {
+            for (ListenerEntries::iterator it = entries->begin(); it != entries->end(); ++it) {
+                it->listener = nullptr;
             }
+            slot->hasRemovedEntries = true;
+        } else if (ctx == this) {
+            entries->clear();
+        } else {
+            slot->contexts.erase(ctx);
+        }
+    }
+    for (std::vector<PendingSubscription>::iterator it = pendingSubscriptions.begin(); it != pendingSubscriptions.end(); ++it) {
+        if (it->id == id && it->context == ctx) {
+            it->entry.listener = nullptr;
         }
     }
 }
 
-/**********************
- * 
- * HELPER FUNCTIONS
- *
- **********************/
-namespace {
+unsigned long long EventPublisher::getPublishCount(EventId id) const {
+    const EventSlot* slot = findSlot(id);
+    return (slot) ? slot->published : 0;
+}
+
+EventPublisher::EventSlot* EventPublisher::findSlot(EventId id) {
+    for (std::deque<EventSlot>::iterator it = slots.begin(); it != slots.end(); ++it) {
+        if (it->id == id && it->registered) {
+            return &(*it);
+        }
+    }
+    return nullptr;
+}
+
+const EventPublisher::EventSlot* EventPublisher::findSlot(EventId id) const {
+    for (std::deque<EventSlot>::const_iterator it = slots.begin(); it != slots.end(); ++it) {
+        if (it->id == id && it->registered) {
+            return &(*it);
+        }
+    }
+    return nullptr;
+}
+
+EventPublisher::ListenerEntries* EventPublisher::findEntries(EventSlot& slot, Context ctx) {
+    if (ctx == this) {
+        return &slot.global;
+    }
+    ContextListeners::iterator it = slot.contexts.find(ctx);
+    return (it != slot.contexts.end()) ? &(it->second) : nullptr;
+}
+
+void EventPublisher::notify(ListenerEntries& entries, EventId id, Context ctx, const EventArgs& args) {
+    //entries are neither added nor erased while publishing, so the vector is iterated in place.
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].listener) {
+            const Entry entry = entries[i];
+            entry.callback(entry.listener, id, ctx, this, args);
+        }
+    }
+}
 
-    bool exitsEvent(const ContextListenersMap& map, EventId id) {
-        return (map.find(id) != map.end());
-    }
-
-    void subscribeListener(ContextListenersMap& map, EventId id, Context ctx,
-            EventListenerPtr listener, Callback callback) {
-        ContextListenersMap::iterator ctxMapItr = map.find(id);
-        if (ctxMapItr != map.end()) {
-            ContextMap::iterator mapItr = ctxMapItr->second.find(ctx);
-            ListenersList* ctxList = 0;
-            if (mapItr == ctxMapItr->second.end()) { //Context Id does not exists
-                std::pair < ContextMap::iterator, bool> ret;
-                ret = ctxMapItr->second.insert(
-                        pair<Context, ListenersList>(ctx, ListenersList()));
-                ctxList = &(ret.first->second);
+bool EventPublisher::removeListener(ListenerEntries& entries, EventListenerPtr listener, EventSlot& slot) {
+    for (ListenerEntries::iterator it = entries.begin(); it != entries.end(); ++it) {
+        if (it->listener == listener) {
+            if (publishDepth > 0) {
+                it->listener = nullptr;
+                slot.hasRemovedEntries = true;
             } else {
-                ctxList = &(mapItr->second);
+                entries.erase(it);
             }
-            ctxList->push_back(Entry(listener, callback));
+            return true;
         }
     }
+    return false;
+}
 
-    void publishEvent(ContextListenersMap& map, bool globalCtx, EventPublisher* sender,
-            EventId id, Context ctx, const EventArgs& args) {
-        //notify context listeners.
-        ContextListenersMap::iterator ctxMapItr = map.find(id);
-        if (ctxMapItr != map.end()) {
-            ContextMap::iterator mapItr = ctxMapItr->second.find(ctx);
-            if (mapItr != ctxMapItr->second.end()) { // Event ID is registered.
-                ListenersList& lst = mapItr->second;
-                ListenersList::iterator lstItr = lst.begin();
-                while (lstItr != lst.end()) {
-                    // notify listener
-                    if (globalCtx) {
-                        ((*(*lstItr).callback))((*lstItr).listener, id, sender, sender, args);
-                    } else {
-                        ((*(*lstItr).callback))((*lstItr).listener, id, ctx, sender, args);
-                    }
-                    lstItr++;
-                }
-            }
+void EventPublisher::applyPendingChanges() {
+    if (hasUnregisteredSlots) {
+        std::deque<EventSlot>::iterator it = slots.begin();
+        while (it != slots.end()) {
+            it = (it->registered) ? it + 1 : slots.erase(it);
         }
+        hasUnregisteredSlots = false;
     }
 
-    void remove(ListenersList& listenersList, EventListenerPtr listener) {
-        if (listener) {
-            ListenersList::iterator lstItr = listenersList.begin();
-            while (lstItr != listenersList.end()) {
-                if ((*lstItr).listener == listener) {
-                    Entry& entry = *lstItr;
-                    listenersList.erase(lstItr);
-                    return;
-                }
-                lstItr++;
+    for (std::deque<EventSlot>::iterator slotIt = slots.begin(); slotIt != slots.end(); ++slotIt) {
+        EventSlot& slot = *slotIt;
+        if (!slot.hasRemovedEntries) {
+            continue;
+        }
+        slot.global.erase(std::remove_if(slot.global.begin(), slot.global.end(), isRemoved), slot.global.end());
+        ContextListeners::iterator ctxIt = slot.contexts.begin();
+        while (ctxIt != slot.contexts.end()) {
+            ListenerEntries& entries = ctxIt->second;
+            entries.erase(std::remove_if(entries.begin(), entries.end(), isRemoved), entries.end());
+            if (entries.empty()) {
+                ctxIt = slot.contexts.erase(ctxIt);
+            } else {
+                ++ctxIt;
             }
         }
+        slot.hasRemovedEntries = false;
+    }
+
+    std::vector<PendingSubscription> subscriptions;
+    subscriptions.swap(pendingSubscriptions);
+    for (std::vector<PendingSubscription>::const_iterator it = subscriptions.begin(); it != subscriptions.end(); ++it) {
+        if (it->entry.listener) {
+            subscribe(it->id, it->entry.listener, it->entry.callback, it->context);
+        }
     }
 }
@@ -11,9 +11,10 @@
 
 #pragma once
 
-#include <list>
+#include <cstring>
+#include <deque>
+#include <vector>
 #include <boost/unordered_map.hpp>
-#include <boost/shared_ptr.hpp>
 #include "EventListener.hpp"
 
 ///Helper macro for callback pointer declaration. 
@@ -28,58 +29,77 @@ namespace sim_mob {
 
     namespace event {
 
+        typedef EventListener* EventListenerPtr;
+
         /**
-         * Interface for Callbacks.
+         * Member function of a listener handling an event.
+         *
+         * The member function pointer is kept by value together with a function
+         * restoring its type, so that callbacks are stored inline in the listener
+         * tables and calling one needs neither a heap object nor a virtual call.
+         * An empty callback calls EventListener::onEvent.
          */
-        struct I_Callback {
+        class Callback {
         public:
 
-            virtual ~I_Callback() {
+            Callback() : invoker(nullptr) {
             }
 
-            virtual void operator()(
-                    sim_mob::event::EventListener* listener,
-                    sim_mob::event::EventId id,
-                    sim_mob::event::Context ctxId,
-                    sim_mob::event::EventPublisher* sender,
-                    const sim_mob::event::EventArgs& args) = 0;
-        };
-
-        /**
-         * Callback function template implementation.
-         */
-        template <typename L, typename T>
-        struct CallbackImpl : public I_Callback {
-            typedef DECLARATION_CALLBACK_PTR(CallbackRef, L, T);
-            
-        public:
-            CallbackImpl(CallbackRef callback) 
-                : callback(callback) {
+            /**
+             * Creates the callback calling the given member function of a listener of type L.
+             */
+            template <typename L, typename T>
+            static Callback create(DECLARATION_CALLBACK_PTR(callback, L, T)) {
+                typedef DECLARATION_CALLBACK_PTR(CallbackRef, L, T);
+                static_assert(sizeof(CallbackRef) <= sizeof(Storage), "member function pointer does not fit the callback storage");
+                Callback cb;
+                std::memcpy(cb.storage.bytes, &callback, sizeof(CallbackRef));
+                cb.invoker = &invoke<L, T>;
+                return cb;
             }
 
-            virtual ~CallbackImpl() {
+            explicit operator bool() const {
+                return invoker != nullptr;
             }
 
-            void operator()(
-                    sim_mob::event::EventListener* listener,
-                    sim_mob::event::EventId id,
-                    sim_mob::event::Context ctxId,
-                    sim_mob::event::EventPublisher* sender,
-                    const sim_mob::event::EventArgs& args) {
-                if (listener) {
-                    (dynamic_cast<L*> (listener)->*callback)(id, ctxId, sender,
-                            dynamic_cast<const T&> (args));
+            void operator()(EventListener* listener, EventId id, Context ctxId,
+                    EventPublisher* sender, const EventArgs& args) const {
+                if (invoker) {
+                    invoker(*this, listener, id, ctxId, sender, args);
+                } else {
+                    listener->onEvent(id, ctxId, sender, args);
                 }
             }
+
         private:
-            CallbackRef callback;
-        };
+            typedef void (*Invoker)(const Callback& callback, EventListener* listener,
+                    EventId id, Context ctxId, EventPublisher* sender, const EventArgs& args);
 
-        typedef EventListener* EventListenerPtr;
-        typedef boost::shared_ptr<I_Callback> Callback;
+            typedef DECLARATION_CALLBACK_PTR(GenericCallback, EventListener, EventArgs);
+
+            union Storage {
+                GenericCallback generic;
+                char bytes[sizeof(GenericCallback)];
+            };
+
+            template <typename L, typename T>
+            static void invoke(const Callback& cb, EventListener* listener,
+                    EventId id, Context ctxId, EventPublisher* sender, const EventArgs& args) {
+                typedef DECLARATION_CALLBACK_PTR(CallbackRef, L, T);
+                CallbackRef callback;
+                std::memcpy(&callback, cb.storage.bytes, sizeof(CallbackRef));
+                //the listener was given as an L when subscribing.
+                (static_cast<L*> (listener)->*callback)(id, ctxId, sender,
+                        dynamic_cast<const T&> (args));
+            }
+
+            Invoker invoker;
+            Storage storage;
+        };
 
         /**
          * Struct to store a Listener entry.
+         * The listener is null once it has been unsubscribed.
          */
         typedef struct ListenerEntry {
             ListenerEntry(EventListenerPtr listener, Callback callback);
@@ -87,14 +107,15 @@ namespace sim_mob {
             Callback callback;
         } Entry;
 
-        // map for global listeners.
-        typedef std::list<Entry> ListenersList;
-        // maps for listeners with context.
-        typedef boost::unordered_map<Context, ListenersList> ContextMap;
-        typedef boost::unordered_map<EventId, ContextMap> ContextListenersMap;
-
         /**
          * Generic implementation of event publisher.
+         *
+         * Each registered event has a slot holding contiguous vectors of listener
+         * entries: one for the global listeners and one per context. Listeners
+         * subscribed or unsubscribed by a listener while an event is being
+         * published are only added or removed once the publication is over, so
+         * publishing iterates the vectors without copying them. Listeners
+         * subscribed during a publication are not notified of it.
          * 
          * This implementation is not thread-safe. 
          */
@@ -152,8 +173,7 @@ namespace sim_mob {
                     DECLARATION_CALLBACK_PTR(callback, L, T),
                     Context context = 0) {
                 if (callback) {
-                    Callback cb(new CallbackImpl<L, T>(callback));
-                    subscribe(id, listener, cb, context);
+                    subscribe(id, listener, Callback::create(callback), context);
                 } else {
                     subscribe(id, listener, context);
                 }
@@ -221,6 +241,13 @@ namespace sim_mob {
              */
             void unSubscribeAll(EventListenerPtr listener);
 
+            /**
+             * Gets the number of times the given event was published.
+             * @param id of the event.
+             * @return number of publications since the event was registered, 0 if it is not registered.
+             */
+            unsigned long long getPublishCount(EventId id) const;
+
         protected:
             /**
              * Subscribes the given listener to the given EventId.
@@ -235,7 +262,77 @@ namespace sim_mob {
                     Callback callback, Context context = 0);
 
         private:
-            ContextListenersMap listeners;
+            typedef std::vector<Entry> ListenerEntries;
+            typedef boost::unordered_map<Context, ListenerEntries> ContextListeners;
+
+            /**
+             * Listeners of a registered event.
+             */
+            struct EventSlot {
+                EventSlot(EventId id);
+
+                EventId id;
+                //false once unregistered while publishing; the slot is removed afterwards.
+                bool registered;
+                //listeners notified of all publications of the event.
+                ListenerEntries global;
+                //listeners notified of the publications for their context.
+                ContextListeners contexts;
+                //number of publications.
+                unsigned long long published;
+                //entries were unsubscribed while publishing.
+                bool hasRemovedEntries;
+            };
+
+            /**
+             * Subscription made while publishing.
+             */
+            struct PendingSubscription {
+                PendingSubscription(EventId id, Context context, const Entry& entry);
+
+                EventId id;
+                Context context;
+                Entry entry;
+            };
+
+            /**
+             * Gets the slot of the given event.
+             * @return slot or nullptr if the event is not registered.
+             */
+            EventSlot* findSlot(EventId id);
+            const EventSlot* findSlot(EventId id) const;
+
+            /**
+             * Gets the entries of the listeners of the given context.
+             * @return entries or nullptr if no listener subscribed to the context.
+             */
+            ListenerEntries* findEntries(EventSlot& slot, Context ctx);
+
+            /**
+             * Notifies the given listeners.
+             */
+            void notify(ListenerEntries& entries, EventId id, Context ctx, const EventArgs& args);
+
+            /**
+             * Removes the first entry of the given listener.
+             * @return true if an entry was removed.
+             */
+            bool removeListener(ListenerEntries& entries, EventListenerPtr listener, EventSlot& slot);
+
+            /**
+             * Removes the entries of unsubscribed listeners and adds the subscriptions
+             * made while publishing.
+             */
+            void applyPendingChanges();
+
+            //registered events; few per publisher, so they are searched linearly.
+            //a deque, so that registering an event while publishing does not move the slots.
+            std::deque<EventSlot> slots;
+            std::vector<PendingSubscription> pendingSubscriptions;
+            //number of publications in progress.
+            unsigned int publishDepth;
+            //slots were unregistered while publishing.
+            bool hasUnregisteredSlots;
         };
     }
 }
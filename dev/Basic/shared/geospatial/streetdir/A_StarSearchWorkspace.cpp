@@ -0,0 +1,48 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "A_StarSearchWorkspace.hpp"
+
+#include <boost/thread/tss.hpp>
+
+using namespace sim_mob;
+
+namespace
+{
+/**workspace of each thread running searches; created on first use*/
+boost::thread_specific_ptr<A_StarSearchWorkspace> threadWorkspace;
+}
+
+void ReverseAdjacency::build(const StreetDirectory::Graph& graph)
+{
+    size_t numVertices = boost::num_vertices(graph);
+    offsets.assign(numVertices + 1, 0);
+    edges.resize(boost::num_edges(graph));
+
+    //count the incoming edges of each vertex, shifted by one so that the running sum gives the start offsets
+    StreetDirectory::Graph::edge_iterator it, end;
+    for (boost::tie(it, end) = boost::edges(graph); it != end; ++it)
+    {
+        ++offsets[boost::target(*it, graph) + 1];
+    }
+    for (size_t v = 0; v < numVertices; ++v)
+    {
+        offsets[v + 1] += offsets[v];
+    }
+
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (boost::tie(it, end) = boost::edges(graph); it != end; ++it)
+    {
+        edges[next[boost::target(*it, graph)]++] = *it;
+    }
+}
+
+A_StarSearchWorkspace& A_StarSearchWorkspace::getThreadWorkspace()
+{
+    if (!threadWorkspace.get())
+    {
+        threadWorkspace.reset(new A_StarSearchWorkspace());
+    }
+    return *threadWorkspace;
+}
@@ -0,0 +1,598 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include <boost/graph/filtered_graph.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/utility.hpp>
+
+#include "StreetDirectory.hpp"
+
+namespace sim_mob
+{
+
+/**
+ * Incoming edges of every vertex of a StreetDirectory::Graph, stored as one edge array indexed by per-vertex offsets.
+ * The driving graphs only keep outgoing edges, so this is built once per graph for the backward half of bidirectional searches.
+ */
+class ReverseAdjacency
+{
+public:
+    typedef std::vector<StreetDirectory::Edge>::const_iterator EdgeIterator;
+
+    /**
+     * (Re)builds the incoming edge lists of a graph
+     *
+     * @param graph is the graph object
+     */
+    void build(const StreetDirectory::Graph& graph);
+
+    /**
+     * @return the number of vertices of the graph this was built for; 0 if not built
+     */
+    size_t numVertices() const
+    {
+        return (offsets.empty() ? 0 : offsets.size() - 1);
+    }
+
+    /**
+     * @param v is a vertex in the graph
+     * @return range of the edges ending at v
+     */
+    std::pair<EdgeIterator, EdgeIterator> inEdges(StreetDirectory::Vertex v) const
+    {
+        return std::make_pair(edges.begin() + offsets[v], edges.begin() + offsets[v + 1]);
+    }
+
+private:
+    /**position of the first incoming edge of each vertex in edges; one extra entry marks the end*/
+    std::vector<size_t> offsets;
+
+    /**incoming edges, grouped by target vertex*/
+    std::vector<StreetDirectory::Edge> edges;
+};
+
+/**
+ * Edge filter accepting every edge; used for searches without black list.
+ */
+struct AllEdgesConstraint
+{
+    bool operator()(const StreetDirectory::Edge& e) const
+    {
+        return true;
+    }
+};
+
+/**
+ * Scratch space of the A* searches on the driving graphs.
+ *
+ * The per-vertex labels (distance, heuristic, the edge through which the vertex was reached and the position in the open
+ * list) are kept between searches and are only valid if their stamp matches the generation of the current search; starting
+ * a search increments the generation instead of clearing or re-allocating the arrays. A search ends as soon as the goal is
+ * settled, without throwing.
+ *
+ * A workspace is not thread safe; use getThreadWorkspace() to obtain the one owned by the calling thread.
+ */
+class A_StarSearchWorkspace : private boost::noncopyable
+{
+public:
+    typedef StreetDirectory::Vertex Vertex;
+    typedef StreetDirectory::Edge Edge;
+
+    A_StarSearchWorkspace() : generation(0)
+    {
+    }
+
+    /**
+     * @return the workspace of the calling thread
+     */
+    static A_StarSearchWorkspace& getThreadWorkspace();
+
+    /**
+     * Searches the shortest path with A*
+     *
+     * @param graph is the graph object (StreetDirectory::Graph or a filtered view of it)
+     * @param fromVertex is a source vertex in the graph
+     * @param toVertex is a sink vertex in the graph
+     * @param heuristic estimates the cost from a vertex to toVertex
+     * @param path output: edges of the shortest path, from fromVertex to toVertex
+     *
+     * @return true if toVertex is reachable from fromVertex; false otherwise
+     */
+    template<class GraphType, class HeuristicType>
+    bool search(const GraphType& graph, Vertex fromVertex, Vertex toVertex, HeuristicType heuristic, std::vector<Edge>& path)
+    {
+        path.clear();
+        beginSearch(boost::num_vertices(graph));
+        Search& fwd = searches[FORWARD];
+
+        double fromHeuristic = heuristic(fromVertex);
+        label(fwd, fromVertex, 0.0, fromHeuristic, Edge(), fromHeuristic);
+
+        while (!fwd.open.empty())
+        {
+            Vertex u = pop(fwd);
+            if (u == toVertex)
+            {
+                buildForwardPath(graph, fromVertex, toVertex, path);
+                return true;
+            }
+
+            double uDist = fwd.dist[u];
+            typename boost::graph_traits<GraphType>::out_edge_iterator it, end;
+            for (boost::tie(it, end) = boost::out_edges(u, graph); it != end; ++it)
+            {
+                Vertex v = boost::target(*it, graph);
+                double dist = uDist + boost::get(boost::edge_weight, graph, *it);
+                if (!isLabelled(fwd, v))
+                {
+                    double vHeuristic = heuristic(v);
+                    label(fwd, v, dist, vHeuristic, *it, dist + vHeuristic);
+                }
+                else if (dist < fwd.dist[v])
+                {
+                    relabel(fwd, v, dist, *it, dist + fwd.heuristic[v]);
+                }
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Searches the shortest path with bidirectional A*, using the euclidean distance between the vertex positions as
+     * heuristic. Both searches run on edge costs reduced by the average of the forward and backward heuristics, so
+     * that they can stop as soon as the sum of the smallest open keys exceeds the best path found.
+     *
+     * @param graph is the graph object (StreetDirectory::Graph or a filtered view of it)
+     * @param reverse is the incoming edge lists of the (unfiltered) graph
+     * @param filter selects the incoming edges usable by the backward search; must match the filter of graph, if any
+     * @param fromVertex is a source vertex in the graph
+     * @param toVertex is a sink vertex in the graph
+     * @param path output: edges of the shortest path, from fromVertex to toVertex
+     *
+     * @return true if toVertex is reachable from fromVertex; false otherwise
+     */
+    template<class GraphType, class EdgeFilterType>
+    bool searchBidirectional(const GraphType& graph, const ReverseAdjacency& reverse, const EdgeFilterType& filter,
+                             Vertex fromVertex, Vertex toVertex, std::vector<Edge>& path)
+    {
+        path.clear();
+        if (fromVertex == toVertex)
+        {
+            return true;
+        }
+
+        beginSearch(boost::num_vertices(graph));
+        Search& fwd = searches[FORWARD];
+        Search& bwd = searches[BACKWARD];
+        const Point fromPos = boost::get(boost::vertex_name, graph, fromVertex);
+        const Point toPos = boost::get(boost::vertex_name, graph, toVertex);
+
+        //the keys are the distances on reduced costs; the heuristic slot of the labels caches the potential
+        label(fwd, fromVertex, 0.0, potential(graph, fromVertex, fromPos, toPos), Edge(), 0.0);
+        label(bwd, toVertex, 0.0, potential(graph, toVertex, fromPos, toPos), Edge(), 0.0);
+
+        double best = std::numeric_limits<double>::max();
+        Vertex meeting = toVertex;
+        bool found = false;
+
+        while (!fwd.open.empty() && !bwd.open.empty() && fwd.open.front().key + bwd.open.front().key < best)
+        {
+            if (fwd.open.front().key <= bwd.open.front().key)
+            {
+                Vertex u = pop(fwd);
+                double uDist = fwd.dist[u];
+                double uPotential = fwd.heuristic[u];
+                typename boost::graph_traits<GraphType>::out_edge_iterator it, end;
+                for (boost::tie(it, end) = boost::out_edges(u, graph); it != end; ++it)
+                {
+                    Vertex v = boost::target(*it, graph);
+                    bool labelled = isLabelled(fwd, v);
+                    double vPotential = (labelled ? fwd.heuristic[v] : potential(graph, v, fromPos, toPos));
+                    double dist = uDist + reducedCost(boost::get(boost::edge_weight, graph, *it), uPotential, vPotential);
+                    if (!labelled)
+                    {
+                        label(fwd, v, dist, vPotential, *it, dist);
+                    }
+                    else if (dist < fwd.dist[v])
+                    {
+                        relabel(fwd, v, dist, *it, dist);
+                    }
+                    else
+                    {
+                        continue;
+                    }
+
+                    if (isLabelled(bwd, v) && dist + bwd.dist[v] < best)
+                    {
+                        best = dist + bwd.dist[v];
+                        meeting = v;
+                        found = true;
+                    }
+                }
+            }
+            else
+            {
+                Vertex v = pop(bwd);
+                double vDist = bwd.dist[v];
+                double vPotential = bwd.heuristic[v];
+                ReverseAdjacency::EdgeIterator it, end;
+                for (boost::tie(it, end) = reverse.inEdges(v); it != end; ++it)
+                {
+                    if (!filter(*it))
+                    {
+                        continue;
+                    }
+
+                    Vertex u = boost::source(*it, graph);
+                    bool labelled = isLabelled(bwd, u);
+                    double uPotential = (labelled ? bwd.heuristic[u] : potential(graph, u, fromPos, toPos));
+                    double dist = vDist + reducedCost(boost::get(boost::edge_weight, graph, *it), uPotential, vPotential);
+                    if (!labelled)
+                    {
+                        label(bwd, u, dist, uPotential, *it, dist);
+                    }
+                    else if (dist < bwd.dist[u])
+                    {
+                        relabel(bwd, u, dist, *it, dist);
+                    }
+                    else
+                    {
+                        continue;
+                    }
+
+                    if (isLabelled(fwd, u) && dist + fwd.dist[u] < best)
+                    {
+                        best = dist + fwd.dist[u];
+                        meeting = u;
+                        found = true;
+                    }
+                }
+            }
+        }
+
+        if (found)
+        {
+            buildForwardPath(graph, fromVertex, meeting, path);
+            for (Vertex v = meeting; v != toVertex;)
+            {
+                const Edge& e = bwd.via[v];
+                path.push_back(e);
+                v = boost::target(e, graph);
+            }
+        }
+        return found;
+    }
+
+    /**
+     * Searches the shortest paths from one vertex to several vertices with a single Dijkstra search, which stops as
+     * soon as all of them are settled
+     *
+     * @param graph is the graph object (StreetDirectory::Graph or a filtered view of it)
+     * @param fromVertex is a source vertex in the graph
+     * @param toVertices are the sink vertices in the graph
+     * @param paths output: for each sink vertex, the edges of the shortest path from fromVertex; empty if the sink is not
+     *        reachable or is fromVertex
+     *
+     * @return the number of sink vertices reachable from fromVertex
+     */
+    template<class GraphType>
+    size_t searchOneToMany(const GraphType& graph, Vertex fromVertex, const std::vector<Vertex>& toVertices,
+                           std::vector<std::vector<Edge> >& paths)
+    {
+        paths.assign(toVertices.size(), std::vector<Edge>());
+        beginSearch(boost::num_vertices(graph));
+        Search& fwd = searches[FORWARD];
+
+        //the backward labels are unused by this search; their stamps mark the sinks still to be settled
+        Search& sinks = searches[BACKWARD];
+        size_t remaining = 0;
+        for (std::vector<Vertex>::const_iterator it = toVertices.begin(); it != toVertices.end(); ++it)
+        {
+            if (!isLabelled(sinks, *it))
+            {
+                sinks.stamp[*it] = generation;
+                ++remaining;
+            }
+        }
+
+        label(fwd, fromVertex, 0.0, 0.0, Edge(), 0.0);
+        while (!fwd.open.empty() && remaining > 0)
+        {
+            Vertex u = pop(fwd);
+            if (isLabelled(sinks, u))
+            {
+                --remaining;
+            }
+
+            double uDist = fwd.dist[u];
+            typename boost::graph_traits<GraphType>::out_edge_iterator it, end;
+            for (boost::tie(it, end) = boost::out_edges(u, graph); it != end; ++it)
+            {
+                Vertex v = boost::target(*it, graph);
+                double dist = uDist + boost::get(boost::edge_weight, graph, *it);
+                if (!isLabelled(fwd, v))
+                {
+                    label(fwd, v, dist, 0.0, *it, dist);
+                }
+                else if (dist < fwd.dist[v])
+                {
+                    relabel(fwd, v, dist, *it, dist);
+                }
+            }
+        }
+
+        //once all sinks are settled (or the open list is exhausted), the labelled sinks have their final distance
+        size_t reached = 0;
+        for (size_t i = 0; i < toVertices.size(); ++i)
+        {
+            if (isLabelled(fwd, toVertices[i]))
+            {
+                buildForwardPath(graph, fromVertex, toVertices[i], paths[i]);
+                ++reached;
+            }
+        }
+        return reached;
+    }
+
+    /**
+     * Converts the edges of a path into the WayPoints held by the edges
+     *
+     * @param graph is the graph object the path was searched in
+     * @param path edges of the path
+     *
+     * @return the WayPoints of the path
+     */
+    template<class GraphType>
+    static std::vector<WayPoint> toWayPoints(const GraphType& graph, const std::vector<Edge>& path)
+    {
+        std::vector<WayPoint> res;
+        res.reserve(path.size());
+        for (std::vector<Edge>::const_iterator it = path.begin(); it != path.end(); ++it)
+        {
+            res.push_back(boost::get(boost::edge_name, graph, *it));
+        }
+        return res;
+    }
+
+private:
+    enum Direction
+    {
+        FORWARD = 0,
+        BACKWARD = 1
+    };
+
+    /**arity of the open list heap*/
+    static const size_t HEAP_ARITY = 4;
+
+    /**heap position of a vertex which is labelled but not in the open list*/
+    static const size_t CLOSED = static_cast<size_t>(-1);
+
+    /**
+     * Element of the open list
+     */
+    struct HeapEntry
+    {
+        HeapEntry(double key, Vertex vertex) : key(key), vertex(vertex)
+        {
+        }
+
+        /**distance plus heuristic (distance on reduced costs for bidirectional searches)*/
+        double key;
+        Vertex vertex;
+    };
+
+    /**
+     * State of one search direction. The per-vertex entries are only valid if their stamp equals the current generation.
+     */
+    struct Search
+    {
+        std::vector<double> dist;
+        std::vector<double> heuristic;
+        std::vector<Edge> via;
+        std::vector<size_t> heapPos;
+        std::vector<uint32_t> stamp;
+
+        /**open list: HEAP_ARITY-ary min heap on key, indexed by heapPos*/
+        std::vector<HeapEntry> open;
+    };
+
+    /**
+     * Starts a new search over a graph of numVertices vertices: invalidates all labels and empties the open lists.
+     */
+    void beginSearch(size_t numVertices)
+    {
+        for (int dir = FORWARD; dir <= BACKWARD; ++dir)
+        {
+            Search& search = searches[dir];
+            if (search.stamp.size() < numVertices)
+            {
+                search.dist.resize(numVertices);
+                search.heuristic.resize(numVertices);
+                search.via.resize(numVertices);
+                search.heapPos.resize(numVertices);
+                search.stamp.resize(numVertices, 0);
+            }
+            search.open.clear();
+        }
+
+        ++generation;
+        if (generation == 0)
+        {
+            //the stamps have wrapped around; stale stamps could now match, so clear them once
+            for (int dir = FORWARD; dir <= BACKWARD; ++dir)
+            {
+                std::fill(searches[dir].stamp.begin(), searches[dir].stamp.end(), 0);
+            }
+            generation = 1;
+        }
+    }
+
+    bool isLabelled(const Search& search, Vertex v) const
+    {
+        return search.stamp[v] == generation;
+    }
+
+    /**
+     * Labels a vertex reached for the first time and opens it
+     */
+    void label(Search& search, Vertex v, double dist, double heuristic, const Edge& via, double key)
+    {
+        search.stamp[v] = generation;
+        search.dist[v] = dist;
+        search.heuristic[v] = heuristic;
+        search.via[v] = via;
+        search.heapPos[v] = search.open.size();
+        search.open.push_back(HeapEntry(key, v));
+        siftUp(search, search.open.size() - 1);
+    }
+
+    /**
+     * Lowers the distance of a labelled vertex; re-opens it if it was already closed (inconsistent heuristic)
+     */
+    void relabel(Search& search, Vertex v, double dist, const Edge& via, double key)
+    {
+        search.dist[v] = dist;
+        search.via[v] = via;
+        if (search.heapPos[v] == CLOSED)
+        {
+            search.heapPos[v] = search.open.size();
+            search.open.push_back(HeapEntry(key, v));
+        }
+        else
+        {
+            search.open[search.heapPos[v]].key = key;
+        }
+        siftUp(search, search.heapPos[v]);
+    }
+
+    /**
+     * Removes the vertex with the smallest key from the open list and closes it
+     */
+    Vertex pop(Search& search)
+    {
+        Vertex top = search.open.front().vertex;
+        search.heapPos[top] = CLOSED;
+        const HeapEntry last = search.open.back();
+        search.open.pop_back();
+        if (!search.open.empty())
+        {
+            search.open.front() = last;
+            search.heapPos[last.vertex] = 0;
+            siftDown(search, 0);
+        }
+        return top;
+    }
+
+    void siftUp(Search& search, size_t pos)
+    {
+        const HeapEntry entry = search.open[pos];
+        while (pos > 0)
+        {
+            size_t parent = (pos - 1) / HEAP_ARITY;
+            if (search.open[parent].key <= entry.key)
+            {
+                break;
+            }
+            search.open[pos] = search.open[parent];
+            search.heapPos[search.open[pos].vertex] = pos;
+            pos = parent;
+        }
+        search.open[pos] = entry;
+        search.heapPos[entry.vertex] = pos;
+    }
+
+    void siftDown(Search& search, size_t pos)
+    {
+        const HeapEntry entry = search.open[pos];
+        size_t size = search.open.size();
+        while (true)
+        {
+            size_t first = pos * HEAP_ARITY + 1;
+            if (first >= size)
+            {
+                break;
+            }
+            size_t smallest = first;
+            size_t last = std::min(first + HEAP_ARITY, size);
+            for (size_t child = first + 1; child < last; ++child)
+            {
+                if (search.open[child].key < search.open[smallest].key)
+                {
+                    smallest = child;
+                }
+            }
+            if (entry.key <= search.open[smallest].key)
+            {
+                break;
+            }
+            search.open[pos] = search.open[smallest];
+            search.heapPos[search.open[pos].vertex] = pos;
+            pos = smallest;
+        }
+        search.open[pos] = entry;
+        search.heapPos[entry.vertex] = pos;
+    }
+
+    /**
+     * Appends the edges from fromVertex to v (as reached by the forward search) to path
+     */
+    template<class GraphType>
+    void buildForwardPath(const GraphType& graph, Vertex fromVertex, Vertex v, std::vector<Edge>& path) const
+    {
+        size_t first = path.size();
+        while (v != fromVertex)
+        {
+            const Edge& e = searches[FORWARD].via[v];
+            path.push_back(e);
+            v = boost::source(e, graph);
+        }
+        std::reverse(path.begin() + first, path.end());
+    }
+
+    /**
+     * Potential of the bidirectional search: average of the forward heuristic (distance to the goal) and the negated
+     * backward heuristic (distance from the start).
+     */
+    template<class GraphType>
+    static double potential(const GraphType& graph, Vertex v, const Point& fromPos, const Point& toPos)
+    {
+        const Point& pos = boost::get(boost::vertex_name, graph, v);
+        return 0.5 * (euclideanDist(pos, toPos) - euclideanDist(fromPos, pos));
+    }
+
+    /**
+     * Edge cost reduced by the potentials of its end points. Never negative for consistent heuristics; clamped in case
+     * an edge is shorter than the straight line between its end points.
+     */
+    static double reducedCost(double weight, double fromPotential, double toPotential)
+    {
+        return std::max(0.0, weight - fromPotential + toPotential);
+    }
+
+    static double euclideanDist(const Point& pt1, const Point& pt2)
+    {
+        double dx = pt2.getX() - pt1.getX();
+        double dy = pt2.getY() - pt1.getY();
+        double dz = pt2.getZ() - pt1.getZ();
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    /**forward and backward searches*/
+    Search searches[2];
+
+    /**stamp of the labels set by the current search*/
+    uint32_t generation;
+};
+
+}
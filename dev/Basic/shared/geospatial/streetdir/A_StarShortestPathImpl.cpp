@@ -31,16 +31,32 @@ using namespace sim_mob;
 
 boost::shared_mutex A_StarShortestPathImpl::GraphSearchMutex;
 
-A_StarShortestPathImpl::A_StarShortestPathImpl(const RoadNetwork& network):isValidSegGraph(false)
+A_StarShortestPathImpl::A_StarShortestPathImpl(const RoadNetwork& network):isValidSegGraph(false),
+        isBidirectionalSearch(sim_mob::ConfigManager::GetInstance().FullConfig().getPathSetConf().bidirectionalSearch),
+        isContractionHierarchy(sim_mob::ConfigManager::GetInstance().FullConfig().getPathSetConf().contractionHierarchy)
 {
     if (sim_mob::ConfigManager::GetInstance().FullConfig().isGenerateBusRoutes()) {
         initSegDrivingNetwork(network);
+        if (isBidirectionalSearch) {
+            drivingSegReverse.build(drivingSegMap);
+        }
+        if (isContractionHierarchy) {
+            drivingSegHierarchy.build(drivingSegMap);
+            Print() << "Contraction hierarchy of the segment graph: " << drivingSegHierarchy.getNumShortcuts() << " shortcuts" << std::endl;
+        }
     } else {
         initLinkDrivingNetwork(network);
+        if (isBidirectionalSearch) {
+            drivingLinkReverse.build(drivingLinkMap);
+        }
+        if (isContractionHierarchy) {
+            drivingLinkHierarchy.build(drivingLinkMap);
+            Print() << "Contraction hierarchy of the link graph: " << drivingLinkHierarchy.getNumShortcuts() << " shortcuts" << std::endl;
+        }
     }
 }
 
-A_StarShortestPathImpl::A_StarShortestPathImpl():isValidSegGraph(false)
+A_StarShortestPathImpl::A_StarShortestPathImpl():isValidSegGraph(false), isBidirectionalSearch(false), isContractionHierarchy(false)
 {
 
 }
@@ -664,7 +680,15 @@ std::vector<WayPoint> A_StarShortestPathImpl::GetShortestDrivingPath(const Stree
         }
     }
 
-    if (blacklistV.empty())
+    if (isContractionHierarchy && blacklistV.empty())
+    {
+        return searchShortestPathHierarchy(drivingLinkMap, drivingLinkHierarchy, fromV, toV);
+    }
+    else if (isBidirectionalSearch)
+    {
+        return searchShortestPathBidirectional(drivingLinkMap, drivingLinkReverse, fromV, toV, blacklistV);
+    }
+    else if (blacklistV.empty())
     {
         return searchShortestPath(drivingLinkMap, fromV, toV);
     }
@@ -674,6 +698,48 @@ std::vector<WayPoint> A_StarShortestPathImpl::GetShortestDrivingPath(const Stree
     }
 }
 
+vector<vector<WayPoint> > A_StarShortestPathImpl::GetShortestDrivingPaths(const StreetDirectory::VertexDesc &from,
+                                                                          const std::vector<StreetDirectory::VertexDesc> &to) const
+{
+    if (isValidSegGraph || isContractionHierarchy)
+    {
+        return StreetDirectory::ShortestPathImpl::GetShortestDrivingPaths(from, to);
+    }
+
+    vector<vector<WayPoint> > res(to.size());
+    if (!from.valid)
+    {
+        return res;
+    }
+
+    //sinks to search for, and the destinations each of them answers
+    vector<StreetDirectory::Vertex> sinks;
+    vector<size_t> destinations;
+    for (size_t i = 0; i < to.size(); ++i)
+    {
+        if (to[i].valid && to[i].sink != from.source)
+        {
+            sinks.push_back(to[i].sink);
+            destinations.push_back(i);
+        }
+    }
+    if (sinks.empty())
+    {
+        return res;
+    }
+
+    //Lock for read access.
+    boost::shared_lock<boost::shared_mutex> lock(GraphSearchMutex);
+
+    vector<vector<StreetDirectory::Edge> > paths;
+    A_StarSearchWorkspace::getThreadWorkspace().searchOneToMany(drivingLinkMap, from.source, sinks, paths);
+    for (size_t i = 0; i < sinks.size(); ++i)
+    {
+        res[destinations[i]] = A_StarSearchWorkspace::toWayPoints(drivingLinkMap, paths[i]);
+    }
+    return res;
+}
+
 vector<WayPoint> A_StarShortestPathImpl::GetShortestDrivingPath(const StreetDirectory::VertexDesc &from, const StreetDirectory::VertexDesc &to,
                                                                 const std::vector<const RoadSegment *> &blacklist) const
 {
@@ -706,7 +772,15 @@ vector<WayPoint> A_StarShortestPathImpl::GetShortestDrivingPath(const StreetDire
         }
     }
 
-    if (blacklistV.empty())
+    if (isContractionHierarchy && blacklistV.empty())
+    {
+        return searchShortestPathHierarchy(drivingSegMap, drivingSegHierarchy, fromV, toV);
+    }
+    else if (isBidirectionalSearch)
+    {
+        return searchShortestPathBidirectional(drivingSegMap, drivingSegReverse, fromV, toV, blacklistV);
+    }
+    else if (blacklistV.empty())
     {
         vector<WayPoint> res =searchShortestPath(drivingSegMap, fromV, toV);
         return res;
@@ -729,118 +803,82 @@ std::vector<WayPoint> A_StarShortestPathImpl::searchShortestPathWithBlackList(co
     BlackListEdgeConstraint filter(blacklist);
     boost::filtered_graph<StreetDirectory::Graph, BlackListEdgeConstraint> filtered(graph, filter);
 
-    vector<WayPoint> res;
-    std::list<StreetDirectory::Vertex> partialRes;
-    //Output variable for A* searching
-    vector<StreetDirectory::Vertex> p(boost::num_vertices(filtered));
-    //Output variable for A* searching
-    vector<double> d(boost::num_vertices(filtered));
-
     //Use A* to search for a path
-    try
+    vector<StreetDirectory::Edge> path;
+    if (A_StarSearchWorkspace::getThreadWorkspace().search(filtered, fromVertex, toVertex, DistanceHeuristicFiltered(&filtered, toVertex), path))
     {
-        boost::astar_search(filtered, fromVertex, DistanceHeuristicFiltered(&filtered, toVertex),
-                            boost::predecessor_map(&p[0]).distance_map(&d[0]).visitor(GoalVisitor(toVertex)));
+        return A_StarSearchWorkspace::toWayPoints(filtered, path);
     }
-    catch (Goal& goal)
-    {
-        //Build backwards.
-        for (StreetDirectory::Vertex v = toVertex;; v = p[v])
-        {
-            partialRes.push_front(v);
-            if (p[v] == v)
-            {
-                break;
-            }
-        }
-
-        //Now build forwards.
-        std::list<StreetDirectory::Vertex>::const_iterator prev = partialRes.end();
-        for (std::list<StreetDirectory::Vertex>::const_iterator it = partialRes.begin(); it != partialRes.end(); it++)
-        {
-            //Add this edge.
-            if (prev != partialRes.end())
-            {
-                //This shouldn't fail.
-                std::pair < StreetDirectory::Edge, bool> edge = boost::edge(*prev, *it, filtered);
-                if (!edge.second)
-                {
-                    Warn() << "ERROR: Boost can't find an edge that it should know about."
-                            << std::endl;
-                    return std::vector<WayPoint>();
-                }
+    return vector<WayPoint>();
+}
 
-                //Retrieve, add this edge's WayPoint.
-                WayPoint wp = boost::get(boost::edge_name, filtered, edge.first);
-                res.push_back(wp);
-            }
+vector<WayPoint> A_StarShortestPathImpl::searchShortestPath(const StreetDirectory::Graph& graph, const StreetDirectory::Vertex& fromVertex,
+                                                            const StreetDirectory::Vertex& toVertex)
+{
+    //Lock for read access.
+    boost::shared_lock<boost::shared_mutex> lock(GraphSearchMutex);
 
-            //Save for later.
-            prev = it;
-        }
+    //Use A* to search for a path
+    vector<StreetDirectory::Edge> path;
+    if (A_StarSearchWorkspace::getThreadWorkspace().search(graph, fromVertex, toVertex, DistanceHeuristicGraph(&graph, toVertex), path))
+    {
+        return A_StarSearchWorkspace::toWayPoints(graph, path);
     }
-
-    return res;
+    return vector<WayPoint>();
 }
 
-vector<WayPoint> A_StarShortestPathImpl::searchShortestPath(const StreetDirectory::Graph& graph, const StreetDirectory::Vertex& fromVertex,
-                                                            const StreetDirectory::Vertex& toVertex)
+vector<WayPoint> A_StarShortestPathImpl::searchShortestPathBidirectional(const StreetDirectory::Graph& graph, const ReverseAdjacency& reverse,
+                                                                         const StreetDirectory::Vertex& fromVertex, const StreetDirectory::Vertex& toVertex,
+                                                                         const std::set<StreetDirectory::Edge>& blacklist)
 {
-    vector<WayPoint> res;
-    std::list<StreetDirectory::Vertex> partialRes;
+    if (reverse.numVertices() != boost::num_vertices(graph))
+    {
+        return (blacklist.empty() ? searchShortestPath(graph, fromVertex, toVertex)
+                : searchShortestPathWithBlackList(graph, fromVertex, toVertex, blacklist));
+    }
 
     //Lock for read access.
     boost::shared_lock<boost::shared_mutex> lock(GraphSearchMutex);
-    //Output variable for A* searching
-    vector<StreetDirectory::Vertex> p(boost::num_vertices(graph));
-    //Output variable for A* searching
-    vector<double> d(boost::num_vertices(graph));
 
-    //Use A* to search for a path
-    try
+    vector<StreetDirectory::Edge> path;
+    A_StarSearchWorkspace& workspace = A_StarSearchWorkspace::getThreadWorkspace();
+    if (blacklist.empty())
     {
-        boost::astar_search(graph, fromVertex, DistanceHeuristicGraph(&graph, toVertex),
-                            boost::predecessor_map(&p[0]).distance_map(&d[0]).visitor(GoalVisitor(toVertex)));
+        if (workspace.searchBidirectional(graph, reverse, AllEdgesConstraint(), fromVertex, toVertex, path))
+        {
+            return A_StarSearchWorkspace::toWayPoints(graph, path);
+        }
     }
-    catch (Goal& goal)
+    else
     {
-        //Build backwards.
-        for (StreetDirectory::Vertex v = toVertex;; v = p[v])
+        BlackListEdgeConstraint filter(blacklist);
+        boost::filtered_graph<StreetDirectory::Graph, BlackListEdgeConstraint> filtered(graph, filter);
+        if (workspace.searchBidirectional(filtered, reverse, filter, fromVertex, toVertex, path))
         {
-            partialRes.push_front(v);
-            if (p[v] == v)
-            {
-                break;
-            }
+            return A_StarSearchWorkspace::toWayPoints(filtered, path);
         }
+    }
+    return vector<WayPoint>();
+}
 
-        //Now build forwards.
-        std::list<StreetDirectory::Vertex>::const_iterator prev = partialRes.end();
-        for (std::list<StreetDirectory::Vertex>::const_iterator it = partialRes.begin(); it != partialRes.end(); it++)
-        {
-            //Add this edge.
-            if (prev != partialRes.end())
-            {
-                //This shouldn't fail.
-                std::pair < StreetDirectory::Edge, bool> edge = boost::edge(*prev, *it, graph);
-                if (!edge.second)
-                {
-                    Warn() << "ERROR: Boost can't find an edge that it should know about."
-                            << std::endl;
-                    return std::vector<WayPoint>();
-                }
+vector<WayPoint> A_StarShortestPathImpl::searchShortestPathHierarchy(const StreetDirectory::Graph& graph, const ContractionHierarchy& hierarchy,
+                                                                     const StreetDirectory::Vertex& fromVertex, const StreetDirectory::Vertex& toVertex)
+{
+    if (!hierarchy.isBuilt())
+    {
+        return searchShortestPath(graph, fromVertex, toVertex);
+    }
 
-                //Retrieve, add this edge WayPoint.
-                WayPoint wp = boost::get(boost::edge_name, graph, edge.first);
-                res.push_back(wp);
-            }
+    //Lock for read access.
+    boost::shared_lock<boost::shared_mutex> lock(GraphSearchMutex);
 
-            //Save for later.
-            prev = it;
-        }
+    vector<StreetDirectory::Edge> path;
+    double cost = 0.0;
+    if (hierarchy.query(fromVertex, toVertex, path, cost))
+    {
+        return A_StarSearchWorkspace::toWayPoints(graph, path);
     }
-
-    return res;
+    return vector<WayPoint>();
 }
 
 double A_StarShortestPathImpl::euclideanDist(const Point& pt1, const Point& pt2)
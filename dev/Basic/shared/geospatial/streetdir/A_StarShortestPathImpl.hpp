@@ -16,6 +16,8 @@
 #include <boost/utility.hpp>
 #include <boost/thread.hpp>
 
+#include "A_StarSearchWorkspace.hpp"
+#include "ContractionHierarchy.hpp"
 #include "StreetDirectory.hpp"
 
 namespace sim_mob
@@ -268,37 +270,6 @@ public:
         }
     };
 
-    /**
-     * Used to terminate our search
-     */
-    struct Goal
-    {
-    };
-
-    /**
-     * Goal visitor: terminates when a goal has been found.
-     */
-    class GoalVisitor : public boost::default_astar_visitor
-    {
-    private:
-        StreetDirectory::Vertex goal;
-
-    public:
-
-        GoalVisitor(StreetDirectory::Vertex goal) : goal(goal)
-        {
-        }
-
-        template<class Graph>
-        void examine_vertex(StreetDirectory::Vertex u, const Graph& g)
-        {
-            if (u == goal)
-            {
-                throw Goal();
-            }
-        }
-    };
-
     /**
      * Search shortest path with black list.
      *
@@ -320,6 +291,31 @@ public:
      * @return a shortest path
      */
     static std::vector<WayPoint> searchShortestPath(const StreetDirectory::Graph& graph, const StreetDirectory::Vertex& fromVertex, const StreetDirectory::Vertex& toVertex);
+    /**
+     * Search the shortest path with bidirectional A*, optionally with black list.
+     * Falls back to the unidirectional search if reverse was not built for graph.
+     *
+     * @param graph is the graph object
+     * @param reverse is the incoming edge lists of graph
+     * @param fromVertex is a source vertex in the graph
+     * @param toVertex is a sink vertex in the graph
+     * @param blackList is a black list used to block edges in the graph
+     *
+     * @return a shortest path
+     */
+    static std::vector<WayPoint> searchShortestPathBidirectional(const StreetDirectory::Graph& graph, const ReverseAdjacency& reverse, const StreetDirectory::Vertex& fromVertex, const StreetDirectory::Vertex& toVertex, const std::set<StreetDirectory::Edge>& blacklist);
+    /**
+     * Search the shortest path in a contraction hierarchy.
+     * Falls back to the A* search if the hierarchy was not built.
+     *
+     * @param graph is the graph object
+     * @param hierarchy is the contraction hierarchy built for graph
+     * @param fromVertex is a source vertex in the graph
+     * @param toVertex is a sink vertex in the graph
+     *
+     * @return a shortest path
+     */
+    static std::vector<WayPoint> searchShortestPathHierarchy(const StreetDirectory::Graph& graph, const ContractionHierarchy& hierarchy, const StreetDirectory::Vertex& fromVertex, const StreetDirectory::Vertex& toVertex);
 
 public:
     explicit A_StarShortestPathImpl(const RoadNetwork& network);
@@ -373,6 +369,27 @@ public:
 
     /**indicate whether segment graph is created*/
     bool isValidSegGraph;
+
+    /**indicate whether the distance-based driving paths are searched with bidirectional A* */
+    bool isBidirectionalSearch;
+
+    /**Incoming edges of drivingLinkMap; only built for bidirectional search*/
+    ReverseAdjacency drivingLinkReverse;
+
+    /**Incoming edges of drivingSegMap; only built for bidirectional search*/
+    ReverseAdjacency drivingSegReverse;
+
+    /**indicate whether the distance-based driving paths without blacklist are searched in a contraction hierarchy*/
+    bool isContractionHierarchy;
+
+    /**
+     * Contraction hierarchy of drivingLinkMap; only built if isContractionHierarchy.
+     * Its customize() re-weights it, e.g. with the link travel times of an interval.
+     */
+    ContractionHierarchy drivingLinkHierarchy;
+
+    /**Contraction hierarchy of drivingSegMap; only built if isContractionHierarchy*/
+    ContractionHierarchy drivingSegHierarchy;
     /**
      * retrieve a vertex in the travel-time graph
      * @param node is a pointer to the node
@@ -409,6 +426,15 @@ public:
      */
     virtual std::vector<WayPoint> GetShortestDrivingPath(const StreetDirectory::VertexDesc &from, const StreetDirectory::VertexDesc &to,
                                                         const std::vector<const Link*> &blacklist, TimeRange timeRange = Default, int randomGraphIdx = 0) const;
+    /**
+     * retrieve distance shortest driving paths from one original point to several destinations, with one Dijkstra search
+     * on the link graph (the segment graph and the contraction hierarchy answer each destination separately)
+     * @param from is original vertex in the graph
+     * @param to are destination vertices in the graph
+     * @return for each destination, the shortest path result.
+     */
+    virtual std::vector<std::vector<WayPoint> > GetShortestDrivingPaths(const StreetDirectory::VertexDesc &from,
+                                                                        const std::vector<StreetDirectory::VertexDesc> &to) const;
     /**
      * Return the distance-based shortest path to drive from to another. Performs a search (currently using
      *  the A* algorithm) from one to another.
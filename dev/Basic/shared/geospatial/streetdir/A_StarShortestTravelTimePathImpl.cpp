@@ -491,118 +491,30 @@ std::vector<WayPoint> A_StarShortestTravelTimePathImpl::searchShortestTTPathWith
     BlackListEdgeConstraint filter(blacklist);
     boost::filtered_graph<StreetDirectory::Graph, BlackListEdgeConstraint> filtered(graph, filter);
 
-    vector<WayPoint> res;
-    std::list<StreetDirectory::Vertex> partialRes;
-    //Output variable for A* searching
-    vector<StreetDirectory::Vertex> p(boost::num_vertices(filtered));
-    //Output variable for A* searching
-    vector<double> d(boost::num_vertices(filtered));
-
     //Use A* to search for a path
-    try
+    vector<StreetDirectory::Edge> path;
+    if (A_StarSearchWorkspace::getThreadWorkspace().search(filtered, fromVertex, toVertex,
+            A_StarShortestTravelTimePathImpl::DistanceHeuristicFiltered(&filtered, toVertex), path))
     {
-        boost::astar_search(filtered, fromVertex, A_StarShortestTravelTimePathImpl::DistanceHeuristicFiltered(&filtered, toVertex),
-                            boost::predecessor_map(&p[0]).distance_map(&d[0]).visitor(GoalVisitor(toVertex)));
+        return A_StarSearchWorkspace::toWayPoints(filtered, path);
     }
-    catch (Goal& goal)
-    {
-        //Build backwards.
-        for (StreetDirectory::Vertex v = toVertex;; v = p[v])
-        {
-            partialRes.push_front(v);
-            if (p[v] == v)
-            {
-                break;
-            }
-        }
-
-        //Now build forwards.
-        std::list<StreetDirectory::Vertex>::const_iterator prev = partialRes.end();
-        for (std::list<StreetDirectory::Vertex>::const_iterator it = partialRes.begin(); it != partialRes.end(); it++)
-        {
-            //Add this edge.
-            if (prev != partialRes.end())
-            {
-                //This shouldn't fail.
-                std::pair < StreetDirectory::Edge, bool> edge = boost::edge(*prev, *it, filtered);
-                if (!edge.second)
-                {
-                    Warn() << "ERROR: Boost can't find an edge that it should know about."
-                            << std::endl;
-                    return std::vector<WayPoint>();
-                }
-
-                //Retrieve, add this edge's WayPoint.
-                WayPoint wp = boost::get(boost::edge_name, filtered, edge.first);
-                res.push_back(wp);
-            }
-
-            //Save for later.
-            prev = it;
-        }
-    }
-
-    return res;
+    return vector<WayPoint>();
 }
 
 vector<WayPoint> A_StarShortestTravelTimePathImpl::searchShortestTTPath(const StreetDirectory::Graph& graph, const StreetDirectory::Vertex& fromVertex,
                                                             const StreetDirectory::Vertex& toVertex)
 {
-    vector<WayPoint> res;
-    std::list<StreetDirectory::Vertex> partialRes;
-
     //Lock for read access.
     boost::shared_lock<boost::shared_mutex> lock(GraphSearchMutex);
-    //Output variable for A* searching
-    vector<StreetDirectory::Vertex> p(boost::num_vertices(graph));
-    //Output variable for A* searching
-    vector<double> d(boost::num_vertices(graph));
 
     //Use A* to search for a path
-    try
+    vector<StreetDirectory::Edge> path;
+    if (A_StarSearchWorkspace::getThreadWorkspace().search(graph, fromVertex, toVertex,
+            A_StarShortestTravelTimePathImpl::DistanceHeuristicGraph(&graph, toVertex), path))
     {
-        boost::astar_search(graph, fromVertex, A_StarShortestTravelTimePathImpl::DistanceHeuristicGraph(&graph, toVertex),
-                            boost::predecessor_map(&p[0]).distance_map(&d[0]).visitor(GoalVisitor(toVertex)));
+        return A_StarSearchWorkspace::toWayPoints(graph, path);
     }
-    catch (Goal& goal)
-    {
-        //Build backwards.
-        for (StreetDirectory::Vertex v = toVertex;; v = p[v])
-        {
-            partialRes.push_front(v);
-            if (p[v] == v)
-            {
-                break;
-            }
-        }
-
-        //Now build forwards.
-        std::list<StreetDirectory::Vertex>::const_iterator prev = partialRes.end();
-        for (std::list<StreetDirectory::Vertex>::const_iterator it = partialRes.begin(); it != partialRes.end(); it++)
-        {
-            //Add this edge.
-            if (prev != partialRes.end())
-            {
-                //This shouldn't fail.
-                std::pair < StreetDirectory::Edge, bool> edge = boost::edge(*prev, *it, graph);
-                if (!edge.second)
-                {
-                    Warn() << "ERROR: Boost can't find an edge that it should know about."
-                            << std::endl;
-                    return std::vector<WayPoint>();
-                }
-
-                //Retrieve, add this edge WayPoint.
-                WayPoint wp = boost::get(boost::edge_name, graph, edge.first);
-                res.push_back(wp);
-            }
-
-            //Save for later.
-            prev = it;
-        }
-    }
-
-    return res;
+    return vector<WayPoint>();
 }
 
 vector<sim_mob::WayPoint> A_StarShortestTravelTimePathImpl::GetShortestDrivingPath(
@@ -833,3 +745,10 @@ vector<sim_mob::WayPoint> A_StarShortestTravelTimePathImpl::GetShortestDrivingPa
 
 
 
+
+vector<vector<sim_mob::WayPoint> > A_StarShortestTravelTimePathImpl::GetShortestDrivingPaths(const StreetDirectory::VertexDesc& from,
+        const vector<StreetDirectory::VertexDesc>& to) const
+{
+    //the vertices are those of the travel-time graphs, not of drivingLinkMap; search each destination on its own
+    return StreetDirectory::ShortestPathImpl::GetShortestDrivingPaths(from, to);
+}
@@ -45,6 +45,15 @@ public:
             const std::vector<const sim_mob::Link*>& blacklist,
             sim_mob::TimeRange timeRange = sim_mob::Default, int randomGraphId = 0) const;
 
+    /**
+     * retrieve travel-time shortest driving paths from one original point to several destinations, one search each
+     * @param from is original vertex in the graph
+     * @param to are destination vertices in the graph
+     * @return for each destination, the shortest path result.
+     */
+    virtual std::vector<std::vector<sim_mob::WayPoint> > GetShortestDrivingPaths(const StreetDirectory::VertexDesc& from,
+            const std::vector<StreetDirectory::VertexDesc>& to) const;
+
     /**
      * Search shortest path with black list.
      *
@@ -0,0 +1,625 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "ContractionHierarchy.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/tss.hpp>
+
+using namespace sim_mob;
+
+namespace
+{
+/**maximum number of vertices settled by a witness search while ranking the vertices*/
+const unsigned ORDERING_SETTLE_LIMIT = 100;
+
+/**maximum number of vertices settled by a witness search while contracting; missing a witness only adds a shortcut*/
+const unsigned CONTRACTION_SETTLE_LIMIT = 500;
+
+typedef std::pair<double, StreetDirectory::Vertex> DistVertex;
+typedef std::priority_queue<DistVertex, std::vector<DistVertex>, std::greater<DistVertex> > MinHeap;
+
+/**
+ * Per-thread scratch space of the queries. Labels are valid only if their stamp matches the current generation.
+ */
+struct QueryWorkspace
+{
+    QueryWorkspace() : generation(0)
+    {
+    }
+
+    void begin(size_t numVertices)
+    {
+        for (int dir = 0; dir < 2; ++dir)
+        {
+            if (stamp[dir].size() < numVertices)
+            {
+                dist[dir].resize(numVertices);
+                parent[dir].resize(numVertices);
+                stamp[dir].resize(numVertices, 0);
+            }
+            heap[dir] = MinHeap();
+        }
+
+        ++generation;
+        if (generation == 0)
+        {
+            for (int dir = 0; dir < 2; ++dir)
+            {
+                std::fill(stamp[dir].begin(), stamp[dir].end(), 0);
+            }
+            generation = 1;
+        }
+    }
+
+    bool isLabelled(int dir, StreetDirectory::Vertex v) const
+    {
+        return stamp[dir][v] == generation;
+    }
+
+    void label(int dir, StreetDirectory::Vertex v, double d, uint32_t arc)
+    {
+        dist[dir][v] = d;
+        parent[dir][v] = arc;
+        stamp[dir][v] = generation;
+        heap[dir].push(DistVertex(d, v));
+    }
+
+    std::vector<double> dist[2];
+    std::vector<uint32_t> parent[2];
+    std::vector<uint32_t> stamp[2];
+    MinHeap heap[2];
+    uint32_t generation;
+};
+
+boost::thread_specific_ptr<QueryWorkspace> threadQueryWorkspace;
+
+QueryWorkspace& getQueryWorkspace()
+{
+    if (!threadQueryWorkspace.get())
+    {
+        threadQueryWorkspace.reset(new QueryWorkspace());
+    }
+    return *threadQueryWorkspace;
+}
+}
+
+/**
+ * Contracts the vertices one at a time, maintaining the arcs between the vertices not contracted yet.
+ * For each pair of remaining vertices, only the cheapest arc is kept.
+ */
+class ContractionHierarchy::Contractor
+{
+public:
+    Contractor(size_t numVertices, std::vector<Arc>& arcs) :
+            numVertices(numVertices), arcs(arcs), outArcs(numVertices), inArcs(numVertices), contracted(numVertices, false),
+            deletedNeighbours(numVertices, 0), witnessDist(numVertices), witnessStamp(numVertices, 0), witnessGeneration(0),
+            upArcs(numVertices), downArcs(numVertices), numShortcuts(0)
+    {
+    }
+
+    /**
+     * Adds an edge of the graph
+     */
+    void addEdge(Vertex from, Vertex to, double weight, uint32_t edge)
+    {
+        if (from != to)
+        {
+            addArc(from, to, weight, NO_ARC, NO_ARC, edge);
+        }
+    }
+
+    /**
+     * @return the priority of a vertex for the contraction order; vertices with lower priority are contracted first
+     */
+    int getPriority(Vertex v)
+    {
+        compact(v);
+        int degree = outArcs[v].size() + inArcs[v].size();
+        int shortcuts = processVertex(v, false, ORDERING_SETTLE_LIMIT);
+        return 2 * (shortcuts - degree) + deletedNeighbours[v];
+    }
+
+    /**
+     * Contracts a vertex: its remaining arcs become part of the hierarchy and the shortcuts bypassing it are added
+     */
+    void contract(Vertex v)
+    {
+        compact(v);
+        upArcs[v] = outArcs[v];
+        downArcs[v] = inArcs[v];
+        processVertex(v, true, CONTRACTION_SETTLE_LIMIT);
+        contracted[v] = true;
+
+        for (std::vector<uint32_t>::const_iterator it = outArcs[v].begin(); it != outArcs[v].end(); ++it)
+        {
+            ++deletedNeighbours[arcs[*it].to];
+        }
+        for (std::vector<uint32_t>::const_iterator it = inArcs[v].begin(); it != inArcs[v].end(); ++it)
+        {
+            ++deletedNeighbours[arcs[*it].from];
+        }
+        std::vector<uint32_t>().swap(outArcs[v]);
+        std::vector<uint32_t>().swap(inArcs[v]);
+    }
+
+    bool isContracted(Vertex v) const
+    {
+        return contracted[v];
+    }
+
+    /**
+     * Flattens the arcs recorded at contraction into the compressed lists of the hierarchy
+     */
+    void fill(Hierarchy& hierarchy) const
+    {
+        flatten(upArcs, hierarchy.upOffsets, hierarchy.upArcs);
+        flatten(downArcs, hierarchy.downOffsets, hierarchy.downArcs);
+        hierarchy.numShortcuts = numShortcuts;
+    }
+
+private:
+    /**
+     * Adds an arc, unless a cheaper arc already links the same vertices. A more expensive one is replaced.
+     */
+    void addArc(Vertex from, Vertex to, double weight, uint32_t first, uint32_t second, uint32_t edge)
+    {
+        std::vector<uint32_t>& fromOut = outArcs[from];
+        std::vector<uint32_t>::iterator existing = fromOut.begin();
+        while (existing != fromOut.end() && arcs[*existing].to != to)
+        {
+            ++existing;
+        }
+        if (existing != fromOut.end() && arcs[*existing].weight <= weight)
+        {
+            return;
+        }
+
+        Arc arc;
+        arc.from = from;
+        arc.to = to;
+        arc.weight = weight;
+        arc.first = first;
+        arc.second = second;
+        arc.edge = edge;
+        uint32_t id = arcs.size();
+        arcs.push_back(arc);
+        if (first != NO_ARC)
+        {
+            ++numShortcuts;
+        }
+
+        if (existing != fromOut.end())
+        {
+            std::replace(inArcs[to].begin(), inArcs[to].end(), *existing, id);
+            *existing = id;
+        }
+        else
+        {
+            fromOut.push_back(id);
+            inArcs[to].push_back(id);
+        }
+    }
+
+    /**
+     * Drops the arcs of v to or from contracted vertices
+     */
+    void compact(Vertex v)
+    {
+        std::vector<uint32_t>& out = outArcs[v];
+        size_t kept = 0;
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            if (!contracted[arcs[out[i]].to])
+            {
+                out[kept++] = out[i];
+            }
+        }
+        out.resize(kept);
+
+        std::vector<uint32_t>& in = inArcs[v];
+        kept = 0;
+        for (size_t i = 0; i < in.size(); ++i)
+        {
+            if (!contracted[arcs[in[i]].from])
+            {
+                in[kept++] = in[i];
+            }
+        }
+        in.resize(kept);
+    }
+
+    /**
+     * Finds the shortcuts needed to bypass v, and adds them if apply is set
+     * @return the number of shortcuts needed
+     */
+    int processVertex(Vertex v, bool apply, unsigned settleLimit)
+    {
+        int shortcuts = 0;
+        const std::vector<uint32_t> in = inArcs[v];
+        const std::vector<uint32_t>& out = outArcs[v];
+        for (std::vector<uint32_t>::const_iterator inIt = in.begin(); inIt != in.end(); ++inIt)
+        {
+            const Arc inArc = arcs[*inIt];
+            Vertex u = inArc.from;
+            if (contracted[u])
+            {
+                continue;
+            }
+
+            double maxOut = -1.0;
+            for (std::vector<uint32_t>::const_iterator outIt = out.begin(); outIt != out.end(); ++outIt)
+            {
+                if (arcs[*outIt].to != u && !contracted[arcs[*outIt].to])
+                {
+                    maxOut = std::max(maxOut, arcs[*outIt].weight);
+                }
+            }
+            if (maxOut < 0.0)
+            {
+                continue;
+            }
+
+            witnessSearch(u, v, inArc.weight + maxOut, settleLimit);
+            for (size_t i = 0; i < out.size(); ++i)
+            {
+                //copied, as adding a shortcut may reallocate arcs
+                const Arc outArc = arcs[out[i]];
+                Vertex w = outArc.to;
+                if (w == u || contracted[w])
+                {
+                    continue;
+                }
+
+                double viaWeight = inArc.weight + outArc.weight;
+                if (witnessStamp[w] == witnessGeneration && witnessDist[w] <= viaWeight)
+                {
+                    continue;
+                }
+
+                ++shortcuts;
+                if (apply)
+                {
+                    addArc(u, w, viaWeight, *inIt, out[i], NO_ARC);
+                }
+            }
+        }
+        return shortcuts;
+    }
+
+    /**
+     * Dijkstra from source over the remaining vertices, except avoid, up to maxDist or settleLimit settled vertices
+     */
+    void witnessSearch(Vertex source, Vertex avoid, double maxDist, unsigned settleLimit)
+    {
+        ++witnessGeneration;
+        if (witnessGeneration == 0)
+        {
+            std::fill(witnessStamp.begin(), witnessStamp.end(), 0);
+            witnessGeneration = 1;
+        }
+
+        MinHeap heap;
+        witnessDist[source] = 0.0;
+        witnessStamp[source] = witnessGeneration;
+        heap.push(DistVertex(0.0, source));
+        unsigned settled = 0;
+        while (!heap.empty() && settled < settleLimit)
+        {
+            DistVertex top = heap.top();
+            heap.pop();
+            if (top.first > witnessDist[top.second])
+            {
+                continue;
+            }
+            if (top.first > maxDist)
+            {
+                break;
+            }
+            ++settled;
+
+            const std::vector<uint32_t>& out = outArcs[top.second];
+            for (std::vector<uint32_t>::const_iterator it = out.begin(); it != out.end(); ++it)
+            {
+                const Arc& arc = arcs[*it];
+                if (arc.to == avoid || contracted[arc.to])
+                {
+                    continue;
+                }
+                double dist = top.first + arc.weight;
+                if (witnessStamp[arc.to] != witnessGeneration || dist < witnessDist[arc.to])
+                {
+                    witnessDist[arc.to] = dist;
+                    witnessStamp[arc.to] = witnessGeneration;
+                    heap.push(DistVertex(dist, arc.to));
+                }
+            }
+        }
+    }
+
+    static void flatten(const std::vector<std::vector<uint32_t> >& lists, std::vector<size_t>& offsets, std::vector<uint32_t>& ids)
+    {
+        offsets.assign(lists.size() + 1, 0);
+        for (size_t v = 0; v < lists.size(); ++v)
+        {
+            offsets[v + 1] = offsets[v] + lists[v].size();
+        }
+        ids.clear();
+        ids.reserve(offsets.back());
+        for (size_t v = 0; v < lists.size(); ++v)
+        {
+            ids.insert(ids.end(), lists[v].begin(), lists[v].end());
+        }
+    }
+
+    size_t numVertices;
+    std::vector<Arc>& arcs;
+
+    /**cheapest arcs between the vertices not contracted yet*/
+    std::vector<std::vector<uint32_t> > outArcs;
+    std::vector<std::vector<uint32_t> > inArcs;
+
+    std::vector<bool> contracted;
+    std::vector<int> deletedNeighbours;
+
+    /**witness search labels*/
+    std::vector<double> witnessDist;
+    std::vector<uint32_t> witnessStamp;
+    uint32_t witnessGeneration;
+
+    /**arcs of each vertex to higher ranked vertices, recorded when it was contracted*/
+    std::vector<std::vector<uint32_t> > upArcs;
+    std::vector<std::vector<uint32_t> > downArcs;
+
+    size_t numShortcuts;
+};
+
+ContractionHierarchy::ContractionHierarchy() : graph(nullptr)
+{
+}
+
+void ContractionHierarchy::build(const StreetDirectory::Graph& graph)
+{
+    this->graph = &graph;
+    edges.clear();
+    edges.reserve(boost::num_edges(graph));
+    std::vector<double> weights;
+    weights.reserve(boost::num_edges(graph));
+
+    StreetDirectory::Graph::edge_iterator it, end;
+    for (boost::tie(it, end) = boost::edges(graph); it != end; ++it)
+    {
+        edges.push_back(*it);
+        weights.push_back(boost::get(boost::edge_weight, graph, *it));
+    }
+
+    boost::shared_ptr<Hierarchy> result = contract(weights, true);
+    boost::unique_lock<boost::shared_mutex> lock(hierarchyMutex);
+    hierarchy = result;
+}
+
+void ContractionHierarchy::customize(const WeightFunction& weight)
+{
+    if (!isBuilt())
+    {
+        throw std::runtime_error("ContractionHierarchy: customize() called before build()");
+    }
+
+    std::vector<double> weights(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        weights[i] = weight(edges[i]);
+    }
+
+    boost::shared_ptr<Hierarchy> result = contract(weights, false);
+    boost::unique_lock<boost::shared_mutex> lock(hierarchyMutex);
+    hierarchy = result;
+}
+
+bool ContractionHierarchy::isBuilt() const
+{
+    boost::shared_lock<boost::shared_mutex> lock(hierarchyMutex);
+    return (hierarchy.get() != nullptr);
+}
+
+size_t ContractionHierarchy::getNumShortcuts() const
+{
+    boost::shared_lock<boost::shared_mutex> lock(hierarchyMutex);
+    return (hierarchy ? hierarchy->numShortcuts : 0);
+}
+
+boost::shared_ptr<ContractionHierarchy::Hierarchy> ContractionHierarchy::contract(const std::vector<double>& weights, bool computeOrder)
+{
+    size_t numVertices = boost::num_vertices(*graph);
+    boost::shared_ptr<Hierarchy> result(new Hierarchy());
+    result->arcs.reserve(edges.size() * 2);
+    Contractor contractor(numVertices, result->arcs);
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        contractor.addEdge(boost::source(edges[i], *graph), boost::target(edges[i], *graph), weights[i], i);
+    }
+
+    if (computeOrder)
+    {
+        //lazy updates: a vertex is only contracted if its refreshed priority is still the smallest
+        typedef std::pair<int, Vertex> PriorityVertex;
+        std::priority_queue<PriorityVertex, std::vector<PriorityVertex>, std::greater<PriorityVertex> > queue;
+        for (Vertex v = 0; v < numVertices; ++v)
+        {
+            queue.push(PriorityVertex(contractor.getPriority(v), v));
+        }
+
+        rank.assign(numVertices, 0);
+        uint32_t nextRank = 0;
+        while (!queue.empty())
+        {
+            Vertex v = queue.top().second;
+            queue.pop();
+            if (contractor.isContracted(v))
+            {
+                continue;
+            }
+
+            int priority = contractor.getPriority(v);
+            if (!queue.empty() && priority > queue.top().first)
+            {
+                queue.push(PriorityVertex(priority, v));
+                continue;
+            }
+
+            contractor.contract(v);
+            rank[v] = nextRank++;
+        }
+    }
+    else
+    {
+        std::vector<Vertex> order(numVertices);
+        for (Vertex v = 0; v < numVertices; ++v)
+        {
+            order[rank[v]] = v;
+        }
+        for (std::vector<Vertex>::const_iterator it = order.begin(); it != order.end(); ++it)
+        {
+            contractor.contract(*it);
+        }
+    }
+
+    contractor.fill(*result);
+    return result;
+}
+
+bool ContractionHierarchy::query(Vertex fromVertex, Vertex toVertex, std::vector<Edge>& path, double& cost) const
+{
+    path.clear();
+    cost = 0.0;
+
+    boost::shared_ptr<const Hierarchy> current;
+    {
+        boost::shared_lock<boost::shared_mutex> lock(hierarchyMutex);
+        current = hierarchy;
+    }
+    if (!current)
+    {
+        return false;
+    }
+    if (fromVertex == toVertex)
+    {
+        return true;
+    }
+
+    const Hierarchy& hier = *current;
+    QueryWorkspace& ws = getQueryWorkspace();
+    ws.begin(rank.size());
+    ws.label(0, fromVertex, 0.0, NO_ARC);
+    ws.label(1, toVertex, 0.0, NO_ARC);
+
+    double best = std::numeric_limits<double>::max();
+    Vertex meeting = toVertex;
+    bool found = false;
+
+    while (true)
+    {
+        //advance the direction with the smaller key; each direction stops once it cannot improve on the best path
+        bool fwdOpen = !ws.heap[0].empty() && ws.heap[0].top().first < best;
+        bool bwdOpen = !ws.heap[1].empty() && ws.heap[1].top().first < best;
+        if (!fwdOpen && !bwdOpen)
+        {
+            break;
+        }
+        int dir = (fwdOpen && (!bwdOpen || ws.heap[0].top().first <= ws.heap[1].top().first)) ? 0 : 1;
+
+        DistVertex top = ws.heap[dir].top();
+        ws.heap[dir].pop();
+        Vertex v = top.second;
+        if (top.first > ws.dist[dir][v])
+        {
+            continue;
+        }
+
+        if (ws.isLabelled(1 - dir, v) && top.first + ws.dist[1 - dir][v] < best)
+        {
+            best = top.first + ws.dist[1 - dir][v];
+            meeting = v;
+            found = true;
+        }
+
+        //stall-on-demand: v is not on a shortest path if a higher ranked vertex reaches it more cheaply
+        const std::vector<size_t>& stallOffsets = (dir == 0 ? hier.downOffsets : hier.upOffsets);
+        const std::vector<uint32_t>& stallIds = (dir == 0 ? hier.downArcs : hier.upArcs);
+        bool stalled = false;
+        for (size_t i = stallOffsets[v]; i < stallOffsets[v + 1] && !stalled; ++i)
+        {
+            const Arc& arc = hier.arcs[stallIds[i]];
+            Vertex prev = (dir == 0 ? arc.from : arc.to);
+            stalled = (ws.isLabelled(dir, prev) && ws.dist[dir][prev] + arc.weight < top.first);
+        }
+        if (stalled)
+        {
+            continue;
+        }
+
+        const std::vector<size_t>& offsets = (dir == 0 ? hier.upOffsets : hier.downOffsets);
+        const std::vector<uint32_t>& ids = (dir == 0 ? hier.upArcs : hier.downArcs);
+        for (size_t i = offsets[v]; i < offsets[v + 1]; ++i)
+        {
+            const Arc& arc = hier.arcs[ids[i]];
+            Vertex next = (dir == 0 ? arc.to : arc.from);
+            double dist = top.first + arc.weight;
+            if (!ws.isLabelled(dir, next) || dist < ws.dist[dir][next])
+            {
+                ws.label(dir, next, dist, ids[i]);
+            }
+        }
+    }
+
+    if (!found)
+    {
+        return false;
+    }
+
+    //arcs from fromVertex up to the meeting vertex, then down to toVertex
+    std::vector<uint32_t> arcPath;
+    for (Vertex v = meeting; v != fromVertex; v = hier.arcs[ws.parent[0][v]].from)
+    {
+        arcPath.push_back(ws.parent[0][v]);
+    }
+    std::reverse(arcPath.begin(), arcPath.end());
+    for (Vertex v = meeting; v != toVertex; v = hier.arcs[ws.parent[1][v]].to)
+    {
+        arcPath.push_back(ws.parent[1][v]);
+    }
+
+    for (std::vector<uint32_t>::const_iterator it = arcPath.begin(); it != arcPath.end(); ++it)
+    {
+        unpack(hier, *it, path);
+    }
+    cost = best;
+    return true;
+}
+
+void ContractionHierarchy::unpack(const Hierarchy& hierarchy, uint32_t arc, std::vector<Edge>& path) const
+{
+    std::vector<uint32_t> pending(1, arc);
+    while (!pending.empty())
+    {
+        const Arc& current = hierarchy.arcs[pending.back()];
+        pending.pop_back();
+        if (current.first == NO_ARC)
+        {
+            path.push_back(edges[current.edge]);
+        }
+        else
+        {
+            pending.push_back(current.second);
+            pending.push_back(current.first);
+        }
+    }
+}
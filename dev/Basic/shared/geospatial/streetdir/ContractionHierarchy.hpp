@@ -0,0 +1,149 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/utility.hpp>
+
+#include "StreetDirectory.hpp"
+
+namespace sim_mob
+{
+
+/**
+ * Contraction hierarchy over a StreetDirectory::Graph.
+ *
+ * build() ranks the vertices (edge difference + deleted neighbours, lazily updated) and contracts them in that order,
+ * adding a shortcut u->w for every pair of arcs u->v->w which is not bypassed by a witness path. A query is then a
+ * bidirectional Dijkstra which only relaxes arcs towards higher ranked vertices; its search space is a few hundred
+ * vertices even on city-scale networks. Shortcuts are unpacked into the original edges of the graph.
+ *
+ * The vertex order does not depend much on the weights, so customize() re-contracts the graph with new weights (e.g. link
+ * travel times of the current interval) in the order computed by build(), which is considerably cheaper than build().
+ * The hierarchy being queried is swapped atomically, so queries can run concurrently with customize().
+ *
+ * The graph must outlive the hierarchy and must not be modified after build().
+ */
+class ContractionHierarchy : private boost::noncopyable
+{
+public:
+    typedef StreetDirectory::Vertex Vertex;
+    typedef StreetDirectory::Edge Edge;
+
+    /**Weight of an edge of the graph; must not be negative*/
+    typedef boost::function<double (const Edge&)> WeightFunction;
+
+    ContractionHierarchy();
+
+    /**
+     * Ranks and contracts the vertices of a graph, using its edge_weight property
+     *
+     * @param graph is the graph object
+     */
+    void build(const StreetDirectory::Graph& graph);
+
+    /**
+     * Re-contracts the graph with new edge weights, keeping the vertex order computed by build()
+     *
+     * @param weight returns the new weight of each edge of the graph
+     */
+    void customize(const WeightFunction& weight);
+
+    /**
+     * @return true if build() was called
+     */
+    bool isBuilt() const;
+
+    /**
+     * Searches the shortest path between two vertices
+     *
+     * @param fromVertex is a source vertex in the graph
+     * @param toVertex is a sink vertex in the graph
+     * @param path output: edges of the shortest path, from fromVertex to toVertex
+     * @param cost output: cost of the path
+     *
+     * @return true if toVertex is reachable from fromVertex; false otherwise
+     */
+    bool query(Vertex fromVertex, Vertex toVertex, std::vector<Edge>& path, double& cost) const;
+
+    /**
+     * @return the number of shortcuts added by the last contraction
+     */
+    size_t getNumShortcuts() const;
+
+private:
+    /**arc id marking the absence of an arc*/
+    static const uint32_t NO_ARC = static_cast<uint32_t>(-1);
+
+    /**
+     * An arc of the hierarchy: either an edge of the graph or a shortcut made of two arcs meeting at a lower ranked vertex
+     */
+    struct Arc
+    {
+        Vertex from;
+        Vertex to;
+        double weight;
+
+        /**for shortcuts, the arcs from->middle and middle->to; NO_ARC for edges of the graph*/
+        uint32_t first;
+        uint32_t second;
+
+        /**for edges of the graph, the index of the edge in ContractionHierarchy::edges*/
+        uint32_t edge;
+    };
+
+    /**
+     * Result of a contraction. Immutable once built; customize() replaces it as a whole.
+     */
+    struct Hierarchy
+    {
+        std::vector<Arc> arcs;
+
+        /**arcs leaving each vertex towards higher ranked vertices, in compressed form (offsets + arc ids)*/
+        std::vector<size_t> upOffsets;
+        std::vector<uint32_t> upArcs;
+
+        /**arcs entering each vertex from higher ranked vertices, in compressed form (offsets + arc ids)*/
+        std::vector<size_t> downOffsets;
+        std::vector<uint32_t> downArcs;
+
+        size_t numShortcuts;
+    };
+
+    class Contractor;
+
+    /**
+     * Contracts the graph with the given edge weights. If computeOrder is set, the vertices are ranked on the fly and
+     * rank is filled in; otherwise the existing rank is followed.
+     */
+    boost::shared_ptr<Hierarchy> contract(const std::vector<double>& weights, bool computeOrder);
+
+    /**
+     * Appends the edges of the graph making up an arc to path
+     */
+    void unpack(const Hierarchy& hierarchy, uint32_t arc, std::vector<Edge>& path) const;
+
+    /**the graph the hierarchy was built for*/
+    const StreetDirectory::Graph* graph;
+
+    /**edges of the graph; arcs refer to them by index*/
+    std::vector<Edge> edges;
+
+    /**contraction order of each vertex*/
+    std::vector<uint32_t> rank;
+
+    /**hierarchy being queried*/
+    boost::shared_ptr<const Hierarchy> hierarchy;
+
+    /**protects the swap of hierarchy*/
+    mutable boost::shared_mutex hierarchyMutex;
+};
+
+}
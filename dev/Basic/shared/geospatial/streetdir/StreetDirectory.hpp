@@ -268,6 +268,26 @@ public:
             virtual std::vector<WayPoint> GetShortestDrivingPath(const VertexDesc &from, const VertexDesc &to, const std::vector<const Link *> &blackList,
                                                              TimeRange timeRange = Default, int randomGraphIdx = 0) const = 0;
 
+        /**
+         * Retrieves the shortest driving paths from one original point to several destinations.
+         * The default implementation searches each path on its own; implementations may share one search.
+         *
+         * @param from is original vertex in the graph
+         * @param to are destination vertices in the graph
+         *
+         * @return for each destination, the shortest path result (empty if not reachable).
+         */
+            virtual std::vector<std::vector<WayPoint> > GetShortestDrivingPaths(const VertexDesc &from, const std::vector<VertexDesc> &to) const
+            {
+                std::vector<std::vector<WayPoint> > res;
+                res.reserve(to.size());
+                for (std::vector<VertexDesc>::const_iterator it = to.begin(); it != to.end(); ++it)
+                {
+                    res.push_back(GetShortestDrivingPath(from, *it, std::vector<const Link*>()));
+                }
+                return res;
+            }
+
         /**
          * Prints the graph structure
          * @param outFile is a output stream is original vertex in the graph
@@ -338,6 +358,32 @@ public:
             return res;
         }
 
+    /**
+     * Return the distance-based shortest paths to drive from one node to several others, as SearchShortestDrivingPath
+     * would for each of them, but sharing the search where the implementation allows it.
+     *
+         * @param from is a parameter to hold starting node/link
+         * @param to are the ending nodes/links
+     *
+     * @return for each ending node/link, the shortest path result (empty if not reachable).
+     */
+        template<class OriginType, class DestinationType>
+        std::vector<std::vector<WayPoint> > SearchShortestDrivingPaths(const OriginType &from, const std::vector<const DestinationType*>& to) const
+        {
+            if (!spImpl)
+            {
+                    return std::vector<std::vector<WayPoint> >(to.size());
+            }
+            VertexDesc source = DrivingVertex(from);
+            std::vector<VertexDesc> sinks;
+            sinks.reserve(to.size());
+            for (typename std::vector<const DestinationType*>::const_iterator it = to.begin(); it != to.end(); ++it)
+            {
+                sinks.push_back(DrivingVertex(**it));
+            }
+            return spImpl->GetShortestDrivingPaths(source, sinks);
+        }
+
     /**
      * Retrieves a vertex in the distance graph
      *
@@ -64,6 +64,9 @@ void LuaModel::initialize()
         fs::path fPath((*it));
         loadLuaFile(state.get(), fPath);
     }
+    mapNativeFunctions();
+    functions.clear();
+    prefixedFunctions.clear();
     initialized = true;
 }
 
@@ -77,6 +80,9 @@ void LuaModel::loadFile(const std::string& filePath)
             if (initialized)
             {
                 loadLuaFile(state.get(), fPath);
+                mapNativeFunctions();
+                functions.clear();
+                prefixedFunctions.clear();
             }
             files.push_back(filePath);
         }
@@ -115,3 +121,34 @@ void LuaModel::loadDirectory(const std::string& dirPath)
         throw runtime_error("Model folder value is not a valid directory.");
     }
 }
+
+const luabridge::LuaRef& LuaModel::getFunction(const std::string& name) const
+{
+    FunctionMap::const_iterator it = functions.find(name);
+    if (it != functions.end())
+    {
+        return it->second;
+    }
+    return cacheFunction(functions, name, name);
+}
+
+const luabridge::LuaRef& LuaModel::getFunction(const char* prefix, const std::string& model) const
+{
+    FunctionMap& modelFunctions = prefixedFunctions[prefix];
+    FunctionMap::const_iterator it = modelFunctions.find(model);
+    if (it != modelFunctions.end())
+    {
+        return it->second;
+    }
+    return cacheFunction(modelFunctions, model, prefix + model);
+}
+
+const luabridge::LuaRef& LuaModel::cacheFunction(FunctionMap& functionMap, const std::string& mapKey, const std::string& name) const
+{
+    luabridge::LuaRef function = luabridge::getGlobal(state.get(), name.c_str());
+    if (!function.isFunction())
+    {
+        throw runtime_error("lua function " + name + " is not defined by the scripts");
+    }
+    return functionMap.insert(std::make_pair(mapKey, function)).first->second;
+}
@@ -11,7 +11,9 @@
 #include <string>
 #include <list>
 #include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
 #include "LuaLibrary.hpp"
+#include "third-party/luabridge/LuaBridge.h"
 
 namespace sim_mob {
     namespace lua {
@@ -47,10 +49,73 @@ namespace sim_mob {
              * Map C++ classes to Lua.
              */
              virtual void mapClasses()=0;
+
+            /**
+             * Replaces functions defined by the scripts with native ones.
+             * Called each time scripts are loaded, after they are run.
+             */
+             virtual void mapNativeFunctions() {}
+
+            /**
+             * Gets a global function of the scripts.
+             * The function is looked up in the lua state on the first call only; its reference is
+             * kept in the lua registry and returned by later calls. The references are dropped
+             * whenever scripts are loaded, as scripts may redefine functions.
+             * @param name of the function
+             * @return reference to the function
+             * @throws std::runtime_error if no function has this name
+             */
+            const luabridge::LuaRef& getFunction(const std::string& name) const;
+
+            /**
+             * Gets the global function named prefix + model, e.g. "choose_" + "tmdw".
+             * Once the function is cached, the name is not built again.
+             * @param prefix of the name; a string literal
+             * @param model rest of the name
+             * @return reference to the function
+             * @throws std::runtime_error if no function has this name
+             */
+            const luabridge::LuaRef& getFunction(const char* prefix, const std::string& model) const;
+
+            /**
+             * Calls a lua function which returns a single value and converts the value to R,
+             * without creating a LuaRef for it.
+             * Arguments are pushed as LuaBridge does; objects must be passed by pointer so that
+             * they are not copied into the lua state.
+             * @param function to call
+             * @param args arguments of the function
+             * @return value returned by the function
+             */
+            template <class R, class... Args>
+            R call(const luabridge::LuaRef& function, Args... args) const
+            {
+                lua_State* luaState = state.get();
+                function.push(luaState);
+                int pushed[] = { 0, (luabridge::Stack<Args>::push(luaState, args), 0)... };
+                (void) pushed;
+                luabridge::LuaException::pcall(luaState, sizeof...(Args), 1);
+                R result = luabridge::Stack<R>::get(luaState, -1);
+                lua_pop(luaState, 1);
+                return result;
+            }
         protected:
             bool initialized;
             boost::shared_ptr<lua_State> state;
             std::list<std::string> files;
+
+        private:
+            typedef boost::unordered_map<std::string, luabridge::LuaRef> FunctionMap;
+
+            /**
+             * Looks up a global function and keeps its reference in functionMap.
+             */
+            const luabridge::LuaRef& cacheFunction(FunctionMap& functionMap, const std::string& mapKey, const std::string& name) const;
+
+            /** functions by name */
+            mutable FunctionMap functions;
+
+            /** functions named prefix + model, by prefix then by model */
+            mutable boost::unordered_map<const char*, FunctionMap> prefixedFunctions;
         };
     }
 }
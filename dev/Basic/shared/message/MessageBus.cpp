@@ -11,6 +11,7 @@
 #include "MessageBus.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <boost/format.hpp>
 #include <boost/function.hpp>
 #include <boost/thread/thread.hpp>
@@ -82,6 +83,9 @@ namespace {
      *        Otherwise the default priority will be MIN_CUSTOM_PRIORITY.
      * @param processOnMainThread tells to process the message
      *        within the main thread context.
+     *
+     * internal and event are set by the function posting the message,
+     * so that the message itself never needs to be inspected.
      */
     typedef struct MessageEntry {
 
@@ -91,17 +95,6 @@ namespace {
         triggerTime(0),type(0){
         }
 
-        MessageEntry(const MessageEntry& source) {
-            this->destination = source.destination;
-            this->message = source.message;
-            this->type = source.type;
-            this->internal = source.internal;
-            this->priority = source.priority;
-            this->event = source.event;
-            this->processOnMainThread = source.processOnMainThread;
-            this->triggerTime = source.triggerTime;
-        }
-
         MessageHandler* destination;
         MessageBus::MessagePtr message;
         Message::MessageType type;
@@ -130,22 +123,38 @@ namespace {
 
     typedef priority_queue<MessageEntry, std::deque<MessageEntry>, CompareTriggerTime> TimebasedMessageQueue;
 
+    /**
+     * Messages exchanged between two thread contexts during a tick.
+     * Buffers are swapped between the sender and the receiver rather than copied,
+     * so their storage is reused from tick to tick.
+     */
+    typedef vector<MessageEntry> MessageBuffer;
+
     /**
      * Represents a thread context.
      *
+     * Messages posted by the thread are put in one outbox per destination context,
+     * which only this thread writes to until the main thread distributes them by
+     * swapping each outbox with the inbox of the destination for this sender.
+     * Each thread then merges its own inboxes into its input queue.
+     *
      * @param threadId String id the thread identifier.
      * @param main tells the context is associated with the main thread.
+     * @param index position of the context in the list of contexts.
      * @param input queue for messages.
-     * @param output queue for messages.
+     * @param outboxes messages posted by this thread, by index of the destination context.
+     * @param inboxes messages received from other threads, by index of the sending context.
      */
     struct ThreadContext {
 
         ThreadContext()
         : eventPublisher(nullptr),
+        eventHandler(nullptr),
+        registrationContext(nullptr),
         input(ComparePriority()),
-        output(ComparePriority()),
         futureEventList(CompareTriggerTime()),
         main(false),
+        index(0),
         receivedMessages(0),
         processedMessages(0),
         eventMessages(0) {
@@ -153,10 +162,36 @@ namespace {
 
         virtual ~ThreadContext() {
             CleanUpQueue(input);
-            CleanUpQueue(output);
             safe_delete_item(eventPublisher);
         }
 
+        /**
+         * Gets the outbox for messages to the given context.
+         * @param destination context of the receiver.
+         * @return outbox for the destination.
+         */
+        MessageBuffer& GetOutbox(const ThreadContext* destination) {
+            if (outboxes.size() <= destination->index) {
+                outboxes.resize(destination->index + 1);
+            }
+            return outboxes[destination->index];
+        }
+
+        /**
+         * Gets the number of messages posted by this thread or delivered to it
+         * which were not processed yet.
+         */
+        size_t GetPendingMessages() const {
+            size_t pending = input.size() + unresolvedOutbox.size() + eventOutbox.size() + futureEventList.size();
+            for (vector<MessageBuffer>::const_iterator it = outboxes.begin(); it != outboxes.end(); ++it) {
+                pending += it->size();
+            }
+            for (vector<MessageBuffer>::const_iterator it = inboxes.begin(); it != inboxes.end(); ++it) {
+                pending += it->size();
+            }
+            return pending;
+        }
+
         /**
          * Cleanup the given queue reference.
          * @param queue to clean up.
@@ -169,11 +204,23 @@ namespace {
 
         boost::thread::id threadId;
         bool main;
+        size_t index;
         MessageQueue input;
-        MessageQueue output;
+        vector<MessageBuffer> outboxes;
+        //messages to handlers which had no context when posted.
+        MessageBuffer unresolvedOutbox;
+        //events published by this thread.
+        MessageBuffer eventOutbox;
+        vector<MessageBuffer> inboxes;
+        //events published by all threads, shared by all contexts.
+        vector<boost::shared_ptr<const MessageBuffer> > eventInboxes;
         TimebasedMessageQueue futureEventList;
         //event publisher for each thread context.
         EventPublisher* eventPublisher;
+        //event publisher as the handler of the event messages.
+        MessageHandler* eventHandler;
+        //context receiving the handlers registered by this thread (this one if null).
+        ThreadContext* registrationContext;
         // statistics
         unsigned long long int receivedMessages;
         unsigned long long int processedMessages;
@@ -181,7 +228,7 @@ namespace {
 
     };
 
-    typedef list<ThreadContext*> ContextList;
+    typedef vector<ThreadContext*> ContextList;
 
     /***************************************************************************
      *                              Internal Classes
@@ -321,6 +368,21 @@ namespace {
      */
     ThreadContext* GetThreadContext();
 
+    /**
+     * Puts a message posted by the given context in the outbox of its destination.
+     * @param entry message to post.
+     * @param context of the thread posting the message.
+     */
+    void Route(const MessageEntry& entry, ThreadContext* context);
+
+    /**
+     * Posts a message on the given context.
+     * @param entry message to post; distributed when the time of the bus reaches its
+     *        trigger time if the trigger time is not 0, else at the next distribution.
+     * @param context of the thread posting the message.
+     */
+    void Post(const MessageEntry& entry, ThreadContext* context);
+
     void deleteContext(ThreadContext* ctx){}
     /**
      * Deletes all contexts in the system
@@ -339,6 +401,13 @@ namespace {
     boost::thread_specific_ptr<ThreadContext> threadContext (deleteContext);
     ContextList threadContexts;
     boost::shared_mutex contextsMutex;
+    ThreadContext* mainThreadContext = nullptr;
+
+    /// set when a handler leaves a context, so that messages already in outboxes are routed again
+    std::atomic<bool> handlersMoved(false);
+
+    /// whether SendMessage() delivers instantaneously within a thread context
+    bool instantaneousDelivery = true;
 }// anonymous namespace
 
 /***************************************************************************
@@ -348,13 +417,21 @@ namespace {
 void MessageBus::RegisterMainThread() {
     if (!threadContext.get()) {
         ThreadContext* mainContext = new ThreadContext();
+        InternalEventPublisher* publisher = new InternalEventPublisher();
         mainContext->threadId = boost::this_thread::get_id();
-        mainContext->eventPublisher = new InternalEventPublisher();
+        mainContext->eventPublisher = publisher;
+        mainContext->eventHandler = publisher;
         mainContext->main = true;
         GetInstance().context = static_cast<void*> (mainContext);
         threadContext.reset(mainContext);
-        threadContexts.push_back(mainContext);
-        RegisterHandler(dynamic_cast<MessageHandler*> (mainContext->eventPublisher));
+        {// thread-safe scope
+            upgrade_lock<shared_mutex> upgradeLock(contextsMutex);
+            upgrade_to_unique_lock<shared_mutex> lock(upgradeLock);
+            mainContext->index = threadContexts.size();
+            threadContexts.push_back(mainContext);
+        }
+        mainThreadContext = mainContext;
+        RegisterHandler(mainContext->eventHandler);
     } else {
         throw runtime_error("MessageBus - Main thread already has a context associated.");
     }
@@ -368,22 +445,26 @@ void MessageBus::UnRegisterMainThread() {
 #endif
 
     GetInstance().context = nullptr;
+    mainThreadContext = nullptr;
     deleteAllContexts();
 }
 
 void MessageBus::RegisterThread() {
     if (!threadContext.get()) {
         ThreadContext* context = new ThreadContext();
+        InternalEventPublisher* publisher = new InternalEventPublisher();
         context->threadId = boost::this_thread::get_id();
-        context->eventPublisher = new InternalEventPublisher();
+        context->eventPublisher = publisher;
+        context->eventHandler = publisher;
         context->main = false;
         {// thread-safe scope
             upgrade_lock<shared_mutex> upgradeLock(contextsMutex);
             upgrade_to_unique_lock<shared_mutex> lock(upgradeLock);
+            context->index = threadContexts.size();
             threadContexts.push_back(context);
         }
         threadContext.reset(context);
-        RegisterHandler(dynamic_cast<MessageHandler*> (context->eventPublisher));
+        RegisterHandler(context->eventHandler);
     } else {
         throw runtime_error("MessageBus - Current thread already has a context associated.");
     }
@@ -406,6 +487,9 @@ void MessageBus::RegisterHandler(MessageHandler* handler) {
     CheckThreadContext();
     if (handler) {
         ThreadContext* context = GetThreadContext();
+        if (context->registrationContext) {
+            context = context->registrationContext;
+        }
         if (!(handler->context)) {
             handler->context = static_cast<void*> (context);
         } else if (context != handler->context) {
@@ -419,8 +503,9 @@ void MessageBus::UnRegisterHandler(MessageHandler* handler) {
     CheckThreadContext();
     if (handler && handler->context) {
         ThreadContext* context = GetThreadContext();
-        if (context == handler->context || context->main) {
+        if (context == handler->context || context->registrationContext == handler->context || context->main) {
             handler->context = nullptr;
+            handlersMoved.store(true, std::memory_order_relaxed);
         } else {
             throw runtime_error("MessageBus - To unregister the handler it is necessary to use the registered thread context.");
         }
@@ -436,10 +521,20 @@ void MessageBus::ReRegisterHandler(MessageHandler* handler, void* newContext)
         {
             throw runtime_error("MessageBus - invalid thread context passed for re-registration");
         }
-        handler->context = newContext;
+        if (handler->context != newContext)
+        {
+            handler->context = newContext;
+            handlersMoved.store(true, std::memory_order_relaxed);
+        }
     }
 }
 
+void MessageBus::SetRegistrationContext(void* registrationContext)
+{
+    CheckThreadContext();
+    GetThreadContext()->registrationContext = static_cast<ThreadContext*> (registrationContext);
+}
+
 void MessageBus::DistributeMessages() {
     CheckMainThread();
     DispatchMessages();
@@ -447,59 +542,84 @@ void MessageBus::DistributeMessages() {
     ThreadDispatchMessages();
 }
 
-void dispatch(const MessageEntry& entry, ThreadContext* &context,ThreadContext* &mainContext)
-{
-    if (entry.event) {
-        context->eventMessages++;
-        //if it is an event then we need to distribute the event for all
-        //publishers in the system.
-        ContextList::iterator lstItr1 = threadContexts.begin();
-        while (lstItr1 != threadContexts.end()) {
-            ThreadContext* ctx = (*lstItr1);
-            //main context will receive the original message
-            //for other the message entry is cloned.
-            MessageEntry newEntry(entry);
-            newEntry.destination = dynamic_cast<MessageHandler*> (ctx->eventPublisher);
-            ctx->input.push(newEntry);
-            lstItr1++;
-        }
-    } else {               // it is a regular/single message
-        context->receivedMessages++;
-        if (entry.processOnMainThread) {
-            mainContext->input.push(entry);
-        } else {
-            ThreadContext* destinationContext = static_cast<ThreadContext*> (entry.destination->GetContext());
-            if (destinationContext) {
-                destinationContext->input.push(entry);
-            }
-        }
-    }
-};
-
 void MessageBus::DispatchMessages() {
     CheckMainThread();
     ThreadContext* mainContext = GetThreadContext();
     if (mainContext) {
         currentTime++;
-        ContextList::iterator lstItr = threadContexts.begin();
-        while (lstItr != threadContexts.end()) {
+        shared_lock<shared_mutex> lock(contextsMutex);
+        const bool revalidate = handlersMoved.exchange(false, std::memory_order_relaxed);
+        boost::shared_ptr<MessageBuffer> events(new MessageBuffer());
+        MessageBuffer rerouted;
+        for (ContextList::iterator lstItr = threadContexts.begin(); lstItr != threadContexts.end(); lstItr++) {
             ThreadContext* context = (*lstItr);
-            while (!context->output.empty()) {
-                const MessageEntry& entry = context->output.top();
-                dispatch(entry, context, mainContext);
-                // internal messages go to the input queue of the main context.
-                context->output.pop();
+
+            //messages to handlers which left their context after being posted
+            //are routed again, with those to handlers which had no context.
+            if (revalidate) {
+                for (size_t idx = 0; idx < context->outboxes.size(); idx++) {
+                    MessageBuffer& outbox = context->outboxes[idx];
+                    MessageBuffer::iterator kept = outbox.begin();
+                    for (MessageBuffer::iterator it = outbox.begin(); it != outbox.end(); ++it) {
+                        if (it->processOnMainThread || it->destination->context == threadContexts[idx]) {
+                            if (kept != it) {
+                                *kept = std::move(*it);
+                            }
+                            ++kept;
+                        } else {
+                            rerouted.push_back(std::move(*it));
+                        }
+                    }
+                    outbox.erase(kept, outbox.end());
+                }
             }
+            rerouted.insert(rerouted.end(), context->unresolvedOutbox.begin(), context->unresolvedOutbox.end());
+            context->unresolvedOutbox.clear();
+            for (MessageBuffer::const_iterator it = rerouted.begin(); it != rerouted.end(); ++it) {
+                Route(*it, context);
+            }
+            rerouted.clear();
+
             while (!context->futureEventList.empty()) {
                 const MessageEntry& entry = context->futureEventList.top();
                 if (entry.triggerTime <= currentTime) {
-                    dispatch(entry, context, mainContext);
+                    Route(entry, context);
                     context->futureEventList.pop();
                 } else {
                     break;
                 }
             }
-            lstItr++;
+
+            //hand the outboxes over to the destinations.
+            for (size_t idx = 0; idx < context->outboxes.size(); idx++) {
+                MessageBuffer& outbox = context->outboxes[idx];
+                if (outbox.empty()) {
+                    continue;
+                }
+                context->receivedMessages += outbox.size();
+                ThreadContext* destination = threadContexts[idx];
+                if (destination->inboxes.size() <= context->index) {
+                    destination->inboxes.resize(context->index + 1);
+                }
+                MessageBuffer& inbox = destination->inboxes[context->index];
+                if (inbox.empty()) {
+                    inbox.swap(outbox);
+                } else {
+                    inbox.insert(inbox.end(), outbox.begin(), outbox.end());
+                    outbox.clear();
+                }
+            }
+
+            //events are delivered to the event publishers of all contexts.
+            context->eventMessages += context->eventOutbox.size();
+            events->insert(events->end(), context->eventOutbox.begin(), context->eventOutbox.end());
+            context->eventOutbox.clear();
+        }
+
+        if (!events->empty()) {
+            for (ContextList::iterator lstItr = threadContexts.begin(); lstItr != threadContexts.end(); lstItr++) {
+                (*lstItr)->eventInboxes.push_back(events);
+            }
         }
     }
 }
@@ -509,10 +629,31 @@ void MessageBus::ThreadDispatchMessages() {
     //gets main collector;
     ThreadContext* context = GetThreadContext();
     if (context) {
+        for (vector<MessageBuffer>::iterator it = context->inboxes.begin(); it != context->inboxes.end(); ++it) {
+            for (MessageBuffer::iterator entryIt = it->begin(); entryIt != it->end(); ++entryIt) {
+                context->input.push(std::move(*entryIt));
+            }
+            it->clear();
+        }
+        for (vector<boost::shared_ptr<const MessageBuffer> >::const_iterator it = context->eventInboxes.begin(); it != context->eventInboxes.end(); ++it) {
+            for (MessageBuffer::const_iterator entryIt = (*it)->begin(); entryIt != (*it)->end(); ++entryIt) {
+                MessageEntry entry(*entryIt);
+                entry.destination = context->eventHandler;
+                context->input.push(std::move(entry));
+            }
+        }
+        context->eventInboxes.clear();
+
         while (!context->input.empty()) {
             const MessageEntry& entry = context->input.top();
             if (entry.destination && entry.message.get()) {
                 ThreadContext* destinationContext = static_cast<ThreadContext*> (entry.destination->context);
+                if (!destinationContext) {
+                    //the handler was unregistered after the message was distributed.
+                    context->input.pop();
+                    context->processedMessages++;
+                    continue;
+                }
                 if (!entry.processOnMainThread && context->threadId != destinationContext->threadId) {
                     //The recepient of the message has moved to a different thread context
                     //This is possible in MT, but not in LT or ST
@@ -536,30 +677,16 @@ void MessageBus::PostMessage(MessageHandler* destination, Message::MessageType t
 {
     CheckThreadContext();
     ThreadContext* context = GetThreadContext();
-    if (context)
+    if (context && destination)
     {
-        InternalMessage* internalMsg = dynamic_cast<InternalMessage*>(message.get());
-        InternalEventMessage* eventMsg = dynamic_cast<InternalEventMessage*>(message.get());
-        if (destination || eventMsg)
-        {
-            MessageEntry entry;
-            entry.destination = destination;
-            entry.type = type;
-            entry.message = message;
-            entry.priority = (!internalMsg && !eventMsg && message->GetPriority() < MB_MIN_MSG_PRIORITY) ? MB_MIN_MSG_PRIORITY : message->priority;
-            entry.internal = (internalMsg != nullptr);
-            entry.event = (eventMsg != nullptr);
-            entry.processOnMainThread = processOnMainThread;
-            if (timeOffset == 0)
-            {
-                context->output.push(entry);
-            }
-            else
-            {
-                entry.triggerTime = currentTime + timeOffset;
-                context->futureEventList.push(entry);
-            }
-        }
+        MessageEntry entry;
+        entry.destination = destination;
+        entry.type = type;
+        entry.message = message;
+        entry.priority = (message->GetPriority() < MB_MIN_MSG_PRIORITY) ? MB_MIN_MSG_PRIORITY : message->priority;
+        entry.processOnMainThread = processOnMainThread;
+        entry.triggerTime = (timeOffset == 0) ? 0 : currentTime + timeOffset;
+        Post(entry, context);
     }
 }
 
@@ -586,7 +713,7 @@ void sim_mob::messaging::MessageBus::SendMessage(MessageHandler* destination,
     ThreadContext* context = GetThreadContext();
     if (context)
     {
-        if (destination && destination->context == context)
+        if (instantaneousDelivery && destination && destination->context == context)
         {
             SendInstantaneousMessage(destination, type, message);
         }
@@ -597,6 +724,11 @@ void sim_mob::messaging::MessageBus::SendMessage(MessageHandler* destination,
     }
 }
 
+void MessageBus::SetInstantaneousDelivery(bool enabled)
+{
+    instantaneousDelivery = enabled;
+}
+
 void MessageBus::SubscribeEvent(EventId id, EventListener* listener) {
     CheckThreadContext();
     if (listener) {
@@ -647,9 +779,13 @@ void MessageBus::UnSubscribeAll(event::EventId id, event::Context ctx){
     CheckThreadContext();
     ThreadContext* context = GetThreadContext();
     if (context) {
-        InternalEventMessage*  msg = new InternalEventMessage(id, ctx);
-        msg->priority = INTERNAL_EVENT_ACTION_PRIORITY;
-        PostMessage(nullptr, MSGI_UNSUBSCRIBE_ALL, MessagePtr(msg));
+        MessageEntry entry;
+        entry.type = MSGI_UNSUBSCRIBE_ALL;
+        entry.message.reset(new InternalEventMessage(id, ctx));
+        entry.message->priority = INTERNAL_EVENT_ACTION_PRIORITY;
+        entry.priority = INTERNAL_EVENT_ACTION_PRIORITY;
+        entry.event = true;
+        Post(entry, context);
     }
 }
 
@@ -661,7 +797,12 @@ void MessageBus::PublishEvent(event::EventId id, event::Context ctx, EventArgsPt
     CheckThreadContext();
     ThreadContext* context = GetThreadContext();
     if (context) {
-        PostMessage(nullptr, MSGI_PUBLISH_EVENT, MessagePtr(new InternalEventMessage(id, ctx, args)));
+        MessageEntry entry;
+        entry.type = MSGI_PUBLISH_EVENT;
+        entry.message.reset(new InternalEventMessage(id, ctx, args));
+        entry.priority = INTERNAL_EVENT_MSG_PRIORITY;
+        entry.event = true;
+        Post(entry, context);
     }
 }
 
@@ -713,6 +854,33 @@ namespace {
         return threadContext.get();
     }
 
+    void Route(const MessageEntry& entry, ThreadContext* context) {
+        if (entry.event) {
+            context->eventOutbox.push_back(entry);
+            return;
+        }
+        ThreadContext* destinationContext = entry.processOnMainThread ? mainThreadContext :
+                static_cast<ThreadContext*> (entry.destination->GetContext());
+        if (destinationContext) {
+            context->GetOutbox(destinationContext).push_back(entry);
+        }
+    }
+
+    void Post(const MessageEntry& entry, ThreadContext* context) {
+        if (entry.triggerTime == 0) {
+            ThreadContext* destinationContext = (entry.event || entry.processOnMainThread) ? nullptr :
+                    static_cast<ThreadContext*> (entry.destination->GetContext());
+            if (destinationContext || entry.event || entry.processOnMainThread) {
+                Route(entry, context);
+            } else {
+                //the handler may be registered before the messages are distributed.
+                context->unresolvedOutbox.push_back(entry);
+            }
+        } else {
+            context->futureEventList.push(entry);
+        }
+    }
+
     void deleteAllContexts() {
         ContextList::iterator itr = threadContexts.begin();
         while (itr != threadContexts.end()) {
@@ -736,7 +904,7 @@ namespace {
         while (itr != threadContexts.end()) {
             ThreadContext* ctx = (*itr);
             if (ctx) {
-                long long int remaining = (ctx->input.size() + ctx->output.size());
+                long long int remaining = ctx->GetPendingMessages();
                 boost::format fmtr = boost::format(REPORT_LINE);
                 fmtr % ctx->threadId %
                         ctx->receivedMessages %
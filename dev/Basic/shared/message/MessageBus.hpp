@@ -94,6 +94,18 @@ namespace sim_mob {
              */
             static void ReRegisterHandler(MessageHandler* handler, void* newContext);
 
+            /**
+             * Makes the handlers registered (or unregistered) by the current thread
+             * use the given context instead of the context of the thread.
+             * note: this is used by Workers updating an entity whose messages are
+             *       handled by another thread, so that the handlers created during
+             *       the update stay with the entity.
+             * @param registrationContext context obtained from a registered handler;
+             *        nullptr to use the context of the current thread again.
+             * @throws runtime_exception if the current thread context is not registered
+             */
+            static void SetRegistrationContext(void* registrationContext);
+
             /**
              * MessageBus distributes all messages for all registered threads.
              * Collects all messages from output queues of all thread contexts and
@@ -163,6 +175,21 @@ namespace sim_mob {
              */
             static void SendMessage(MessageHandler* target, Message::MessageType type, MessagePtr message, bool processOnMainThread = false);
 
+            /**
+             * Enables or disables the instantaneous delivery of SendMessage().
+             * When disabled, SendMessage() always invokes PostMessage().
+             *
+             * This must be disabled when the handlers of a thread context may be
+             * updated by other threads (e.g., by Workers stealing entity updates),
+             * since an instantaneous message would then be handled while its
+             * receiver is being updated elsewhere.
+             *
+             * \note call this before the worker threads start.
+             *
+             * @param enabled true (the default) to deliver instantaneously within a context.
+             */
+            static void SetInstantaneousDelivery(bool enabled);
+
             /**
              * Subscribes to the given event. 
              * This listener will receive *all* notifications for this event.
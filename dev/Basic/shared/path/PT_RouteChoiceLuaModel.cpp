@@ -167,7 +167,7 @@ std::vector<sim_mob::OD_Trip> PT_RouteChoiceLuaModel::makePT_RouteChoice(const s
     std::vector<sim_mob::OD_Trip> odTrips;
     unsigned int sizeOfChoiceSet = getSizeOfChoiceSet();
     std::string pathSetId = "N_" + origin + "_" + "N_" + destination;
-    LuaRef funcRef = getGlobal(state.get(), "choose_PT_path");
+    const LuaRef& funcRef = getFunction("choose_PT_path");
     LuaRef retVal = funcRef(this, sizeOfChoiceSet);
     int index = -1;
     if (retVal.isNumber()) {
@@ -194,6 +194,22 @@ void sim_mob::ParsePathXmlConfig::processPrivatePathsetNode(xercesc::DOMElement*
         cfg.reroute = ParseBoolean(GetNamedAttributeValue(reroute, "enabled"), false);
     }
 
+    //bidirectional shortest path search (optional)
+    xercesc::DOMElement* bidirectional = GetSingleElementByName(pvtConfNode, "bidirectional_search");
+
+    if (bidirectional)
+    {
+        cfg.bidirectionalSearch = ParseBoolean(GetNamedAttributeValue(bidirectional, "enabled"), false);
+    }
+
+    //contraction hierarchy for the shortest path queries (optional)
+    xercesc::DOMElement* hierarchy = GetSingleElementByName(pvtConfNode, "contraction_hierarchy");
+
+    if (hierarchy)
+    {
+        cfg.contractionHierarchy = ParseBoolean(GetNamedAttributeValue(hierarchy, "enabled"), false);
+    }
+
     //path generators configuration
     xercesc::DOMElement* gen = GetSingleElementByName(pvtConfNode, "path_generators");
 
@@ -54,6 +54,28 @@ using namespace sim_mob;
 
 namespace
 {
+/** maximum total size (bytes) of the pathsets cached by a route choice model instance */
+const size_t PATHSET_CACHE_CAPACITY_BYTES = 64 * 1024 * 1024;
+
+/** number of independently locked shards of the pathset cache */
+const size_t PATHSET_CACHE_SHARDS = 16;
+
+/**
+ * estimates the memory held by a pathset, for weighing pathsets in the cache
+ * @param ps the pathset
+ * @return approximate size of ps in bytes
+ */
+size_t estimatePathSetSize(const boost::shared_ptr<sim_mob::PathSet>& ps)
+{
+    size_t size = sizeof(sim_mob::PathSet) + ps->id.capacity() + ps->scenario.capacity();
+    for (const sim_mob::SinglePath* sp : ps->pathChoices)
+    {
+        size += sizeof(sim_mob::SinglePath) + sp->id.capacity() + sp->pathSetId.capacity() + sp->scenario.capacity()
+                + (sp->path.capacity() * sizeof(sim_mob::WayPoint));
+    }
+    return size;
+}
+
 struct ModelContext
 {
     ModelContext()
@@ -328,6 +350,8 @@ std::string getFromToString(unsigned int fromNode, unsigned int toNode)
 PrivatePathsetGenerator* sim_mob::PrivatePathsetGenerator::pvtPathGeneratorInstance = nullptr;
 
 boost::shared_ptr<sim_mob::batched::ThreadPool> sim_mob::PrivatePathsetGenerator::threadpool_;
+boost::shared_ptr<sim_mob::batched::ThreadPool> sim_mob::PrivateTrafficRouteChoice::matrixThreadPool;
+boost::mutex sim_mob::PrivateTrafficRouteChoice::matrixThreadPoolMutex;
 
 unsigned int sim_mob::PathSetManager::curIntervalMS = 0;
 unsigned int sim_mob::PathSetManager::intervalMS = 0;
@@ -377,6 +401,11 @@ bool sim_mob::PrivateTrafficRouteChoice::findCachedPathSet(std::string key, boos
     return cacheLRU.find(key, value);
 }
 
+sim_mob::CacheStatistics sim_mob::PrivateTrafficRouteChoice::getPathSetCacheStatistics()
+{
+    return cacheLRU.getStatistics();
+}
+
 void sim_mob::PrivatePathsetGenerator::setPathSetTags(boost::shared_ptr<sim_mob::PathSet>& ps) const
 {
     double minDistance = std::numeric_limits<double>::max();
@@ -748,6 +777,12 @@ double sim_mob::PrivateTrafficRouteChoice::getOD_TravelTime_StudyArea(unsigned i
 
 
 double sim_mob::PrivateTrafficRouteChoice::getShortestPathTravelTime(const Node* origin, const Node* destination, const sim_mob::DailyTime& curTime)
+{
+    return getShortestPathTravelTime(origin, destination, curTime, nullptr);
+}
+
+double sim_mob::PrivateTrafficRouteChoice::getShortestPathTravelTime(const Node* origin, const Node* destination, const sim_mob::DailyTime& curTime,
+        const std::vector<WayPoint>* searchedPath)
 {
     double shortestPathTravelTime = 0.0;
     if (origin->getNodeId() == destination->getNodeId()) { return 0.0; }
@@ -755,6 +790,7 @@ double sim_mob::PrivateTrafficRouteChoice::getShortestPathTravelTime(const Node*
     if (noPathODs.find(fromToID)) { return 0.0; }
 
     sim_mob::SinglePath* shortestPath = nullptr;
+    sim_mob::SinglePath drivingPath;
     boost::shared_ptr<sim_mob::PathSet> pathset;
     bool pathsetFound = findCachedPathSet(fromToID, pathset);
     if(pathsetFound)
@@ -763,18 +799,21 @@ double sim_mob::PrivateTrafficRouteChoice::getShortestPathTravelTime(const Node*
     }
     else
     {
-        std::vector<WayPoint> wayPointSequence = StreetDirectory::Instance().SearchShortestDrivingPath<Node,Node>(*origin,*destination);
-        std::vector<WayPoint> wayPointSequenceCleaned;
-        for (WayPoint wp:wayPointSequence)
+        std::vector<WayPoint> wayPointSequence;
+        if (!searchedPath)
+        {
+            wayPointSequence = StreetDirectory::Instance().SearchShortestDrivingPath<Node,Node>(*origin,*destination);
+            searchedPath = &wayPointSequence;
+        }
+        for (WayPoint wp:*searchedPath)
         {
             if (wp.type == WayPoint::LINK)
-                wayPointSequenceCleaned.push_back(wp);
+                drivingPath.path.push_back(wp);
         }
 
-        if ( !wayPointSequenceCleaned.empty() )
+        if ( !drivingPath.path.empty() )
         {
-            shortestPath = new SinglePath();
-            shortestPath->path =wayPointSequenceCleaned;
+            shortestPath = &drivingPath;
         }
     }
 
@@ -790,6 +829,58 @@ double sim_mob::PrivateTrafficRouteChoice::getShortestPathTravelTime(const Node*
     return shortestPathTravelTime;
 }
 
+namespace
+{
+/**
+ * searches the distance-based shortest paths from one origin to all destinations of a travel time matrix
+ */
+void searchMatrixPaths(const sim_mob::Node* origin, const std::vector<const sim_mob::Node*>& destinations,
+                       std::vector<std::vector<sim_mob::WayPoint> >& paths)
+{
+    paths = sim_mob::StreetDirectory::Instance().SearchShortestDrivingPaths(*origin, destinations);
+}
+}
+
+std::vector<std::vector<double> > sim_mob::PrivateTrafficRouteChoice::getShortestPathTravelTimes(const std::vector<const Node*>& origins,
+        const std::vector<const Node*>& destinations, const sim_mob::DailyTime& curTime)
+{
+    std::vector<std::vector<std::vector<WayPoint> > > paths(origins.size());
+    const unsigned int poolSize = sim_mob::ConfigManager::GetInstance().FullConfig().getPathSetConf().threadPoolSize;
+    if (poolSize > 1 && origins.size() > 1)
+    {
+        {
+            boost::unique_lock<boost::mutex> lock(matrixThreadPoolMutex);
+            if (!matrixThreadPool)
+            {
+                matrixThreadPool.reset(new sim_mob::batched::ThreadPool(poolSize));
+            }
+        }
+        for (size_t i = 0; i < origins.size(); ++i)
+        {
+            matrixThreadPool->enqueue(boost::bind(searchMatrixPaths, origins[i], boost::cref(destinations), boost::ref(paths[i])));
+        }
+        matrixThreadPool->wait();
+    }
+    else
+    {
+        for (size_t i = 0; i < origins.size(); ++i)
+        {
+            searchMatrixPaths(origins[i], destinations, paths[i]);
+        }
+    }
+
+    //the travel times use the caches of this (thread specific) instance, so they are evaluated here
+    std::vector<std::vector<double> > travelTimes(origins.size(), std::vector<double>(destinations.size()));
+    for (size_t i = 0; i < origins.size(); ++i)
+    {
+        for (size_t j = 0; j < destinations.size(); ++j)
+        {
+            travelTimes[i][j] = getShortestPathTravelTime(origins[i], destinations[j], curTime, &paths[i][j]);
+        }
+    }
+    return travelTimes;
+}
+
 //Operations:
 //step-0: Initial preparations
 //step-1: Check the cache
@@ -1971,7 +2062,7 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPathChoiceFromPathSet(boost::sha
     if (sizeOfChoiceSet > 0)
     {
         // Call to the Lua function
-        LuaRef funcRef = getGlobal(state.get(), "choose_PVT_path");
+        const LuaRef& funcRef = getFunction("choose_PVT_path");
         LuaRef retVal = funcRef(this, sizeOfChoiceSet);
         int index = -1;
         if (retVal.isNumber())
@@ -2120,7 +2211,7 @@ sim_mob::PrivateTrafficRouteChoice::PrivateTrafficRouteChoice()
         : PathSetManager(),
           psRetrieval(sim_mob::ConfigManager::GetInstance().FullConfig().getDatabaseProcMappings().procedureMappings.find("pvt_pathset")->second),
           psRetrievalWithoutRestrictedRegion(sim_mob::ConfigManager::GetInstance().FullConfig().getPathSetConf().psRetrievalWithoutBannedRegion),
-          cacheLRU(2500), ttMgr(*(sim_mob::TravelTimeManager::getInstance())), regionRestrictonEnabled(false)
+          cacheLRU(PATHSET_CACHE_CAPACITY_BYTES, PATHSET_CACHE_SHARDS, &estimatePathSetSize), ttMgr(*(sim_mob::TravelTimeManager::getInstance())), regionRestrictonEnabled(false)
 {
 }
 
@@ -315,7 +315,7 @@ public:
 class PrivateTrafficRouteChoice : public sim_mob::PathSetManager , public lua::LuaModel
 {
 private:
-    /** the pathset cache */
+    /** the pathset cache, bounded by the estimated memory of the cached pathsets */
     sim_mob::LRU_Cache<std::string, boost::shared_ptr<PathSet> > cacheLRU;
 
     /**
@@ -341,6 +341,24 @@ private:
 
     std::vector<sim_mob::SinglePath*> pvtpathset;
 
+    /** threads searching the shortest paths of travel time matrices, one origin per task */
+    static boost::shared_ptr<sim_mob::batched::ThreadPool> matrixThreadPool;
+
+    /** protects the creation of matrixThreadPool */
+    static boost::mutex matrixThreadPoolMutex;
+
+    /**
+     * calculates the travel time of the shortest path between two nodes: the shortest path of the cached pathset if any,
+     * otherwise the distance-based shortest path
+     * @param origin origin node
+     * @param destination destination node
+     * @param curTime time at which the path starts
+     * @param searchedPath the distance-based shortest path from origin to destination, if already searched; searched if null
+     * @return travel time in seconds; -1 if there is no path
+     */
+    double getShortestPathTravelTime(const Node* origin, const Node* destination, const sim_mob::DailyTime& curTime,
+                                     const std::vector<WayPoint>* searchedPath);
+
     /**
      * cache the generated pathset
      * @param ps pathset general information
@@ -443,6 +461,12 @@ public:
     bool isRegionRestrictonEnabled() const;
     void setRegionRestrictonEnabled(bool regionRestrictonEnabled);
 
+    /**
+     * gets the hit, miss and eviction counters and the size of the pathset cache
+     * @return statistics of the pathset cache
+     */
+    sim_mob::CacheStatistics getPathSetCacheStatistics();
+
     /**
      * gets the average travel time for link experienced during the current simulation.
      * Whether the desired travel time is coming from the last time interval
@@ -545,6 +569,19 @@ public:
     //for OD Travel Time Estimation for Study Area for On Call Controller
     double getOD_TravelTime_StudyArea(unsigned int origin, unsigned int destination, const sim_mob::DailyTime& curTime);
     double getShortestPathTravelTime(const Node* origin, const Node* destination, const sim_mob::DailyTime& curTime);
+
+    /**
+     * calculates the travel times of the shortest paths from several origins to several destinations, as
+     * getShortestPathTravelTime would for each pair. The shortest paths of an origin to all destinations are found
+     * by a single search; the searches of the origins run in parallel.
+     * @param origins origin nodes
+     * @param destinations destination nodes
+     * @param curTime time at which the paths start
+     *
+     * @return matrix whose element [i][j] is the travel time from origins[i] to destinations[j]; -1 if there is no path. In seconds
+     */
+    std::vector<std::vector<double> > getShortestPathTravelTimes(const std::vector<const Node*>& origins,
+            const std::vector<const Node*>& destinations, const sim_mob::DailyTime& curTime);
 };
 
 }//namespace
@@ -8,6 +8,7 @@
 
 #include "PathSetThreadPool.hpp"
 #include "Path.hpp"
+#include "geospatial/streetdir/A_StarSearchWorkspace.hpp"
 #include "geospatial/streetdir/A_StarShortestTravelTimePathImpl.hpp"
 #include "geospatial/streetdir/A_StarShortestPathImpl.hpp"
 #include "logging/Log.hpp"
@@ -16,8 +17,6 @@
 #include <semaphore.h>
 #include <cstdlib>
 #include <boost/graph/filtered_graph.hpp>
-#include <boost/graph/astar_search.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <iterator>
 #include <algorithm>
 #include <vector>
@@ -56,223 +55,46 @@ void sim_mob::PathSetWorkerThread::run()
         }
     }
 
-    //used for error checking and validation
-    std::pair<StreetDirectory::Edge, bool> dbgPrevEdge;
     //output container
     vector<WayPoint> wps;
+    vector<StreetDirectory::Edge> edges;
+    sim_mob::A_StarSearchWorkspace& workspace = sim_mob::A_StarSearchWorkspace::getThreadWorkspace();
 
     if (blacklistEdges.empty())
     {
         if(timeBased)
         {
-            std::list<StreetDirectory::Vertex> partialRes;
-            //Use A* to search for a path
-            //Taken from: http://www.boost.org/doc/libs/1_38_0/libs/graph/example/astar-cities.cpp
-            vector<StreetDirectory::Vertex> p(boost::num_vertices(*graph)); //Output variable
-            vector<double> d(boost::num_vertices(*graph)); //Output variable
-            try
+            if (workspace.search(*graph, fromVertex, toVertex, sim_mob::A_StarShortestTravelTimePathImpl::DistanceHeuristicGraph(graph, toVertex), edges))
             {
-                boost::astar_search(*graph, fromVertex, sim_mob::A_StarShortestTravelTimePathImpl::DistanceHeuristicGraph(graph, toVertex),
-                                    boost::predecessor_map(&p[0]).distance_map(&d[0]).visitor(sim_mob::A_StarShortestTravelTimePathImpl::GoalVisitor(toVertex)));
-            }
-            catch (sim_mob::A_StarShortestTravelTimePathImpl::Goal& goal)
-            {
-                //Build backwards.
-                for (StreetDirectory::Vertex v = toVertex;; v = p[v])
-                {
-                    partialRes.push_front(v);
-                    if (p[v] == v)
-                    {
-                        break;
-                    }
-                }
-                //Now build forwards.
-                std::list<StreetDirectory::Vertex>::const_iterator prev = partialRes.end();
-                for (std::list<StreetDirectory::Vertex>::const_iterator it = partialRes.begin(); it != partialRes.end(); it++)
-                {
-                    //Add this edge.
-                    if (prev != partialRes.end())
-                    {
-                        //This shouldn't fail.
-                        std::pair < StreetDirectory::Edge, bool> edge = boost::edge(*prev, *it, *graph);
-                        if (!edge.second)
-                        {
-                            Warn() << "ERROR: Boost can't find an edge that it should know about." << std::endl;
-                        }
-                        //Retrieve, add this edge's WayPoint.
-                        WayPoint wp = boost::get(boost::edge_name, *graph, edge.first);
-                        wps.push_back(wp);
-                    }
-                    //Save for later.
-                    prev = it;
-                }
+                wps = sim_mob::A_StarSearchWorkspace::toWayPoints(*graph, edges);
             }
         }
         else
         {
-            std::list<StreetDirectory::Vertex> partialRes;
-            //Use A* to search for a path
-            //Taken from: http://www.boost.org/doc/libs/1_38_0/libs/graph/example/astar-cities.cpp
-            vector<StreetDirectory::Vertex> p(boost::num_vertices(*graph)); //Output variable
-            vector<double> d(boost::num_vertices(*graph)); //Output variable
-            try
-            {
-                boost::astar_search(*graph, fromVertex, sim_mob::A_StarShortestPathImpl::DistanceHeuristicGraph(graph, toVertex),
-                                    boost::predecessor_map(&p[0]).distance_map(&d[0]).visitor(sim_mob::A_StarShortestPathImpl::GoalVisitor(toVertex)));
-            }
-            catch (sim_mob::A_StarShortestPathImpl::Goal& goal)
+            if (workspace.search(*graph, fromVertex, toVertex, sim_mob::A_StarShortestPathImpl::DistanceHeuristicGraph(graph, toVertex), edges))
             {
-                //Build backwards.
-                for (StreetDirectory::Vertex v = toVertex;; v = p[v])
-                {
-                    partialRes.push_front(v);
-                    if (p[v] == v)
-                    {
-                        break;
-                    }
-                }
-                //Now build forwards.
-                std::list<StreetDirectory::Vertex>::const_iterator prev = partialRes.end();
-                for (std::list<StreetDirectory::Vertex>::const_iterator it = partialRes.begin(); it != partialRes.end(); it++)
-                {
-                    //Add this edge.
-                    if (prev != partialRes.end())
-                    {
-                        //This shouldn't fail.
-                        std::pair < StreetDirectory::Edge, bool> edge = boost::edge(*prev, *it, *graph);
-                        if (!edge.second)
-                        {
-                            Warn() << "ERROR: Boost can't find an edge that it should know about." << std::endl;
-                        }
-                        //Retrieve, add this edge's WayPoint.
-                        WayPoint wp = boost::get(boost::edge_name, *graph, edge.first);
-                        wps.push_back(wp);
-                    }
-                    //Save for later.
-                    prev = it;
-                }
+                wps = sim_mob::A_StarSearchWorkspace::toWayPoints(*graph, edges);
             }
         }
     }
     else
     {
+        //Filter it.
+        sim_mob::A_StarShortestPathImpl::BlackListEdgeConstraint filter(blacklistEdges);
+        boost::filtered_graph<StreetDirectory::Graph, sim_mob::A_StarShortestPathImpl::BlackListEdgeConstraint> filtered(*graph, filter);
+
         if (timeBased)
         {
-            //logger << "Blacklist NOT empty" << blacklistV.size() << std::endl;
-            //Filter it.
-
-            sim_mob::A_StarShortestTravelTimePathImpl::BlackListEdgeConstraint filter(blacklistEdges);
-            boost::filtered_graph<StreetDirectory::Graph, sim_mob::A_StarShortestTravelTimePathImpl::BlackListEdgeConstraint> filtered(*graph, filter);
-            ////////////////////////////////////////
-            // TODO: This code is copied (since filtered_graph is not the same as adjacency_list) from searchShortestPath.
-            ////////////////////////////////////////
-            std::list<StreetDirectory::Vertex> partialRes;
-
-            vector<StreetDirectory::Vertex> p(boost::num_vertices(filtered)); //Output variable
-            vector<double> d(boost::num_vertices(filtered)); //Output variable
-
-            //Use A* to search for a path
-            //Taken from: http://www.boost.org/doc/libs/1_38_0/libs/graph/example/astar-cities.cpp
-            //...which is available under the terms of the Boost Software License, 1.0
-            try
+            if (workspace.search(filtered, fromVertex, toVertex, sim_mob::A_StarShortestTravelTimePathImpl::DistanceHeuristicFiltered(&filtered, toVertex), edges))
             {
-                if(!p.empty() && !d.empty())
-                {
-                    boost::astar_search(filtered, fromVertex, sim_mob::A_StarShortestTravelTimePathImpl::DistanceHeuristicFiltered(&filtered, toVertex),
-                                        boost::predecessor_map(&p[0]).distance_map(&d[0]).visitor(sim_mob::A_StarShortestTravelTimePathImpl::GoalVisitor(toVertex)));
-                }
+                wps = sim_mob::A_StarSearchWorkspace::toWayPoints(filtered, edges);
             }
-            catch (sim_mob::A_StarShortestTravelTimePathImpl::Goal& goal)
-            {
-                //Build backwards.
-                for (StreetDirectory::Vertex v = toVertex;; v = p[v])
-                {
-                    partialRes.push_front(v);
-                    if (p[v] == v)
-                    {
-                        break;
-                    }
-                }
-                //Now build forwards.
-                std::list<StreetDirectory::Vertex>::const_iterator prev = partialRes.end();
-                for (std::list<StreetDirectory::Vertex>::const_iterator it = partialRes.begin(); it != partialRes.end(); it++)
-                {
-                    //Add this edge.
-                    if (prev != partialRes.end())
-                    {
-                        //This shouldn't fail.
-                        std::pair < StreetDirectory::Edge, bool> edge = boost::edge(*prev, *it, filtered);
-                        if (!edge.second)
-                        {
-                            std::cerr << "ERROR: Boost can't find an edge that it should know about." << std::endl;
-                        }
-                        //Retrieve, add this edge's WayPoint.
-                        WayPoint wp = boost::get(boost::edge_name, filtered, edge.first);
-                        wps.push_back(wp);
-                    }
-
-                    //Save for later.
-                    prev = it;
-                }
-            } //catch
         }
         else
         {
-            //logger << "Blacklist NOT empty" << blacklistV.size() << std::endl;
-            //Filter it.
-            sim_mob::A_StarShortestPathImpl::BlackListEdgeConstraint filter(blacklistEdges);
-            boost::filtered_graph<StreetDirectory::Graph, sim_mob::A_StarShortestPathImpl::BlackListEdgeConstraint> filtered(*graph, filter);
-            ////////////////////////////////////////
-            // TODO: This code is copied (since filtered_graph is not the same as adjacency_list) from searchShortestPath.
-            ////////////////////////////////////////
-            std::list<StreetDirectory::Vertex> partialRes;
-
-            vector<StreetDirectory::Vertex> p(boost::num_vertices(filtered)); //Output variable
-            vector<double> d(boost::num_vertices(filtered)); //Output variable
-
-            //Use A* to search for a path
-            //Taken from: http://www.boost.org/doc/libs/1_38_0/libs/graph/example/astar-cities.cpp
-            //...which is available under the terms of the Boost Software License, 1.0
-            try
+            if (workspace.search(filtered, fromVertex, toVertex, sim_mob::A_StarShortestPathImpl::DistanceHeuristicFiltered(&filtered, toVertex), edges))
             {
-                if(!p.empty() && !d.empty())
-                {
-                    boost::astar_search(filtered, fromVertex, sim_mob::A_StarShortestPathImpl::DistanceHeuristicFiltered(&filtered, toVertex),
-                                        boost::predecessor_map(&p[0]).distance_map(&d[0]).visitor(sim_mob::A_StarShortestPathImpl::GoalVisitor(toVertex)));
-                }
-            }
-            catch (sim_mob::A_StarShortestPathImpl::Goal& goal)
-            {
-                //Build backwards.
-                for (StreetDirectory::Vertex v = toVertex;; v = p[v])
-                {
-                    partialRes.push_front(v);
-                    if (p[v] == v)
-                    {
-                        break;
-                    }
-                }
-                //Now build forwards.
-                std::list<StreetDirectory::Vertex>::const_iterator prev = partialRes.end();
-                for (std::list<StreetDirectory::Vertex>::const_iterator it = partialRes.begin(); it != partialRes.end(); it++)
-                {
-                    //Add this edge.
-                    if (prev != partialRes.end())
-                    {
-                        //This shouldn't fail.
-                        std::pair < StreetDirectory::Edge, bool> edge = boost::edge(*prev, *it, filtered);
-                        if (!edge.second)
-                        {
-                            std::cerr << "ERROR: Boost can't find an edge that it should know about." << std::endl;
-                        }
-                        //Retrieve, add this edge's WayPoint.
-                        WayPoint wp = boost::get(boost::edge_name, filtered, edge.first);
-                        wps.push_back(wp);
-                    }
-
-                    //Save for later.
-                    prev = it;
-                }
+                wps = sim_mob::A_StarSearchWorkspace::toWayPoints(filtered, edges);
             }
         }
     }
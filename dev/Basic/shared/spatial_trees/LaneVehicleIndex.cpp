@@ -0,0 +1,110 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "LaneVehicleIndex.hpp"
+
+#include <limits>
+#include "geospatial/network/Lane.hpp"
+#include "geospatial/network/Point.hpp"
+#include "geospatial/network/RoadNetwork.hpp"
+#include "logging/Log.hpp"
+
+using namespace sim_mob;
+
+boost::scoped_ptr<LaneVehicleIndex> LaneVehicleIndex::instance;
+
+LaneVehicleIndex::LaneVehicles::LaneVehicles()
+{
+    //No tick has been stored yet, frame 0 included
+    frames[0] = frames[1] = std::numeric_limits<uint32_t>::max();
+}
+
+LaneVehicleIndex::LaneVehicleIndex(const std::map<unsigned int, Lane *> &mapOfLanes, LookupMode mode) :
+        mode(mode), lanes(mapOfLanes.size()), numValidated(0), numDifferent(0)
+{
+    for (std::map<unsigned int, Lane *>::const_iterator it = mapOfLanes.begin(); it != mapOfLanes.end(); ++it)
+    {
+        laneIndices.insert(std::make_pair(it->second, laneIndices.size()));
+    }
+}
+
+void LaneVehicleIndex::createInstance(const RoadNetwork &network, LookupMode mode)
+{
+    instance.reset(new LaneVehicleIndex(network.getMapOfIdVsLanes(), mode));
+}
+
+LaneVehicleIndex* LaneVehicleIndex::getInstance()
+{
+    return instance.get();
+}
+
+LaneVehicleIndex::LookupMode LaneVehicleIndex::getMode() const
+{
+    return mode;
+}
+
+void LaneVehicleIndex::add(const Lane *lane, const Agent *agent, int x, int y, uint32_t frame)
+{
+    boost::unordered_map<const Lane *, size_t>::const_iterator itLane = laneIndices.find(lane);
+    if (itLane == laneIndices.end())
+    {
+        return;
+    }
+
+    LaneVehicles &laneVehicles = lanes[itLane->second];
+    const uint32_t nextFrame = frame + 1;
+    const Vehicle vehicle = { agent, x, y };
+
+    boost::mutex::scoped_lock lock(laneVehicles.mutex);
+
+    //The list of the next tick still holds the vehicles of the previous tick, unless a vehicle has already been added
+    std::vector<Vehicle> &vehicles = laneVehicles.vehicles[nextFrame % 2];
+    if (laneVehicles.frames[nextFrame % 2] != nextFrame)
+    {
+        vehicles.clear();
+        laneVehicles.frames[nextFrame % 2] = nextFrame;
+    }
+    vehicles.push_back(vehicle);
+}
+
+void LaneVehicleIndex::findInRect(const Lane *lane, uint32_t frame, const Point &lowerLeft, const Point &upperRight,
+                                  std::vector<const Agent *> &result) const
+{
+    boost::unordered_map<const Lane *, size_t>::const_iterator itLane = laneIndices.find(lane);
+    if (itLane == laneIndices.end())
+    {
+        return;
+    }
+
+    //The list of the current tick is complete and is no longer modified, so it is read without locking
+    const LaneVehicles &laneVehicles = lanes[itLane->second];
+    if (laneVehicles.frames[frame % 2] != frame)
+    {
+        return;
+    }
+
+    const std::vector<Vehicle> &vehicles = laneVehicles.vehicles[frame % 2];
+    for (std::vector<Vehicle>::const_iterator it = vehicles.begin(); it != vehicles.end(); ++it)
+    {
+        if (it->x >= lowerLeft.getX() && it->x <= upperRight.getX() && it->y >= lowerLeft.getY() && it->y <= upperRight.getY())
+        {
+            result.push_back(it->agent);
+        }
+    }
+}
+
+void LaneVehicleIndex::countValidation(bool identical)
+{
+    boost::mutex::scoped_lock lock(validationMutex);
+    ++numValidated;
+    if (!identical)
+    {
+        ++numDifferent;
+    }
+    if (numValidated % 1000 == 0)
+    {
+        Print() << "LaneVehicleIndex: " << numDifferent << " of " << numValidated
+                << " drivers had different nearby drivers with the aura manager" << std::endl;
+    }
+}
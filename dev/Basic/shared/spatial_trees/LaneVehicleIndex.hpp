@@ -0,0 +1,134 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <map>
+#include <stdint.h>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+namespace sim_mob
+{
+
+class Agent;
+class Lane;
+class Point;
+class RoadNetwork;
+
+/**
+ * Lists, for every lane of the network, the drivers on it.
+ *
+ * Every driver adds itself to the list of its lane at the end of its frame tick, with the lane and position it has
+ * just published, so that in the next tick the drivers in the middle of a link find the drivers around them on the
+ * lanes of their link instead of querying the aura manager. The lists of consecutive ticks are kept apart, as the
+ * lists of the current tick are read while those of the next tick are filled by the same worker threads.
+ *
+ * The index is created before the simulation starts if the generic property "nearby_driver_lookup" is "lanes"
+ * or "validate"; in the latter mode the nearby drivers are also found with the aura manager and the results are
+ * compared (see DriverMovement::updateNearbyAgents).
+ */
+class LaneVehicleIndex : private boost::noncopyable
+{
+public:
+    enum LookupMode
+    {
+        /**The drivers in the middle of a link find their nearby drivers in the index*/
+        LOOKUP_LANES,
+
+        /**As LOOKUP_LANES, and the nearby drivers are also found with the aura manager, whose results are kept*/
+        LOOKUP_VALIDATE
+    };
+
+    /**
+     * Creates an index with an empty list for each of the given lanes; the lanes are used as keys only
+     *
+     * @param lanes the lanes, by id
+     * @param mode the way the index is used
+     */
+    LaneVehicleIndex(const std::map<unsigned int, Lane *> &lanes, LookupMode mode);
+
+    /**
+     * Creates the index, with an empty list for each lane of the network
+     *
+     * @param network the road network
+     * @param mode the way the index is used
+     */
+    static void createInstance(const RoadNetwork &network, LookupMode mode);
+
+    /**
+     * @return the index, or nullptr if the nearby drivers are only found with the aura manager
+     */
+    static LaneVehicleIndex* getInstance();
+
+    LookupMode getMode() const;
+
+    /**
+     * Adds an agent to the list of the given lane for the tick following the given one. Thread safe.
+     *
+     * @param lane the lane the agent is on
+     * @param agent the agent driving
+     * @param x the position of the agent published for the next tick
+     * @param y the position of the agent published for the next tick
+     * @param frame the current tick
+     */
+    void add(const Lane *lane, const Agent *agent, int x, int y, uint32_t frame);
+
+    /**
+     * Finds the agents which were on the given lane at the start of the given tick, and whose position is in
+     * the given rectangle (bounds included, as for the aura manager)
+     *
+     * @param lane the lane
+     * @param frame the current tick
+     * @param lowerLeft the lower left corner of the rectangle
+     * @param upperRight the upper right corner of the rectangle
+     * @param result the agents found are added to it
+     */
+    void findInRect(const Lane *lane, uint32_t frame, const Point &lowerLeft, const Point &upperRight, std::vector<const Agent *> &result) const;
+
+    /**
+     * Counts a driver whose nearby drivers were found with both the index and the aura manager, and reports the
+     * number of differences found so far every 1000 of them
+     *
+     * @param identical whether the results were the same
+     */
+    void countValidation(bool identical);
+
+private:
+    struct Vehicle
+    {
+        const Agent *agent;
+        int x;
+        int y;
+    };
+
+    /**The vehicles on a lane, for the current and next tick (indexed by the parity of the tick)*/
+    struct LaneVehicles
+    {
+        LaneVehicles();
+
+        boost::mutex mutex;
+        std::vector<Vehicle> vehicles[2];
+        uint32_t frames[2];
+    };
+
+    static boost::scoped_ptr<LaneVehicleIndex> instance;
+
+    LookupMode mode;
+
+    /**The lists of all lanes; created once, so that the lanes can be looked up without locking*/
+    std::vector<LaneVehicles> lanes;
+
+    /**Position of each lane in lanes*/
+    boost::unordered_map<const Lane *, size_t> laneIndices;
+
+    boost::mutex validationMutex;
+    unsigned long numValidated;
+    unsigned long numDifferent;
+};
+
+}
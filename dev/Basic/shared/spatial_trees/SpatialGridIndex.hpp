@@ -0,0 +1,403 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/function.hpp>
+
+namespace sim_mob
+{
+
+/**
+ * Uniform grid over a set of moving objects, e.g. the idle vehicles of a fleet.
+ *
+ * Unlike GeneralR_TreeManager, which is bulk loaded once, objects can be inserted, moved and removed one at a time in
+ * constant time; this suits sets whose members change at every tick. Nearest neighbour, k-nearest and radius queries
+ * visit the cells in rings of increasing size around the query point and stop as soon as no unvisited cell can hold
+ * a closer object, so their cost depends on the local density rather than on the number of objects.
+ *
+ * Coordinates are in meters. The cell size should be in the order of the typical distance between neighbouring objects.
+ */
+template<typename T>
+class SpatialGridIndex
+{
+public:
+    /**Restricts a query to the objects for which it returns true*/
+    typedef boost::function<bool (const T*)> Filter;
+
+    explicit SpatialGridIndex(double cellSize = 1000.0) : cellSize(cellSize), minCol(0), maxCol(-1), minRow(0), maxRow(-1)
+    {
+        if (!(cellSize > 0.0))
+        {
+            throw std::runtime_error("SpatialGridIndex: the cell size must be positive");
+        }
+    }
+
+    /**
+     * Inserts an object, or moves it if it is already indexed
+     *
+     * @param object the object
+     * @param x x coordinate of its location
+     * @param y y coordinate of its location
+     */
+    void update(const T* object, double x, double y)
+    {
+        const int32_t col = cellOf(x);
+        const int32_t row = cellOf(y);
+        extendBounds(col, row);
+
+        const CellKey key = toKey(col, row);
+        typename std::unordered_map<const T*, Entry>::iterator it = entries.find(object);
+        const Item item = { object, x, y };
+        if (it == entries.end())
+        {
+            Cell& cell = cells[key];
+            Entry entry = { key, &cell, cell.size() };
+            entries.emplace(object, entry);
+            cell.push_back(item);
+            return;
+        }
+
+        Entry& entry = it->second;
+        if (entry.key != key)
+        {
+            removeFromCell(entry);
+            Cell& cell = cells[key];
+            entry.key = key;
+            entry.cell = &cell;
+            entry.slot = cell.size();
+            cell.push_back(item);
+        }
+        else
+        {
+            (*entry.cell)[entry.slot] = item;
+        }
+    }
+
+    /**
+     * Moves an indexed object within its cell
+     *
+     * Only the location of the object is written, so this may be called concurrently for distinct objects as long as
+     * no other method modifying the index is running.
+     *
+     * @return false (and does nothing) if the object is not indexed or its new location is in another cell, in which
+     *         case update() must be called
+     */
+    bool updateInPlace(const T* object, double x, double y)
+    {
+        typename std::unordered_map<const T*, Entry>::iterator it = entries.find(object);
+        if (it == entries.end() || it->second.key != toKey(cellOf(x), cellOf(y)))
+        {
+            return false;
+        }
+        Item& item = (*it->second.cell)[it->second.slot];
+        item.x = x;
+        item.y = y;
+        return true;
+    }
+
+    /**
+     * Removes an object; does nothing if it is not indexed
+     */
+    void erase(const T* object)
+    {
+        typename std::unordered_map<const T*, Entry>::iterator it = entries.find(object);
+        if (it != entries.end())
+        {
+            removeFromCell(it->second);
+            entries.erase(it);
+        }
+    }
+
+    bool contains(const T* object) const
+    {
+        return entries.find(object) != entries.end();
+    }
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    bool empty() const
+    {
+        return entries.empty();
+    }
+
+    void clear()
+    {
+        entries.clear();
+        cells.clear();
+        minCol = minRow = 0;
+        maxCol = maxRow = -1;
+    }
+
+    /**
+     * Returns the object closest to (x, y) among those accepted by filter; nullptr if there is none
+     */
+    const T* findNearest(double x, double y, const Filter& filter = Filter()) const
+    {
+        std::vector<std::pair<double, const T*> > found;
+        searchNearest(x, y, 1, std::numeric_limits<double>::max(), filter, found);
+        return (found.empty() ? nullptr : found.front().second);
+    }
+
+    /**
+     * Retrieves the k objects closest to (x, y) among those accepted by filter, closest first
+     *
+     * @param result output: the objects found (less than k if there are not enough)
+     */
+    void findKNearest(double x, double y, size_t k, std::vector<const T*>& result, const Filter& filter = Filter()) const
+    {
+        std::vector<std::pair<double, const T*> > found;
+        searchNearest(x, y, k, std::numeric_limits<double>::max(), filter, found);
+        toObjects(found, result);
+    }
+
+    /**
+     * Retrieves the objects within radius of (x, y) accepted by filter, closest first
+     *
+     * @param result output: the objects found
+     */
+    void findWithinRadius(double x, double y, double radius, std::vector<const T*>& result,
+                          const Filter& filter = Filter()) const
+    {
+        std::vector<std::pair<double, const T*> > found;
+        searchNearest(x, y, entries.size(), radius, filter, found);
+        toObjects(found, result);
+    }
+
+    /**
+     * Retrieves the objects located in the axially-aligned rectangle (boundaries included), in no particular order
+     *
+     * @param result output: the objects found
+     */
+    void findInRect(double minX, double minY, double maxX, double maxY, std::vector<const T*>& result) const
+    {
+        result.clear();
+        if (entries.empty() || maxX < minX || maxY < minY)
+        {
+            return;
+        }
+
+        const int64_t firstCol = std::max<int64_t>(cellOf(minX), minCol);
+        const int64_t lastCol = std::min<int64_t>(cellOf(maxX), maxCol);
+        const int64_t firstRow = std::max<int64_t>(cellOf(minY), minRow);
+        const int64_t lastRow = std::min<int64_t>(cellOf(maxY), maxRow);
+        if (lastCol < firstCol || lastRow < firstRow)
+        {
+            return;
+        }
+
+        //a rectangle covering more cells than are occupied is answered from the occupied cells
+        if ((lastCol - firstCol + 1) * (lastRow - firstRow + 1) > static_cast<int64_t>(cells.size()))
+        {
+            for (typename std::unordered_map<CellKey, Cell>::const_iterator cellIt = cells.begin();
+                 cellIt != cells.end(); ++cellIt)
+            {
+                addInRect(cellIt->second, minX, minY, maxX, maxY, result);
+            }
+            return;
+        }
+
+        for (int64_t col = firstCol; col <= lastCol; ++col)
+        {
+            for (int64_t row = firstRow; row <= lastRow; ++row)
+            {
+                typename std::unordered_map<CellKey, Cell>::const_iterator cellIt =
+                        cells.find(toKey(static_cast<int32_t>(col), static_cast<int32_t>(row)));
+                if (cellIt != cells.end())
+                {
+                    addInRect(cellIt->second, minX, minY, maxX, maxY, result);
+                }
+            }
+        }
+    }
+
+private:
+    typedef uint64_t CellKey;
+
+    /**An object and its location, as stored in its cell*/
+    struct Item
+    {
+        const T* object;
+        double x;
+        double y;
+    };
+
+    typedef std::vector<Item> Cell;
+
+    struct Entry
+    {
+        /**cell holding the object, and position of the object in it*/
+        CellKey key;
+        Cell* cell;
+        size_t slot;
+    };
+
+    int32_t cellOf(double coordinate) const
+    {
+        return static_cast<int32_t>(std::floor(coordinate / cellSize));
+    }
+
+    static CellKey toKey(int32_t col, int32_t row)
+    {
+        return (static_cast<CellKey>(static_cast<uint32_t>(col)) << 32) | static_cast<uint32_t>(row);
+    }
+
+    void extendBounds(int32_t col, int32_t row)
+    {
+        if (maxCol < minCol)
+        {
+            minCol = maxCol = col;
+            minRow = maxRow = row;
+            return;
+        }
+        minCol = std::min(minCol, col);
+        maxCol = std::max(maxCol, col);
+        minRow = std::min(minRow, row);
+        maxRow = std::max(maxRow, row);
+    }
+
+    void removeFromCell(const Entry& entry)
+    {
+        Cell& cell = *entry.cell;
+
+        //swap with the last object of the cell, to erase in constant time
+        const Item last = cell.back();
+        cell[entry.slot] = last;
+        entries.find(last.object)->second.slot = entry.slot;
+        cell.pop_back();
+        if (cell.empty())
+        {
+            cells.erase(entry.key);
+        }
+    }
+
+    /**
+     * Adds the objects of a cell located in the rectangle to result
+     */
+    static void addInRect(const Cell& cell, double minX, double minY, double maxX, double maxY, std::vector<const T*>& result)
+    {
+        for (const Item& item : cell)
+        {
+            if (item.x >= minX && item.x <= maxX && item.y >= minY && item.y <= maxY)
+            {
+                result.push_back(item.object);
+            }
+        }
+    }
+
+    /**
+     * Adds the accepted objects of a cell within maxDistance to candidates
+     */
+    void visitCell(int32_t col, int32_t row, double x, double y, double maxDistance, const Filter& filter,
+                   std::vector<std::pair<double, const T*> >& candidates) const
+    {
+        typename std::unordered_map<CellKey, Cell>::const_iterator cellIt = cells.find(toKey(col, row));
+        if (cellIt == cells.end())
+        {
+            return;
+        }
+        for (const Item& item : cellIt->second)
+        {
+            const double distance = std::sqrt((item.x - x) * (item.x - x) + (item.y - y) * (item.y - y));
+            if (distance <= maxDistance && (!filter || filter(item.object)))
+            {
+                candidates.push_back(std::make_pair(distance, item.object));
+            }
+        }
+    }
+
+    /**
+     * Retrieves the (at most) k accepted objects within maxDistance of (x, y), closest first
+     */
+    void searchNearest(double x, double y, size_t k, double maxDistance, const Filter& filter,
+                       std::vector<std::pair<double, const T*> >& found) const
+    {
+        found.clear();
+        if (k == 0 || entries.empty())
+        {
+            return;
+        }
+
+        const int32_t col = cellOf(x);
+        const int32_t row = cellOf(y);
+
+        //the occupied cells lie within maxRing rings of the query cell
+        const int64_t maxRing = std::max(std::max(static_cast<int64_t>(col) - minCol, static_cast<int64_t>(maxCol) - col),
+                                         std::max(static_cast<int64_t>(row) - minRow, static_cast<int64_t>(maxRow) - row));
+
+        for (int64_t ring = 0; ring <= maxRing; ++ring)
+        {
+            //the objects in this ring and beyond are farther than (ring - 1) * cellSize
+            const double ringDistance = (ring - 1) * cellSize;
+            if (ringDistance > maxDistance || (found.size() >= k && found[k - 1].first <= ringDistance))
+            {
+                break;
+            }
+
+            if (ring == 0)
+            {
+                visitCell(col, row, x, y, maxDistance, filter, found);
+            }
+            else
+            {
+                const int32_t r = static_cast<int32_t>(ring);
+                for (int32_t i = -r; i <= r; ++i)
+                {
+                    visitCell(col + i, row - r, x, y, maxDistance, filter, found);
+                    visitCell(col + i, row + r, x, y, maxDistance, filter, found);
+                }
+                for (int32_t i = -r + 1; i <= r - 1; ++i)
+                {
+                    visitCell(col - r, row + i, x, y, maxDistance, filter, found);
+                    visitCell(col + r, row + i, x, y, maxDistance, filter, found);
+                }
+            }
+
+            std::sort(found.begin(), found.end());
+            if (found.size() > k)
+            {
+                found.resize(k);
+            }
+        }
+    }
+
+    static void toObjects(const std::vector<std::pair<double, const T*> >& found, std::vector<const T*>& result)
+    {
+        result.clear();
+        result.reserve(found.size());
+        for (const std::pair<double, const T*>& item : found)
+        {
+            result.push_back(item.second);
+        }
+    }
+
+    /**side of a cell (meters)*/
+    double cellSize;
+
+    /**cell of each indexed object*/
+    std::unordered_map<const T*, Entry> entries;
+
+    /**objects in each non-empty cell, with their location; the elements of an unordered_map do not move when it grows*/
+    std::unordered_map<CellKey, Cell> cells;
+
+    /**range of the cells which have held an object since the last clear(); empty if maxCol < minCol*/
+    int32_t minCol;
+    int32_t maxCol;
+    int32_t minRow;
+    int32_t maxRow;
+};
+
+}
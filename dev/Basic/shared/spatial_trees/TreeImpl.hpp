@@ -42,6 +42,13 @@ public:
     {
     }
 
+    ///Update the locations of the Agents among the entities managed by a Worker. Called by each Worker, in parallel,
+    ///after it flipped its buffers and before update(); must therefore be thread-safe. Optional.
+
+    virtual void updateAgents(const std::set<sim_mob::Entity *> &entities)
+    {
+    }
+
     ///Update the structure.
     //Note: The pointers in removedAgentPointers will be deleted after this time tick; do *not*
     //      save them anywhere.
@@ -0,0 +1,99 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "GridAuraManager.hpp"
+
+#include "geospatial/network/Point.hpp"
+#include "geospatial/network/WayPoint.hpp"
+#include "spatial_trees/shared_funcs.hpp"
+
+using namespace sim_mob;
+using namespace spatial;
+
+GridAuraManager::GridAuraManager(double cellSize) : index(cellSize)
+{
+}
+
+GridAuraManager::~GridAuraManager()
+{
+}
+
+void GridAuraManager::updateAgents(const std::set<Entity *> &entities)
+{
+    //The index is only read here (or written for agents of this Worker), so the Workers need not synchronise.
+    std::vector<Move> moves;
+    for (std::set<Entity *>::const_iterator it = entities.begin(); it != entities.end(); ++it)
+    {
+        Agent *agent = dynamic_cast<Agent *>(*it);
+        if (!agent)
+        {
+            continue;
+        }
+
+        if (agent->isNonspatial())
+        {
+            if (index.contains(agent))
+            {
+                Move move = { agent, 0, 0, true };
+                moves.push_back(move);
+            }
+            continue;
+        }
+
+        const int x = agent->xPos.get();
+        const int y = agent->yPos.get();
+        if (!index.updateInPlace(agent, x, y))
+        {
+            Move move = { agent, x, y, false };
+            moves.push_back(move);
+        }
+    }
+
+    if (!moves.empty())
+    {
+        boost::mutex::scoped_lock lock(dirtyMutex);
+        dirty.insert(dirty.end(), moves.begin(), moves.end());
+    }
+}
+
+void GridAuraManager::update(int time_step, const std::set<sim_mob::Entity *> &removedAgentPointers)
+{
+    for (std::vector<Move>::const_iterator it = dirty.begin(); it != dirty.end(); ++it)
+    {
+        if (it->remove)
+        {
+            index.erase(it->agent);
+        }
+        else
+        {
+            index.update(it->agent, it->x, it->y);
+        }
+    }
+    dirty.clear();
+
+    //Removed agents may have been moved above
+    for (std::set<Entity *>::const_iterator it = removedAgentPointers.begin(); it != removedAgentPointers.end(); ++it)
+    {
+        Agent *agent = dynamic_cast<Agent *>(*it);
+        if (agent)
+        {
+            index.erase(agent);
+        }
+    }
+}
+
+std::vector<const Agent *> GridAuraManager::agentsInRect(const Point &lowerLeft, const Point &upperRight, const sim_mob::Agent *refAgent) const
+{
+    std::vector<const Agent *> agentsInRectangle;
+    index.findInRect(lowerLeft.getX(), lowerLeft.getY(), upperRight.getX(), upperRight.getY(), agentsInRectangle);
+    return agentsInRectangle;
+}
+
+std::vector<const Agent *> GridAuraManager::nearbyAgents(const Point &position, const WayPoint &wayPoint, double distanceInFront, double distanceBehind,
+                                                         const sim_mob::Agent *refAgent) const
+{
+    Point lowerLeft, upperRight;
+    getNearbyAgentsRect(position, wayPoint, distanceInFront, distanceBehind, lowerLeft, upperRight);
+    return agentsInRect(lowerLeft, upperRight, nullptr);
+}
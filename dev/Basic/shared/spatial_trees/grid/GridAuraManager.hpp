@@ -0,0 +1,102 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <vector>
+#include <boost/thread/mutex.hpp>
+
+#include "entities/Agent.hpp"
+#include "spatial_trees/SpatialGridIndex.hpp"
+#include "spatial_trees/TreeImpl.hpp"
+
+namespace sim_mob
+{
+
+/**
+ * Aura manager indexing the agents on a uniform grid which is updated incrementally.
+ *
+ * The tree based implementations rebuild their index from all the agents at every tick, on the main thread. Here,
+ * each Worker updates the locations of its own agents in parallel, right after flipping its buffers: an agent which
+ * stays in its cell is moved in place, and the agents which changed cell (or are new) are put on the dirty list of
+ * the Worker. The main thread then only moves the agents of the dirty lists and drops the removed agents, so the
+ * cost of the aura manager phase depends on the number of agents which changed cell rather than on all the agents.
+ */
+class GridAuraManager : public TreeImpl
+{
+public:
+    /**
+     * @param cellSize side of a cell (meters)
+     */
+    explicit GridAuraManager(double cellSize = 50.0);
+    virtual ~GridAuraManager();
+
+    /**
+     * Updates the locations of the agents among the given entities, or records them for the next update().
+     * Called by each Worker, in parallel, after it flipped its buffers.
+     *
+     * @param entities the entities managed by the Worker
+     */
+    virtual void updateAgents(const std::set<Entity *> &entities);
+
+    /**
+     * Applies the moves recorded since the last update and removes the given agents.
+     *
+     * @param time_step simulation time_step
+     * @param removedAgentPointers agents removed during this tick
+     *
+     * The pointers in removedAgentPointers will be deleted after this time tick; do *not* save them anywhere.
+     */
+    virtual void update(int time_step, const std::set<sim_mob::Entity *> &removedAgentPointers);
+
+    /**
+     * Return a collection of agents that are located in the axially-aligned rectangle.
+     *
+     * @param lowerLeft The lower left corner of the axially-aligned search rectangle.
+     * @param upperRight The upper right corner of the axially-aligned search rectangle.
+     * @param refAgent Unused.
+     *
+     * @return a collection of agents
+     * The caller is responsible to determine the "type" of each agent in the returned array.
+     */
+    virtual std::vector<Agent const *> agentsInRect(const Point &lowerLeft, const Point &upperRight, const sim_mob::Agent *refAgent) const;
+
+    /**
+     * Return a collection of agents that are on the left, right, front, and back of the specified
+     * position. The search rectangle is computed by spatial::getNearbyAgentsRect, as for the PackingTreeAuraManager.
+     *
+     * @param position The center of the search rectangle.
+     * @param wayPoint The wapypoint (lane or turning path)
+     * @param distanceInFront The forward distance of the search rectangle.
+     * @param distanceBehind The backward distance of the search rectangle
+     * @param refAgent Unused.
+     *
+     * @return a collection of agents
+     */
+    virtual std::vector<Agent const *> nearbyAgents(const Point &position, const WayPoint &wayPoint, double distanceInFront, double distanceBehind,
+                                                    const sim_mob::Agent *refAgent) const;
+
+private:
+    /**An agent which changed cell, entered or left the index*/
+    struct Move
+    {
+        const Agent *agent;
+        int x;
+        int y;
+
+        /**true if the agent became non-spatial*/
+        bool remove;
+    };
+
+    /**Locations of the agents, as of the last update*/
+    SpatialGridIndex<Agent> index;
+
+    /**Moves recorded by the Workers since the last update*/
+    std::vector<Move> dirty;
+
+    /**Protects dirty*/
+    boost::mutex dirtyMutex;
+};
+
+}
@@ -4,15 +4,18 @@
 
 #include "shared_funcs.hpp"
 
+#include <algorithm>
 #include <vector>
 
 #include "buffering/Vector2D.hpp"
 #include "entities/Entity.hpp"
 #include "entities/Agent.hpp"
 #include "geospatial/network/Point.hpp"
+#include "geospatial/network/PolyLine.hpp"
 #include "geospatial/network/Lane.hpp"
 #include "geospatial/network/RoadSegment.hpp"
 #include "geospatial/network/RoadNetwork.hpp"
+#include "geospatial/network/TurningPath.hpp"
 
 
 using namespace sim_mob;
@@ -190,3 +193,29 @@ void sim_mob::spatial::adjust(Point &p1, Point &p2, const Point &position, doubl
     p1 = Point(x, y);
 }
 
+void sim_mob::spatial::getNearbyAgentsRect(const Point &position, const WayPoint &wayPoint, double distanceInFront, double distanceBehind,
+                                           Point &lowerLeft, Point &upperRight)
+{
+    // Find the stretch of the poly-line that <position> is in.
+    const std::vector<PolyPoint> &points = (wayPoint.type == WayPoint::LANE) ? wayPoint.lane->getPolyLine()->getPoints()
+                                                                             : wayPoint.turningPath->getPolyLine()->getPoints();
+
+    Point p1, p2;
+    for (size_t i = 0; i < points.size() - 1; i++)
+    {
+        p1 = points[i];
+        p2 = points[i + 1];
+        if (isInBetween(position, p1, p2))
+        {
+            break;
+        }
+    }
+
+    // Adjust <p1> and <p2>.  <distanceInFront> and <distanceBehind> may extend beyond the stretch marked out by <p1> and <p2>.
+    adjust(p1, p2, position, distanceInFront, distanceBehind);
+
+    // Calculate the search rectangle, widened by the adjacent lanes (or turning paths).
+    double halfWidth = getAdjacentPathWidth(wayPoint) / 2;
+    lowerLeft = Point(std::min(p1.getX(), p2.getX()) - halfWidth, std::min(p1.getY(), p2.getY()) - halfWidth);
+    upperRight = Point(std::max(p1.getX(), p2.getX()) + halfWidth, std::max(p1.getY(), p2.getY()) + halfWidth);
+}
@@ -59,5 +59,20 @@ bool isInBetween(const sim_mob::Point &point, const sim_mob::Point &p1, const si
 // from <p1> to <p2>.
 void adjust(sim_mob::Point &p1, sim_mob::Point &p2, const sim_mob::Point &position, double distanceInFront, double distanceBehind);
 
+/**
+ * Calculates the rectangle searched by AuraManager::nearbyAgents: the stretch of the poly-line of the lane/turning
+ * path that <position> is in, extended to <distanceInFront> and <distanceBehind> and widened by the adjacent
+ * lanes/turning paths.
+ *
+ * @param position the position of the agent searching around itself
+ * @param wayPoint holds the lane or the turning path the agent is on
+ * @param distanceInFront distance to be searched ahead of position
+ * @param distanceBehind distance to be searched behind position
+ * @param lowerLeft set to the lower left corner of the rectangle
+ * @param upperRight set to the upper right corner of the rectangle
+ */
+void getNearbyAgentsRect(const sim_mob::Point &position, const sim_mob::WayPoint &wayPoint, double distanceInFront, double distanceBehind,
+                         sim_mob::Point &lowerLeft, sim_mob::Point &upperRight);
+
 }
 } 
@@ -0,0 +1,87 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "behavioral/LogitKernels.hpp"
+
+#include "LogitKernelsUnitTests.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::LogitKernelsUnitTests);
+
+using namespace sim_mob;
+
+namespace
+{
+const double EPSILON = 1e-12;
+const double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+}
+
+void unit_tests::LogitKernelsUnitTests::test_MnlProbabilities()
+{
+    double utility[] = { 1.0, 2.0, NOT_A_NUMBER, 0.5 };
+    double availability[] = { 1, 1, 1, 0 };
+    double probability[4];
+    logit::computeMnlProbabilities(utility, availability, 4, probability);
+
+    //the NaN utility is made unavailable in the inputs as well
+    CPPUNIT_ASSERT_EQUAL(0.0, utility[2]);
+    CPPUNIT_ASSERT_EQUAL(0.0, availability[2]);
+
+    const double sum = std::exp(1.0) + std::exp(2.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::exp(1.0) / sum, probability[0], EPSILON);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::exp(2.0) / sum, probability[1], EPSILON);
+    CPPUNIT_ASSERT_EQUAL(0.0, probability[2]);
+    CPPUNIT_ASSERT_EQUAL(0.0, probability[3]);
+}
+
+void unit_tests::LogitKernelsUnitTests::test_MnlLogsum()
+{
+    const double utility[] = { 1.0, NOT_A_NUMBER, -1.0 };
+    const double availability[] = { 1, 1, 1 };
+    const double logsum = logit::computeMnlLogsum(utility, availability, 3);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::log(std::exp(1.0) + std::exp(-1.0)), logsum, EPSILON);
+    CPPUNIT_ASSERT(utility[1] != utility[1]);
+    CPPUNIT_ASSERT_EQUAL(1.0, availability[1]);
+}
+
+void unit_tests::LogitKernelsUnitTests::test_NlWithUnitScales()
+{
+    double mnlUtility[] = { 0.3, -0.2, 1.1, 0.7, -1.5 };
+    double mnlAvailability[] = { 1, 1, 0, 1, 1 };
+    double nlUtility[5], nlAvailability[5];
+    std::copy(mnlUtility, mnlUtility + 5, nlUtility);
+    std::copy(mnlAvailability, mnlAvailability + 5, nlAvailability);
+
+    const std::size_t nestSizes[] = { 2, 3 };
+    const double scales[] = { 1, 1 };
+
+    double mnlProbability[5], nlProbability[5];
+    logit::computeMnlProbabilities(mnlUtility, mnlAvailability, 5, mnlProbability);
+    logit::computeNlProbabilities(nlUtility, nlAvailability, nestSizes, scales, 2, nlProbability);
+    for (int i = 0; i < 5; ++i)
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(mnlProbability[i], nlProbability[i], EPSILON);
+    }
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(logit::computeMnlLogsum(mnlUtility, mnlAvailability, 5),
+            logit::computeNlLogsum(nlUtility, nlAvailability, nestSizes, scales, 2), EPSILON);
+}
+
+void unit_tests::LogitKernelsUnitTests::test_NlUnavailableNest()
+{
+    double utility[] = { 0.5, 1.0, 2.0 };
+    double availability[] = { 1, 0, 0 };
+    const std::size_t nestSizes[] = { 1, 2 };
+    const double scales[] = { 2, 0.5 };
+    double probability[3];
+    logit::computeNlProbabilities(utility, availability, nestSizes, scales, 2, probability);
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, probability[0], EPSILON);
+    CPPUNIT_ASSERT_EQUAL(0.0, probability[1]);
+    CPPUNIT_ASSERT_EQUAL(0.0, probability[2]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, logit::computeNlLogsum(utility, availability, nestSizes, scales, 2), EPSILON);
+}
@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the logit computations in behavioral/LogitKernels.hpp
+ */
+class LogitKernelsUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test the multinomial logit probabilities and the masking of NaN utilities
+    void test_MnlProbabilities();
+
+    ///Test that the logsum of a multinomial logit model does not modify its inputs
+    void test_MnlLogsum();
+
+    ///Test that a nested logit model with unit scales gives the probabilities and logsum of the multinomial logit model
+    void test_NlWithUnitScales();
+
+    ///Test the nested logit probabilities when a nest has no available alternative
+    void test_NlUnavailableNest();
+
+private:
+    CPPUNIT_TEST_SUITE(LogitKernelsUnitTests);
+        CPPUNIT_TEST(test_MnlProbabilities);
+        CPPUNIT_TEST(test_MnlLogsum);
+        CPPUNIT_TEST(test_NlWithUnitScales);
+        CPPUNIT_TEST(test_NlUnavailableNest);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,160 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "behavioral/LogsumCache.hpp"
+
+#include "LogsumCacheUnitTests.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::LogsumCacheUnitTests);
+
+using namespace sim_mob;
+
+namespace
+{
+const std::string CACHE_FILE = "LogsumCacheUnitTests.bin";
+const uint64_t INPUTS_FINGERPRINT = 0x1234;
+
+PersonParams makePerson(const std::string& personId, int homeLocation)
+{
+    PersonParams personParams;
+    personParams.setPersonId(personId);
+    personParams.setPersonTypeId(1);
+    personParams.setAgeId(3);
+    personParams.setIncomeId(5);
+    personParams.setHomeLocation(homeLocation);
+    personParams.setFixedWorkLocation(20);
+    personParams.setActivityLogsum(1, 0);
+    personParams.setActivityLogsum(2, 0);
+    return personParams;
+}
+
+void setLogsums(PersonParams& personParams, double base)
+{
+    personParams.setActivityLogsum(1, base + 1);
+    personParams.setActivityLogsum(2, base + 2);
+    personParams.setDptLogsum(base + 3);
+    personParams.setDpsLogsum(base + 4);
+    personParams.setDpbLogsum(base + 5);
+    personParams.setTravelProbability(0.75);
+    personParams.setTripsExpected(2.5);
+}
+}
+
+void unit_tests::LogsumCacheUnitTests::test_Signature()
+{
+    const LogsumSignature first(makePerson("1-1", 10), "TC");
+
+    CPPUNIT_ASSERT(first == LogsumSignature(makePerson("2-1", 10), "TC"));
+    CPPUNIT_ASSERT_EQUAL(hash_value(first), hash_value(LogsumSignature(makePerson("2-1", 10), "TC")));
+
+    CPPUNIT_ASSERT(!(first == LogsumSignature(makePerson("1-1", 11), "TC")));
+    CPPUNIT_ASSERT(!(first == LogsumSignature(makePerson("1-1", 10), "TCZero")));
+
+    PersonParams otherVehicle = makePerson("1-1", 10);
+    otherVehicle.setVehicleOwnershipCategory(2);
+    CPPUNIT_ASSERT(!(first == LogsumSignature(otherVehicle, "TC")));
+
+    PersonParams otherLogsum = makePerson("1-1", 10);
+    otherLogsum.setActivityLogsum(3, 0.5);
+    CPPUNIT_ASSERT(!(first == LogsumSignature(otherLogsum, "TC")));
+}
+
+void unit_tests::LogsumCacheUnitTests::test_FindInsert()
+{
+    LogsumCache cache(16, INPUTS_FINGERPRINT);
+    const LogsumSignature signature(makePerson("1-1", 10), "TC");
+
+    PersonParams result = makePerson("2-1", 10);
+    CPPUNIT_ASSERT(!cache.find(signature, result));
+
+    PersonParams computed = makePerson("1-1", 10);
+    setLogsums(computed, 10);
+    cache.insert(signature, computed);
+
+    CPPUNIT_ASSERT(cache.find(LogsumSignature(makePerson("2-1", 10), "TC"), result));
+    CPPUNIT_ASSERT_EQUAL(std::string("2-1"), result.getPersonId());
+    CPPUNIT_ASSERT_EQUAL(11.0, result.getActivityLogsum(1));
+    CPPUNIT_ASSERT_EQUAL(12.0, result.getActivityLogsum(2));
+    CPPUNIT_ASSERT_EQUAL(13.0, result.getDptLogsum());
+    CPPUNIT_ASSERT_EQUAL(14.0, result.getDpsLogsum());
+    CPPUNIT_ASSERT_EQUAL(15.0, result.getDpbLogsum());
+    CPPUNIT_ASSERT_EQUAL(0.75, result.getTravelProbability());
+    CPPUNIT_ASSERT_EQUAL(2.5, result.getTripsExpected());
+
+    CPPUNIT_ASSERT(!cache.find(LogsumSignature(makePerson("1-1", 11), "TC"), result));
+
+    CacheStatistics stats = cache.getStatistics();
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), stats.hits);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), stats.misses);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), stats.entries);
+}
+
+void unit_tests::LogsumCacheUnitTests::test_SaveLoad()
+{
+    std::remove(CACHE_FILE.c_str());
+    {
+        LogsumCache cache(16, INPUTS_FINGERPRINT);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.loadFromFile(CACHE_FILE));
+
+        for (int home = 10; home < 13; ++home)
+        {
+            PersonParams computed = makePerson("1-1", home);
+            LogsumSignature signature(computed, "TC");
+            setLogsums(computed, home);
+            cache.insert(signature, computed);
+        }
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), cache.saveToFile(CACHE_FILE));
+    }
+
+    LogsumCache loaded(16, INPUTS_FINGERPRINT);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), loaded.loadFromFile(CACHE_FILE));
+    for (int home = 10; home < 13; ++home)
+    {
+        PersonParams result = makePerson("3-1", home);
+        CPPUNIT_ASSERT(loaded.find(LogsumSignature(result, "TC"), result));
+        CPPUNIT_ASSERT_EQUAL(home + 3.0, result.getDptLogsum());
+        CPPUNIT_ASSERT_EQUAL(home + 1.0, result.getActivityLogsum(1));
+    }
+
+    //logsums saved for other scripts or data are not loaded
+    LogsumCache stale(16, INPUTS_FINGERPRINT + 1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), stale.loadFromFile(CACHE_FILE));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), stale.getStatistics().entries);
+
+    std::ifstream inFile(CACHE_FILE.c_str(), std::ios::binary);
+    const std::string contents((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    inFile.close();
+
+    //truncate the file in the middle of an entry
+    std::ofstream outFile(CACHE_FILE.c_str(), std::ios::binary | std::ios::trunc);
+    outFile.write(contents.data(), contents.size() - 8);
+    outFile.close();
+
+    LogsumCache corrupt(16, INPUTS_FINGERPRINT);
+    CPPUNIT_ASSERT_THROW(corrupt.loadFromFile(CACHE_FILE), std::runtime_error);
+
+    //counts larger than the file are rejected before anything is allocated for them
+    const std::size_t numEntriesOffset = 8 + sizeof(uint32_t) + sizeof(uint64_t);
+    const std::size_t numAttributesOffset = numEntriesOffset + sizeof(uint64_t);
+    const uint32_t hugeCount = 0xFFFFFFFF;
+    const uint64_t hugeNumEntries = uint64_t(1) << 60;
+    std::string hugeAttributes = contents;
+    hugeAttributes.replace(numAttributesOffset, sizeof(hugeCount), reinterpret_cast<const char*>(&hugeCount), sizeof(hugeCount));
+    std::string hugeEntries = contents;
+    hugeEntries.replace(numEntriesOffset, sizeof(hugeNumEntries), reinterpret_cast<const char*>(&hugeNumEntries), sizeof(hugeNumEntries));
+    for (const std::string* corruptContents : { &hugeAttributes, &hugeEntries })
+    {
+        outFile.open(CACHE_FILE.c_str(), std::ios::binary | std::ios::trunc);
+        outFile.write(corruptContents->data(), corruptContents->size());
+        outFile.close();
+
+        LogsumCache oversized(16, INPUTS_FINGERPRINT);
+        CPPUNIT_ASSERT_THROW(oversized.loadFromFile(CACHE_FILE), std::runtime_error);
+    }
+    std::remove(CACHE_FILE.c_str());
+}
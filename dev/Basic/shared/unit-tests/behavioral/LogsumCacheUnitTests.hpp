@@ -0,0 +1,36 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the preday logsum cache in behavioral/LogsumCache.hpp
+ */
+class LogsumCacheUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that persons differing only by id share a signature, and persons differing by a model input do not
+    void test_Signature();
+
+    ///Test that cached logsums are returned for a matching signature only
+    void test_FindInsert();
+
+    ///Test that the entries saved to a file are loaded back, and that a stale, truncated or corrupt file is rejected
+    void test_SaveLoad();
+
+private:
+    CPPUNIT_TEST_SUITE(LogsumCacheUnitTests);
+        CPPUNIT_TEST(test_Signature);
+        CPPUNIT_TEST(test_FindInsert);
+        CPPUNIT_TEST(test_SaveLoad);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -8,6 +8,7 @@
 #include "buffering/Buffered.hpp"
 #include "buffering/Buffered_uint32.hpp"
 #include "buffering/BufferedDataManager.hpp"
+#include "buffering/Shared.hpp"
 #include "buffering/Vector2D.hpp"
 
 #include "BufferedUnitTests.hpp"
@@ -475,6 +476,146 @@ void BufferedUnitTests::test_BufferedDataManager_stopManaging()
     CPPUNIT_ASSERT(0 == mgr2.managed_data_count());
 }
 
+void BufferedUnitTests::test_BufferedDataManager_many_data()
+{
+    // More data than fit in a block of the arena.
+    const size_t count = 1000;
+    std::vector<sim_mob::Buffered_uint32*> integers;
+    std::vector<sim_mob::Buffered<double>*> doubles;
+
+    DataManager mgr;
+    for (size_t i = 0; i < count; i++) {
+        integers.push_back(new sim_mob::Buffered_uint32(i));
+        doubles.push_back(new sim_mob::Buffered<double>(i * 0.5));
+        mgr.beginManaging(integers.back());
+        mgr.beginManaging(doubles.back());
+    }
+    CPPUNIT_ASSERT(2 * count == mgr.managed_data_count());
+
+    // Every other integer stops being managed; it must keep its values.
+    for (size_t i = 0; i < count; i += 2) {
+        (*integers[i])++;
+        mgr.stopManaging(integers[i]);
+        CPPUNIT_ASSERT(i == *integers[i]);
+    }
+    CPPUNIT_ASSERT(count + count / 2 == mgr.managed_data_count());
+
+    // Its replacements take other slots until the next flip.
+    std::vector<sim_mob::Buffered_uint32*> replacements;
+    for (size_t i = 0; i < count / 2; i++) {
+        replacements.push_back(new sim_mob::Buffered_uint32(7));
+        mgr.beginManaging(replacements.back());
+        (*replacements.back()) += 3;
+    }
+    CPPUNIT_ASSERT(2 * count == mgr.managed_data_count());
+
+    for (size_t i = 1; i < count; i += 2) {
+        (*integers[i])++;
+    }
+    for (size_t i = 0; i < count; i++) {
+        doubles[i]->set(i * 2.0);
+    }
+    mgr.flip();
+
+    for (size_t i = 0; i < count; i++) {
+        CPPUNIT_ASSERT((i % 2 ? i + 1 : i) == *integers[i]);
+        CPPUNIT_ASSERT(i * 2.0 == *doubles[i]);
+    }
+    for (size_t i = 0; i < replacements.size(); i++) {
+        CPPUNIT_ASSERT(10 == *replacements[i]);
+    }
+
+    // The next value starts from the current one after a flip.
+    (*integers[1])++;
+    mgr.flip();
+    CPPUNIT_ASSERT(3 == *integers[1]);
+
+    for (size_t i = 0; i < count; i++) {
+        mgr.stopManaging(integers[i]);
+        mgr.stopManaging(doubles[i]);
+        delete integers[i];
+        delete doubles[i];
+    }
+    for (size_t i = 0; i < replacements.size(); i++) {
+        mgr.stopManaging(replacements[i]);
+        delete replacements[i];
+    }
+    CPPUNIT_ASSERT(0 == mgr.managed_data_count());
+}
+
+void BufferedUnitTests::test_BufferedDataManager_Shared_T_objects()
+{
+    sim_mob::Shared<int> buffered(sim_mob::MtxStrat_Buffered, 42);
+    sim_mob::Shared<int> locked(sim_mob::MtxStrat_Locked, 42);
+
+    DataManager mgr;
+    mgr.beginManaging(&buffered);
+    mgr.beginManaging(&locked);
+    CPPUNIT_ASSERT(2 == mgr.managed_data_count());
+
+    buffered.set(1);
+    CPPUNIT_ASSERT(42 == buffered);
+    mgr.flip();
+    CPPUNIT_ASSERT(1 == buffered);
+    CPPUNIT_ASSERT(42 == locked);
+
+    buffered.getRW() = 5;
+    CPPUNIT_ASSERT(5 == buffered.get());
+
+    buffered.set(2);
+    mgr.stopManaging(&buffered);
+    mgr.stopManaging(&locked);
+    CPPUNIT_ASSERT(0 == mgr.managed_data_count());
+    CPPUNIT_ASSERT(5 == buffered);
+
+    // The pending value is flipped by the next manager.
+    DataManager mgr2;
+    mgr2.beginManaging(&buffered);
+    mgr2.flip();
+    CPPUNIT_ASSERT(2 == buffered);
+    mgr2.stopManaging(&buffered);
+}
+
+void BufferedUnitTests::test_BufferedDataManager_release_before_flip()
+{
+    sim_mob::Buffered<int> released(1);
+    sim_mob::Buffered<int> added(2);
+    sim_mob::Buffered<int> addedAfterFlip(3);
+
+    DataManager mgr;
+    mgr.beginManaging(&released);
+    released.set(4);
+    mgr.flip();
+    const int* pooled = &released.get();
+    CPPUNIT_ASSERT(4 == *pooled);
+
+    // A reader which fetched the value before the release keeps reading it during the update phase.
+    released.set(5);
+    mgr.stopManaging(&released);
+    CPPUNIT_ASSERT(4 == released);
+    CPPUNIT_ASSERT(pooled != &released.get());
+    mgr.beginManaging(&added);
+    CPPUNIT_ASSERT(pooled != &added.get());
+    CPPUNIT_ASSERT(4 == *pooled);
+    CPPUNIT_ASSERT(2 == added);
+
+    // The slot is reused once flipped.
+    mgr.flip();
+    mgr.beginManaging(&addedAfterFlip);
+    CPPUNIT_ASSERT(pooled == &addedAfterFlip.get());
+    CPPUNIT_ASSERT(3 == addedAfterFlip);
+
+    // The value set before the release is flipped by the next manager.
+    DataManager mgr2;
+    mgr2.beginManaging(&released);
+    mgr2.flip();
+    CPPUNIT_ASSERT(5 == released);
+
+    mgr2.stopManaging(&released);
+    mgr.stopManaging(&added);
+    mgr.stopManaging(&addedAfterFlip);
+}
+
 void BufferedUnitTests::test_the_Vector2D_float_class()
 {
     // This is lazy: the better approach is to have a separate method of the BufferedUnitTests
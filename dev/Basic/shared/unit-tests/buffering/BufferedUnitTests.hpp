@@ -154,6 +154,24 @@ public:
      */
     void test_BufferedDataManager_stopManaging();
 
+    /**
+     * Tests that a BufferedDataManager flips many data, of several types, after some of them
+     * stopped being managed and others took their place.
+     */
+    void test_BufferedDataManager_many_data();
+
+    /**
+     * Tests that Shared<T> objects are flipped whatever their mutex strategy, and keep their
+     * values when they stop being managed.
+     */
+    void test_BufferedDataManager_Shared_T_objects();
+
+    /**
+     * Tests that the values of a datum which stops being managed stay where other threads read
+     * them until the next flip, and that its slot is only reused after that flip.
+     */
+    void test_BufferedDataManager_release_before_flip();
+
     /**
      * Tests the Vector2D class.
      *
@@ -179,6 +197,9 @@ private:
         CPPUNIT_TEST(test_BufferedDataManager_doubleBeginManage);
         CPPUNIT_TEST(test_BufferedDataManager_doubleStopManaging);
         CPPUNIT_TEST(test_BufferedDataManager_stopManaging);
+        CPPUNIT_TEST(test_BufferedDataManager_many_data);
+        CPPUNIT_TEST(test_BufferedDataManager_Shared_T_objects);
+        CPPUNIT_TEST(test_BufferedDataManager_release_before_flip);
         CPPUNIT_TEST(test_the_Vector2D_float_class);
     CPPUNIT_TEST_SUITE_END();
 };
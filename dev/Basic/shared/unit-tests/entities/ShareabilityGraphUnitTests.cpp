@@ -0,0 +1,130 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cmath>
+#include <vector>
+
+#include <boost/random.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "entities/controllers/ShareabilityGraph.hpp"
+#include "geospatial/network/Node.hpp"
+
+#include "ShareabilityGraphUnitTests.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::ShareabilityGraphUnitTests);
+
+using sim_mob::Node;
+using sim_mob::Point;
+using sim_mob::ShareabilityGraph;
+using sim_mob::TripRequestMessage;
+
+namespace
+{
+/**speed, in m/s, below which no travel time goes*/
+const double LOWER_BOUND_SPEED = 10.0;
+
+/**
+ * Euclidean distance at LOWER_BOUND_SPEED, lengthened by 0 to 60% depending on the nodes, so that the travel times are
+ * not symmetric and are only bounded from below by the distance
+ */
+double travelTime(const Node* from, const Node* to)
+{
+    const double dx = from->getPosX() - to->getPosX();
+    const double dy = from->getPosY() - to->getPosY();
+    const double detour = ((from->getNodeId() * 7919 + to->getNodeId() * 104729) % 61) / 100.0;
+    return std::sqrt(dx * dx + dy * dy) / LOWER_BOUND_SPEED * (1.0 + detour);
+}
+
+/**
+ * Random requests over 8 km x 8 km, each with its own start and destination nodes
+ */
+struct RandomRequests
+{
+    RandomRequests(size_t numRequests, unsigned seed)
+    {
+        boost::mt19937 rng(seed);
+        boost::uniform_real<> coordinate(0.0, 8000.0);
+        boost::uniform_int<> threshold(0, 900);
+        for (size_t i = 0; i < 2 * numRequests; ++i)
+        {
+            nodes.push_back(boost::shared_ptr<Node>(new Node()));
+            nodes.back()->setNodeId(i + 1);
+            nodes.back()->setLocation(Point(coordinate(rng), coordinate(rng)));
+        }
+        for (size_t i = 0; i < numRequests; ++i)
+        {
+            TripRequestMessage request;
+            request.startNode = nodes[2 * i].get();
+            request.destinationNode = nodes[2 * i + 1].get();
+            request.extraTripTimeThreshold = threshold(rng);
+            requests.push_back(request);
+            desiredTravelTimes.push_back(travelTime(request.startNode, request.destinationNode));
+        }
+    }
+
+    std::vector<boost::shared_ptr<Node> > nodes;
+    std::vector<TripRequestMessage> requests;
+    std::vector<double> desiredTravelTimes;
+};
+}
+
+void unit_tests::ShareabilityGraphUnitTests::test_PrunedMatchesAllPairs()
+{
+    //enough requests for both graphs to be evaluated by the thread pool, where there is more than one core
+    const RandomRequests random(300, 7);
+    const ShareabilityGraph allPairs(random.requests, random.desiredTravelTimes, travelTime, 0.0);
+    const ShareabilityGraph pruned(random.requests, random.desiredTravelTimes, travelTime, LOWER_BOUND_SPEED);
+
+    const size_t numRequests = random.requests.size();
+    CPPUNIT_ASSERT_EQUAL(numRequests * (numRequests - 1) / 2, allPairs.getNumEvaluatedPairs());
+    CPPUNIT_ASSERT(pruned.getNumEvaluatedPairs() < allPairs.getNumEvaluatedPairs());
+    CPPUNIT_ASSERT(allPairs.getNumEdges() > 0);
+    CPPUNIT_ASSERT_EQUAL(allPairs.getNumEdges(), pruned.getNumEdges());
+
+    for (unsigned i = 0; i < numRequests; ++i)
+    {
+        const std::pair<const ShareabilityGraph::SharedTrip*, const ShareabilityGraph::SharedTrip*> expected =
+                allPairs.getSharedTrips(i);
+        const std::pair<const ShareabilityGraph::SharedTrip*, const ShareabilityGraph::SharedTrip*> found =
+                pruned.getSharedTrips(i);
+        CPPUNIT_ASSERT_EQUAL(expected.second - expected.first, found.second - found.first);
+        for (ptrdiff_t j = 0; j < expected.second - expected.first; ++j)
+        {
+            CPPUNIT_ASSERT_EQUAL(expected.first[j].request, found.first[j].request);
+            CPPUNIT_ASSERT_EQUAL(expected.first[j].totalTime, found.first[j].totalTime);
+            CPPUNIT_ASSERT_EQUAL(expected.first[j].sequence, found.first[j].sequence);
+        }
+    }
+}
+
+void unit_tests::ShareabilityGraphUnitTests::test_EdgesAreSymmetric()
+{
+    const RandomRequests random(60, 13);
+    const ShareabilityGraph graph(random.requests, random.desiredTravelTimes, travelTime, LOWER_BOUND_SPEED);
+    CPPUNIT_ASSERT_EQUAL(random.requests.size(), graph.getNumRequests());
+
+    size_t numEnds = 0;
+    for (unsigned i = 0; i < graph.getNumRequests(); ++i)
+    {
+        const std::pair<const ShareabilityGraph::SharedTrip*, const ShareabilityGraph::SharedTrip*> trips =
+                graph.getSharedTrips(i);
+        numEnds += trips.second - trips.first;
+        for (unsigned j = 0; j < graph.getNumRequests(); ++j)
+        {
+            const ShareabilityGraph::SharedTrip* trip = graph.findSharedTrip(i, j);
+            const ShareabilityGraph::SharedTrip* reverse = graph.findSharedTrip(j, i);
+            CPPUNIT_ASSERT_EQUAL(trip == nullptr, reverse == nullptr);
+            if (trip)
+            {
+                CPPUNIT_ASSERT(i != j);
+                CPPUNIT_ASSERT_EQUAL(j, trip->request);
+                CPPUNIT_ASSERT_EQUAL(i, reverse->request);
+                CPPUNIT_ASSERT_EQUAL(trip->totalTime, reverse->totalTime);
+                CPPUNIT_ASSERT_EQUAL(trip->sequence, reverse->sequence);
+            }
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(2 * graph.getNumEdges(), numEnds);
+}
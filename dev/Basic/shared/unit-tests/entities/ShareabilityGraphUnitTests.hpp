@@ -0,0 +1,32 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the ShareabilityGraph in entities/controllers/ShareabilityGraph.hpp
+ */
+class ShareabilityGraphUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that the graph built with pruning has the same edges as the one built by evaluating all the pairs
+    void test_PrunedMatchesAllPairs();
+
+    ///Test that both ends of each edge see it, and that findSharedTrip finds exactly the edges
+    void test_EdgesAreSymmetric();
+
+private:
+    CPPUNIT_TEST_SUITE(ShareabilityGraphUnitTests);
+        CPPUNIT_TEST(test_PrunedMatchesAllPairs);
+        CPPUNIT_TEST(test_EdgesAreSymmetric);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
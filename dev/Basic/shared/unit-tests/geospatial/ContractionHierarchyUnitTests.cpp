@@ -0,0 +1,180 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/random.hpp>
+
+#include "geospatial/streetdir/ContractionHierarchy.hpp"
+
+#include "ContractionHierarchyUnitTests.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::ContractionHierarchyUnitTests);
+
+using sim_mob::ContractionHierarchy;
+using sim_mob::StreetDirectory;
+
+namespace
+{
+const unsigned GRID_SIZE = 12;
+
+void addEdge(StreetDirectory::Graph& graph, StreetDirectory::Vertex from, StreetDirectory::Vertex to, double weight)
+{
+    StreetDirectory::Edge edge = boost::add_edge(from, to, graph).first;
+    boost::put(boost::edge_weight, graph, edge, weight);
+}
+
+/**Grid of two-way streets with random weights; the weights differ per direction*/
+void makeGrid(unsigned size, StreetDirectory::Graph& graph)
+{
+    boost::mt19937 rng(7);
+    boost::uniform_real<> weight(1.0, 10.0);
+    for (unsigned i = 0; i < size * size; ++i)
+    {
+        boost::add_vertex(graph);
+    }
+    for (unsigned row = 0; row < size; ++row)
+    {
+        for (unsigned col = 0; col < size; ++col)
+        {
+            StreetDirectory::Vertex v = row * size + col;
+            if (col + 1 < size)
+            {
+                addEdge(graph, v, v + 1, weight(rng));
+                addEdge(graph, v + 1, v, weight(rng));
+            }
+            if (row + 1 < size)
+            {
+                addEdge(graph, v, v + size, weight(rng));
+                addEdge(graph, v + size, v, weight(rng));
+            }
+        }
+    }
+}
+
+/**@return the Dijkstra distances from source; infinity for unreachable vertices*/
+std::vector<double> dijkstraCosts(const StreetDirectory::Graph& graph, StreetDirectory::Vertex source)
+{
+    std::vector<double> dist(boost::num_vertices(graph));
+    boost::dijkstra_shortest_paths(graph, source, boost::distance_map(&dist[0]));
+    return dist;
+}
+
+/**Travel time like re-weighting: the edges leaving every third vertex become congested*/
+double congestedWeight(const StreetDirectory::Graph* graph, const StreetDirectory::Edge& edge)
+{
+    double weight = boost::get(boost::edge_weight, *graph, edge);
+    return (boost::source(edge, *graph) % 3 == 0 ? weight * 4.0 : weight);
+}
+
+void checkAllPairs(const StreetDirectory::Graph& graph, const ContractionHierarchy& hierarchy)
+{
+    std::vector<StreetDirectory::Edge> path;
+    for (StreetDirectory::Vertex from = 0; from < boost::num_vertices(graph); ++from)
+    {
+        std::vector<double> expected = dijkstraCosts(graph, from);
+        for (StreetDirectory::Vertex to = 0; to < boost::num_vertices(graph); ++to)
+        {
+            double cost = -1.0;
+            CPPUNIT_ASSERT(hierarchy.query(from, to, path, cost));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[to], cost, 1e-9);
+        }
+    }
+}
+}
+
+void unit_tests::ContractionHierarchyUnitTests::test_CostsMatchDijkstra()
+{
+    StreetDirectory::Graph graph;
+    makeGrid(GRID_SIZE, graph);
+
+    ContractionHierarchy hierarchy;
+    CPPUNIT_ASSERT(!hierarchy.isBuilt());
+    hierarchy.build(graph);
+    CPPUNIT_ASSERT(hierarchy.isBuilt());
+
+    checkAllPairs(graph, hierarchy);
+}
+
+void unit_tests::ContractionHierarchyUnitTests::test_UnpackedPaths()
+{
+    StreetDirectory::Graph graph;
+    makeGrid(GRID_SIZE, graph);
+    ContractionHierarchy hierarchy;
+    hierarchy.build(graph);
+
+    StreetDirectory::Vertex from = 0;
+    StreetDirectory::Vertex to = GRID_SIZE * GRID_SIZE - 1;
+    std::vector<StreetDirectory::Edge> path;
+    double cost = 0.0;
+    CPPUNIT_ASSERT(hierarchy.query(from, to, path, cost));
+    CPPUNIT_ASSERT(path.size() >= 2 * (GRID_SIZE - 1));
+
+    //consecutive edges of the graph, from the source to the sink
+    CPPUNIT_ASSERT_EQUAL(from, boost::source(path.front(), graph));
+    CPPUNIT_ASSERT_EQUAL(to, boost::target(path.back(), graph));
+    double sum = 0.0;
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+        if (i > 0)
+        {
+            CPPUNIT_ASSERT_EQUAL(boost::target(path[i - 1], graph), boost::source(path[i], graph));
+        }
+        sum += boost::get(boost::edge_weight, graph, path[i]);
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(cost, sum, 1e-9);
+
+    //a vertex to itself is an empty path
+    CPPUNIT_ASSERT(hierarchy.query(from, from, path, cost));
+    CPPUNIT_ASSERT(path.empty());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, cost, 1e-9);
+}
+
+void unit_tests::ContractionHierarchyUnitTests::test_Unreachable()
+{
+    //0 -> 1 -> 2 one-way, 3 isolated; the parallel edge 0 -> 1 is cheaper
+    StreetDirectory::Graph graph;
+    for (int i = 0; i < 4; ++i)
+    {
+        boost::add_vertex(graph);
+    }
+    addEdge(graph, 0, 1, 5.0);
+    addEdge(graph, 0, 1, 2.0);
+    addEdge(graph, 1, 2, 3.0);
+
+    ContractionHierarchy hierarchy;
+    hierarchy.build(graph);
+
+    std::vector<StreetDirectory::Edge> path;
+    double cost = 0.0;
+    CPPUNIT_ASSERT(hierarchy.query(0, 2, path, cost));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, cost, 1e-9);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), path.size());
+
+    CPPUNIT_ASSERT(!hierarchy.query(2, 0, path, cost));
+    CPPUNIT_ASSERT(path.empty());
+    CPPUNIT_ASSERT(!hierarchy.query(0, 3, path, cost));
+    CPPUNIT_ASSERT(!hierarchy.query(3, 0, path, cost));
+}
+
+void unit_tests::ContractionHierarchyUnitTests::test_Customize()
+{
+    StreetDirectory::Graph graph;
+    makeGrid(GRID_SIZE, graph);
+    ContractionHierarchy hierarchy;
+    hierarchy.build(graph);
+    hierarchy.customize(boost::bind(congestedWeight, &graph, _1));
+
+    //same structure, with the congested weights as edge_weight
+    StreetDirectory::Graph congested(boost::num_vertices(graph));
+    StreetDirectory::Graph::edge_iterator it, end;
+    for (boost::tie(it, end) = boost::edges(graph); it != end; ++it)
+    {
+        addEdge(congested, boost::source(*it, graph), boost::target(*it, graph), congestedWeight(&graph, *it));
+    }
+
+    checkAllPairs(congested, hierarchy);
+}
@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the ContractionHierarchy in geospatial/streetdir/ContractionHierarchy.hpp
+ */
+class ContractionHierarchyUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that the query costs match Dijkstra's on a grid of two-way streets
+    void test_CostsMatchDijkstra();
+
+    ///Test that the unpacked paths are connected edges of the graph adding up to the query cost
+    void test_UnpackedPaths();
+
+    ///Test that unreachable vertices and one-way streets are handled
+    void test_Unreachable();
+
+    ///Test that the query costs match Dijkstra's with the new weights after customize()
+    void test_Customize();
+
+private:
+    CPPUNIT_TEST_SUITE(ContractionHierarchyUnitTests);
+        CPPUNIT_TEST(test_CostsMatchDijkstra);
+        CPPUNIT_TEST(test_UnpackedPaths);
+        CPPUNIT_TEST(test_Unreachable);
+        CPPUNIT_TEST(test_Customize);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,129 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "geospatial/network/Lane.hpp"
+#include "geospatial/network/Point.hpp"
+#include "spatial_trees/LaneVehicleIndex.hpp"
+
+#include "LaneVehicleIndexUnitTests.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::LaneVehicleIndexUnitTests);
+
+using namespace sim_mob;
+
+namespace
+{
+const Point LOWER_LEFT(0, 0);
+const Point UPPER_RIGHT(1000, 1000);
+
+/**@return a distinct agent; the index never dereferences the agents*/
+const Agent* agent(int id)
+{
+    static const char agents[16] = {};
+    return reinterpret_cast<const Agent*>(agents + id);
+}
+
+/**Lanes keyed by id, as in the road network*/
+struct Lanes
+{
+    Lanes()
+    {
+        byId[1] = &first;
+        byId[2] = &second;
+    }
+
+    Lane first;
+    Lane second;
+    std::map<unsigned int, Lane*> byId;
+};
+
+std::vector<const Agent*> find(const LaneVehicleIndex& index, const Lane* lane, uint32_t frame)
+{
+    std::vector<const Agent*> result;
+    index.findInRect(lane, frame, LOWER_LEFT, UPPER_RIGHT, result);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<const Agent*> agents(int first, int last)
+{
+    std::vector<const Agent*> result;
+    for (int id = first; id <= last; ++id)
+    {
+        result.push_back(agent(id));
+    }
+    return result;
+}
+}
+
+void unit_tests::LaneVehicleIndexUnitTests::test_DoubleBufferParity()
+{
+    Lanes lanes;
+    LaneVehicleIndex index(lanes.byId, LaneVehicleIndex::LOOKUP_LANES);
+
+    //nothing was added for frame 0, not even the vehicles of a default constructed list
+    CPPUNIT_ASSERT(find(index, &lanes.first, 0).empty());
+
+    //added during frame 0, for frame 1
+    index.add(&lanes.first, agent(0), 10, 10, 0);
+    index.add(&lanes.first, agent(1), 20, 20, 0);
+    CPPUNIT_ASSERT(find(index, &lanes.first, 0).empty());
+    CPPUNIT_ASSERT(agents(0, 1) == find(index, &lanes.first, 1));
+
+    //the vehicles added during frame 1 go to the other list, which is not read in frame 1
+    index.add(&lanes.first, agent(2), 30, 30, 1);
+    CPPUNIT_ASSERT(agents(0, 1) == find(index, &lanes.first, 1));
+    CPPUNIT_ASSERT(agents(2, 2) == find(index, &lanes.first, 2));
+}
+
+void unit_tests::LaneVehicleIndexUnitTests::test_PerFrameClearing()
+{
+    Lanes lanes;
+    LaneVehicleIndex index(lanes.byId, LaneVehicleIndex::LOOKUP_LANES);
+
+    index.add(&lanes.first, agent(0), 10, 10, 0);
+    index.add(&lanes.first, agent(1), 20, 20, 0);
+    index.add(&lanes.second, agent(2), 20, 20, 0);
+
+    //the list of frame 1 is reused for frame 3; the first vehicle added clears the vehicles of frame 1
+    index.add(&lanes.first, agent(3), 40, 40, 2);
+    index.add(&lanes.first, agent(4), 50, 50, 2);
+    CPPUNIT_ASSERT(agents(3, 4) == find(index, &lanes.first, 3));
+
+    //a lane to which no vehicle was added for frame 3 still holds frame 1, which must not be returned
+    CPPUNIT_ASSERT(find(index, &lanes.second, 3).empty());
+    CPPUNIT_ASSERT(find(index, &lanes.first, 1).empty());
+
+    //a lane left empty for a whole tick is empty two ticks later as well
+    CPPUNIT_ASSERT(find(index, &lanes.first, 5).empty());
+}
+
+void unit_tests::LaneVehicleIndexUnitTests::test_RectAndLaneFilter()
+{
+    Lanes lanes;
+    Lane unknown;
+    LaneVehicleIndex index(lanes.byId, LaneVehicleIndex::LOOKUP_VALIDATE);
+    CPPUNIT_ASSERT_EQUAL(LaneVehicleIndex::LOOKUP_VALIDATE, index.getMode());
+
+    index.add(&lanes.first, agent(0), 0, 0, 6);
+    index.add(&lanes.first, agent(1), 1000, 1000, 6);
+    index.add(&lanes.first, agent(2), 1001, 500, 6);
+    index.add(&lanes.first, agent(3), 500, -1, 6);
+    index.add(&lanes.second, agent(4), 500, 500, 6);
+    index.add(&unknown, agent(5), 500, 500, 6);
+
+    CPPUNIT_ASSERT(agents(0, 1) == find(index, &lanes.first, 7));
+    CPPUNIT_ASSERT(agents(4, 4) == find(index, &lanes.second, 7));
+    CPPUNIT_ASSERT(find(index, &unknown, 7).empty());
+
+    //the agents found are appended to the given vector
+    std::vector<const Agent*> result(1, agent(9));
+    index.findInRect(&lanes.second, 7, LOWER_LEFT, UPPER_RIGHT, result);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), result.size());
+    CPPUNIT_ASSERT(agent(9) == result[0]);
+}
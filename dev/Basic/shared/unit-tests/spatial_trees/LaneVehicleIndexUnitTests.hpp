@@ -0,0 +1,36 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the LaneVehicleIndex in spatial_trees/LaneVehicleIndex.hpp
+ */
+class LaneVehicleIndexUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that vehicles added during a tick are found in the next tick only, while the next lists are filled
+    void test_DoubleBufferParity();
+
+    ///Test that the lists of a tick are cleared before the vehicles of a later tick with the same parity are added
+    void test_PerFrameClearing();
+
+    ///Test that only the vehicles of the lane in the rectangle (bounds included) are found
+    void test_RectAndLaneFilter();
+
+private:
+    CPPUNIT_TEST_SUITE(LaneVehicleIndexUnitTests);
+        CPPUNIT_TEST(test_DoubleBufferParity);
+        CPPUNIT_TEST(test_PerFrameClearing);
+        CPPUNIT_TEST(test_RectAndLaneFilter);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,205 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/random.hpp>
+
+#include "spatial_trees/SpatialGridIndex.hpp"
+
+#include "SpatialGridIndexUnitTests.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::SpatialGridIndexUnitTests);
+
+using sim_mob::SpatialGridIndex;
+
+namespace
+{
+struct Vehicle
+{
+    double x;
+    double y;
+};
+
+bool isEven(const std::vector<Vehicle>* vehicles, const Vehicle* vehicle)
+{
+    return (vehicle - &vehicles->front()) % 2 == 0;
+}
+
+/**@return the vehicles sorted by their distance from (x, y)*/
+std::vector<std::pair<double, const Vehicle*> > sortByDistance(const std::vector<Vehicle>& vehicles, double x, double y)
+{
+    std::vector<std::pair<double, const Vehicle*> > sorted;
+    for (const Vehicle& vehicle : vehicles)
+    {
+        sorted.push_back(std::make_pair(std::sqrt((vehicle.x - x) * (vehicle.x - x) + (vehicle.y - y) * (vehicle.y - y)),
+                                        &vehicle));
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+}
+
+void unit_tests::SpatialGridIndexUnitTests::test_QueriesMatchLinearScan()
+{
+    //vehicles scattered over 20 km x 20 km, on both sides of the origin
+    boost::mt19937 rng(11);
+    boost::uniform_real<> coordinate(-10000.0, 10000.0);
+    std::vector<Vehicle> vehicles(500);
+    SpatialGridIndex<Vehicle> index(750.0);
+    for (Vehicle& vehicle : vehicles)
+    {
+        vehicle.x = coordinate(rng);
+        vehicle.y = coordinate(rng);
+        index.update(&vehicle, vehicle.x, vehicle.y);
+    }
+    CPPUNIT_ASSERT_EQUAL(vehicles.size(), index.size());
+
+    //query points inside and well outside the area covered by the vehicles
+    boost::uniform_real<> queryCoordinate(-30000.0, 30000.0);
+    for (int i = 0; i < 100; ++i)
+    {
+        const double x = queryCoordinate(rng);
+        const double y = queryCoordinate(rng);
+        const std::vector<std::pair<double, const Vehicle*> > expected = sortByDistance(vehicles, x, y);
+
+        CPPUNIT_ASSERT(expected.front().second == index.findNearest(x, y));
+
+        std::vector<const Vehicle*> found;
+        index.findKNearest(x, y, 10, found);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(10), found.size());
+        for (size_t j = 0; j < found.size(); ++j)
+        {
+            CPPUNIT_ASSERT(expected[j].second == found[j]);
+        }
+
+        const double radius = 2500.0;
+        index.findWithinRadius(x, y, radius, found);
+        size_t inRadius = 0;
+        while (inRadius < expected.size() && expected[inRadius].first <= radius)
+        {
+            CPPUNIT_ASSERT(inRadius < found.size() && expected[inRadius].second == found[inRadius]);
+            ++inRadius;
+        }
+        CPPUNIT_ASSERT_EQUAL(inRadius, found.size());
+    }
+}
+
+void unit_tests::SpatialGridIndexUnitTests::test_MoveAndErase()
+{
+    std::vector<Vehicle> vehicles(3);
+    SpatialGridIndex<Vehicle> index(100.0);
+    index.update(&vehicles[0], 0.0, 0.0);
+    index.update(&vehicles[1], 50.0, 0.0);
+    index.update(&vehicles[2], 1000.0, 1000.0);
+    CPPUNIT_ASSERT(&vehicles[0] == index.findNearest(10.0, 0.0));
+
+    //moving within the same cell and to another cell
+    index.update(&vehicles[0], 20.0, 0.0);
+    CPPUNIT_ASSERT(&vehicles[0] == index.findNearest(10.0, 0.0));
+    index.update(&vehicles[0], 990.0, 990.0);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), index.size());
+    CPPUNIT_ASSERT(&vehicles[1] == index.findNearest(10.0, 0.0));
+    CPPUNIT_ASSERT(&vehicles[0] == index.findNearest(980.0, 980.0));
+
+    index.erase(&vehicles[1]);
+    CPPUNIT_ASSERT(!index.contains(&vehicles[1]));
+    CPPUNIT_ASSERT(&vehicles[0] == index.findNearest(10.0, 0.0));
+    index.erase(&vehicles[1]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), index.size());
+
+    std::vector<const Vehicle*> found;
+    index.findWithinRadius(0.0, 0.0, 500.0, found);
+    CPPUNIT_ASSERT(found.empty());
+}
+
+void unit_tests::SpatialGridIndexUnitTests::test_FilterAndEmpty()
+{
+    SpatialGridIndex<Vehicle> index;
+    CPPUNIT_ASSERT(index.empty());
+    CPPUNIT_ASSERT(!index.findNearest(0.0, 0.0));
+
+    std::vector<Vehicle> vehicles(10);
+    for (size_t i = 0; i < vehicles.size(); ++i)
+    {
+        index.update(&vehicles[i], 100.0 * i, 0.0);
+    }
+
+    //the odd vehicles are rejected, so the nearest to (190, 0) is the vehicle at (200, 0) rather than (100, 0)
+    const SpatialGridIndex<Vehicle>::Filter even = boost::bind(isEven, &vehicles, _1);
+    CPPUNIT_ASSERT(&vehicles[2] == index.findNearest(190.0, 0.0, even));
+
+    std::vector<const Vehicle*> found;
+    index.findKNearest(0.0, 0.0, 20, found, even);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), found.size());
+    for (size_t i = 0; i < found.size(); ++i)
+    {
+        CPPUNIT_ASSERT(&vehicles[2 * i] == found[i]);
+    }
+
+    index.clear();
+    CPPUNIT_ASSERT(index.empty());
+    CPPUNIT_ASSERT(!index.findNearest(0.0, 0.0));
+}
+
+void unit_tests::SpatialGridIndexUnitTests::test_RectQueryAndMoveInPlace()
+{
+    boost::mt19937 rng(23);
+    boost::uniform_real<> coordinate(-5000.0, 5000.0);
+    boost::uniform_real<> step(-60.0, 60.0);
+    std::vector<Vehicle> vehicles(400);
+    SpatialGridIndex<Vehicle> index(200.0);
+    for (Vehicle& vehicle : vehicles)
+    {
+        vehicle.x = coordinate(rng);
+        vehicle.y = coordinate(rng);
+        index.update(&vehicle, vehicle.x, vehicle.y);
+    }
+
+    //small moves stay in the cell of the vehicle; the others need update()
+    size_t movedInPlace = 0;
+    for (Vehicle& vehicle : vehicles)
+    {
+        vehicle.x += step(rng);
+        vehicle.y += step(rng);
+        if (index.updateInPlace(&vehicle, vehicle.x, vehicle.y))
+        {
+            ++movedInPlace;
+        }
+        else
+        {
+            index.update(&vehicle, vehicle.x, vehicle.y);
+        }
+    }
+    CPPUNIT_ASSERT(movedInPlace > 0 && movedInPlace < vehicles.size());
+    CPPUNIT_ASSERT(!index.updateInPlace(nullptr, 0.0, 0.0));
+
+    //small rectangles, and rectangles larger than the area covered by the vehicles
+    for (int i = 0; i < 100; ++i)
+    {
+        const double extent = (i % 10 == 0) ? 20000.0 : 800.0;
+        const double minX = coordinate(rng) - extent / 2;
+        const double minY = coordinate(rng) - extent / 2;
+        const double maxX = minX + extent;
+        const double maxY = minY + extent;
+
+        std::vector<const Vehicle*> expected;
+        for (const Vehicle& vehicle : vehicles)
+        {
+            if (vehicle.x >= minX && vehicle.x <= maxX && vehicle.y >= minY && vehicle.y <= maxY)
+            {
+                expected.push_back(&vehicle);
+            }
+        }
+
+        std::vector<const Vehicle*> found;
+        index.findInRect(minX, minY, maxX, maxY, found);
+        std::sort(found.begin(), found.end());
+        CPPUNIT_ASSERT(expected == found);
+    }
+}
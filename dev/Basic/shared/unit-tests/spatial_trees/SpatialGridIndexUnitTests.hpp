@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the SpatialGridIndex in spatial_trees/SpatialGridIndex.hpp
+ */
+class SpatialGridIndexUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that the nearest, k-nearest and radius queries match a linear scan
+    void test_QueriesMatchLinearScan();
+
+    ///Test that moved and erased objects are found at their new location only
+    void test_MoveAndErase();
+
+    ///Test that the filter excludes objects and that an empty index finds nothing
+    void test_FilterAndEmpty();
+
+    ///Test that the rectangle query matches a linear scan after objects were moved in place and across cells
+    void test_RectQueryAndMoveInPlace();
+
+private:
+    CPPUNIT_TEST_SUITE(SpatialGridIndexUnitTests);
+        CPPUNIT_TEST(test_QueriesMatchLinearScan);
+        CPPUNIT_TEST(test_MoveAndErase);
+        CPPUNIT_TEST(test_FilterAndEmpty);
+        CPPUNIT_TEST(test_RectQueryAndMoveInPlace);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
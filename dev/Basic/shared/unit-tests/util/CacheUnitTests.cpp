@@ -0,0 +1,89 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <string>
+#include <boost/lexical_cast.hpp>
+
+#include "util/Cache.hpp"
+
+#include "CacheUnitTests.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::CacheUnitTests);
+
+namespace
+{
+typedef sim_mob::LRU_Cache<std::string, boost::shared_ptr<int> > IntCache;
+
+size_t intWeight(const boost::shared_ptr<int>& value)
+{
+    return *value;
+}
+}
+
+void unit_tests::CacheUnitTests::test_InsertAndFind()
+{
+    IntCache cache(100);
+    for (int i = 0; i < 50; ++i)
+    {
+        cache.insert(boost::lexical_cast<std::string>(i), boost::shared_ptr<int>(new int(i)));
+    }
+
+    boost::shared_ptr<int> value;
+    CPPUNIT_ASSERT(cache.find("42", value));
+    CPPUNIT_ASSERT_EQUAL(42, *value);
+    CPPUNIT_ASSERT(!cache.find("50", value));
+    CPPUNIT_ASSERT_EQUAL(50, cache.size());
+
+    //re-inserting a key replaces its value
+    cache.insert("42", boost::shared_ptr<int>(new int(-1)));
+    CPPUNIT_ASSERT(cache.find("42", value));
+    CPPUNIT_ASSERT_EQUAL(-1, *value);
+    CPPUNIT_ASSERT_EQUAL(50, cache.size());
+}
+
+void unit_tests::CacheUnitTests::test_SecondChanceEviction()
+{
+    //single shard, so that the eviction order is fully determined
+    IntCache cache(3, 1);
+    cache.insert("a", boost::shared_ptr<int>(new int(1)));
+    cache.insert("b", boost::shared_ptr<int>(new int(2)));
+    cache.insert("c", boost::shared_ptr<int>(new int(3)));
+
+    boost::shared_ptr<int> value;
+    CPPUNIT_ASSERT(cache.find("a", value));
+
+    cache.insert("d", boost::shared_ptr<int>(new int(4)));
+    CPPUNIT_ASSERT(cache.find("a", value));
+    CPPUNIT_ASSERT(!cache.find("b", value));
+    CPPUNIT_ASSERT(cache.find("c", value));
+    CPPUNIT_ASSERT(cache.find("d", value));
+    CPPUNIT_ASSERT_EQUAL(3, cache.size());
+}
+
+void unit_tests::CacheUnitTests::test_WeightedCapacity()
+{
+    IntCache cache(100, 4, &intWeight);
+    for (int i = 1; i <= 40; ++i)
+    {
+        cache.insert(boost::lexical_cast<std::string>(i), boost::shared_ptr<int>(new int(i)));
+        CPPUNIT_ASSERT(cache.getStatistics().weight <= 100);
+    }
+}
+
+void unit_tests::CacheUnitTests::test_Statistics()
+{
+    IntCache cache(2, 1);
+    boost::shared_ptr<int> value;
+    cache.insert("a", boost::shared_ptr<int>(new int(1)));
+    cache.insert("b", boost::shared_ptr<int>(new int(2)));
+    cache.find("a", value);
+    cache.find("x", value);
+    cache.insert("c", boost::shared_ptr<int>(new int(3)));
+
+    sim_mob::CacheStatistics stats = cache.getStatistics();
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), stats.hits);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), stats.misses);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(1), stats.evictions);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint64_t>(2), stats.entries);
+}
@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the sharded LRU_Cache in util/Cache.hpp
+ */
+class CacheUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that inserted values are found and unknown keys are not
+    void test_InsertAndFind();
+
+    ///Test that a referenced entry survives eviction while an unreferenced one does not
+    void test_SecondChanceEviction();
+
+    ///Test that the total weight never exceeds the capacity when a weigher is used
+    void test_WeightedCapacity();
+
+    ///Test the hit, miss and eviction counters
+    void test_Statistics();
+
+private:
+    CPPUNIT_TEST_SUITE(CacheUnitTests);
+        CPPUNIT_TEST(test_InsertAndFind);
+        CPPUNIT_TEST(test_SecondChanceEviction);
+        CPPUNIT_TEST(test_WeightedCapacity);
+        CPPUNIT_TEST(test_Statistics);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
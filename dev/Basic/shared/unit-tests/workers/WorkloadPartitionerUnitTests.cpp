@@ -0,0 +1,77 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "workers/WorkloadPartitioner.hpp"
+
+#include "WorkloadPartitionerUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::WorkloadPartitionerUnitTests);
+
+void unit_tests::WorkloadPartitionerUnitTests::test_BalancedPartsUntouched()
+{
+    WorkloadPartitioner partitioner(2);
+    partitioner.addVertex(3.0, 0, true);
+    partitioner.addVertex(2.0, 0, true);
+    partitioner.addVertex(5.1, 1, true);
+    partitioner.addEdge(0, 1);
+    partitioner.addEdge(1, 2);
+
+    CPPUNIT_ASSERT(partitioner.getImbalance() < 1.05);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), partitioner.rebalance(1.05, 10));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), partitioner.getPart(0));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), partitioner.getPart(2));
+}
+
+void unit_tests::WorkloadPartitionerUnitTests::test_ChainSplitContiguously()
+{
+    //0 - 1 - 2 - 3 - 4 - 5 - 6 - 7, all on the first part.
+    const size_t numVertices = 8;
+    WorkloadPartitioner partitioner(2);
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        partitioner.addVertex(1.0, 0, true);
+        if (i > 0)
+        {
+            partitioner.addEdge(i - 1, i);
+        }
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, partitioner.getImbalance(), 1e-9);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(4), partitioner.rebalance(1.05, numVertices));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, partitioner.getImbalance(), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, partitioner.getLoads()[1], 1e-9);
+
+    //Only one edge of the chain may cross the two parts.
+    size_t cut = 0;
+    for (size_t i = 1; i < numVertices; i++)
+    {
+        if (partitioner.getPart(i - 1) != partitioner.getPart(i))
+        {
+            cut++;
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(1), cut);
+}
+
+void unit_tests::WorkloadPartitionerUnitTests::test_ImmovableVerticesAndMaxMoves()
+{
+    WorkloadPartitioner partitioner(3);
+    partitioner.addVertex(6.0, 0, false);
+    for (size_t i = 0; i < 6; i++)
+    {
+        partitioner.addVertex(1.0, 0, true);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(size_t(2), partitioner.rebalance(1.0, 2));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, partitioner.getLoads()[0], 1e-9);
+
+    //Once all the movable vertices are gone, the immovable one keeps its part the heaviest.
+    partitioner.rebalance(1.0, 10);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), partitioner.getPart(0));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, partitioner.getLoads()[0], 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, partitioner.getLoads()[1], 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, partitioner.getLoads()[2], 1e-9);
+}
@@ -0,0 +1,36 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the WorkloadPartitioner used to rebalance Workers.
+ */
+class WorkloadPartitionerUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that a balanced assignment is left as it is.
+    void test_BalancedPartsUntouched();
+
+    ///Test that a chain held by one part is split into two halves of consecutive vertices.
+    void test_ChainSplitContiguously();
+
+    ///Test that immovable vertices stay, and that the number of moves is bounded.
+    void test_ImmovableVerticesAndMaxMoves();
+
+private:
+    CPPUNIT_TEST_SUITE(WorkloadPartitionerUnitTests);
+        CPPUNIT_TEST(test_BalancedPartsUntouched);
+        CPPUNIT_TEST(test_ChainSplitContiguously);
+        CPPUNIT_TEST(test_ImmovableVerticesAndMaxMoves);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
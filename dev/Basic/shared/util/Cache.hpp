@@ -1,110 +1,337 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <atomic>
 #include <cassert>
-#include <list>
-#include <map>
+#include <deque>
+#include <stdint.h>
+#include <vector>
+#include <boost/function.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/unordered_map.hpp>
 
 namespace sim_mob
 {
 /// Base template class for all cache implementations
 template <typename KEY, typename VAL> class Cache;
 
+/// Counters of a cache, aggregated over all its shards
+struct CacheStatistics
+{
+    CacheStatistics() : hits(0), misses(0), evictions(0), entries(0), weight(0)
+    {
+    }
+
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t entries;
+
+    /// total weight of the cached entries (bytes if the cache was given a weigher, else number of entries)
+    uint64_t weight;
+};
+
 /// Template class for Least Recently Used Caching Policy(LRU)
 template <typename KEY, typename VAL> class LRU_Cache : public Cache<KEY,VAL>{};
 
-/// Specialization of LRU template class for the VAL type to accept shared_ptr only
+/**
+ * Specialization of LRU template class for the VAL type to accept shared_ptr only
+ *
+ * The cache is split into a power of two number of shards selected by the hash of the key, each with its own lock,
+ * so that lookups from different threads rarely touch the same lock. Recency is tracked with the CLOCK (second chance)
+ * approximation of LRU: a lookup only sets the referenced flag of the entry, which is safe under the shared lock, and
+ * eviction (under the exclusive lock of the shard being inserted into) sweeps the clock hand over the entries of the shard,
+ * evicting the first one which was not referenced since the previous sweep.
+ *
+ * The capacity is either a number of entries or, if a weigher is supplied, the sum of the weights (e.g. bytes) of the entries.
+ * Values heavier than the capacity of a shard are not cached.
+ */
 template <typename K, typename VAL>
-class LRU_Cache<K, boost::shared_ptr<VAL> >
+class LRU_Cache<K, boost::shared_ptr<VAL> > : private boost::noncopyable
 {
 public:
     typedef K KeyType;
     typedef boost::shared_ptr<VAL> ValueType;
 
-    // Key access history, most recent at back
-    typedef std::list<KeyType> KeyTrackerType;
+    /// Function returning the weight of a value
+    typedef boost::function<size_t (const ValueType&)> WeigherType;
 
-    // Key to value and key history iterator
-    typedef std::map<KeyType, std::pair<ValueType, typename KeyTrackerType::iterator> > KeyToValueType;
-
-    /// Constuctor specifies the cached function and the maximum number of records to be stored
-    LRU_Cache(size_t c) : capacity(c)
+    /**
+     * Constuctor
+     * @param c maximum number of records to be stored or, if weigher is given, maximum total weight of records
+     * @param numShards number of independently locked shards (rounded up to a power of two)
+     * @param weigher function returning the weight of a value; every record weighs 1 if empty
+     */
+    LRU_Cache(size_t c, size_t numShards = 16, const WeigherType& weigher = WeigherType()) : capacity(c), weigher(weigher)
     {
         assert(capacity!=0);
+
+        size_t shardCount = 1;
+        while (shardCount < numShards && shardCount < capacity)
+        {
+            shardCount <<= 1;
+        }
+        shardMask = shardCount - 1;
+
+        size_t shardCapacity = (capacity + shardCount - 1) / shardCount;
+        shards.reserve(shardCount);
+        for (size_t i = 0; i < shardCount; ++i)
+        {
+            shards.push_back(new Shard(shardCapacity));
+        }
+    }
+
+    ~LRU_Cache()
+    {
+        for (typename std::vector<Shard*>::iterator it = shards.begin(); it != shards.end(); ++it)
+        {
+            delete *it;
+        }
     }
 
     /// Obtain value of the cached function for k
     bool find(const KeyType& key, ValueType & value)
     {
-        boost::shared_lock<boost::shared_mutex> lock(mutex_);
+        Shard& shard = getShard(key);
+        boost::shared_lock<boost::shared_mutex> lock(shard.mutex_);
 
         // Attempt to find existing record
-        const typename KeyToValueType::iterator it = keyToValue.find(key);
+        const typename KeyToSlotType::const_iterator it = shard.keyToSlot.find(key);
 
-        if (it==keyToValue.end())
+        if (it == shard.keyToSlot.end())
         {
+            shard.misses.fetch_add(1, std::memory_order_relaxed);
             return false;
         }
-        else
-        {
-            // Update access record by moving accessed key to back of list
-            keyTracker.splice(keyTracker.end(), keyTracker, (*it).second.second);
 
-            // Return the retrieved value
-            value = (*it).second.first;
-            return true;
-        }
+        // Give the record a second chance at the next sweep of the clock hand
+        Slot& slot = shard.slots[it->second];
+        slot.referenced.store(true, std::memory_order_relaxed);
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+
+        // Return the retrieved value
+        value = slot.value;
+        return true;
     }
 
-    /// Record a fresh key-value pair in the cache
+    /// Record a fresh key-value pair in the cache; replaces the value if the key is already cached
     void insert(const KeyType& k,const ValueType& v)
     {
-        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        size_t weight = (weigher ? weigher(v) : 1);
+        Shard& shard = getShard(k);
+        boost::unique_lock<boost::shared_mutex> lock(shard.mutex_);
 
-        // Make space if necessary
-        if (keyToValue.size()==capacity)
+        const typename KeyToSlotType::iterator it = shard.keyToSlot.find(k);
+        if (weight > shard.capacity)
+        {
+            // Too heavy to be retained. Drop the stale value (if any) rather than evicting the whole shard
+            if (it != shard.keyToSlot.end())
+            {
+                shard.erase(it->second);
+            }
+        }
+        else if (it != shard.keyToSlot.end())
         {
-            evict();
+            Slot& slot = shard.slots[it->second];
+            shard.weight = shard.weight - slot.weight + weight;
+            slot.value = v;
+            slot.weight = weight;
+            slot.referenced.store(true, std::memory_order_relaxed);
         }
+        else
+        {
+            // Make space if necessary
+            while (!shard.keyToSlot.empty() && shard.weight + weight > shard.capacity)
+            {
+                shard.evict();
+            }
 
-        // Record k as most-recently-used key
-        typename KeyTrackerType::iterator it = keyTracker.insert(keyTracker.end(),k);
+            size_t slotIdx;
+            if (shard.freeSlots.empty())
+            {
+                slotIdx = shard.slots.size();
+                shard.slots.emplace_back();
+            }
+            else
+            {
+                slotIdx = shard.freeSlots.back();
+                shard.freeSlots.pop_back();
+            }
 
-        // Create the key-value entry,
-        // linked to the usage record.
-        keyToValue.insert( std::make_pair(k, std::make_pair(v,it)) );
-        // No need to check return,
-        // given previous assert.
+            Slot& slot = shard.slots[slotIdx];
+            slot.key = k;
+            slot.value = v;
+            slot.weight = weight;
+            slot.occupied = true;
+            slot.referenced.store(false, std::memory_order_relaxed);
+            shard.keyToSlot.insert(std::make_pair(k, slotIdx));
+            shard.weight += weight;
+        }
     }
 
     int size()
     {
-        return keyToValue.size();
+        size_t entries = 0;
+        for (typename std::vector<Shard*>::const_iterator it = shards.begin(); it != shards.end(); ++it)
+        {
+            boost::shared_lock<boost::shared_mutex> lock((*it)->mutex_);
+            entries += (*it)->keyToSlot.size();
+        }
+        return entries;
+    }
+
+    /// Aggregates the counters of all shards
+    CacheStatistics getStatistics()
+    {
+        CacheStatistics stats;
+        for (typename std::vector<Shard*>::const_iterator it = shards.begin(); it != shards.end(); ++it)
+        {
+            Shard& shard = **it;
+            boost::shared_lock<boost::shared_mutex> lock(shard.mutex_);
+            stats.hits += shard.hits.load(std::memory_order_relaxed);
+            stats.misses += shard.misses.load(std::memory_order_relaxed);
+            stats.evictions += shard.evictions;
+            stats.entries += shard.keyToSlot.size();
+            stats.weight += shard.weight;
+        }
+        return stats;
+    }
+
+    /**
+     * Calls visitor(key, value) for each cached record, one shard at a time under its shared lock.
+     * Lookups do not count as references for the visited records.
+     */
+    template <typename Visitor>
+    void forEach(Visitor visitor)
+    {
+        for (typename std::vector<Shard*>::const_iterator it = shards.begin(); it != shards.end(); ++it)
+        {
+            Shard& shard = **it;
+            boost::shared_lock<boost::shared_mutex> lock(shard.mutex_);
+            for (typename std::deque<Slot>::const_iterator slotIt = shard.slots.begin(); slotIt != shard.slots.end(); ++slotIt)
+            {
+                if (slotIt->occupied)
+                {
+                    visitor(slotIt->key, slotIt->value);
+                }
+            }
+        }
     }
 
 private:
-    /// Purge the least-recently-used element in the cache
-    void evict()
+    /// A cached record
+    struct Slot
+    {
+        Slot() : weight(0), occupied(false), referenced(false)
+        {
+        }
+
+        KeyType key;
+        ValueType value;
+        size_t weight;
+        bool occupied;
+        std::atomic<bool> referenced;
+    };
+
+    // Key to position of its record within the shard
+    typedef boost::unordered_map<KeyType, size_t, boost::hash<KeyType> > KeyToSlotType;
+
+    /// Independently locked part of the cache
+    struct Shard : private boost::noncopyable
+    {
+        Shard(size_t capacity) : capacity(capacity), weight(0), hand(0), evictions(0), hits(0), misses(0)
+        {
+        }
+
+        /// Purge the record under the clock hand which was not referenced since the last sweep. Caller holds the exclusive lock
+        void evict()
+        {
+            // Assert method is never called when cache is empty
+            assert(!keyToSlot.empty());
+
+            while (true)
+            {
+                if (hand >= slots.size())
+                {
+                    hand = 0;
+                }
+
+                Slot& slot = slots[hand];
+                if (slot.occupied && !slot.referenced.exchange(false, std::memory_order_relaxed))
+                {
+                    erase(hand);
+                    ++evictions;
+                    ++hand;
+                    return;
+                }
+                ++hand;
+            }
+        }
+
+        /// Remove the record at slotIdx. Caller holds the exclusive lock
+        void erase(size_t slotIdx)
+        {
+            Slot& slot = slots[slotIdx];
+            keyToSlot.erase(slot.key);
+            weight -= slot.weight;
+            slot.value.reset();
+            slot.key = KeyType();
+            slot.weight = 0;
+            slot.occupied = false;
+            freeSlots.push_back(slotIdx);
+        }
+
+        /// Maximum weight of the records retained in this shard
+        const size_t capacity;
+
+        /// Total weight of the records in this shard
+        size_t weight;
+
+        /// Records; a deque so that records never move
+        std::deque<Slot> slots;
+
+        /// Positions in slots which are not occupied
+        std::vector<size_t> freeSlots;
+
+        /// Key-to-record lookup
+        KeyToSlotType keyToSlot;
+
+        /// Position of the clock hand in slots
+        size_t hand;
+
+        /// Number of records evicted. Protected by the exclusive lock
+        uint64_t evictions;
+
+        /// Lookup counters. Updated under the shared lock
+        std::atomic<uint64_t> hits;
+        std::atomic<uint64_t> misses;
+
+        /// protector
+        boost::shared_mutex mutex_;
+    };
+
+    Shard& getShard(const KeyType& key)
     {
-        // Assert method is never called when cache is empty
-        assert(!keyTracker.empty());
-
-        // Identify least recently used key
-        const typename KeyToValueType::iterator it = keyToValue.find(keyTracker.front());
-        assert(it!=keyToValue.end());
-        // Erase both elements to completely purge record
-        keyToValue.erase(it);
-        keyTracker.pop_front();
+        return *shards[boost::hash<KeyType>()(key) & shardMask];
     }
 
-    /// Maximum number of key-value pairs to be retained
+    /// Maximum number (or total weight) of key-value pairs to be retained
     const size_t capacity;
 
-    /// Key access history
-    KeyTrackerType keyTracker;
+    /// Weight of a value; unit weight if empty
+    const WeigherType weigher;
 
-    /// Key-to-value lookup
-    KeyToValueType keyToValue;
+    /// Shards of the cache; the number of shards is a power of two
+    std::vector<Shard*> shards;
 
-    /// protector
-    boost::shared_mutex mutex_;
+    /// Mask selecting the shard from the hash of the key
+    size_t shardMask;
 };
 }//namespace
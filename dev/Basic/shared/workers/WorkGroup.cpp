@@ -6,6 +6,7 @@
 
 #include "GenConfig.h"
 
+#include <algorithm>
 #include <boost/thread.hpp>
 #include <iostream>
 #include <sstream>
@@ -24,16 +25,26 @@
 #include "partitions/PartitionManager.hpp"
 #include "path/PathSetManager.hpp"
 #include "workers/Worker.hpp"
+#include "workers/WorkloadPartitioner.hpp"
 
 using std::vector;
 
 using namespace sim_mob;
 
+namespace
+{
+/** Workers are rebalanced only when the busiest one takes this much longer than the average */
+const double REBALANCE_TOLERANCE = 1.05;
+
+/** Largest fraction of the migratable entities moved by one rebalancing */
+const double MAX_MIGRATED_FRACTION = 0.1;
+}
+
 sim_mob::WorkGroup::WorkGroup(unsigned int wgNum, unsigned int numWorkers, unsigned int numSimTicks, unsigned int tickStep, AuraManager* auraMgr,
         PartitionManager* partitionMgr, PeriodicPersonLoader* periodicLoader, uint32_t simulationStart) :
         wgNum(wgNum), numWorkers(numWorkers), numSimTicks(numSimTicks), tickStep(tickStep), auraMgr(auraMgr), partitionMgr(partitionMgr), tickOffset(0), started(
                 false), currTimeTick(0), nextTimeTick(0), loader(nullptr), nextWorkerID(0), frame_tick_barr(nullptr), buff_flip_barr(nullptr), msg_bus_barr(
-                nullptr), macro_tick_barr(nullptr), profile(nullptr), periodicPersonLoader(periodicLoader), nextLoaderIdx(0), simulationStart(simulationStart)
+                nullptr), macro_tick_barr(nullptr), msg_dispatch_barr(nullptr), rebalanceInterval(0), profile(nullptr), periodicPersonLoader(periodicLoader), nextLoaderIdx(0), simulationStart(simulationStart)
 {
     if (ConfigManager::GetInstance().CMakeConfig().ProfileAuraMgrUpdates())
     {
@@ -65,6 +76,7 @@ sim_mob::WorkGroup::~WorkGroup()  //Be aware that this will hang if Workers are
     //TODO: Find a way to statically delete the other barriers too (low priority; minor amount of memory leakage).
 #ifndef SIMMOB_INTERACTIVE_MODE
     safe_delete_item(macro_tick_barr);
+    safe_delete_item(msg_dispatch_barr);
 #endif
 
     //Clear the ProfileBuilder.
@@ -89,6 +101,22 @@ Worker* WorkGroup::getLeastLoadedWorker(const vector<Worker*>& workers)
     return res;
 }
 
+Worker* WorkGroup::getLeastBusyWorker(const vector<Worker*>& workers)
+{
+    Worker* res = nullptr;
+    double resLoad = 0.0;
+    for (vector<Worker*>::const_iterator it = workers.begin(); it != workers.end(); it++)
+    {
+        const double load = (*it)->getEstimatedLoad();
+        if ((!res) || (load < resLoad))
+        {
+            res = *it;
+            resLoad = load;
+        }
+    }
+    return res;
+}
+
 void sim_mob::WorkGroup::clear()
 {
     for (vector<Worker*>::iterator it = workers.begin(); it != workers.end(); it++)
@@ -103,6 +131,7 @@ void sim_mob::WorkGroup::clear()
     //The only barrier we can delete is the non-shared barrier.
     //TODO: Find a way to statically delete the other barriers too (low priority; minor amount of memory leakage).
     safe_delete_item(macro_tick_barr);
+    safe_delete_item(msg_dispatch_barr);
 }
 
 void sim_mob::WorkGroup::initializeBarriers(FlexiBarrier* frame_tick, FlexiBarrier* buff_flip, FlexiBarrier* aura_mgr)
@@ -178,8 +207,32 @@ void sim_mob::WorkGroup::startAll(bool singleThreaded)
     //Start all workers
     tickOffset = 0; //Always start with an update.
 
+    //Work stealing needs several threads; messages must then be posted, since the receiver of an
+    // instantaneous message could be in the middle of its update on another thread.
+    const ConfigParams& config = ConfigManager::GetInstance().FullConfig();
+    const bool workStealing = config.simulation.workStealing && !singleThreaded && workers.size() > 1;
+
+    //The same goes for entities moved between Workers, whose messages are handled by their first Worker.
+    const bool timeBased = (config.defaultWrkGrpAssignment() == ASSIGN_TIMEBASED);
+    if (timeBased && !singleThreaded && workers.size() > 1)
+    {
+        rebalanceInterval = config.simulation.workGroupRebalanceInterval;
+    }
+    if (rebalanceInterval > 0)
+    {
+        msg_dispatch_barr = new boost::barrier(workers.size());
+    }
+
+    if (workStealing || rebalanceInterval > 0)
+    {
+        messaging::MessageBus::SetInstantaneousDelivery(false);
+    }
+
     for (vector<Worker*>::iterator it = workers.begin(); it != workers.end(); it++)
     {
+        (*it)->workStealing = workStealing;
+        (*it)->measureCosts = timeBased;
+        (*it)->msg_dispatch_barr = msg_dispatch_barr;
         (*it)->start();
     }
 }
@@ -315,6 +368,10 @@ void sim_mob::WorkGroup::assignAWorker(Entity* ag)
     {
         workers.at(nextWorkerID)->scheduleForAddition(ag);
     }
+    else if (strat == ASSIGN_TIMEBASED)
+    {
+        getLeastBusyWorker(workers)->scheduleForAddition(ag);
+    }
     else
     {
         getLeastLoadedWorker(workers)->scheduleForAddition(ag);
@@ -477,6 +534,100 @@ void sim_mob::WorkGroup::waitMacroTimeTick()
     tickOffset--;
 }
 
+void sim_mob::WorkGroup::rebalanceWorkers()
+{
+    if (rebalanceInterval == 0 || tickOffset != 0 || currTimeTick == 0 || (currTimeTick / tickStep) % rebalanceInterval != 0)
+    {
+        return;
+    }
+
+    //Entities which have not been updated yet are assumed to take as long as the average entity.
+    double knownCost = 0.0;
+    size_t numKnown = 0;
+    for (vector<Worker*>::const_iterator wrkr = workers.begin(); wrkr != workers.end(); wrkr++)
+    {
+        for (std::unordered_map<const Entity*, double>::const_iterator it = (*wrkr)->entityCosts.begin(); it != (*wrkr)->entityCosts.end(); it++)
+        {
+            knownCost += it->second;
+            numKnown++;
+        }
+    }
+    const double defaultCost = (numKnown > 0) ? knownCost / numKnown : 1.0;
+
+    //One vertex per entity, weighted by its update time.
+    WorkloadPartitioner partitioner(workers.size());
+    vector<Entity*> entities;
+    std::unordered_map<const Entity*, size_t> vertices;
+    size_t numMigratable = 0;
+    for (size_t wrkrIdx = 0; wrkrIdx < workers.size(); wrkrIdx++)
+    {
+        const Worker* wrkr = workers[wrkrIdx];
+        for (std::set<Entity*>::const_iterator it = wrkr->managedEntities.begin(); it != wrkr->managedEntities.end(); it++)
+        {
+            std::unordered_map<const Entity*, double>::const_iterator cost = wrkr->entityCosts.find(*it);
+            const bool migratable = (*it)->isMigratable();
+            vertices[*it] = partitioner.addVertex((cost != wrkr->entityCosts.end()) ? cost->second : defaultCost, wrkrIdx, migratable);
+            entities.push_back(*it);
+            if (migratable)
+            {
+                numMigratable++;
+            }
+        }
+    }
+    if (numMigratable == 0)
+    {
+        return;
+    }
+
+    vector<Entity*> adjacent;
+    for (size_t vertex = 0; vertex < entities.size(); vertex++)
+    {
+        adjacent.clear();
+        entities[vertex]->getAdjacentEntities(adjacent);
+        for (vector<Entity*>::const_iterator it = adjacent.begin(); it != adjacent.end(); it++)
+        {
+            std::unordered_map<const Entity*, size_t>::const_iterator other = vertices.find(*it);
+            if (other != vertices.end())
+            {
+                partitioner.addEdge(vertex, other->second);
+            }
+        }
+    }
+
+    const double imbalanceBefore = partitioner.getImbalance();
+    const size_t maxMoves = std::max<size_t>(1, numMigratable * MAX_MIGRATED_FRACTION);
+    const size_t numMoves = partitioner.rebalance(REBALANCE_TOLERANCE, maxMoves);
+    if (numMoves == 0)
+    {
+        return;
+    }
+
+    //Move the entities. The Workers are all waiting at the message bus barrier, so nothing else touches them.
+    for (size_t vertex = 0; vertex < entities.size(); vertex++)
+    {
+        Entity* entity = entities[vertex];
+        Worker* from = static_cast<Worker*>(entity->currWorkerProvider);
+        Worker* to = workers[partitioner.getPart(vertex)];
+        if (from != to)
+        {
+            std::unordered_map<const Entity*, double>::const_iterator cost = from->entityCosts.find(entity);
+            const bool measured = (cost != from->entityCosts.end());
+            const double entityCost = measured ? cost->second : 0.0;
+
+            from->migrateOut(*entity);
+            to->migrateIn(*entity);
+            if (measured)
+            {
+                to->entityCosts[entity] = entityCost;
+            }
+        }
+    }
+
+    Print() << "WorkGroup " << wgNum << " rebalanced at tick " << currTimeTick << ": moved " << numMoves << " of "
+            << numMigratable << " entities; imbalance (slowest/average worker) " << imbalanceBefore << " -> "
+            << partitioner.getImbalance() << "\n";
+}
+
 #ifndef SIMMOB_DISABLE_MPI
 
 void sim_mob::WorkGroup::removeAgentFromWorker(Entity* ag)
@@ -42,6 +42,7 @@ class WorkGroup
 {
 private:
     friend class WorkGroupManager;
+    friend class Worker;
 
     /** Private constructor: Use the static newWorkGroup function instead. */
     WorkGroup(unsigned int wgNum, unsigned int numWorkers, unsigned int numSimTicks, unsigned int tickStep, sim_mob::AuraManager* auraMgr,
@@ -56,6 +57,16 @@ private:
      */
     static sim_mob::Worker* getLeastLoadedWorker(const std::vector<sim_mob::Worker*>& workers);
 
+    /**
+     * Helper method; find the worker with the smallest measured update time. Entities not updated yet are
+     * assumed to take as long as the average entity of their worker. O(n) in the number of entities.
+     *
+     * @param workers input set of workers
+     *
+     * @return least busy worker from workers
+     */
+    static sim_mob::Worker* getLeastBusyWorker(const std::vector<sim_mob::Worker*>& workers);
+
 public:
     /**
      * Type of Worker assignment strategy. Determines how a newly-dispatched Agent
@@ -65,7 +76,8 @@ public:
     {
         ASSIGN_ROUNDROBIN,  ///< Assign an Agent to Worker 1, then Worker 2, etc.
         ASSIGN_SMALLEST,    ///< Assign an Agent to the Worker with the smallest number of Agents.
-    //TODO: Something like "ASSIGN_TIMEBASED", based on actual time tick length.
+        ASSIGN_TIMEBASED,   ///< Assign an Agent to the Worker with the smallest update time, and move migratable
+                            ///< Entities between Workers periodically to balance their update times.
     };
 
     /** Entity load/migration parameters */
@@ -238,6 +250,14 @@ private:
      */
     void waitMacroTimeTick();
 
+    /**
+     * moves migratable entities between workers to balance the measured update times of the workers, keeping
+     * adjacent entities on the same worker as far as possible. Does nothing unless the time-based assignment
+     * strategy is used and the rebalancing interval has elapsed.
+     * Must be called while all workers are waiting at the message bus barrier.
+     */
+    void rebalanceWorkers();
+
     /**
      * Initialize our shared (static) barriers. These barriers don't technically need to be copied
      * locally, but we'd rather avoid relying on static variables in case we ever make a WorkGroupGroup (or whatever) class.
@@ -332,6 +352,16 @@ private:
      */
     boost::barrier* macro_tick_barr;
 
+    /**
+     * Barrier of the Workers between their message dispatch and their frame tick; only needed (and created)
+     * when entities may be moved between Workers, as a moved entity still receives its messages on the
+     * thread of the Worker which first managed it.
+     */
+    boost::barrier* msg_dispatch_barr;
+
+    /** Number of ticks between two rebalancings of the workers; 0 if the workers are never rebalanced */
+    unsigned int rebalanceInterval;
+
     /** Profiler */
     sim_mob::ProfileBuilder* profile;
 
@@ -272,6 +272,12 @@ void sim_mob::WorkGroupManager::waitAllGroups_DistributeMessages(std::set<Entity
         PathSetManager::updateCurrTimeInterval();
     }
 
+    //All Workers are waiting at the message bus barrier, so their entities can be moved safely.
+    for (vector<WorkGroup*>::iterator it = registeredWorkGroups.begin(); it != registeredWorkGroups.end(); it++)
+    {
+        (*it)->rebalanceWorkers();
+    }
+
     sim_mob::messaging::MessageBus::DistributeMessages();
 
     //Here is where we actually block, ensuring a tick-wide synchronization.
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <deque>
 
+#include <boost/chrono.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/bind.hpp>
 
@@ -20,6 +21,7 @@
 #include "conf/ConfigParams.hpp"
 #include "entities/Entity.hpp"
 #include "entities/Agent.hpp"
+#include "entities/AuraManager.hpp"
 #include "entities/roles/Role.hpp"
 #include "entities/profile/ProfileBuilder.hpp"
 #include "path/PathSetManager.hpp"
@@ -68,7 +70,8 @@ sim_mob::Worker::Worker(WorkGroup* parent, std::ostream* logFile,  FlexiBarrier*
                         std::vector<Entity*>* entityRemovalList, std::vector<Entity*>* entityBredList, uint32_t endTick, uint32_t tickStep, uint32_t _simulationStartDay)
                        :logFile(logFile), frame_tick_barr(frame_tick), buff_flip_barr(buff_flip), aura_mgr_barr(aura_mgr), macro_tick_barr(macro_tick),
                         endTick(endTick), tickStep(tickStep), parent(parent), entityRemovalList(entityRemovalList), entityBredList(entityBredList),
-                        profile(nullptr),pathSetMgr(nullptr), simulationStartDay(_simulationStartDay)
+                        profile(nullptr),pathSetMgr(nullptr), simulationStartDay(_simulationStartDay), workStealing(false), unfinishedChunks(0),
+                        msg_dispatch_barr(nullptr), measureCosts(false)
 {
     //Initialize our profile builder, if applicable.
     if (ConfigManager::GetInstance().CMakeConfig().ProfileWorkerUpdates()) {
@@ -126,6 +129,7 @@ void sim_mob::Worker::remEntity(Entity* entity)
             managedMultiUpdateEntities.erase(it);
         }
     }
+    entityCosts.erase(entity);
 }
 
 UpdatePublisher & sim_mob::Worker::GetUpdatePublisher()
@@ -329,6 +333,12 @@ void sim_mob::Worker::perform_buff_flip()
 {
     //Flip all data managed by this worker.
     this->flip();
+
+    //Let the aura manager index the new positions of this worker's agents.
+    if (parent->auraMgr && ConfigManager::GetInstance().FullConfig().RunningShortTerm())
+    {
+        parent->auraMgr->updateAgents(managedEntities);
+    }
 }
 
 
@@ -357,6 +367,12 @@ void sim_mob::Worker::threaded_function_loop()
         }
 
         messaging::MessageBus::ThreadDispatchMessages();
+
+        //Entities moved to this Worker may still receive messages on the thread of their previous one.
+        if (msg_dispatch_barr) {
+            msg_dispatch_barr->wait();
+        }
+
         perform_frame_tick();
 
 
@@ -406,6 +422,68 @@ void sim_mob::Worker::threaded_function_loop()
 
 namespace {
 
+///Number of chunks a Worker splits its entities into, when work stealing.
+const size_t CHUNKS_PER_WORKER = 16;
+
+///Weight of the last update in the smoothed update cost of an entity.
+const double COST_SMOOTHING = 0.5;
+
+///Makes the message handlers registered during the update of an entity use the context of that entity, which
+///  differs from the context of the updating thread when the entity was stolen or moved from another Worker.
+struct RegistrationContextScope
+{
+    explicit RegistrationContextScope(const Entity* entity) : active(entity->GetContext() != nullptr)
+    {
+        if (active) {
+            messaging::MessageBus::SetRegistrationContext(entity->GetContext());
+        }
+    }
+
+    ~RegistrationContextScope()
+    {
+        if (active) {
+            messaging::MessageBus::SetRegistrationContext(nullptr);
+        }
+    }
+
+    const bool active;
+};
+
+///Applies the result of an Entity's update to the Worker managing it.
+void processUpdateStatus(Worker& wrk, sim_mob::Entity* entity, const UpdateStatus& res)
+{
+    switch(res.status)
+    {
+        case UpdateStatus::RS_DONE:
+        {
+            //This Entity is done; schedule for deletion.
+            wrk.scheduleForRemoval(entity);
+            break;
+        }
+        case UpdateStatus::RS_CONTINUE:
+        {
+            //Still going, but we may have properties to start/stop managing
+            for (set<BufferedBase*>::const_iterator it = res.toRemove.begin(); it != res.toRemove.end(); it++)
+            {
+                wrk.stopManaging(*it);
+            }
+            for (set<BufferedBase*>::const_iterator it = res.toAdd.begin(); it != res.toAdd.end(); it++)
+            {
+                wrk.beginManaging(*it);
+            }
+            break;
+        }
+        case UpdateStatus::RS_CONTINUE_INCOMPLETE:
+        {
+            break;
+        }
+        default:
+        {
+            throw std::runtime_error("Unknown/unexpected update() return status.");
+        }
+    }
+}
+
 ///This class performs the operator() function on an Entity, and is meant to be used inside of a for_each loop.
 struct EntityUpdater
 {
@@ -428,36 +506,7 @@ struct EntityUpdater
         {
             Worker::GetUpdatePublisher().publish(event::EVT_CORE_AGENT_UPDATED, (void*) event::CXT_CORE_AGENT_UPDATE, UpdateEventArgs(entity));
         }
-        switch(res.status)
-        {
-            case UpdateStatus::RS_DONE:
-            {
-                //This Entity is done; schedule for deletion.
-                wrk.scheduleForRemoval(entity);
-                break;
-            }
-            case UpdateStatus::RS_CONTINUE:
-            {
-                //Still going, but we may have properties to start/stop managing
-                for (set<BufferedBase*>::iterator it = res.toRemove.begin(); it != res.toRemove.end(); it++)
-                {
-                    wrk.stopManaging(*it);
-                }
-                for (set<BufferedBase*>::iterator it = res.toAdd.begin(); it != res.toAdd.end(); it++)
-                {
-                    wrk.beginManaging(*it);
-                }
-                break;
-            }
-            case UpdateStatus::RS_CONTINUE_INCOMPLETE:
-            {
-                break;
-            }
-            default:
-            {
-                throw std::runtime_error("Unknown/unexpected update() return status.");
-            }
-        }
+        processUpdateStatus(wrk, entity, res);
     }
 };
 
@@ -554,9 +603,200 @@ void sim_mob::Worker::migrateIn(Entity& ag)
 //      May want to dig into this a bit more. ~Seth
 void sim_mob::Worker::update_entities(timeslice currTime)
 {
+    if (workStealing) {
+        update_entities_work_stealing(currTime);
+        return;
+    }
+    if (measureCosts) {
+        update_entities_timed(currTime);
+        return;
+    }
     std::for_each(managedEntities.begin(), managedEntities.end(), EntityUpdater(*this, currTime));
 }
 
+void sim_mob::Worker::update_entities_work_stealing(timeslice currTime)
+{
+    publish_chunks();
+
+    //Our own chunks first.
+    EntityChunk chunk;
+    while (pop_chunk(chunk)) {
+        update_chunk(*this, chunk, currTime);
+    }
+
+    //Then help the other Workers, until none has chunks left and those stolen from us are finished.
+    const vector<Worker*>& workers = parent->workers;
+    const size_t self = std::find(workers.begin(), workers.end(), this) - workers.begin();
+    for (;;) {
+        bool stole = false;
+        for (size_t i = 1; i < workers.size() && !stole; i++) {
+            Worker* victim = workers[(self + i) % workers.size()];
+            if (victim->steal_chunk(chunk)) {
+                update_chunk(*victim, chunk, currTime);
+                stole = true;
+            }
+        }
+        if (!stole) {
+            if (unfinishedChunks.load(boost::memory_order_acquire) == 0) {
+                break;
+            }
+            boost::this_thread::yield();
+        }
+    }
+
+    //Apply the results in order. This is done by us alone, since it touches our entities and Buffered<> data.
+    for (size_t i = 0; i < tickEntities.size(); i++) {
+        recordCost(tickEntities[i], tickCosts[i]);
+        processUpdateStatus(*this, tickEntities[i], tickResults[i]);
+    }
+    tickEntities.clear();
+    tickResults.clear();
+    tickCosts.clear();
+}
+
+void sim_mob::Worker::publish_chunks()
+{
+    tickEntities.assign(managedEntities.begin(), managedEntities.end());
+    tickResults.assign(tickEntities.size(), UpdateStatus::Continue);
+    tickCosts.assign(tickEntities.size(), 0.0);
+
+    //Estimate the cost of each update from the previous ones. New entities are assumed to cost as much as the
+    // average known entity.
+    vector<double> estimates(tickEntities.size(), -1.0);
+    double knownCost = 0.0;
+    size_t numKnown = 0;
+    for (size_t i = 0; i < tickEntities.size(); i++) {
+        std::unordered_map<const Entity*, double>::const_iterator it = entityCosts.find(tickEntities[i]);
+        if (it != entityCosts.end()) {
+            estimates[i] = it->second;
+            knownCost += it->second;
+            numKnown++;
+        }
+    }
+    const double defaultCost = (numKnown > 0 && knownCost > 0.0) ? knownCost / numKnown : 1.0;
+    double totalCost = 0.0;
+    for (vector<double>::iterator it = estimates.begin(); it != estimates.end(); it++) {
+        if (*it <= 0.0) {
+            *it = defaultCost;
+        }
+        totalCost += *it;
+    }
+
+    //Consecutive entities are grouped into chunks of about the same cost.
+    const double chunkCost = totalCost / CHUNKS_PER_WORKER;
+    vector<EntityChunk> chunks;
+    EntityChunk chunk = { 0, 0 };
+    double cost = 0.0;
+    for (size_t i = 0; i < estimates.size(); i++) {
+        cost += estimates[i];
+        chunk.end = i + 1;
+        if (cost >= chunkCost) {
+            chunks.push_back(chunk);
+            chunk.begin = chunk.end;
+            cost = 0.0;
+        }
+    }
+    if (chunk.end > chunk.begin) {
+        chunks.push_back(chunk);
+    }
+
+    unfinishedChunks.store(chunks.size(), boost::memory_order_relaxed);
+    boost::mutex::scoped_lock lock(pendingChunksMutex);
+    pendingChunks.assign(chunks.begin(), chunks.end());
+}
+
+bool sim_mob::Worker::pop_chunk(EntityChunk& chunk)
+{
+    boost::mutex::scoped_lock lock(pendingChunksMutex);
+    if (pendingChunks.empty()) {
+        return false;
+    }
+    chunk = pendingChunks.front();
+    pendingChunks.pop_front();
+    return true;
+}
+
+bool sim_mob::Worker::steal_chunk(EntityChunk& chunk)
+{
+    boost::mutex::scoped_lock lock(pendingChunksMutex);
+    if (pendingChunks.empty()) {
+        return false;
+    }
+    chunk = pendingChunks.back();
+    pendingChunks.pop_back();
+    return true;
+}
+
+void sim_mob::Worker::update_chunk(Worker& owner, const EntityChunk& chunk, timeslice currTime)
+{
+    const bool publish = ConfigManager::GetInstance().FullConfig().isWorkerPublisherEnabled();
+    for (size_t i = chunk.begin; i < chunk.end; i++) {
+        Entity* entity = owner.tickEntities[i];
+
+        //While we update a stolen entity, it uses our random number generator, log file, etc.
+        entity->currWorkerProvider = this;
+        {
+            RegistrationContextScope registration(entity);
+            const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+            owner.tickResults[i] = entity->update(currTime);
+            owner.tickCosts[i] = boost::chrono::duration<double, boost::micro>(boost::chrono::steady_clock::now() - start).count();
+        }
+        //Hand the entity, and whatever took our worker provider during its update, back to the owner.
+        entity->resetWorkerProvider(&owner);
+
+        if (publish) {
+            Worker::GetUpdatePublisher().publish(event::EVT_CORE_AGENT_UPDATED, (void*) event::CXT_CORE_AGENT_UPDATE, UpdateEventArgs(entity));
+        }
+    }
+
+    //The owner reads the results once all its chunks are finished.
+    owner.unfinishedChunks.fetch_sub(1, boost::memory_order_release);
+}
+
+void sim_mob::Worker::update_entities_timed(timeslice currTime)
+{
+    const bool publish = ConfigManager::GetInstance().FullConfig().isWorkerPublisherEnabled();
+    for (set<Entity*>::iterator it = managedEntities.begin(); it != managedEntities.end(); it++) {
+        Entity* entity = *it;
+        UpdateStatus res = UpdateStatus::Continue;
+        {
+            RegistrationContextScope registration(entity);
+            const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+            res = entity->update(currTime);
+            recordCost(entity, boost::chrono::duration<double, boost::micro>(boost::chrono::steady_clock::now() - start).count());
+        }
+
+        if (publish) {
+            Worker::GetUpdatePublisher().publish(event::EVT_CORE_AGENT_UPDATED, (void*) event::CXT_CORE_AGENT_UPDATE, UpdateEventArgs(entity));
+        }
+        processUpdateStatus(*this, entity, res);
+    }
+}
+
+void sim_mob::Worker::recordCost(const Entity* entity, double cost)
+{
+    std::pair<std::unordered_map<const Entity*, double>::iterator, bool> res = entityCosts.insert(std::make_pair(entity, cost));
+    if (!res.second) {
+        res.first->second += COST_SMOOTHING * (cost - res.first->second);
+    }
+}
+
+double sim_mob::Worker::getEstimatedLoad() const
+{
+    //Entities not updated yet are assumed to cost as much as the average measured one.
+    double load = 0.0;
+    size_t numKnown = 0;
+    for (set<Entity*>::const_iterator it = managedEntities.begin(); it != managedEntities.end(); it++) {
+        std::unordered_map<const Entity*, double>::const_iterator cost = entityCosts.find(*it);
+        if (cost != entityCosts.end()) {
+            load += cost->second;
+            numKnown++;
+        }
+    }
+    const double defaultCost = numKnown > 0 ? load / numKnown : 1.0;
+    return load + defaultCost * (managedEntities.size() - numKnown + toBeAdded.size());
+}
+
 void sim_mob::Worker::processMultiUpdateEntities(uint32_t currTick)
 {
     const unsigned int msPerFrame = ConfigManager::GetInstance().FullConfig().baseGranMS();
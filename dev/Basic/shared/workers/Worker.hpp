@@ -4,12 +4,16 @@
 
 #pragma once
 
+#include <deque>
 #include <ostream>
 #include <vector>
 #include <set>
+#include <unordered_map>
+#include <boost/atomic.hpp>
 #include <boost/random.hpp>
 #include <boost/thread.hpp>
 #include "buffering/BufferedDataManager.hpp"
+#include "entities/Entity.hpp"
 #include "metrics/Frame.hpp"
 #include "event/EventPublisher.hpp"
 #include "event/SystemEvents.hpp"
@@ -22,7 +26,6 @@ class FlexiBarrier;
 class ProfileBuilder;
 class ControlManager;
 class WorkGroup;
-class Entity;
 class PathSetManager;
 
 //subclassed Eventpublisher coz its destructor is pure virtual
@@ -91,6 +94,21 @@ public:
  *   This will cause them to use no threads or barriers, and to simply be stepped through one-by-one by
  *   their parent WorkGroups.
  *
+ * With work stealing enabled, a Worker splits its entities into chunks of similar cost (as measured over
+ *   the previous ticks) at each frame tick. It updates its own chunks first, then updates the chunks left
+ *   by the other Workers of its WorkGroup. The results of the updates (removals, Buffered<> changes) are
+ *   always applied by the Worker which owns the entity, once all its chunks are done. The message handlers
+ *   registered while a stolen entity is updated (e.g., the persons a Conflux starts) join the message context of
+ *   that entity rather than the context of the stealing thread, so their messages are still dispatched by the
+ *   owner's thread once the stealing Worker moves on. After the update, the stolen entity and the entities which
+ *   took the stealing Worker as their worker provider during it (e.g., the persons of a Conflux) are handed back to
+ *   the owner (see Entity::resetWorkerProvider).
+ *
+ * With the time-based assignment strategy, a Worker measures the duration of each update, and its WorkGroup
+ *   moves entities between Workers every few ticks to even out these durations. The messages of an entity
+ *   (and of the handlers registered while it is updated) keep being handled by the thread of the Worker which
+ *   first registered it, so the Workers then wait for each other after handling their messages.
+ *
  * \author Seth N. Hetu
  * \author LIM Fung Chai
  * \author Xu Yan
@@ -174,6 +192,24 @@ private:
     //Helper functions for various update functionality.
     virtual void update_entities(timeslice currTime);
 
+    ///A range of tickEntities, updated as a whole by this Worker or by a Worker stealing it.
+    struct EntityChunk {
+        size_t begin;
+        size_t end;
+    };
+
+    //Work stealing helpers.
+    void update_entities_work_stealing(timeslice currTime);
+    void publish_chunks();
+    bool pop_chunk(EntityChunk& chunk);
+    bool steal_chunk(EntityChunk& chunk);
+    void update_chunk(Worker& owner, const EntityChunk& chunk, timeslice currTime);
+
+    //Cost measurement helpers.
+    void update_entities_timed(timeslice currTime);
+    void recordCost(const Entity* entity, double cost);
+    double getEstimatedLoad() const;
+
     void migrateOut(Entity& ent);
     void migrateIn(Entity& ent);
 
@@ -193,6 +229,10 @@ protected:
     sim_mob::FlexiBarrier* aura_mgr_barr;
     boost::barrier* macro_tick_barr;
 
+    ///Optional barrier between the message dispatch and the frame tick; set by the WorkGroup when entities may be
+    ///  moved between its Workers.
+    boost::barrier* msg_dispatch_barr;
+
     //Time management
     uint32_t endTick;
     uint32_t tickStep;
@@ -235,6 +275,29 @@ private:
     ///      In other words, managedMultiUpdateEntities is a subset of managedEntities containing only multi-update entities
     std::set<Entity*> managedMultiUpdateEntities;
 
+    ///If true, our entities may be updated by the other Workers of our WorkGroup, and we update theirs
+    ///  once we are done with ours. Set by the WorkGroup.
+    bool workStealing;
+
+    ///The entities updated in the current tick (work stealing), with the result and duration of each update.
+    std::vector<Entity*> tickEntities;
+    std::vector<Entity::UpdateStatus> tickResults;
+    std::vector<double> tickCosts;
+
+    ///Chunks of tickEntities not yet started. We take them from the front; other Workers steal from the back.
+    std::deque<EntityChunk> pendingChunks;
+    boost::mutex pendingChunksMutex;
+
+    ///Number of our chunks not yet finished, including those being updated by other Workers.
+    boost::atomic<size_t> unfinishedChunks;
+
+    ///If true, the duration of each update is recorded in entityCosts even without work stealing. Set by the WorkGroup.
+    bool measureCosts;
+
+    ///Smoothed duration (in microseconds) of the recent updates of each entity; used to size the chunks and
+    ///  to balance the load of the Workers.
+    std::unordered_map<const Entity*, double> entityCosts;
+
     ///If non-null, used for profiling.
     sim_mob::ProfileBuilder* profile;
     //int thread_id;
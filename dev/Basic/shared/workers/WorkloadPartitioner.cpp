@@ -0,0 +1,150 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "WorkloadPartitioner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using std::vector;
+
+using namespace sim_mob;
+
+WorkloadPartitioner::WorkloadPartitioner(size_t numParts) : loads(numParts, 0.0)
+{
+    if (numParts == 0)
+    {
+        throw std::runtime_error("WorkloadPartitioner needs at least one part");
+    }
+}
+
+size_t WorkloadPartitioner::addVertex(double cost, size_t part, bool movable)
+{
+    if (part >= loads.size())
+    {
+        throw std::runtime_error("WorkloadPartitioner: invalid part for vertex");
+    }
+
+    costs.push_back(cost);
+    parts.push_back(part);
+    this->movable.push_back(movable);
+    neighbours.push_back(vector<size_t>());
+    loads[part] += cost;
+    return costs.size() - 1;
+}
+
+void WorkloadPartitioner::addEdge(size_t first, size_t second)
+{
+    if (first >= costs.size() || second >= costs.size())
+    {
+        throw std::runtime_error("WorkloadPartitioner: invalid vertex for edge");
+    }
+    if (first != second)
+    {
+        neighbours[first].push_back(second);
+        neighbours[second].push_back(first);
+    }
+}
+
+size_t WorkloadPartitioner::countNeighboursIn(size_t vertex, size_t part) const
+{
+    size_t count = 0;
+    for (vector<size_t>::const_iterator it = neighbours[vertex].begin(); it != neighbours[vertex].end(); it++)
+    {
+        if (parts[*it] == part)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t WorkloadPartitioner::rebalance(double tolerance, size_t maxMoves)
+{
+    vector<bool> moved(costs.size(), false);
+    size_t numMoves = 0;
+
+    while (numMoves < maxMoves)
+    {
+        const size_t heaviest = std::max_element(loads.begin(), loads.end()) - loads.begin();
+        const size_t lightest = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        if (loads[heaviest] <= 0.0 || getImbalance() <= tolerance)
+        {
+            break;
+        }
+
+        //Pick the move keeping most neighbours together, then the one evening out the two parts best.
+        //Only moves that leave both parts lighter than the heaviest part was are considered.
+        size_t bestVertex = costs.size();
+        size_t bestPart = 0;
+        long bestGain = std::numeric_limits<long>::min();
+        double bestResidual = std::numeric_limits<double>::max();
+        vector<size_t> candidates;
+        for (size_t vertex = 0; vertex < costs.size(); vertex++)
+        {
+            if (parts[vertex] != heaviest || !movable[vertex] || moved[vertex] || costs[vertex] <= 0.0)
+            {
+                continue;
+            }
+
+            candidates.clear();
+            for (vector<size_t>::const_iterator it = neighbours[vertex].begin(); it != neighbours[vertex].end(); it++)
+            {
+                if (parts[*it] != heaviest)
+                {
+                    candidates.push_back(parts[*it]);
+                }
+            }
+            candidates.push_back(lightest);
+
+            const long kept = countNeighboursIn(vertex, heaviest);
+            for (vector<size_t>::const_iterator it = candidates.begin(); it != candidates.end(); it++)
+            {
+                if (loads[*it] + costs[vertex] >= loads[heaviest])
+                {
+                    continue;
+                }
+
+                const long gain = static_cast<long>(countNeighboursIn(vertex, *it)) - kept;
+                const double residual = std::fabs(loads[heaviest] - loads[*it] - 2 * costs[vertex]);
+                if (gain > bestGain || (gain == bestGain && residual < bestResidual))
+                {
+                    bestVertex = vertex;
+                    bestPart = *it;
+                    bestGain = gain;
+                    bestResidual = residual;
+                }
+            }
+        }
+
+        if (bestVertex == costs.size())
+        {
+            break;
+        }
+
+        loads[heaviest] -= costs[bestVertex];
+        loads[bestPart] += costs[bestVertex];
+        parts[bestVertex] = bestPart;
+        moved[bestVertex] = true;
+        numMoves++;
+    }
+
+    return numMoves;
+}
+
+double WorkloadPartitioner::getImbalance() const
+{
+    double total = 0.0;
+    for (vector<double>::const_iterator it = loads.begin(); it != loads.end(); it++)
+    {
+        total += *it;
+    }
+    if (total <= 0.0)
+    {
+        return 1.0;
+    }
+    return *std::max_element(loads.begin(), loads.end()) * loads.size() / total;
+}
@@ -0,0 +1,77 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace sim_mob
+{
+
+/**
+ * Balances the load of a set of parts (Workers) by moving weighted vertices (entities) between them, while
+ * keeping adjacent vertices in the same part as far as possible.
+ *
+ * Starting from the current assignment, the heaviest part repeatedly gives one of its vertices to a lighter part.
+ * The move cutting the fewest edges is preferred: vertices on the boundary of the part go to a part holding their
+ * neighbours, so that the parts stay connected regions of the graph, and a vertex is sent to the lightest part only
+ * when no better move remains. Each vertex is moved at most once per call to rebalance().
+ */
+class WorkloadPartitioner
+{
+public:
+    explicit WorkloadPartitioner(size_t numParts);
+
+    /**
+     * Adds a vertex.
+     *
+     * @param cost load of the vertex
+     * @param part part currently holding the vertex
+     * @param movable false if the vertex must stay in its part
+     *
+     * @return index of the vertex
+     */
+    size_t addVertex(double cost, size_t part, bool movable);
+
+    /**
+     * Adds an undirected edge between two vertices.
+     */
+    void addEdge(size_t first, size_t second);
+
+    /**
+     * Moves vertices until the load of the heaviest part is at most tolerance times the mean load, no move reduces
+     * it any further, or maxMoves vertices have been moved.
+     *
+     * @return the number of vertices moved
+     */
+    size_t rebalance(double tolerance, size_t maxMoves);
+
+    size_t getPart(size_t vertex) const
+    {
+        return parts[vertex];
+    }
+
+    const std::vector<double>& getLoads() const
+    {
+        return loads;
+    }
+
+    /**
+     * @return the load of the heaviest part divided by the mean load (1 when perfectly balanced)
+     */
+    double getImbalance() const;
+
+private:
+    /** Number of neighbours of vertex in part. */
+    size_t countNeighboursIn(size_t vertex, size_t part) const;
+
+    std::vector<double> costs;
+    std::vector<size_t> parts;
+    std::vector<bool> movable;
+    std::vector<std::vector<size_t> > neighbours;
+    std::vector<double> loads;
+};
+
+}
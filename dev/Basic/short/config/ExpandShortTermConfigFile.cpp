@@ -13,6 +13,7 @@
 #include "geospatial/streetdir/StreetDirectory.hpp"
 #include "partitions/PartitionManager.hpp"
 #include "path/PT_PathSetManager.hpp"
+#include "spatial_trees/LaneVehicleIndex.hpp"
 #include "util/Utils.hpp"
 #include "geospatial/streetdir/KShortestPathImpl.hpp"
 #include <entities/FleetController_ST.hpp>
@@ -331,6 +332,24 @@ void ExpandShortTermConfigFile::processConfig()
         }
     }   
 
+    //The drivers find the drivers around them with the aura manager, unless "lanes" or "validate" is given
+    std::map<std::string, std::string>::iterator itLookup = stConfig.genericProps.find("nearby_driver_lookup");
+    if (itLookup != stConfig.genericProps.end() && itLookup->second != "aura")
+    {
+        if (itLookup->second == "lanes")
+        {
+            LaneVehicleIndex::createInstance(*(RoadNetwork::getInstance()), LaneVehicleIndex::LOOKUP_LANES);
+        }
+        else if (itLookup->second == "validate")
+        {
+            LaneVehicleIndex::createInstance(*(RoadNetwork::getInstance()), LaneVehicleIndex::LOOKUP_VALIDATE);
+        }
+        else
+        {
+            throw std::runtime_error("Invalid value for nearby_driver_lookup: " + itLookup->second + " (expected aura, lanes or validate)");
+        }
+    }
+
     if (cfg.PathSetMode() && cfg.getPathSetConf().privatePathSetMode == "generation")
     {
         Profiler profile("bulk profiler start", true);
@@ -750,6 +769,9 @@ void ExpandShortTermConfigFile::printSettings()
     case WorkGroup::ASSIGN_SMALLEST:
         std::cout << "smallest" << std::endl;
         break;
+    case WorkGroup::ASSIGN_TIMEBASED:
+        std::cout << "timebased (rebalanced every " << cfg.simulation.workGroupRebalanceInterval << " ticks)" << std::endl;
+        break;
     default:
         std::cout << "<unknown>" << std::endl;
         break;
@@ -383,11 +383,15 @@ void ParseShortTermConfigFile::processAuraManagerImpNode(DOMElement *node)
         {
             stCfg.auraManagerImplementation = AuraManager::IMPL_SIMTREE;
         }
+        else if (value == "grid")
+        {
+            stCfg.auraManagerImplementation = AuraManager::IMPL_GRID;
+        }
         else
         {
             stringstream msg;
             msg << "Invalid value for <aura_manager_impl value=\""
-                << value << "\">. Expected: \"packing-tree\" or \"rstar\" or \"rdu\" or \"simtree\"";
+                << value << "\">. Expected: \"packing-tree\" or \"rstar\" or \"rdu\" or \"simtree\" or \"grid\"";
             throw runtime_error(msg.str());
         }
     }
@@ -32,6 +32,8 @@
 #include "IncidentPerformer.hpp"
 #include "network/CommunicationDataManager.hpp"
 #include "path/PathSetManager.hpp"
+#include "spatial_trees/LaneVehicleIndex.hpp"
+#include "spatial_trees/shared_funcs.hpp"
 #include "util/Utils.hpp"
 
 using namespace sim_mob;
@@ -51,6 +53,16 @@ const double KILOMETER_TO_METER_CONVERT_UNIT = 1000.0;
 const double HOUR_TO_SEC_CONVERT_UNIT = 3600.0;
 const double KILOMETER_PER_HOUR_TO_METER_PER_SEC = 3.6;
 const double DEFAULT_DIS_TO_STOP = 1000;
+
+/**The nearest vehicles derived from the nearby agents*/
+NearestVehicle DriverUpdateParams::* const NEAREST_VEHICLES[] = {
+    &DriverUpdateParams::nvFwd, &DriverUpdateParams::nvLeftFwd, &DriverUpdateParams::nvRightFwd,
+    &DriverUpdateParams::nvBack, &DriverUpdateParams::nvLeftBack, &DriverUpdateParams::nvRightBack,
+    &DriverUpdateParams::nvLeftFwd2, &DriverUpdateParams::nvLeftBack2, &DriverUpdateParams::nvRightFwd2,
+    &DriverUpdateParams::nvRightBack2, &DriverUpdateParams::nvFwdNextLink, &DriverUpdateParams::nvLagFreeway,
+    &DriverUpdateParams::nvLeadFreeway
+};
+const size_t NUM_NEAREST_VEHICLES = sizeof(NEAREST_VEHICLES) / sizeof(NEAREST_VEHICLES[0]);
 }
 
 map<const RoadSegment *, unsigned long> DriverMovement::rdSegDensityMap;
@@ -150,6 +162,11 @@ void DriverMovement::frame_tick()
             parentDriver->getParent()->setToBeRemoved();
 
         }
+        else
+        {
+            //The on-call driver stays where it is
+            addToLaneVehicleIndex(parentDriver->getCurrLane(), parentDriver->getParent()->xPos.get(), parentDriver->getParent()->yPos.get());
+        }
         return;
     }
     identifyAdjacentLanes(params);
@@ -221,6 +238,7 @@ void DriverMovement::frame_tick()
 
     setParentBufferedData();
     parentDriver->isVehiclePositionDefined = true;
+    addToLaneVehicleIndex(fwdDriverMovement.getCurrLane(), static_cast<int>(position.getX()), static_cast<int>(position.getY()));
 
     //Clear the NearestVehicles list in the conflictTurnings
     params.conflictVehicles.clear();
@@ -945,6 +963,16 @@ void DriverMovement::setParentBufferedData()
     parentDriver->getParent()->yPos.set(parentDriver->getCurrPosition().getY());
 }
 
+void DriverMovement::addToLaneVehicleIndex(const Lane *lane, int x, int y)
+{
+    LaneVehicleIndex *laneIndex = LaneVehicleIndex::getInstance();
+    
+    if (laneIndex && lane)
+    {
+        laneIndex->add(lane, parentDriver->getParent(), x, y, parentDriver->getParams().now.frame());
+    }
+}
+
 std::vector<WayPoint> DriverMovement::buildPath(std::vector<WayPoint> &wayPoints)
 {
     //Path containing only links
@@ -2105,16 +2133,27 @@ double DriverMovement::getAngle() const
 
 void DriverMovement::updateNearbyAgents()
 {
-    DriverUpdateParams& params = parentDriver->getParams();
     vector<const Agent *> nearbyAgentsList;
 
     if (parentDriver->getCurrPosition().getX() > 0 && parentDriver->getCurrPosition().getY() > 0)
     {
         //Retrieve a list of nearby agents
+        LaneVehicleIndex *laneIndex = LaneVehicleIndex::getInstance();
         
+        if (laneIndex && canUseLaneVehicleIndex())
+        {
+            //All the drivers which can be nearby drivers are on the lanes of this segment or of the adjacent segments
+            getNearbyAgentsOnLanes(*laneIndex, nearbyAgentsList);
+
+            if (laneIndex->getMode() == LaneVehicleIndex::LOOKUP_VALIDATE)
+            {
+                validateNearbyAgentsOnLanes(*laneIndex, nearbyAgentsList);
+                return;
+            }
+        }
         //Depending on whether we are on a turning or a lane, send the way-point with the corresponding object to 
         //th aura manager
-        if(fwdDriverMovement.isInIntersection())
+        else if(fwdDriverMovement.isInIntersection())
         {
             nearbyAgentsList = AuraManager::instance().nearbyAgents(parentDriver->getCurrPosition(), WayPoint(fwdDriverMovement.getCurrTurning()),
                                                                     distanceInFront, distanceBehind, parentDriver->getParent());
@@ -2132,22 +2171,20 @@ void DriverMovement::updateNearbyAgents()
                 << parentDriver->getCurrPosition().getY() << std::endl;
     }
 
+    updateNearestVehicles(nearbyAgentsList);
+}
+
+void DriverMovement::updateNearestVehicles(const vector<const Agent *> &nearbyAgentsList)
+{
+    DriverUpdateParams& params = parentDriver->getParams();
+
     //Update each nearby Pedestrian/Driver
-    params.nvFwd.reset();
-    params.nvLeftFwd.reset();
-    params.nvRightFwd.reset();
-    params.nvBack.reset();
-    params.nvLeftBack.reset();
-    params.nvRightBack.reset();
-    params.nvLeftFwd2.reset();
-    params.nvLeftBack2.reset();
-    params.nvRightFwd2.reset();
-    params.nvRightBack2.reset();
-    params.nvFwdNextLink.reset();
-    params.nvLagFreeway.reset();
-    params.nvLeadFreeway.reset();
-
-    for (vector<const Agent *>::iterator it = nearbyAgentsList.begin(); it != nearbyAgentsList.end(); ++it)
+    for (size_t i = 0; i < NUM_NEAREST_VEHICLES; ++i)
+    {
+        (params.*NEAREST_VEHICLES[i]).reset();
+    }
+
+    for (vector<const Agent *>::const_iterator it = nearbyAgentsList.begin(); it != nearbyAgentsList.end(); ++it)
     {
         //Perform no action on non-Persons
         const Person_ST *nearbyAgent = dynamic_cast<const Person_ST *> (*it);
@@ -2171,6 +2208,97 @@ void DriverMovement::updateNearbyAgents()
     }
 }
 
+bool DriverMovement::canUseLaneVehicleIndex() const
+{
+    //In or approaching an intersection, the drivers on the turnings and on the other links matter too
+    if (fwdDriverMovement.isInIntersection() || !fwdDriverMovement.getCurrLane() || parentDriver->expectedTurning_.get())
+    {
+        return false;
+    }
+
+    //On the first segment of a link, the drivers approaching the upstream intersection matter too
+    const unsigned int currSeqNum = fwdDriverMovement.getCurrSegment()->getSequenceNumber();
+    const vector<RoadSegment *> &segments = fwdDriverMovement.getCurrLink()->getRoadSegments();
+    
+    for (vector<RoadSegment *>::const_iterator itSeg = segments.begin(); itSeg != segments.end(); ++itSeg)
+    {
+        if ((*itSeg)->getSequenceNumber() < currSeqNum)
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+void DriverMovement::getNearbyAgentsOnLanes(const LaneVehicleIndex &laneIndex, vector<const Agent *> &nearbyAgents) const
+{
+    //Only keep the drivers the aura manager would find, so that the nearest vehicles are the same
+    Point lowerLeft, upperRight;
+    spatial::getNearbyAgentsRect(parentDriver->getCurrPosition(), WayPoint(fwdDriverMovement.getCurrLane()), distanceInFront, distanceBehind,
+                                 lowerLeft, upperRight);
+
+    const uint32_t frame = parentDriver->getParams().now.frame();
+    const unsigned int currSeqNum = fwdDriverMovement.getCurrSegment()->getSequenceNumber();
+    const vector<RoadSegment *> &segments = fwdDriverMovement.getCurrLink()->getRoadSegments();
+    
+    for (vector<RoadSegment *>::const_iterator itSeg = segments.begin(); itSeg != segments.end(); ++itSeg)
+    {
+        const unsigned int seqNum = (*itSeg)->getSequenceNumber();
+        
+        if (seqNum + 1 >= currSeqNum && seqNum <= currSeqNum + 1)
+        {
+            const vector<const Lane *> &lanes = (*itSeg)->getLanes();
+            
+            for (vector<const Lane *>::const_iterator itLane = lanes.begin(); itLane != lanes.end(); ++itLane)
+            {
+                laneIndex.findInRect(*itLane, frame, lowerLeft, upperRight, nearbyAgents);
+            }
+        }
+    }
+}
+
+void DriverMovement::validateNearbyAgentsOnLanes(LaneVehicleIndex &laneIndex, const vector<const Agent *> &agentsOnLanes)
+{
+    DriverUpdateParams &params = parentDriver->getParams();
+    const double density = params.density;
+
+    updateNearestVehicles(agentsOnLanes);
+    
+    //NearestVehicle only declares a copy constructor, so it is copied by construction rather than assignment
+    vector<NearestVehicle> nearestOnLanes;
+    nearestOnLanes.reserve(NUM_NEAREST_VEHICLES);
+    for (size_t i = 0; i < NUM_NEAREST_VEHICLES; ++i)
+    {
+        nearestOnLanes.push_back(NearestVehicle(params.*NEAREST_VEHICLES[i]));
+    }
+    const double densityOnLanes = params.density;
+    params.density = density;
+
+    updateNearestVehicles(AuraManager::instance().nearbyAgents(parentDriver->getCurrPosition(), WayPoint(fwdDriverMovement.getCurrLane()),
+                                                               distanceInFront, distanceBehind, parentDriver->getParent()));
+
+    //Nearby drivers at the same distance may be picked in a different order, so only the distances are compared
+    bool identical = (densityOnLanes == params.density);
+    for (size_t i = 0; i < NUM_NEAREST_VEHICLES; ++i)
+    {
+        const NearestVehicle &nearestByAura = params.*NEAREST_VEHICLES[i];
+        
+        if (nearestOnLanes[i].exists() != nearestByAura.exists() || nearestOnLanes[i].distance != nearestByAura.distance)
+        {
+            identical = false;
+        }
+    }
+
+    if (!identical)
+    {
+        Warn() << "LaneVehicleIndex: driver " << parentDriver->getParent()->getId() << " has different nearby drivers than with the aura manager at frame "
+                << params.now.frame() << std::endl;
+    }
+    
+    laneIndex.countValidation(identical);
+}
+
 void DriverMovement::perceivedDataProcess(NearestVehicle &nearestVehicle, DriverUpdateParams &params)
 {
     //Update your perceptions for leading vehicle and gap
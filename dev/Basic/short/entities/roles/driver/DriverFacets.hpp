@@ -42,6 +42,7 @@ const static int maxVisibleDis = 100;
 namespace sim_mob
 {
 class CarFollowingModel;
+class LaneVehicleIndex;
 class VehicleLoadingModel;
 
 class DriverBehavior : public BehaviorFacet
@@ -211,6 +212,40 @@ private:
      */
     void updateTrafficSensor(double oldPos, double newPos, double speed, double acceleration);
 
+    /**
+     * Checks whether all the drivers which can be nearby drivers are on the lanes of the current segment and of the
+     * segments before and after it, i.e. if we are neither in nor approaching an intersection, and not on the first
+     * segment of the link
+     *
+     * @return true if the nearby drivers can be found in the LaneVehicleIndex
+     */
+    bool canUseLaneVehicleIndex() const;
+
+    /**
+     * Retrieves the drivers on the lanes of the current segment and of the segments before and after it, which are
+     * in the rectangle the aura manager would search
+     *
+     * @param laneIndex the index of the drivers on each lane
+     * @param nearbyAgents the drivers found are added to it
+     */
+    void getNearbyAgentsOnLanes(const LaneVehicleIndex &laneIndex, std::vector<const Agent *> &nearbyAgents) const;
+
+    /**
+     * Resets the nearest vehicles and derives them from the given nearby agents
+     *
+     * @param nearbyAgents the nearby agents
+     */
+    void updateNearestVehicles(const std::vector<const Agent *> &nearbyAgents);
+
+    /**
+     * Derives the nearest vehicles from the agents found in the LaneVehicleIndex and from those found by the
+     * aura manager, and reports any difference. The results of the aura manager are kept.
+     *
+     * @param laneIndex the index of the drivers on each lane
+     * @param agentsOnLanes the agents found in the LaneVehicleIndex
+     */
+    void validateNearbyAgentsOnLanes(LaneVehicleIndex &laneIndex, const std::vector<const Agent *> &agentsOnLanes);
+
 protected:
     /**Pointer to the lane changing model being used*/
     LaneChangingModel *lcModel;
@@ -322,6 +357,16 @@ protected:
      */
     void perceivedDataProcess(NearestVehicle &nearestVehicle, DriverUpdateParams &params);
 
+    /**
+     * Adds the driver to the LaneVehicleIndex (if it is used), so that it can be found by the drivers around it in
+     * the next tick
+     *
+     * @param lane the lane of the driver in the next tick
+     * @param x the position of the driver in the next tick
+     * @param y the position of the driver in the next tick
+     */
+    void addToLaneVehicleIndex(const Lane *lane, int x, int y);
+
     /**
      * Returns the angle (orientation) of the vehicle. Used for displaying on the visualiser only
      * @return
@@ -0,0 +1,347 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "DriverParameterRegistry.hpp"
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "config/params/ParameterManager.hpp"
+#include "util/Utils.hpp"
+
+using namespace sim_mob;
+using std::string;
+using std::vector;
+
+namespace
+{
+/**The name of the driving models in the driver parameters XML file*/
+const string MODEL_NAME = "general_driver_model";
+
+/**Split delimiter in the driver parameters XML file*/
+const string SPLIT_DELIMITER = " ,";
+
+/**
+ * Converts a list of numbers separated by spaces or commas
+ *
+ * @param str the list of numbers
+ * @param caller the name of the function reading the list, for the error message
+ *
+ * @return the numbers
+ */
+vector<double> parseDoubles(string str, const char *caller)
+{
+    vector<string> arrayStr;
+    vector<double> values;
+
+    boost::trim(str);
+    boost::split(arrayStr, str, boost::is_any_of(SPLIT_DELIMITER), boost::token_compress_on);
+
+    for (size_t i = 0; i < arrayStr.size(); ++i)
+    {
+        try
+        {
+            values.push_back(boost::lexical_cast<double>(arrayStr[i].c_str()));
+        }
+        catch (boost::bad_lexical_cast&)
+        {
+            std::stringstream msg;
+            msg << caller << ": Cannot convert " << str << " to type double";
+            throw std::runtime_error(msg.str());
+        }
+    }
+
+    return values;
+}
+
+/**Reads the parameter with the given name and converts it with Utils::convertStringToArray*/
+vector<double> readArray(const ParameterManager &parameterMgr, const string &paramName, const string &defaultVal)
+{
+    string str;
+    vector<double> values;
+    parameterMgr.param(MODEL_NAME, paramName, str, defaultVal);
+    Utils::convertStringToArray(str, values);
+    return values;
+}
+
+/**Reads the parameter with the given name and converts it with parseDoubles*/
+vector<double> readScale(const ParameterManager &parameterMgr, const string &paramName, const string &defaultVal)
+{
+    string str;
+    parameterMgr.param(MODEL_NAME, paramName, str, defaultVal);
+    return parseDoubles(str, __func__);
+}
+
+void createCF_Params(const vector<double> &values, MITSIM_CF_Parameters::CarFollowingParams &cfParams)
+{
+    cfParams.alpha = values[0];
+    cfParams.beta = values[1];
+    cfParams.gama = values[2];
+    cfParams.lambda = values[3];
+    cfParams.rho = values[4];
+    cfParams.stddev = values[5];
+}
+
+void createUpdateSizeParams(const vector<double> &values, MITSIM_CF_Parameters::UpdateStepSizeParam &stepSizeParams)
+{
+    stepSizeParams.mean = values[0];
+    stepSizeParams.stdev = values[1];
+    stepSizeParams.lower = values[2];
+    stepSizeParams.upper = values[3];
+    stepSizeParams.perception = values[4];
+}
+
+void createSpeedIndices(VehicleBase::VehicleType vhType, const string &speedScalerStr, const string &cstr, SpeedTable &table)
+{
+    //For example
+    //speedScalerStr "5 20 20" ft/sec
+    //maxAccStr      "10.00  7.90  5.60  4.00  4.00" ft/(s^2)
+    vector<double> speedScalerArrayDouble = parseDoubles(speedScalerStr, __func__);
+    vector<double> cArrayDouble = parseDoubles(cstr, __func__);
+
+    table.upperBound = round(speedScalerArrayDouble[1] * (speedScalerArrayDouble[0] - 1));
+
+    vector<double> &cIdx = table.values[vhType];
+    cIdx.clear();
+
+    for (int speed = 0; speed <= table.upperBound; ++speed)
+    {
+        // Convert speed value to a table index.
+        int j = speed / speedScalerArrayDouble[1];
+
+        if (j >= (speedScalerArrayDouble[0] - 1))
+        {
+            cIdx.push_back(cArrayDouble[speedScalerArrayDouble[0] - 1]);
+        }
+        else
+        {
+            cIdx.push_back(cArrayDouble[j]);
+        }
+    }
+}
+}
+
+boost::scoped_ptr<const DriverParameters> DriverParameterRegistry::driverParameters[2];
+boost::once_flag DriverParameterRegistry::parametersLoaded[2] = { BOOST_ONCE_INIT, BOOST_ONCE_INIT };
+
+SpeedTable::SpeedTable() : upperBound(0)
+{
+}
+
+double SpeedTable::get(VehicleBase::VehicleType vhType, int speed) const
+{
+    if (speed < 0)
+    {
+        speed = 0;
+    }
+
+    if (speed > upperBound)
+    {
+        speed = upperBound;
+    }
+
+    const vector<double> &table = values[vhType];
+    return (static_cast<size_t>(speed) < table.size()) ? table[speed] : 0;
+}
+
+MITSIM_IntDriving_Parameters::MITSIM_IntDriving_Parameters() :
+intersectionAttentivenessFactorMin(0), intersectionAttentivenessFactorMax(0), minimumGap(0), impatienceFactor(0)
+{
+    criticalGapAddOn[0] = criticalGapAddOn[1] = 0;
+}
+
+const DriverParameters& DriverParameterRegistry::getParameters(bool isAMOD)
+{
+    //If reading the parameters throws, the flag is left unset and the next call reads them again
+    boost::call_once(parametersLoaded[isAMOD ? 1 : 0], boost::bind(&DriverParameterRegistry::loadParameters, isAMOD));
+    return *driverParameters[isAMOD ? 1 : 0];
+}
+
+void DriverParameterRegistry::loadParameters(bool isAMOD)
+{
+    //Get the parameter manager instance for the respective type of vehicle (normal or AMOD)
+    DriverParameters newParameters;
+    readParameters(*ParameterManager::Instance(isAMOD), newParameters);
+    driverParameters[isAMOD ? 1 : 0].reset(new DriverParameters(newParameters));
+}
+
+void DriverParameterRegistry::readParameters(const ParameterManager &parameterMgr, DriverParameters &parameters)
+{
+    readCarFollowingParameters(parameterMgr, parameters.carFollowing);
+    readLaneChangingParameters(parameterMgr, parameters.laneChanging);
+    readIntersectionDrivingParameters(parameterMgr, parameters.intersectionDriving);
+    readVehicleLoadingParameters(parameterMgr, parameters.vehicleLoading);
+}
+
+void DriverParameterRegistry::readCarFollowingParameters(const ParameterManager &parameterMgr, MITSIM_CF_Parameters &parameters)
+{
+    string speedScalarStr, str;
+
+    parameterMgr.param(MODEL_NAME, "speed_scaler", speedScalarStr, string("5 20 20"));
+    parameterMgr.param(MODEL_NAME, "max_acc_car1", str, string("10.00  7.90  5.60  4.00  4.00"));
+    createSpeedIndices(VehicleBase::CAR, speedScalarStr, str, parameters.maxAccelerationIndex);
+
+    parameters.maxAccelerationScale = readScale(parameterMgr, "max_acceleration_scale", "0.6 0.7 0.8 0.9 1.0 1.1 1.2 1.3 1.4 1.5");
+
+    parameterMgr.param(MODEL_NAME, "normal_deceleration_car1", str, string("7.8     6.7     4.8     4.8     4.8"));
+    createSpeedIndices(VehicleBase::CAR, speedScalarStr, str, parameters.normalDecelerationIndex);
+
+    //The normal deceleration scale has always been created from the max acceleration scale
+    parameterMgr.param(MODEL_NAME, "normal_deceleration_scale", str, string("1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0"));
+    parameters.normalDecelerationScale = parameters.maxAccelerationScale;
+
+    parameters.speedLimitAddon = readScale(parameterMgr, "speed_limit_add_on",
+                                           "-0.1911 -0.0708 -0.0082 0.0397 0.0810 0.1248 0.1661 0.2180 0.2745 0.3657");
+
+    parameters.accelerationAddon = readArray(parameterMgr, "Car_following_acceleration_add_on",
+                                             "-1.3564 -0.8547 -0.5562 -0.3178 -0.1036 0.1036 0.3178 0.5562 0.8547 1.3564");
+
+    parameters.decelerationAddon = readArray(parameterMgr, "Car_following_deceleration_add_on",
+                                             "-1.3187 -0.8309 -0.5407 -0.3089 -0.1007 0.1007 0.3089 0.5407 0.8309 1.3187");
+
+    parameterMgr.param(MODEL_NAME, "max_deceleration_car1", str, string("-16.0   -14.5   -13.0   -11.0   -9.0"));
+    createSpeedIndices(VehicleBase::CAR, speedScalarStr, str, parameters.maxDecelerationIndex);
+
+    parameters.maxDecelerationScale = readScale(parameterMgr, "max_deceleration_scale", "1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0");
+
+    parameterMgr.param(MODEL_NAME, "acceleration_grade_factor", parameters.accGradeFactor, 0.305);
+    parameterMgr.param(MODEL_NAME, "tmp_all_grades", parameters.allGrades, 0.0);
+
+    parameterMgr.param(MODEL_NAME, "min_speed", parameters.minSpeed, 0.1);
+    parameterMgr.param(MODEL_NAME, "min_response_distance", parameters.minResponseDistance, 5.0);
+
+    parameterMgr.param(MODEL_NAME, "yellow_stop_headway", parameters.maxYellowLightHeadway, 1.0);
+    parameterMgr.param(MODEL_NAME, "min_speed_yellow", parameters.minYellowLightSpeed, 2.2352);
+
+    parameterMgr.param(MODEL_NAME, "hbuffer_lower", parameters.hBufferLower, 0.8);
+    parameters.hBufferUpperScale = readScale(parameterMgr, "hbuffer_Upper",
+                                             "1.7498 2.2737 2.5871 2.8379 3.0633 3.2814 3.5068 3.7578 4.0718 4.5979");
+
+    createCF_Params(readScale(parameterMgr, "CF_parameters_1", "0.0400, 0.7220, 0.2420, 0.6820, 0.6000, 0.8250"), parameters.CF_parameters[0]);
+    createCF_Params(readScale(parameterMgr, "CF_parameters_2", "-0.0418 0.0000 0.1510 0.6840 0.6800 0.8020"), parameters.CF_parameters[1]);
+
+    parameters.targetGapAccParm = readScale(parameterMgr, "target_gap_acc_parm",
+                                            "0.604, 0.385, 0.323, 0.0678, 0.217,0.583, -0.596, -0.219, 0.0832, -0.170, 1.478, 0.131, 0.300");
+
+    createUpdateSizeParams(readScale(parameterMgr, "dec_update_step_size", "0.5 0.0 0.5 0.5 0.5"), parameters.decUpdateStepSize);
+
+    parameterMgr.param(MODEL_NAME, "speed_factor", parameters.speedFactor, 1.0);
+
+    createUpdateSizeParams(readScale(parameterMgr, "acc_update_step_size", "1.0 0.0 1.0 1.0 0.5"), parameters.accUpdateStepSize);
+    createUpdateSizeParams(readScale(parameterMgr, "uniform_speed_update_step_size", "1.0 0.0 1.0 1.0 0.5"), parameters.uniformSpeedUpdateStepSize);
+    createUpdateSizeParams(readScale(parameterMgr, "stopped_vehicle_update_step_size", "0.5 0.0 0.5 0.5 0.5"), parameters.stoppedUpdateStepSize);
+
+    parameterMgr.param(MODEL_NAME, "visibility_distance", parameters.visibilityDistance, 10.0);
+
+    parameterMgr.param(MODEL_NAME, "FF_Acc_Params_b2", parameters.FFAccParamsBeta, 0.3091);
+
+    parameterMgr.param(MODEL_NAME, "driver_signal_perception_distance", parameters.signalVisibilityDist, 75.0);
+}
+
+void DriverParameterRegistry::readLaneChangingParameters(const ParameterManager &parameterMgr, MITSIM_LC_Parameters &parameters)
+{
+    //MLC_PARAMETERS
+    vector<double> array = readArray(parameterMgr, "MLC_PARAMETERS", "1320.0  5280.0 0.5 1.0  1.0");
+    parameters.MLC_PARAMETERS.lowbound = array[0];
+    parameters.MLC_PARAMETERS.delta = array[1];
+    parameters.MLC_PARAMETERS.lane_mintime = array[2];
+
+    //LC_GAP_MODELS
+    parameters.LC_GAP_MODELS.push_back(readArray(parameterMgr, "LC_GAP_MODELS_0", "1.00,   0.0,   0.000,  0.508,  0.000,  0.000,  -0.420, 0.000,   0.488"));
+    parameters.LC_GAP_MODELS.push_back(readArray(parameterMgr, "LC_GAP_MODELS_1", "1.00, 0.0, 0.000, 2.020, 0.000, 0.000, 0.153, 0.188, 0.526"));
+    parameters.LC_GAP_MODELS.push_back(readArray(parameterMgr, "LC_GAP_MODELS_2", "1.00, 0.0, 0.000, 0.384, 0.000, 0.000, 0.000, 0.000, 0.859"));
+    parameters.LC_GAP_MODELS.push_back(readArray(parameterMgr, "LC_GAP_MODELS_3", "1.00, 0.0, 0.000, 0.587, 0.000, 0.000, 0.048, 0.356, 1.073"));
+    parameters.LC_GAP_MODELS.push_back(readArray(parameterMgr, "LC_GAP_MODELS_4", "0.60, 0.0, 0.000, 0.384, 0.000, 0.000, 0.000, 0.000, 0.859"));
+    parameters.LC_GAP_MODELS.push_back(readArray(parameterMgr, "LC_GAP_MODELS_5", "0.60, 0.0, 0.000, 0.587, 0.000, 0.000, 0.048, 0.356, 1.073"));
+    parameters.LC_GAP_MODELS.push_back(readArray(parameterMgr, "LC_GAP_MODELS_6", "0.20, 0.0, 0.000, 0.384, 0.000, 0.000, 0.000, 0.000, 0.859"));
+    parameters.LC_GAP_MODELS.push_back(readArray(parameterMgr, "LC_GAP_MODELS_7", "0.20, 0.0, 0.000, 0.587, 0.000, 0.000, 0.048, 0.356, 1.073"));
+
+    //GAP_PARAM
+    parameters.GAP_PARAM.push_back(readArray(parameterMgr, "GAP_PARAM_0", "-1.23, -0.482, 0.224, -0.0179, 2.10, 0.239"));
+    parameters.GAP_PARAM.push_back(readArray(parameterMgr, "GAP_PARAM_1", "0.00,   0.00,  0.224, -0.0179, 2.10, 0.000"));
+    parameters.GAP_PARAM.push_back(readArray(parameterMgr, "GAP_PARAM_2", "-0.772, -0.482, 0.224, -0.0179, 2.10, 0.675"));
+
+    //Minimum speed
+    parameterMgr.param(MODEL_NAME, "min_speed", parameters.minSpeed, 0.1);
+
+    //Lane Utility parameters
+    parameters.laneUtilityParams = readArray(parameterMgr, "lane_utility_model",
+            "3.9443 -0.3213  -1.1683  -1.1683 0.0 0.0633 -1.0 0.0058 -0.2664 -0.0088 -3.3754 10 19 -2.3400 -4.5084 -2.8257 -1.2597 -0.7239 -0.3269");
+
+    //Critical gap parameters
+    parameters.criticalGapParams = readArray(parameterMgr, "critical_gaps_param", "0.5 -0.231  -2.700  1.112    0.5   0.000 0.2  0.742   6.0");
+
+    //Nosing parameters
+    parameters.nosingParams = readArray(parameterMgr, "nosing_param", "1.0 0.5  0.6  0.1   0.2   1.0 300.0  180.0   600.0 40.0");
+    parameters.lcMaxNosingDis = parameters.nosingParams[8];
+    parameters.lcMaxStuckTime = parameters.nosingParams[7];
+    parameters.lcNosingConstStateTime = parameters.nosingParams[0];
+    parameters.lcMaxYieldingTime = parameters.nosingParams[6];
+
+    parameters.lcYieldingProb = readArray(parameterMgr, "MLC_Yielding_Probabilities", "0.13 0.71  0.13  0.03");
+
+    //Kazi Nosing parameters
+    parameters.kaziNosingParams = readArray(parameterMgr, "kazi_nosing_param", "-3.159  0.313  -0.027  2.050  0.028  0.6");
+
+    //CF_CRITICAL_TIMER_RATIO
+    parameterMgr.param(MODEL_NAME, "CF_CRITICAL_TIMER_RATIO", parameters.CF_CRITICAL_TIMER_RATIO, 0.5);
+
+    //Minimum time in lane in same direction
+    parameterMgr.param(MODEL_NAME, "LC_Discretionary_Lane_Change_Model_MinTimeInLaneSameDir", parameters.minTimeInLaneSameDir, 2.0);
+
+    //Minimum time in lane in different direction
+    parameterMgr.param(MODEL_NAME, "LC_Discretionary_Lane_Change_Model_MinTimeInLaneDiffDir", parameters.minTimeInLaneDiffDir, 2.0);
+
+    //Target Gap Model
+    parameters.targetGapParams = readArray(parameterMgr, "Target_Gap_Model", "-0.837   0.913  0.816  -1.218  -2.393  -1.662");
+
+    parameterMgr.param(MODEL_NAME, "check_stop_point_distance", parameters.stopVisibilityDistance, 100.0);
+}
+
+void DriverParameterRegistry::readIntersectionDrivingParameters(const ParameterManager &parameterMgr, MITSIM_IntDriving_Parameters &parameters)
+{
+    string critical_gap_addon;
+
+    //Read the parameter values
+    parameterMgr.param(MODEL_NAME, "intersection_attentiveness_factor_min", parameters.intersectionAttentivenessFactorMin, 1.0);
+    parameterMgr.param(MODEL_NAME, "intersection_attentiveness_factor_max", parameters.intersectionAttentivenessFactorMax, 3.0);
+    parameterMgr.param(MODEL_NAME, "minimum_gap", parameters.minimumGap, 0.0);
+    parameterMgr.param(MODEL_NAME, "critical_gap_addon", critical_gap_addon, string("0.0 2.5"));
+    parameterMgr.param(MODEL_NAME, "impatience_factor", parameters.impatienceFactor, 0.2);
+
+    //Vector to store the tokenized parameters
+    std::vector<string> gapAddonParams;
+
+    //Tokenize the gap add-on parameters
+    boost::trim(critical_gap_addon);
+    boost::split(gapAddonParams, critical_gap_addon, boost::is_any_of(" "), boost::token_compress_on);
+
+    //Convert into numeric form
+    for (size_t index = 0; index < gapAddonParams.size() && index < 2; ++index)
+    {
+        try
+        {
+            parameters.criticalGapAddOn[index] = boost::lexical_cast<double>(gapAddonParams[index].c_str());
+        }
+        catch (boost::bad_lexical_cast&)
+        {
+            std::stringstream str;
+            str << __func__ << ": Could not covert " << gapAddonParams[index] << " to type double.";
+            throw std::runtime_error(str.str());
+        }
+    }
+}
+
+void DriverParameterRegistry::readVehicleLoadingParameters(const ParameterManager &parameterMgr, VehicleLoadingParameters &parameters)
+{
+    vector<double> thresholds = readScale(parameterMgr, "Initial_Speed_Assignment_Thresholds", "4 14 40");
+    parameters.speedAssignmentThresholds.distanceBoundedLow = thresholds[0];
+    parameters.speedAssignmentThresholds.distanceBoundedUpper = thresholds[1];
+    parameters.speedAssignmentThresholds.distanceUnbounded = thresholds[2];
+}
@@ -0,0 +1,224 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/once.hpp>
+
+#include "entities/vehicle/VehicleBase.hpp"
+
+namespace sim_mob
+{
+
+class ParameterManager;
+
+/**Values of a driver parameter which depend on the vehicle type and on its speed*/
+struct SpeedTable
+{
+    SpeedTable();
+
+    /**
+     * @param vhType the vehicle type
+     * @param speed the speed (ft/s), which is bounded by 0 and upperBound
+     *
+     * @return the value for the vehicle type at the given speed, 0 if there is none
+     */
+    double get(VehicleBase::VehicleType vhType, int speed) const;
+
+    /**The highest speed in the tables*/
+    int upperBound;
+
+    /**The values indexed by the speed (ft/s), for each vehicle type*/
+    std::vector<double> values[VehicleBase::OTHER + 1];
+};
+
+/**The parameters of the MITSIM car following model, which are the same for all drivers*/
+struct MITSIM_CF_Parameters
+{
+    /**Parameters of the update step size of a state*/
+    struct UpdateStepSizeParam
+    {
+        double mean;
+        double stdev;
+        double lower;
+        double upper;
+        double perception; //percentage of total reaction time
+    };
+
+    /**Parameters of the car following acceleration*/
+    struct CarFollowingParams
+    {
+        double alpha;
+        double beta;
+        double gama;
+        double lambda;
+        double rho;
+        double stddev;
+    };
+
+    double accGradeFactor;
+    double allGrades;
+    double minSpeed;
+    double minResponseDistance;
+    double maxYellowLightHeadway;
+    double minYellowLightSpeed;
+    double hBufferLower;
+    double speedFactor;
+    double visibilityDistance;
+    double signalVisibilityDist;
+    double FFAccParamsBeta;
+
+    CarFollowingParams CF_parameters[2];
+    UpdateStepSizeParam decUpdateStepSize;
+    UpdateStepSizeParam accUpdateStepSize;
+    UpdateStepSizeParam uniformSpeedUpdateStepSize;
+    UpdateStepSizeParam stoppedUpdateStepSize;
+
+    SpeedTable maxAccelerationIndex;
+    SpeedTable normalDecelerationIndex;
+    SpeedTable maxDecelerationIndex;
+
+    std::vector<double> maxAccelerationScale;
+    std::vector<double> normalDecelerationScale;
+    std::vector<double> maxDecelerationScale;
+    std::vector<double> speedLimitAddon;
+    std::vector<double> accelerationAddon;
+    std::vector<double> decelerationAddon;
+    std::vector<double> hBufferUpperScale;
+    std::vector<double> targetGapAccParm;
+    std::vector<double> mergingParams;
+};
+
+/**The parameters of the MITSIM lane changing model, which are the same for all drivers*/
+struct MITSIM_LC_Parameters
+{
+    /**Parameters of the mandatory lane change*/
+    struct MandatoryLaneChangeParams
+    {
+        //In metre
+        double lowbound;
+
+        //In metre
+        double delta;
+
+        //In sec
+        double lane_mintime;
+    };
+
+    MandatoryLaneChangeParams MLC_PARAMETERS;
+    double minSpeed;
+    double minTimeInLaneSameDir;
+    double minTimeInLaneDiffDir;
+    double lcMaxNosingDis;
+    double lcMaxStuckTime;
+    double lcMaxYieldingTime;
+    float lcNosingConstStateTime;
+    double CF_CRITICAL_TIMER_RATIO;
+    double stopVisibilityDistance;
+
+    std::vector<double> criticalGapParams;
+    std::vector<double> kaziNosingParams;
+    std::vector<double> lcYieldingProb;
+    std::vector<double> laneUtilityParams;
+    std::vector<double> nosingParams;
+    std::vector<double> targetGapParams;
+    std::vector< std::vector<double> > GAP_PARAM;
+    std::vector< std::vector<double> > LC_GAP_MODELS;
+};
+
+/**The parameters of the MITSIM intersection driving model, which are the same for all drivers*/
+struct MITSIM_IntDriving_Parameters
+{
+    MITSIM_IntDriving_Parameters();
+
+    double intersectionAttentivenessFactorMin;
+    double intersectionAttentivenessFactorMax;
+    double minimumGap;
+    double criticalGapAddOn[2];
+    double impatienceFactor;
+};
+
+/**The parameters of the vehicle loading model, which are the same for all drivers*/
+struct VehicleLoadingParameters
+{
+    /**Represents the various distance (to leader vehicle) headway thresholds for the initial speed assignment*/
+    struct InitialSpeedAssignmentThresholds
+    {
+        //Lower bound threshold for bounded traffic
+        double distanceBoundedLow;
+
+        //Upper bound threshold for bounded traffic
+        double distanceBoundedUpper;
+
+        //Threshold for unbounded traffic
+        double distanceUnbounded;
+    };
+
+    InitialSpeedAssignmentThresholds speedAssignmentThresholds;
+};
+
+/**The parameters of all the driving models*/
+struct DriverParameters
+{
+    MITSIM_CF_Parameters carFollowing;
+    MITSIM_LC_Parameters laneChanging;
+    MITSIM_IntDriving_Parameters intersectionDriving;
+    VehicleLoadingParameters vehicleLoading;
+};
+
+/**
+ * Holds the driving model parameters read from the driver parameter files.
+ *
+ * The parameters are read from the ParameterManager and parsed the first time a driver of each kind (normal or
+ * AMOD) is created, and are then never modified. The driving models of all the drivers refer to the same
+ * parameters, and only keep the values they sample for their own driver.
+ */
+class DriverParameterRegistry : private boost::noncopyable
+{
+public:
+    /**
+     * Returns the parameters of the normal or of the AMOD drivers, which are read the first time. Thread safe;
+     * once the parameters are read, they are returned without locking.
+     *
+     * @param isAMOD whether the parameters of the AMOD drivers are requested
+     *
+     * @return the parameters
+     */
+    static const DriverParameters& getParameters(bool isAMOD);
+
+private:
+    /**
+     * Reads the parameters from the given parameter manager
+     *
+     * @param parameterMgr the parameter manager holding the parameters of the normal or of the AMOD drivers
+     * @param parameters the parameters to be filled
+     */
+    static void readParameters(const ParameterManager &parameterMgr, DriverParameters &parameters);
+
+    /**
+     * Reads the parameters of the normal or of the AMOD drivers into driverParameters; called once for each
+     *
+     * @param isAMOD whether the parameters of the AMOD drivers are read
+     */
+    static void loadParameters(bool isAMOD);
+
+    static void readCarFollowingParameters(const ParameterManager &parameterMgr, MITSIM_CF_Parameters &parameters);
+
+    static void readLaneChangingParameters(const ParameterManager &parameterMgr, MITSIM_LC_Parameters &parameters);
+
+    static void readIntersectionDrivingParameters(const ParameterManager &parameterMgr, MITSIM_IntDriving_Parameters &parameters);
+
+    static void readVehicleLoadingParameters(const ParameterManager &parameterMgr, VehicleLoadingParameters &parameters);
+
+    /**The parameters of the normal drivers and of the AMOD drivers*/
+    static boost::scoped_ptr<const DriverParameters> driverParameters[2];
+
+    /**Flags ensuring that the parameters of the normal drivers and of the AMOD drivers are read only once*/
+    static boost::once_flag parametersLoaded[2];
+};
+
+}
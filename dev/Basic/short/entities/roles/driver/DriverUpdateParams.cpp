@@ -18,7 +18,8 @@ overflowIntoIntersection(0), stopVisibilityDistance(100), distanceToStoppingPt(9
 headway(999), acc(0), density(0), FFAccParamsBeta(0), lateralVelocity(0), reactionTimeCounter(0), nextStepSize(0), maxAcceleration(0), normalDeceleration(0), 
 maxDeceleration(0), laneChangeTime(200), lcMaxYieldingTime(0), maxLaneSpeed(0), acceleration(0), yieldTime(0,0), trafficColor(TrafficColor::TRAFFIC_COLOUR_INVALID),
 perceivedTrafficColor(TrafficColor::TRAFFIC_COLOUR_INVALID), turningDirection(LaneChangeTo::LANE_CHANGE_TO_NONE),
-stopPointState(STOP_POINT_NOT_FOUND), driver(NULL), currLane(NULL), leftLane(NULL), rightLane(NULL), leftLane2(NULL), rightLane2(NULL)
+stopPointState(STOP_POINT_NOT_FOUND), driver(NULL), currLane(NULL), leftLane(NULL), rightLane(NULL), leftLane2(NULL), rightLane2(NULL),
+LC_GAP_MODELS(NULL)
 {
 }
 
@@ -110,7 +111,7 @@ void DriverUpdateParams::unsetStatus(unsigned int s)
 
 double DriverUpdateParams::lcMinGap(int type)
 {
-    std::vector<double> b = LC_GAP_MODELS[type];
+    const std::vector<double> &b = (*LC_GAP_MODELS)[type];
     return b[2] * b[0];
 }
 
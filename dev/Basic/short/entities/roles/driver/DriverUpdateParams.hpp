@@ -402,14 +402,8 @@ public:
     /**The map of conflicting vehicles in the intersection. Key=Turning conflict, Value=Sorted set of vehicles(nearest vehicle first)*/
     std::map<const TurningConflict*, std::set<NearestVehicle, compare_NearestVehicle> > conflictVehicles;
 
-    /**Parameters for calculating the target gap*/
-    std::vector<double> targetGapParams;
-
-    /**The parameters for the nosing model*/
-    std::vector<double> nosingParams;
-
-    /**The critical gap parameters for lane changing*/
-    std::vector< std::vector<double> > LC_GAP_MODELS;
+    /**The critical gap parameters for lane changing (shared by all drivers, see DriverParameterRegistry)*/
+    const std::vector< std::vector<double> > *LC_GAP_MODELS;
 
     /**The set of lanes which we can change to*/
     std::set<const Lane*> targetLanes;
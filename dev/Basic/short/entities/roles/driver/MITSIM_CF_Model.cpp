@@ -10,6 +10,7 @@
 #include <cmath>
 
 #include "Driver.hpp"
+#include "DriverParameterRegistry.hpp"
 #include "entities/roles/driver/models/CarFollowModel.hpp"
 #include "entities/vehicle/Vehicle.hpp"
 #include "util/Math.hpp"
@@ -48,20 +49,6 @@ double calculateHeadway(double space, double speed, double elapsedSeconds, doubl
 
 MITSIM_CF_Model::MITSIM_CF_Model(DriverUpdateParams &params, DriverPathMover *pathMover) : CarFollowingModel(pathMover)
 {
-    modelName = "general_driver_model";
-    splitDelimiter = " ,";
-
-    readDriverParameters(params);
-}
-
-MITSIM_CF_Model::~MITSIM_CF_Model()
-{
-}
-
-void MITSIM_CF_Model::readDriverParameters(DriverUpdateParams &params)
-{
-    string speedScalarStr, maxAccStr, decelerationStr, maxAccScaleStr, normalDecScaleStr, maxDecScaleStr;
-    string addOn, hBufferUpperStr;
     bool isAMOD = false;
 
     if (params.driver->getParent()->amodId != "-1")
@@ -69,82 +56,12 @@ void MITSIM_CF_Model::readDriverParameters(DriverUpdateParams &params)
         isAMOD = true;
     }
 
-    ParameterManager *parameterMgr = ParameterManager::Instance(isAMOD);
-
-    parameterMgr->param(modelName, "speed_scaler", speedScalarStr, string("5 20 20"));
-    parameterMgr->param(modelName, "max_acc_car1", maxAccStr, string("10.00  7.90  5.60  4.00  4.00"));
-    createSpeedIndices(Vehicle::CAR, speedScalarStr, maxAccStr, maxAccelerationIndex, maxAccUpperBound);
-
-    parameterMgr->param(modelName, "max_acceleration_scale", maxAccScaleStr, string("0.6 0.7 0.8 0.9 1.0 1.1 1.2 1.3 1.4 1.5"));
-    createScaleIndices(maxAccScaleStr, maxAccelerationScale);
-
-    parameterMgr->param(modelName, "normal_deceleration_car1", decelerationStr, string("7.8     6.7     4.8     4.8     4.8"));
-    createSpeedIndices(Vehicle::CAR, speedScalarStr, decelerationStr, normalDecelerationIndex, normalDecelerationUpperBound);
-
-    parameterMgr->param(modelName, "normal_deceleration_scale", normalDecScaleStr, string("1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0"));
-    createScaleIndices(maxAccScaleStr, normalDecelerationScale);
-
-    parameterMgr->param(modelName, "speed_limit_add_on", addOn, string("-0.1911 -0.0708 -0.0082 0.0397 0.0810 0.1248 0.1661 0.2180 0.2745 0.3657"));
-    createScaleIndices(addOn, speedLimitAddon);
-
-    parameterMgr->param(modelName, "Car_following_acceleration_add_on", addOn, string("-1.3564 -0.8547 -0.5562 -0.3178 -0.1036 0.1036 0.3178 0.5562 0.8547 1.3564"));
-    Utils::convertStringToArray(addOn, accelerationAddon);
-
-    parameterMgr->param(modelName, "Car_following_deceleration_add_on", addOn, string("-1.3187 -0.8309 -0.5407 -0.3089 -0.1007 0.1007 0.3089 0.5407 0.8309 1.3187"));
-    Utils::convertStringToArray(addOn, decelerationAddon);
-
-    parameterMgr->param(modelName, "max_deceleration_car1", decelerationStr, string("-16.0   -14.5   -13.0   -11.0   -9.0"));
-    createSpeedIndices(Vehicle::CAR, speedScalarStr, decelerationStr, maxDecelerationIndex, maxDecelerationUpperBound);
+    parameters = &DriverParameterRegistry::getParameters(isAMOD).carFollowing;
+    minSpeed = parameters->minSpeed;
 
-    parameterMgr->param(modelName, "max_deceleration_scale", maxDecScaleStr, string("1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0 1.0"));
-    createScaleIndices(maxDecScaleStr, maxDecelerationScale);
-
-    parameterMgr->param(modelName, "acceleration_grade_factor", accGradeFactor, 0.305);
-    parameterMgr->param(modelName, "tmp_all_grades", allGrades, 0.0);
-
-    parameterMgr->param(modelName, "min_speed", minSpeed, 0.1);
-    parameterMgr->param(modelName, "min_response_distance", minResponseDistance, 5.0);
-
-    parameterMgr->param(modelName, "yellow_stop_headway", maxYellowLightHeadway, 1.0);
-    parameterMgr->param(modelName, "min_speed_yellow", minYellowLightSpeed, 2.2352);
-
-    parameterMgr->param(modelName, "hbuffer_lower", hBufferLower, 0.8);
-    parameterMgr->param(modelName, "hbuffer_Upper", hBufferUpperStr, string("1.7498 2.2737 2.5871 2.8379 3.0633 3.2814 3.5068 3.7578 4.0718 4.5979"));
-    createScaleIndices(hBufferUpperStr, hBufferUpperScale);
+    params.FFAccParamsBeta = parameters->FFAccParamsBeta;
     hBufferUpper = getH_BufferUpperBound();
 
-    string cfParamStr;
-    parameterMgr->param(modelName, "CF_parameters_1", cfParamStr, string("0.0400, 0.7220, 0.2420, 0.6820, 0.6000, 0.8250"));
-    createCF_Params(cfParamStr, CF_parameters[0]);
-
-    parameterMgr->param(modelName, "CF_parameters_2", cfParamStr, string("-0.0418 0.0000 0.1510 0.6840 0.6800 0.8020"));
-    createCF_Params(cfParamStr, CF_parameters[1]);
-
-    string targetGapAccParmStr;
-    parameterMgr->param(modelName, "target_gap_acc_parm", targetGapAccParmStr, string("0.604, 0.385, 0.323, 0.0678, 0.217,0.583, -0.596, -0.219, 0.0832, -0.170, 1.478, 0.131, 0.300"));
-    createScaleIndices(targetGapAccParmStr, targetGapAccParm);
-
-    string updateStepSizeStr;
-    parameterMgr->param(modelName, "dec_update_step_size", updateStepSizeStr, string("0.5 0.0 0.5 0.5 0.5"));
-    createUpdateSizeParams(updateStepSizeStr, decUpdateStepSize);
-
-    parameterMgr->param(modelName, "speed_factor", speedFactor, 1.0);
-
-    parameterMgr->param(modelName, "acc_update_step_size", updateStepSizeStr, string("1.0 0.0 1.0 1.0 0.5"));
-    createUpdateSizeParams(updateStepSizeStr, accUpdateStepSize);
-
-    parameterMgr->param(modelName, "uniform_speed_update_step_size", updateStepSizeStr, string("1.0 0.0 1.0 1.0 0.5"));
-    createUpdateSizeParams(updateStepSizeStr, uniformSpeedUpdateStepSize);
-
-    parameterMgr->param(modelName, "stopped_vehicle_update_step_size", updateStepSizeStr, string("0.5 0.0 0.5 0.5 0.5"));
-    createUpdateSizeParams(updateStepSizeStr, stoppedUpdateStepSize);
-
-    parameterMgr->param(modelName, "visibility_distance", visibilityDistance, 10.0);
-
-    parameterMgr->param(modelName, "FF_Acc_Params_b2", params.FFAccParamsBeta, 0.3091);
-
-    parameterMgr->param(modelName, "driver_signal_perception_distance", signalVisibilityDist, 75.0);
-
     boost::random_device seed_gen;
     long int seed = seed_gen();
     updateSizeRNG = boost::mt19937(seed);
@@ -162,300 +79,96 @@ void MITSIM_CF_Model::readDriverParameters(DriverUpdateParams &params)
     nextPerceptionSize = perceptionSize[3];
 }
 
-void MITSIM_CF_Model::createCF_Params(string &strParams, CarFollowingParams &cfParams)
-{
-    std::vector<std::string> arrayStr;
-    vector<double> params;
-
-    boost::trim(strParams);
-    boost::split(arrayStr, strParams, boost::is_any_of(splitDelimiter), boost::token_compress_on);
-
-    for (int i = 0; i < arrayStr.size(); ++i)
-    {
-        double res = 0;
-
-        try
-        {
-            res = boost::lexical_cast<double>(arrayStr[i].c_str());
-        }
-        catch (boost::bad_lexical_cast&)
-        {
-            std::stringstream str;
-            str << __func__ << ": Cannot convert " << strParams << " to type double";
-            throw std::runtime_error(str.str());
-        }
-
-        params.push_back(res);
-    }
-
-    cfParams.alpha = params[0];
-    cfParams.beta = params[1];
-    cfParams.gama = params[2];
-    cfParams.lambda = params[3];
-    cfParams.rho = params[4];
-    cfParams.stddev = params[5];
-}
-
-void MITSIM_CF_Model::createUpdateSizeParams(string &strParams, UpdateStepSizeParam &stepSizeParams)
-{
-    std::vector<std::string> arrayStr;
-    vector<double> params;
-
-    boost::trim(strParams);
-    boost::split(arrayStr, strParams, boost::is_any_of(splitDelimiter), boost::token_compress_on);
-
-    for (int i = 0; i < arrayStr.size(); ++i)
-    {
-        double res = 0;
-
-        try
-        {
-            res = boost::lexical_cast<double>(arrayStr[i].c_str());
-        }
-        catch (boost::bad_lexical_cast&)
-        {
-            std::stringstream str;
-            str << __func__ << ": Cannot convert " << strParams << " to type double";
-            throw std::runtime_error(str.str());
-        }
-
-        params.push_back(res);
-    }
-
-    stepSizeParams.mean = params[0];
-    stepSizeParams.stdev = params[1];
-    stepSizeParams.lower = params[2];
-    stepSizeParams.upper = params[3];
-    stepSizeParams.perception = params[4];
-}
-
-void MITSIM_CF_Model::createScaleIndices(string &data, vector<double> &container)
-{
-    std::vector<std::string> arrayStr;
-
-    boost::trim(data);
-    boost::split(arrayStr, data, boost::is_any_of(splitDelimiter), boost::token_compress_on);
-
-    for (int i = 0; i < arrayStr.size(); ++i)
-    {
-        double res = 0;
-
-        try
-        {
-            res = boost::lexical_cast<double>(arrayStr[i].c_str());
-        }
-        catch (boost::bad_lexical_cast&)
-        {
-            std::stringstream str;
-            str << __func__ << ": Cannot convert " << data << " to type double";
-            throw std::runtime_error(str.str());
-        }
-
-        container.push_back(res);
-    }
-}
-
-void MITSIM_CF_Model::createSpeedIndices(VehicleBase::VehicleType vhType, string &speedScalerStr, string &cstr,
-                                         map<VehicleBase::VehicleType, map<int, double> > &idx, int &upperBound)
+MITSIM_CF_Model::~MITSIM_CF_Model()
 {
-    //For example
-    //speedScalerStr "5 20 20" ft/sec
-    //maxAccStr      "10.00  7.90  5.60  4.00  4.00" ft/(s^2)
-    std::vector<std::string> arrayStr;
-
-    boost::trim(speedScalerStr);
-    boost::split(arrayStr, speedScalerStr, boost::is_any_of(splitDelimiter), boost::token_compress_on);
-
-    std::vector<double> speedScalerArrayDouble;
-
-    for (int i = 0; i < arrayStr.size(); ++i)
-    {
-        double res = 0;
-        try
-        {
-            res = boost::lexical_cast<double>(arrayStr[i].c_str());
-        }
-        catch (boost::bad_lexical_cast&)
-        {
-            std::stringstream str;
-            str << __func__ << ": Cannot convert " << speedScalerStr << " to type double.";
-            throw std::runtime_error(str.str());
-        }
-
-        speedScalerArrayDouble.push_back(res);
-    }
-
-    arrayStr.clear();
-
-    boost::algorithm::trim(cstr);
-    boost::split(arrayStr, cstr, boost::is_any_of(splitDelimiter), boost::token_compress_on);
-
-    std::vector<double> cArrayDouble;
-
-    for (int i = 0; i < arrayStr.size(); ++i)
-    {
-        double res = 0;
-        try
-        {
-            res = boost::lexical_cast<double>(arrayStr[i].c_str());
-        }
-        catch (boost::bad_lexical_cast&)
-        {
-            std::stringstream str;
-            str << __func__ << ": Cannot convert " << cstr << " to type double.";
-            throw std::runtime_error(str.str());
-        }
-
-        cArrayDouble.push_back(res);
-    }
-
-    upperBound = round(speedScalerArrayDouble[1] * (speedScalerArrayDouble[0] - 1));
-
-    map<int, double> cIdx;
-
-    for (int speed = 0; speed <= upperBound; ++speed)
-    {
-        // Convert speed value to a table index.
-        int j = speed / speedScalerArrayDouble[1];
-        double maxAcc = 0;
-
-        if (j >= (speedScalerArrayDouble[0] - 1))
-        {
-            maxAcc = cArrayDouble[speedScalerArrayDouble[0] - 1];
-        }
-        else
-        {
-            maxAcc = cArrayDouble[j];
-        }
-
-        cIdx.insert(std::make_pair(speed, maxAcc));
-    }
-
-    idx[vhType] = cIdx;
 }
 
 double MITSIM_CF_Model::getMaxAcceleration(DriverUpdateParams &params, VehicleBase::VehicleType vhType)
 {
-    int speed = params.perceivedFwdVelocity;
-
-    if (speed < 0)
-    {
-        speed = 0;
-    }
-
-    if (speed > maxAccUpperBound)
-    {
-        speed = maxAccUpperBound;
-    }
-
-    double maxTableAcc = maxAccelerationIndex[vhType][speed];
+    double maxTableAcc = parameters->maxAccelerationIndex.get(vhType, params.perceivedFwdVelocity);
 
-    double maxAcc = (maxTableAcc - allGrades * accGradeFactor) * getMaxAccScalar();
+    double maxAcc = (maxTableAcc - parameters->allGrades * parameters->accGradeFactor) * getMaxAccScalar();
 
     return maxAcc;
 }
 
 double MITSIM_CF_Model::getNormalDeceleration(DriverUpdateParams &params, VehicleBase::VehicleType vhType)
 {
-    int speed = params.perceivedFwdVelocity;
-
-    if (speed < 0)
-    {
-        speed = 0;
-    }
-
-    if (speed > normalDecelerationUpperBound)
-    {
-        speed = normalDecelerationUpperBound;
-    }
+    double normalDec = parameters->normalDecelerationIndex.get(vhType, params.perceivedFwdVelocity);
 
-    double normalDec = normalDecelerationIndex[vhType][speed];
-
-    double dec = (normalDec - allGrades * accGradeFactor) * getNormalDecScalar();
+    double dec = (normalDec - parameters->allGrades * parameters->accGradeFactor) * getNormalDecScalar();
 
     return dec;
 }
 
 double MITSIM_CF_Model::getMaxDeceleration(DriverUpdateParams &params, VehicleBase::VehicleType vhType)
 {
-    int speed = params.perceivedFwdVelocity;
-
-    if (speed < 0)
-    {
-        speed = 0;
-    }
-
-    if (speed > maxDecelerationUpperBound)
-    {
-        speed = maxDecelerationUpperBound;
-    }
-
-    double maxDec = maxDecelerationIndex[vhType][speed];
+    double maxDec = parameters->maxDecelerationIndex.get(vhType, params.perceivedFwdVelocity);
 
-    double dec = (maxDec - allGrades * accGradeFactor) * getMaxDecScalar();
+    double dec = (maxDec - parameters->allGrades * parameters->accGradeFactor) * getMaxDecScalar();
 
     return dec;
 }
 
 double MITSIM_CF_Model::getMaxAccScalar()
 {
-    int scaleNo = Utils::generateInt(1, maxAccelerationScale.size() - 1);
-    double res = Utils::generateFloat(maxAccelerationScale[scaleNo - 1], maxAccelerationScale[scaleNo]);
+    int scaleNo = Utils::generateInt(1, parameters->maxAccelerationScale.size() - 1);
+    double res = Utils::generateFloat(parameters->maxAccelerationScale[scaleNo - 1], parameters->maxAccelerationScale[scaleNo]);
 
     return res;
 }
 
 double MITSIM_CF_Model::getNormalDecScalar()
 {
-    int scaleNo = Utils::generateInt(1, normalDecelerationScale.size() - 1);
-    double res = Utils::generateFloat(normalDecelerationScale[scaleNo - 1], normalDecelerationScale[scaleNo]);
+    int scaleNo = Utils::generateInt(1, parameters->normalDecelerationScale.size() - 1);
+    double res = Utils::generateFloat(parameters->normalDecelerationScale[scaleNo - 1], parameters->normalDecelerationScale[scaleNo]);
 
     return res;
 }
 
 double MITSIM_CF_Model::getMaxDecScalar()
 {
-    int scaleNo = Utils::generateInt(1, maxDecelerationScale.size() - 1);
-    double res = Utils::generateFloat(normalDecelerationScale[scaleNo - 1], normalDecelerationScale[scaleNo]);
+    int scaleNo = Utils::generateInt(1, parameters->maxDecelerationScale.size() - 1);
+    double res = Utils::generateFloat(parameters->normalDecelerationScale[scaleNo - 1], parameters->normalDecelerationScale[scaleNo]);
 
     return res;
 }
 
 double MITSIM_CF_Model::getSpeedLimitAddon()
 {
-    int scaleNo = Utils::generateInt(1, speedLimitAddon.size() - 1);
-    double res = Utils::generateFloat(speedLimitAddon[scaleNo - 1], speedLimitAddon[scaleNo]);
+    int scaleNo = Utils::generateInt(1, parameters->speedLimitAddon.size() - 1);
+    double res = Utils::generateFloat(parameters->speedLimitAddon[scaleNo - 1], parameters->speedLimitAddon[scaleNo]);
 
     return res;
 }
 
 double MITSIM_CF_Model::getAccelerationAddon()
 {
-    int scaleNo = Utils::generateInt(1, accelerationAddon.size() - 1);
-    double res = Utils::generateFloat(accelerationAddon[scaleNo - 1], accelerationAddon[scaleNo]);
+    int scaleNo = Utils::generateInt(1, parameters->accelerationAddon.size() - 1);
+    double res = Utils::generateFloat(parameters->accelerationAddon[scaleNo - 1], parameters->accelerationAddon[scaleNo]);
 
     return res;
 }
 
 double MITSIM_CF_Model::getDecelerationAddon()
 {
-    int scaleNo = Utils::generateInt(1, decelerationAddon.size() - 1);
-    double res = Utils::generateFloat(decelerationAddon[scaleNo - 1], decelerationAddon[scaleNo]);
+    int scaleNo = Utils::generateInt(1, parameters->decelerationAddon.size() - 1);
+    double res = Utils::generateFloat(parameters->decelerationAddon[scaleNo - 1], parameters->decelerationAddon[scaleNo]);
 
     return res;
 }
 
 double MITSIM_CF_Model::getH_BufferUpperBound()
 {
-    int scaleNo = Utils::generateInt(1, hBufferUpperScale.size() - 1);
-    double res = Utils::generateFloat(hBufferUpperScale[scaleNo - 1], hBufferUpperScale[scaleNo]);
+    int scaleNo = Utils::generateInt(1, parameters->hBufferUpperScale.size() - 1);
+    double res = Utils::generateFloat(parameters->hBufferUpperScale[scaleNo - 1], parameters->hBufferUpperScale[scaleNo]);
 
     return res;
 }
 
 double MITSIM_CF_Model::getHeadwayBuffer()
 {
-    return Utils::generateFloat(hBufferLower, hBufferUpper);
+    return Utils::generateFloat(parameters->hBufferLower, hBufferUpper);
 }
 
 double MITSIM_CF_Model::makeAcceleratingDecision(DriverUpdateParams &params)
@@ -579,7 +292,7 @@ double MITSIM_CF_Model::makeAcceleratingDecision(DriverUpdateParams &params)
             Driver *rearDriver = const_cast<Driver*> (params.nvBack.driver);
             DriverUpdateParams &rearDriverParams = rearDriver->getParams();
 
-            if (params.nvBack.distance < visibilityDistance && !(rearDriver->IsBusDriver() && rearDriverParams.getStatus(STATUS_STOPPED)))
+            if (params.nvBack.distance < parameters->visibilityDistance && !(rearDriver->IsBusDriver() && rearDriverParams.getStatus(STATUS_STOPPED)))
             {
                 float alert = CF_CRITICAL_TIMER_RATIO * updateStepSize[0];
                 rearDriverParams.reactionTimeCounter = std::min<double>(alert, rearDriverParams.reactionTimeCounter);
@@ -644,7 +357,7 @@ double MITSIM_CF_Model::calcCarFollowingAcc(DriverUpdateParams &params, NearestV
             double speed = params.perceivedFwdVelocity;
             double emergHeadway = calculateHeadway(emergSpace, speed, params.elapsedSeconds, params.maxAcceleration);
 
-            if (emergHeadway < hBufferLower)
+            if (emergHeadway < parameters->hBufferLower)
             {
                 //We need to brake. Override.
                 params.gapBetnVehicles = emergSpace;
@@ -657,7 +370,7 @@ double MITSIM_CF_Model::calcCarFollowingAcc(DriverUpdateParams &params, NearestV
         float v = params.velocityLeadVehicle + params.accLeadVehicle * dt;
         params.spaceStar = params.gapBetnVehicles + 0.5 * (params.velocityLeadVehicle + v) * dt;
 
-        if (headway < hBufferLower)
+        if (headway < parameters->hBufferLower)
         {
             res = calcEmergencyDeceleration(params);
             params.setStatus(STATUS_REGIME_EMERGENCY);
@@ -672,7 +385,7 @@ double MITSIM_CF_Model::calcCarFollowingAcc(DriverUpdateParams &params, NearestV
             debugStr << "UP;";
         }
 
-        if (headway <= hBufferUpper && headway >= hBufferLower)
+        if (headway <= hBufferUpper && headway >= parameters->hBufferLower)
         {
             res = calcAccOfCarFollowing(params);
             debugStr << "LOUP;";
@@ -799,7 +512,7 @@ double MITSIM_CF_Model::calcTrafficSignalAcc(DriverUpdateParams &p)
 
     //The check for current lane ensures that we pass through the intersection without getting stuck if the driver reacts a little late
     //for the traffic light causing the vehicle to enter the intersection slightly
-    if (distanceToTrafficSignal < signalVisibilityDist && p.currLane)
+    if (distanceToTrafficSignal < parameters->signalVisibilityDist && p.currLane)
     {
         if (color == TRAFFIC_COLOUR_RED)
         {
@@ -807,9 +520,9 @@ double MITSIM_CF_Model::calcTrafficSignalAcc(DriverUpdateParams &p)
         }
         else if (color == TRAFFIC_COLOUR_AMBER)
         {
-            double maxSpeed = (p.perceivedFwdVelocity > minYellowLightSpeed) ? p.perceivedFwdVelocity : minYellowLightSpeed;
+            double maxSpeed = (p.perceivedFwdVelocity > parameters->minYellowLightSpeed) ? p.perceivedFwdVelocity : parameters->minYellowLightSpeed;
 
-            if (distanceToTrafficSignal / maxSpeed > maxYellowLightHeadway)
+            if (distanceToTrafficSignal / maxSpeed > parameters->maxYellowLightHeadway)
             {
                 minAcc = std::min(calcBrakeToStopAcc(p, distanceToTrafficSignal), minAcc);
             }
@@ -1110,7 +823,7 @@ double MITSIM_CF_Model::calcDesiredSpeed(DriverUpdateParams &params)
 
     }
 
-    float desired = speedFactor * speedOnSign;
+    float desired = parameters->speedFactor * speedOnSign;
 
     desired = desired * (1 + getSpeedLimitAddon());
 
@@ -1145,7 +858,7 @@ double MITSIM_CF_Model::calcForwardGapAcc(DriverUpdateParams &params)
         return params.maxAcceleration;
     }
 
-    const std::vector<double> &gapAcceptanceParams = targetGapAccParm;
+    const std::vector<double> &gapAcceptanceParams = parameters->targetGapAccParm;
     double distance = 0;
     double dv = 0;
 
@@ -1195,7 +908,7 @@ double MITSIM_CF_Model::calcBackwardGapAcc(DriverUpdateParams &params)
         return params.maxAcceleration;
     }
 
-    const std::vector<double> &gapAcceptanceParams = targetGapAccParm;
+    const std::vector<double> &gapAcceptanceParams = parameters->targetGapAccParm;
 
     double distance = 0;
     double dv = 0;
@@ -1252,7 +965,7 @@ double MITSIM_CF_Model::calcAdjacentGapRate(DriverUpdateParams& p)
         return p.maxAcceleration;
     }
 
-    const std::vector<double> &gapAcceptanceParams = targetGapAccParm;
+    const std::vector<double> &gapAcceptanceParams = parameters->targetGapAccParm;
 
     if (!adjVehicle->exists())
     {
@@ -1449,9 +1162,9 @@ double MITSIM_CF_Model::calcAccOfCarFollowing(DriverUpdateParams &params)
 
     double dv = (velocity > params.velocityLeadVehicle) ? (velocity - params.velocityLeadVehicle) : (params.velocityLeadVehicle - velocity);
 
-    double res = CF_parameters[i].alpha * pow(velocity, CF_parameters[i].beta) / pow(params.nvFwd.distance, CF_parameters[i].gama);
-    res *= pow(dv, CF_parameters[i].lambda) * pow(density, CF_parameters[i].rho);
-    res += feet2Unit(Utils::nRandom(0, CF_parameters[i].stddev));
+    double res = parameters->CF_parameters[i].alpha * pow(velocity, parameters->CF_parameters[i].beta) / pow(params.nvFwd.distance, parameters->CF_parameters[i].gama);
+    res *= pow(dv, parameters->CF_parameters[i].lambda) * pow(density, parameters->CF_parameters[i].rho);
+    res += feet2Unit(Utils::nRandom(0, parameters->CF_parameters[i].stddev));
 
     return res;
 }
@@ -1460,12 +1173,12 @@ double MITSIM_CF_Model::calcFreeFlowingAcc(DriverUpdateParams &params, double ta
 {
     double velocity = params.perceivedFwdVelocity;
 
-    if (velocity < targetSpeed - minSpeed)
+    if (velocity < targetSpeed - parameters->minSpeed)
     {
         double acc = params.FFAccParamsBeta * (targetSpeed - velocity);
         return acc;
     }
-    else if (velocity > targetSpeed + minSpeed)
+    else if (velocity > targetSpeed + parameters->minSpeed)
     {
         return params.normalDeceleration;
     }
@@ -1490,18 +1203,18 @@ double MITSIM_CF_Model::accOfMixOfCFandFF(DriverUpdateParams &params, double tar
 
 void MITSIM_CF_Model::calcDistanceForNormalStop(DriverUpdateParams &params)
 {
-    if (params.perceivedFwdVelocity > minSpeed)
+    if (params.perceivedFwdVelocity > parameters->minSpeed)
     {
         params.distanceToNormalStop = Math::DOUBLE_EPSILON - 0.5 * params.perceivedFwdVelocity * params.perceivedFwdVelocity / params.normalDeceleration;
 
-        if (params.distanceToNormalStop < minResponseDistance)
+        if (params.distanceToNormalStop < parameters->minResponseDistance)
         {
-            params.distanceToNormalStop = minResponseDistance;
+            params.distanceToNormalStop = parameters->minResponseDistance;
         }
     }
     else
     {
-        params.distanceToNormalStop = minResponseDistance;
+        params.distanceToNormalStop = parameters->minResponseDistance;
     }
 }
 
@@ -1527,43 +1240,43 @@ void MITSIM_CF_Model::calcStateBasedVariables(DriverUpdateParams &params)
 void MITSIM_CF_Model::calcUpdateStepSizes()
 {
     //Deceleration
-    double totalReactionTime = sampleFromNormalDistribution(decUpdateStepSize);
+    double totalReactionTime = sampleFromNormalDistribution(parameters->decUpdateStepSize);
 
     //Perception time  = reaction time * perception percentage
-    double perceptionTime = totalReactionTime * decUpdateStepSize.perception;
+    double perceptionTime = totalReactionTime * parameters->decUpdateStepSize.perception;
 
     updateStepSize.push_back(totalReactionTime);
     perceptionSize.push_back(perceptionTime);
 
     //Acceleration
-    totalReactionTime = sampleFromNormalDistribution(accUpdateStepSize);
+    totalReactionTime = sampleFromNormalDistribution(parameters->accUpdateStepSize);
 
     //Perception time  = reaction time * perception percentage
-    perceptionTime = totalReactionTime * accUpdateStepSize.perception;
+    perceptionTime = totalReactionTime * parameters->accUpdateStepSize.perception;
 
     updateStepSize.push_back(totalReactionTime);
     perceptionSize.push_back(perceptionTime);
 
     //Uniform Speed
-    totalReactionTime = sampleFromNormalDistribution(uniformSpeedUpdateStepSize);
+    totalReactionTime = sampleFromNormalDistribution(parameters->uniformSpeedUpdateStepSize);
 
     //Perception time  = reaction time * perception percentage
-    perceptionTime = totalReactionTime * uniformSpeedUpdateStepSize.perception;
+    perceptionTime = totalReactionTime * parameters->uniformSpeedUpdateStepSize.perception;
 
     updateStepSize.push_back(totalReactionTime);
     perceptionSize.push_back(perceptionTime);
 
     //Stopped vehicle
-    totalReactionTime = sampleFromNormalDistribution(stoppedUpdateStepSize);
+    totalReactionTime = sampleFromNormalDistribution(parameters->stoppedUpdateStepSize);
 
     //Perception time  = reaction time * perception percentage
-    perceptionTime = totalReactionTime * stoppedUpdateStepSize.perception;
+    perceptionTime = totalReactionTime * parameters->stoppedUpdateStepSize.perception;
 
     updateStepSize.push_back(totalReactionTime);
     perceptionSize.push_back(perceptionTime);
 }
 
-double MITSIM_CF_Model::sampleFromNormalDistribution(UpdateStepSizeParam &stepSizeParams)
+double MITSIM_CF_Model::sampleFromNormalDistribution(const MITSIM_CF_Parameters::UpdateStepSizeParam &stepSizeParams)
 {
 
     if (stepSizeParams.mean == 0)
@@ -2,8 +2,6 @@
 //Licensed under the terms of the MIT License, as described in the file:
 // license.txt (http://opensource.org/licenses/MIT)
 
-#include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string/trim.hpp>
 #include <cmath>
 #include <map>
 
@@ -15,17 +13,29 @@
 using namespace std;
 using namespace sim_mob;
 
-MITSIM_IntDriving_Model::MITSIM_IntDriving_Model() :
-intersectionAttentivenessFactorMin(0), intersectionAttentivenessFactorMax(0), minimumGap(0), impatienceFactor(0)
+namespace
+{
+/**The parameters of the models which are not created for a driver*/
+const MITSIM_IntDriving_Parameters NO_PARAMETERS;
+}
+
+MITSIM_IntDriving_Model::MITSIM_IntDriving_Model() : parameters(&NO_PARAMETERS)
 {
     modelType = IntModelType::Int_Model_MITSIM;
 }
 
-MITSIM_IntDriving_Model::MITSIM_IntDriving_Model(DriverUpdateParams& params) :
-intersectionAttentivenessFactorMin(0), intersectionAttentivenessFactorMax(0), minimumGap(0), impatienceFactor(0)
+MITSIM_IntDriving_Model::MITSIM_IntDriving_Model(DriverUpdateParams& params)
 {
+    bool isAMOD = false;
+
+    //Check if the vehicle is autonomous
+    if (params.driver->getParent()->amodId != "-1")
+    {
+        isAMOD = true;
+    }
+
     modelType = IntModelType::Int_Model_MITSIM;
-    readDriverParameters(params);
+    parameters = &DriverParameterRegistry::getParameters(isAMOD).intersectionDriving;
 }
 
 MITSIM_IntDriving_Model::~MITSIM_IntDriving_Model()
@@ -34,73 +44,17 @@ MITSIM_IntDriving_Model::~MITSIM_IntDriving_Model()
 
 double MITSIM_IntDriving_Model::getIntersectionAttentivenessFactorMin() const
 {
-    return intersectionAttentivenessFactorMin;
+    return parameters->intersectionAttentivenessFactorMin;
 }
 
 double MITSIM_IntDriving_Model::getIntersectionAttentivenessFactorMax() const
 {
-    return intersectionAttentivenessFactorMax;
+    return parameters->intersectionAttentivenessFactorMax;
 }
 
 double MITSIM_IntDriving_Model::getImpatienceFactor() const
 {
-    return impatienceFactor;
-}
-
-void MITSIM_IntDriving_Model::readDriverParameters(DriverUpdateParams &params)
-{
-    string modelName = "general_driver_model";
-    string critical_gap_addon;
-    bool isAMOD = false;
-
-    //Check if the vehicle is autonomous
-    if (params.driver->getParent()->amodId != "-1")
-    {
-        isAMOD = true;
-    }
-
-    //Get the parameter manager instance for the respective type of vehicle (normal or AMOD)
-    ParameterManager *parameterMgr = ParameterManager::Instance(isAMOD);
-
-    //Read the parameter values
-    parameterMgr->param(modelName, "intersection_attentiveness_factor_min", intersectionAttentivenessFactorMin, 1.0);
-    parameterMgr->param(modelName, "intersection_attentiveness_factor_max", intersectionAttentivenessFactorMax, 3.0);
-    parameterMgr->param(modelName, "minimum_gap", minimumGap, 0.0);
-    parameterMgr->param(modelName, "critical_gap_addon", critical_gap_addon, string("0.0 2.5"));
-    parameterMgr->param(modelName, "impatience_factor", impatienceFactor, 0.2);
-
-    //Vector to store the tokenized parameters
-    std::vector<string> gapAddonParams;
-
-    //Index
-    int index = 0;
-
-    //Tokenize the gap add-on parameters
-    boost::trim(critical_gap_addon);
-    boost::split(gapAddonParams, critical_gap_addon, boost::is_any_of(" "), boost::token_compress_on);
-
-    //Convert into numeric form
-    vector<string>::iterator itStr = gapAddonParams.begin();
-    while (itStr != gapAddonParams.end())
-    {
-        double res = 0;
-
-        try
-        {
-            res = boost::lexical_cast<double>(itStr->c_str());
-        }
-        catch (boost::bad_lexical_cast&)
-        {
-            std::stringstream str;
-            str << __func__ << ": Could not covert " << *itStr << " to type double.";
-            throw std::runtime_error(str.str());
-        }
-
-        criticalGapAddOn[index] = res;
-
-        ++index;
-        ++itStr;
-    }
+    return parameters->impatienceFactor;
 }
 
 double MITSIM_IntDriving_Model::calcBrakeToStopAcc(double distance, DriverUpdateParams &params)
@@ -229,7 +183,7 @@ double MITSIM_IntDriving_Model::makeAcceleratingDecision(DriverUpdateParams &par
     const TurningGroup *currTurningGroup = currTurning->getTurningGroup();
 
     //Reduce the reaction time in intersection          
-    params.reactionTimeCounter = params.reactionTimeCounter * Utils::generateFloat(intersectionAttentivenessFactorMin, intersectionAttentivenessFactorMax);
+    params.reactionTimeCounter = params.reactionTimeCounter * Utils::generateFloat(parameters->intersectionAttentivenessFactorMin, parameters->intersectionAttentivenessFactorMax);
 
     //Safety margin distance in front of the vehicle (half a vehicle length seems a reasonable margin)
     const double safeDist = 1.5 * vehicleLength;
@@ -372,15 +326,15 @@ double MITSIM_IntDriving_Model::makeAcceleratingDecision(DriverUpdateParams &par
             double criticalGap = conflict->getCriticalGap();
 
             //Add a random add-on value
-            criticalGap += Utils::nRandom(criticalGapAddOn[0], criticalGapAddOn[1]);
+            criticalGap += Utils::nRandom(parameters->criticalGapAddOn[0], parameters->criticalGapAddOn[1]);
 
             //Reduce by impatience on if equal priority
             if (priority == 0)
             {
-                criticalGap -= (params.impatienceTimer * impatienceFactor);
+                criticalGap -= (params.impatienceTimer * parameters->impatienceFactor);
             }
 
-            criticalGap = max(criticalGap, minimumGap);
+            criticalGap = max(criticalGap, parameters->minimumGap);
 
             debugStr << ";CGap:" << criticalGap;            
 
@@ -6,6 +6,7 @@
 #include <limits>
 
 #include "Driver.hpp"
+#include "DriverParameterRegistry.hpp"
 #include "IncidentPerformer.hpp"
 #include "entities/roles/driver/models/LaneChangeModel.hpp"
 #include "entities/vehicle/Vehicle.hpp"
@@ -32,19 +33,6 @@ template <class T> struct LeadLag
 
 MITSIM_LC_Model::MITSIM_LC_Model(DriverUpdateParams &params, DriverPathMover *pathMover) : LaneChangingModel(pathMover)
 {
-    modelName = "general_driver_model";
-    splitDelimiter = " ,";
-
-    readDriverParameters(params);
-}
-
-MITSIM_LC_Model::~MITSIM_LC_Model()
-{
-}
-
-void MITSIM_LC_Model::readDriverParameters(DriverUpdateParams &params)
-{
-    std::string str;
     bool isAMOD = false;
 
     if (params.driver->getParent()->amodId != "-1")
@@ -52,92 +40,26 @@ void MITSIM_LC_Model::readDriverParameters(DriverUpdateParams &params)
         isAMOD = true;
     }
 
-    ParameterManager *parameterMgr = ParameterManager::Instance(isAMOD);
-
-    //MLC_PARAMETERS
-    parameterMgr->param(modelName, "MLC_PARAMETERS", str, string("1320.0  5280.0 0.5 1.0  1.0"));
-    makeMLCParam(str);
-
-    //LC_GAP_MODELS
-    std::vector< std::string > strArray;
-    parameterMgr->param(modelName, "LC_GAP_MODELS_0", str, string("1.00,   0.0,   0.000,  0.508,  0.000,  0.000,  -0.420, 0.000,   0.488"));
-    strArray.push_back(str);
-    parameterMgr->param(modelName, "LC_GAP_MODELS_1", str, string("1.00, 0.0, 0.000, 2.020, 0.000, 0.000, 0.153, 0.188, 0.526"));
-    strArray.push_back(str);
-    parameterMgr->param(modelName, "LC_GAP_MODELS_2", str, string("1.00, 0.0, 0.000, 0.384, 0.000, 0.000, 0.000, 0.000, 0.859"));
-    strArray.push_back(str);
-    parameterMgr->param(modelName, "LC_GAP_MODELS_3", str, string("1.00, 0.0, 0.000, 0.587, 0.000, 0.000, 0.048, 0.356, 1.073"));
-    strArray.push_back(str);
-    parameterMgr->param(modelName, "LC_GAP_MODELS_4", str, string("0.60, 0.0, 0.000, 0.384, 0.000, 0.000, 0.000, 0.000, 0.859"));
-    strArray.push_back(str);
-    parameterMgr->param(modelName, "LC_GAP_MODELS_5", str, string("0.60, 0.0, 0.000, 0.587, 0.000, 0.000, 0.048, 0.356, 1.073"));
-    strArray.push_back(str);
-    parameterMgr->param(modelName, "LC_GAP_MODELS_6", str, string("0.20, 0.0, 0.000, 0.384, 0.000, 0.000, 0.000, 0.000, 0.859"));
-    strArray.push_back(str);
-    parameterMgr->param(modelName, "LC_GAP_MODELS_7", str, string("0.20, 0.0, 0.000, 0.587, 0.000, 0.000, 0.048, 0.356, 1.073"));
-    strArray.push_back(str);
-    makeCriticalGapParams(params, strArray);
-
-    //GAP_PARAM
-    strArray.clear();
-    parameterMgr->param(modelName, "GAP_PARAM_0", str, string("-1.23, -0.482, 0.224, -0.0179, 2.10, 0.239"));
-    strArray.push_back(str);
-    parameterMgr->param(modelName, "GAP_PARAM_1", str, string("0.00,   0.00,  0.224, -0.0179, 2.10, 0.000"));
-    strArray.push_back(str);
-    parameterMgr->param(modelName, "GAP_PARAM_2", str, string("-0.772, -0.482, 0.224, -0.0179, 2.10, 0.675"));
-    strArray.push_back(str);
-    makeTargetGapPram(strArray);
-
-    //Minimum speed
-    parameterMgr->param(modelName, "min_speed", minSpeed, 0.1);
+    parameters = &DriverParameterRegistry::getParameters(isAMOD).laneChanging;
+
+    params.LC_GAP_MODELS = &parameters->LC_GAP_MODELS;
+    params.lcMaxYieldingTime = parameters->lcMaxYieldingTime;
+    params.stopVisibilityDistance = parameters->stopVisibilityDistance;
 
     //Driver look ahead distance
     lookAheadDistance = mlcDistance();
+}
 
-    //Lane Utility parameters
-    parameterMgr->param(modelName, "lane_utility_model", str, string("3.9443 -0.3213  -1.1683  -1.1683 0.0 0.0633 -1.0 0.0058 -0.2664 -0.0088 -3.3754 10 19 -2.3400 -4.5084 -2.8257 -1.2597 -0.7239 -0.3269"));
-    makeLaneUtilityParams(str);
-
-    //Critical gap parameters
-    parameterMgr->param(modelName, "critical_gaps_param", str, string("0.5 -0.231  -2.700  1.112    0.5   0.000 0.2  0.742   6.0"));
-    makeCriticalGapParams(str);
-
-    //Nosing parameters
-    parameterMgr->param(modelName, "nosing_param", str, string("1.0 0.5  0.6  0.1   0.2   1.0 300.0  180.0   600.0 40.0"));
-    makeNosingParams(params, str);
-
-    parameterMgr->param(modelName, "MLC_Yielding_Probabilities", str, string("0.13 0.71  0.13  0.03"));
-    makeLC_YieldingProbabilities(str);
-
-    //Kazi Nosing parameters
-    parameterMgr->param(modelName, "kazi_nosing_param", str, string("-3.159  0.313  -0.027  2.050  0.028  0.6"));
-    makeKaziNosingParams(str);
-
-    //CF_CRITICAL_TIMER_RATIO
-    parameterMgr->param(modelName, "CF_CRITICAL_TIMER_RATIO", CF_CRITICAL_TIMER_RATIO, 0.5);
-
-    //LC Yielding Model
-    parameterMgr->param(modelName, "LC_Yielding_Model", str, string("0.80 1.0"));
-
-    //Minimum time in lane in same direction
-    parameterMgr->param(modelName, "LC_Discretionary_Lane_Change_Model_MinTimeInLaneSameDir", minTimeInLaneSameDir, 2.0);
-
-    //Minimum time in lane in different direction
-    parameterMgr->param(modelName, "LC_Discretionary_Lane_Change_Model_MinTimeInLaneDiffDir", minTimeInLaneDiffDir, 2.0);
-
-    //Target Gap Model
-    parameterMgr->param(modelName, "Target_Gap_Model", str, string("-0.837   0.913  0.816  -1.218  -2.393  -1.662"));
-    Utils::convertStringToArray(str, params.targetGapParams);
-
-    parameterMgr->param(modelName, "check_stop_point_distance", params.stopVisibilityDistance, 100.0);
+MITSIM_LC_Model::~MITSIM_LC_Model()
+{
 }
 
 double MITSIM_LC_Model::calcCriticalGapKaziModel(DriverUpdateParams &params, int type, double distance, double diffInSpeed)
 {
-    std::vector<double> a = params.LC_GAP_MODELS[type];
+    const std::vector<double> &a = parameters->LC_GAP_MODELS[type];
 
     //                    beta0            beta1                  beta2                    beta3                        beta4
-    double b[] = {params.LC_GAP_MODELS[type][3], params.LC_GAP_MODELS[type][4], params.LC_GAP_MODELS[type][5], params.LC_GAP_MODELS[type][6], params.LC_GAP_MODELS[type][7]};
+    double b[] = {a[3], a[4], a[5], a[6], a[7]};
     double rem_dist_impact = (type < 3) ? 0.0 : (1.0 - 1.0 / (1 + exp(a[2] * distance)));
     double dvNegative = (diffInSpeed < 0) ? diffInSpeed : 0.0;
     double dvPositive = (diffInSpeed > 0) ? diffInSpeed : 0.0;
@@ -417,7 +339,7 @@ void MITSIM_LC_Model::chooseTargetGap(DriverUpdateParams &params)
 
 double MITSIM_LC_Model::gapExpOfUtility(DriverUpdateParams &params, int n, float effectiveGap, float distToGap, float gapSpeed, float remainderGap)
 {
-    std::vector<double> a = params.targetGapParams;
+    const std::vector<double> &a = parameters->targetGapParams;
 
     double u = a[2] * effectiveGap + a[3] * distToGap + a[4] * gapSpeed;
 
@@ -438,64 +360,6 @@ double MITSIM_LC_Model::gapExpOfUtility(DriverUpdateParams &params, int n, float
     return exp(u);
 }
 
-void MITSIM_LC_Model::makeMLCParam(std::string &str)
-{
-    std::vector<double> array;
-    Utils::convertStringToArray(str, array);
-    MLC_PARAMETERS.lowbound = array[0];
-    MLC_PARAMETERS.delta = array[1];
-    MLC_PARAMETERS.lane_mintime = array[2];
-}
-
-void MITSIM_LC_Model::makeCriticalGapParams(DriverUpdateParams &params, std::vector<std::string> &strMatrix)
-{
-    for (int i = 0; i < strMatrix.size(); ++i)
-    {
-        std::vector<double> array;
-        Utils::convertStringToArray(strMatrix[i], array);
-        params.LC_GAP_MODELS.push_back(array);
-    }
-}
-
-void MITSIM_LC_Model::makeTargetGapPram(std::vector<std::string> &strMatrix)
-{
-    for (int i = 0; i < strMatrix.size(); ++i)
-    {
-        std::vector<double> array;
-        Utils::convertStringToArray(strMatrix[i], array);
-        GAP_PARAM.push_back(array);
-    }
-}
-
-void MITSIM_LC_Model::makeLaneUtilityParams(std::string &str)
-{
-    Utils::convertStringToArray(str, laneUtilityParams);
-}
-
-void MITSIM_LC_Model::makeNosingParams(DriverUpdateParams &params, string &str)
-{
-    Utils::convertStringToArray(str, params.nosingParams);
-    lcMaxNosingDis = params.nosingParams[8];
-    lcMaxStuckTime = params.nosingParams[7];
-    lcNosingConstStateTime = params.nosingParams[0];
-    params.lcMaxYieldingTime = params.nosingParams[6];
-}
-
-void MITSIM_LC_Model::makeKaziNosingParams(string &str)
-{
-    Utils::convertStringToArray(str, kaziNosingParams);
-}
-
-void MITSIM_LC_Model::makeLC_YieldingProbabilities(string &str)
-{
-    Utils::convertStringToArray(str, lcYieldingProb);
-}
-
-void MITSIM_LC_Model::makeCriticalGapParams(std::string &str)
-{
-    Utils::convertStringToArray(str, criticalGapParams);
-}
-
 LaneChangeTo MITSIM_LC_Model::checkForLC_WithLookAhead(DriverUpdateParams &params)
 {
     LaneChangeTo change = LANE_CHANGE_TO_NONE;
@@ -631,12 +495,12 @@ int MITSIM_LC_Model::isReadyForNextDLC(DriverUpdateParams &params, int mode)
     {
     case 1: // request a change to the right
     {
-        if (params.flag(FLAG_PREV_LC_RIGHT) && sec > minTimeInLaneSameDir)
+        if (params.flag(FLAG_PREV_LC_RIGHT) && sec > parameters->minTimeInLaneSameDir)
         {
             params.lcDebugStr << ";1i0";
             return 1;
         }
-        else if (sec > minTimeInLaneDiffDir)
+        else if (sec > parameters->minTimeInLaneDiffDir)
         {
             params.lcDebugStr << ";1i1";
             return 1;
@@ -649,12 +513,12 @@ int MITSIM_LC_Model::isReadyForNextDLC(DriverUpdateParams &params, int mode)
     }
     case 2: // request a change to the left
     {
-        if (params.flag(FLAG_PREV_LC_LEFT) && sec > minTimeInLaneSameDir)
+        if (params.flag(FLAG_PREV_LC_LEFT) && sec > parameters->minTimeInLaneSameDir)
         {
             params.lcDebugStr << ";2i0";
             return 1;
         }
-        else if (sec > minTimeInLaneDiffDir)
+        else if (sec > parameters->minTimeInLaneDiffDir)
         {
             params.lcDebugStr << ";2i1";
             return 1;
@@ -666,7 +530,7 @@ int MITSIM_LC_Model::isReadyForNextDLC(DriverUpdateParams &params, int mode)
         }
     }
     }
-    return sec > minTimeInLaneSameDir;
+    return sec > parameters->minTimeInLaneSameDir;
 }
 
 int MITSIM_LC_Model::getNumberOfLCToEndOfLink(DriverUpdateParams &params, const Lane *currLane)
@@ -726,7 +590,7 @@ int MITSIM_LC_Model::getNumberOfLCToEndOfLink(DriverUpdateParams &params, const
 double MITSIM_LC_Model::lcUtilityCurrent(DriverUpdateParams &params)
 {
     // 1.0 lane utility parameters
-    vector<double> a = laneUtilityParams;
+    const vector<double> &a = parameters->laneUtilityParams;
 
     // 2.0 LEADING AND LAG VEHICLES
     const NearestVehicle * av = &params.nvFwd;
@@ -812,7 +676,7 @@ double MITSIM_LC_Model::lcUtilityCurrent(DriverUpdateParams &params)
 double MITSIM_LC_Model::lcUtilityRight(DriverUpdateParams &params)
 {
     // 1.0 lane utility parameters
-    vector<double> a = laneUtilityParams;
+    const vector<double> &a = parameters->laneUtilityParams;
 
     // 2.0 LEADING AND LAG VEHICLES
     const NearestVehicle * av = &params.nvRightFwd;
@@ -898,7 +762,7 @@ double MITSIM_LC_Model::lcUtilityRight(DriverUpdateParams &params)
 double MITSIM_LC_Model::lcUtilityLeft(DriverUpdateParams &params)
 {
     // 1.0 lane utility parameters
-    vector<double> a = laneUtilityParams;
+    const vector<double> &a = parameters->laneUtilityParams;
 
     // 2.0 LEADING AND LAG VEHICLES
     const NearestVehicle *leftFwdVeh = &params.nvLeftFwd;
@@ -972,7 +836,7 @@ double MITSIM_LC_Model::lcUtilityLeft(DriverUpdateParams &params)
 
 double MITSIM_LC_Model::lcUtilityLookAheadLeft(DriverUpdateParams &params, int noOfChanges, float lcDistance)
 {
-    vector<double> a = laneUtilityParams;
+    const vector<double> &a = parameters->laneUtilityParams;
     double vld, mlc, density, spacing;
 
     density = 0;
@@ -1054,7 +918,7 @@ double MITSIM_LC_Model::lcUtilityLookAheadLeft(DriverUpdateParams &params, int n
 
 double MITSIM_LC_Model::lcUtilityLookAheadRight(DriverUpdateParams &params, int noOfChanges, float lcDistance)
 {
-    vector<double> a = laneUtilityParams;
+    const vector<double> &a = parameters->laneUtilityParams;
     double vld, mlc, density, spacing;
 
     density = 0.0;
@@ -1146,7 +1010,7 @@ double MITSIM_LC_Model::lcUtilityLookAheadRight(DriverUpdateParams &params, int
 
 double MITSIM_LC_Model::lcUtilityLookAheadCurrent(DriverUpdateParams &params, int noOfChanges, float lcDistance)
 {
-    vector<double> a = laneUtilityParams;
+    const vector<double> &a = parameters->laneUtilityParams;
     double vld, mlc, density, spacing;
 
     density = params.density;
@@ -1245,7 +1109,7 @@ double MITSIM_LC_Model::lcUtilityLookAheadCurrent(DriverUpdateParams &params, in
 
 double MITSIM_LC_Model::lcCriticalGap(DriverUpdateParams &params, int type, double dv)
 {
-    vector<double> a = criticalGapParams;
+    const vector<double> &a = parameters->criticalGapParams;
 
     float dvNegative = (dv < 0) ? dv : 0.0;
     float dvPositive = (dv > 0) ? dv : 0.0;
@@ -1278,7 +1142,7 @@ double MITSIM_LC_Model::lcCriticalGap(DriverUpdateParams &params, int type, doub
 double MITSIM_LC_Model::mlcDistance()
 {
     double n = Utils::generateFloat(0, 1.0);
-    double dis = MLC_PARAMETERS.lowbound + n * (MLC_PARAMETERS.delta - MLC_PARAMETERS.lowbound);
+    double dis = parameters->MLC_PARAMETERS.lowbound + n * (parameters->MLC_PARAMETERS.delta - parameters->MLC_PARAMETERS.lowbound);
     return dis;
 }
 
@@ -1288,7 +1152,7 @@ LaneChangeTo MITSIM_LC_Model::makeLaneChangingDecision(DriverUpdateParams &param
     params.lcDebugStr << "makeD" << params.now.frame();
     params.noOfLC = 0;
     
-    if(params.desiredSpeed < minSpeed)
+    if(params.desiredSpeed < parameters->minSpeed)
     {
         params.lcDebugStr << ";samesm";
         return LANE_CHANGE_TO_NONE;
@@ -1466,7 +1330,7 @@ double MITSIM_LC_Model::executeLaneChanging(DriverUpdateParams &params)
 
         int nosing = params.flag(FLAG_NOSING);
         params.lcDebugStr << ";LCF" << nosing << ";ds" << params.distToStop;
-        if (!nosing && params.distToStop < lcMaxNosingDis)
+        if (!nosing && params.distToStop < parameters->lcMaxNosingDis)
         {
             params.lcDebugStr << ";NDis";
             int nlanes = params.noOfLC;
@@ -1503,7 +1367,7 @@ double MITSIM_LC_Model::executeLaneChanging(DriverUpdateParams &params)
             params.lcDebugStr << ";nig";
             
             // Since I am nosing, updating of acceleration rate sooner
-            params.reactionTimeCounter = CF_CRITICAL_TIMER_RATIO * params.nextStepSize;
+            params.reactionTimeCounter = parameters->CF_CRITICAL_TIMER_RATIO * params.nextStepSize;
             
             // Now I am going to nose in provided it is feasible and the
             // lag vehicle is willing to yield
@@ -1591,7 +1455,7 @@ int MITSIM_LC_Model::checkNosingFeasibility(DriverUpdateParams &params, const Ne
     if (params.flag(FLAG_STUCK_AT_END))
     {
         params.lcDebugStr << ";stuck";
-        if (timeSinceTagged(params) > lcMaxStuckTime)
+        if (timeSinceTagged(params) > parameters->lcMaxStuckTime)
         {
             //If stuck for a very long time, skip the feasibility check
             params.lcDebugStr << ";max";        
@@ -1633,7 +1497,7 @@ int MITSIM_LC_Model::checkNosingFeasibility(DriverUpdateParams &params, const Ne
             params.lcDebugStr << ";CF5";
 
             // Acceleration rate in order to be slower than the leader
-            upper = (fwdVehicle->driver->getFwdVelocity() - params.currSpeed) / lcNosingConstStateTime + fwdVehicle->driver->getFwdAcceleration();
+            upper = (fwdVehicle->driver->getFwdVelocity() - params.currSpeed) / parameters->lcNosingConstStateTime + fwdVehicle->driver->getFwdAcceleration();
             params.lcDebugStr << ";up" << upper;
 
             if (upper < params.maxDeceleration)
@@ -1666,7 +1530,7 @@ int MITSIM_LC_Model::checkNosingFeasibility(DriverUpdateParams &params, const Ne
             // Acceleration rate in order to be faster than the lag
             // vehicle and do not cause the lag vehicle to decelerate
             // harder than its normal deceleration rate
-            lower = (rearVehicle->driver->getFwdVelocity() - params.currSpeed) / lcNosingConstStateTime + params.normalDeceleration;
+            lower = (rearVehicle->driver->getFwdVelocity() - params.currSpeed) / parameters->lcNosingConstStateTime + params.normalDeceleration;
 
             if (lower > params.maxAcceleration)
             {
@@ -1694,7 +1558,7 @@ int MITSIM_LC_Model::checkNosingFeasibility(DriverUpdateParams &params, const Ne
             // Acceleration rate in order to be faster than the lag
             // vehicle and do not cause the lag vehicle to decelerate
             // harder than its normal deceleration rate
-            lower = (rearVehicle->driver->getFwdVelocity() - params.currSpeed) / lcNosingConstStateTime + params.normalDeceleration;
+            lower = (rearVehicle->driver->getFwdVelocity() - params.currSpeed) / parameters->lcNosingConstStateTime + params.normalDeceleration;
             params.lcDebugStr << ";low" << lower;
 
             if (lower > params.maxAcceleration)
@@ -1734,7 +1598,7 @@ float MITSIM_LC_Model::lcNosingProbability(float distance, float diffInSpeed, fl
         num = 1;
     }
 
-    std::vector<double> b = kaziNosingParams;
+    const std::vector<double> &b = parameters->kaziNosingParams;
     float rel_spd = (diffInSpeed > 0) ? 0 : diffInSpeed;
     float rm_dist_impact = 10 - 10 / (1.0 + exp(b[2] * distance));
 
@@ -1890,7 +1754,7 @@ int MITSIM_LC_Model::checkForEventsAhead(DriverUpdateParams& params)
     }
 
     // 3.0 MLC is required and not enough headway, set STATUS_MANDATORY
-    if (needMLC && params.distToStop < lookAheadDistance && timeSinceTagged(params) >= MLC_PARAMETERS.lane_mintime)
+    if (needMLC && params.distToStop < lookAheadDistance && timeSinceTagged(params) >= parameters->MLC_PARAMETERS.lane_mintime)
     {
         params.setStatus(STATUS_MANDATORY);
     }
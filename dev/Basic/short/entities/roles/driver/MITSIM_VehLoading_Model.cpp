@@ -2,8 +2,6 @@
 //Licensed under the terms of the MIT License, as described in the file:
 //   license.txt   (http://opensource.org/licenses/MIT)
 
-#include <boost/algorithm/string.hpp>
-
 #include "entities/AuraManager.hpp"
 #include "entities/roles/driver/models/VehicleLoadingModel.hpp"
 #include "util/Utils.hpp"
@@ -12,18 +10,6 @@ using namespace std;
 using namespace sim_mob;
 
 VehicleLoadingModel::VehicleLoadingModel(DriverUpdateParams &params)
-{
-    modelName = "general_driver_model";
-    splitDelimiter = " ,";
-
-    readDriverParameters(params);
-}
-
-VehicleLoadingModel::~VehicleLoadingModel()
-{
-}
-
-void VehicleLoadingModel::readDriverParameters(DriverUpdateParams &params)
 {
     bool isAMOD = false;
 
@@ -32,39 +18,11 @@ void VehicleLoadingModel::readDriverParameters(DriverUpdateParams &params)
         isAMOD = true;
     }
 
-    string speedAssignmentThresholdsStr;
-    ParameterManager *parameterMgr = ParameterManager::Instance(isAMOD);
-    parameterMgr->param(modelName, "Initial_Speed_Assignment_Thresholds", speedAssignmentThresholdsStr,
-                        string("4 14 40"));
-    createInitialSpeedAssignmentThresholds(speedAssignmentThresholdsStr, speedAssignmentThresholds);
+    parameters = &DriverParameterRegistry::getParameters(isAMOD).vehicleLoading;
 }
 
-void VehicleLoadingModel::createInitialSpeedAssignmentThresholds(string &strParams,
-                                                                 InitialSpeedAssignmentThresholds &thresholds)
+VehicleLoadingModel::~VehicleLoadingModel()
 {
-    std::vector<std::string> arrayStr;
-    vector<double> params;
-
-    boost::trim(strParams);
-    boost::split(arrayStr, strParams, boost::is_any_of(splitDelimiter), boost::token_compress_on);
-
-    for (int i = 0; i < arrayStr.size(); ++i)
-    {
-        try
-        {
-            params.push_back(boost::lexical_cast<double>(arrayStr[i].c_str()));
-        }
-        catch (boost::bad_lexical_cast &)
-        {
-            std::stringstream str;
-            str << __func__ << ": Cannot convert " << strParams << " to type double";
-            throw std::runtime_error(str.str());
-        }
-    }
-
-    thresholds.distanceBoundedLow = params[0];
-    thresholds.distanceBoundedUpper = params[1];
-    thresholds.distanceUnbounded = params[2];
 }
 
 void VehicleLoadingModel::chooseStartingLaneAndSpeed(vector<WayPoint> &path, int *laneIdx, const int segmentId,
@@ -128,20 +86,20 @@ void VehicleLoadingModel::chooseStartingLaneAndSpeed(vector<WayPoint> &path, int
     //Set initial speed based on the leader vehicle
     auto leader = leadVehicles[selectedLane];
 
-    if (speedAssignmentThresholds.distanceBoundedLow < leader.distance &&
-        leader.distance < speedAssignmentThresholds.distanceBoundedUpper)
+    if (parameters->speedAssignmentThresholds.distanceBoundedLow < leader.distance &&
+        leader.distance < parameters->speedAssignmentThresholds.distanceBoundedUpper)
     {
         *initialSpeed = leader.driver->getFwdVelocity();
     }
-    else if (speedAssignmentThresholds.distanceBoundedUpper < leader.distance &&
-             leader.distance <= speedAssignmentThresholds.distanceUnbounded)
+    else if (parameters->speedAssignmentThresholds.distanceBoundedUpper < leader.distance &&
+             leader.distance <= parameters->speedAssignmentThresholds.distanceUnbounded)
     {
-        auto alpha = (leader.distance - speedAssignmentThresholds.distanceBoundedUpper) /
-                     (speedAssignmentThresholds.distanceUnbounded - speedAssignmentThresholds.distanceBoundedUpper);
+        auto alpha = (leader.distance - parameters->speedAssignmentThresholds.distanceBoundedUpper) /
+                     (parameters->speedAssignmentThresholds.distanceUnbounded - parameters->speedAssignmentThresholds.distanceBoundedUpper);
         *initialSpeed = (alpha * selectedLane->getParentSegment()->getMaxSpeed()) +
                         (1 - alpha) * leader.driver->getFwdVelocity();
     }
-    else if (leader.distance > speedAssignmentThresholds.distanceUnbounded)
+    else if (leader.distance > parameters->speedAssignmentThresholds.distanceUnbounded)
     {
         *initialSpeed = selectedLane->getParentSegment()->getMaxSpeed();
     }
@@ -200,6 +200,11 @@ void OnCallDriverMovement::frame_tick()
    {
        DriverMovement::frame_tick();
 
+   }
+   else
+   {
+       //The parked driver stays where it is
+       addToLaneVehicleIndex(onCallDriver->getCurrLane(), onCallDriver->getParent()->xPos.get(), onCallDriver->getParent()->yPos.get());
    }
     /*
  if(fwdDriverMovement.isDoneWithEntireRoute())
@@ -12,6 +12,7 @@
 #include "config/params/ParameterManager.hpp"
 #include "entities/models/Constants.hpp"
 #include "entities/roles/driver/Driver.hpp"
+#include "entities/roles/driver/DriverParameterRegistry.hpp"
 #include "entities/roles/driver/DriverPathMover.hpp"
 #include "entities/vehicle/VehicleBase.hpp"
 
@@ -27,12 +28,6 @@ class Driver;
 class CarFollowingModel
 {
 public:
-    /**The model name*/
-    string modelName;
-
-    /**The acceleration grade factor*/
-    double accGradeFactor;
-
     /**The next perception size*/
     double nextPerceptionSize;
 
@@ -45,9 +40,6 @@ public:
     /**The perception sizes*/
     std::vector<double> perceptionSize;
 
-    /**Split delimiter in the driver parameters XML file*/
-    string splitDelimiter;
-    
 protected:
     /**The pointer to the driver path mover object*/
     DriverPathMover *fwdDriverMovement;
@@ -87,162 +79,15 @@ public:
 class MITSIM_CF_Model : public CarFollowingModel
 {
 private:
-    /**Represents the container to store the normal distribution*/
-    struct UpdateStepSizeParam
-    {
-        double mean;
-        double stdev;
-        double lower;
-        double upper;
-        double perception; //percentage of total reaction time
-    };
-
-    /**Represents the container to store the car following model parameters*/
-    struct CarFollowingParams
-    {
-        double alpha;
-        double beta;
-        double gama;
-        double lambda;
-        double rho;
-        double stddev;
-    };
-
-    /**The upper bound on the maximum acceleration*/
-    int maxAccUpperBound;
-
-    /**The upper bound on the normal deceleration*/
-    int normalDecelerationUpperBound;
-
-    /**The upper bound on the maximum deceleration*/
-    int maxDecelerationUpperBound;
-
-    /**This parameter is used to compute the desired speed based on the posted speed limit*/
-    double speedFactor;
-
-    /**The visibility distance of the traffic signal*/
-    double signalVisibilityDist;
-
-    /**The maximum value of headway a driver can have to pass a yellow light.*/
-    double maxYellowLightHeadway;
-
-    /**The minimum speed for approaching a yellow light*/
-    double minYellowLightSpeed;
-
-    /**The road slope*/
-    double allGrades;
-
-    /**
-     * This is the minimum space headway between the lead and following vehicles for which the following
-     * vehicle must apply some acceleration (or deceleration)
-     */
-    double minResponseDistance;
+    /**The car following parameters shared by all the drivers*/
+    const MITSIM_CF_Parameters *parameters;
 
     /**Upper bound for the headway buffer*/
     double hBufferUpper;
 
-    /**Lower bound for the headway buffer*/
-    double hBufferLower;
-
-    /**Defines how close the lead vehicle needs to be in order for the following vehicle to brake (in meter)*/
-    double visibilityDistance;
-
     /**Random number generator for calculating update step sizes*/
     boost::mt19937 updateSizeRNG;
 
-    /**The car following parameters*/
-    CarFollowingParams CF_parameters[2];
-
-    /**Merging parameters*/
-    vector<double> mergingParams;
-
-    /**Update step size while deceleration*/
-    UpdateStepSizeParam decUpdateStepSize;
-
-    /**Update step size while acceleration*/
-    UpdateStepSizeParam accUpdateStepSize;
-
-    /**Update step size when the speed is constant*/
-    UpdateStepSizeParam uniformSpeedUpdateStepSize;
-
-    /**Update step size when the vehicle has stopped*/
-    UpdateStepSizeParam stoppedUpdateStepSize;
-
-    /**Parameters to calculate the target gap acceleration*/
-    vector<double> targetGapAccParm;
-
-    /**The maximum acceleration scale*/
-    vector<double> maxAccelerationScale;
-
-    /**The normal deceleration scale*/
-    vector<double> normalDecelerationScale;
-
-    /**The maximum deceleration scale*/
-    vector<double> maxDecelerationScale;
-
-    /**The speed limit add-on distribution*/
-    vector<double> speedLimitAddon;
-
-    /**The car following acceleration add-on distribution*/
-    vector<double> accelerationAddon;
-
-    /**The car following deceleration add-on distribution*/
-    vector<double> decelerationAddon;
-
-    /**The distribution for the headway upperbound*/
-    vector<double> hBufferUpperScale;
-
-    /**The maximum acceleration indices. Key: Vehicle type, Value: Map with Key: Speed, Value: Max. Acceleration*/
-    map< VehicleBase::VehicleType, map<int, double> > maxAccelerationIndex;
-
-    /**The normal deceleration indices. Key: Vehicle type, Value: Map with Key: Speed, Value: Normal deceleration*/
-    map< VehicleBase::VehicleType, map<int, double> > normalDecelerationIndex;
-
-    /**The maximum deceleration indices. Key: Vehicle type, Value: Map with Key: Speed, Value: Normal deceleration*/
-    map< VehicleBase::VehicleType, map<int, double> > maxDecelerationIndex;
-
-    /**
-     * Reads the car following model parameters from the driver parameters XML file
-     *
-     * @param params the drivers parameters
-     */
-    void readDriverParameters(DriverUpdateParams &params);
-
-    /**
-     * Creates the car following parameters from the given parameter values in string format
-     *
-     * @param strParams the parameter string
-     * @param cfParams the car following parameters
-     */
-    void createCF_Params(string &strParams, CarFollowingParams &cfParams);
-
-    /**
-     * Creates the speed indices based on the speed scalars
-     *
-     * @param vehicleType vehicle type
-     * @param speedScalerStr speed scalar
-     * @param cstr the index value
-     * @param idx the container holding the indices
-     * @param upperBound the upper bound of the index
-     */
-    void createSpeedIndices(VehicleBase::VehicleType vehicleType, string &speedScalerStr, string &cstr, map< VehicleBase::VehicleType, map<int, double> > &idx,
-                            int &upperBound);
-
-    /**
-     * Creates the scale indices based on the string data
-     *
-     * @param data the data in the format "0.6 0.7 0.8 0.9 1.0 1.1 1.2 1.3 1.4 1.5"
-     * @param container the container that stores the created indices
-     */
-    void createScaleIndices(string &data, vector<double> &container);
-
-    /**
-     * Creates the update step size parameters from the given parameter values in string format
-     * @param strParams the parameter string
-     * @param stepSizeParams the container for the update step size parameters
-     */
-    void createUpdateSizeParams(string &strParams, UpdateStepSizeParam &stepSizeParams);
-
     /**
      * Builds and gets a sample from the normal distribution created from the given parameters
      *
@@ -250,7 +95,7 @@ private:
      *
      * @return sampled value from the distribution
      */
-    double sampleFromNormalDistribution(UpdateStepSizeParam &stepSizeParams);
+    double sampleFromNormalDistribution(const MITSIM_CF_Parameters::UpdateStepSizeParam &stepSizeParams);
 
     /**
      * Returns the maximum acceleration for the given vehicle type
@@ -567,22 +412,22 @@ private:
 
     double upMergingArea()
     {
-        return mergingParams[0];
+        return parameters->mergingParams[0];
     }
 
     double dnMergingArea()
     {
-        return mergingParams[1];
+        return parameters->mergingParams[1];
     }
 
     int nVehiclesAllowedInMergingArea()
     {
-        return (int) mergingParams[2];
+        return (int) parameters->mergingParams[2];
     }
 
     float aggresiveRampMergeProb()
     {
-        return mergingParams[3];
+        return parameters->mergingParams[3];
     }
 
 public:
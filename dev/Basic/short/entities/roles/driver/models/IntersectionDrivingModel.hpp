@@ -7,6 +7,7 @@
 
 #include "config/params/ParameterManager.hpp"
 #include "conf/settings/DisableMPI.h"
+#include "entities/roles/driver/DriverParameterRegistry.hpp"
 #include "entities/roles/driver/DriverUpdateParams.hpp"
 #include "geospatial/network/TurningPath.hpp"
 #include "util/DynamicVector.hpp"
@@ -93,27 +94,8 @@ public:
 class MITSIM_IntDriving_Model : public IntersectionDrivingModel
 {
 private:
-    /**The minimum value of the attentiveness factor within an intersection. The factor is a random value between the given min and max*/
-    double intersectionAttentivenessFactorMin;
-
-    /**The maximum value of the attentiveness factor within an intersection. The factor is a random value between the given min and max*/
-    double intersectionAttentivenessFactorMax;
-
-    /**The value of minimum gap*/
-    double minimumGap;
-
-    /**Contains the mean and standard deviation values for generating a random add-on to the critical gap*/
-    double criticalGapAddOn[2];
-
-    /**The multiplier for the impatience timer.*/
-    double impatienceFactor;
-    
-    /**
-     * Reads and stores the parameters related to intersection driving from the driver parameter XML file
-     *
-     * @param params driver parameters
-     */
-    void readDriverParameters(DriverUpdateParams &params);
+    /**The intersection driving parameters shared by all the drivers*/
+    const MITSIM_IntDriving_Parameters *parameters;
 
     /**
      * Calculate the acceleration needed to crawl
@@ -9,6 +9,7 @@
 #include "config/params/ParameterManager.hpp"
 #include "geospatial/network/Lane.hpp"
 #include "entities/models/Constants.hpp"
+#include "entities/roles/driver/DriverParameterRegistry.hpp"
 #include "entities/roles/driver/DriverPathMover.hpp"
 #include "entities/roles/driver/DriverUpdateParams.hpp"
 
@@ -23,12 +24,6 @@ class NearestVehicle;
 class LaneChangingModel
 {
 protected:
-    /**The model name in the "parameters" tag of the XML file*/
-    string modelName;
-
-    /**The delimiter to split the parameters specified in the XML file*/
-    string splitDelimiter;
-
     /**The pointer to the driver path mover object*/
     DriverPathMover *fwdDriverMovement;
 
@@ -56,129 +51,12 @@ public:
 class MITSIM_LC_Model : public LaneChangingModel
 {
 private:
-
-    /**
-     * Holds the mandatory lane changing parameters
-     */
-    struct MandatoryLaneChangeParams
-    {
-        //In metre
-        double lowbound;
-
-        //In metre
-        double delta;
-
-        //In sec
-        double lane_mintime;
-    };
-
-    /**Minimum time require in lane before doing a lane change in the same direction as the previous lane change*/
-    double minTimeInLaneSameDir;
-
-    /**Minimum time require in lane before doing a lane change in a direction different to the previous lane change*/
-    double minTimeInLaneDiffDir;
-
-    /**Max distance for nosing*/
-    double lcMaxNosingDis;
-
-    /**This parameter is used to change drivers reaction time when in a nosing behaviour*/
-    double CF_CRITICAL_TIMER_RATIO;
-
-    /**The maximum time a vehicle is stuck while attempting to nose*/
-    double lcMaxStuckTime;
-
-    /**Minimum speed to consider for a moving vehicle*/
-    double minSpeed;
+    /**The lane changing parameters shared by all the drivers*/
+    const MITSIM_LC_Parameters *parameters;
 
     /**The look ahead distance*/
     double lookAheadDistance;
 
-    /**Specifies the time horizon (in second) for constant acceleration while nosing*/
-    float lcNosingConstStateTime;
-
-    /**Holds the parameters required to calculate critical gap*/
-    vector<double> criticalGapParams;
-
-    /**Holds the nosing parameters*/
-    vector<double> kaziNosingParams;
-
-    /**Holds the probabilities of yielding to other vehicles*/
-    vector<double> lcYieldingProb;
-
-    /**Holds the lane utility model. This model describes drivers’ choice of lane they would want to travel in*/
-    vector<double> laneUtilityParams;
-
-    /**Holds the parameters the define how a gap is chosen*/
-    std::vector< std::vector<double> > GAP_PARAM;
-
-    /**Holds the mandatory lane changing parameters*/
-    MandatoryLaneChangeParams MLC_PARAMETERS;
-
-    /**
-     * Reads the lane changing model parameters from the driver parameters XML file
-     *
-     * @param params the drivers parameters
-     */
-    void readDriverParameters(DriverUpdateParams &params);
-
-    /**
-     * Helper function to parse parameters read in string format and store them
-     *
-     * @param str parameters read from driver parameters XML
-     */
-    void makeCriticalGapParams(std::string &str);
-
-    /**
-     * Helper function to parse parameters read in string format and store them
-     *
-     * @param params driver parameters
-     * @param str parameters read from driver parameters XML
-     */
-    void makeNosingParams(DriverUpdateParams &params, string &str);
-
-    /**
-     * Helper function to parse parameters read in string format and store them
-     *
-     * @param str parameters read from driver parameters XML
-     */
-    void makeLC_YieldingProbabilities(string &str);
-
-    /**
-     * Helper function to parse parameters read in string format and store them
-     *
-     * @param str parameters read from driver parameters XML
-     */
-    void makeLaneUtilityParams(std::string &str);
-
-    /**
-     * Helper function to parse parameters read in string format and store them
-     *
-     * @param str parameters read from driver parameters XML
-     */
-    void makeMLCParam(std::string &str);
-
-    /**
-     * Helper function to parse parameters read in string format and store them
-     *
-     * @param params driver parameters
-     * @param strMatrix parameters read from driver parameters XML
-     */
-    void makeCriticalGapParams(DriverUpdateParams &params, std::vector<std::string> &strMatrix);
-
-    /**
-     * Helper function to parse parameters read in string format and store them
-     *
-     * @param strMatrix parameters read from driver parameters XML
-     */
-    void makeTargetGapPram(std::vector<std::string> &strMatrix);
-
-    /**
-     * Helper function to parse parameters read in string format and store them
-     *
-     * @param str parameters read from driver parameters XML
-     */
-    void makeKaziNosingParams(string &str);
-
     /**
      * Calculates target gap utility
      *
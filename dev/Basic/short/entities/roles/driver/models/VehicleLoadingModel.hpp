@@ -6,6 +6,7 @@
 
 #include "config/params/ParameterManager.hpp"
 #include "entities/roles/driver/Driver.hpp"
+#include "entities/roles/driver/DriverParameterRegistry.hpp"
 
 using namespace std;
 
@@ -17,26 +18,10 @@ class DriverUpdateParams;
 class VehicleLoadingModel
 {
 private:
-    /**The model name*/
-    string modelName;
+    typedef VehicleLoadingParameters::InitialSpeedAssignmentThresholds InitialSpeedAssignmentThresholds;
 
-    /**Split delimiter in the driver parameters XML file*/
-    string splitDelimiter;
-
-    /**Represents the various distance (to leader vehicle) headway thresholds for the initial speed assignment*/
-    struct InitialSpeedAssignmentThresholds
-    {
-        //Lower bound threshold for bounded traffic
-        double distanceBoundedLow;
-
-        //Upper bound threshold for bounded traffic
-        double distanceBoundedUpper;
-
-        //Threshold for unbounded traffic
-        double distanceUnbounded;
-    };
-
-    InitialSpeedAssignmentThresholds speedAssignmentThresholds;
+    /**The vehicle loading parameters shared by all the drivers*/
+    const VehicleLoadingParameters *parameters;
 
     /**
      * If the given start segment is in the path, the path is updated to start from the given segment
@@ -79,21 +64,6 @@ public:
     VehicleLoadingModel(DriverUpdateParams &params);
     ~VehicleLoadingModel();
 
-    /**
-     * Reads the vehicle loading model parameters from the driver parameters XML file
-     *
-     * @param params the drivers parameters
-     */
-    void readDriverParameters(DriverUpdateParams &params);
-
-    /**
-     * Creates the distance thresholds for the initial speed assignment parameters
-     * from the given parameter values in string format
-     * @param strParams the parameter string
-     * @param thresholds the container for the threshold parameters
-     */
-    void createInitialSpeedAssignmentThresholds(string &strParams, InitialSpeedAssignmentThresholds &thresholds);
-
     /**
      * Gets the nearby vehicles and then filters out the lead and follower vehicles in each of the candidate
      * lanes
@@ -118,9 +88,9 @@ public:
     void chooseStartingLaneAndSpeed(vector<WayPoint> &path, int *laneIdx, const int segmentId, int *initialSpeed,
                                     DriverUpdateParams &params);
 
-    InitialSpeedAssignmentThresholds& getInitialSpeedAssignmentThresholds()
+    const InitialSpeedAssignmentThresholds& getInitialSpeedAssignmentThresholds() const
     {
-        return speedAssignmentThresholds;
+        return parameters->speedAssignmentThresholds;
     }
 };
 }
\ No newline at end of file